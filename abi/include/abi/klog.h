@@ -35,11 +35,58 @@
 #ifndef _ABI_KLOG_H_
 #define _ABI_KLOG_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 typedef enum {
 	KLOG_WRITE,
 	KLOG_READ
 } klog_operation_t;
 
+/** Alignment of entries in the kernel log rings */
+#define KLOG_ENTRY_ALIGN  8
+
+/** Size of the kernel log ring header preceding the ring data */
+#define KLOG_RING_HEADER_SIZE  64
+
+/** Kernel log entry
+ *
+ * The header is immediately followed by the message, which is not
+ * terminated by a null character. Within a ring, an entry with zero
+ * length marks the unused rest of the ring before it wraps around.
+ *
+ */
+typedef struct {
+	uint32_t len;        /**< Length of the entry including the header */
+	uint32_t serial;     /**< Sequence number of the entry */
+	uint32_t facility;   /**< Log facility */
+	uint32_t level;      /**< Log level */
+	uint64_t timestamp;  /**< Microseconds since boot */
+	uint32_t cpu;        /**< CPU which logged the entry */
+	uint32_t reserved;
+	char message[];
+} klog_entry_t;
+
+/** Per-CPU kernel log ring
+ *
+ * The rings can be mapped by a single reader task, which then drains them
+ * directly. Positions are byte offsets which only grow, an entry at
+ * position @c pos starts at offset @c pos % @c size of the ring data.
+ * If less than sizeof(klog_entry_t) bytes are left before the end of
+ * the data, the next entry starts at the beginning of the data.
+ *
+ */
+typedef struct {
+	/** Position after the last complete entry, written by the kernel */
+	size_t head;
+	/** Position of the first unread entry, written by the reader */
+	size_t tail;
+	/** Number of entries lost because the ring was full */
+	size_t dropped;
+	/** Size of the ring data in bytes */
+	size_t size;
+} klog_ring_t;
+
 #endif
 
 /** @}
@@ -70,8 +70,29 @@ typedef struct {
 	uint16_t frequency_mhz;  /**< Frequency in MHz */
 	uint64_t idle_cycles;    /**< Number of idle cycles */
 	uint64_t busy_cycles;    /**< Number of busy cycles */
+	uint64_t dispatched;     /**< Number of threads dispatched */
+	uint64_t stolen;         /**< Number of threads stolen from other CPUs */
+	uint64_t wait_cycles;    /**< Cycles dispatched threads spent ready */
+	uint64_t wait_max;       /**< Longest wait of a ready thread in cycles */
 } stats_cpu_t;
 
+/** Length of slab cache names in statistics */
+#define STATS_SLAB_NAME_BUFLEN  32
+
+/** Statistics about a single slab cache
+ *
+ */
+typedef struct {
+	char name[STATS_SLAB_NAME_BUFLEN];  /**< Cache name */
+	size_t size;                        /**< Object size */
+	size_t slabs;                       /**< Number of allocated slabs */
+	size_t allocated_objs;              /**< Number of allocated objects */
+	size_t cached_objs;                 /**< Number of objects in magazines */
+	size_t magazine_size;               /**< Size of new magazines */
+	uint64_t exchanges;                 /**< Magazine list accesses */
+	uint64_t contention;                /**< Contended magazine list accesses */
+} stats_slab_t;
+
 /** Physical memory statistics
  *
  */
@@ -131,6 +131,23 @@ void cpu_identify(void)
 		CPU->arch.family = (info.cpuid_eax >> 8) & 0xf;
 		CPU->arch.model = (info.cpuid_eax >> 4) & 0xf;
 		CPU->arch.stepping = (info.cpuid_eax >> 0) & 0xf;
+
+		/*
+		 * The initial APIC ID of a logical processor is its package
+		 * number followed by enough bits to number all the logical
+		 * processors in the package. Hyperthread siblings are not told
+		 * apart, each logical processor counts as a core of its own.
+		 */
+		if (info.cpuid_edx & (1 << INTEL_HTT)) {
+			unsigned int apic_id = info.cpuid_ebx >> 24;
+			unsigned int logical = (info.cpuid_ebx >> 16) & 0xff;
+			unsigned int shift = 0;
+
+			while ((1U << shift) < logical)
+				shift++;
+
+			CPU->package = apic_id >> shift;
+		}
 	}
 }
 
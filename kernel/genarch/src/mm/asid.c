@@ -127,6 +127,12 @@ asid_t asid_get(void)
 		 */
 		ipl_t ipl = tlb_shootdown_start(TLB_INVL_ASID, asid, 0, 0);
 		tlb_invalidate_asid(asid);
+
+		/*
+		 * No processor has any TLB entries of the address space
+		 * now.
+		 */
+		atomic_store(&as->tlb_cpus, 0);
 		tlb_shootdown_finalize(ipl);
 	} else {
 
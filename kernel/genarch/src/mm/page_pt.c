@@ -221,7 +221,7 @@ void pt_mapping_remove(as_t *as, uintptr_t page)
 
 		memsetb(&ptl0[PTL0_INDEX(page)], sizeof(pte_t), 0);
 #endif
-		frame_free(KA2PA((uintptr_t) ptl3), PTL3_FRAMES);
+		as_frame_free(as, KA2PA((uintptr_t) ptl3), PTL3_FRAMES, 0);
 	} else {
 		/*
 		 * PTL3 is not empty.
@@ -255,7 +255,7 @@ void pt_mapping_remove(as_t *as, uintptr_t page)
 
 		memsetb(&ptl0[PTL0_INDEX(page)], sizeof(pte_t), 0);
 #endif
-		frame_free(KA2PA((uintptr_t) ptl2), PTL2_FRAMES);
+		as_frame_free(as, KA2PA((uintptr_t) ptl2), PTL2_FRAMES, 0);
 	} else {
 		/*
 		 * PTL2 is not empty.
@@ -286,7 +286,7 @@ void pt_mapping_remove(as_t *as, uintptr_t page)
 			return;
 
 		memsetb(&ptl0[PTL0_INDEX(page)], sizeof(pte_t), 0);
-		frame_free(KA2PA((uintptr_t) ptl1), PTL1_FRAMES);
+		as_frame_free(as, KA2PA((uintptr_t) ptl1), PTL1_FRAMES, 0);
 	}
 #endif /* PTL1_ENTRIES != 0 */
 }
@@ -45,6 +45,15 @@
 
 #define CPU                  CURRENT->cpu
 
+/*
+ * Geometry of the per-CPU timeout wheel (see time/timeout.c). There are
+ * TIMEOUT_WHEEL_LEVELS levels of TIMEOUT_WHEEL_SLOTS slots, a slot on level
+ * L spans TIMEOUT_WHEEL_SLOTS^L clock ticks.
+ */
+#define TIMEOUT_WHEEL_BITS    6
+#define TIMEOUT_WHEEL_SLOTS   (1 << TIMEOUT_WHEEL_BITS)
+#define TIMEOUT_WHEEL_LEVELS  4
+
 /** CPU structure.
  *
  * There is one structure like this for every processor.
@@ -62,7 +71,10 @@ typedef struct cpu {
 	volatile size_t needs_relink;
 
 	IRQ_SPINLOCK_DECLARE(timeoutlock);
-	list_t timeout_active_list;
+	/** Pending timeouts, hashed by their deadline. */
+	list_t timeout_wheel[TIMEOUT_WHEEL_LEVELS][TIMEOUT_WHEEL_SLOTS];
+	/** Next clock tick to be processed by clock(). */
+	uint64_t timeout_tick;
 
 	/**
 	 * When system clock loses a tick, it is
@@ -86,6 +98,24 @@ typedef struct cpu {
 	 */
 	unsigned int id;
 
+	/**
+	 * Position in the processor topology. Processors with equal core
+	 * numbers share a core, processors with equal package numbers share
+	 * a package (and the last level cache).
+	 */
+	unsigned int core;
+	unsigned int package;
+
+	/**
+	 * Scheduler statistics, protected by lock.
+	 */
+	uint64_t sched_dispatched;
+	uint64_t sched_stolen;
+	uint64_t sched_wait_cycles;
+	uint64_t sched_wait_max;
+	/** Clock tick of the last periodic load balancing, CPU-local. */
+	uint64_t balance_tick;
+
 	bool active;
 	volatile bool tlb_active;
 
@@ -47,7 +47,9 @@
 #include <adt/odict.h>
 #include <lib/elf.h>
 #include <arch.h>
+#include <atomic.h>
 #include <lib/refcount.h>
+#include <mm/frame.h>
 
 #define AS                   CURRENT->as
 
@@ -88,6 +90,38 @@
 /** The page fault was not resolved by as_page_fault(). Non-verbose version. */
 #define AS_PF_SILENT 3
 
+/** Maximum number of frame ranges kept until a deferred TLB shootdown. */
+#define AS_DEFERRED_FRAMES  32
+
+/**
+ * Maximum number of pages between two unmapped ranges which are still
+ * invalidated by a single deferred TLB shootdown.
+ */
+#define AS_DEFERRED_GAP  16
+
+/** Frames of an unmapped page or page table waiting for a TLB shootdown. */
+typedef struct {
+	uintptr_t frame;
+	size_t count;
+	frame_flags_t flags;
+} as_deferred_frame_t;
+
+/** Unmapped pages whose TLB shootdown has been deferred.
+ *
+ * Protected by the address space lock.
+ */
+typedef struct {
+	/** as_frame_free() keeps the frames instead of freeing them. */
+	bool collect;
+	/** First page of the range to be invalidated. */
+	uintptr_t page;
+	/** Number of pages to be invalidated, zero if there are none. */
+	size_t count;
+	/** Number of used entries in @c frames. */
+	size_t frames_count;
+	as_deferred_frame_t frames[AS_DEFERRED_FRAMES];
+} as_deferred_t;
+
 /** Address space structure.
  *
  * as_t contains the list of as_areas of userspace accessible
@@ -115,6 +149,16 @@ typedef struct as {
 	 */
 	asid_t asid;
 
+	/**
+	 * Processors which may have TLB entries of this address space,
+	 * one bit per processor ID modulo the width of the mask. Only these
+	 * processors take part in TLB shootdowns for this address space.
+	 */
+	atomic_size_t tlb_cpus;
+
+	/** Unmapped pages still to be shot down from other processors. */
+	as_deferred_t tlb_deferred;
+
 	/** Number of references (i.e. tasks that reference this as). */
 	atomic_refcount_t refcount;
 
@@ -324,6 +368,7 @@ extern errno_t as_area_resize(as_t *, uintptr_t, size_t, unsigned int);
 extern errno_t as_area_share(as_t *, uintptr_t, size_t, as_t *, unsigned int,
     uintptr_t *, uintptr_t);
 extern errno_t as_area_change_flags(as_t *, unsigned int, uintptr_t);
+extern void as_frame_free(as_t *, uintptr_t, size_t, frame_flags_t);
 extern as_area_t *as_area_first(as_t *);
 extern as_area_t *as_area_next(as_area_t *);
 
@@ -130,6 +130,7 @@ typedef struct {
 extern zones_t zones;
 
 extern void frame_init(void);
+extern void frame_enable_cpucache(void);
 extern bool frame_adjust_zone_bounds(bool, uintptr_t *, size_t *);
 extern uintptr_t frame_alloc_generic(size_t, frame_flags_t, uintptr_t,
     size_t *);
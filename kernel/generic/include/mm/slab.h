@@ -39,10 +39,23 @@
 #include <synch/spinlock.h>
 #include <atomic.h>
 #include <mm/frame.h>
+#include <abi/sysinfo.h>
 
-/** Initial Magazine size (TODO: dynamically growing magazines) */
+/** Initial and minimal magazine size */
 #define SLAB_MAG_SIZE  4
 
+/** Maximal magazine size */
+#define SLAB_MAG_SIZE_MAX  64
+
+/** Number of magazine sizes, powers of two from SLAB_MAG_SIZE on */
+#define SLAB_MAG_CLASSES  5
+
+/** Magazine list accesses over which contention is evaluated */
+#define SLAB_MAG_WINDOW  64
+
+/** Contended accesses within a window after which magazines grow */
+#define SLAB_MAG_CONTENTION  8
+
 /** If object size is less, store control structure inside SLAB */
 #define SLAB_INSIDE_SIZE  (PAGE_SIZE >> 3)
 
@@ -74,6 +87,8 @@ typedef struct {
 typedef struct {
 	slab_magazine_t *current;
 	slab_magazine_t *last;
+	slab_magazine_t *full;   /**< Spare full magazine */
+	slab_magazine_t *empty;  /**< Spare empty magazine */
 	IRQ_SPINLOCK_DECLARE(lock);
 } slab_mag_cache_t;
 
@@ -103,6 +118,10 @@ typedef struct {
 	atomic_t cached_objs;
 	/** How many magazines in magazines list */
 	atomic_t magazine_counter;
+	/** Accesses to magazines list */
+	atomic_t magazine_exchanges;
+	/** Accesses to magazines list which had to wait for maglock */
+	atomic_t magazine_contention;
 
 	/* Slabs */
 	list_t full_slabs;     /**< List of full slabs */
@@ -111,6 +130,12 @@ typedef struct {
 	/* Magazines */
 	list_t magazines;  /**< List o full magazines */
 	IRQ_SPINLOCK_DECLARE(maglock);
+	/** Size of new magazines, protected by maglock */
+	size_t mag_size;
+	/** Accesses in the current window, protected by maglock */
+	size_t mag_window;
+	/** Contended accesses in the current window, protected by maglock */
+	size_t mag_contention;
 
 	/** CPU cache */
 	slab_mag_cache_t *mag_cache;
@@ -132,6 +157,9 @@ extern void slab_enable_cpucache(void);
 /* kconsole debug */
 extern void slab_print_list(void);
 
+/* statistics */
+extern size_t slab_stats_get(stats_slab_t *, size_t);
+
 #endif
 
 /** @}
@@ -56,7 +56,6 @@ extern void scheduler_init(void);
 
 extern void scheduler_fpu_lazy_request(void);
 extern void scheduler(void);
-extern void kcpulb(void *arg);
 
 extern void sched_print_list(void);
 
@@ -173,6 +173,15 @@ typedef struct thread {
 	bool wired;
 	/** Thread was migrated to another CPU and has not run yet. */
 	bool stolen;
+	/**
+	 * Package the thread was created on. Its memory is likely local to
+	 * that package, so other packages steal it only as a last resort.
+	 */
+	unsigned int home_package;
+	/** Clock tick of cpu when the thread last stopped running. */
+	uint64_t last_run_tick;
+	/** Cycle counter value when the thread was last made ready. */
+	uint64_t ready_cycle;
 	/** Thread is executed in user space. */
 	bool uspace;
 
@@ -37,9 +37,16 @@
 
 #ifdef CONFIG_SMP
 
+struct cpu;
+
 extern void ipi_broadcast(int);
 extern void ipi_broadcast_arch(int);
 
+#ifdef CONFIG_IPI_UNICAST
+extern void ipi_unicast(struct cpu *, int);
+extern void ipi_unicast_arch(struct cpu *, int);
+#endif
+
 #else
 
 #define ipi_broadcast(ipi)
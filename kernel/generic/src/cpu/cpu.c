@@ -82,6 +82,7 @@ void cpu_init(void)
 
 			cpus[i].stack = (uint8_t *) PA2KA(stack_phys);
 			cpus[i].id = i;
+			cpus[i].core = i;
 
 			irq_spinlock_initialize(&cpus[i].lock, "cpus[].lock");
 
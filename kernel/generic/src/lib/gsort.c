@@ -32,68 +32,252 @@
 
 /**
  * @file
- * @brief Sorting functions.
+ * @brief Stable sort.
  *
- * This files contains functions implementing several sorting
- * algorithms (e.g. quick sort and gnome sort).
+ * Historically a gnome sort, hence the name. This is an in-place merge
+ * sort: blocks sorted by insertion sort are merged with the SymMerge
+ * algorithm by Kim and Kutzner. It is stable (callers such as the MADT
+ * parser rely on that), needs no extra memory and does O(n log n)
+ * comparisons and O(n log^2 n) swaps. Elements are moved by swapping,
+ * with wide loads and stores for 4, 8 and 16 byte elements.
+ *
+ * This is the same engine as gsort() in libc uses.
  *
  */
 
 #include <gsort.h>
-#include <mem.h>
-#include <stdlib.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
-/** Immediate buffer size.
- *
- * For small buffer sizes avoid doing malloc()
- * and use the stack.
- *
- */
-#define IBUF_SIZE  32
+/** Size of blocks sorted by insertion sort before merging. */
+#define MERGE_BLOCK  20
 
-/** Array accessor.
- *
- */
-#define INDEX(buf, i, elem_size)  ((buf) + (i) * (elem_size))
+typedef uint32_t __attribute__((may_alias)) u32_alias_t;
+typedef uint64_t __attribute__((may_alias)) u64_alias_t;
+typedef unsigned long __attribute__((may_alias)) word_alias_t;
 
-/** Gnome sort
- *
- * Apply generic gnome sort algorithm on supplied data,
- * using pre-allocated buffer.
- *
- * @param data      Pointer to data to be sorted.
- * @param cnt       Number of elements to be sorted.
- * @param elem_size Size of one element.
- * @param cmp       Comparator function.
- * @param arg       3rd argument passed to cmp.
- * @param slot      Pointer to scratch memory buffer
- *                  elem_size bytes long.
+typedef enum {
+	swap_bytes,
+	swap_words,
+	swap_4,
+	swap_8,
+	swap_16
+} swap_type_t;
+
+/** Sort spec */
+typedef struct {
+	char *base;
+	size_t size;
+	swap_type_t swap;
+	sort_cmp_t cmp;
+	void *arg;
+} sort_spec_t;
+
+static void sort_spec_init(sort_spec_t *s, void *base, size_t size,
+    sort_cmp_t cmp, void *arg)
+{
+	/* Every element is aligned at least as well as this. */
+	uintptr_t align = (uintptr_t) base | size;
+
+	s->base = base;
+	s->size = size;
+	s->cmp = cmp;
+	s->arg = arg;
+
+	if (size == 4 && (align & (__alignof__(uint32_t) - 1)) == 0)
+		s->swap = swap_4;
+	else if (size == 8 && (align & (__alignof__(uint64_t) - 1)) == 0)
+		s->swap = swap_8;
+	else if (size == 16 && (align & (__alignof__(uint64_t) - 1)) == 0)
+		s->swap = swap_16;
+	else if ((align & (sizeof(unsigned long) - 1)) == 0)
+		s->swap = swap_words;
+	else
+		s->swap = swap_bytes;
+}
+
+/** Address of element with index @a i */
+static inline char *elem(sort_spec_t *s, size_t i)
+{
+	return s->base + i * s->size;
+}
+
+static inline bool elem_lt(sort_spec_t *s, void *a, void *b)
+{
+	return s->cmp(a, b, s->arg) < 0;
+}
+
+static inline void elem_swap(sort_spec_t *s, void *a, void *b)
+{
+	switch (s->swap) {
+	case swap_4: {
+		uint32_t t = *(u32_alias_t *) a;
+		*(u32_alias_t *) a = *(u32_alias_t *) b;
+		*(u32_alias_t *) b = t;
+		break;
+	}
+	case swap_16: {
+		uint64_t t = ((u64_alias_t *) a)[1];
+		((u64_alias_t *) a)[1] = ((u64_alias_t *) b)[1];
+		((u64_alias_t *) b)[1] = t;
+	}
+		/* Fallthrough */
+	case swap_8: {
+		uint64_t t = *(u64_alias_t *) a;
+		*(u64_alias_t *) a = *(u64_alias_t *) b;
+		*(u64_alias_t *) b = t;
+		break;
+	}
+	case swap_words: {
+		word_alias_t *wa = a;
+		word_alias_t *wb = b;
+
+		for (size_t k = 0; k < s->size / sizeof(unsigned long); k++) {
+			unsigned long t = wa[k];
+			wa[k] = wb[k];
+			wb[k] = t;
+		}
+		break;
+	}
+	case swap_bytes: {
+		char *ca = a;
+		char *cb = b;
+
+		for (size_t k = 0; k < s->size; k++) {
+			char t = ca[k];
+			ca[k] = cb[k];
+			cb[k] = t;
+		}
+		break;
+	}
+	}
+}
+
+/** Sort elements [lo, hi) by (stable) insertion sort. */
+static void insertion_sort(sort_spec_t *s, size_t lo, size_t hi)
+{
+	for (size_t i = lo + 1; i < hi; i++) {
+		for (size_t j = i; j > lo; j--) {
+			char *a = elem(s, j - 1);
+			char *b = elem(s, j);
+
+			if (!elem_lt(s, b, a))
+				break;
+			elem_swap(s, a, b);
+		}
+	}
+}
+
+/** Swap elements [a, a + n) with [b, b + n). */
+static void swap_range(sort_spec_t *s, size_t a, size_t b, size_t n)
+{
+	for (size_t i = 0; i < n; i++)
+		elem_swap(s, elem(s, a + i), elem(s, b + i));
+}
+
+/** Rotate elements [a, b) so that the element at @a m comes first. */
+static void rotate(sort_spec_t *s, size_t a, size_t m, size_t b)
+{
+	size_t i = m - a;
+	size_t j = b - m;
+
+	while (i != j) {
+		if (i > j) {
+			swap_range(s, m - i, m, j);
+			i -= j;
+		} else {
+			swap_range(s, m - i, m + j - i, i);
+			j -= i;
+		}
+	}
+
+	swap_range(s, m - i, m, i);
+}
+
+/** Merge sorted runs [a, m) and [m, b) in place, keeping it stable.
  *
+ * This is the SymMerge algorithm from P. Kim and A. Kutzner, "Stable
+ * Minimum Storage Merging by Symmetric Comparisons", ESA 2004.
  */
-static void _gsort(void *data, size_t cnt, size_t elem_size, sort_cmp_t cmp,
-    void *arg, void *slot)
+static void sym_merge(sort_spec_t *s, size_t a, size_t m, size_t b)
 {
-	size_t i = 0;
-
-	while (i < cnt) {
-		if ((i != 0) &&
-		    (cmp(INDEX(data, i, elem_size),
-		    INDEX(data, i - 1, elem_size), arg) == -1)) {
-			memcpy(slot, INDEX(data, i, elem_size), elem_size);
-			memcpy(INDEX(data, i, elem_size), INDEX(data, i - 1, elem_size),
-			    elem_size);
-			memcpy(INDEX(data, i - 1, elem_size), slot, elem_size);
-			i--;
-		} else
-			i++;
+	size_t i, j, h;
+
+	if (m - a == 1) {
+		/* Insert the single element at a into [m, b). */
+		i = m;
+		j = b;
+		while (i < j) {
+			h = i + (j - i) / 2;
+			if (elem_lt(s, elem(s, h), elem(s, a)))
+				i = h + 1;
+			else
+				j = h;
+		}
+
+		for (size_t k = a; k + 1 < i; k++)
+			elem_swap(s, elem(s, k), elem(s, k + 1));
+		return;
+	}
+
+	if (b - m == 1) {
+		/* Insert the single element at m into [a, m). */
+		i = a;
+		j = m;
+		while (i < j) {
+			h = i + (j - i) / 2;
+			if (!elem_lt(s, elem(s, m), elem(s, h)))
+				i = h + 1;
+			else
+				j = h;
+		}
+
+		for (size_t k = m; k > i; k--)
+			elem_swap(s, elem(s, k), elem(s, k - 1));
+		return;
 	}
+
+	size_t mid = a + (b - a) / 2;
+	size_t n = mid + m;
+	size_t start, r;
+
+	if (m > mid) {
+		start = n - b;
+		r = mid;
+	} else {
+		start = a;
+		r = m;
+	}
+
+	size_t p = n - 1;
+	while (start < r) {
+		size_t c = start + (r - start) / 2;
+		if (!elem_lt(s, elem(s, p - c), elem(s, c)))
+			start = c + 1;
+		else
+			r = c;
+	}
+
+	size_t end = n - start;
+	if (start < m && m < end)
+		rotate(s, start, m, end);
+	if (a < start && start < mid)
+		sym_merge(s, a, start, mid);
+	if (mid < end && end < b)
+		sym_merge(s, mid, end, b);
+}
+
+/** Merge sorted runs [a, m) and [m, b) unless they are in order already. */
+static void merge(sort_spec_t *s, size_t a, size_t m, size_t b)
+{
+	if (elem_lt(s, elem(s, m), elem(s, m - 1)))
+		sym_merge(s, a, m, b);
 }
 
-/** Gnome sort wrapper
+/** Stable sort
  *
- * This is only a wrapper that takes care of memory
- * allocations for storing the slot element for generic
- * gnome sort algorithm.
+ * Equal elements keep their relative order.
  *
  * @param data      Pointer to data to be sorted.
  * @param cnt       Number of elements to be sorted.
@@ -101,25 +285,31 @@ static void _gsort(void *data, size_t cnt, size_t elem_size, sort_cmp_t cmp,
  * @param cmp       Comparator function.
  * @param arg       3rd argument passed to cmp.
  *
- * @return True if sorting succeeded.
+ * @return True if sorting succeeded (it always does, the sort does not
+ *         need any extra memory).
  *
  */
 bool gsort(void *data, size_t cnt, size_t elem_size, sort_cmp_t cmp, void *arg)
 {
-	uint8_t ibuf_slot[IBUF_SIZE];
-	void *slot;
+	sort_spec_t s;
+	size_t a;
+
+	if (cnt < 2 || elem_size == 0)
+		return true;
 
-	if (elem_size > IBUF_SIZE) {
-		slot = (void *) malloc(elem_size);
-		if (!slot)
-			return false;
-	} else
-		slot = (void *) ibuf_slot;
+	sort_spec_init(&s, data, elem_size, cmp, arg);
 
-	_gsort(data, cnt, elem_size, cmp, arg, slot);
+	for (a = 0; a + MERGE_BLOCK < cnt; a += MERGE_BLOCK)
+		insertion_sort(&s, a, a + MERGE_BLOCK);
+	insertion_sort(&s, a, cnt);
 
-	if (elem_size > IBUF_SIZE)
-		free(slot);
+	for (size_t block = MERGE_BLOCK; block < cnt; block *= 2) {
+		for (a = 0; a + 2 * block <= cnt; a += 2 * block)
+			merge(&s, a, a + block, a + 2 * block);
+
+		if (a + block < cnt)
+			merge(&s, a, a + block, cnt);
+	}
 
 	return true;
 }
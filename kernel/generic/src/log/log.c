@@ -43,6 +43,14 @@
 #include <panic.h>
 #include <putchar.h>
 #include <atomic.h>
+#include <barrier.h>
+#include <align.h>
+#include <macros.h>
+#include <mem.h>
+#include <config.h>
+#include <cpu.h>
+#include <mm/frame.h>
+#include <time/clock.h>
 #include <syscall/copy.h>
 #include <errno.h>
 #include <str.h>
@@ -54,148 +62,347 @@
 #include <abi/log.h>
 #include <stdlib.h>
 
-#define LOG_PAGES    8
-#define LOG_LENGTH   (LOG_PAGES * PAGE_SIZE)
-#define LOG_ENTRY_HEADER_LENGTH (sizeof(size_t) + sizeof(uint32_t))
+/*
+ * Every CPU logs into a ring of its own. Only the owning CPU writes into
+ * the ring and it does so with interrupts disabled, so the writers need
+ * no locking. An entry is composed in a per-CPU buffer first and copied
+ * into the ring as a whole in log_end(), when its length is known. If the
+ * ring is full, the entry is dropped instead of discarding older ones, so
+ * that the reader never sees an entry being overwritten.
+ *
+ * The rings are merged according to the entry serial numbers only when
+ * they are read, either by sys_klog() or directly by the task which maps
+ * them (see abi/klog.h).
+ */
 
-/** Cyclic buffer holding the data for kernel log */
-uint8_t log_buffer[LOG_LENGTH] __attribute__((aligned(PAGE_SIZE)));
+#define LOG_RING_PAGES  8
+#define LOG_RING_SIZE   (LOG_RING_PAGES * PAGE_SIZE)
 
-/** Kernel log initialized */
-static atomic_bool log_inited = false;
+/** Maximal length of a log entry including the header */
+#define LOG_ENTRY_MAX  PAGE_SIZE
 
-/** Position in the cyclic buffer where the first log entry starts */
-size_t log_start = 0;
+/** Per-CPU kernel log */
+typedef struct {
+	/** Ring header shared with the reader */
+	klog_ring_t *ring;
+	/** Ring data */
+	uint8_t *data;
 
-/** Sum of length of all log entries currently stored in the cyclic buffer */
-size_t log_used = 0;
+	/** Position after the last complete entry */
+	size_t head;
 
-/** Log spinlock */
-SPINLOCK_STATIC_INITIALIZE_NAME(log_lock, "log_lock");
+	/** Nesting level of log_begin() */
+	unsigned int nesting;
+	/** Interrupt level to be restored by log_end() */
+	ipl_t ipl;
 
-/** Overall count of logged messages, which may overflow as needed */
-static uint32_t log_counter = 0;
+	/** Length of the entry being composed */
+	size_t len;
+	/** Entry being composed */
+	union {
+		klog_entry_t header;
+		uint8_t data[LOG_ENTRY_MAX];
+	} entry;
+} log_cpu_t;
+
+/** Ring header used before the per-CPU rings are allocated */
+static klog_ring_t log_boot_ring;
 
-/** Starting position of the entry currently being written to the log */
-static size_t log_current_start = 0;
+/** Ring data used before the per-CPU rings are allocated */
+static uint8_t log_boot_data[LOG_RING_SIZE]
+    __attribute__((aligned(KLOG_ENTRY_ALIGN)));
 
-/** Length (including header) of the entry currently being written to the log */
-static size_t log_current_len = 0;
+/** Log used before the per-CPU rings are allocated */
+static log_cpu_t log_boot_cpu = {
+	.ring = &log_boot_ring,
+	.data = log_boot_data
+};
 
-/** Start of the next entry to be handed to uspace starting from log_start */
-static size_t next_for_uspace = 0;
+/** Per-CPU logs */
+static log_cpu_t *log_cpus = NULL;
+
+/** Number of per-CPU logs */
+static size_t log_count = 0;
+
+/** Physical memory area with the rings */
+static parea_t log_parea;
+
+/** Kernel log initialized */
+static atomic_bool log_inited = false;
+
+/** Overall count of logged messages, which may overflow as needed */
+static atomic_size_t log_counter = 0;
 
+/** The reader has been notified and has not unmasked the event yet */
+static atomic_bool log_notified = false;
+
+/** Serializes sys_klog() readers */
+SPINLOCK_STATIC_INITIALIZE_NAME(log_read_lock, "log_read_lock");
+
+static void log_notify(void);
 static void log_update(void *);
 
+/** Get the log of the current CPU
+ *
+ * Interrupts must be disabled.
+ *
+ */
+static log_cpu_t *log_cpu_get(void)
+{
+	if ((CPU != NULL) && (log_cpus != NULL))
+		return &log_cpus[CPU->id];
+
+	return &log_boot_cpu;
+}
+
 /** Initialize kernel logging facility
+ *
+ * Allocate the per-CPU rings and export them to uspace. This must happen
+ * before application processors start, as until then all entries go to
+ * a single static ring.
  *
  */
 void log_init(void)
 {
+	static_assert(sizeof(klog_ring_t) <= KLOG_RING_HEADER_SIZE, "");
+
+	size_t count = config.cpu_count;
+	size_t header_frames = SIZE2FRAMES(count * KLOG_RING_HEADER_SIZE);
+	size_t frames = header_frames + count * LOG_RING_PAGES;
+
+	log_cpu_t *cpus = malloc(sizeof(log_cpu_t) * count);
+	if (cpus == NULL)
+		panic("Cannot allocate kernel log.");
+
+	uintptr_t faddr = frame_alloc(frames, FRAME_LOWMEM | FRAME_ATOMIC, 0);
+	if (faddr == 0)
+		panic("Cannot allocate kernel log rings.");
+
+	uint8_t *area = (uint8_t *) PA2KA(faddr);
+	memsetb(area, FRAMES2SIZE(header_frames), 0);
+
+	for (size_t i = 0; i < count; i++) {
+		cpus[i].ring = (klog_ring_t *) (area + i * KLOG_RING_HEADER_SIZE);
+		cpus[i].ring->size = LOG_RING_SIZE;
+		cpus[i].data = area + FRAMES2SIZE(header_frames) +
+		    i * LOG_RING_SIZE;
+		cpus[i].head = 0;
+		cpus[i].nesting = 0;
+		cpus[i].len = 0;
+	}
+
+	/* Move the entries logged so far to the ring of this CPU */
+	ipl_t ipl = interrupts_disable();
+
+	log_cpu_t *cpu = &cpus[CPU->id];
+	memcpy(cpu->data, log_boot_cpu.data, LOG_RING_SIZE);
+	cpu->head = log_boot_cpu.head;
+	cpu->ring->head = log_boot_ring.head;
+	cpu->ring->dropped = log_boot_ring.dropped;
+
+	log_cpus = cpus;
+	log_count = count;
+
+	interrupts_restore(ipl);
+
+	ddi_parea_init(&log_parea);
+	log_parea.pbase = faddr;
+	log_parea.frames = frames;
+	log_parea.unpriv = false;
+	log_parea.mapped = false;
+	ddi_parea_register(&log_parea);
+
+	sysinfo_set_item_val("klog.faddr", NULL, (sysarg_t) faddr);
+	sysinfo_set_item_val("klog.pages", NULL, frames);
+	sysinfo_set_item_val("klog.rings", NULL, count);
+	sysinfo_set_item_val("klog.ring_size", NULL, LOG_RING_SIZE);
+	sysinfo_set_item_val("klog.data_offset", NULL,
+	    FRAMES2SIZE(header_frames));
+
 	event_set_unmask_callback(EVENT_KLOG, log_update);
 	atomic_store(&log_inited, true);
 }
 
-static size_t log_copy_from(uint8_t *data, size_t pos, size_t len)
+/** Get the time since boot in microseconds
+ *
+ */
+static uint64_t log_timestamp(void)
 {
-	for (size_t i = 0; i < len; i++, pos = (pos + 1) % LOG_LENGTH) {
-		data[i] = log_buffer[pos];
-	}
-	return pos;
+	if (uptime == NULL)
+		return 0;
+
+	sysarg_t s2 = uptime->seconds2;
+	read_barrier();
+	sysarg_t us = uptime->useconds;
+	read_barrier();
+	sysarg_t s1 = uptime->seconds1;
+
+	if (s1 != s2)
+		return (uint64_t) max(s1, s2) * 1000000;
+
+	return (uint64_t) s1 * 1000000 + us;
 }
 
-static size_t log_copy_to(const uint8_t *data, size_t pos, size_t len)
+/** Append data to the currently open log entry.
+ *
+ * Data which do not fit into the entry are dropped.
+ */
+static void log_append(log_cpu_t *cpu, const uint8_t *data, size_t len)
 {
-	for (size_t i = 0; i < len; i++, pos = (pos + 1) % LOG_LENGTH) {
-		log_buffer[pos] = data[i];
-	}
-	return pos;
+	if (len > LOG_ENTRY_MAX - cpu->len)
+		len = LOG_ENTRY_MAX - cpu->len;
+
+	memcpy(cpu->entry.data + cpu->len, data, len);
+	cpu->len += len;
 }
 
-/** Append data to the currently open log entry.
+/** Copy the composed entry into the ring
  *
- * This function requires that the log_lock is acquired by the caller.
+ * @return True if the entry was stored, false if the ring is full.
  */
-static void log_append(const uint8_t *data, size_t len)
+static bool log_store(log_cpu_t *cpu)
 {
-	/* Cap the length so that the entry entirely fits into the buffer */
-	if (len > LOG_LENGTH - log_current_len) {
-		len = LOG_LENGTH - log_current_len;
-	}
+	klog_ring_t *ring = cpu->ring;
+	size_t len = ALIGN_UP(cpu->len, KLOG_ENTRY_ALIGN);
 
-	if (len == 0)
-		return;
+	/* The tail might be written by a uspace task, do not trust it */
+	size_t used = cpu->head - ACCESS_ONCE(ring->tail);
+	if (used > LOG_RING_SIZE)
+		used = LOG_RING_SIZE;
+
+	size_t offset = cpu->head % LOG_RING_SIZE;
+	size_t skip = 0;
 
-	size_t log_free = LOG_LENGTH - log_used - log_current_len;
+	/* Entries do not wrap around, leave the rest of the ring unused */
+	if (LOG_RING_SIZE - offset < len)
+		skip = LOG_RING_SIZE - offset;
 
-	/* Discard older entries to make space, if necessary */
-	while (len > log_free) {
-		size_t entry_len;
-		log_copy_from((uint8_t *) &entry_len, log_start, sizeof(size_t));
-		log_start = (log_start + entry_len) % LOG_LENGTH;
-		log_used -= entry_len;
-		log_free += entry_len;
-		next_for_uspace -= entry_len;
+	if (skip + len > LOG_RING_SIZE - used) {
+		ring->dropped++;
+		return false;
 	}
 
-	size_t pos = (log_current_start + log_current_len) % LOG_LENGTH;
-	log_copy_to(data, pos, len);
-	log_current_len += len;
+	if (skip > 0) {
+		if (skip >= sizeof(klog_entry_t))
+			((klog_entry_t *) (cpu->data + offset))->len = 0;
+
+		offset = 0;
+	}
+
+	memcpy(cpu->data + offset, cpu->entry.data, cpu->len);
+	cpu->head += skip + len;
+
+	/* Publish the entry */
+	write_barrier();
+	ACCESS_ONCE(ring->head) = cpu->head;
+
+	return true;
 }
 
 /** Begin writing an entry to the log.
  *
- * This acquires the log and output buffer locks, so only calls to log_* functions should
+ * This disables interrupts, so only calls to log_* functions should
  * be used until calling log_end.
  */
 void log_begin(log_facility_t fac, log_level_t level)
 {
-	spinlock_lock(&log_lock);
-	spinlock_lock(&kio_lock);
+	ipl_t ipl = interrupts_disable();
+	log_cpu_t *cpu = log_cpu_get();
 
-	log_current_start = (log_start + log_used) % LOG_LENGTH;
-	log_current_len = 0;
+	/* An entry logged while composing another one is merged into it */
+	if (cpu->nesting++ > 0)
+		return;
 
-	/* Write header of the log entry, the length will be written in log_end() */
-	log_append((uint8_t *) &log_current_len, sizeof(size_t));
-	log_append((uint8_t *) &log_counter, sizeof(uint32_t));
-	uint32_t fac32 = fac;
-	uint32_t lvl32 = level;
-	log_append((uint8_t *) &fac32, sizeof(uint32_t));
-	log_append((uint8_t *) &lvl32, sizeof(uint32_t));
+	cpu->ipl = ipl;
+	cpu->len = sizeof(klog_entry_t);
 
-	log_counter++;
+	cpu->entry.header.serial = atomic_fetch_add_explicit(&log_counter, 1,
+	    memory_order_relaxed);
+	cpu->entry.header.facility = fac;
+	cpu->entry.header.level = level;
+	cpu->entry.header.timestamp = log_timestamp();
+	cpu->entry.header.cpu = (CPU != NULL) ? CPU->id : 0;
+	cpu->entry.header.reserved = 0;
 }
 
 /** Finish writing an entry to the log.
  *
- * This releases the log and output buffer locks.
+ * This stores the entry into the ring, prints it and restores interrupts.
  */
 void log_end(void)
 {
-	/* Set the length in the header to correct value */
-	log_copy_to((uint8_t *) &log_current_len, log_current_start, sizeof(size_t));
-	log_used += log_current_len;
+	log_cpu_t *cpu = log_cpu_get();
+
+	if (--cpu->nesting > 0)
+		return;
+
+	cpu->entry.header.len = cpu->len;
+	bool stored = log_store(cpu);
+
+	const char *message = cpu->entry.header.message;
+	size_t size = cpu->len - sizeof(klog_entry_t);
+	size_t offset = 0;
+
+	spinlock_lock(&kio_lock);
+
+	while (offset < size)
+		kio_push_char(str_decode(message, &offset, size));
 
 	kio_push_char('\n');
 	spinlock_unlock(&kio_lock);
-	spinlock_unlock(&log_lock);
 
-	/* This has to be called after we released the locks above */
+	interrupts_restore(cpu->ipl);
+
+	/* This has to be called with interrupts enabled */
 	kio_flush();
 	kio_update(NULL);
-	log_update(NULL);
+
+	if (stored)
+		log_notify();
 }
 
-static void log_update(void *event)
+/** Check whether any ring contains unread entries
+ *
+ */
+static bool log_unread(void)
+{
+	for (size_t i = 0; i < log_count; i++) {
+		klog_ring_t *ring = log_cpus[i].ring;
+
+		if (ACCESS_ONCE(ring->head) != ACCESS_ONCE(ring->tail))
+			return true;
+	}
+
+	return false;
+}
+
+/** Notify the reader about new entries
+ *
+ * Only the first entry after the reader has unmasked the event results
+ * in a notification, log_update() checks the rings again on the unmask.
+ *
+ */
+static void log_notify(void)
 {
 	if (!atomic_load(&log_inited))
 		return;
 
-	spinlock_lock(&log_lock);
-	if (next_for_uspace < log_used)
+	memory_barrier();
+
+	if (!atomic_exchange(&log_notified, true))
 		event_notify_0(EVENT_KLOG, true);
-	spinlock_unlock(&log_lock);
+}
+
+static void log_update(void *event)
+{
+	if (!atomic_load(&log_inited))
+		return;
+
+	atomic_store(&log_notified, false);
+	memory_barrier();
+
+	if (log_unread())
+		log_notify();
 }
 
 static int log_printf_str_write(const char *str, size_t size, void *data)
@@ -204,11 +411,11 @@ static int log_printf_str_write(const char *str, size_t size, void *data)
 	size_t chars = 0;
 
 	while (offset < size) {
-		kio_push_char(str_decode(str, &offset, size));
+		str_decode(str, &offset, size);
 		chars++;
 	}
 
-	log_append((const uint8_t *)str, size);
+	log_append(data, (const uint8_t *) str, size);
 
 	return chars;
 }
@@ -220,15 +427,13 @@ static int log_printf_wstr_write(const char32_t *wstr, size_t size, void *data)
 	size_t chars = 0;
 
 	for (offset = 0; offset < size; offset += sizeof(char32_t), chars++) {
-		kio_push_char(wstr[chars]);
-
 		size_t buffer_offset = 0;
 		errno_t rc = chr_encode(wstr[chars], buffer, &buffer_offset, 16);
 		if (rc != EOK) {
 			return EOF;
 		}
 
-		log_append((const uint8_t *)buffer, buffer_offset);
+		log_append(data, (const uint8_t *) buffer, buffer_offset);
 	}
 
 	return chars;
@@ -245,7 +450,7 @@ int log_vprintf(const char *fmt, va_list args)
 	printf_spec_t ps = {
 		log_printf_str_write,
 		log_printf_wstr_write,
-		NULL
+		log_cpu_get()
 	};
 
 	ret = printf_core(fmt, &ps, args);
@@ -291,6 +496,45 @@ int log(log_facility_t fac, log_level_t level, const char *fmt, ...)
 	return ret;
 }
 
+/** Find the first unread entry of a ring
+ *
+ * Skips the unused rest of the ring before it wraps around.
+ * Requires that the log_read_lock is acquired by the caller.
+ *
+ * @return The entry or NULL if the ring has no unread entries.
+ */
+static klog_entry_t *log_ring_first(log_cpu_t *cpu)
+{
+	klog_ring_t *ring = cpu->ring;
+	size_t head = ACCESS_ONCE(ring->head);
+	read_barrier();
+
+	/* The tail might have been left behind by a uspace reader */
+	if (head - ring->tail > LOG_RING_SIZE)
+		ring->tail = head;
+
+	while (ring->tail != head) {
+		size_t offset = ring->tail % LOG_RING_SIZE;
+		size_t rest = LOG_RING_SIZE - offset;
+		klog_entry_t *entry = (klog_entry_t *) (cpu->data + offset);
+
+		if ((rest < sizeof(klog_entry_t)) || (entry->len == 0)) {
+			ring->tail += rest;
+			continue;
+		}
+
+		if ((entry->len < sizeof(klog_entry_t)) || (entry->len > rest)) {
+			/* Not at an entry boundary, skip everything */
+			ring->tail = head;
+			break;
+		}
+
+		return entry;
+	}
+
+	return NULL;
+}
+
 /** Control of the log from uspace
  *
  */
@@ -324,53 +568,61 @@ sys_errno_t sys_klog(sysarg_t operation, uspace_addr_t buf, size_t size,
 		free(data);
 		return EOK;
 	case KLOG_READ:
+		/* The task which mapped the rings drains them by itself */
+		if (log_parea.mapped)
+			return (sys_errno_t) EBUSY;
+
 		data = (char *) malloc(size);
 		if (!data)
 			return (sys_errno_t) ENOMEM;
 
-		size_t entry_len = 0;
 		size_t copied = 0;
 
 		rc = EOK;
 
-		spinlock_lock(&log_lock);
-
-		while (next_for_uspace < log_used) {
-			size_t pos = (log_start + next_for_uspace) % LOG_LENGTH;
-			log_copy_from((uint8_t *) &entry_len, pos, sizeof(size_t));
-
-			if (entry_len > PAGE_SIZE) {
-				/*
-				 * Since we limit data transfer
-				 * to uspace to a maximum of PAGE_SIZE
-				 * bytes, skip any entries larger
-				 * than this limit to prevent
-				 * userspace being stuck trying to
-				 * read them.
-				 */
-				next_for_uspace += entry_len;
-				continue;
+		spinlock_lock(&log_read_lock);
+
+		while (true) {
+			/* Merge the rings in the order of serial numbers */
+			log_cpu_t *cpu = NULL;
+			klog_entry_t *entry = NULL;
+
+			for (size_t i = 0; i < log_count; i++) {
+				klog_entry_t *first = log_ring_first(&log_cpus[i]);
+				if ((first != NULL) && ((entry == NULL) ||
+				    ((int32_t) (first->serial - entry->serial) < 0))) {
+					cpu = &log_cpus[i];
+					entry = first;
+				}
 			}
 
+			if (entry == NULL)
+				break;
+
+			size_t entry_len = ALIGN_UP(entry->len, KLOG_ENTRY_ALIGN);
+
 			if (size < copied + entry_len) {
 				if (copied == 0)
 					rc = EOVERFLOW;
 				break;
 			}
 
-			log_copy_from((uint8_t *) (data + copied), pos, entry_len);
+			memcpy(data + copied, entry, entry->len);
 			copied += entry_len;
-			next_for_uspace += entry_len;
+
+			/* Release the space only after the entry is copied */
+			memory_barrier();
+			cpu->ring->tail += entry_len;
 		}
 
-		spinlock_unlock(&log_lock);
+		spinlock_unlock(&log_read_lock);
 
 		if (rc != EOK) {
 			free(data);
 			return (sys_errno_t) rc;
 		}
 
-		rc = copy_to_uspace(buf, data, size);
+		rc = copy_to_uspace(buf, data, copied);
 
 		free(data);
 
@@ -378,7 +630,6 @@ sys_errno_t sys_klog(sysarg_t operation, uspace_addr_t buf, size_t size,
 			return (sys_errno_t) rc;
 
 		return copy_to_uspace(uspace_nread, &copied, sizeof(copied));
-		return EOK;
 	default:
 		return (sys_errno_t) ENOTSUP;
 	}
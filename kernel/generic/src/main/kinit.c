@@ -114,9 +114,7 @@ void kinit(void *arg)
 
 		/*
 		 * Create the kmp thread and wait for its completion.
-		 * cpu1 through cpuN-1 will come up consecutively and
-		 * not mess together with kcpulb threads.
-		 * Just a beautification.
+		 * cpu1 through cpuN-1 will come up consecutively.
 		 */
 		thread = thread_create(kmp, NULL, TASK,
 		    THREAD_FLAG_UNCOUNTED, "kmp");
@@ -127,22 +125,6 @@ void kinit(void *arg)
 		thread_ready(thread);
 		thread_join(thread);
 		thread_detach(thread);
-
-		/*
-		 * For each CPU, create its load balancing thread.
-		 */
-		unsigned int i;
-
-		for (i = 0; i < config.cpu_count; i++) {
-			thread = thread_create(kcpulb, NULL, TASK,
-			    THREAD_FLAG_UNCOUNTED, "kcpulb");
-			if (thread != NULL) {
-				thread_wire(thread, &cpus[i]);
-				thread_ready(thread);
-			} else
-				log(LF_OTHER, LVL_ERROR,
-				    "Unable to create kcpulb thread for cpu%u", i);
-		}
 	}
 #endif /* CONFIG_SMP */
 
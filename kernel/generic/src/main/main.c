@@ -261,6 +261,7 @@ void main_bsp_separated_stack(void)
 
 	/* Slab must be initialized after we know the number of processors. */
 	slab_enable_cpucache();
+	frame_enable_cpucache();
 
 	uint64_t size;
 	const char *size_suffix;
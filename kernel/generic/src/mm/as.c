@@ -53,6 +53,7 @@
 #include <mm/frame.h>
 #include <mm/slab.h>
 #include <mm/tlb.h>
+#include <mm/reserve.h>
 #include <arch/mm/page.h>
 #include <genarch/mm/page_pt.h>
 #include <genarch/mm/page_ht.h>
@@ -118,6 +119,8 @@ as_t *AS_KERNEL = NULL;
 static void *as_areas_getkey(odlink_t *);
 static int as_areas_cmp(void *, void *);
 
+static void as_deferred_flush(as_t *);
+
 static void used_space_initialize(used_space_t *);
 static void used_space_finalize(used_space_t *);
 static void *used_space_getkey(odlink_t *);
@@ -183,6 +186,10 @@ as_t *as_create(unsigned int flags)
 
 	refcount_init(&as->refcount);
 	as->cpu_refcount = 0;
+	atomic_store(&as->tlb_cpus, 0);
+	as->tlb_deferred.collect = false;
+	as->tlb_deferred.count = 0;
+	as->tlb_deferred.frames_count = 0;
 
 #ifdef AS_PAGE_TABLE
 	as->genarch.page_table = page_table_create(flags);
@@ -243,6 +250,14 @@ retry:
 		asid_put(as->asid);
 	}
 
+	/*
+	 * No processor runs the address space any more and its ASID is purged
+	 * from all TLBs before it is handed out again. Destroying the address
+	 * space areas below therefore needs no other processor to take part
+	 * in the TLB shootdowns.
+	 */
+	atomic_store(&as->tlb_cpus, 0);
+
 	spinlock_unlock(&asidlock);
 	interrupts_restore(ipl);
 
@@ -261,6 +276,10 @@ retry:
 		area = as_area_first(as);
 	}
 
+	mutex_lock(&as->lock);
+	as_deferred_flush(as);
+	mutex_unlock(&as->lock);
+
 	odict_finalize(&as->as_areas);
 
 #ifdef AS_PAGE_TABLE
@@ -685,6 +704,167 @@ _NO_TRACE void as_pagemap_remove(as_page_mapping_t *mapping)
 	slab_free(as_page_mapping_cache, mapping);
 }
 
+/** Shoot down the deferred range of pages and free the kept frames.
+ *
+ * The range stays deferred, as more pages in it may be about to be
+ * unmapped.
+ *
+ * @param as Address space, locked.
+ *
+ */
+_NO_TRACE static void as_deferred_shootdown(as_t *as)
+{
+	as_deferred_t *def = &as->tlb_deferred;
+
+	if (def->count == 0)
+		return;
+
+	ipl_t ipl = tlb_shootdown_start_as(as, TLB_INVL_PAGES, def->page,
+	    def->count);
+	tlb_invalidate_pages(as->asid, def->page, def->count);
+	tlb_shootdown_finalize(ipl);
+
+	for (size_t i = 0; i < def->frames_count; i++) {
+		as_deferred_frame_t *df = &def->frames[i];
+
+		frame_free_generic(df->frame, df->count, df->flags);
+		if (df->flags & FRAME_NO_RESERVE)
+			reserve_free(df->count);
+	}
+
+	def->frames_count = 0;
+}
+
+/** Complete the deferred TLB shootdown of an address space.
+ *
+ * Must be done before pages in the deferred range can be mapped again,
+ * as other processors could otherwise keep using the old mappings.
+ *
+ * @param as Address space, locked.
+ *
+ */
+_NO_TRACE static void as_deferred_flush(as_t *as)
+{
+	as_deferred_shootdown(as);
+	as->tlb_deferred.count = 0;
+}
+
+/** Start unmapping pages with a deferred TLB shootdown.
+ *
+ * The pages are added to the deferred range of the address space. If they
+ * lie too far from it, the deferred shootdown is completed first. Until
+ * as_deferred_end(), frames released by as_frame_free() are kept until the
+ * shootdown.
+ *
+ * @param as    Address space, locked.
+ * @param page  First page to be unmapped.
+ * @param count Number of pages to be unmapped.
+ *
+ */
+_NO_TRACE static void as_deferred_begin(as_t *as, uintptr_t page,
+    size_t count)
+{
+	as_deferred_t *def = &as->tlb_deferred;
+
+	assert(page_table_locked(as));
+	assert(!def->collect);
+
+	if (def->count > 0) {
+		uintptr_t start = min(def->page, page);
+		uintptr_t end = max(def->page + P2SZ(def->count),
+		    page + P2SZ(count));
+		size_t span = (end - start) >> PAGE_WIDTH;
+
+		if (span <= def->count + count + AS_DEFERRED_GAP) {
+			def->page = start;
+			def->count = span;
+		} else {
+			as_deferred_flush(as);
+		}
+	}
+
+	if (def->count == 0) {
+		def->page = page;
+		def->count = count;
+	}
+
+	def->collect = true;
+}
+
+/** Finish unmapping pages with a deferred TLB shootdown.
+ *
+ * The pages are invalidated in the TLB of this processor and in the
+ * software translation caches right away. The other processors are left
+ * for the deferred shootdown unless it has to be done now. This is the
+ * case when the frames of the pages are released other than through
+ * as_frame_free(), e.g. by the destroy function of the backend.
+ *
+ * @param as    Address space, locked.
+ * @param page  First unmapped page.
+ * @param count Number of unmapped pages.
+ * @param lazy  Whether the other processors can be left for later.
+ *
+ */
+_NO_TRACE static void as_deferred_end(as_t *as, uintptr_t page,
+    size_t count, bool lazy)
+{
+	as->tlb_deferred.collect = false;
+
+	ipl_t ipl = interrupts_disable();
+	tlb_invalidate_pages(as->asid, page, count);
+
+	/*
+	 * Invalidate potential software translation caches
+	 * (e.g. TSB on sparc64, PHT on ppc32).
+	 */
+	as_invalidate_translation_cache(as, page, count);
+	interrupts_restore(ipl);
+
+	if (!lazy)
+		as_deferred_flush(as);
+}
+
+/** Free frames of an unmapped page or page table.
+ *
+ * Other processors may still access the frames through stale TLB entries
+ * until the deferred TLB shootdown is done, so the frames are kept until
+ * then if they are released between as_deferred_begin() and
+ * as_deferred_end(). Their reservation is kept as well, since backends
+ * may return the reserve of an area before its frames.
+ *
+ * @param as    Address space of the page, NULL for kernel page tables
+ *              created before the kernel address space.
+ * @param frame First frame.
+ * @param count Number of frames.
+ * @param flags Flags passed to frame_free_generic().
+ *
+ */
+void as_frame_free(as_t *as, uintptr_t frame, size_t count,
+    frame_flags_t flags)
+{
+	if ((as == NULL) || (!as->tlb_deferred.collect)) {
+		frame_free_generic(frame, count, flags);
+		return;
+	}
+
+	as_deferred_t *def = &as->tlb_deferred;
+
+	/*
+	 * All the kept frames are already unmapped, unlike the frame being
+	 * released now.
+	 */
+	if (def->frames_count == AS_DEFERRED_FRAMES)
+		as_deferred_shootdown(as);
+
+	if (flags & FRAME_NO_RESERVE)
+		reserve_force_alloc(count);
+
+	as_deferred_frame_t *df = &def->frames[def->frames_count++];
+	df->frame = frame;
+	df->count = count;
+	df->flags = flags;
+}
+
 /** Remove reference to address space area share info.
  *
  * If the reference count drops to 0, the sh_info is deallocated.
@@ -778,6 +958,11 @@ as_area_t *as_area_create(as_t *as, unsigned int flags, size_t size,
 		return NULL;
 	}
 
+	/*
+	 * The area may cover pages still waiting for the TLB shootdown.
+	 */
+	as_deferred_flush(as);
+
 	as_area_t *area = (as_area_t *) malloc(sizeof(as_area_t));
 	if (!area) {
 		mutex_unlock(&as->lock);
@@ -954,8 +1139,7 @@ errno_t as_area_resize(as_t *as, uintptr_t address, size_t size, unsigned int fl
 		 * Start TLB shootdown sequence.
 		 */
 
-		ipl_t ipl = tlb_shootdown_start(TLB_INVL_PAGES,
-		    as->asid, area->base + P2SZ(pages),
+		as_deferred_begin(as, area->base + P2SZ(pages),
 		    area->pages - pages);
 
 		/*
@@ -1030,18 +1214,9 @@ errno_t as_area_resize(as_t *as, uintptr_t address, size_t size, unsigned int fl
 		 * Finish TLB shootdown sequence.
 		 */
 
-		tlb_invalidate_pages(as->asid,
-		    area->base + P2SZ(pages),
-		    area->pages - pages);
-
-		/*
-		 * Invalidate software translation caches
-		 * (e.g. TSB on sparc64, PHT on ppc32).
-		 */
-		as_invalidate_translation_cache(as,
-		    area->base + P2SZ(pages),
-		    area->pages - pages);
-		tlb_shootdown_finalize(ipl);
+		as_deferred_end(as, area->base + P2SZ(pages),
+		    area->pages - pages,
+		    (area->backend) && (area->backend->frame_free));
 
 		page_table_unlock(as, false);
 	} else {
@@ -1061,6 +1236,12 @@ errno_t as_area_resize(as_t *as, uintptr_t address, size_t size, unsigned int fl
 			mutex_unlock(&as->lock);
 			return EADDRNOTAVAIL;
 		}
+
+		/*
+		 * The area may grow into pages still waiting for
+		 * the TLB shootdown.
+		 */
+		as_deferred_flush(as);
 	}
 
 	if (area->backend && area->backend->resize) {
@@ -1104,8 +1285,7 @@ errno_t as_area_destroy(as_t *as, uintptr_t address)
 	/*
 	 * Start TLB shootdown sequence.
 	 */
-	ipl_t ipl = tlb_shootdown_start(TLB_INVL_PAGES, as->asid, area->base,
-	    area->pages);
+	as_deferred_begin(as, area->base, area->pages);
 
 	/*
 	 * Visit only the pages mapped by used_space.
@@ -1142,14 +1322,8 @@ errno_t as_area_destroy(as_t *as, uintptr_t address)
 	 * Finish TLB shootdown sequence.
 	 */
 
-	tlb_invalidate_pages(as->asid, area->base, area->pages);
-
-	/*
-	 * Invalidate potential software translation caches
-	 * (e.g. TSB on sparc64, PHT on ppc32).
-	 */
-	as_invalidate_translation_cache(as, area->base, area->pages);
-	tlb_shootdown_finalize(ipl);
+	as_deferred_end(as, area->base, area->pages,
+	    (area->backend) && (area->backend->frame_free));
 
 	page_table_unlock(as, false);
 
@@ -1404,7 +1578,7 @@ errno_t as_area_change_flags(as_t *as, unsigned int flags, uintptr_t address)
 	/*
 	 * Start TLB shootdown sequence.
 	 */
-	ipl_t ipl = tlb_shootdown_start(TLB_INVL_PAGES, as->asid, area->base,
+	ipl_t ipl = tlb_shootdown_start_as(as, TLB_INVL_PAGES, area->base,
 	    area->pages);
 
 	/*
@@ -1675,6 +1849,14 @@ retry:
 			new_as->asid = asid_get();
 	}
 
+	/*
+	 * Keep track of the processors that have to take part in TLB
+	 * shootdowns for the address spaces. This processor must be
+	 * accounted for before it can load any TLB entries of the new
+	 * address space.
+	 */
+	tlb_as_install(new_as);
+
 #ifdef AS_PAGE_TABLE
 	SET_PTL0_ADDRESS(new_as->genarch.page_table);
 #endif
@@ -1685,6 +1867,9 @@ retry:
 	 */
 	as_install_arch(new_as);
 
+	if (old_as)
+		tlb_as_deinstall(old_as);
+
 	spinlock_unlock(&asidlock);
 
 	AS = new_as;
@@ -280,17 +280,17 @@ void anon_frame_free(as_area_t *area, uintptr_t page, uintptr_t frame)
 	if (area->flags & AS_AREA_LATE_RESERVE) {
 		/*
 		 * In case of the late reserve areas, physical memory will not
-		 * be unreserved when the area is destroyed so we need to use
-		 * the normal unreserving frame_free().
+		 * be unreserved when the area is destroyed so we need to free
+		 * the frame together with its reservation.
 		 */
-		frame_free(frame, 1);
+		as_frame_free(area->as, frame, 1, 0);
 	} else {
 		/*
 		 * The reserve will be given back when the area is destroyed or
-		 * resized, so use the frame_free_noreserve() which does not
-		 * manipulate the reserve or it would be given back twice.
+		 * resized, so use FRAME_NO_RESERVE which does not manipulate
+		 * the reserve or it would be given back twice.
 		 */
-		frame_free_noreserve(frame, 1);
+		as_frame_free(area->as, frame, 1, FRAME_NO_RESERVE);
 	}
 }
 
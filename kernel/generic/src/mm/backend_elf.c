@@ -435,7 +435,7 @@ void elf_frame_free(as_area_t *area, uintptr_t page, uintptr_t frame)
 			 * Free the frame with the copy of writable segment
 			 * data.
 			 */
-			frame_free_noreserve(frame, 1);
+			as_frame_free(area->as, frame, 1, FRAME_NO_RESERVE);
 		}
 	} else {
 		/*
@@ -443,7 +443,7 @@ void elf_frame_free(as_area_t *area, uintptr_t page, uintptr_t frame)
 		 * lower part is backed by the ELF image and the upper is
 		 * anonymous). In any case, a frame needs to be freed.
 		 */
-		frame_free_noreserve(frame, 1);
+		as_frame_free(area->as, frame, 1, FRAME_NO_RESERVE);
 	}
 }
 
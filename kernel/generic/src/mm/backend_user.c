@@ -167,7 +167,7 @@ void user_frame_free(as_area_t *area, uintptr_t page, uintptr_t frame)
 
 	pfn_t pfn = ADDR2PFN(frame);
 	if (find_zone(pfn, 1, 0) != (size_t) -1) {
-		frame_free(frame, 1);
+		as_frame_free(area->as, frame, 1, 0);
 	} else {
 		/* Nothing to do */
 	}
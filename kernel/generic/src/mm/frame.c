@@ -39,6 +39,12 @@
  * This file contains the physical frame allocator and memory zone management.
  * The frame allocator is built on top of the two-level bitmap structure.
  *
+ * Once all processors are known, each of them gets a small cache of single
+ * frames, so that the most common allocations and deallocations of one
+ * frame do not need to take the global zones lock. Frames in the caches
+ * stay allocated in their zones, with a reference count of one, and are
+ * moved between the caches and the zones in batches.
+ *
  */
 
 #include <typedefs.h>
@@ -61,6 +67,10 @@
 #include <config.h>
 #include <str.h>
 #include <proc/thread.h> /* THREAD */
+#include <cpu.h>
+#include <sysinfo/sysinfo.h>
+#include <mem.h>
+#include <stdlib.h>
 
 zones_t zones;
 
@@ -73,6 +83,38 @@ static condvar_t mem_avail_cv;
 static size_t mem_avail_req = 0;  /**< Number of frames requested. */
 static size_t mem_avail_gen = 0;  /**< Generation counter. */
 
+/** Maximum number of frames in one per-CPU frame list. */
+#define FRAME_CACHE_SIZE   64
+/** Number of frames moved between a per-CPU frame list and the zones. */
+#define FRAME_CACHE_BATCH  16
+
+/** Per-CPU list of single frames.
+ *
+ * The list is a stack of frame numbers. Frames freed on the CPU are pushed
+ * on its top, where they are taken from first while they are still hot in
+ * the CPU cache. When the list overflows, the coldest frames at its bottom
+ * are returned to the zones.
+ */
+typedef struct {
+	pfn_t pfn[FRAME_CACHE_SIZE];
+	size_t count;
+} frame_list_t;
+
+typedef struct {
+	IRQ_SPINLOCK_DECLARE(lock);
+	/** Frames from low memory zones. */
+	frame_list_t lowmem;
+	/** Frames for allocations that prefer high memory. */
+	frame_list_t highmem;
+	/** Allocations served from the list. */
+	uint64_t hits;
+	/** Allocations that had to go to the zones. */
+	uint64_t misses;
+} frame_cache_t;
+
+/** Per-CPU frame caches, NULL until frame_enable_cpucache() is called. */
+static frame_cache_t *frame_cache = NULL;
+
 /** Initialize frame structure.
  *
  * @param frame Frame structure to be initialized.
@@ -829,6 +871,221 @@ static size_t try_find_zone(size_t count, bool lowmem,
 	    frame_constraint, hint);
 }
 
+/*
+ * Per-CPU frame caches
+ *
+ * After frame_enable_cpucache(), the zones are never created, merged or
+ * moved around again, so looking up the zone of a frame does not need the
+ * zones lock. The frame_t of a frame is only ever changed under the zones
+ * lock, except by the owner of its only reference.
+ */
+
+/** Return coldest frames from a per-CPU list to the zones.
+ *
+ * Assume the per-CPU cache is locked.
+ *
+ * @param list  Per-CPU frame list.
+ * @param count Number of frames to return.
+ *
+ */
+_NO_TRACE static void frame_list_drain(frame_list_t *list, size_t count)
+{
+	count = min(count, list->count);
+	if (count == 0)
+		return;
+
+	irq_spinlock_lock(&zones.lock, false);
+
+	for (size_t i = 0; i < count; i++) {
+		size_t znum = find_zone(list->pfn[i], 1, 0);
+		assert(znum != (size_t) -1);
+
+		size_t freed = zone_frame_free(&zones.info[znum],
+		    list->pfn[i] - zones.info[znum].base);
+
+		(void) freed;
+		assert(freed == 1);
+	}
+
+	irq_spinlock_unlock(&zones.lock, false);
+
+	list->count -= count;
+	memmove(&list->pfn[0], &list->pfn[count],
+	    list->count * sizeof(pfn_t));
+}
+
+/** Refill an empty per-CPU list from the zones.
+ *
+ * Assume the per-CPU cache is locked.
+ *
+ * @param list   Per-CPU frame list.
+ * @param lowmem Whether the frames must come from low memory.
+ *
+ * @return Number of frames added to the list.
+ *
+ */
+_NO_TRACE static size_t frame_list_refill(frame_list_t *list, bool lowmem)
+{
+	size_t hint = 0;
+
+	irq_spinlock_lock(&zones.lock, false);
+
+	while (list->count < FRAME_CACHE_BATCH) {
+		size_t znum = try_find_zone(1, lowmem, 0, hint);
+		if (znum == (size_t) -1)
+			break;
+
+		list->pfn[list->count++] = zone_frame_alloc(&zones.info[znum],
+		    1, 0) + zones.info[znum].base;
+		hint = znum;
+	}
+
+	irq_spinlock_unlock(&zones.lock, false);
+
+	return list->count;
+}
+
+/** Allocate a single frame from the per-CPU cache.
+ *
+ * @param lowmem Whether the frame must come from low memory.
+ * @param pfn    Place to store the frame number.
+ *
+ * @return True if a frame was allocated.
+ *
+ */
+_NO_TRACE static bool frame_cache_alloc(bool lowmem, pfn_t *pfn)
+{
+	if ((frame_cache == NULL) || (CPU == NULL))
+		return false;
+
+	frame_cache_t *cache = &frame_cache[CPU->id];
+	irq_spinlock_lock(&cache->lock, true);
+
+	frame_list_t *list = lowmem ? &cache->lowmem : &cache->highmem;
+
+	if (list->count > 0) {
+		cache->hits++;
+	} else {
+		cache->misses++;
+
+		if (frame_list_refill(list, lowmem) == 0) {
+			irq_spinlock_unlock(&cache->lock, true);
+			return false;
+		}
+	}
+
+	*pfn = list->pfn[--list->count];
+
+	irq_spinlock_unlock(&cache->lock, true);
+	return true;
+}
+
+/** Free a single frame to the per-CPU cache.
+ *
+ * Only frames with no other references can be cached. Threads waiting
+ * for memory are woken up only by frees that go to the zones, so they
+ * bypass the cache while someone is waiting.
+ *
+ * @param pfn Frame to free.
+ *
+ * @return True if the frame was cached.
+ *
+ */
+_NO_TRACE static bool frame_cache_free(pfn_t pfn)
+{
+	if ((frame_cache == NULL) || (CPU == NULL) || (mem_avail_req > 0))
+		return false;
+
+	size_t znum = find_zone(pfn, 1, 0);
+	assert(znum != (size_t) -1);
+
+	zone_t *zone = &zones.info[znum];
+	if (zone_get_frame(zone, pfn - zone->base)->refcount != 1)
+		return false;
+
+	frame_cache_t *cache = &frame_cache[CPU->id];
+	irq_spinlock_lock(&cache->lock, true);
+
+	frame_list_t *list = (zone->flags & ZONE_LOWMEM) ?
+	    &cache->lowmem : &cache->highmem;
+
+	if (list->count == FRAME_CACHE_SIZE)
+		frame_list_drain(list, FRAME_CACHE_BATCH);
+
+	list->pfn[list->count++] = pfn;
+
+	irq_spinlock_unlock(&cache->lock, true);
+	return true;
+}
+
+/** Return all frames in per-CPU caches to the zones.
+ *
+ * Used when the zones run out of free frames.
+ *
+ */
+static void frame_cache_drain_all(void)
+{
+	if (frame_cache == NULL)
+		return;
+
+	for (size_t i = 0; i < config.cpu_count; i++) {
+		irq_spinlock_lock(&frame_cache[i].lock, true);
+		frame_list_drain(&frame_cache[i].lowmem, FRAME_CACHE_SIZE);
+		frame_list_drain(&frame_cache[i].highmem, FRAME_CACHE_SIZE);
+		irq_spinlock_unlock(&frame_cache[i].lock, true);
+	}
+}
+
+static sysarg_t frame_cache_get_hits(sysinfo_item_t *item, void *data)
+{
+	sysarg_t hits = 0;
+
+	for (size_t i = 0; i < config.cpu_count; i++)
+		hits += frame_cache[i].hits;
+
+	return hits;
+}
+
+static sysarg_t frame_cache_get_misses(sysinfo_item_t *item, void *data)
+{
+	sysarg_t misses = 0;
+
+	for (size_t i = 0; i < config.cpu_count; i++)
+		misses += frame_cache[i].misses;
+
+	return misses;
+}
+
+/** Enable per-CPU frame caches.
+ *
+ * Must be called after the number of processors is known and after all
+ * zones have been created and merged.
+ *
+ */
+void frame_enable_cpucache(void)
+{
+	frame_cache_t *cache = malloc(sizeof(frame_cache_t) * config.cpu_count);
+	if (cache == NULL) {
+		log(LF_OTHER, LVL_WARN, "Cannot allocate per-CPU frame caches");
+		return;
+	}
+
+	for (size_t i = 0; i < config.cpu_count; i++) {
+		irq_spinlock_initialize(&cache[i].lock, "frame.cache.lock");
+		cache[i].lowmem.count = 0;
+		cache[i].highmem.count = 0;
+		cache[i].hits = 0;
+		cache[i].misses = 0;
+	}
+
+	frame_cache = cache;
+
+	sysinfo_set_item_gen_val("mm.frame_cache.hits", NULL,
+	    frame_cache_get_hits, NULL);
+	sysinfo_set_item_gen_val("mm.frame_cache.misses", NULL,
+	    frame_cache_get_misses, NULL);
+}
+
 /** Allocate frames of physical memory.
  *
  * @param count      Number of continuous frames to allocate.
@@ -854,17 +1111,43 @@ uintptr_t frame_alloc_generic(size_t count, frame_flags_t flags,
 	if (!(flags & FRAME_NO_RESERVE))
 		reserve_force_alloc(count);
 
-loop:
-	irq_spinlock_lock(&zones.lock, true);
-
 	// TODO: Print diagnostic if neither is explicitly specified.
 	bool lowmem = (flags & FRAME_LOWMEM) || !(flags & FRAME_HIGHMEM);
 
+	/*
+	 * Single frames without a constraint come from the per-CPU cache.
+	 */
+	if ((count == 1) && (frame_constraint == 0)) {
+		pfn_t pfn;
+
+		if (frame_cache_alloc(lowmem, &pfn)) {
+			if (pzone)
+				*pzone = find_zone(pfn, 1, hint);
+
+			return PFN2ADDR(pfn);
+		}
+	}
+
+loop:
+	irq_spinlock_lock(&zones.lock, true);
+
 	/*
 	 * First, find suitable frame zone.
 	 */
 	size_t znum = try_find_zone(count, lowmem, frame_constraint, hint);
 
+	/*
+	 * Before reclaiming anything, return the frames sitting
+	 * in the per-CPU caches.
+	 */
+	if ((znum == (size_t) -1) && (frame_cache != NULL)) {
+		irq_spinlock_unlock(&zones.lock, true);
+		frame_cache_drain_all();
+		irq_spinlock_lock(&zones.lock, true);
+
+		znum = try_find_zone(count, lowmem, frame_constraint, hint);
+	}
+
 	/*
 	 * If no memory, reclaim some slab memory,
 	 * if it does not help, reclaim all.
@@ -976,6 +1259,12 @@ void frame_free_generic(uintptr_t start, size_t count, frame_flags_t flags)
 {
 	size_t freed = 0;
 
+	if ((count == 1) && frame_cache_free(ADDR2PFN(start))) {
+		if (!(flags & FRAME_NO_RESERVE))
+			reserve_free(1);
+		return;
+	}
+
 	irq_spinlock_lock(&zones.lock, true);
 
 	for (size_t i = 0; i < count; i++) {
@@ -45,8 +45,6 @@
  *
  * Following features are not currently supported but would be easy to do:
  * @li cache coloring
- * @li dynamic magazine growing (different magazine sizes are already
- *     supported, but we would need to adjust allocation strategy)
  *
  * The slab allocator supports per-CPU caches ('magazines') to facilitate
  * good SMP scaling.
@@ -64,7 +62,15 @@
  * The CPU-bound magazine is actually a pair of magazines in order to avoid
  * thrashing when somebody is allocating/deallocating 1 item at the magazine
  * size boundary. LIFO order is enforced, which should avoid fragmentation
- * as much as possible.
+ * as much as possible. Each CPU further keeps one spare full and one spare
+ * empty magazine, which are used before the cpu-shared list of magazines
+ * is touched or a new magazine is allocated.
+ *
+ * Magazines of a cache start with SLAB_MAG_SIZE objects. Every access to
+ * the cpu-shared list of magazines is counted and if too many of them had
+ * to wait for the list lock, new magazines of the cache are made twice as
+ * large (up to SLAB_MAG_SIZE_MAX), so that the list is visited less often.
+ * The magazines themselves are allocated from one cache per magazine size.
  *
  * Every cache contains list of full slabs and list of partially full slabs.
  * Empty slabs are immediately freed (thrashing will be avoided because
@@ -80,18 +86,9 @@
  * It tries 'light reclaim' first, then brutal reclaim. The light reclaim
  * releases slabs from cpu-shared magazine-list, until at least 1 slab
  * is deallocated in each cache (this algorithm should probably change).
- * The brutal reclaim removes all cached objects, even from CPU-bound
- * magazines.
- *
- * @todo
- * For better CPU-scaling the magazine allocation strategy should
- * be extended. Currently, if the cache does not have magazine, it asks
- * for non-cpu cached magazine cache to provide one. It might be feasible
- * to add cpu-cached magazine cache (which would allocate it's magazines
- * from non-cpu-cached mag. cache). This would provide a nice per-cpu
- * buffer. The other possibility is to use the per-cache
- * 'empty-magazine-list', which decreases competing for 1 per-system
- * magazine cache.
+ * It also halves the size of new magazines and frees the spare empty
+ * magazines. The brutal reclaim removes all cached objects, even from
+ * CPU-bound magazines, and returns to the initial magazine size.
  *
  * @todo
  * It might be good to add granularity of locks even to slab level,
@@ -116,12 +113,22 @@
 #include <macros.h>
 #include <cpu.h>
 #include <stdlib.h>
+#include <str.h>
 
 IRQ_SPINLOCK_STATIC_INITIALIZE(slab_cache_lock);
 static LIST_INITIALIZE(slab_cache_list);
 
-/** Magazine cache */
-static slab_cache_t mag_cache;
+/** Magazine caches, one per magazine size */
+static slab_cache_t mag_cache[SLAB_MAG_CLASSES];
+
+/** Names of magazine caches */
+static const char *mag_cache_names[SLAB_MAG_CLASSES] = {
+	"slab_magazine_4",
+	"slab_magazine_8",
+	"slab_magazine_16",
+	"slab_magazine_32",
+	"slab_magazine_64"
+};
 
 /** Cache for cache descriptors */
 static slab_cache_t slab_cache_cache;
@@ -326,6 +333,49 @@ _NO_TRACE static void *slab_obj_create(slab_cache_t *cache, unsigned int flags)
  * CPU-Cache slab functions
  */
 
+/** Lock the magazine list of a cache and account for contention
+ *
+ * If too many accesses within the last window had to wait for the lock,
+ * the size of new magazines is doubled.
+ *
+ * @return Interrupt level to be passed to maglock_unlock().
+ *
+ */
+_NO_TRACE static ipl_t maglock_lock(slab_cache_t *cache)
+{
+	ipl_t ipl = interrupts_disable();
+
+	bool contended = !irq_spinlock_trylock(&cache->maglock);
+	if (contended)
+		irq_spinlock_lock(&cache->maglock, false);
+
+	atomic_inc(&cache->magazine_exchanges);
+	if (contended) {
+		atomic_inc(&cache->magazine_contention);
+		cache->mag_contention++;
+	}
+
+	if (++cache->mag_window >= SLAB_MAG_WINDOW) {
+		if ((cache->mag_contention >= SLAB_MAG_CONTENTION) &&
+		    (cache->mag_size < SLAB_MAG_SIZE_MAX))
+			cache->mag_size <<= 1;
+
+		cache->mag_window = 0;
+		cache->mag_contention = 0;
+	}
+
+	return ipl;
+}
+
+/** Unlock the magazine list of a cache
+ *
+ */
+_NO_TRACE static void maglock_unlock(slab_cache_t *cache, ipl_t ipl)
+{
+	irq_spinlock_unlock(&cache->maglock, false);
+	interrupts_restore(ipl);
+}
+
 /** Find a full magazine in cache, take it from list and return it
  *
  * @param first If true, return first, else last mag.
@@ -337,7 +387,7 @@ _NO_TRACE static slab_magazine_t *get_mag_from_cache(slab_cache_t *cache,
 	slab_magazine_t *mag = NULL;
 	link_t *cur;
 
-	irq_spinlock_lock(&cache->maglock, true);
+	ipl_t ipl = maglock_lock(cache);
 	if (!list_empty(&cache->magazines)) {
 		if (first)
 			cur = list_first(&cache->magazines);
@@ -348,7 +398,7 @@ _NO_TRACE static slab_magazine_t *get_mag_from_cache(slab_cache_t *cache,
 		list_remove(&mag->link);
 		atomic_dec(&cache->magazine_counter);
 	}
-	irq_spinlock_unlock(&cache->maglock, true);
+	maglock_unlock(cache, ipl);
 
 	return mag;
 }
@@ -359,12 +409,51 @@ _NO_TRACE static slab_magazine_t *get_mag_from_cache(slab_cache_t *cache,
 _NO_TRACE static void put_mag_to_cache(slab_cache_t *cache,
     slab_magazine_t *mag)
 {
-	irq_spinlock_lock(&cache->maglock, true);
+	ipl_t ipl = maglock_lock(cache);
 
 	list_prepend(&mag->link, &cache->magazines);
 	atomic_inc(&cache->magazine_counter);
 
-	irq_spinlock_unlock(&cache->maglock, true);
+	maglock_unlock(cache, ipl);
+}
+
+/** Return the magazine cache for magazines of given size
+ *
+ */
+_NO_TRACE static slab_cache_t *mag_cache_get(size_t size)
+{
+	assert(size >= SLAB_MAG_SIZE);
+	assert(size <= SLAB_MAG_SIZE_MAX);
+
+	return &mag_cache[fnzb(size / SLAB_MAG_SIZE)];
+}
+
+/** Allocate an empty magazine of the current size of cache magazines
+ *
+ */
+_NO_TRACE static slab_magazine_t *magazine_alloc(slab_cache_t *cache)
+{
+	/*
+	 * The size is only a hint and it is fine to read it without
+	 * holding the maglock.
+	 */
+	size_t size = cache->mag_size;
+
+	/*
+	 * We do not want to sleep just because of caching,
+	 * especially we do not want reclaiming to start, as
+	 * this would deadlock.
+	 *
+	 */
+	slab_magazine_t *mag = slab_alloc(mag_cache_get(size),
+	    FRAME_ATOMIC | FRAME_NO_RECLAIM);
+	if (!mag)
+		return NULL;
+
+	mag->size = size;
+	mag->busy = 0;
+
+	return mag;
 }
 
 /** Free all objects in magazine and free memory associated with magazine
@@ -383,11 +472,26 @@ _NO_TRACE static size_t magazine_destroy(slab_cache_t *cache,
 		atomic_dec(&cache->cached_objs);
 	}
 
-	slab_free(&mag_cache, mag);
+	slab_free(mag_cache_get(mag->size), mag);
 
 	return frames;
 }
 
+/** Keep an empty magazine as the CPU spare or destroy it
+ *
+ */
+_NO_TRACE static void magazine_put_empty(slab_cache_t *cache,
+    slab_magazine_t *mag)
+{
+	slab_mag_cache_t *mcache = &cache->mag_cache[CPU->id];
+
+	if ((!mcache->empty) && (mag->busy == 0) &&
+	    (mag->size == cache->mag_size))
+		mcache->empty = mag;
+	else
+		magazine_destroy(cache, mag);
+}
+
 /** Find full magazine, set it as current and return it
  *
  */
@@ -409,13 +513,21 @@ _NO_TRACE static slab_magazine_t *get_full_current_mag(slab_cache_t *cache)
 		}
 	}
 
-	/* Local magazines are empty, import one from magazine list */
-	slab_magazine_t *newmag = get_mag_from_cache(cache, 1);
-	if (!newmag)
-		return NULL;
+	/*
+	 * Local magazines are empty, use the spare full magazine or
+	 * import one from magazine list
+	 */
+	slab_magazine_t *newmag = cache->mag_cache[CPU->id].full;
+	if (newmag) {
+		cache->mag_cache[CPU->id].full = NULL;
+	} else {
+		newmag = get_mag_from_cache(cache, true);
+		if (!newmag)
+			return NULL;
+	}
 
 	if (lastmag)
-		magazine_destroy(cache, lastmag);
+		magazine_put_empty(cache, lastmag);
 
 	cache->mag_cache[CPU->id].last = cmag;
 	cache->mag_cache[CPU->id].current = newmag;
@@ -455,7 +567,8 @@ _NO_TRACE static void *magazine_obj_get(slab_cache_t *cache)
  * We have 2 magazines bound to processor.
  * First try the current.
  * If full, try the last.
- * If full, put to magazines list.
+ * If full, keep it as the spare full magazine
+ * or put it to magazines list.
  *
  */
 _NO_TRACE static slab_magazine_t *make_empty_current_mag(slab_cache_t *cache)
@@ -476,25 +589,29 @@ _NO_TRACE static slab_magazine_t *make_empty_current_mag(slab_cache_t *cache)
 		}
 	}
 
-	/* current | last are full | nonexistent, allocate new */
+	/* current | last are full | nonexistent, use spare or allocate new */
+	slab_magazine_t *newmag = cache->mag_cache[CPU->id].empty;
+	cache->mag_cache[CPU->id].empty = NULL;
 
-	/*
-	 * We do not want to sleep just because of caching,
-	 * especially we do not want reclaiming to start, as
-	 * this would deadlock.
-	 *
-	 */
-	slab_magazine_t *newmag = slab_alloc(&mag_cache,
-	    FRAME_ATOMIC | FRAME_NO_RECLAIM);
-	if (!newmag)
-		return NULL;
+	if ((newmag) && (newmag->size != cache->mag_size)) {
+		/* The magazine size has changed since */
+		magazine_destroy(cache, newmag);
+		newmag = NULL;
+	}
 
-	newmag->size = SLAB_MAG_SIZE;
-	newmag->busy = 0;
+	if (!newmag) {
+		newmag = magazine_alloc(cache);
+		if (!newmag)
+			return NULL;
+	}
 
-	/* Flush last to magazine list */
-	if (lastmag)
-		put_mag_to_cache(cache, lastmag);
+	/* Keep last as the spare full magazine or flush it to magazine list */
+	if (lastmag) {
+		if (!cache->mag_cache[CPU->id].full)
+			cache->mag_cache[CPU->id].full = lastmag;
+		else
+			put_mag_to_cache(cache, lastmag);
+	}
 
 	/* Move current as last, save new as current */
 	cache->mag_cache[CPU->id].last = cmag;
@@ -602,6 +719,7 @@ _NO_TRACE static void _slab_cache_create(slab_cache_t *cache, const char *name,
 	cache->constructor = constructor;
 	cache->destructor = destructor;
 	cache->flags = flags;
+	cache->mag_size = SLAB_MAG_SIZE;
 
 	list_initialize(&cache->full_slabs);
 	list_initialize(&cache->partial_slabs);
@@ -664,6 +782,19 @@ _NO_TRACE static size_t _slab_reclaim(slab_cache_t *cache, unsigned int flags)
 	if (cache->flags & SLAB_CACHE_NOMAGAZINE)
 		return 0; /* Nothing to do */
 
+	/* Memory is scarce, make new magazines smaller */
+	irq_spinlock_lock(&cache->maglock, true);
+
+	if (flags & SLAB_RECLAIM_ALL)
+		cache->mag_size = SLAB_MAG_SIZE;
+	else if (cache->mag_size > SLAB_MAG_SIZE)
+		cache->mag_size >>= 1;
+
+	cache->mag_window = 0;
+	cache->mag_contention = 0;
+
+	irq_spinlock_unlock(&cache->maglock, true);
+
 	/*
 	 * We count up to original magazine count to avoid
 	 * endless loop
@@ -679,12 +810,25 @@ _NO_TRACE static size_t _slab_reclaim(slab_cache_t *cache, unsigned int flags)
 			break;
 	}
 
-	if (flags & SLAB_RECLAIM_ALL) {
-		/* Free cpu-bound magazines */
-		/* Destroy CPU magazines */
-		size_t i;
-		for (i = 0; i < config.cpu_count; i++) {
-			irq_spinlock_lock(&cache->mag_cache[i].lock, true);
+	if (!cache->mag_cache)
+		return frames;
+
+	/* Free cpu-bound magazines */
+	size_t i;
+	for (i = 0; i < config.cpu_count; i++) {
+		irq_spinlock_lock(&cache->mag_cache[i].lock, true);
+
+		mag = cache->mag_cache[i].empty;
+		if (mag)
+			frames += magazine_destroy(cache, mag);
+		cache->mag_cache[i].empty = NULL;
+
+		if (flags & SLAB_RECLAIM_ALL) {
+			/* Destroy CPU magazines */
+			mag = cache->mag_cache[i].full;
+			if (mag)
+				frames += magazine_destroy(cache, mag);
+			cache->mag_cache[i].full = NULL;
 
 			mag = cache->mag_cache[i].current;
 			if (mag)
@@ -695,9 +839,9 @@ _NO_TRACE static size_t _slab_reclaim(slab_cache_t *cache, unsigned int flags)
 			if (mag)
 				frames += magazine_destroy(cache, mag);
 			cache->mag_cache[i].last = NULL;
-
-			irq_spinlock_unlock(&cache->mag_cache[i].lock, true);
 		}
+
+		irq_spinlock_unlock(&cache->mag_cache[i].lock, true);
 	}
 
 	return frames;
@@ -807,7 +951,7 @@ size_t slab_reclaim(unsigned int flags)
 void slab_print_list(void)
 {
 	printf("[cache name      ] [size  ] [pages ] [obj/pg] [slabs ]"
-	    " [cached] [alloc ] [ctl]\n");
+	    " [cached] [alloc ] [mag] [exchange] [contend ] [ctl]\n");
 
 	size_t skip = 0;
 	while (true) {
@@ -859,24 +1003,83 @@ void slab_print_list(void)
 		long allocated_slabs = atomic_load(&cache->allocated_slabs);
 		long cached_objs = atomic_load(&cache->cached_objs);
 		long allocated_objs = atomic_load(&cache->allocated_objs);
+		size_t mag_size = cache->mag_size;
+		size_t exchanges = atomic_load(&cache->magazine_exchanges);
+		size_t contention = atomic_load(&cache->magazine_contention);
 		unsigned int flags = cache->flags;
 
 		irq_spinlock_unlock(&slab_cache_lock, true);
 
-		printf("%-18s %8zu %8zu %8zu %8ld %8ld %8ld %-5s\n",
-		    name, size, frames, objects, allocated_slabs,
-		    cached_objs, allocated_objs,
-		    flags & SLAB_CACHE_SLINSIDE ? "in" : "out");
+		if (flags & SLAB_CACHE_NOMAGAZINE) {
+			printf("%-18s %8zu %8zu %8zu %8ld %8ld %8ld %5s %10s %10s"
+			    " %-5s\n", name, size, frames, objects, allocated_slabs,
+			    cached_objs, allocated_objs, "-", "-", "-",
+			    flags & SLAB_CACHE_SLINSIDE ? "in" : "out");
+		} else {
+			printf("%-18s %8zu %8zu %8zu %8ld %8ld %8ld %5zu %10zu %10zu"
+			    " %-5s\n", name, size, frames, objects, allocated_slabs,
+			    cached_objs, allocated_objs, mag_size, exchanges,
+			    contention, flags & SLAB_CACHE_SLINSIDE ? "in" : "out");
+		}
 	}
 }
 
+/** Gather statistics about slab caches
+ *
+ * @param stats Array to be filled in.
+ * @param count Number of entries in the array.
+ *
+ * @return Number of slab caches in the system, which may be more
+ *         than the number of entries filled in.
+ *
+ */
+size_t slab_stats_get(stats_slab_t *stats, size_t count)
+{
+	size_t i = 0;
+
+	irq_spinlock_lock(&slab_cache_lock, true);
+
+	list_foreach(slab_cache_list, link, slab_cache_t, cache) {
+		if (i < count) {
+			str_cpy(stats[i].name, STATS_SLAB_NAME_BUFLEN, cache->name);
+			stats[i].size = cache->size;
+			stats[i].slabs = atomic_load(&cache->allocated_slabs);
+			stats[i].allocated_objs =
+			    atomic_load(&cache->allocated_objs);
+			stats[i].cached_objs = atomic_load(&cache->cached_objs);
+
+			if (cache->flags & SLAB_CACHE_NOMAGAZINE)
+				stats[i].magazine_size = 0;
+			else
+				stats[i].magazine_size = cache->mag_size;
+
+			stats[i].exchanges =
+			    atomic_load(&cache->magazine_exchanges);
+			stats[i].contention =
+			    atomic_load(&cache->magazine_contention);
+		}
+
+		i++;
+	}
+
+	irq_spinlock_unlock(&slab_cache_lock, true);
+
+	return i;
+}
+
 void slab_cache_init(void)
 {
-	/* Initialize magazine cache */
-	_slab_cache_create(&mag_cache, "slab_magazine_t",
-	    sizeof(slab_magazine_t) + SLAB_MAG_SIZE * sizeof(void *),
-	    sizeof(uintptr_t), NULL, NULL, SLAB_CACHE_NOMAGAZINE |
-	    SLAB_CACHE_SLINSIDE);
+	static_assert(SLAB_MAG_SIZE << (SLAB_MAG_CLASSES - 1) ==
+	    SLAB_MAG_SIZE_MAX, "");
+
+	/* Initialize magazine caches */
+	for (size_t i = 0; i < SLAB_MAG_CLASSES; i++) {
+		_slab_cache_create(&mag_cache[i], mag_cache_names[i],
+		    sizeof(slab_magazine_t) +
+		    (SLAB_MAG_SIZE << i) * sizeof(void *),
+		    sizeof(uintptr_t), NULL, NULL, SLAB_CACHE_NOMAGAZINE |
+		    SLAB_CACHE_SLINSIDE);
+	}
 
 	/* Initialize slab_cache cache */
 	_slab_cache_create(&slab_cache_cache, "slab_cache_cache",
@@ -35,12 +35,22 @@
  * @brief Generic TLB shootdown algorithm.
  *
  * The algorithm implemented here is based on the CMU TLB shootdown
- * algorithm and is further simplified (e.g. all CPUs receive all TLB
- * shootdown messages).
+ * algorithm and is further simplified. Shootdowns for a user address space
+ * involve only the processors which may have TLB entries of it, as tracked
+ * in as_t.tlb_cpus, while the other shootdowns involve all processors.
+ * Where the architecture supports it (CONFIG_IPI_UNICAST), only the
+ * involved processors are interrupted.
+ *
+ * Shootdowns of pages unmapped by as_area_destroy() and as_area_resize()
+ * are deferred by the address space code, which keeps the frames of the
+ * pages until the shootdown. Consecutive unmaps of nearby ranges are thus
+ * shot down together as one range.
  */
 
 #include <mm/tlb.h>
 #include <mm/asid.h>
+#include <mm/as.h>
+#include <mm/page.h>
 #include <arch/mm/tlb.h>
 #include <assert.h>
 #include <smp/ipi.h>
@@ -50,6 +60,7 @@
 #include <config.h>
 #include <arch.h>
 #include <panic.h>
+#include <macros.h>
 #include <cpu.h>
 
 void tlb_init(void)
@@ -59,6 +70,9 @@ void tlb_init(void)
 
 #ifdef CONFIG_SMP
 
+/** Bit of a processor in the as_t.tlb_cpus mask. */
+#define TLB_CPU_BIT(id)  ((size_t) 1 << ((id) % (sizeof(size_t) * 8)))
+
 /**
  * This lock is used for synchronisation between sender and
  * recipients of TLB shootdown message. It must be acquired
@@ -67,64 +81,191 @@ void tlb_init(void)
  */
 IRQ_SPINLOCK_STATIC_INITIALIZE(tlblock);
 
-/** Send TLB shootdown message.
+/** A shootdown has picked its recipients and is not finished yet. */
+static atomic_bool shootdown_active = false;
+
+/** Queue TLB shootdown message for a processor.
  *
- * This function attempts to deliver TLB shootdown message
- * to all other processors.
+ * A range of pages adjacent to or overlapping with the range of the last
+ * queued message of the same address space is merged into it. When the
+ * queue is full, it is collapsed into a single message invalidating the
+ * whole address space, if all the messages concern one, or the whole TLB
+ * otherwise.
  *
+ * @param cpu   Recipient processor, its lock held.
  * @param type  Type describing scope of shootdown.
  * @param asid  Address space, if required by type.
  * @param page  Virtual page address, if required by type.
  * @param count Number of pages, if required by type.
  *
- * @return The interrupt priority level as it existed prior to this call.
+ */
+static void tlb_message_post(cpu_t *cpu, tlb_invalidate_type_t type,
+    asid_t asid, uintptr_t page, size_t count)
+{
+	if ((type == TLB_INVL_PAGES) && (cpu->tlb_messages_count > 0)) {
+		tlb_shootdown_msg_t *last =
+		    &cpu->tlb_messages[cpu->tlb_messages_count - 1];
+
+		if ((last->type == TLB_INVL_PAGES) && (last->asid == asid) &&
+		    (page <= last->page + P2SZ(last->count)) &&
+		    (last->page <= page + P2SZ(count))) {
+			uintptr_t start = min(page, last->page);
+			uintptr_t end = max(page + P2SZ(count),
+			    last->page + P2SZ(last->count));
+
+			last->page = start;
+			last->count = (end - start) >> PAGE_WIDTH;
+			return;
+		}
+	}
+
+	if (cpu->tlb_messages_count == TLB_MESSAGE_QUEUE_LEN) {
+		/*
+		 * The message queue is full.
+		 * Erase the queue and store one TLB_INVL_ASID message
+		 * if possible, or one TLB_INVL_ALL message.
+		 */
+		bool same_asid = (type != TLB_INVL_ALL);
+		for (size_t i = 0; i < cpu->tlb_messages_count; i++) {
+			if ((cpu->tlb_messages[i].type == TLB_INVL_ALL) ||
+			    (cpu->tlb_messages[i].asid != asid))
+				same_asid = false;
+		}
+
+		cpu->tlb_messages_count = 1;
+		if (same_asid) {
+			cpu->tlb_messages[0].type = TLB_INVL_ASID;
+			cpu->tlb_messages[0].asid = asid;
+		} else {
+			cpu->tlb_messages[0].type = TLB_INVL_ALL;
+			cpu->tlb_messages[0].asid = ASID_INVALID;
+		}
+		cpu->tlb_messages[0].page = 0;
+		cpu->tlb_messages[0].count = 0;
+	} else {
+		/*
+		 * Enqueue the message.
+		 */
+		size_t idx = cpu->tlb_messages_count++;
+		cpu->tlb_messages[idx].type = type;
+		cpu->tlb_messages[idx].asid = asid;
+		cpu->tlb_messages[idx].page = page;
+		cpu->tlb_messages[idx].count = count;
+	}
+}
+
+/** Send TLB shootdown message to a set of processors.
+ *
+ * @param targets Mask of processors to receive the message.
+ * @param type    Type describing scope of shootdown.
+ * @param asid    Address space, if required by type.
+ * @param page    Virtual page address, if required by type.
+ * @param count   Number of pages, if required by type.
  *
  */
-ipl_t tlb_shootdown_start(tlb_invalidate_type_t type, asid_t asid,
-    uintptr_t page, size_t count)
+static void shootdown_send(size_t targets, tlb_invalidate_type_t type,
+    asid_t asid, uintptr_t page, size_t count)
 {
-	ipl_t ipl = interrupts_disable();
-	CPU->tlb_active = false;
-	irq_spinlock_lock(&tlblock, false);
+	bool send = false;
 
 	size_t i;
 	for (i = 0; i < config.cpu_count; i++) {
-		if (i == CPU->id)
+		if ((i == CPU->id) || ((targets & TLB_CPU_BIT(i)) == 0))
 			continue;
 
 		cpu_t *cpu = &cpus[i];
 
 		irq_spinlock_lock(&cpu->lock, false);
-		if (cpu->tlb_messages_count == TLB_MESSAGE_QUEUE_LEN) {
-			/*
-			 * The message queue is full.
-			 * Erase the queue and store one TLB_INVL_ALL message.
-			 */
-			cpu->tlb_messages_count = 1;
-			cpu->tlb_messages[0].type = TLB_INVL_ALL;
-			cpu->tlb_messages[0].asid = ASID_INVALID;
-			cpu->tlb_messages[0].page = 0;
-			cpu->tlb_messages[0].count = 0;
-		} else {
-			/*
-			 * Enqueue the message.
-			 */
-			size_t idx = cpu->tlb_messages_count++;
-			cpu->tlb_messages[idx].type = type;
-			cpu->tlb_messages[idx].asid = asid;
-			cpu->tlb_messages[idx].page = page;
-			cpu->tlb_messages[idx].count = count;
-		}
+		tlb_message_post(cpu, type, asid, page, count);
 		irq_spinlock_unlock(&cpu->lock, false);
+
+		send = true;
 	}
 
+	/*
+	 * If the address space is used only on this processor, e.g. by
+	 * a single-threaded task, there is nobody to interrupt.
+	 */
+	if (!send)
+		return;
+
+#ifdef CONFIG_IPI_UNICAST
+	if (targets != (size_t) -1) {
+		for (i = 0; i < config.cpu_count; i++) {
+			if ((i != CPU->id) && ((targets & TLB_CPU_BIT(i)) != 0))
+				ipi_unicast(&cpus[i], VECTOR_TLB_SHOOTDOWN_IPI);
+		}
+	} else {
+		tlb_shootdown_ipi_send();
+	}
+#else
 	tlb_shootdown_ipi_send();
+#endif
 
 busy_wait:
 	for (i = 0; i < config.cpu_count; i++) {
+		if ((i == CPU->id) || ((targets & TLB_CPU_BIT(i)) == 0))
+			continue;
+
 		if (cpus[i].tlb_active)
 			goto busy_wait;
 	}
+}
+
+/** Send TLB shootdown message.
+ *
+ * This function attempts to deliver TLB shootdown message
+ * to all other processors.
+ *
+ * @param type  Type describing scope of shootdown.
+ * @param asid  Address space, if required by type.
+ * @param page  Virtual page address, if required by type.
+ * @param count Number of pages, if required by type.
+ *
+ * @return The interrupt priority level as it existed prior to this call.
+ *
+ */
+ipl_t tlb_shootdown_start(tlb_invalidate_type_t type, asid_t asid,
+    uintptr_t page, size_t count)
+{
+	ipl_t ipl = interrupts_disable();
+	CPU->tlb_active = false;
+	irq_spinlock_lock(&tlblock, false);
+	atomic_store(&shootdown_active, true);
+
+	shootdown_send((size_t) -1, type, asid, page, count);
+
+	return ipl;
+}
+
+/** Send TLB shootdown message concerning an address space.
+ *
+ * The message is delivered only to the processors which may have TLB
+ * entries of the address space.
+ *
+ * @param as    Address space.
+ * @param type  Type describing scope of shootdown.
+ * @param page  Virtual page address, if required by type.
+ * @param count Number of pages, if required by type.
+ *
+ * @return The interrupt priority level as it existed prior to this call.
+ *
+ */
+ipl_t tlb_shootdown_start_as(as_t *as, tlb_invalidate_type_t type,
+    uintptr_t page, size_t count)
+{
+	ipl_t ipl = interrupts_disable();
+	CPU->tlb_active = false;
+	irq_spinlock_lock(&tlblock, false);
+
+	/*
+	 * Either tlb_as_install() sees the shootdown in progress or the
+	 * processor it runs on is among the recipients.
+	 */
+	atomic_store(&shootdown_active, true);
+	size_t targets = atomic_load(&as->tlb_cpus);
+
+	shootdown_send(targets, type, as->asid, page, count);
 
 	return ipl;
 }
@@ -136,6 +277,7 @@ busy_wait:
  */
 void tlb_shootdown_finalize(ipl_t ipl)
 {
+	atomic_store(&shootdown_active, false);
 	irq_spinlock_unlock(&tlblock, false);
 	CPU->tlb_active = true;
 	interrupts_restore(ipl);
@@ -153,9 +295,19 @@ void tlb_shootdown_ipi_recv(void)
 {
 	assert(CPU);
 
+	/*
+	 * Only the recipients of a shootdown have messages queued, but the
+	 * IPI is broadcast where the architecture cannot address single
+	 * processors, and a unicast IPI may find its messages already
+	 * handled by an earlier one. Messages are only removed from the
+	 * queue with tlblock held, so a recipient never sees an empty queue
+	 * here while the sender waits for it.
+	 */
+	if (CPU->tlb_messages_count == 0)
+		return;
+
 	CPU->tlb_active = false;
 	irq_spinlock_lock(&tlblock, false);
-	irq_spinlock_unlock(&tlblock, false);
 
 	irq_spinlock_lock(&CPU->lock, false);
 	assert(CPU->tlb_messages_count <= TLB_MESSAGE_QUEUE_LEN);
@@ -189,9 +341,64 @@ void tlb_shootdown_ipi_recv(void)
 
 	CPU->tlb_messages_count = 0;
 	irq_spinlock_unlock(&CPU->lock, false);
+
+	irq_spinlock_unlock(&tlblock, false);
 	CPU->tlb_active = true;
 }
 
+/** Note that an address space is being installed on this processor.
+ *
+ * From now on, the processor takes part in TLB shootdowns for the address
+ * space. If a shootdown which did not count with the processor is under
+ * way, wait for it to finish, as the page tables are being changed.
+ *
+ * Interrupts must be disabled and the page tables of the address space
+ * must not be installed yet. Otherwise the processor could load TLB
+ * entries which a shootdown that missed it would leave behind.
+ *
+ * @param as Address space being installed.
+ *
+ */
+void tlb_as_install(as_t *as)
+{
+	size_t bit = TLB_CPU_BIT(CPU->id);
+
+	if ((atomic_load(&as->tlb_cpus) & bit) != 0)
+		return;
+
+	atomic_fetch_or(&as->tlb_cpus, bit);
+
+	if (atomic_load(&shootdown_active)) {
+		CPU->tlb_active = false;
+		irq_spinlock_lock(&tlblock, false);
+		irq_spinlock_unlock(&tlblock, false);
+		CPU->tlb_active = true;
+	}
+}
+
+/** Note that an address space has been replaced on this processor.
+ *
+ * Interrupts must be disabled and the new address space must already be
+ * installed.
+ *
+ * @param as Address space being removed from the processor.
+ *
+ */
+void tlb_as_deinstall(as_t *as)
+{
+#ifndef CONFIG_ASID
+	/*
+	 * Without hardware ASIDs, installing another address space flushes
+	 * the TLB entries of the old one, so the processor no longer has to
+	 * take part in its shootdowns. With ASIDs, the entries stay around
+	 * until the ASID is stolen or freed. The bit cannot be cleared if
+	 * other processors share it.
+	 */
+	if (config.cpu_count <= sizeof(size_t) * 8)
+		atomic_fetch_and(&as->tlb_cpus, ~TLB_CPU_BIT(CPU->id));
+#endif
+}
+
 #endif /* CONFIG_SMP */
 
 /** @}
@@ -34,8 +34,11 @@
  * @file
  * @brief Scheduler and load balancing.
  *
- * This file contains the scheduler and kcpulb kernel thread which
- * performs load-balancing of per-CPU run queues.
+ * This file contains the scheduler and the load-balancing of per-CPU
+ * run queues. A CPU which runs out of ready threads steals one from
+ * another CPU before it goes idle, preferring CPUs close to it in the
+ * processor topology. Besides that, each CPU periodically pulls threads
+ * from CPUs with longer run queues.
  */
 
 #include <assert.h>
@@ -65,6 +68,20 @@
 #include <log.h>
 #include <stacktrace.h>
 
+/** Number of clock ticks a thread stays cache hot after it stopped running. */
+#define CACHE_HOT_TICKS  1
+
+/** Number of clock ticks between two periodic load balancing passes. */
+#define BALANCE_TICKS  (HZ / 10)
+
+/** Distance of two CPUs in the processor topology. */
+typedef enum {
+	DISTANCE_CORE,     /**< CPUs share a core. */
+	DISTANCE_PACKAGE,  /**< CPUs share a package. */
+	DISTANCE_REMOTE,   /**< CPUs are in different packages. */
+	DISTANCE_COUNT
+} cpu_distance_t;
+
 static void scheduler_separated_stack(void);
 
 atomic_t nrdy;  /**< Number of ready threads in the system. */
@@ -128,6 +145,9 @@ static void before_thread_runs(void)
 static void after_thread_ran(void)
 {
 	after_thread_ran_arch();
+
+	/* Remember when the thread's cache footprint was fresh */
+	THREAD->last_run_tick = CPU->timeout_tick;
 }
 
 #ifdef CONFIG_FPU_LAZY
@@ -172,6 +192,219 @@ void scheduler_init(void)
 {
 }
 
+/** Hand a thread taken from a run queue over to the current CPU
+ *
+ * @param thread Thread removed from a run queue, its lock held.
+ *               The lock is released.
+ * @param rq     Index of the run queue the thread was taken from.
+ * @param stolen The thread was taken from another CPU's run queue.
+ *
+ * @return The thread.
+ *
+ */
+static thread_t *dispatch_thread(thread_t *thread, unsigned int rq,
+    bool stolen)
+{
+	thread->cpu = CPU;
+	thread->ticks = us2ticks((rq + 1) * 10000);
+	thread->priority = rq;  /* Correct rq index */
+
+	/*
+	 * Clear the stolen flag so that it can be migrated
+	 * when load balancing needs emerge.
+	 */
+	thread->stolen = false;
+
+	/*
+	 * Cycle counters of different CPUs need not be synchronized, so a
+	 * thread made ready elsewhere may seem to have waited a negative time.
+	 */
+	uint64_t now = get_cycle();
+	uint64_t wait = (now > thread->ready_cycle) ?
+	    now - thread->ready_cycle : 0;
+
+	irq_spinlock_unlock(&thread->lock, false);
+
+	irq_spinlock_lock(&CPU->lock, false);
+	CPU->sched_dispatched++;
+	if (stolen)
+		CPU->sched_stolen++;
+	CPU->sched_wait_cycles += wait;
+	if (wait > CPU->sched_wait_max)
+		CPU->sched_wait_max = wait;
+	irq_spinlock_unlock(&CPU->lock, false);
+
+	return thread;
+}
+
+#ifdef CONFIG_SMP
+/** Get the distance of a CPU from the current CPU in the topology. */
+static cpu_distance_t cpu_distance(cpu_t *cpu)
+{
+	if (cpu->package != CPU->package)
+		return DISTANCE_REMOTE;
+
+	if (cpu->core != CPU->core)
+		return DISTANCE_PACKAGE;
+
+	return DISTANCE_CORE;
+}
+
+/** Decide whether a ready thread can be stolen by the current CPU
+ *
+ * @param thread   Ready thread, its lock held.
+ * @param victim   CPU in whose run queue the thread is.
+ * @param distance Distance of the victim from the current CPU.
+ *
+ * @return True if the thread can be moved to the current CPU.
+ *
+ */
+static bool thread_can_steal(thread_t *thread, cpu_t *victim,
+    cpu_distance_t distance)
+{
+	/*
+	 * Do not steal CPU-wired threads, threads already stolen,
+	 * threads for which migration was temporarily disabled or
+	 * threads whose FPU context is still in the CPU.
+	 */
+	if ((thread->wired) || (thread->stolen) || (thread->nomigrate) ||
+	    (thread->fpu_context_engaged))
+		return false;
+
+	if (distance != DISTANCE_REMOTE)
+		return true;
+
+	/*
+	 * Moving a thread to another package costs it its cache contents.
+	 * Leave the threads which have run only a moment ago alone. The
+	 * victim's tick is read without its lock, which is good enough for
+	 * a hint.
+	 */
+	if (victim->timeout_tick - thread->last_run_tick <= CACHE_HOT_TICKS)
+		return false;
+
+	/*
+	 * Do not take a thread away from its home package unless the victim
+	 * has more work to do anyway.
+	 */
+	return ((thread->home_package == CPU->package) ||
+	    (thread->home_package != victim->package) ||
+	    (atomic_load(&victim->nrdy) > 1));
+}
+
+/** Steal a ready thread from another CPU
+ *
+ * The victims are searched in the order of their distance from the
+ * current CPU, i.e. the CPUs sharing a core first, the CPUs sharing a
+ * package next and the rest last. Among the CPUs at the same distance,
+ * the search starts past the current CPU so that several thieves do not
+ * all go after the same victim. Each run queue is searched from its
+ * highest-priority end, so the thread stolen is the one which would
+ * otherwise have waited for the victim the least.
+ *
+ * @param min Steal only from CPUs with more than @a min ready threads.
+ * @param rq  Place to store the index of the run queue of the thread.
+ *
+ * @return Stolen thread with its lock held or NULL if there is none.
+ *
+ */
+static thread_t *steal_thread(size_t min, unsigned int *rq)
+{
+	for (cpu_distance_t distance = DISTANCE_CORE;
+	    distance < DISTANCE_COUNT; distance++) {
+		for (size_t acpu = 1; acpu < config.cpu_active; acpu++) {
+			cpu_t *cpu = &cpus[(CPU->id + acpu) % config.cpu_active];
+
+			if (cpu_distance(cpu) != distance)
+				continue;
+
+			if (atomic_load(&cpu->nrdy) <= min)
+				continue;
+
+			for (unsigned int i = 0; i < RQ_COUNT; i++) {
+				irq_spinlock_lock(&(cpu->rq[i].lock), false);
+
+				list_foreach(cpu->rq[i].rq, rq_link, thread_t,
+				    thread) {
+					irq_spinlock_lock(&thread->lock, false);
+
+					if (thread_can_steal(thread, cpu,
+					    distance)) {
+						/*
+						 * Remove thread from ready queue.
+						 */
+						atomic_dec(&cpu->nrdy);
+						atomic_dec(&nrdy);
+
+						cpu->rq[i].n--;
+						list_remove(&thread->rq_link);
+
+						irq_spinlock_unlock(
+						    &(cpu->rq[i].lock), false);
+
+						*rq = i;
+						return thread;
+					}
+
+					irq_spinlock_unlock(&thread->lock, false);
+				}
+
+				irq_spinlock_unlock(&(cpu->rq[i].lock), false);
+			}
+		}
+	}
+
+	return NULL;
+}
+
+/** Periodic load balancing
+ *
+ * An idle CPU steals work by itself, but a CPU with a short run queue
+ * would never take over any of the threads piling up elsewhere. Every
+ * BALANCE_TICKS ticks, the CPU therefore pulls threads from CPUs with
+ * more than the average number of ready threads until it has the average
+ * itself.
+ *
+ */
+static void balance_load(void)
+{
+	if (CPU->timeout_tick - CPU->balance_tick < BALANCE_TICKS)
+		return;
+
+	CPU->balance_tick = CPU->timeout_tick;
+
+	size_t average = atomic_load(&nrdy) / config.cpu_active + 1;
+	size_t rdy = atomic_load(&CPU->nrdy);
+
+	while (rdy < average) {
+		unsigned int rq;
+		thread_t *thread = steal_thread(average, &rq);
+		if (thread == NULL)
+			break;
+
+#ifdef SCHEDULER_VERBOSE
+		log(LF_OTHER, LVL_DEBUG,
+		    "cpu%u: TID %" PRIu64 " stolen, nrdy=%zu, avg=%zu",
+		    CPU->id, thread->tid, rdy, average);
+#endif
+
+		/*
+		 * Ready thread on local CPU
+		 */
+		thread->stolen = true;
+		thread->state = Entering;
+		irq_spinlock_unlock(&thread->lock, false);
+
+		thread_ready(thread);
+		rdy++;
+
+		irq_spinlock_lock(&CPU->lock, false);
+		CPU->sched_stolen++;
+		irq_spinlock_unlock(&CPU->lock, false);
+	}
+}
+#endif /* CONFIG_SMP */
+
 /** Get thread to be scheduled
  *
  * Get the optimal thread to be scheduled
@@ -185,9 +418,24 @@ static thread_t *find_best_thread(void)
 {
 	assert(CPU != NULL);
 
+#ifdef CONFIG_SMP
+	balance_load();
+#endif
+
 loop:
 
 	if (atomic_load(&CPU->nrdy) == 0) {
+#ifdef CONFIG_SMP
+		/*
+		 * Rather than going idle, take over a thread which
+		 * would have to wait for another CPU.
+		 */
+		unsigned int rq;
+		thread_t *thread = steal_thread(0, &rq);
+		if (thread != NULL)
+			return dispatch_thread(thread, rq, true);
+#endif
+
 		/*
 		 * For there was nothing to run, the CPU goes to sleep
 		 * until a hardware interrupt or an IPI comes.
@@ -234,18 +482,7 @@ loop:
 
 		irq_spinlock_pass(&(CPU->rq[i].lock), &thread->lock);
 
-		thread->cpu = CPU;
-		thread->ticks = us2ticks((i + 1) * 10000);
-		thread->priority = i;  /* Correct rq index */
-
-		/*
-		 * Clear the stolen flag so that it can be migrated
-		 * when load balancing needs emerge.
-		 */
-		thread->stolen = false;
-		irq_spinlock_unlock(&thread->lock, false);
-
-		return thread;
+		return dispatch_thread(thread, i, false);
 	}
 
 	goto loop;
@@ -536,178 +773,6 @@ void scheduler_separated_stack(void)
 	/* Not reached */
 }
 
-#ifdef CONFIG_SMP
-/** Load balancing thread
- *
- * SMP load balancing thread, supervising thread supplies
- * for the CPU it's wired to.
- *
- * @param arg Generic thread argument (unused).
- *
- */
-void kcpulb(void *arg)
-{
-	size_t average;
-	size_t rdy;
-
-	/*
-	 * Detach kcpulb as nobody will call thread_join_timeout() on it.
-	 */
-	thread_detach(THREAD);
-
-loop:
-	/*
-	 * Work in 1s intervals.
-	 */
-	thread_sleep(1);
-
-not_satisfied:
-	/*
-	 * Calculate the number of threads that will be migrated/stolen from
-	 * other CPU's. Note that situation can have changed between two
-	 * passes. Each time get the most up to date counts.
-	 *
-	 */
-	average = atomic_load(&nrdy) / config.cpu_active + 1;
-	rdy = atomic_load(&CPU->nrdy);
-
-	if (average <= rdy)
-		goto satisfied;
-
-	size_t count = average - rdy;
-
-	/*
-	 * Searching least priority queues on all CPU's first and most priority
-	 * queues on all CPU's last.
-	 */
-	size_t acpu;
-	size_t acpu_bias = 0;
-	int rq;
-
-	for (rq = RQ_COUNT - 1; rq >= 0; rq--) {
-		for (acpu = 0; acpu < config.cpu_active; acpu++) {
-			cpu_t *cpu = &cpus[(acpu + acpu_bias) % config.cpu_active];
-
-			/*
-			 * Not interested in ourselves.
-			 * Doesn't require interrupt disabling for kcpulb has
-			 * THREAD_FLAG_WIRED.
-			 *
-			 */
-			if (CPU == cpu)
-				continue;
-
-			if (atomic_load(&cpu->nrdy) <= average)
-				continue;
-
-			irq_spinlock_lock(&(cpu->rq[rq].lock), true);
-			if (cpu->rq[rq].n == 0) {
-				irq_spinlock_unlock(&(cpu->rq[rq].lock), true);
-				continue;
-			}
-
-			thread_t *thread = NULL;
-
-			/* Search rq from the back */
-			link_t *link = list_last(&cpu->rq[rq].rq);
-
-			while (link != NULL) {
-				thread = (thread_t *) list_get_instance(link,
-				    thread_t, rq_link);
-
-				/*
-				 * Do not steal CPU-wired threads, threads
-				 * already stolen, threads for which migration
-				 * was temporarily disabled or threads whose
-				 * FPU context is still in the CPU.
-				 */
-				irq_spinlock_lock(&thread->lock, false);
-
-				if ((!thread->wired) && (!thread->stolen) &&
-				    (!thread->nomigrate) &&
-				    (!thread->fpu_context_engaged)) {
-					/*
-					 * Remove thread from ready queue.
-					 */
-					irq_spinlock_unlock(&thread->lock,
-					    false);
-
-					atomic_dec(&cpu->nrdy);
-					atomic_dec(&nrdy);
-
-					cpu->rq[rq].n--;
-					list_remove(&thread->rq_link);
-
-					break;
-				}
-
-				irq_spinlock_unlock(&thread->lock, false);
-
-				link = list_prev(link, &cpu->rq[rq].rq);
-				thread = NULL;
-			}
-
-			if (thread) {
-				/*
-				 * Ready thread on local CPU
-				 */
-
-				irq_spinlock_pass(&(cpu->rq[rq].lock),
-				    &thread->lock);
-
-#ifdef KCPULB_VERBOSE
-				log(LF_OTHER, LVL_DEBUG,
-				    "kcpulb%u: TID %" PRIu64 " -> cpu%u, "
-				    "nrdy=%ld, avg=%ld", CPU->id, thread->tid,
-				    CPU->id, atomic_load(&CPU->nrdy),
-				    atomic_load(&nrdy) / config.cpu_active);
-#endif
-
-				thread->stolen = true;
-				thread->state = Entering;
-
-				irq_spinlock_unlock(&thread->lock, true);
-				thread_ready(thread);
-
-				if (--count == 0)
-					goto satisfied;
-
-				/*
-				 * We are not satisfied yet, focus on another
-				 * CPU next time.
-				 *
-				 */
-				acpu_bias++;
-
-				continue;
-			} else
-				irq_spinlock_unlock(&(cpu->rq[rq].lock), true);
-
-		}
-	}
-
-	if (atomic_load(&CPU->nrdy)) {
-		/*
-		 * Be a little bit light-weight and let migrated threads run.
-		 *
-		 */
-		scheduler();
-	} else {
-		/*
-		 * We failed to migrate a single thread.
-		 * Give up this turn.
-		 *
-		 */
-		goto loop;
-	}
-
-	goto not_satisfied;
-
-satisfied:
-	goto loop;
-}
-#endif /* CONFIG_SMP */
-
 /** Print information about threads & scheduler queues
  *
  */
@@ -307,6 +307,7 @@ void thread_ready(thread_t *thread)
 	}
 
 	thread->state = Ready;
+	thread->ready_cycle = get_cycle();
 
 	irq_spinlock_pass(&thread->lock, &(cpu->rq[i].lock));
 
@@ -380,6 +381,9 @@ thread_t *thread_create(void (*func)(void *), void *arg, task_t *task,
 	thread->cpu = NULL;
 	thread->wired = false;
 	thread->stolen = false;
+	thread->home_package = (CPU != NULL) ? CPU->package : 0;
+	thread->last_run_tick = 0;
+	thread->ready_cycle = 0;
 	thread->uspace =
 	    ((flags & THREAD_FLAG_USPACE) == THREAD_FLAG_USPACE);
 
@@ -39,6 +39,8 @@
 
 #include <smp/ipi.h>
 #include <config.h>
+#include <assert.h>
+#include <cpu.h>
 
 /** Broadcast IPI message
  *
@@ -59,6 +61,26 @@ void ipi_broadcast(int ipi)
 		ipi_broadcast_arch(ipi);
 }
 
+#ifdef CONFIG_IPI_UNICAST
+
+/** Send IPI message to one CPU
+ *
+ * Architectures which cannot address a single CPU do not define
+ * CONFIG_IPI_UNICAST and their callers have to use ipi_broadcast().
+ *
+ * @param cpu Destination CPU, different from the current one.
+ * @param ipi Message to send.
+ *
+ */
+void ipi_unicast(cpu_t *cpu, int ipi)
+{
+	assert(cpu != CPU);
+
+	ipi_unicast_arch(cpu, ipi);
+}
+
+#endif /* CONFIG_IPI_UNICAST */
+
 #endif /* CONFIG_SMP */
 
 /** @}
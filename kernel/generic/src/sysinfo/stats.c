@@ -43,6 +43,7 @@
 #include <synch/mutex.h>
 #include <time/clock.h>
 #include <mm/frame.h>
+#include <mm/slab.h>
 #include <proc/task.h>
 #include <proc/thread.h>
 #include <interrupt.h>
@@ -52,6 +53,7 @@
 #include <cpu.h>
 #include <arch.h>
 #include <stdlib.h>
+#include <macros.h>
 
 /** Bits of fixed-point precision for load */
 #define LOAD_FIXED_SHIFT  11
@@ -125,6 +127,10 @@ static void *get_stats_cpus(struct sysinfo_item *item, size_t *size,
 		stats_cpus[i].frequency_mhz = cpus[i].frequency_mhz;
 		stats_cpus[i].busy_cycles = cpus[i].busy_cycles;
 		stats_cpus[i].idle_cycles = cpus[i].idle_cycles;
+		stats_cpus[i].dispatched = cpus[i].sched_dispatched;
+		stats_cpus[i].stolen = cpus[i].sched_stolen;
+		stats_cpus[i].wait_cycles = cpus[i].sched_wait_cycles;
+		stats_cpus[i].wait_max = cpus[i].sched_wait_max;
 
 		irq_spinlock_unlock(&cpus[i].lock, true);
 	}
@@ -790,6 +796,39 @@ static void *get_stats_physmem(struct sysinfo_item *item, size_t *size,
 	return ((void *) stats_physmem);
 }
 
+/** Get slab cache statistics
+ *
+ * @param item    Sysinfo item (unused).
+ * @param size    Size of the returned data.
+ * @param dry_run Do not get the data, just calculate the size.
+ * @param data    Unused.
+ *
+ * @return Data containing several stats_slab_t structures.
+ *         If the return value is not NULL, it should be freed
+ *         in the context of the sysinfo request.
+ */
+static void *get_stats_slabs(struct sysinfo_item *item, size_t *size,
+    bool dry_run, void *data)
+{
+	size_t count = slab_stats_get(NULL, 0);
+
+	*size = sizeof(stats_slab_t) * count;
+	if ((dry_run) || (count == 0))
+		return NULL;
+
+	stats_slab_t *stats_slabs = (stats_slab_t *) malloc(*size);
+	if (stats_slabs == NULL) {
+		*size = 0;
+		return NULL;
+	}
+
+	/* Caches might have been created or destroyed in the meantime */
+	count = min(count, slab_stats_get(stats_slabs, count));
+	*size = sizeof(stats_slab_t) * count;
+
+	return ((void *) stats_slabs);
+}
+
 /** Get system load
  *
  * @param item    Sysinfo item (unused).
@@ -873,6 +912,7 @@ void stats_init(void)
 
 	sysinfo_set_item_gen_data("system.cpus", NULL, get_stats_cpus, NULL);
 	sysinfo_set_item_gen_data("system.physmem", NULL, get_stats_physmem, NULL);
+	sysinfo_set_item_gen_data("system.slabs", NULL, get_stats_slabs, NULL);
 	sysinfo_set_item_gen_data("system.load", NULL, get_stats_load, NULL);
 	sysinfo_set_item_gen_data("system.tasks", NULL, get_stats_tasks, NULL);
 	sysinfo_set_item_gen_data("system.threads", NULL, get_stats_threads, NULL);
@@ -163,17 +163,18 @@ void clock(void)
 
 		irq_spinlock_lock(&CPU->timeoutlock, false);
 
+		/*
+		 * Timeouts registered by the handlers to expire in this very
+		 * tick end up in the same slot and are run by this loop, too.
+		 */
+		list_t *expired = timeout_expired();
+
 		link_t *cur;
-		while ((cur = list_first(&CPU->timeout_active_list)) != NULL) {
+		while ((cur = list_first(expired)) != NULL) {
 			timeout_t *timeout = list_get_instance(cur, timeout_t,
 			    link);
 
 			irq_spinlock_lock(&timeout->lock, false);
-			if (timeout->ticks-- != 0) {
-				irq_spinlock_unlock(&timeout->lock, false);
-				break;
-			}
-
 			list_remove(cur);
 			timeout_handler_t handler = timeout->handler;
 			void *arg = timeout->arg;
@@ -187,6 +188,7 @@ void clock(void)
 			irq_spinlock_lock(&CPU->timeoutlock, false);
 		}
 
+		CPU->timeout_tick++;
 		irq_spinlock_unlock(&CPU->timeoutlock, false);
 	}
 	CPU->missed_clock_ticks = 0;
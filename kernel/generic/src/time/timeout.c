@@ -33,6 +33,16 @@
 /**
  * @file
  * @brief Timeout management functions.
+ *
+ * Pending timeouts of each CPU are kept in a hierarchical timing wheel, so
+ * that both registering and unregistering a timeout take constant time. A
+ * slot on level L of the wheel spans TIMEOUT_WHEEL_SLOTS^L clock ticks and
+ * a timeout lives on the lowest level whose range still reaches its
+ * deadline. When clock() gets to the beginning of a slot on a higher level,
+ * the timeouts in that slot are cascaded down, so by the time a deadline
+ * comes, its timeouts are all in a single slot on level 0. Timeouts too
+ * far in the future for the wheel wait in its top level until they are
+ * within its reach.
  */
 
 #include <time/timeout.h>
@@ -44,6 +54,7 @@
 #include <cpu.h>
 #include <arch/asm.h>
 #include <arch.h>
+#include <assert.h>
 
 /** Initialize timeouts
  *
@@ -53,7 +64,13 @@
 void timeout_init(void)
 {
 	irq_spinlock_initialize(&CPU->timeoutlock, "cpu.timeoutlock");
-	list_initialize(&CPU->timeout_active_list);
+
+	for (unsigned int level = 0; level < TIMEOUT_WHEEL_LEVELS; level++) {
+		for (unsigned int slot = 0; slot < TIMEOUT_WHEEL_SLOTS; slot++)
+			list_initialize(&CPU->timeout_wheel[level][slot]);
+	}
+
+	CPU->timeout_tick = 0;
 }
 
 /** Reinitialize timeout
@@ -66,7 +83,7 @@ void timeout_init(void)
 void timeout_reinitialize(timeout_t *timeout)
 {
 	timeout->cpu = NULL;
-	timeout->ticks = 0;
+	timeout->deadline = 0;
 	timeout->handler = NULL;
 	timeout->arg = NULL;
 	link_initialize(&timeout->link);
@@ -85,6 +102,78 @@ void timeout_initialize(timeout_t *timeout)
 	timeout_reinitialize(timeout);
 }
 
+/** Insert timeout into the timeout wheel of a CPU
+ *
+ * The caller must hold cpu->timeoutlock.
+ *
+ * @param cpu     CPU whose wheel is used.
+ * @param timeout Timeout with its deadline set.
+ *
+ */
+static void timeout_wheel_insert(cpu_t *cpu, timeout_t *timeout)
+{
+	uint64_t now = cpu->timeout_tick;
+	uint64_t expires = timeout->deadline;
+
+	assert(expires >= now);
+
+	/* The top level reaches this far, keep farther timeouts at its end. */
+	uint64_t range = (uint64_t) 1 <<
+	    (TIMEOUT_WHEEL_BITS * TIMEOUT_WHEEL_LEVELS);
+	if (expires - now >= range)
+		expires = now + range - 1;
+
+	unsigned int level = 0;
+	while ((expires - now) >>
+	    (TIMEOUT_WHEEL_BITS * (level + 1)) != 0)
+		level++;
+
+	unsigned int slot = (expires >> (TIMEOUT_WHEEL_BITS * level)) &
+	    (TIMEOUT_WHEEL_SLOTS - 1);
+
+	list_append(&timeout->link, &cpu->timeout_wheel[level][slot]);
+}
+
+/** Get timeouts expiring in the current clock tick
+ *
+ * Cascade timeouts from the slots that start in the current clock tick
+ * (CPU->timeout_tick) down the wheel. Afterwards, all timeouts with the
+ * current tick as their deadline are on level 0. The caller must hold
+ * CPU->timeoutlock.
+ *
+ * @return Wheel slot with the timeouts that expire in the current tick.
+ *
+ */
+list_t *timeout_expired(void)
+{
+	uint64_t now = CPU->timeout_tick;
+
+	for (unsigned int level = 1; level < TIMEOUT_WHEEL_LEVELS; level++) {
+		unsigned int shift = TIMEOUT_WHEEL_BITS * level;
+
+		/* Slots of this level begin only at multiples of their span. */
+		if ((now & (((uint64_t) 1 << shift) - 1)) != 0)
+			break;
+
+		list_t *slot = &CPU->timeout_wheel[level]
+		    [(now >> shift) & (TIMEOUT_WHEEL_SLOTS - 1)];
+
+		/*
+		 * The deadline of a registered timeout does not change, so
+		 * there is no need to take its lock to read it.
+		 */
+		list_foreach_safe(*slot, cur, next) {
+			timeout_t *timeout = list_get_instance(cur, timeout_t,
+			    link);
+
+			list_remove(cur);
+			timeout_wheel_insert(CPU, timeout);
+		}
+	}
+
+	return &CPU->timeout_wheel[0][now & (TIMEOUT_WHEEL_SLOTS - 1)];
+}
+
 /** Register timeout
  *
  * Insert timeout handler f (with argument arg)
@@ -107,52 +196,12 @@ void timeout_register(timeout_t *timeout, uint64_t time,
 		panic("Unexpected: timeout->cpu != 0.");
 
 	timeout->cpu = CPU;
-	timeout->ticks = us2ticks(time);
+	timeout->deadline = CPU->timeout_tick + us2ticks(time);
 
 	timeout->handler = handler;
 	timeout->arg = arg;
 
-	/*
-	 * Insert timeout into the active timeouts list according to timeout->ticks.
-	 */
-	uint64_t sum = 0;
-	timeout_t *target = NULL;
-	link_t *cur, *prev;
-	prev = NULL;
-	for (cur = list_first(&CPU->timeout_active_list);
-	    cur != NULL; cur = list_next(cur, &CPU->timeout_active_list)) {
-		target = list_get_instance(cur, timeout_t, link);
-		irq_spinlock_lock(&target->lock, false);
-
-		if (timeout->ticks < sum + target->ticks) {
-			irq_spinlock_unlock(&target->lock, false);
-			break;
-		}
-
-		sum += target->ticks;
-		irq_spinlock_unlock(&target->lock, false);
-		prev = cur;
-	}
-
-	if (prev == NULL)
-		list_prepend(&timeout->link, &CPU->timeout_active_list);
-	else
-		list_insert_after(&timeout->link, prev);
-
-	/*
-	 * Adjust timeout->ticks according to ticks
-	 * accumulated in target's predecessors.
-	 */
-	timeout->ticks -= sum;
-
-	/*
-	 * Decrease ticks of timeout's immediate succesor by timeout->ticks.
-	 */
-	if (cur != NULL) {
-		irq_spinlock_lock(&target->lock, false);
-		target->ticks -= timeout->ticks;
-		irq_spinlock_unlock(&target->lock, false);
-	}
+	timeout_wheel_insert(CPU, timeout);
 
 	irq_spinlock_unlock(&timeout->lock, false);
 	irq_spinlock_unlock(&CPU->timeoutlock, true);
@@ -186,18 +235,9 @@ grab_locks:
 
 	/*
 	 * Now we know for sure that timeout hasn't been activated yet
-	 * and is lurking in timeout->cpu->timeout_active_list.
+	 * and is lurking in the timeout wheel of timeout->cpu.
 	 */
 
-	link_t *cur = list_next(&timeout->link,
-	    &timeout->cpu->timeout_active_list);
-	if (cur != NULL) {
-		timeout_t *tmp = list_get_instance(cur, timeout_t, link);
-		irq_spinlock_lock(&tmp->lock, false);
-		tmp->ticks += timeout->ticks;
-		irq_spinlock_unlock(&tmp->lock, false);
-	}
-
 	list_remove(&timeout->link);
 	irq_spinlock_unlock(&timeout->cpu->timeoutlock, false);
 
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <test.h>
+#include <mm/page.h>
+#include <mm/frame.h>
+#include <stdlib.h>
+#include <arch/mm/page.h>
+#include <typedefs.h>
+#include <atomic.h>
+#include <proc/thread.h>
+#include <cpu.h>
+#include <config.h>
+#include <arch.h>
+
+/*
+ * Allocate and free frames on all processors at the same time, mostly
+ * single frames, which go through the per-CPU frame caches, mixed with
+ * some larger blocks. Every frame is tagged with its owner while it is
+ * allocated, so that a frame handed out twice is detected.
+ */
+
+#define MAX_FRAMES  256
+#define ROUNDS      200
+
+static atomic_t thread_fail;
+
+/** Frame tag identifying the owner and the frame itself. */
+static uintptr_t frame_tag(unsigned int owner, uintptr_t frame)
+{
+	return (frame ^ ((uintptr_t) owner << 1)) | 1;
+}
+
+static void falloc(void *arg)
+{
+	unsigned int owner = (unsigned int) (uintptr_t) arg;
+	uint32_t seed = 0xdeadbeef + owner;
+
+	uintptr_t *frames = malloc(MAX_FRAMES * sizeof(uintptr_t));
+	size_t *counts = malloc(MAX_FRAMES * sizeof(size_t));
+	if ((frames == NULL) || (counts == NULL)) {
+		TPRINTF("cpu%u: Unable to allocate frame arrays\n", CPU->id);
+		atomic_inc(&thread_fail);
+		free(frames);
+		free(counts);
+		return;
+	}
+
+	for (unsigned int round = 0; round < ROUNDS; round++) {
+		size_t allocated = 0;
+
+		for (size_t i = 0; i < MAX_FRAMES; i++) {
+			seed = seed * 1103515245 + 12345;
+			size_t count = ((seed >> 16) % 8 == 0) ? 2 : 1;
+
+			uintptr_t frame = frame_alloc(count,
+			    FRAME_ATOMIC | FRAME_LOWMEM, 0);
+			if (frame == 0)
+				break;
+
+			*((uintptr_t *) PA2KA(frame)) = frame_tag(owner, frame);
+			frames[allocated] = frame;
+			counts[allocated] = count;
+			allocated++;
+		}
+
+		/* Free in a different order than allocated. */
+		for (size_t j = 0; j < allocated; j++) {
+			size_t i = (j * 7) % allocated;
+			while (frames[i] == 0)
+				i = (i + 1) % allocated;
+
+			if (*((uintptr_t *) PA2KA(frames[i])) !=
+			    frame_tag(owner, frames[i])) {
+				TPRINTF("cpu%u: Frame %p overwritten\n", CPU->id,
+				    (void *) frames[i]);
+				atomic_inc(&thread_fail);
+			}
+
+			frame_free(frames[i], counts[i]);
+			frames[i] = 0;
+		}
+	}
+
+	free(frames);
+	free(counts);
+}
+
+const char *test_falloc3(void)
+{
+	thread_t **threads = malloc(config.cpu_count * sizeof(thread_t *));
+	if (threads == NULL)
+		return "Unable to allocate thread array";
+
+	atomic_store(&thread_fail, 0);
+
+	for (unsigned int i = 0; i < config.cpu_count; i++) {
+		threads[i] = NULL;
+		if (!cpus[i].active)
+			continue;
+
+		threads[i] = thread_create(falloc, (void *) (uintptr_t) i,
+		    TASK, THREAD_FLAG_NONE, "falloc3");
+		if (threads[i] == NULL) {
+			TPRINTF("Could not create thread for cpu%u\n", i);
+			atomic_inc(&thread_fail);
+			continue;
+		}
+
+		thread_wire(threads[i], &cpus[i]);
+		thread_ready(threads[i]);
+	}
+
+	for (unsigned int i = 0; i < config.cpu_count; i++) {
+		if (threads[i] == NULL)
+			continue;
+
+		thread_join(threads[i]);
+		thread_detach(threads[i]);
+	}
+
+	free(threads);
+
+	if (atomic_load(&thread_fail) == 0)
+		return NULL;
+
+	return "Test failed";
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <test.h>
+#include <atomic.h>
+#include <proc/thread.h>
+#include <time/delay.h>
+#include <stdlib.h>
+#include <cpu.h>
+#include <config.h>
+#include <arch.h>
+
+/*
+ * Make many busy threads ready on one processor and check that the other
+ * processors steal some of them instead of idling.
+ */
+
+#define THREADS_PER_CPU  4
+#define ROUNDS           200
+
+static atomic_t *ran_on;
+static atomic_t threads_finished;
+
+static void busy(void *data)
+{
+	for (unsigned int round = 0; round < ROUNDS; round++) {
+		/* Migration is disabled only for the duration of one delay */
+		delay(1000);
+		atomic_inc(&ran_on[CPU->id]);
+	}
+
+	atomic_inc(&threads_finished);
+}
+
+const char *test_thread2(void)
+{
+	ran_on = malloc(config.cpu_count * sizeof(atomic_t));
+	if (ran_on == NULL)
+		return "Unable to allocate counters";
+
+	uint64_t stolen = 0;
+	for (unsigned int i = 0; i < config.cpu_count; i++) {
+		atomic_store(&ran_on[i], 0);
+		irq_spinlock_lock(&cpus[i].lock, true);
+		stolen -= cpus[i].sched_stolen;
+		irq_spinlock_unlock(&cpus[i].lock, true);
+	}
+
+	atomic_store(&threads_finished, 0);
+
+	size_t count = THREADS_PER_CPU * config.cpu_active;
+	size_t total = 0;
+
+	/* All the threads go to the run queue of this processor */
+	thread_migration_disable();
+	for (size_t i = 0; i < count; i++) {
+		thread_t *thread = thread_create(busy, NULL, TASK,
+		    THREAD_FLAG_NONE, "thread2");
+		if (thread == NULL) {
+			TPRINTF("Could not create thread %zu\n", i);
+			break;
+		}
+
+		thread_detach(thread);
+		thread_ready(thread);
+		total++;
+	}
+	thread_migration_enable();
+
+	while (atomic_load(&threads_finished) < total)
+		thread_usleep(10000);
+
+	unsigned int used = 0;
+	for (unsigned int i = 0; i < config.cpu_count; i++) {
+		if (!cpus[i].active)
+			continue;
+
+		irq_spinlock_lock(&cpus[i].lock, true);
+		stolen += cpus[i].sched_stolen;
+		uint64_t dispatched = cpus[i].sched_dispatched;
+		uint64_t wait = (dispatched > 0) ?
+		    cpus[i].sched_wait_cycles / dispatched : 0;
+		uint64_t wait_max = cpus[i].sched_wait_max;
+		irq_spinlock_unlock(&cpus[i].lock, true);
+
+		TPRINTF("cpu%u: %zu rounds, avg wait %" PRIu64 " cycles, "
+		    "max wait %" PRIu64 " cycles\n", i,
+		    atomic_load(&ran_on[i]), wait, wait_max);
+
+		if (atomic_load(&ran_on[i]) > 0)
+			used++;
+	}
+
+	TPRINTF("%" PRIu64 " threads stolen\n", stolen);
+
+	free(ran_on);
+
+	if (total < count)
+		return "Unable to create all threads";
+
+	if ((config.cpu_active > 1) && ((used < 2) || (stolen == 0)))
+		return "Threads did not spread to other processors";
+
+	return NULL;
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <test.h>
+#include <arch.h>
+#include <arch/asm.h>
+#include <arch/cycle.h>
+#include <cpu.h>
+#include <stdlib.h>
+#include <time/timeout.h>
+
+/*
+ * Arm many timeouts far enough in the future for none of them to expire
+ * and cancel them all again. Both should take constant time per timeout,
+ * no matter how many timeouts are pending.
+ */
+
+#define TIMEOUT_COUNT  100000
+
+/* Delays between 5 and 60 seconds, in microseconds */
+#define DELAY_MIN      5000000
+#define DELAY_SPREAD   55000000
+
+static void handler(void *arg)
+{
+	bool *fired = arg;
+
+	*fired = true;
+}
+
+const char *test_timeout1(void)
+{
+	timeout_t *timeouts = malloc(TIMEOUT_COUNT * sizeof(timeout_t));
+	if (timeouts == NULL)
+		return "Cannot allocate timeouts";
+
+	bool fired = false;
+	uint32_t seed = 0xdeadbeef;
+
+	for (size_t i = 0; i < TIMEOUT_COUNT; i++)
+		timeout_initialize(&timeouts[i]);
+
+	TPRINTF("Arming %d timeouts...", TIMEOUT_COUNT);
+
+	uint64_t start = get_cycle();
+	for (size_t i = 0; i < TIMEOUT_COUNT; i++) {
+		seed = seed * 1103515245 + 12345;
+		timeout_register(&timeouts[i], DELAY_MIN + seed % DELAY_SPREAD,
+		    handler, &fired);
+	}
+	uint64_t armed = get_cycle();
+
+	TPRINTF(" %" PRIu64 " cycles per timeout\n",
+	    (armed - start) / TIMEOUT_COUNT);
+
+	TPRINTF("Cancelling %d timeouts...", TIMEOUT_COUNT);
+
+	size_t cancelled = 0;
+	start = get_cycle();
+	/* Cancel every other timeout first, then the rest. */
+	for (size_t i = 1; i < TIMEOUT_COUNT; i += 2) {
+		if (timeout_unregister(&timeouts[i]))
+			cancelled++;
+	}
+	for (size_t i = 0; i < TIMEOUT_COUNT; i += 2) {
+		if (timeout_unregister(&timeouts[i]))
+			cancelled++;
+	}
+	uint64_t done = get_cycle();
+
+	TPRINTF(" %" PRIu64 " cycles per timeout\n",
+	    (done - start) / TIMEOUT_COUNT);
+
+	free(timeouts);
+
+	if (fired)
+		return "Timeout fired too early";
+
+	if (cancelled != TIMEOUT_COUNT)
+		return "Not all timeouts could be cancelled";
+
+	return NULL;
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <test.h>
+#include <arch.h>
+#include <arch/asm.h>
+#include <atomic.h>
+#include <cpu.h>
+#include <stdlib.h>
+#include <proc/thread.h>
+#include <time/timeout.h>
+
+/*
+ * Arm many timeouts with short delays and let them all expire. Every
+ * timeout must fire exactly in the clock tick it was due in.
+ */
+
+#define TIMEOUT_COUNT  100000
+
+/* Delays of up to two seconds, in microseconds */
+#define DELAY_SPREAD   2000000
+
+/* How long to wait for the timeouts to fire, in microseconds */
+#define WAIT_LIMIT     10000000
+#define WAIT_STEP      100000
+
+typedef struct {
+	timeout_t timeout;
+	/** Clock tick the timeout is due in */
+	uint64_t due;
+} test_timeout_t;
+
+static atomic_t fired;
+static atomic_t misfired;
+
+static void handler(void *arg)
+{
+	test_timeout_t *test_timeout = arg;
+
+	if (CPU->timeout_tick != test_timeout->due)
+		atomic_inc(&misfired);
+
+	atomic_inc(&fired);
+}
+
+const char *test_timeout2(void)
+{
+	test_timeout_t *timeouts =
+	    malloc(TIMEOUT_COUNT * sizeof(test_timeout_t));
+	if (timeouts == NULL)
+		return "Cannot allocate timeouts";
+
+	atomic_store(&fired, 0);
+	atomic_store(&misfired, 0);
+	uint32_t seed = 0xdeadbeef;
+
+	TPRINTF("Arming %d timeouts...\n", TIMEOUT_COUNT);
+
+	for (size_t i = 0; i < TIMEOUT_COUNT; i++) {
+		seed = seed * 1103515245 + 12345;
+		uint32_t delay = seed % DELAY_SPREAD;
+
+		timeout_initialize(&timeouts[i].timeout);
+
+		/* Stay on this CPU to learn which tick the timeout is due in. */
+		ipl_t ipl = interrupts_disable();
+		timeouts[i].due = CPU->timeout_tick + us2ticks(delay);
+		timeout_register(&timeouts[i].timeout, delay, handler,
+		    &timeouts[i]);
+		interrupts_restore(ipl);
+	}
+
+	size_t waited = 0;
+	while (atomic_load(&fired) < TIMEOUT_COUNT && waited < WAIT_LIMIT) {
+		thread_usleep(WAIT_STEP);
+		waited += WAIT_STEP;
+	}
+
+	TPRINTF("%zu timeouts fired, %zu not in their tick\n",
+	    atomic_load(&fired), atomic_load(&misfired));
+
+	if (atomic_load(&fired) < TIMEOUT_COUNT) {
+		/* Do not free timeouts that could still fire. */
+		for (size_t i = 0; i < TIMEOUT_COUNT; i++)
+			timeout_unregister(&timeouts[i].timeout);
+		free(timeouts);
+		return "Not all timeouts fired";
+	}
+
+	free(timeouts);
+
+	if (atomic_load(&misfired) != 0)
+		return "Timeouts fired in a wrong clock tick";
+
+	return NULL;
+}
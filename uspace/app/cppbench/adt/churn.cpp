@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include "../cppbench.hpp"
+
+namespace cppbench
+{
+    namespace
+    {
+        /**
+         * Number of live keys kept in the container, each
+         * round erases and re-inserts every one of them
+         * in random order, the workload size is the number
+         * of rounds.
+         */
+        constexpr std::uint32_t churn_count{10000};
+
+        template<class T>
+        using pool_allocator = std::__ext::node_pool_allocator<T>;
+
+        using pool_map = std::map<
+            std::uint32_t, std::uint32_t, std::less<std::uint32_t>,
+            pool_allocator<std::pair<const std::uint32_t, std::uint32_t>>
+        >;
+
+        using pool_unordered_map = std::unordered_map<
+            std::uint32_t, std::uint32_t, std::hash<std::uint32_t>,
+            std::equal_to<std::uint32_t>,
+            pool_allocator<std::pair<const std::uint32_t, std::uint32_t>>
+        >;
+
+        using pool_list = std::list<std::uint32_t, pool_allocator<std::uint32_t>>;
+
+        std::uint32_t next_random(std::uint32_t& state)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+
+            return state;
+        }
+
+        template<class Map>
+        bool map_churn(run& r, std::uint64_t size)
+        {
+            std::uint32_t state{2463534242u};
+            Map map{};
+
+            for (std::uint32_t i = 0; i < churn_count; ++i)
+                map.emplace(i, i);
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                for (std::uint32_t j = 0; j < churn_count; ++j)
+                {
+                    auto key = next_random(state) % churn_count;
+
+                    if (map.erase(key) == 0)
+                        return r.fail("key was not found");
+                    map.emplace(key, j);
+                }
+            }
+            r.stop();
+
+            if (map.size() != churn_count)
+                return r.fail("wrong number of keys");
+
+            return true;
+        }
+
+        /**
+         * Pops from the front and pushes to the back, so that
+         * the freed node is immediately reused by the next
+         * push.
+         */
+        template<class List>
+        bool list_churn(run& r, std::uint64_t size)
+        {
+            List list{};
+
+            for (std::uint32_t i = 0; i < churn_count; ++i)
+                list.push_back(i);
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                for (std::uint32_t j = 0; j < churn_count; ++j)
+                {
+                    auto value = list.front();
+                    list.pop_front();
+                    list.push_back(value);
+                }
+            }
+            r.stop();
+
+            if (list.size() != churn_count)
+                return r.fail("wrong number of elements");
+
+            return true;
+        }
+    }
+
+    benchmark map_churn_std{
+        "map_churn_std",
+        "std::map erase + insert churn of 10000 keys, std::allocator",
+        &map_churn<std::map<std::uint32_t, std::uint32_t>>
+    };
+
+    benchmark map_churn_pool{
+        "map_churn_pool",
+        "std::map erase + insert churn of 10000 keys, node_pool_allocator",
+        &map_churn<pool_map>
+    };
+
+    benchmark unordered_map_churn_std{
+        "unordered_map_churn_std",
+        "std::unordered_map erase + insert churn of 10000 keys, std::allocator",
+        &map_churn<std::unordered_map<std::uint32_t, std::uint32_t>>
+    };
+
+    benchmark unordered_map_churn_pool{
+        "unordered_map_churn_pool",
+        "std::unordered_map erase + insert churn of 10000 keys, node_pool_allocator",
+        &map_churn<pool_unordered_map>
+    };
+
+    benchmark list_churn_std{
+        "list_churn_std",
+        "std::list pop_front + push_back churn of 10000 elements, std::allocator",
+        &list_churn<std::list<std::uint32_t>>
+    };
+
+    benchmark list_churn_pool{
+        "list_churn_pool",
+        "std::list pop_front + push_back churn of 10000 elements, node_pool_allocator",
+        &list_churn<pool_list>
+    };
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <unordered_map>
+#include "../cppbench.hpp"
+
+namespace cppbench
+{
+    namespace
+    {
+        /**
+         * Number of entries in the maps, the workload size
+         * is the number of passes over all of them.
+         */
+        constexpr std::uint32_t entry_count{1000000};
+
+        using flat_map = std::__ext::flat_hash_map<std::uint32_t, std::uint32_t>;
+        using chained_map = std::unordered_map<std::uint32_t, std::uint32_t>;
+
+        /**
+         * Multiplication by an odd constant is a bijection,
+         * so the keys are distinct but scattered.
+         */
+        std::uint32_t key_of(std::uint32_t i)
+        {
+            return i * 2654435761u;
+        }
+
+        /**
+         * Visits the indices in a different order than the one
+         * they were inserted in, otherwise the nodes of the
+         * chained map would be accessed in allocation order.
+         */
+        std::uint32_t index_of(std::uint32_t j)
+        {
+            return static_cast<std::uint32_t>((j * 15485863ull) % entry_count);
+        }
+
+        template<class Map>
+        void fill(Map& map)
+        {
+            for (std::uint32_t i = 0; i < entry_count; ++i)
+                map.emplace(key_of(i), i);
+        }
+
+        template<class Map>
+        bool hash_map_insert(run& r, std::uint64_t size)
+        {
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                Map map{};
+                fill(map);
+
+                if (map.size() != entry_count)
+                    return r.fail("wrong number of entries");
+            }
+            r.stop();
+
+            return true;
+        }
+
+        /**
+         * Every other lookup misses, the missing keys are
+         * the images of the indices past entry_count.
+         */
+        template<class Map>
+        bool hash_map_find(run& r, std::uint64_t size)
+        {
+            Map map{};
+            fill(map);
+
+            std::uint64_t found{};
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                for (std::uint32_t j = 0; j < entry_count; ++j)
+                {
+                    auto idx = index_of(j);
+                    auto key = key_of((idx & 1) ? idx : entry_count + idx);
+                    auto it = map.find(key);
+                    if (it != map.end())
+                        found += it->second;
+                }
+            }
+            r.stop();
+
+            std::uint64_t expected{};
+            for (std::uint32_t j = 1; j < entry_count; j += 2)
+                expected += j;
+
+            if (found != expected * size)
+                return r.fail("wrong entries found");
+
+            return true;
+        }
+
+        /**
+         * Erases all entries and inserts them back, so that
+         * every pass starts with a full map.
+         */
+        template<class Map>
+        bool hash_map_erase(run& r, std::uint64_t size)
+        {
+            Map map{};
+            fill(map);
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                for (std::uint32_t j = 0; j < entry_count; ++j)
+                {
+                    if (map.erase(key_of(index_of(j))) != 1)
+                        return r.fail("key was not found");
+                }
+
+                if (!map.empty())
+                    return r.fail("map not empty after erasure");
+
+                fill(map);
+            }
+            r.stop();
+
+            return true;
+        }
+    }
+
+    benchmark unordered_map_insert{
+        "unordered_map_insert",
+        "std::unordered_map insertion of 1000000 keys into an empty map",
+        &hash_map_insert<chained_map>
+    };
+
+    benchmark flat_hash_map_insert{
+        "flat_hash_map_insert",
+        "std::__ext::flat_hash_map insertion of 1000000 keys into an empty map",
+        &hash_map_insert<flat_map>
+    };
+
+    benchmark unordered_map_find{
+        "unordered_map_find",
+        "std::unordered_map lookups in a map of 1000000 keys, half of them missing",
+        &hash_map_find<chained_map>
+    };
+
+    benchmark flat_hash_map_find{
+        "flat_hash_map_find",
+        "std::__ext::flat_hash_map lookups in a map of 1000000 keys, half of them missing",
+        &hash_map_find<flat_map>
+    };
+
+    benchmark unordered_map_erase{
+        "unordered_map_erase",
+        "std::unordered_map erasure of all 1000000 keys followed by reinsertion",
+        &hash_map_erase<chained_map>
+    };
+
+    benchmark flat_hash_map_erase{
+        "flat_hash_map_erase",
+        "std::__ext::flat_hash_map erasure of all 1000000 keys followed by reinsertion",
+        &hash_map_erase<flat_map>
+    };
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "../cppbench.hpp"
+
+namespace cppbench
+{
+    namespace
+    {
+        /**
+         * Number of elements sorted in each round,
+         * the workload size is the number of rounds.
+         */
+        constexpr std::size_t sort_count{10000};
+
+        /**
+         * Record with a key and enough payload to make
+         * element moves cost more than the comparisons.
+         */
+        struct record
+        {
+            std::uint32_t key;
+            std::uint32_t payload[15];
+
+            bool operator<(const record& other) const
+            {
+                return key < other.key;
+            }
+        };
+
+        std::uint32_t next_random(std::uint32_t& state)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+
+            return state;
+        }
+
+        template<class T>
+        std::vector<T> make_input();
+
+        template<>
+        std::vector<int> make_input<int>()
+        {
+            std::uint32_t state{2463534242u};
+
+            std::vector<int> res(sort_count);
+            for (auto& x: res)
+                x = static_cast<int>(next_random(state) % sort_count);
+
+            return res;
+        }
+
+        template<>
+        std::vector<record> make_input<record>()
+        {
+            std::uint32_t state{2463534242u};
+
+            std::vector<record> res(sort_count);
+            for (auto& x: res)
+            {
+                x.key = next_random(state) % sort_count;
+                x.payload[0] = x.key;
+            }
+
+            return res;
+        }
+
+        /**
+         * Every round sorts a fresh copy of the same
+         * random input, the copy is part of the
+         * measurement but is the same for all variants.
+         */
+        template<class T, class Sorter>
+        bool sort_runner(run& r, std::uint64_t size, Sorter sorter)
+        {
+            auto input = make_input<T>();
+            std::vector<T> data(input.size());
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                std::copy(input.begin(), input.end(), data.begin());
+                sorter(data.begin(), data.end());
+            }
+            r.stop();
+
+            if (!std::is_sorted(data.begin(), data.end()))
+                return r.fail("output is not sorted");
+
+            return true;
+        }
+
+        template<class T>
+        bool introsort(run& r, std::uint64_t size)
+        {
+            return sort_runner<T>(r, size, [](auto first, auto last){
+                std::sort(first, last);
+            });
+        }
+
+        template<class T>
+        bool heapsort(run& r, std::uint64_t size)
+        {
+            return sort_runner<T>(r, size, [](auto first, auto last){
+                std::make_heap(first, last);
+                std::sort_heap(first, last);
+            });
+        }
+
+        template<class T>
+        bool mergesort(run& r, std::uint64_t size)
+        {
+            return sort_runner<T>(r, size, [](auto first, auto last){
+                std::stable_sort(first, last);
+            });
+        }
+    }
+
+    benchmark sort_int{
+        "sort_int",
+        "std::sort of 10000 random ints",
+        &introsort<int>
+    };
+
+    benchmark sort_int_heap{
+        "sort_int_heap",
+        "make_heap + sort_heap of 10000 random ints",
+        &heapsort<int>
+    };
+
+    benchmark sort_record{
+        "sort_record",
+        "std::sort of 10000 random 64B records",
+        &introsort<record>
+    };
+
+    benchmark sort_record_heap{
+        "sort_record_heap",
+        "make_heap + sort_heap of 10000 random 64B records",
+        &heapsort<record>
+    };
+
+    benchmark stable_sort_record{
+        "stable_sort_record",
+        "std::stable_sort of 10000 random 64B records",
+        &mergesort<record>
+    };
+}
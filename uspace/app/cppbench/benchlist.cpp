@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cppbench.hpp"
+
+namespace cppbench
+{
+    benchmark* benchmarks[] = {
+        &sort_int,
+        &sort_int_heap,
+        &sort_record,
+        &sort_record_heap,
+        &stable_sort_record,
+        &map_churn_std,
+        &map_churn_pool,
+        &unordered_map_churn_std,
+        &unordered_map_churn_pool,
+        &unordered_map_insert,
+        &flat_hash_map_insert,
+        &unordered_map_find,
+        &flat_hash_map_find,
+        &unordered_map_erase,
+        &flat_hash_map_erase,
+        &list_churn_std,
+        &list_churn_pool,
+        &string_construct_short,
+        &string_construct_long,
+        &string_concat_short,
+        &string_concat_long,
+        &string_hash_short,
+        &string_hash_long,
+        &regex_search_lines,
+        &regex_search_captures,
+        &regex_search_backref,
+        &regex_replace_log,
+        &charconv_int,
+        &charconv_double,
+        &fstream_read,
+        &fstream_read_mapped,
+        &fstream_read_chars,
+        &fstream_write_lines,
+        &ostringstream_ints,
+        &ostringstream_doubles,
+        &valarray_fma_fused,
+        &valarray_fma_temporaries,
+        &valarray_fma_loop,
+        &async_short_tasks,
+        &async_parallel_sum,
+        &atomic_counter_contended,
+        &mutex_counter_contended,
+        &atomic_wait_ping_pong
+    };
+
+    std::size_t benchmark_count = sizeof(benchmarks) / sizeof(benchmarks[0]);
+}
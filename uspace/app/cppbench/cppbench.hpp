@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CPPBENCH_HPP_
+#define CPPBENCH_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace cppbench
+{
+    inline constexpr std::size_t default_run_count{10};
+    inline constexpr std::uint64_t default_min_run_duration_msec{1000};
+
+    /**
+     * Single run information, mirrors bench_run_t of hbench.
+     * Benchmarks call start() and stop() around the measured
+     * code and report errors via fail().
+     */
+    class run
+    {
+        public:
+            void start()
+            {
+                start_ = std::chrono::steady_clock::now();
+            }
+
+            void stop()
+            {
+                end_ = std::chrono::steady_clock::now();
+            }
+
+            bool fail(const char* msg)
+            {
+                error_ = msg;
+
+                return false;
+            }
+
+            std::uint64_t usecs() const
+            {
+                return std::chrono::duration_cast<std::chrono::microseconds>(
+                    end_ - start_
+                ).count();
+            }
+
+            const char* error() const
+            {
+                return error_;
+            }
+
+        private:
+            std::chrono::steady_clock::time_point start_{};
+            std::chrono::steady_clock::time_point end_{};
+            const char* error_{};
+    };
+
+    /**
+     * The second argument is the workload size, used
+     * to self-calibrate the benchmark (see main.cpp).
+     */
+    using runner = bool (*)(run&, std::uint64_t);
+
+    struct benchmark
+    {
+        const char* name;
+        const char* desc;
+        runner entry;
+    };
+
+    extern benchmark* benchmarks[];
+    extern std::size_t benchmark_count;
+
+    /* Put your benchmark descriptors here (and also to benchlist.cpp). */
+    extern benchmark sort_int;
+    extern benchmark sort_int_heap;
+    extern benchmark sort_record;
+    extern benchmark sort_record_heap;
+    extern benchmark stable_sort_record;
+    extern benchmark map_churn_std;
+    extern benchmark map_churn_pool;
+    extern benchmark unordered_map_churn_std;
+    extern benchmark unordered_map_churn_pool;
+    extern benchmark unordered_map_insert;
+    extern benchmark flat_hash_map_insert;
+    extern benchmark unordered_map_find;
+    extern benchmark flat_hash_map_find;
+    extern benchmark unordered_map_erase;
+    extern benchmark flat_hash_map_erase;
+    extern benchmark list_churn_std;
+    extern benchmark list_churn_pool;
+    extern benchmark string_construct_short;
+    extern benchmark string_construct_long;
+    extern benchmark string_concat_short;
+    extern benchmark string_concat_long;
+    extern benchmark string_hash_short;
+    extern benchmark string_hash_long;
+    extern benchmark regex_search_lines;
+    extern benchmark regex_search_captures;
+    extern benchmark regex_search_backref;
+    extern benchmark regex_replace_log;
+    extern benchmark charconv_int;
+    extern benchmark charconv_double;
+    extern benchmark fstream_read;
+    extern benchmark fstream_read_mapped;
+    extern benchmark fstream_read_chars;
+    extern benchmark fstream_write_lines;
+    extern benchmark ostringstream_ints;
+    extern benchmark ostringstream_doubles;
+    extern benchmark valarray_fma_fused;
+    extern benchmark valarray_fma_temporaries;
+    extern benchmark valarray_fma_loop;
+    extern benchmark async_short_tasks;
+    extern benchmark async_parallel_sum;
+    extern benchmark atomic_counter_contended;
+    extern benchmark mutex_counter_contended;
+    extern benchmark atomic_wait_ping_pong;
+}
+
+#endif
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "../cppbench.hpp"
+
+namespace cppbench
+{
+    namespace
+    {
+        /**
+         * Same default file as the file_read benchmark
+         * of hbench, so that the results can be compared.
+         */
+        const char* read_path = "/data/web/helenos.png";
+
+        const char* write_path = "/tmp/cppbench_fstream";
+
+        constexpr std::size_t chunk_size{4096};
+
+        bool read_chunks(run& r, std::uint64_t size, std::ios_base::openmode mode)
+        {
+            std::ifstream in{read_path, mode};
+            if (!in.is_open())
+                return r.fail("cannot open /data/web/helenos.png");
+
+            char buf[chunk_size];
+            std::uint64_t total{};
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                in.clear();
+                in.seekg(0);
+
+                while (in.read(buf, chunk_size), in.gcount() > 0)
+                    total += static_cast<std::uint64_t>(in.gcount());
+            }
+            r.stop();
+
+            if (total == 0)
+                return r.fail("nothing was read");
+
+            return true;
+        }
+
+        bool read_buffered(run& r, std::uint64_t size)
+        {
+            return read_chunks(r, size, std::ios_base::in | std::ios_base::binary);
+        }
+
+        bool read_mapped(run& r, std::uint64_t size)
+        {
+            return read_chunks(
+                r, size, std::ios_base::in | std::ios_base::binary | std::__ext::mapped
+            );
+        }
+
+        /**
+         * Character at a time, this is what the
+         * buffer is for.
+         */
+        bool read_chars(run& r, std::uint64_t size)
+        {
+            std::ifstream in{read_path, std::ios_base::in | std::ios_base::binary};
+            if (!in.is_open())
+                return r.fail("cannot open /data/web/helenos.png");
+
+            auto buf = in.rdbuf();
+            auto eof = std::ifstream::traits_type::eof();
+            std::uint64_t sum{};
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                buf->pubseekpos(0);
+
+                for (auto c = buf->sbumpc(); c != eof; c = buf->sbumpc())
+                    sum += static_cast<std::uint64_t>(c);
+            }
+            r.stop();
+
+            if (sum == 0)
+                return r.fail("nothing was read");
+
+            return true;
+        }
+
+        bool write_lines(run& r, std::uint64_t size)
+        {
+            std::string line(79, '-');
+            line.push_back('\n');
+
+            r.start();
+            {
+                std::ofstream out{write_path};
+                if (!out.is_open())
+                    return r.fail("cannot open /tmp/cppbench_fstream");
+
+                for (std::uint64_t i = 0; i < size; ++i)
+                    out << i << line;
+            }
+            r.stop();
+
+            std::remove(write_path);
+
+            return true;
+        }
+    }
+
+    benchmark fstream_read{
+        "fstream_read",
+        "std::ifstream::read in 4096 byte chunks of /data/web/helenos.png",
+        &read_buffered
+    };
+
+    benchmark fstream_read_mapped{
+        "fstream_read_mapped",
+        "std::ifstream::read in 4096 byte chunks of mapped /data/web/helenos.png",
+        &read_mapped
+    };
+
+    benchmark fstream_read_chars{
+        "fstream_read_chars",
+        "std::filebuf::sbumpc over /data/web/helenos.png",
+        &read_chars
+    };
+
+    benchmark fstream_write_lines{
+        "fstream_write_lines",
+        "std::ofstream of 80 character lines to /tmp",
+        &write_lines
+    };
+}
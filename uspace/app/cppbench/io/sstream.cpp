@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include "../cppbench.hpp"
+
+namespace cppbench
+{
+    namespace
+    {
+        /**
+         * The stream is emptied after this many values,
+         * so that a run of ten million integers does not
+         * keep a hundred megabytes of text around.
+         */
+        constexpr std::uint64_t values_per_stream{1 << 16};
+
+        /**
+         * Spreads the values over the whole range so that
+         * numbers of all lengths are written.
+         */
+        std::int64_t value(std::uint64_t i)
+        {
+            auto x = i * 0x9e3779b97f4a7c15ULL;
+
+            return static_cast<std::int64_t>(x >> (x & 63));
+        }
+
+        bool write_ints(run& r, std::uint64_t size)
+        {
+            std::ostringstream out{};
+            std::uint64_t total{};
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                out << value(i) << ' ';
+
+                if ((i + 1) % values_per_stream == 0)
+                {
+                    total += out.str().size();
+                    out.str(std::string{});
+                }
+            }
+            total += out.str().size();
+            r.stop();
+
+            if (total < 2 * size)
+                return r.fail("stream lost characters");
+
+            return true;
+        }
+
+        bool write_doubles(run& r, std::uint64_t size)
+        {
+            std::ostringstream out{};
+            std::uint64_t total{};
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                out << static_cast<double>(value(i)) / 1024.0 << ' ';
+
+                if ((i + 1) % values_per_stream == 0)
+                {
+                    total += out.str().size();
+                    out.str(std::string{});
+                }
+            }
+            total += out.str().size();
+            r.stop();
+
+            if (total < 2 * size)
+                return r.fail("stream lost characters");
+
+            return true;
+        }
+    }
+
+    benchmark ostringstream_ints{
+        "ostringstream_ints",
+        "std::ostringstream << of 64 bit integers",
+        &write_ints
+    };
+
+    benchmark ostringstream_doubles{
+        "ostringstream_doubles",
+        "std::ostringstream << of doubles in the default format",
+        &write_doubles
+    };
+}
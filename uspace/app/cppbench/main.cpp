@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "cppbench.hpp"
+
+namespace cppbench
+{
+    namespace
+    {
+        struct config
+        {
+            std::size_t run_count{default_run_count};
+            std::uint64_t min_run_duration_usec{
+                default_min_run_duration_msec * 1000
+            };
+        };
+
+        void short_report(const run& r, std::uint64_t size)
+        {
+            auto usecs = r.usecs();
+
+            std::printf("Completed %llu operations in %llu us",
+                        static_cast<unsigned long long>(size),
+                        static_cast<unsigned long long>(usecs));
+            if (usecs > 0)
+                std::printf(", %.0f ops/s.\n", size / (usecs / 1000000.0));
+            else
+                std::printf(".\n");
+        }
+
+        bool run_benchmark(const config& conf, benchmark& bench)
+        {
+            std::printf("Warm up and determine workload size...\n");
+
+            /**
+             * Find workload size that is big enough to
+             * last the minimal duration.
+             */
+            std::uint64_t size{};
+            for (unsigned int bits = 0; bits <= 64; ++bits)
+            {
+                if (bits == 64)
+                {
+                    std::printf("Error: Workload too small even for 1 << 63\n");
+
+                    return false;
+                }
+                size = std::uint64_t{1} << bits;
+
+                run r{};
+                if (!bench.entry(r, size))
+                {
+                    std::printf("Error: %s\n", r.error());
+
+                    return false;
+                }
+                short_report(r, size);
+
+                if (r.usecs() > conf.min_run_duration_usec)
+                    break;
+            }
+
+            std::printf("Workload size set to %llu, measuring %zu samples.\n",
+                        static_cast<unsigned long long>(size), conf.run_count);
+
+            /**
+             * Note: As in hbench, average throughput is computed
+             *       from the total time, not as mean of the
+             *       per-run throughputs.
+             */
+            std::uint64_t total_usecs{};
+            for (std::size_t i = 0; i < conf.run_count; ++i)
+            {
+                run r{};
+                if (!bench.entry(r, size))
+                {
+                    std::printf("Error: %s\n", r.error());
+
+                    return false;
+                }
+                short_report(r, size);
+
+                total_usecs += r.usecs();
+            }
+
+            auto avg_usecs = total_usecs / static_cast<double>(conf.run_count);
+            std::printf("Average: %llu ops in %.0f us; %.0f ops/s; Samples: %zu\n",
+                        static_cast<unsigned long long>(size), avg_usecs,
+                        avg_usecs > 0 ? size / (avg_usecs / 1000000.0) : 0.0,
+                        conf.run_count);
+            std::printf("\nBenchmark completed\n");
+
+            return true;
+        }
+
+        void print_usage(const char* progname)
+        {
+            std::printf("Usage: %s [options] <benchmark>\n", progname);
+            std::printf("-d MILLIS  Set minimal run duration (milliseconds)\n");
+            std::printf("-n N       Set number of measured runs\n");
+            std::printf("<benchmark> is one of the following:\n");
+
+            for (std::size_t i = 0; i < benchmark_count; ++i)
+            {
+                std::printf("  %-20s %s\n", benchmarks[i]->name,
+                            benchmarks[i]->desc);
+            }
+            std::printf("  %-20s Run all benchmarks\n", "*");
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace cppbench;
+
+    config conf{};
+
+    int idx{1};
+    while (idx + 1 < argc && argv[idx][0] == '-')
+    {
+        auto value = std::stoul(argv[idx + 1]);
+        if (value == 0)
+        {
+            print_usage(argv[0]);
+
+            return 1;
+        }
+
+        if (std::strcmp(argv[idx], "-d") == 0)
+            conf.min_run_duration_usec = static_cast<std::uint64_t>(value) * 1000;
+        else if (std::strcmp(argv[idx], "-n") == 0)
+            conf.run_count = static_cast<std::size_t>(value);
+        else
+        {
+            print_usage(argv[0]);
+
+            return 1;
+        }
+
+        idx += 2;
+    }
+
+    if (idx + 1 != argc)
+    {
+        print_usage(argv[0]);
+
+        return 1;
+    }
+
+    const char* name = argv[idx];
+    bool all = std::strcmp(name, "*") == 0;
+
+    unsigned int count_ok{};
+    unsigned int count_fail{};
+    for (std::size_t i = 0; i < benchmark_count; ++i)
+    {
+        if (!all && std::strcmp(name, benchmarks[i]->name) != 0)
+            continue;
+
+        std::printf("%s (%s)\n", benchmarks[i]->name, benchmarks[i]->desc);
+        if (run_benchmark(conf, *benchmarks[i]))
+            ++count_ok;
+        else
+            ++count_fail;
+    }
+
+    if (count_ok + count_fail == 0)
+    {
+        std::printf("Error: unknown benchmark '%s'.\n", name);
+
+        return 1;
+    }
+
+    std::printf("\nCompleted, %u benchmarks run, %u succeeded.\n",
+                count_ok + count_fail, count_ok);
+
+    return count_fail == 0 ? 0 : 1;
+}
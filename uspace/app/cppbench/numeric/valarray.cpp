@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <valarray>
+#include <vector>
+#include "../cppbench.hpp"
+
+namespace cppbench
+{
+    namespace
+    {
+        /**
+         * Number of elements of each operand, the workload
+         * size is the number of times d = a * d + c is
+         * computed. Three arrays of this size fit into L2.
+         *
+         * Note: Each round depends on the previous one, so
+         *       the compiler cannot hoist the computation out
+         *       of the round loop. With |a| < 1 the values
+         *       converge to c / (1 - a) instead of overflowing.
+         */
+        constexpr std::size_t element_count{16384};
+
+        template<class Container>
+        void fill(Container& a, Container& c, Container& d)
+        {
+            for (std::size_t i = 0; i < element_count; ++i)
+            {
+                a[i] = static_cast<double>(i % 7 + 1) * 0.1;
+                c[i] = static_cast<double>(i % 13) * 0.25;
+                d[i] = 0.0;
+            }
+        }
+
+        template<class Container>
+        bool check(run& r, const Container& a, const Container& c,
+                   const Container& d, std::uint64_t size)
+        {
+            for (std::size_t i = 0; i < element_count; ++i)
+            {
+                double expected{};
+                for (std::uint64_t j = 0; j < size; ++j)
+                    expected = a[i] * expected + c[i];
+
+                auto diff = d[i] - expected;
+                if (diff > 1e-9 || diff < -1e-9)
+                    return r.fail("wrong result");
+            }
+
+            return true;
+        }
+
+        bool fused(run& r, std::uint64_t size)
+        {
+            std::valarray<double> a(element_count), c(element_count),
+                                  d(element_count);
+            fill(a, c, d);
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+                d = a * d + c;
+            r.stop();
+
+            return check(r, a, c, d, size);
+        }
+
+        /**
+         * What we would do without expression templates,
+         * every operator creates a new valarray.
+         */
+        bool temporaries(run& r, std::uint64_t size)
+        {
+            std::valarray<double> a(element_count), c(element_count),
+                                  d(element_count);
+            fill(a, c, d);
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                std::valarray<double> tmp = a * d;
+                d = tmp + c;
+            }
+            r.stop();
+
+            return check(r, a, c, d, size);
+        }
+
+        bool loop(run& r, std::uint64_t size)
+        {
+            std::vector<double> a(element_count), c(element_count),
+                                d(element_count);
+            fill(a, c, d);
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                for (std::size_t j = 0; j < element_count; ++j)
+                    d[j] = a[j] * d[j] + c[j];
+            }
+            r.stop();
+
+            return check(r, a, c, d, size);
+        }
+    }
+
+    benchmark valarray_fma_fused{
+        "valarray_fma_fused",
+        "d = a * d + c over 16384 doubles with valarray expressions",
+        &fused
+    };
+
+    benchmark valarray_fma_temporaries{
+        "valarray_fma_temporaries",
+        "d = a * d + c over 16384 doubles with a temporary valarray",
+        &temporaries
+    };
+
+    benchmark valarray_fma_loop{
+        "valarray_fma_loop",
+        "d[i] = a[i] * d[i] + c[i] over 16384 doubles in a vector",
+        &loop
+    };
+}
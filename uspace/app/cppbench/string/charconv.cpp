@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <charconv>
+#include <cstdint>
+#include "../cppbench.hpp"
+
+namespace cppbench
+{
+    namespace
+    {
+        std::int64_t value(std::uint64_t i)
+        {
+            auto x = i * 0x9e3779b97f4a7c15ULL;
+
+            return static_cast<std::int64_t>(x >> (x & 63));
+        }
+
+        bool int_round_trip(run& r, std::uint64_t size)
+        {
+            char buf[32];
+            std::uint64_t errors{};
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                auto val = value(i);
+                auto res = std::to_chars(buf, buf + sizeof(buf), val);
+
+                std::int64_t tmp{};
+                std::from_chars(buf, res.ptr, tmp);
+                errors += (tmp != val);
+            }
+            r.stop();
+
+            if (errors > 0)
+                return r.fail("integer did not round trip");
+
+            return true;
+        }
+
+        bool double_round_trip(run& r, std::uint64_t size)
+        {
+            char buf[32];
+            std::uint64_t errors{};
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                auto val = static_cast<double>(value(i)) / 1024.0;
+                auto res = std::to_chars(buf, buf + sizeof(buf), val);
+
+                double tmp{};
+                std::from_chars(buf, res.ptr, tmp);
+                errors += (tmp != val);
+            }
+            r.stop();
+
+            if (errors > 0)
+                return r.fail("double did not round trip");
+
+            return true;
+        }
+    }
+
+    benchmark charconv_int{
+        "charconv_int",
+        "std::to_chars and std::from_chars of 64 bit integers",
+        &int_round_trip
+    };
+
+    benchmark charconv_double{
+        "charconv_double",
+        "shortest std::to_chars and std::from_chars of doubles",
+        &double_round_trip
+    };
+}
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <iterator>
+#include <regex>
+#include <string>
+#include "../cppbench.hpp"
+
+namespace cppbench
+{
+    namespace
+    {
+        /**
+         * Number of lines of the synthetic log,
+         * the workload size is the number of passes
+         * over it.
+         */
+        constexpr std::size_t line_count{20000};
+
+        const char* levels[] = {
+            "INFO", "DEBUG", "INFO", "WARN", "INFO", "DEBUG", "INFO", "ERROR"
+        };
+
+        const char* services[] = {
+            "devman", "locsrv", "vfs", "net", "console", "taskmon"
+        };
+
+        /**
+         * Every line looks like
+         *   "000123 INFO vfs: request 7 took 42 ms, status=ok"
+         * with a repeated word in every 16th line for the
+         * backreference benchmark.
+         */
+        std::string make_log()
+        {
+            std::string res{};
+            res.reserve(line_count * 64);
+
+            for (std::size_t i = 0; i < line_count; ++i)
+            {
+                res += std::to_string(100000 + i);
+                res += ' ';
+                res += levels[i % 8];
+                res += ' ';
+                res += services[i % 6];
+                res += ": request ";
+                res += std::to_string(i % 97);
+                res += (i % 16 == 0) ? " took took " : " took ";
+                res += std::to_string((i * 7) % 1000);
+                res += " ms, status=";
+                res += (i % 8 == 7) ? "timeout" : "ok";
+                res += '\n';
+            }
+
+            return res;
+        }
+
+        /**
+         * Filters the log line by line, as grep would. Has
+         * no captures, so only the DFA runs.
+         */
+        bool search_lines(run& r, std::uint64_t size)
+        {
+            auto log = make_log();
+            std::regex re{"ERROR (vfs|net): .*status=timeout"};
+            std::size_t count{};
+
+            std::size_t expected{};
+            for (std::size_t i = 0; i < line_count; ++i)
+            {
+                if (i % 8 == 7 && (i % 6 == 2 || i % 6 == 3))
+                    ++expected;
+            }
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                auto first = log.data();
+                auto last = log.data() + log.size();
+                while (first != last)
+                {
+                    auto eol = first;
+                    while (eol != last && *eol != '\n')
+                        ++eol;
+
+                    if (std::regex_search(first, eol, re))
+                        ++count;
+                    first = (eol == last) ? eol : eol + 1;
+                }
+            }
+            r.stop();
+
+            if (count != size * expected)
+                return r.fail("wrong number of matching lines");
+
+            return true;
+        }
+
+        /**
+         * Extracts key=value pairs with regex_iterator,
+         * which needs the captures of every match.
+         */
+        bool search_captures(run& r, std::uint64_t size)
+        {
+            auto log = make_log();
+            std::regex re{"(\\w+)=(\\w+)"};
+            std::size_t total{};
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                std::sregex_iterator it{log.begin(), log.end(), re};
+                for (std::sregex_iterator end{}; it != end; ++it)
+                    total += (*it)[2].length();
+            }
+            r.stop();
+
+            if (total == 0)
+                return r.fail("no pairs found");
+
+            return true;
+        }
+
+        /**
+         * Looks for doubled words, which requires
+         * the backtracking matcher.
+         */
+        bool search_backref(run& r, std::uint64_t size)
+        {
+            auto log = make_log();
+            std::regex re{"\\b(\\w+) \\1\\b"};
+            std::size_t count{};
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                std::sregex_iterator it{log.begin(), log.end(), re};
+                count += std::distance(it, std::sregex_iterator{});
+            }
+            r.stop();
+
+            if (count != size * (line_count / 16))
+                return r.fail("wrong number of doubled words");
+
+            return true;
+        }
+
+        bool replace(run& r, std::uint64_t size)
+        {
+            auto log = make_log();
+            std::regex re{"took ([0-9]+) ms"};
+            std::size_t total{};
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                auto res = std::regex_replace(log, re, "[$1us]");
+                total += res.size();
+            }
+            r.stop();
+
+            if (total == 0)
+                return r.fail("nothing was replaced");
+
+            return true;
+        }
+    }
+
+    benchmark regex_search_lines{
+        "regex_search_lines",
+        "std::regex_search over 20000 log lines, no captures",
+        &search_lines
+    };
+
+    benchmark regex_search_captures{
+        "regex_search_captures",
+        "std::sregex_iterator with two captures over a 20000 line log",
+        &search_captures
+    };
+
+    benchmark regex_search_backref{
+        "regex_search_backref",
+        "std::sregex_iterator with a backreference over a 20000 line log",
+        &search_backref
+    };
+
+    benchmark regex_replace_log{
+        "regex_replace_log",
+        "std::regex_replace over a 20000 line log",
+        &replace
+    };
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../cppbench.hpp"
+
+namespace cppbench
+{
+    namespace
+    {
+        /**
+         * Number of operations in each round,
+         * the workload size is the number of rounds.
+         */
+        constexpr std::size_t string_count{10000};
+
+        /**
+         * Path-like keys, short ones fit into the inline
+         * buffer of std::string, long ones do not.
+         */
+        const char* short_parts[] = {
+            "bin", "lib", "srv", "tmp", "data", "dev", "loc", "w"
+        };
+
+        const char* long_parts[] = {
+            "/system/services/devman/", "/configuration/locations/",
+            "/application/resources/", "/volumes/persistent/data/"
+        };
+
+        std::vector<std::string> make_keys(bool is_short)
+        {
+            std::vector<std::string> res{};
+            res.reserve(string_count);
+
+            for (std::size_t i = 0; i < string_count; ++i)
+            {
+                std::string key{is_short ? "/" : long_parts[i % 4]};
+                key += short_parts[i % 8];
+                key += std::to_string(i);
+                res.push_back(std::move(key));
+            }
+
+            return res;
+        }
+
+        /**
+         * Copies the keys into fresh strings, the only
+         * work done here is constructing and destroying
+         * the copies.
+         */
+        template<bool Short>
+        bool construct(run& r, std::uint64_t size)
+        {
+            auto keys = make_keys(Short);
+            std::size_t total{};
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                for (const auto& key: keys)
+                {
+                    std::string copy{key.c_str()};
+                    total += copy.size();
+                }
+            }
+            r.stop();
+
+            if (total == 0)
+                return r.fail("nothing was copied");
+
+            return true;
+        }
+
+        template<bool Short>
+        bool concatenate(run& r, std::uint64_t size)
+        {
+            std::size_t total{};
+            const char* prefix = Short ? "/" : long_parts[0];
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                for (std::size_t j = 0; j < string_count; ++j)
+                {
+                    auto path = std::string{prefix} + short_parts[j % 8] + "/x";
+                    total += path.size();
+                }
+            }
+            r.stop();
+
+            if (total == 0)
+                return r.fail("nothing was concatenated");
+
+            return true;
+        }
+
+        template<bool Short>
+        bool hash_lookup(run& r, std::uint64_t size)
+        {
+            auto keys = make_keys(Short);
+
+            std::unordered_map<std::string, std::size_t> map{};
+            for (std::size_t i = 0; i < keys.size(); ++i)
+                map.emplace(keys[i], i);
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                for (std::size_t j = 0; j < keys.size(); ++j)
+                {
+                    /**
+                     * Lookup through a temporary, as when the
+                     * key comes from a C string.
+                     */
+                    auto it = map.find(std::string{keys[j].c_str()});
+                    if (it == map.end() || it->second != j)
+                        return r.fail("key not found");
+                }
+            }
+            r.stop();
+
+            return true;
+        }
+    }
+
+    benchmark string_construct_short{
+        "string_construct_short",
+        "std::string construction of 10000 short keys",
+        &construct<true>
+    };
+
+    benchmark string_construct_long{
+        "string_construct_long",
+        "std::string construction of 10000 long keys",
+        &construct<false>
+    };
+
+    benchmark string_concat_short{
+        "string_concat_short",
+        "operator+ of short strings, 10000 times",
+        &concatenate<true>
+    };
+
+    benchmark string_concat_long{
+        "string_concat_long",
+        "operator+ of long strings, 10000 times",
+        &concatenate<false>
+    };
+
+    benchmark string_hash_short{
+        "string_hash_short",
+        "std::unordered_map<std::string> lookup of 10000 short keys",
+        &hash_lookup<true>
+    };
+
+    benchmark string_hash_long{
+        "string_hash_long",
+        "std::unordered_map<std::string> lookup of 10000 long keys",
+        &hash_lookup<false>
+    };
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <future>
+#include <thread>
+#include <vector>
+#include "../cppbench.hpp"
+
+namespace cppbench
+{
+    namespace
+    {
+        /**
+         * Number of tasks in each round,
+         * the workload size is the number of rounds.
+         */
+        constexpr std::size_t task_count{1000};
+
+        /**
+         * Launches many tiny tasks and waits for all of
+         * them, this measures the launch overhead.
+         */
+        bool short_tasks(run& r, std::uint64_t size)
+        {
+            std::vector<std::future<std::size_t>> futures{};
+            futures.reserve(task_count);
+            std::size_t total{};
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                for (std::size_t j = 0; j < task_count; ++j)
+                {
+                    futures.push_back(std::async(
+                        std::launch::async, [j](){ return j; }
+                    ));
+                }
+
+                for (auto& f: futures)
+                    total += f.get();
+                futures.clear();
+            }
+            r.stop();
+
+            if (total != size * (task_count * (task_count - 1) / 2))
+                return r.fail("wrong sum of task results");
+
+            return true;
+        }
+
+        /**
+         * Splits a CPU bound loop into one chunk
+         * per CPU, this shows the parallel speedup.
+         */
+        bool parallel_sum(run& r, std::uint64_t size)
+        {
+            constexpr std::uint64_t chunk_work{1000000};
+
+            std::size_t chunks = std::thread::hardware_concurrency();
+            if (chunks == 0)
+                chunks = 1;
+
+            std::vector<std::future<std::uint64_t>> futures{};
+            futures.reserve(chunks);
+            std::uint64_t total{};
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                for (std::size_t j = 0; j < chunks; ++j)
+                {
+                    futures.push_back(std::async(
+                        std::launch::async, [chunks](){
+                            std::uint64_t x{88172645463325252ULL};
+                            std::uint64_t sum{};
+
+                            for (std::uint64_t k = 0; k < chunk_work / chunks; ++k)
+                            {
+                                x ^= x << 13;
+                                x ^= x >> 7;
+                                x ^= x << 17;
+                                sum += x & 0xFF;
+                            }
+
+                            return sum;
+                        }
+                    ));
+                }
+
+                for (auto& f: futures)
+                    total += f.get();
+                futures.clear();
+            }
+            r.stop();
+
+            if (total == 0)
+                return r.fail("nothing was summed");
+
+            return true;
+        }
+    }
+
+    benchmark async_short_tasks{
+        "async_short_tasks",
+        "std::async launch and get of 1000 trivial tasks",
+        &short_tasks
+    };
+
+    benchmark async_parallel_sum{
+        "async_parallel_sum",
+        "std::async CPU bound loop split into one task per CPU",
+        &parallel_sum
+    };
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../cppbench.hpp"
+
+namespace cppbench
+{
+    namespace
+    {
+        /**
+         * Number of increments done by each thread per
+         * round, the workload size is the number of rounds.
+         */
+        constexpr std::uint64_t increment_count{100000};
+
+        /**
+         * Threads are fibrils, so we need a runner
+         * per CPU for them to really contend.
+         */
+        std::size_t contender_count()
+        {
+            ::helenos::fibril_enable_multithreaded();
+
+            std::size_t count = std::thread::hardware_concurrency();
+
+            return count < 2 ? 2 : count;
+        }
+
+        /**
+         * Runs the given body in one thread per CPU, see
+         * contender_count().
+         */
+        template<class Body>
+        void contend(std::size_t count, Body body)
+        {
+            std::vector<std::thread> threads{};
+            threads.reserve(count);
+
+            for (std::size_t i = 0; i < count; ++i)
+                threads.emplace_back(body);
+
+            for (auto& thr: threads)
+                thr.join();
+        }
+
+        bool atomic_counter(run& r, std::uint64_t size)
+        {
+            auto count = contender_count();
+            std::atomic<std::uint64_t> counter{};
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                contend(count, [&counter](){
+                    for (std::uint64_t j = 0; j < increment_count; ++j)
+                        counter.fetch_add(1, std::memory_order_relaxed);
+                });
+            }
+            r.stop();
+
+            if (counter.load() != size * count * increment_count)
+                return r.fail("lost increments");
+
+            return true;
+        }
+
+        bool mutex_counter(run& r, std::uint64_t size)
+        {
+            auto count = contender_count();
+            std::mutex mtx{};
+            std::uint64_t counter{};
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                contend(count, [&mtx, &counter](){
+                    for (std::uint64_t j = 0; j < increment_count; ++j)
+                    {
+                        std::lock_guard<std::mutex> lock{mtx};
+                        ++counter;
+                    }
+                });
+            }
+            r.stop();
+
+            if (counter != size * count * increment_count)
+                return r.fail("lost increments");
+
+            return true;
+        }
+
+        /**
+         * Two threads take turns incrementing a counter,
+         * each one sleeping in wait() until the other
+         * one has made its move.
+         */
+        bool atomic_ping_pong(run& r, std::uint64_t size)
+        {
+            constexpr std::uint64_t turns{1000};
+            std::atomic<std::uint64_t> value{};
+            ::helenos::fibril_enable_multithreaded();
+
+            r.start();
+            for (std::uint64_t i = 0; i < size; ++i)
+            {
+                value.store(0);
+
+                std::thread other{[&value](){
+                    for (std::uint64_t j = 1; j < 2 * turns; j += 2)
+                    {
+                        value.wait(j - 1);
+                        value.store(j + 1);
+                        value.notify_one();
+                    }
+                }};
+
+                for (std::uint64_t j = 0; j < 2 * turns; j += 2)
+                {
+                    value.store(j + 1);
+                    value.notify_one();
+                    value.wait(j + 1);
+                }
+
+                other.join();
+            }
+            r.stop();
+
+            if (value.load() != 2 * turns)
+                return r.fail("wrong final value");
+
+            return true;
+        }
+    }
+
+    benchmark atomic_counter_contended{
+        "atomic_counter_contended",
+        "std::atomic fetch_add on a counter shared by one thread per CPU",
+        &atomic_counter
+    };
+
+    benchmark mutex_counter_contended{
+        "mutex_counter_contended",
+        "std::mutex protected counter shared by one thread per CPU",
+        &mutex_counter
+    };
+
+    benchmark atomic_wait_ping_pong{
+        "atomic_wait_ping_pong",
+        "std::atomic wait/notify_one hand-off between two threads",
+        &atomic_ping_pong
+    };
+}
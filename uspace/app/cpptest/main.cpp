@@ -47,6 +47,8 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <charconv>
 #include <chrono>
 #include <condition_variable>
 #include <deque>
@@ -79,6 +81,7 @@
 #include <typeindex>
 #include <typeinfo>
 #include <utility>
+#include <valarray>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -93,6 +96,7 @@
 #include <complex>
 #include <future>
 #include <shared_mutex>
+#include <regex>
 
 #include <__bits/adt/hash_table.hpp>
 #include <__bits/adt/rbtree.hpp>
@@ -121,6 +125,12 @@ int main()
     ts.add<std::test::functional_test>();
     ts.add<std::test::algorithm_test>();
     ts.add<std::test::future_test>();
+    ts.add<std::test::atomic_test>();
+    ts.add<std::test::regex_test>();
+    ts.add<std::test::fstream_test>();
+    ts.add<std::test::valarray_test>();
+    ts.add<std::test::charconv_test>();
+    ts.add<std::test::flat_hash_test>();
 
     return ts.run(true) ? 0 : 1;
 }
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <adt/hash_table.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <str.h>
+#include "../hbench.h"
+
+/*
+ * Measures the latency of individual hash table insertions. Every iteration
+ * inserts all entries into an empty table, which is therefore resized many
+ * times along the way, and each insertion is timed on its own. The whole
+ * run measures the throughput, while the distribution of the individual
+ * latencies is collected into a histogram with power-of-two buckets that
+ * is printed after the benchmark has finished. The maximum shows the cost
+ * of the worst insertion, i.e. the one that had to deal with a resize.
+ */
+
+#define MAX_ENTRIES 10000000
+
+/* Histogram bucket i counts insertions that took less than 2^i ns. */
+#define HIST_BUCKETS 40
+
+typedef struct {
+	ht_link_t link;
+	size_t key;
+} entry_t;
+
+static entry_t *entries;
+static size_t entry_count;
+
+static uint64_t histogram[HIST_BUCKETS];
+static nsec_t max_latency;
+
+static size_t entry_hash(const ht_link_t *item)
+{
+	return hash_table_get_inst(item, entry_t, link)->key;
+}
+
+static size_t entry_key_hash(const void *key)
+{
+	return *(const size_t *) key;
+}
+
+static bool entry_equal(const ht_link_t *item1, const ht_link_t *item2)
+{
+	return hash_table_get_inst(item1, entry_t, link)->key ==
+	    hash_table_get_inst(item2, entry_t, link)->key;
+}
+
+static bool entry_key_equal(const void *key, const ht_link_t *item)
+{
+	return *(const size_t *) key ==
+	    hash_table_get_inst(item, entry_t, link)->key;
+}
+
+static hash_table_ops_t entry_ops = {
+	.hash = entry_hash,
+	.key_hash = entry_key_hash,
+	.equal = entry_equal,
+	.key_equal = entry_key_equal,
+	.remove_callback = NULL
+};
+
+static bool setup(bench_env_t *env, bench_run_t *run)
+{
+	const char *param = bench_env_param_get(env, "count", "100000");
+
+	errno_t rc = str_size_t(param, NULL, 10, true, &entry_count);
+	if (rc != EOK || entry_count == 0 || entry_count > MAX_ENTRIES) {
+		return bench_run_fail(run, "invalid number of entries '%s' "
+		    "(expected 1 to %d)", param, MAX_ENTRIES);
+	}
+
+	entries = calloc(entry_count, sizeof(entry_t));
+	if (entries == NULL)
+		return bench_run_fail(run, "failed allocating entries");
+
+	for (size_t i = 0; i < entry_count; i++)
+		entries[i].key = i;
+
+	for (size_t i = 0; i < HIST_BUCKETS; i++)
+		histogram[i] = 0;
+	max_latency = 0;
+
+	return true;
+}
+
+static bool teardown(bench_env_t *env, bench_run_t *run)
+{
+	uint64_t total = 0;
+	for (size_t i = 0; i < HIST_BUCKETS; i++)
+		total += histogram[i];
+
+	if (total > 0) {
+		printf("Insertion latency histogram (%" PRIu64 " insertions):\n",
+		    total);
+
+		for (size_t i = 0; i < HIST_BUCKETS; i++) {
+			if (histogram[i] == 0)
+				continue;
+
+			printf("  < %12" PRIu64 " ns: %12" PRIu64 " (%3" PRIu64 "%%)\n",
+			    (uint64_t) 1 << i, histogram[i],
+			    histogram[i] * 100 / total);
+		}
+
+		printf("Maximum insertion latency: %lld ns\n",
+		    (long long) max_latency);
+	}
+
+	free(entries);
+	entries = NULL;
+	return true;
+}
+
+static void record_latency(nsec_t latency)
+{
+	size_t i = 0;
+	while (i < HIST_BUCKETS - 1 && ((nsec_t) 1 << i) <= latency)
+		i++;
+
+	histogram[i]++;
+	if (latency > max_latency)
+		max_latency = latency;
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	hash_table_t table;
+	stopwatch_t insert_watch;
+
+	bench_run_start(run);
+
+	for (uint64_t count = 0; count < niter; count++) {
+		if (!hash_table_create(&table, 0, 0, &entry_ops))
+			return bench_run_fail(run, "failed creating hash table");
+
+		for (size_t i = 0; i < entry_count; i++) {
+			stopwatch_start(&insert_watch);
+			hash_table_insert(&table, &entries[i].link);
+			stopwatch_stop(&insert_watch);
+
+			record_latency(stopwatch_get_nanos(&insert_watch));
+		}
+
+		/* Entries are not owned by the table, just forget them. */
+		hash_table_destroy(&table);
+	}
+
+	bench_run_stop(run);
+
+	return true;
+}
+
+benchmark_t benchmark_hash_table = {
+	.name = "hash_table",
+	.desc = "Hash table insertion latency (with histogram)",
+	.entry = &runner,
+	.setup = &setup,
+	.teardown = &teardown
+};
+
+/** @}
+ */
@@ -38,13 +38,24 @@
 #include "hbench.h"
 
 benchmark_t *benchmarks[] = {
+	&benchmark_as_area,
 	&benchmark_dir_read,
 	&benchmark_fibril_mutex,
 	&benchmark_file_read,
+	&benchmark_hash_table,
 	&benchmark_malloc1,
 	&benchmark_malloc2,
+	&benchmark_malloc_mt,
+	&benchmark_memchr,
+	&benchmark_memcmp,
+	&benchmark_memcpy,
+	&benchmark_memset,
 	&benchmark_ns_ping,
-	&benchmark_ping_pong
+	&benchmark_ping_pong,
+	&benchmark_ping_pong_many,
+	&benchmark_sort,
+	&benchmark_strlen,
+	&benchmark_timer_stress
 };
 
 size_t benchmark_count = sizeof(benchmarks) / sizeof(benchmarks[0]);
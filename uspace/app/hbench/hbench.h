@@ -127,17 +127,35 @@ extern errno_t bench_env_param_set(bench_env_t *, const char *, const char *);
 extern const char *bench_env_param_get(bench_env_t *, const char *, const char *);
 extern void bench_env_cleanup(bench_env_t *);
 
+/* Buffers and setup shared by the benchmarks in mem/ */
+extern char *bench_mem_src;
+extern char *bench_mem_dst;
+extern size_t bench_mem_size;
+extern bool bench_mem_setup(bench_env_t *, bench_run_t *);
+extern bool bench_mem_teardown(bench_env_t *, bench_run_t *);
+
 extern benchmark_t *benchmarks[];
 extern size_t benchmark_count;
 
 /* Put your benchmark descriptors here (and also to benchlist.c). */
+extern benchmark_t benchmark_as_area;
 extern benchmark_t benchmark_dir_read;
 extern benchmark_t benchmark_fibril_mutex;
 extern benchmark_t benchmark_file_read;
+extern benchmark_t benchmark_hash_table;
 extern benchmark_t benchmark_malloc1;
 extern benchmark_t benchmark_malloc2;
+extern benchmark_t benchmark_malloc_mt;
+extern benchmark_t benchmark_memchr;
+extern benchmark_t benchmark_memcmp;
+extern benchmark_t benchmark_memcpy;
+extern benchmark_t benchmark_memset;
 extern benchmark_t benchmark_ns_ping;
 extern benchmark_t benchmark_ping_pong;
+extern benchmark_t benchmark_ping_pong_many;
+extern benchmark_t benchmark_sort;
+extern benchmark_t benchmark_strlen;
+extern benchmark_t benchmark_timer_stress;
 
 #endif
 
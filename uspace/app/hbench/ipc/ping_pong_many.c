@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <ipc_test.h>
+#include <async.h>
+#include <errno.h>
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <str.h>
+#include <str_error.h>
+#include "../hbench.h"
+
+/*
+ * Variant of ping_pong where several client fibrils, each with a session
+ * of its own, ping the IPC test server at the same time. The iterations are
+ * split evenly among the clients. With more than one fibril runner, this
+ * shows how IPC handling scales with the number of CPUs.
+ */
+
+#define MAX_CLIENTS 64
+
+typedef struct {
+	ipc_test_t *test;
+	uint64_t niter;
+	errno_t rc;
+} client_t;
+
+static client_t clients[MAX_CLIENTS];
+static size_t client_count = 0;
+
+static FIBRIL_MUTEX_INITIALIZE(done_mutex);
+static FIBRIL_CONDVAR_INITIALIZE(done_cv);
+static size_t done_count;
+
+static bool teardown(bench_env_t *env, bench_run_t *run)
+{
+	for (size_t i = 0; i < client_count; i++)
+		ipc_test_destroy(clients[i].test);
+
+	client_count = 0;
+	return true;
+}
+
+static bool setup(bench_env_t *env, bench_run_t *run)
+{
+	const char *param = bench_env_param_get(env, "clients", "8");
+
+	size_t count;
+	errno_t rc = str_size_t(param, NULL, 10, true, &count);
+	if (rc != EOK || count == 0 || count > MAX_CLIENTS) {
+		return bench_run_fail(run, "invalid number of clients '%s' "
+		    "(expected 1 to %d)", param, MAX_CLIENTS);
+	}
+
+	for (client_count = 0; client_count < count; client_count++) {
+		rc = ipc_test_create(&clients[client_count].test);
+		if (rc != EOK) {
+			teardown(env, run);
+			return bench_run_fail(run,
+			    "failed contacting IPC test server (have you run /srv/test/ipc-test?): %s (%d)",
+			    str_error(rc), rc);
+		}
+	}
+
+	fibril_enable_multithreaded();
+
+	return true;
+}
+
+static errno_t client_fibril(void *arg)
+{
+	client_t *client = arg;
+
+	client->rc = EOK;
+	for (uint64_t count = 0; count < client->niter; count++) {
+		errno_t rc = ipc_test_ping(client->test);
+		if (rc != EOK) {
+			client->rc = rc;
+			break;
+		}
+	}
+
+	fibril_mutex_lock(&done_mutex);
+	done_count++;
+	fibril_condvar_broadcast(&done_cv);
+	fibril_mutex_unlock(&done_mutex);
+
+	return EOK;
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	fid_t fids[MAX_CLIENTS];
+
+	for (size_t i = 0; i < client_count; i++) {
+		clients[i].niter = niter / client_count;
+		if (i < niter % client_count)
+			clients[i].niter++;
+
+		fids[i] = fibril_create(client_fibril, &clients[i]);
+		if (fids[i] == 0) {
+			for (size_t j = 0; j < i; j++)
+				fibril_destroy(fids[j]);
+			return bench_run_fail(run, "failed creating client fibril");
+		}
+	}
+
+	done_count = 0;
+
+	bench_run_start(run);
+
+	for (size_t i = 0; i < client_count; i++)
+		fibril_add_ready(fids[i]);
+
+	fibril_mutex_lock(&done_mutex);
+	while (done_count < client_count)
+		fibril_condvar_wait(&done_cv, &done_mutex);
+	fibril_mutex_unlock(&done_mutex);
+
+	bench_run_stop(run);
+
+	for (size_t i = 0; i < client_count; i++) {
+		if (clients[i].rc != EOK) {
+			return bench_run_fail(run, "failed sending ping message: %s (%d)",
+			    str_error(clients[i].rc), clients[i].rc);
+		}
+	}
+
+	return true;
+}
+
+benchmark_t benchmark_ping_pong_many = {
+	.name = "ping_pong_many",
+	.desc = "IPC ping-pong benchmark with many concurrent clients",
+	.entry = &runner,
+	.setup = &setup,
+	.teardown = &teardown
+};
+
+/** @}
+ */
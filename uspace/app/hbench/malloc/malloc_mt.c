@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <errno.h>
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <stdlib.h>
+#include <str.h>
+#include "../hbench.h"
+
+/*
+ * Several worker fibrils, each kept on a fibril runner of its own,
+ * allocate and free blocks of mixed sizes at the same time. Every worker
+ * keeps a few blocks alive, so that the heap does not just hand the same
+ * block back and forth. The iterations are split evenly among the workers,
+ * so with a scalable allocator the time goes down with the number of
+ * workers, up to the number of CPUs.
+ */
+
+#define MAX_WORKERS 64
+
+/* Blocks kept alive by each worker. */
+#define LIVE_BLOCKS 64
+
+typedef struct {
+	uint64_t niter;
+	unsigned seed;
+	bool failed;
+} worker_t;
+
+static worker_t workers[MAX_WORKERS];
+static size_t worker_count;
+
+static FIBRIL_MUTEX_INITIALIZE(done_mutex);
+static FIBRIL_CONDVAR_INITIALIZE(done_cv);
+static size_t done_count;
+
+static bool setup(bench_env_t *env, bench_run_t *run)
+{
+	const char *param = bench_env_param_get(env, "workers", "4");
+
+	errno_t rc = str_size_t(param, NULL, 10, true, &worker_count);
+	if (rc != EOK || worker_count == 0 || worker_count > MAX_WORKERS) {
+		return bench_run_fail(run, "invalid number of workers '%s' "
+		    "(expected 1 to %d)", param, MAX_WORKERS);
+	}
+
+	fibril_enable_multithreaded();
+
+	return true;
+}
+
+/** Pick a block size, mostly small ones with some larger ones. */
+static size_t block_size(unsigned *seed)
+{
+	*seed = *seed * 1103515245 + 12345;
+	unsigned r = *seed >> 8;
+
+	switch (r % 8) {
+	case 0:
+		return 1 + (r >> 3) % 4096;
+	case 1:
+		return 1 + (r >> 3) % 512;
+	default:
+		return 1 + (r >> 3) % 128;
+	}
+}
+
+static errno_t worker_fibril(void *arg)
+{
+	worker_t *worker = arg;
+	void *blocks[LIVE_BLOCKS] = { NULL };
+
+	worker->failed = false;
+	for (uint64_t count = 0; count < worker->niter; count++) {
+		size_t slot = count % LIVE_BLOCKS;
+
+		free(blocks[slot]);
+		blocks[slot] = malloc(block_size(&worker->seed));
+		if (blocks[slot] == NULL) {
+			worker->failed = true;
+			break;
+		}
+	}
+
+	for (size_t i = 0; i < LIVE_BLOCKS; i++)
+		free(blocks[i]);
+
+	fibril_mutex_lock(&done_mutex);
+	done_count++;
+	fibril_condvar_broadcast(&done_cv);
+	fibril_mutex_unlock(&done_mutex);
+
+	return EOK;
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	fid_t fids[MAX_WORKERS];
+
+	for (size_t i = 0; i < worker_count; i++) {
+		workers[i].niter = niter / worker_count;
+		if (i < niter % worker_count)
+			workers[i].niter++;
+		workers[i].seed = i;
+
+		fids[i] = fibril_create(worker_fibril, &workers[i]);
+		if (fids[i] == 0) {
+			for (size_t j = 0; j < i; j++)
+				fibril_destroy(fids[j]);
+			return bench_run_fail(run, "failed creating worker fibril");
+		}
+
+		/* Spread the workers over the runners. */
+		fibril_set_affinity(fids[i], i);
+	}
+
+	done_count = 0;
+
+	bench_run_start(run);
+
+	for (size_t i = 0; i < worker_count; i++)
+		fibril_add_ready(fids[i]);
+
+	fibril_mutex_lock(&done_mutex);
+	while (done_count < worker_count)
+		fibril_condvar_wait(&done_cv, &done_mutex);
+	fibril_mutex_unlock(&done_mutex);
+
+	bench_run_stop(run);
+
+	for (size_t i = 0; i < worker_count; i++) {
+		if (workers[i].failed)
+			return bench_run_fail(run, "failed to allocate memory");
+	}
+
+	return true;
+}
+
+benchmark_t benchmark_malloc_mt = {
+	.name = "malloc_mt",
+	.desc = "User-space memory allocator benchmark, many threads allocating at once",
+	.entry = &runner,
+	.setup = &setup,
+	.teardown = NULL
+};
+
+/** @}
+ */
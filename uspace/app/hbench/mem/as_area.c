@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <as.h>
+#include <errno.h>
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <stdatomic.h>
+#include <str.h>
+#include <str_error.h>
+#include "../hbench.h"
+
+/*
+ * Map an address space area, touch all of its pages, shrink it to half its
+ * size and unmap it. Unmapping pages needs a TLB shootdown on every CPU
+ * that may have them cached. To have the task's address space active on
+ * other CPUs as well, spinner fibrils can be kept busy on fibril runners
+ * of their own while the benchmark runs.
+ */
+
+#define MAX_SPINNERS 64
+
+static size_t pages;
+static size_t spinner_count;
+
+/* Fibril runners are never destroyed, they are reused by later runs. */
+static size_t runner_count;
+
+static atomic_bool spinners_stop;
+
+static FIBRIL_MUTEX_INITIALIZE(done_mutex);
+static FIBRIL_CONDVAR_INITIALIZE(done_cv);
+static size_t done_count;
+
+static errno_t spinner_fibril(void *arg)
+{
+	while (!atomic_load(&spinners_stop))
+		fibril_yield();
+
+	fibril_mutex_lock(&done_mutex);
+	done_count++;
+	fibril_condvar_broadcast(&done_cv);
+	fibril_mutex_unlock(&done_mutex);
+
+	return EOK;
+}
+
+static bool teardown(bench_env_t *env, bench_run_t *run)
+{
+	atomic_store(&spinners_stop, true);
+
+	fibril_mutex_lock(&done_mutex);
+	while (done_count < spinner_count)
+		fibril_condvar_wait(&done_cv, &done_mutex);
+	fibril_mutex_unlock(&done_mutex);
+
+	spinner_count = 0;
+	return true;
+}
+
+static bool setup(bench_env_t *env, bench_run_t *run)
+{
+	const char *param = bench_env_param_get(env, "pages", "16");
+
+	errno_t rc = str_size_t(param, NULL, 10, true, &pages);
+	if (rc != EOK || pages < 2) {
+		return bench_run_fail(run, "invalid number of pages '%s' "
+		    "(expected at least 2)", param);
+	}
+
+	param = bench_env_param_get(env, "spinners", "0");
+
+	size_t count;
+	rc = str_size_t(param, NULL, 10, true, &count);
+	if (rc != EOK || count > MAX_SPINNERS) {
+		return bench_run_fail(run, "invalid number of spinners '%s' "
+		    "(expected 0 to %d)", param, MAX_SPINNERS);
+	}
+
+	atomic_store(&spinners_stop, false);
+	done_count = 0;
+	spinner_count = 0;
+
+	if (count == 0)
+		return true;
+
+	if (count > runner_count) {
+		int spawned = fibril_test_spawn_runners(count - runner_count);
+		runner_count += spawned;
+		if (runner_count < count)
+			return bench_run_fail(run, "failed spawning fibril runners");
+	}
+
+	for (spinner_count = 0; spinner_count < count; spinner_count++) {
+		fid_t fid = fibril_create(spinner_fibril, NULL);
+		if (fid == 0) {
+			teardown(env, run);
+			return bench_run_fail(run, "failed creating spinner fibril");
+		}
+
+		/* Keep each spinner on a runner of its own, not the main one. */
+		fibril_set_affinity(fid, 1 + spinner_count);
+		fibril_add_ready(fid);
+	}
+
+	return true;
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	size_t size = pages * PAGE_SIZE;
+
+	bench_run_start(run);
+
+	for (uint64_t count = 0; count < niter; count++) {
+		void *area = as_area_create(AS_AREA_ANY, size,
+		    AS_AREA_READ | AS_AREA_WRITE | AS_AREA_CACHEABLE,
+		    AS_AREA_UNPAGED);
+		if (area == AS_MAP_FAILED) {
+			return bench_run_fail(run, "failed creating address "
+			    "space area in run %" PRIu64, count);
+		}
+
+		for (size_t i = 0; i < pages; i++)
+			((volatile char *) area)[i * PAGE_SIZE] = 1;
+
+		errno_t rc = as_area_resize(area, size / 2, 0);
+		if (rc == EOK)
+			rc = as_area_destroy(area);
+		if (rc != EOK) {
+			return bench_run_fail(run, "failed unmapping address "
+			    "space area: %s (%d)", str_error(rc), rc);
+		}
+	}
+
+	bench_run_stop(run);
+
+	return true;
+}
+
+benchmark_t benchmark_as_area = {
+	.name = "as_area",
+	.desc = "Address space area map, shrink and unmap cycles",
+	.entry = &runner,
+	.setup = &setup,
+	.teardown = &teardown
+};
+
+/** @}
+ */
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <errno.h>
+#include <mem.h>
+#include <stdlib.h>
+#include <str.h>
+#include "../hbench.h"
+
+/*
+ * Buffers shared by the memory and string routine benchmarks. Their size
+ * is given by the "size" parameter, so that one benchmark can be run over
+ * the whole range from a few bytes (where the call overhead and the head
+ * and tail handling dominate) up to a megabyte (where the memory bandwidth
+ * does).
+ *
+ * The source buffer holds a string of size - 1 'a' characters. The
+ * destination buffer starts out as an exact copy of the source.
+ */
+
+#define MEM_SIZE_MIN 8
+#define MEM_SIZE_MAX (1024 * 1024)
+
+char *bench_mem_src;
+char *bench_mem_dst;
+size_t bench_mem_size;
+
+bool bench_mem_teardown(bench_env_t *env, bench_run_t *run)
+{
+	free(bench_mem_src);
+	free(bench_mem_dst);
+	bench_mem_src = NULL;
+	bench_mem_dst = NULL;
+	return true;
+}
+
+bool bench_mem_setup(bench_env_t *env, bench_run_t *run)
+{
+	const char *param = bench_env_param_get(env, "size", "4096");
+
+	errno_t rc = str_size_t(param, NULL, 10, true, &bench_mem_size);
+	if (rc != EOK || bench_mem_size < MEM_SIZE_MIN ||
+	    bench_mem_size > MEM_SIZE_MAX) {
+		return bench_run_fail(run, "invalid size '%s' "
+		    "(expected %d to %d)", param, MEM_SIZE_MIN, MEM_SIZE_MAX);
+	}
+
+	bench_mem_src = malloc(bench_mem_size);
+	bench_mem_dst = malloc(bench_mem_size);
+	if (bench_mem_src == NULL || bench_mem_dst == NULL) {
+		bench_mem_teardown(env, run);
+		return bench_run_fail(run, "failed to allocate %zu B buffers",
+		    bench_mem_size);
+	}
+
+	memset(bench_mem_src, 'a', bench_mem_size - 1);
+	bench_mem_src[bench_mem_size - 1] = '\0';
+	memcpy(bench_mem_dst, bench_mem_src, bench_mem_size);
+
+	return true;
+}
+
+/** @}
+ */
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <errno.h>
+#include <gsort.h>
+#include <mem.h>
+#include <qsort.h>
+#include <stdlib.h>
+#include <str.h>
+#include "../hbench.h"
+
+/*
+ * Sort an array of integers with qsort() or gsort() (the "func" parameter).
+ * The input (the "input" parameter) is either random, already sorted or
+ * sorted in reverse, which are the classic worst cases of a naive
+ * quicksort. Every iteration sorts a fresh copy of the input, so the
+ * time includes copying "count" integers.
+ */
+
+#define MAX_COUNT (16 * 1024 * 1024)
+
+static int *input;
+static int *work;
+static size_t count;
+static bool use_gsort;
+
+static int qsort_cmp(const void *a, const void *b)
+{
+	int ia = *(const int *) a;
+	int ib = *(const int *) b;
+
+	return (ia > ib) - (ia < ib);
+}
+
+static int gsort_cmp(void *a, void *b, void *arg)
+{
+	return qsort_cmp(a, b);
+}
+
+static bool teardown(bench_env_t *env, bench_run_t *run)
+{
+	free(input);
+	free(work);
+	input = NULL;
+	work = NULL;
+	return true;
+}
+
+static bool setup(bench_env_t *env, bench_run_t *run)
+{
+	const char *param = bench_env_param_get(env, "count", "100000");
+
+	errno_t rc = str_size_t(param, NULL, 10, true, &count);
+	if (rc != EOK || count == 0 || count > MAX_COUNT) {
+		return bench_run_fail(run, "invalid count '%s' "
+		    "(expected 1 to %d)", param, MAX_COUNT);
+	}
+
+	const char *func = bench_env_param_get(env, "func", "qsort");
+	if (str_cmp(func, "qsort") == 0) {
+		use_gsort = false;
+	} else if (str_cmp(func, "gsort") == 0) {
+		use_gsort = true;
+	} else {
+		return bench_run_fail(run, "invalid func '%s' "
+		    "(expected qsort or gsort)", func);
+	}
+
+	input = calloc(count, sizeof(int));
+	work = calloc(count, sizeof(int));
+	if (input == NULL || work == NULL) {
+		teardown(env, run);
+		return bench_run_fail(run, "failed to allocate %zu integers",
+		    count);
+	}
+
+	const char *order = bench_env_param_get(env, "input", "random");
+	if (str_cmp(order, "random") == 0) {
+		srand(count);
+		for (size_t i = 0; i < count; i++)
+			input[i] = rand();
+	} else if (str_cmp(order, "sorted") == 0) {
+		for (size_t i = 0; i < count; i++)
+			input[i] = i;
+	} else if (str_cmp(order, "reverse") == 0) {
+		for (size_t i = 0; i < count; i++)
+			input[i] = count - i;
+	} else {
+		teardown(env, run);
+		return bench_run_fail(run, "invalid input '%s' "
+		    "(expected random, sorted or reverse)", order);
+	}
+
+	return true;
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	bench_run_start(run);
+	for (uint64_t i = 0; i < niter; i++) {
+		memcpy(work, input, count * sizeof(int));
+		if (use_gsort)
+			gsort(work, count, sizeof(int), gsort_cmp, NULL);
+		else
+			qsort(work, count, sizeof(int), qsort_cmp);
+	}
+	bench_run_stop(run);
+
+	for (size_t i = 1; i < count; i++) {
+		if (work[i - 1] > work[i])
+			return bench_run_fail(run, "array not sorted");
+	}
+
+	return true;
+}
+
+benchmark_t benchmark_sort = {
+	.name = "sort",
+	.desc = "Sort random, sorted or reverse sorted integers with qsort or gsort",
+	.entry = &runner,
+	.setup = &setup,
+	.teardown = &teardown
+};
+
+/** @}
+ */
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <str.h>
+#include <str_error.h>
+#include "../hbench.h"
+
+/*
+ * Benchmark for arming and cancelling fibril timeouts while many other
+ * timeouts are pending, as in a server where every connection waits for
+ * its next call with a timeout.
+ *
+ * Idle fibrils wait on a condition variable with timeouts spread over
+ * one minute. The measured fibril then repeatedly waits with a timeout
+ * on another condition variable that a partner fibril signals, so every
+ * iteration arms one timeout and cancels it.
+ */
+
+#define MAX_TIMERS 100000
+
+/* Idle fibrils do not need much stack. */
+#define IDLE_STACK_SIZE 16384
+
+#define IDLE_TIMEOUT_MIN 1000000
+#define IDLE_TIMEOUT_SPREAD 59000000
+#define WAIT_TIMEOUT 10000000
+
+static FIBRIL_MUTEX_INITIALIZE(mutex);
+static FIBRIL_CONDVAR_INITIALIZE(idle_cv);
+static FIBRIL_CONDVAR_INITIALIZE(wait_cv);
+static FIBRIL_CONDVAR_INITIALIZE(exit_cv);
+
+static size_t idle_count;
+static bool stopping;
+static bool done;
+static bool partner_running;
+
+static errno_t idle_fibril(void *arg)
+{
+	usec_t timeout = IDLE_TIMEOUT_MIN +
+	    ((uintptr_t) arg * 7919) % IDLE_TIMEOUT_SPREAD;
+
+	fibril_mutex_lock(&mutex);
+	while (!stopping)
+		(void) fibril_condvar_wait_timeout(&idle_cv, &mutex, timeout);
+
+	idle_count--;
+	fibril_condvar_broadcast(&exit_cv);
+	fibril_mutex_unlock(&mutex);
+
+	return EOK;
+}
+
+static bool teardown(bench_env_t *env, bench_run_t *run)
+{
+	fibril_mutex_lock(&mutex);
+	stopping = true;
+	fibril_condvar_broadcast(&idle_cv);
+	while (idle_count > 0)
+		fibril_condvar_wait(&exit_cv, &mutex);
+	fibril_mutex_unlock(&mutex);
+
+	return true;
+}
+
+static bool setup(bench_env_t *env, bench_run_t *run)
+{
+	const char *param = bench_env_param_get(env, "timers", "1000");
+
+	size_t count;
+	errno_t rc = str_size_t(param, NULL, 10, true, &count);
+	if (rc != EOK || count > MAX_TIMERS) {
+		return bench_run_fail(run, "invalid number of timers '%s' "
+		    "(expected 0 to %d)", param, MAX_TIMERS);
+	}
+
+	stopping = false;
+	idle_count = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		fid_t fid = fibril_create_generic(idle_fibril, (void *) (uintptr_t) i,
+		    IDLE_STACK_SIZE);
+		if (fid == 0) {
+			teardown(env, run);
+			return bench_run_fail(run, "failed creating idle fibril");
+		}
+
+		fibril_mutex_lock(&mutex);
+		idle_count++;
+		fibril_mutex_unlock(&mutex);
+
+		fibril_add_ready(fid);
+	}
+
+	/* Let all idle fibrils arm their timeouts. */
+	fibril_yield();
+
+	return true;
+}
+
+static errno_t partner_fibril(void *arg)
+{
+	fibril_mutex_lock(&mutex);
+	while (!done) {
+		fibril_condvar_signal(&wait_cv);
+		fibril_mutex_unlock(&mutex);
+		fibril_yield();
+		fibril_mutex_lock(&mutex);
+	}
+
+	partner_running = false;
+	fibril_condvar_broadcast(&exit_cv);
+	fibril_mutex_unlock(&mutex);
+
+	return EOK;
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	fid_t partner = fibril_create(partner_fibril, NULL);
+	if (partner == 0)
+		return bench_run_fail(run, "failed creating partner fibril");
+
+	done = false;
+	partner_running = true;
+	fibril_add_ready(partner);
+
+	errno_t rc = EOK;
+
+	bench_run_start(run);
+	fibril_mutex_lock(&mutex);
+	for (uint64_t i = 0; i < niter; i++) {
+		rc = fibril_condvar_wait_timeout(&wait_cv, &mutex,
+		    WAIT_TIMEOUT);
+		if (rc != EOK)
+			break;
+	}
+	fibril_mutex_unlock(&mutex);
+	bench_run_stop(run);
+
+	fibril_mutex_lock(&mutex);
+	done = true;
+	while (partner_running)
+		fibril_condvar_wait(&exit_cv, &mutex);
+	fibril_mutex_unlock(&mutex);
+
+	if (rc != EOK)
+		return bench_run_fail(run, "wait failed: %s", str_error(rc));
+
+	return true;
+}
+
+benchmark_t benchmark_timer_stress = {
+	.name = "timer_stress",
+	.desc = "Arming and cancelling fibril timeouts with many pending",
+	.entry = &runner,
+	.setup = &setup,
+	.teardown = &teardown
+};
+
+/** @}
+ */
@@ -59,6 +59,7 @@ typedef enum {
 	LIST_THREADS,
 	LIST_IPCCS,
 	LIST_CPUS,
+	LIST_SLABS,
 	PRINT_LOAD,
 	PRINT_UPTIME,
 	PRINT_ARCH
@@ -172,20 +173,31 @@ static void list_cpus(void)
 		return;
 	}
 
-	printf("[id] [MHz     ] [busy cycles] [idle cycles]\n");
+	printf("[id] [MHz     ] [busy cycles] [idle cycles] [dispatched]"
+	    " [stolen] [avg wait] [max wait]\n");
 
 	for (size_t i = 0; i < count; i++) {
 		printf("%-4u ", cpus[i].id);
 		if (cpus[i].active) {
-			uint64_t bcycles, icycles;
-			char bsuffix, isuffix;
+			uint64_t bcycles, icycles, dcount, scount, await, mwait;
+			char bsuffix, isuffix, dsuffix, ssuffix, asuffix, msuffix;
+
+			uint64_t avg = (cpus[i].dispatched > 0) ?
+			    cpus[i].wait_cycles / cpus[i].dispatched : 0;
 
 			order_suffix(cpus[i].busy_cycles, &bcycles, &bsuffix);
 			order_suffix(cpus[i].idle_cycles, &icycles, &isuffix);
-
-			printf("%10" PRIu16 " %12" PRIu64 "%c %12" PRIu64 "%c\n",
+			order_suffix(cpus[i].dispatched, &dcount, &dsuffix);
+			order_suffix(cpus[i].stolen, &scount, &ssuffix);
+			order_suffix(avg, &await, &asuffix);
+			order_suffix(cpus[i].wait_max, &mwait, &msuffix);
+
+			printf("%10" PRIu16 " %12" PRIu64 "%c %12" PRIu64 "%c"
+			    " %11" PRIu64 "%c %7" PRIu64 "%c %9" PRIu64 "%c"
+			    " %9" PRIu64 "%c\n",
 			    cpus[i].frequency_mhz, bcycles, bsuffix,
-			    icycles, isuffix);
+			    icycles, isuffix, dcount, dsuffix, scount, ssuffix,
+			    await, asuffix, mwait, msuffix);
 		} else
 			printf("inactive\n");
 	}
@@ -193,6 +205,47 @@ static void list_cpus(void)
 	free(cpus);
 }
 
+static void list_slabs(void)
+{
+	size_t count;
+	stats_slab_t *slabs = stats_get_slabs(&count);
+
+	if (slabs == NULL) {
+		fprintf(stderr, "%s: Unable to get slab statistics\n", NAME);
+		return;
+	}
+
+	printf("[cache name      ] [size  ] [slabs ] [alloc ] [cached]"
+	    " [mag] [exchanges] [contended] [%%]\n");
+
+	for (size_t i = 0; i < count; i++) {
+		printf("%-18s %8zu %8zu %8zu %8zu", slabs[i].name,
+		    slabs[i].size, slabs[i].slabs, slabs[i].allocated_objs,
+		    slabs[i].cached_objs);
+
+		if (slabs[i].magazine_size == 0) {
+			printf(" %5s %11s %11s\n", "-", "-", "-");
+			continue;
+		}
+
+		uint64_t exchanges, contention;
+		char esuffix, csuffix;
+
+		order_suffix(slabs[i].exchanges, &exchanges, &esuffix);
+		order_suffix(slabs[i].contention, &contention, &csuffix);
+
+		unsigned int percent = (slabs[i].exchanges > 0) ?
+		    (unsigned int) (slabs[i].contention * 100 /
+		    slabs[i].exchanges) : 0;
+
+		printf(" %5zu %10" PRIu64 "%c %10" PRIu64 "%c %3u\n",
+		    slabs[i].magazine_size, exchanges, esuffix,
+		    contention, csuffix, percent);
+	}
+
+	free(slabs);
+}
+
 static void print_load(void)
 {
 	size_t count;
@@ -367,7 +420,8 @@ static void print_arch(void)
 static void usage(const char *name)
 {
 	printf(
-	    "Usage: %s [-t task_id] [-i task_id] [-at] [-ai] [-c] [-l] [-u] [-d]\n"
+	    "Usage: %s [-t task_id] [-i task_id] [-at] [-ai] [-c] [-s] [-l] [-u]"
+	    " [-d]\n"
 	    "\n"
 	    "Options:\n"
 	    "\t-t task_id | --task=task_id\n"
@@ -385,6 +439,9 @@ static void usage(const char *name)
 	    "\t-c | --cpus\n"
 	    "\t\tList CPUs\n"
 	    "\n"
+	    "\t-s | --slabs\n"
+	    "\t\tList kernel slab caches\n"
+	    "\n"
 	    "\t-l | --load\n"
 	    "\t\tPrint system load\n"
 	    "\n"
@@ -468,6 +525,12 @@ int main(int argc, char *argv[])
 			continue;
 		}
 
+		/* Slab caches */
+		if ((off = arg_parse_short_long(argv[i], "-s", "--slabs")) != -1) {
+			output_toggle = LIST_SLABS;
+			continue;
+		}
+
 		/* Load */
 		if ((off = arg_parse_short_long(argv[i], "-l", "--load")) != -1) {
 			output_toggle = PRINT_LOAD;
@@ -500,6 +563,9 @@ int main(int argc, char *argv[])
 	case LIST_CPUS:
 		list_cpus();
 		break;
+	case LIST_SLABS:
+		list_slabs();
+		break;
 	case PRINT_LOAD:
 		print_load();
 		break;
@@ -0,0 +1,602 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup libc
+ * @{
+ */
+/** @file Memory and string routines using SSE2 and AVX2.
+ *
+ * SSE2 is part of the amd64 baseline, so the SSE2 routines are always
+ * used. The AVX2 routines are only selected if the CPU supports AVX2 and
+ * the kernel has enabled the extended register state (which it must do
+ * for the upper halves of the YMM registers to be preserved across context
+ * switches).
+ *
+ * The search routines read whole aligned vectors, possibly past the end of
+ * the string or memory area. Aligned vectors never straddle a page boundary,
+ * so this cannot fault.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "../../../generic/private/cc.h"
+#include "../../../generic/private/mem.h"
+
+typedef char v16qi_t __attribute__((vector_size(16), may_alias));
+typedef char v16qi_u_t __attribute__((vector_size(16), may_alias, aligned(1)));
+typedef char v32qi_t __attribute__((vector_size(32), may_alias));
+typedef char v32qi_u_t __attribute__((vector_size(32), may_alias, aligned(1)));
+
+typedef struct {
+	uint16_t v;
+} __attribute__((packed, may_alias)) u16_u_t;
+
+typedef struct {
+	uint32_t v;
+} __attribute__((packed, may_alias)) u32_u_t;
+
+typedef struct {
+	uint64_t v;
+} __attribute__((packed, may_alias)) u64_u_t;
+
+/** Bit mask of the most significant bits of the bytes of a vector */
+#define MASK16(v)  ((unsigned) __builtin_ia32_pmovmskb128((v16qi_t) (v)))
+#define MASK32(v)  ((unsigned) __builtin_ia32_pmovmskb256((v32qi_t) (v)))
+
+#define CPUID_AVX       (1 << 28)
+#define CPUID_OSXSAVE   (1 << 27)
+#define CPUID_AVX2      (1 << 5)
+
+#define XCR0_SSE        (1 << 1)
+#define XCR0_AVX        (1 << 2)
+
+static void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4])
+{
+	asm volatile (
+	    "cpuid\n"
+	    : "=a" (regs[0]), "=b" (regs[1]), "=c" (regs[2]), "=d" (regs[3])
+	    : "a" (leaf), "c" (subleaf)
+	);
+}
+
+static bool cpu_has_avx2(void)
+{
+	uint32_t regs[4];
+	uint32_t xcr0_lo;
+	uint32_t xcr0_hi;
+
+	cpuid(0, 0, regs);
+	if (regs[0] < 7)
+		return false;
+
+	cpuid(1, 0, regs);
+	if ((regs[2] & (CPUID_OSXSAVE | CPUID_AVX)) !=
+	    (CPUID_OSXSAVE | CPUID_AVX))
+		return false;
+
+	asm volatile (
+	    "xgetbv\n"
+	    : "=a" (xcr0_lo), "=d" (xcr0_hi)
+	    : "c" (0)
+	);
+	if ((xcr0_lo & (XCR0_SSE | XCR0_AVX)) != (XCR0_SSE | XCR0_AVX))
+		return false;
+
+	cpuid(7, 0, regs);
+	return (regs[1] & CPUID_AVX2) != 0;
+}
+
+/** Copy at most 16 bytes using possibly overlapping scalar moves. */
+static inline void copy_small(char *d, const char *s, size_t n)
+{
+	if (n >= 8) {
+		uint64_t head = ((const u64_u_t *) s)->v;
+		uint64_t tail = ((const u64_u_t *) (s + n - 8))->v;
+		((u64_u_t *) d)->v = head;
+		((u64_u_t *) (d + n - 8))->v = tail;
+	} else if (n >= 4) {
+		uint32_t head = ((const u32_u_t *) s)->v;
+		uint32_t tail = ((const u32_u_t *) (s + n - 4))->v;
+		((u32_u_t *) d)->v = head;
+		((u32_u_t *) (d + n - 4))->v = tail;
+	} else if (n >= 2) {
+		uint16_t head = ((const u16_u_t *) s)->v;
+		uint16_t tail = ((const u16_u_t *) (s + n - 2))->v;
+		((u16_u_t *) d)->v = head;
+		((u16_u_t *) (d + n - 2))->v = tail;
+	} else if (n == 1) {
+		*d = *s;
+	}
+}
+
+/** Fill at most 16 bytes using possibly overlapping scalar moves. */
+static inline void fill_small(char *d, uint8_t b, size_t n)
+{
+	uint64_t pattern = 0x0101010101010101ULL * b;
+
+	if (n >= 8) {
+		((u64_u_t *) d)->v = pattern;
+		((u64_u_t *) (d + n - 8))->v = pattern;
+	} else if (n >= 4) {
+		((u32_u_t *) d)->v = pattern;
+		((u32_u_t *) (d + n - 4))->v = pattern;
+	} else if (n >= 2) {
+		((u16_u_t *) d)->v = pattern;
+		((u16_u_t *) (d + n - 2))->v = pattern;
+	} else if (n == 1) {
+		*d = b;
+	}
+}
+
+/*
+ * The copy and fill routines deal with short blocks using overlapping
+ * moves of the head and the tail. Longer blocks are done with unaligned
+ * loads and aligned stores, the last (unaligned) vector again overlapping
+ * with what has been stored before.
+ */
+
+ATTRIBUTE_OPTIMIZE_NO_TLDP
+static void *memcpy_sse2(void *dst, const void *src, size_t n)
+{
+	char *d = dst;
+	const char *s = src;
+
+	if (n <= 16) {
+		copy_small(d, s, n);
+		return dst;
+	}
+
+	v16qi_u_t head = *(const v16qi_u_t *) s;
+	v16qi_u_t tail = *(const v16qi_u_t *) (s + n - 16);
+
+	if (n <= 32) {
+		*(v16qi_u_t *) d = head;
+		*(v16qi_u_t *) (d + n - 16) = tail;
+		return dst;
+	}
+
+	*(v16qi_u_t *) d = head;
+	size_t skip = 16 - ((uintptr_t) d & 15);
+	d += skip;
+	s += skip;
+	n -= skip;
+
+	while (n > 64) {
+		v16qi_u_t v0 = ((const v16qi_u_t *) s)[0];
+		v16qi_u_t v1 = ((const v16qi_u_t *) s)[1];
+		v16qi_u_t v2 = ((const v16qi_u_t *) s)[2];
+		v16qi_u_t v3 = ((const v16qi_u_t *) s)[3];
+		((v16qi_t *) d)[0] = v0;
+		((v16qi_t *) d)[1] = v1;
+		((v16qi_t *) d)[2] = v2;
+		((v16qi_t *) d)[3] = v3;
+		d += 64;
+		s += 64;
+		n -= 64;
+	}
+
+	while (n > 16) {
+		*(v16qi_t *) d = *(const v16qi_u_t *) s;
+		d += 16;
+		s += 16;
+		n -= 16;
+	}
+
+	*(v16qi_u_t *) (d + n - 16) = tail;
+	return dst;
+}
+
+ATTRIBUTE_OPTIMIZE_NO_TLDP
+__attribute__((target("avx2")))
+static void *memcpy_avx2(void *dst, const void *src, size_t n)
+{
+	char *d = dst;
+	const char *s = src;
+
+	if (n <= 32)
+		return memcpy_sse2(dst, src, n);
+
+	v32qi_u_t head = *(const v32qi_u_t *) s;
+	v32qi_u_t tail = *(const v32qi_u_t *) (s + n - 32);
+
+	if (n <= 64) {
+		*(v32qi_u_t *) d = head;
+		*(v32qi_u_t *) (d + n - 32) = tail;
+		return dst;
+	}
+
+	*(v32qi_u_t *) d = head;
+	size_t skip = 32 - ((uintptr_t) d & 31);
+	d += skip;
+	s += skip;
+	n -= skip;
+
+	while (n > 128) {
+		v32qi_u_t v0 = ((const v32qi_u_t *) s)[0];
+		v32qi_u_t v1 = ((const v32qi_u_t *) s)[1];
+		v32qi_u_t v2 = ((const v32qi_u_t *) s)[2];
+		v32qi_u_t v3 = ((const v32qi_u_t *) s)[3];
+		((v32qi_t *) d)[0] = v0;
+		((v32qi_t *) d)[1] = v1;
+		((v32qi_t *) d)[2] = v2;
+		((v32qi_t *) d)[3] = v3;
+		d += 128;
+		s += 128;
+		n -= 128;
+	}
+
+	while (n > 32) {
+		*(v32qi_t *) d = *(const v32qi_u_t *) s;
+		d += 32;
+		s += 32;
+		n -= 32;
+	}
+
+	*(v32qi_u_t *) (d + n - 32) = tail;
+	return dst;
+}
+
+ATTRIBUTE_OPTIMIZE_NO_TLDP
+static void *memset_sse2(void *dst, int c, size_t n)
+{
+	char *d = dst;
+
+	if (n <= 16) {
+		fill_small(d, (uint8_t) c, n);
+		return dst;
+	}
+
+	v16qi_t v = (v16qi_t) { } + (char) c;
+
+	*(v16qi_u_t *) d = v;
+	*(v16qi_u_t *) (d + n - 16) = v;
+	if (n <= 32)
+		return dst;
+
+	char *end = d + n - 16;
+	d = (char *) (((uintptr_t) d + 16) & ~(uintptr_t) 15);
+
+	while (d + 64 <= end) {
+		((v16qi_t *) d)[0] = v;
+		((v16qi_t *) d)[1] = v;
+		((v16qi_t *) d)[2] = v;
+		((v16qi_t *) d)[3] = v;
+		d += 64;
+	}
+
+	while (d < end) {
+		*(v16qi_t *) d = v;
+		d += 16;
+	}
+
+	return dst;
+}
+
+ATTRIBUTE_OPTIMIZE_NO_TLDP
+__attribute__((target("avx2")))
+static void *memset_avx2(void *dst, int c, size_t n)
+{
+	char *d = dst;
+
+	if (n <= 32)
+		return memset_sse2(dst, c, n);
+
+	v32qi_t v = (v32qi_t) { } + (char) c;
+
+	*(v32qi_u_t *) d = v;
+	*(v32qi_u_t *) (d + n - 32) = v;
+	if (n <= 64)
+		return dst;
+
+	char *end = d + n - 32;
+	d = (char *) (((uintptr_t) d + 32) & ~(uintptr_t) 31);
+
+	while (d + 128 <= end) {
+		((v32qi_t *) d)[0] = v;
+		((v32qi_t *) d)[1] = v;
+		((v32qi_t *) d)[2] = v;
+		((v32qi_t *) d)[3] = v;
+		d += 128;
+	}
+
+	while (d < end) {
+		*(v32qi_t *) d = v;
+		d += 32;
+	}
+
+	return dst;
+}
+
+static int memcmp_sse2(const void *s1, const void *s2, size_t n)
+{
+	const uint8_t *a = s1;
+	const uint8_t *b = s2;
+	unsigned mask;
+	size_t i;
+
+	if (n < 8) {
+		for (i = 0; i < n; i++) {
+			if (a[i] != b[i])
+				return (int) a[i] - (int) b[i];
+		}
+
+		return 0;
+	}
+
+	if (n < 16) {
+		uint64_t x = ((const u64_u_t *) a)->v;
+		uint64_t y = ((const u64_u_t *) b)->v;
+		i = 0;
+		if (x == y) {
+			i = n - 8;
+			x = ((const u64_u_t *) (a + i))->v;
+			y = ((const u64_u_t *) (b + i))->v;
+			if (x == y)
+				return 0;
+		}
+
+		i += __builtin_ctzll(x ^ y) / 8;
+		return (int) a[i] - (int) b[i];
+	}
+
+	for (i = 0; i + 16 <= n; i += 16) {
+		mask = MASK16(*(const v16qi_u_t *) (a + i) ==
+		    *(const v16qi_u_t *) (b + i)) ^ 0xffff;
+		if (mask != 0)
+			goto found;
+	}
+
+	if (i == n)
+		return 0;
+
+	/* The last block overlaps with what has been compared already. */
+	i = n - 16;
+	mask = MASK16(*(const v16qi_u_t *) (a + i) ==
+	    *(const v16qi_u_t *) (b + i)) ^ 0xffff;
+	if (mask == 0)
+		return 0;
+
+found:
+	i += __builtin_ctz(mask);
+	return (int) a[i] - (int) b[i];
+}
+
+static void *memchr_sse2(const void *s, int c, size_t n)
+{
+	if (n == 0)
+		return NULL;
+
+	v16qi_t needle = (v16qi_t) { } + (char) c;
+	size_t off = (uintptr_t) s & 15;
+	const char *p = (const char *) s - off;
+	unsigned mask;
+
+	/* Ignore matches before the start of the area. */
+	mask = MASK16(*(const v16qi_t *) p == needle) >> off;
+	if (mask != 0) {
+		size_t i = __builtin_ctz(mask);
+		return i < n ? (char *) s + i : NULL;
+	}
+
+	if (n <= 16 - off)
+		return NULL;
+
+	/* n is now the number of bytes left starting at p. */
+	n -= 16 - off;
+	p += 16;
+
+	while (n > 64) {
+		const v16qi_t *v = (const v16qi_t *) p;
+		if (MASK16((v[0] == needle) | (v[1] == needle) |
+		    (v[2] == needle) | (v[3] == needle)) != 0)
+			break;
+
+		p += 64;
+		n -= 64;
+	}
+
+	while (true) {
+		mask = MASK16(*(const v16qi_t *) p == needle);
+		if (mask != 0) {
+			size_t i = __builtin_ctz(mask);
+			return i < n ? (char *) p + i : NULL;
+		}
+
+		if (n <= 16)
+			return NULL;
+
+		p += 16;
+		n -= 16;
+	}
+}
+
+__attribute__((target("avx2")))
+static void *memchr_avx2(const void *s, int c, size_t n)
+{
+	if (n == 0)
+		return NULL;
+
+	v32qi_t needle = (v32qi_t) { } + (char) c;
+	size_t off = (uintptr_t) s & 31;
+	const char *p = (const char *) s - off;
+	unsigned mask;
+
+	mask = MASK32(*(const v32qi_t *) p == needle) >> off;
+	if (mask != 0) {
+		size_t i = __builtin_ctz(mask);
+		return i < n ? (char *) s + i : NULL;
+	}
+
+	if (n <= 32 - off)
+		return NULL;
+
+	n -= 32 - off;
+	p += 32;
+
+	while (n > 128) {
+		const v32qi_t *v = (const v32qi_t *) p;
+		if (MASK32((v[0] == needle) | (v[1] == needle) |
+		    (v[2] == needle) | (v[3] == needle)) != 0)
+			break;
+
+		p += 128;
+		n -= 128;
+	}
+
+	while (true) {
+		mask = MASK32(*(const v32qi_t *) p == needle);
+		if (mask != 0) {
+			size_t i = __builtin_ctz(mask);
+			return i < n ? (char *) p + i : NULL;
+		}
+
+		if (n <= 32)
+			return NULL;
+
+		p += 32;
+		n -= 32;
+	}
+}
+
+static size_t strlen_sse2(const char *s)
+{
+	v16qi_t zero = { };
+	size_t off = (uintptr_t) s & 15;
+	const char *p = s - off;
+	unsigned mask;
+
+	mask = MASK16(*(const v16qi_t *) p == zero) >> off;
+	if (mask != 0)
+		return __builtin_ctz(mask);
+
+	/*
+	 * Step to a 64-byte boundary, so that the unrolled loop below does
+	 * not read across a page boundary either.
+	 */
+	p += 16;
+	while (((uintptr_t) p & 63) != 0) {
+		mask = MASK16(*(const v16qi_t *) p == zero);
+		if (mask != 0)
+			return p - s + __builtin_ctz(mask);
+		p += 16;
+	}
+
+	while (true) {
+		const v16qi_t *v = (const v16qi_t *) p;
+		if (MASK16((v[0] == zero) | (v[1] == zero) |
+		    (v[2] == zero) | (v[3] == zero)) != 0)
+			break;
+		p += 64;
+	}
+
+	while (true) {
+		mask = MASK16(*(const v16qi_t *) p == zero);
+		if (mask != 0)
+			return p - s + __builtin_ctz(mask);
+		p += 16;
+	}
+}
+
+__attribute__((target("avx2")))
+static size_t strlen_avx2(const char *s)
+{
+	v32qi_t zero = { };
+	size_t off = (uintptr_t) s & 31;
+	const char *p = s - off;
+	unsigned mask;
+
+	mask = MASK32(*(const v32qi_t *) p == zero) >> off;
+	if (mask != 0)
+		return __builtin_ctz(mask);
+
+	p += 32;
+	while (((uintptr_t) p & 127) != 0) {
+		mask = MASK32(*(const v32qi_t *) p == zero);
+		if (mask != 0)
+			return p - s + __builtin_ctz(mask);
+		p += 32;
+	}
+
+	while (true) {
+		const v32qi_t *v = (const v32qi_t *) p;
+		if (MASK32((v[0] == zero) | (v[1] == zero) |
+		    (v[2] == zero) | (v[3] == zero)) != 0)
+			break;
+		p += 128;
+	}
+
+	while (true) {
+		mask = MASK32(*(const v32qi_t *) p == zero);
+		if (mask != 0)
+			return p - s + __builtin_ctz(mask);
+		p += 32;
+	}
+}
+
+static char *strchr_sse2(const char *s, int c)
+{
+	v16qi_t zero = { };
+	v16qi_t needle = (v16qi_t) { } + (char) c;
+	size_t off = (uintptr_t) s & 15;
+	const char *p = s - off;
+	v16qi_t v = *(const v16qi_t *) p;
+	unsigned mask;
+
+	mask = MASK16((v == zero) | (v == needle)) >> off;
+	p = s;
+
+	while (mask == 0) {
+		p = (const char *) ((uintptr_t) p & ~(uintptr_t) 15) + 16;
+		v = *(const v16qi_t *) p;
+		mask = MASK16((v == zero) | (v == needle));
+	}
+
+	p += __builtin_ctz(mask);
+	return *p == (char) c ? (char *) p : NULL;
+}
+
+void __mem_arch_init(mem_ops_t *ops)
+{
+	ops->memcpy = memcpy_sse2;
+	ops->memset = memset_sse2;
+	ops->memcmp = memcmp_sse2;
+	ops->memchr = memchr_sse2;
+	ops->strlen = strlen_sse2;
+	ops->strchr = strchr_sse2;
+
+	if (cpu_has_avx2()) {
+		ops->memcpy = memcpy_avx2;
+		ops->memset = memset_avx2;
+		ops->memchr = memchr_avx2;
+		ops->strlen = strlen_avx2;
+	}
+}
+
+/** @}
+ */
@@ -39,6 +39,9 @@
 #define PAGE_WIDTH  12
 #define PAGE_SIZE   (1 << PAGE_WIDTH)
 
+/* Vectorized memory and string routines in src/mem.c */
+#define LIBARCH_MEM_OPS
+
 #endif
 
 /** @}
@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup libc
+ * @{
+ */
+/** @file Memory and string routines using Advanced SIMD (NEON).
+ *
+ * Advanced SIMD is mandatory on AArch64, so there is nothing to detect and
+ * these routines are always used.
+ *
+ * The search routines read whole aligned vectors, possibly past the end of
+ * the string or memory area. Aligned vectors never straddle a page boundary,
+ * so this cannot fault.
+ */
+
+#include <arm_neon.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "../../../generic/private/cc.h"
+#include "../../../generic/private/mem.h"
+
+typedef struct {
+	uint16_t v;
+} __attribute__((packed, may_alias)) u16_u_t;
+
+typedef struct {
+	uint32_t v;
+} __attribute__((packed, may_alias)) u32_u_t;
+
+typedef struct {
+	uint64_t v;
+} __attribute__((packed, may_alias)) u64_u_t;
+
+/** Turn a byte comparison result into a mask with four bits per byte.
+ *
+ * AArch64 has no byte mask extraction instruction like x86 pmovmskb, so
+ * each 16-bit lane is shifted right by four and narrowed, which keeps
+ * a nibble of every byte.
+ */
+static inline uint64_t nibble_mask(uint8x16_t eq)
+{
+	uint8x8_t narrow = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+	return vget_lane_u64(vreinterpret_u64_u8(narrow), 0);
+}
+
+/** Index of the first byte flagged in a nibble mask. */
+static inline size_t nibble_index(uint64_t mask)
+{
+	return __builtin_ctzll(mask) / 4;
+}
+
+/** Copy at most 16 bytes using possibly overlapping scalar moves. */
+static inline void copy_small(uint8_t *d, const uint8_t *s, size_t n)
+{
+	if (n >= 8) {
+		uint64_t head = ((const u64_u_t *) s)->v;
+		uint64_t tail = ((const u64_u_t *) (s + n - 8))->v;
+		((u64_u_t *) d)->v = head;
+		((u64_u_t *) (d + n - 8))->v = tail;
+	} else if (n >= 4) {
+		uint32_t head = ((const u32_u_t *) s)->v;
+		uint32_t tail = ((const u32_u_t *) (s + n - 4))->v;
+		((u32_u_t *) d)->v = head;
+		((u32_u_t *) (d + n - 4))->v = tail;
+	} else if (n >= 2) {
+		uint16_t head = ((const u16_u_t *) s)->v;
+		uint16_t tail = ((const u16_u_t *) (s + n - 2))->v;
+		((u16_u_t *) d)->v = head;
+		((u16_u_t *) (d + n - 2))->v = tail;
+	} else if (n == 1) {
+		*d = *s;
+	}
+}
+
+/** Fill at most 16 bytes using possibly overlapping scalar moves. */
+static inline void fill_small(uint8_t *d, uint8_t b, size_t n)
+{
+	uint64_t pattern = 0x0101010101010101ULL * b;
+
+	if (n >= 8) {
+		((u64_u_t *) d)->v = pattern;
+		((u64_u_t *) (d + n - 8))->v = pattern;
+	} else if (n >= 4) {
+		((u32_u_t *) d)->v = pattern;
+		((u32_u_t *) (d + n - 4))->v = pattern;
+	} else if (n >= 2) {
+		((u16_u_t *) d)->v = pattern;
+		((u16_u_t *) (d + n - 2))->v = pattern;
+	} else if (n == 1) {
+		*d = b;
+	}
+}
+
+/*
+ * The copy and fill routines deal with short blocks using overlapping
+ * moves of the head and the tail. Longer blocks are done with aligned
+ * stores, the last (unaligned) vector again overlapping with what has
+ * been stored before.
+ */
+
+ATTRIBUTE_OPTIMIZE_NO_TLDP
+static void *memcpy_neon(void *dst, const void *src, size_t n)
+{
+	uint8_t *d = dst;
+	const uint8_t *s = src;
+
+	if (n <= 16) {
+		copy_small(d, s, n);
+		return dst;
+	}
+
+	uint8x16_t head = vld1q_u8(s);
+	uint8x16_t tail = vld1q_u8(s + n - 16);
+
+	if (n <= 32) {
+		vst1q_u8(d, head);
+		vst1q_u8(d + n - 16, tail);
+		return dst;
+	}
+
+	vst1q_u8(d, head);
+	size_t skip = 16 - ((uintptr_t) d & 15);
+	d += skip;
+	s += skip;
+	n -= skip;
+
+	while (n > 64) {
+		uint8x16_t v0 = vld1q_u8(s);
+		uint8x16_t v1 = vld1q_u8(s + 16);
+		uint8x16_t v2 = vld1q_u8(s + 32);
+		uint8x16_t v3 = vld1q_u8(s + 48);
+		vst1q_u8(d, v0);
+		vst1q_u8(d + 16, v1);
+		vst1q_u8(d + 32, v2);
+		vst1q_u8(d + 48, v3);
+		d += 64;
+		s += 64;
+		n -= 64;
+	}
+
+	while (n > 16) {
+		vst1q_u8(d, vld1q_u8(s));
+		d += 16;
+		s += 16;
+		n -= 16;
+	}
+
+	vst1q_u8(d + n - 16, tail);
+	return dst;
+}
+
+ATTRIBUTE_OPTIMIZE_NO_TLDP
+static void *memset_neon(void *dst, int c, size_t n)
+{
+	uint8_t *d = dst;
+
+	if (n <= 16) {
+		fill_small(d, (uint8_t) c, n);
+		return dst;
+	}
+
+	uint8x16_t v = vdupq_n_u8((uint8_t) c);
+
+	vst1q_u8(d, v);
+	vst1q_u8(d + n - 16, v);
+	if (n <= 32)
+		return dst;
+
+	uint8_t *end = d + n - 16;
+	d = (uint8_t *) (((uintptr_t) d + 16) & ~(uintptr_t) 15);
+
+	while (d + 64 <= end) {
+		vst1q_u8(d, v);
+		vst1q_u8(d + 16, v);
+		vst1q_u8(d + 32, v);
+		vst1q_u8(d + 48, v);
+		d += 64;
+	}
+
+	while (d < end) {
+		vst1q_u8(d, v);
+		d += 16;
+	}
+
+	return dst;
+}
+
+static int memcmp_neon(const void *s1, const void *s2, size_t n)
+{
+	const uint8_t *a = s1;
+	const uint8_t *b = s2;
+	uint64_t mask;
+	size_t i;
+
+	if (n < 8) {
+		for (i = 0; i < n; i++) {
+			if (a[i] != b[i])
+				return (int) a[i] - (int) b[i];
+		}
+
+		return 0;
+	}
+
+	if (n < 16) {
+		uint64_t x = ((const u64_u_t *) a)->v;
+		uint64_t y = ((const u64_u_t *) b)->v;
+		i = 0;
+		if (x == y) {
+			i = n - 8;
+			x = ((const u64_u_t *) (a + i))->v;
+			y = ((const u64_u_t *) (b + i))->v;
+			if (x == y)
+				return 0;
+		}
+
+		i += __builtin_ctzll(x ^ y) / 8;
+		return (int) a[i] - (int) b[i];
+	}
+
+	for (i = 0; i + 16 <= n; i += 16) {
+		mask = nibble_mask(vmvnq_u8(vceqq_u8(vld1q_u8(a + i),
+		    vld1q_u8(b + i))));
+		if (mask != 0)
+			goto found;
+	}
+
+	if (i == n)
+		return 0;
+
+	/* The last block overlaps with what has been compared already. */
+	i = n - 16;
+	mask = nibble_mask(vmvnq_u8(vceqq_u8(vld1q_u8(a + i),
+	    vld1q_u8(b + i))));
+	if (mask == 0)
+		return 0;
+
+found:
+	i += nibble_index(mask);
+	return (int) a[i] - (int) b[i];
+}
+
+static void *memchr_neon(const void *s, int c, size_t n)
+{
+	if (n == 0)
+		return NULL;
+
+	uint8x16_t needle = vdupq_n_u8((uint8_t) c);
+	size_t off = (uintptr_t) s & 15;
+	const uint8_t *p = (const uint8_t *) s - off;
+	uint64_t mask;
+
+	/* Ignore matches before the start of the area. */
+	mask = nibble_mask(vceqq_u8(vld1q_u8(p), needle)) >> (4 * off);
+	if (mask != 0) {
+		size_t i = nibble_index(mask);
+		return i < n ? (uint8_t *) s + i : NULL;
+	}
+
+	if (n <= 16 - off)
+		return NULL;
+
+	/* n is now the number of bytes left starting at p. */
+	n -= 16 - off;
+	p += 16;
+
+	while (n > 64) {
+		uint8x16_t any = vorrq_u8(
+		    vorrq_u8(vceqq_u8(vld1q_u8(p), needle),
+		    vceqq_u8(vld1q_u8(p + 16), needle)),
+		    vorrq_u8(vceqq_u8(vld1q_u8(p + 32), needle),
+		    vceqq_u8(vld1q_u8(p + 48), needle)));
+		if (vmaxvq_u8(any) != 0)
+			break;
+
+		p += 64;
+		n -= 64;
+	}
+
+	while (true) {
+		mask = nibble_mask(vceqq_u8(vld1q_u8(p), needle));
+		if (mask != 0) {
+			size_t i = nibble_index(mask);
+			return i < n ? (uint8_t *) p + i : NULL;
+		}
+
+		if (n <= 16)
+			return NULL;
+
+		p += 16;
+		n -= 16;
+	}
+}
+
+static size_t strlen_neon(const char *s)
+{
+	size_t off = (uintptr_t) s & 15;
+	const uint8_t *p = (const uint8_t *) s - off;
+	uint64_t mask;
+
+	mask = nibble_mask(vceqzq_u8(vld1q_u8(p))) >> (4 * off);
+	if (mask != 0)
+		return nibble_index(mask);
+
+	/*
+	 * Step to a 64-byte boundary, so that the unrolled loop below does
+	 * not read across a page boundary either.
+	 */
+	p += 16;
+	while (((uintptr_t) p & 63) != 0) {
+		mask = nibble_mask(vceqzq_u8(vld1q_u8(p)));
+		if (mask != 0)
+			return (const char *) p - s + nibble_index(mask);
+		p += 16;
+	}
+
+	while (true) {
+		uint8x16_t min = vminq_u8(
+		    vminq_u8(vld1q_u8(p), vld1q_u8(p + 16)),
+		    vminq_u8(vld1q_u8(p + 32), vld1q_u8(p + 48)));
+		if (vminvq_u8(min) == 0)
+			break;
+		p += 64;
+	}
+
+	while (true) {
+		mask = nibble_mask(vceqzq_u8(vld1q_u8(p)));
+		if (mask != 0)
+			return (const char *) p - s + nibble_index(mask);
+		p += 16;
+	}
+}
+
+static char *strchr_neon(const char *s, int c)
+{
+	uint8x16_t needle = vdupq_n_u8((uint8_t) c);
+	size_t off = (uintptr_t) s & 15;
+	const uint8_t *p = (const uint8_t *) s - off;
+	uint8x16_t v = vld1q_u8(p);
+	uint64_t mask;
+
+	mask = nibble_mask(vorrq_u8(vceqzq_u8(v), vceqq_u8(v, needle))) >>
+	    (4 * off);
+	p = (const uint8_t *) s;
+
+	while (mask == 0) {
+		p = (const uint8_t *) ((uintptr_t) p & ~(uintptr_t) 15) + 16;
+		v = vld1q_u8(p);
+		mask = nibble_mask(vorrq_u8(vceqzq_u8(v), vceqq_u8(v, needle)));
+	}
+
+	p += nibble_index(mask);
+	return *p == (uint8_t) c ? (char *) p : NULL;
+}
+
+void __mem_arch_init(mem_ops_t *ops)
+{
+	ops->memcpy = memcpy_neon;
+	ops->memset = memset_neon;
+	ops->memcmp = memcmp_neon;
+	ops->memchr = memchr_neon;
+	ops->strlen = strlen_neon;
+	ops->strchr = strchr_neon;
+}
+
+/** @}
+ */
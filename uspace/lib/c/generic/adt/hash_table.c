@@ -46,6 +46,19 @@
  * have fairly large (prime/odd) divisors. Having a prime table size
  * mitigates the use of suboptimal hash functions and distributes
  * items over the whole table.
+ *
+ * Resizing is incremental. When the table is resized, the new bucket array
+ * becomes the primary one and the old one is kept around. Each subsequent
+ * insertion or removal then migrates a few of the old buckets (in the order
+ * of their indices) to the new array, until the old array is empty and
+ * freed. This spreads the cost of rehashing over many operations, so that
+ * no single insertion has to rehash the whole table.
+ *
+ * Items always stay together with all other items of the same hash: an
+ * item belongs to its old bucket until that bucket is migrated and to its
+ * new bucket afterwards (see bucket_of()). Hence lookups only ever need to
+ * search one bucket list, and items inserted during a migration keep their
+ * order relative to equal items already in the table.
  */
 
 #include <adt/hash_table.h>
@@ -59,11 +72,14 @@
 #define HT_MIN_BUCKETS  89
 /* The table is resized when the average load per bucket exceeds this number. */
 #define HT_MAX_LOAD     2
+/* Number of old buckets migrated by each insertion or removal during resize. */
+#define HT_MIGRATE_STEP 4
 
 static size_t round_up_size(size_t);
 static bool alloc_table(size_t, list_t **);
 static void clear_items(hash_table_t *);
 static void resize(hash_table_t *, size_t);
+static void migrate(hash_table_t *, size_t);
 static void grow_if_needed(hash_table_t *);
 static void shrink_if_needed(hash_table_t *);
 
@@ -109,6 +125,9 @@ bool hash_table_create(hash_table_t *h, size_t init_size, size_t max_load,
 	h->op = op;
 	h->full_item_cnt = h->max_load * h->bucket_cnt;
 	h->apply_ongoing = false;
+	h->old_bucket = NULL;
+	h->old_bucket_cnt = 0;
+	h->migrate_idx = 0;
 
 	if (h->op->remove_callback == NULL) {
 		h->op->remove_callback = nop_remove_callback;
@@ -129,8 +148,10 @@ void hash_table_destroy(hash_table_t *h)
 
 	clear_items(h);
 
+	free(h->old_bucket);
 	free(h->bucket);
 
+	h->old_bucket = NULL;
 	h->bucket = NULL;
 	h->bucket_cnt = 0;
 }
@@ -160,6 +181,9 @@ void hash_table_clear(hash_table_t *h)
 
 	clear_items(h);
 
+	/* There is nothing left to migrate. */
+	migrate(h, h->old_bucket_cnt);
+
 	/* Shrink the table to its minimum size if possible. */
 	if (HT_MIN_BUCKETS < h->bucket_cnt) {
 		resize(h, HT_MIN_BUCKETS);
@@ -172,6 +196,15 @@ static void clear_items(hash_table_t *h)
 	if (h->item_cnt == 0)
 		return;
 
+	for (size_t idx = h->migrate_idx; idx < h->old_bucket_cnt; ++idx) {
+		list_foreach_safe(h->old_bucket[idx], cur, next) {
+			ht_link_t *cur_link = member_to_inst(cur, ht_link_t, link);
+
+			list_remove(cur);
+			h->op->remove_callback(cur_link);
+		}
+	}
+
 	for (size_t idx = 0; idx < h->bucket_cnt; ++idx) {
 		list_foreach_safe(h->bucket[idx], cur, next) {
 			assert(cur);
@@ -185,6 +218,22 @@ static void clear_items(hash_table_t *h)
 	h->item_cnt = 0;
 }
 
+/** Returns the bucket list items with the given hash belong to.
+ *
+ * While a resize is in progress, items whose old bucket has not been
+ * migrated yet are still there, all other items are in the new buckets.
+ */
+static list_t *bucket_of(const hash_table_t *h, size_t hash)
+{
+	if (h->old_bucket != NULL) {
+		size_t old_idx = hash % h->old_bucket_cnt;
+		if (h->migrate_idx <= old_idx)
+			return &h->old_bucket[old_idx];
+	}
+
+	return &h->bucket[hash % h->bucket_cnt];
+}
+
 /** Insert item into a hash table.
  *
  * @param h    Hash table.
@@ -196,9 +245,9 @@ void hash_table_insert(hash_table_t *h, ht_link_t *item)
 	assert(h && h->bucket);
 	assert(!h->apply_ongoing);
 
-	size_t idx = h->op->hash(item) % h->bucket_cnt;
+	migrate(h, HT_MIGRATE_STEP);
 
-	list_append(&item->link, &h->bucket[idx]);
+	list_append(&item->link, bucket_of(h, h->op->hash(item)));
 	++h->item_cnt;
 	grow_if_needed(h);
 }
@@ -218,10 +267,12 @@ bool hash_table_insert_unique(hash_table_t *h, ht_link_t *item)
 	assert(h->op && h->op->hash && h->op->equal);
 	assert(!h->apply_ongoing);
 
-	size_t idx = h->op->hash(item) % h->bucket_cnt;
+	migrate(h, HT_MIGRATE_STEP);
+
+	list_t *bucket = bucket_of(h, h->op->hash(item));
 
 	/* Check for duplicates. */
-	list_foreach(h->bucket[idx], link, ht_link_t, cur_link) {
+	list_foreach(*bucket, link, ht_link_t, cur_link) {
 		/*
 		 * We could filter out items using their hashes first, but
 		 * calling equal() might very well be just as fast.
@@ -230,7 +281,7 @@ bool hash_table_insert_unique(hash_table_t *h, ht_link_t *item)
 			return false;
 	}
 
-	list_append(&item->link, &h->bucket[idx]);
+	list_append(&item->link, bucket);
 	++h->item_cnt;
 	grow_if_needed(h);
 
@@ -249,9 +300,9 @@ ht_link_t *hash_table_find(const hash_table_t *h, const void *key)
 {
 	assert(h && h->bucket);
 
-	size_t idx = h->op->key_hash(key) % h->bucket_cnt;
+	list_t *bucket = bucket_of(h, h->op->key_hash(key));
 
-	list_foreach(h->bucket[idx], link, ht_link_t, cur_link) {
+	list_foreach(*bucket, link, ht_link_t, cur_link) {
 		/*
 		 * Is this is the item we are looking for? We could have first
 		 * checked if the hashes match but op->key_equal() may very well be
@@ -272,14 +323,14 @@ hash_table_find_next(const hash_table_t *h, ht_link_t *first, ht_link_t *item)
 	assert(item);
 	assert(h && h->bucket);
 
-	size_t idx = h->op->hash(item) % h->bucket_cnt;
+	list_t *bucket = bucket_of(h, h->op->hash(item));
 
 	/* Traverse the circular list until we reach the starting item again. */
 	for (link_t *cur = item->link.next; cur != &first->link;
 	    cur = cur->next) {
 		assert(cur);
 
-		if (cur == &h->bucket[idx].head)
+		if (cur == &bucket->head)
 			continue;
 
 		ht_link_t *cur_link = member_to_inst(cur, ht_link_t, link);
@@ -311,11 +362,13 @@ size_t hash_table_remove(hash_table_t *h, const void *key)
 	assert(h && h->bucket);
 	assert(!h->apply_ongoing);
 
-	size_t idx = h->op->key_hash(key) % h->bucket_cnt;
+	migrate(h, HT_MIGRATE_STEP);
+
+	list_t *bucket = bucket_of(h, h->op->key_hash(key));
 
 	size_t removed = 0;
 
-	list_foreach_safe(h->bucket[idx], cur, next) {
+	list_foreach_safe(*bucket, cur, next) {
 		ht_link_t *cur_link = member_to_inst(cur, ht_link_t, link);
 
 		if (h->op->key_equal(key, cur_link)) {
@@ -341,6 +394,11 @@ void hash_table_remove_item(hash_table_t *h, ht_link_t *item)
 	list_remove(&item->link);
 	--h->item_cnt;
 	h->op->remove_callback(item);
+
+	/* Migrating buckets would disrupt hash_table_apply(). */
+	if (!h->apply_ongoing)
+		migrate(h, HT_MIGRATE_STEP);
+
 	shrink_if_needed(h);
 }
 
@@ -363,6 +421,14 @@ void hash_table_apply(hash_table_t *h, bool (*f)(ht_link_t *, void *), void *arg
 
 	h->apply_ongoing = true;
 
+	for (size_t idx = h->migrate_idx; idx < h->old_bucket_cnt; ++idx) {
+		list_foreach_safe(h->old_bucket[idx], cur, next) {
+			ht_link_t *cur_link = member_to_inst(cur, ht_link_t, link);
+			if (!f(cur_link, arg))
+				goto out;
+		}
+	}
+
 	for (size_t idx = 0; idx < h->bucket_cnt; ++idx) {
 		list_foreach_safe(h->bucket[idx], cur, next) {
 			ht_link_t *cur_link = member_to_inst(cur, ht_link_t, link);
@@ -433,7 +499,41 @@ static inline void grow_if_needed(hash_table_t *h)
 	}
 }
 
-/** Allocates and rehashes items to a new table. Frees the old table. */
+/** Migrates up to @a cnt buckets of the old table to the new one.
+ *
+ * Frees the old table once all of its buckets have been migrated.
+ */
+static void migrate(hash_table_t *h, size_t cnt)
+{
+	if (h->old_bucket == NULL)
+		return;
+
+	while (cnt > 0 && h->migrate_idx < h->old_bucket_cnt) {
+		list_foreach_safe(h->old_bucket[h->migrate_idx], cur, next) {
+			ht_link_t *cur_link = member_to_inst(cur, ht_link_t, link);
+
+			size_t new_idx = h->op->hash(cur_link) % h->bucket_cnt;
+			list_remove(cur);
+			list_append(cur, &h->bucket[new_idx]);
+		}
+
+		++h->migrate_idx;
+		--cnt;
+	}
+
+	if (h->migrate_idx == h->old_bucket_cnt) {
+		free(h->old_bucket);
+		h->old_bucket = NULL;
+		h->old_bucket_cnt = 0;
+		h->migrate_idx = 0;
+	}
+}
+
+/** Allocates a new table and starts migrating items to it.
+ *
+ * The items are moved over incrementally by subsequent operations (see
+ * migrate()). A migration still in progress is finished first.
+ */
 static void resize(hash_table_t *h, size_t new_bucket_cnt)
 {
 	assert(h && h->bucket);
@@ -449,20 +549,16 @@ static void resize(hash_table_t *h, size_t new_bucket_cnt)
 	if (!alloc_table(new_bucket_cnt, &new_buckets))
 		return;
 
+	migrate(h, h->old_bucket_cnt);
+
 	if (0 < h->item_cnt) {
-		/* Rehash all the items to the new table. */
-		for (size_t old_idx = 0; old_idx < h->bucket_cnt; ++old_idx) {
-			list_foreach_safe(h->bucket[old_idx], cur, next) {
-				ht_link_t *cur_link = member_to_inst(cur, ht_link_t, link);
-
-				size_t new_idx = h->op->hash(cur_link) % new_bucket_cnt;
-				list_remove(cur);
-				list_append(cur, &new_buckets[new_idx]);
-			}
-		}
+		h->old_bucket = h->bucket;
+		h->old_bucket_cnt = h->bucket_cnt;
+		h->migrate_idx = 0;
+	} else {
+		free(h->bucket);
 	}
 
-	free(h->bucket);
 	h->bucket = new_buckets;
 	h->bucket_cnt = new_bucket_cnt;
 	h->full_item_cnt = h->max_load * h->bucket_cnt;
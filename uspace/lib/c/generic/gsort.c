@@ -32,68 +32,35 @@
 
 /**
  * @file
- * @brief Gnome Sort.
+ * @brief Stable sort.
  *
- * This file contains an implementation of gnome sort
+ * Historically a gnome sort, hence the name. The sorting is now done by
+ * the in-place merge sort in sort.c, which keeps gsort() stable (callers
+ * rely on that) while avoiding the quadratic running time.
  *
  */
 
 #include <gsort.h>
-#include <inttypes.h>
-#include <mem.h>
-#include <stdlib.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "private/sort.h"
 
-/** Immediate buffer size.
- *
- * For small buffer sizes avoid doing malloc()
- * and use the stack.
- *
- */
-#define IBUF_SIZE  32
+/** Comparator and its argument as passed to gsort(). */
+typedef struct {
+	sort_cmp_t cmp;
+	void *arg;
+} gsort_cmp_t;
 
-/** Array accessor.
- *
- */
-#define INDEX(buf, i, elem_size)  ((buf) + (i) * (elem_size))
-
-/** Gnome sort
- *
- * Apply generic gnome sort algorithm on supplied data,
- * using pre-allocated buffer.
- *
- * @param data      Pointer to data to be sorted.
- * @param cnt       Number of elements to be sorted.
- * @param elem_size Size of one element.
- * @param cmp       Comparator function.
- * @param arg       3rd argument passed to cmp.
- * @param slot      Pointer to scratch memory buffer
- *                  elem_size bytes long.
- *
- */
-static void _gsort(void *data, size_t cnt, size_t elem_size, sort_cmp_t cmp,
-    void *arg, void *slot)
+static int cmp_wrap(const void *a, const void *b, void *arg)
 {
-	size_t i = 0;
+	gsort_cmp_t *gcmp = arg;
 
-	while (i < cnt) {
-		if ((i != 0) &&
-		    (cmp(INDEX(data, i, elem_size),
-		    INDEX(data, i - 1, elem_size), arg) < 0)) {
-			memcpy(slot, INDEX(data, i, elem_size), elem_size);
-			memcpy(INDEX(data, i, elem_size), INDEX(data, i - 1, elem_size),
-			    elem_size);
-			memcpy(INDEX(data, i - 1, elem_size), slot, elem_size);
-			i--;
-		} else
-			i++;
-	}
+	return gcmp->cmp((void *) a, (void *) b, gcmp->arg);
 }
 
-/** Gnome sort wrapper
+/** Stable sort
  *
- * This is only a wrapper that takes care of memory
- * allocations for storing the slot element for generic
- * gnome sort algorithm.
+ * Equal elements keep their relative order.
  *
  * @param data      Pointer to data to be sorted.
  * @param cnt       Number of elements to be sorted.
@@ -101,26 +68,18 @@ static void _gsort(void *data, size_t cnt, size_t elem_size, sort_cmp_t cmp,
  * @param cmp       Comparator function.
  * @param arg       3rd argument passed to cmp.
  *
- * @return True if sorting succeeded.
+ * @return True if sorting succeeded (it always does, the sort does not
+ *         need any extra memory).
  *
  */
 bool gsort(void *data, size_t cnt, size_t elem_size, sort_cmp_t cmp, void *arg)
 {
-	uint8_t ibuf_slot[IBUF_SIZE];
-	void *slot;
-
-	if (elem_size > IBUF_SIZE) {
-		slot = (void *) malloc(elem_size);
-		if (!slot)
-			return false;
-	} else
-		slot = (void *) ibuf_slot;
-
-	_gsort(data, cnt, elem_size, cmp, arg, slot);
-
-	if (elem_size > IBUF_SIZE)
-		free(slot);
+	gsort_cmp_t gcmp = {
+		.cmp = cmp,
+		.arg = arg
+	};
 
+	__sort_stable(data, cnt, elem_size, cmp_wrap, &gcmp);
 	return true;
 }
 
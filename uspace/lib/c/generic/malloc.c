@@ -782,7 +782,8 @@ static void *malloc_internal(const size_t size, const size_t align)
  */
 void *calloc(const size_t nmemb, const size_t size)
 {
-	// FIXME: Check for overflow
+	if ((size != 0) && (nmemb > SIZE_MAX / size))
+		return NULL;
 
 	void *block = malloc(nmemb * size);
 	if (block == NULL)
@@ -0,0 +1,1092 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup libc
+ * @{
+ */
+/** @file Scalable heap allocator.
+ *
+ * Every runner thread allocates from its own arena, so threads do not
+ * contend for a single heap lock. An arena only needs to be locked
+ * against frees of its blocks from other threads and against runners
+ * sharing the arena, so the lock is normally uncontended.
+ *
+ * Memory is taken from the kernel in chunks, address space areas aligned
+ * on CHUNK_SIZE with a header at the start. The header of the chunk of
+ * any block is found by aligning the block address down.
+ *
+ *  - Small blocks (up to SMALL_MAX bytes) are rounded up to one of the
+ *    size classes. A small chunk holds blocks of a single class, without
+ *    any per-block header.
+ *
+ *  - Medium blocks (up to MEDIUM_MAX bytes) are carved from medium chunks
+ *    using boundary tags. Free medium blocks are coalesced and kept in
+ *    segregated free lists, binned by size.
+ *
+ *  - Large blocks are mapped as address space areas of their own.
+ *
+ * Chunks that become empty are returned to the kernel. Each arena keeps
+ * at most one partially used chunk per small class, one medium chunk and
+ * one spare chunk to avoid remapping memory back and forth.
+ */
+
+#include <malloc.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <as.h>
+#include <align.h>
+#include <macros.h>
+#include <assert.h>
+#include <errno.h>
+#include <bitops.h>
+#include <fibril.h>
+#include <mem.h>
+#include <stdlib.h>
+#include <adt/list.h>
+
+#include "private/malloc.h"
+#include "private/fibril.h"
+
+/** Magic used in chunk headers. */
+#define CHUNK_MAGIC  UINT32_C(0xBEEFC0DE)
+
+/** Allocation alignment. */
+#define BASE_ALIGN  16
+
+/** Binary logarithm of the size of chunks. */
+#define CHUNK_SHIFT  18
+
+/** Size and alignment of chunks. */
+#define CHUNK_SIZE  (1 << CHUNK_SHIFT)
+
+/** Space reserved for the chunk header. */
+#define CHUNK_HEADER_SIZE  ALIGN_UP(sizeof(chunk_t), 64)
+
+/** Largest small block. */
+#define SMALL_MAX  1024
+
+/** Number of small size classes. */
+#define SMALL_CLASSES  20
+
+/** Largest medium block. */
+#define MEDIUM_MAX  (CHUNK_SIZE / 4)
+
+/** Flag of a used medium block, kept in the size of the block. */
+#define MEDIUM_USED  1
+
+/** Space reserved for the medium block header. */
+#define MEDIUM_HEAD_SIZE  ALIGN_UP(sizeof(medium_head_t), BASE_ALIGN)
+
+/** Smallest medium block, it has to fit a free list link. */
+#define MEDIUM_BLOCK_MIN \
+	ALIGN_UP(MEDIUM_HEAD_SIZE + sizeof(link_t), BASE_ALIGN)
+
+/** Binary logarithm of the smallest medium block. */
+#define MEDIUM_BIN_SHIFT  5
+
+/** Number of bins of free medium blocks, four per power of two. */
+#define MEDIUM_BINS  ((CHUNK_SHIFT - MEDIUM_BIN_SHIFT) * 4)
+
+/** Maximal number of arenas. Runners beyond that share arenas. */
+#define ARENAS  64
+
+/** Flags of the address space areas used by the heap. */
+#define HEAP_AREA_FLAGS \
+	(AS_AREA_READ | AS_AREA_WRITE | AS_AREA_CACHEABLE | AS_AREA_LATE_RESERVE)
+
+typedef enum {
+	CHUNK_SMALL,
+	CHUNK_MEDIUM,
+	CHUNK_LARGE
+} chunk_kind_t;
+
+struct arena;
+
+/** Chunk header
+ *
+ * Placed at the start of every chunk, and of every area holding
+ * a large block.
+ *
+ */
+typedef struct {
+	/** A magic value */
+	uint32_t magic;
+
+	/** Kind of blocks in the chunk */
+	uint8_t kind;
+
+	/** Size class of a small chunk */
+	uint8_t sclass;
+
+	/** Arena the chunk belongs to */
+	struct arena *arena;
+
+	/** Size of the chunk */
+	size_t size;
+
+	/** Link to the list of all chunks of the arena */
+	link_t chunks_link;
+
+	/** Link to the list of small chunks with free blocks */
+	link_t link;
+
+	/** Number of used blocks */
+	size_t used;
+
+	/** Free small blocks */
+	void *free;
+
+	/** Start of the part of a small chunk that has never been used */
+	uintptr_t bump;
+} chunk_t;
+
+/** Header of a medium block */
+typedef struct {
+	/** Size of the block (including the header), MEDIUM_USED if used */
+	size_t size;
+
+	/** Size of the previous block in the chunk, zero for the first one */
+	size_t prev_size;
+} medium_head_t;
+
+/** Arena */
+typedef struct arena {
+	/** Serializes access to the arena */
+	fibril_rmutex_t lock;
+
+	/** Small chunks with free blocks, for each size class */
+	list_t small[SMALL_CLASSES];
+
+	/** Free medium blocks, binned by size */
+	list_t bins[MEDIUM_BINS];
+
+	/** Bitmap of non-empty bins */
+	uint64_t bin_map;
+
+	/** Number of medium chunks */
+	size_t medium_chunks;
+
+	/** All chunks of the arena, for heap_check() */
+	list_t chunks;
+
+	/** Empty chunk kept for reuse */
+	chunk_t *spare;
+} arena_t;
+
+/** Sizes of the small classes. */
+static const uint16_t small_sizes[SMALL_CLASSES] = {
+	16, 32, 48, 64, 80, 96, 112, 128,
+	160, 192, 224, 256,
+	320, 384, 448, 512,
+	640, 768, 896, 1024
+};
+
+/** Arena of the main thread, always present. */
+static arena_t main_arena;
+
+/** Arenas, indexed by the runner. */
+static _Atomic(arena_t *) arenas[ARENAS];
+
+/** Where to try to map the next chunk. */
+static atomic_uintptr_t chunk_hint;
+
+/** Serializes creation of arenas. */
+static fibril_rmutex_t arenas_lock;
+
+#define malloc_assert(expr) safe_assert(expr)
+
+/*
+ * Make sure the base alignment is sufficient.
+ */
+static_assert(BASE_ALIGN >= alignof(max_align_t), "");
+static_assert(MEDIUM_BINS <= 64, "");
+static_assert(MEDIUM_BLOCK_MIN >= (1 << MEDIUM_BIN_SHIFT), "");
+static_assert((CHUNK_SIZE % PAGE_SIZE) == 0, "");
+
+static errno_t arena_init(arena_t *arena)
+{
+	errno_t rc = fibril_rmutex_initialize(&arena->lock);
+	if (rc != EOK)
+		return rc;
+
+	for (unsigned i = 0; i < SMALL_CLASSES; i++)
+		list_initialize(&arena->small[i]);
+
+	for (unsigned i = 0; i < MEDIUM_BINS; i++)
+		list_initialize(&arena->bins[i]);
+
+	arena->bin_map = 0;
+	arena->medium_chunks = 0;
+	list_initialize(&arena->chunks);
+	arena->spare = NULL;
+
+	return EOK;
+}
+
+/** Create the arena of a runner.
+ *
+ * @param idx Index of the arena.
+ *
+ * @return The arena. The main arena if there is not enough memory
+ *         for a new one.
+ *
+ */
+static arena_t *arena_create(unsigned idx)
+{
+	fibril_rmutex_lock(&arenas_lock);
+
+	arena_t *arena = atomic_load_explicit(&arenas[idx], memory_order_relaxed);
+	if (arena == NULL) {
+		arena = as_area_create(AS_AREA_ANY,
+		    ALIGN_UP(sizeof(arena_t), PAGE_SIZE), HEAP_AREA_FLAGS,
+		    AS_AREA_UNPAGED);
+
+		if (arena == AS_MAP_FAILED) {
+			arena = &main_arena;
+		} else if (arena_init(arena) != EOK) {
+			as_area_destroy(arena);
+			arena = &main_arena;
+		} else {
+			atomic_store_explicit(&arenas[idx], arena,
+			    memory_order_release);
+		}
+	}
+
+	fibril_rmutex_unlock(&arenas_lock);
+	return arena;
+}
+
+/** Get the arena of the running thread. */
+static arena_t *arena_get(void)
+{
+	unsigned idx = fibril_get_runner() % ARENAS;
+
+	arena_t *arena = atomic_load_explicit(&arenas[idx], memory_order_acquire);
+	if (arena == NULL)
+		arena = arena_create(idx);
+
+	return arena;
+}
+
+/** Get the chunk of a block. */
+static chunk_t *chunk_of(void *addr)
+{
+	/*
+	 * Large blocks with the alignment of a whole chunk begin right
+	 * at the end of their first chunk.
+	 */
+	chunk_t *chunk = (chunk_t *) ALIGN_DOWN((uintptr_t) addr - 1, CHUNK_SIZE);
+	malloc_assert(chunk->magic == CHUNK_MAGIC);
+	return chunk;
+}
+
+/** Map an address space area at an address aligned on CHUNK_SIZE.
+ *
+ * Find a hole large enough for an aligned area and map the area there.
+ * Another thread might take the hole in the meantime, so try a few times.
+ *
+ */
+static void *chunk_map_aligned(size_t size)
+{
+	for (unsigned i = 0; i < 4; i++) {
+		void *hole = as_area_create(AS_AREA_ANY, size + CHUNK_SIZE,
+		    HEAP_AREA_FLAGS, AS_AREA_UNPAGED);
+		if (hole == AS_MAP_FAILED)
+			return NULL;
+
+		as_area_destroy(hole);
+
+		void *start = as_area_create(
+		    (void *) ALIGN_UP((uintptr_t) hole, CHUNK_SIZE), size,
+		    HEAP_AREA_FLAGS, AS_AREA_UNPAGED);
+		if (start != AS_MAP_FAILED)
+			return start;
+	}
+
+	return NULL;
+}
+
+/** Map an address space area aligned on CHUNK_SIZE.
+ *
+ * @param size Size of the area.
+ *
+ * @return Start of the area or NULL on not enough memory.
+ *
+ */
+static void *chunk_map(size_t size)
+{
+	/* The space right after the last chunk is usually free. */
+	uintptr_t hint = atomic_load_explicit(&chunk_hint, memory_order_relaxed);
+	void *start = AS_MAP_FAILED;
+
+	if (hint != 0) {
+		start = as_area_create((void *) hint, size, HEAP_AREA_FLAGS,
+		    AS_AREA_UNPAGED);
+	}
+
+	if (start == AS_MAP_FAILED) {
+		start = as_area_create(AS_AREA_ANY, size, HEAP_AREA_FLAGS,
+		    AS_AREA_UNPAGED);
+		if (start == AS_MAP_FAILED)
+			return NULL;
+
+		if (((uintptr_t) start % CHUNK_SIZE) != 0) {
+			as_area_destroy(start);
+			start = chunk_map_aligned(size);
+			if (start == NULL)
+				return NULL;
+		}
+	}
+
+	atomic_store_explicit(&chunk_hint,
+	    ALIGN_UP((uintptr_t) start + size, CHUNK_SIZE), memory_order_relaxed);
+	return start;
+}
+
+/** Get a chunk for small or medium blocks.
+ *
+ * Should be called only inside the critical section of the arena.
+ *
+ */
+static chunk_t *chunk_get(arena_t *arena, chunk_kind_t kind)
+{
+	chunk_t *chunk = arena->spare;
+	if (chunk != NULL) {
+		arena->spare = NULL;
+	} else {
+		chunk = chunk_map(CHUNK_SIZE);
+		if (chunk == NULL)
+			return NULL;
+	}
+
+	chunk->magic = CHUNK_MAGIC;
+	chunk->kind = kind;
+	chunk->sclass = 0;
+	chunk->arena = arena;
+	chunk->size = CHUNK_SIZE;
+	link_initialize(&chunk->link);
+	chunk->used = 0;
+	chunk->free = NULL;
+	chunk->bump = 0;
+
+	list_append(&chunk->chunks_link, &arena->chunks);
+	return chunk;
+}
+
+/** Release an empty chunk.
+ *
+ * Keep it as the spare chunk of the arena, or return it to the kernel.
+ * Should be called only inside the critical section of the arena.
+ *
+ */
+static void chunk_release(arena_t *arena, chunk_t *chunk)
+{
+	list_remove(&chunk->chunks_link);
+
+	if (arena->spare == NULL) {
+		arena->spare = chunk;
+		return;
+	}
+
+	chunk->magic = 0;
+	as_area_destroy(chunk);
+}
+
+/** Get the size class of a small block. */
+static unsigned small_class(size_t size)
+{
+	if (size <= 128)
+		return (size > 0) ? (size - 1) / 16 : 0;
+
+	/* Four classes per power of two. */
+	unsigned order = fnzb(size - 1);
+	return 8 + (order - 7) * 4 + ((size - 1 - (1 << order)) >> (order - 2));
+}
+
+/** Start of the blocks in a small chunk.
+ *
+ * The blocks are aligned on the largest power of two dividing the size
+ * of the class, which memalign() relies on.
+ *
+ */
+static uintptr_t small_start(chunk_t *chunk)
+{
+	size_t size = small_sizes[chunk->sclass];
+	return ALIGN_UP((uintptr_t) chunk + CHUNK_HEADER_SIZE, size & -size);
+}
+
+/** Allocate a small block.
+ *
+ * Should be called only inside the critical section of the arena.
+ *
+ */
+static void *small_alloc(arena_t *arena, unsigned sclass)
+{
+	list_t *list = &arena->small[sclass];
+	size_t size = small_sizes[sclass];
+	chunk_t *chunk;
+
+	link_t *link = list_first(list);
+	if (link != NULL) {
+		chunk = list_get_instance(link, chunk_t, link);
+	} else {
+		chunk = chunk_get(arena, CHUNK_SMALL);
+		if (chunk == NULL)
+			return NULL;
+
+		chunk->sclass = sclass;
+		chunk->bump = small_start(chunk);
+		list_append(&chunk->link, list);
+	}
+
+	void *addr = chunk->free;
+	if (addr != NULL) {
+		chunk->free = *(void **) addr;
+	} else {
+		/* Carve blocks lazily, not to touch all pages at once. */
+		addr = (void *) chunk->bump;
+		chunk->bump += size;
+	}
+
+	chunk->used++;
+
+	/* Full chunks are not kept on the list. */
+	if ((chunk->free == NULL) &&
+	    (chunk->bump + size > (uintptr_t) chunk + CHUNK_SIZE))
+		list_remove(&chunk->link);
+
+	return addr;
+}
+
+/** Free a small block.
+ *
+ * Should be called only inside the critical section of the arena.
+ *
+ */
+static void small_free(arena_t *arena, chunk_t *chunk, void *addr)
+{
+	list_t *list = &arena->small[chunk->sclass];
+
+	malloc_assert((uintptr_t) addr < chunk->bump);
+	malloc_assert(((uintptr_t) addr - small_start(chunk)) %
+	    small_sizes[chunk->sclass] == 0);
+	malloc_assert(chunk->used > 0);
+
+	*(void **) addr = chunk->free;
+	chunk->free = addr;
+	chunk->used--;
+
+	if (!link_in_use(&chunk->link))
+		list_prepend(&chunk->link, list);
+
+	/* Keep one chunk of the class, even if it is empty. */
+	if ((chunk->used == 0) &&
+	    ((list_first(list) != &chunk->link) ||
+	    (list_last(list) != &chunk->link))) {
+		list_remove(&chunk->link);
+		chunk_release(arena, chunk);
+	}
+}
+
+/** Get the bin of a free medium block. */
+static unsigned medium_bin(size_t size)
+{
+	unsigned order = fnzb(size);
+	return (order - MEDIUM_BIN_SHIFT) * 4 + ((size >> (order - 2)) & 3);
+}
+
+static void medium_bin_insert(arena_t *arena, medium_head_t *head)
+{
+	unsigned bin = medium_bin(head->size);
+	link_t *link = (link_t *) ((uintptr_t) head + MEDIUM_HEAD_SIZE);
+
+	link_initialize(link);
+	list_append(link, &arena->bins[bin]);
+	arena->bin_map |= (uint64_t) 1 << bin;
+}
+
+static void medium_bin_remove(arena_t *arena, medium_head_t *head)
+{
+	unsigned bin = medium_bin(head->size);
+	link_t *link = (link_t *) ((uintptr_t) head + MEDIUM_HEAD_SIZE);
+
+	list_remove(link);
+	if (list_empty(&arena->bins[bin]))
+		arena->bin_map &= ~((uint64_t) 1 << bin);
+}
+
+static medium_head_t *medium_next(chunk_t *chunk, medium_head_t *head)
+{
+	uintptr_t next = (uintptr_t) head + (head->size & ~MEDIUM_USED);
+	if (next >= (uintptr_t) chunk + CHUNK_SIZE)
+		return NULL;
+
+	return (medium_head_t *) next;
+}
+
+/** Gross size of a medium block. */
+static size_t medium_gross(size_t size)
+{
+	return ALIGN_UP(size, BASE_ALIGN) + MEDIUM_HEAD_SIZE;
+}
+
+/** Split the tail off a medium block.
+ *
+ * The tail is freed, if it is large enough for a block.
+ * Should be called only inside the critical section of the arena.
+ *
+ * @param head  Used medium block.
+ * @param gross New size of the block.
+ *
+ */
+static void medium_split(arena_t *arena, chunk_t *chunk, medium_head_t *head,
+    size_t gross)
+{
+	size_t size = head->size & ~MEDIUM_USED;
+	if (size - gross < MEDIUM_BLOCK_MIN)
+		return;
+
+	medium_head_t *rest = (medium_head_t *) ((uintptr_t) head + gross);
+	rest->size = size - gross;
+	rest->prev_size = gross;
+	head->size = gross | MEDIUM_USED;
+
+	/* Merge the tail with the next block if that is free. */
+	medium_head_t *next = medium_next(chunk, rest);
+	if ((next != NULL) && !(next->size & MEDIUM_USED)) {
+		medium_bin_remove(arena, next);
+		rest->size += next->size;
+		next = medium_next(chunk, rest);
+	}
+
+	if (next != NULL)
+		next->prev_size = rest->size;
+
+	medium_bin_insert(arena, rest);
+}
+
+/** Allocate a medium block.
+ *
+ * Should be called only inside the critical section of the arena.
+ *
+ * @param gross Gross size of the block.
+ *
+ */
+static void *medium_alloc(arena_t *arena, size_t gross)
+{
+	unsigned bin = medium_bin(gross);
+	medium_head_t *head = NULL;
+
+	/*
+	 * Any block in the bins above the bin of the requested size is large
+	 * enough. Blocks in that bin might be too small, so search it only
+	 * when there is nothing else.
+	 */
+	uint64_t map = arena->bin_map & ~(((uint64_t) 2 << bin) - 1);
+	if (map != 0) {
+		link_t *link = list_first(&arena->bins[__builtin_ctzll(map)]);
+		head = (medium_head_t *) ((uintptr_t) link - MEDIUM_HEAD_SIZE);
+	} else {
+		list_t *list = &arena->bins[bin];
+		for (link_t *link = list_first(list); link != NULL;
+		    link = list_next(link, list)) {
+			medium_head_t *cur = (medium_head_t *)
+			    ((uintptr_t) link - MEDIUM_HEAD_SIZE);
+			if (cur->size >= gross) {
+				head = cur;
+				break;
+			}
+		}
+	}
+
+	chunk_t *chunk;
+	if (head == NULL) {
+		chunk = chunk_get(arena, CHUNK_MEDIUM);
+		if (chunk == NULL)
+			return NULL;
+
+		arena->medium_chunks++;
+
+		head = (medium_head_t *) ((uintptr_t) chunk + CHUNK_HEADER_SIZE);
+		head->size = CHUNK_SIZE - CHUNK_HEADER_SIZE;
+		head->prev_size = 0;
+	} else {
+		chunk = chunk_of(head);
+		medium_bin_remove(arena, head);
+	}
+
+	head->size |= MEDIUM_USED;
+	medium_split(arena, chunk, head, gross);
+	chunk->used++;
+
+	return (void *) ((uintptr_t) head + MEDIUM_HEAD_SIZE);
+}
+
+/** Free a medium block.
+ *
+ * Should be called only inside the critical section of the arena.
+ *
+ */
+static void medium_free(arena_t *arena, chunk_t *chunk, void *addr)
+{
+	medium_head_t *head = (medium_head_t *)
+	    ((uintptr_t) addr - MEDIUM_HEAD_SIZE);
+
+	malloc_assert(head->size & MEDIUM_USED);
+	malloc_assert(chunk->used > 0);
+
+	head->size &= ~MEDIUM_USED;
+	chunk->used--;
+
+	/* Merge with the next block if it is free. */
+	medium_head_t *next = medium_next(chunk, head);
+	if ((next != NULL) && !(next->size & MEDIUM_USED)) {
+		medium_bin_remove(arena, next);
+		head->size += next->size;
+	}
+
+	/* Merge with the previous block if it is free. */
+	if (head->prev_size != 0) {
+		medium_head_t *prev = (medium_head_t *)
+		    ((uintptr_t) head - head->prev_size);
+		if (!(prev->size & MEDIUM_USED)) {
+			medium_bin_remove(arena, prev);
+			prev->size += head->size;
+			head = prev;
+		}
+	}
+
+	next = medium_next(chunk, head);
+	if (next != NULL)
+		next->prev_size = head->size;
+
+	/* Keep one medium chunk, even if it is empty. */
+	if ((chunk->used == 0) && (arena->medium_chunks > 1)) {
+		arena->medium_chunks--;
+		chunk_release(arena, chunk);
+		return;
+	}
+
+	medium_bin_insert(arena, head);
+}
+
+/** Try to resize a medium block in place.
+ *
+ * Should be called only inside the critical section of the arena.
+ *
+ */
+static bool medium_resize(arena_t *arena, chunk_t *chunk, void *addr,
+    size_t gross)
+{
+	medium_head_t *head = (medium_head_t *)
+	    ((uintptr_t) addr - MEDIUM_HEAD_SIZE);
+	size_t size = head->size & ~MEDIUM_USED;
+
+	if (gross > size) {
+		medium_head_t *next = medium_next(chunk, head);
+		if ((next == NULL) || (next->size & MEDIUM_USED) ||
+		    (size + next->size < gross))
+			return false;
+
+		/* Take over the next block. */
+		medium_bin_remove(arena, next);
+		head->size += next->size;
+
+		next = medium_next(chunk, head);
+		if (next != NULL)
+			next->prev_size = head->size & ~MEDIUM_USED;
+	}
+
+	medium_split(arena, chunk, head, gross);
+	return true;
+}
+
+/** Allocate a large block.
+ *
+ * @param size  Size of the block.
+ * @param align Alignment of the block, at most CHUNK_SIZE.
+ *
+ */
+static void *large_alloc(arena_t *arena, size_t size, size_t align)
+{
+	size_t offset = ALIGN_UP(CHUNK_HEADER_SIZE, align);
+
+	/* Check for integer overflow. */
+	if (size > SIZE_MAX - offset - PAGE_SIZE)
+		return NULL;
+
+	size_t asize = ALIGN_UP(offset + size, PAGE_SIZE);
+
+	chunk_t *chunk = chunk_map(asize);
+	if (chunk == NULL)
+		return NULL;
+
+	chunk->magic = CHUNK_MAGIC;
+	chunk->kind = CHUNK_LARGE;
+	chunk->sclass = 0;
+	chunk->arena = arena;
+	chunk->size = asize;
+	link_initialize(&chunk->link);
+	chunk->used = 1;
+	chunk->free = NULL;
+	chunk->bump = 0;
+
+	fibril_rmutex_lock(&arena->lock);
+	list_append(&chunk->chunks_link, &arena->chunks);
+	fibril_rmutex_unlock(&arena->lock);
+
+	return (void *) ((uintptr_t) chunk + offset);
+}
+
+static void large_free(chunk_t *chunk)
+{
+	arena_t *arena = chunk->arena;
+
+	fibril_rmutex_lock(&arena->lock);
+	list_remove(&chunk->chunks_link);
+	fibril_rmutex_unlock(&arena->lock);
+
+	chunk->magic = 0;
+	as_area_destroy(chunk);
+}
+
+/** Get the usable size of a block. */
+static size_t block_size(chunk_t *chunk, void *addr)
+{
+	switch (chunk->kind) {
+	case CHUNK_SMALL:
+		return small_sizes[chunk->sclass];
+	case CHUNK_MEDIUM:
+		return (((medium_head_t *) ((uintptr_t) addr -
+		    MEDIUM_HEAD_SIZE))->size & ~MEDIUM_USED) - MEDIUM_HEAD_SIZE;
+	default:
+		return (uintptr_t) chunk + chunk->size - (uintptr_t) addr;
+	}
+}
+
+/** Allocate a memory block
+ *
+ * @param size  The size of the block to allocate.
+ * @param align Memory address alignment, a power of two.
+ *
+ * @return Address of the allocated block or NULL on not enough memory.
+ *
+ */
+static void *malloc_internal(size_t size, size_t align)
+{
+	if (align > CHUNK_SIZE)
+		return NULL;
+
+	arena_t *arena = arena_get();
+	void *addr = NULL;
+
+	if ((size <= SMALL_MAX) && (align <= SMALL_MAX)) {
+		/* Find a class aligned well enough. */
+		unsigned sclass = small_class(size);
+		while ((sclass < SMALL_CLASSES) &&
+		    ((small_sizes[sclass] & (align - 1)) != 0))
+			sclass++;
+
+		if (sclass < SMALL_CLASSES) {
+			fibril_rmutex_lock(&arena->lock);
+			addr = small_alloc(arena, sclass);
+			fibril_rmutex_unlock(&arena->lock);
+			return addr;
+		}
+	}
+
+	if ((size <= MEDIUM_MAX) && (align <= BASE_ALIGN)) {
+		fibril_rmutex_lock(&arena->lock);
+		addr = medium_alloc(arena, medium_gross(size));
+		fibril_rmutex_unlock(&arena->lock);
+		return addr;
+	}
+
+	return large_alloc(arena, size, max(align, BASE_ALIGN));
+}
+
+/** Initialize the heap allocator
+ *
+ * This routine is only called from libc initialization,
+ * thus we do not take any locks.
+ *
+ */
+void __malloc_init(void)
+{
+	if (fibril_rmutex_initialize(&arenas_lock) != EOK)
+		abort();
+
+	if (arena_init(&main_arena) != EOK)
+		abort();
+
+	atomic_store_explicit(&arenas[0], &main_arena, memory_order_relaxed);
+}
+
+void __malloc_fini(void)
+{
+	fibril_rmutex_destroy(&main_arena.lock);
+	fibril_rmutex_destroy(&arenas_lock);
+}
+
+/** Allocate memory by number of elements
+ *
+ * @param nmemb Number of members to allocate.
+ * @param size  Size of one member in bytes.
+ *
+ * @return Allocated memory or NULL.
+ *
+ */
+void *calloc(const size_t nmemb, const size_t size)
+{
+	if ((size != 0) && (nmemb > SIZE_MAX / size))
+		return NULL;
+
+	void *block = malloc(nmemb * size);
+	if (block == NULL)
+		return NULL;
+
+	/* Large blocks are fresh memory from the kernel. */
+	if (chunk_of(block)->kind != CHUNK_LARGE)
+		memset(block, 0, nmemb * size);
+
+	return block;
+}
+
+/** Allocate memory
+ *
+ * @param size Number of bytes to allocate.
+ *
+ * @return Allocated memory or NULL.
+ *
+ */
+void *malloc(const size_t size)
+{
+	return malloc_internal(size, BASE_ALIGN);
+}
+
+/** Allocate memory with specified alignment
+ *
+ * @param align Alignment in byes.
+ * @param size  Number of bytes to allocate.
+ *
+ * @return Allocated memory or NULL.
+ *
+ */
+void *memalign(const size_t align, const size_t size)
+{
+	if (align == 0)
+		return NULL;
+
+	size_t palign =
+	    1 << (fnzb(max(sizeof(void *), align) - 1) + 1);
+
+	return malloc_internal(size, palign);
+}
+
+/** Reallocate memory block
+ *
+ * @param addr Already allocated memory or NULL.
+ * @param size New size of the memory block.
+ *
+ * @return Reallocated memory or NULL.
+ *
+ */
+void *realloc(void *const addr, const size_t size)
+{
+	if (size == 0) {
+		free(addr);
+		return NULL;
+	}
+
+	if (addr == NULL)
+		return malloc(size);
+
+	chunk_t *chunk = chunk_of(addr);
+	arena_t *arena = chunk->arena;
+	size_t orig_size = block_size(chunk, addr);
+
+	switch (chunk->kind) {
+	case CHUNK_SMALL:
+		/* Keep the block unless it becomes much too large. */
+		if ((size <= orig_size) && (size > orig_size / 2))
+			return addr;
+		break;
+	case CHUNK_MEDIUM:
+		if ((size > SMALL_MAX) && (size <= MEDIUM_MAX)) {
+			fibril_rmutex_lock(&arena->lock);
+			bool resized = medium_resize(arena, chunk, addr,
+			    medium_gross(size));
+			fibril_rmutex_unlock(&arena->lock);
+
+			if (resized)
+				return addr;
+		}
+		break;
+	case CHUNK_LARGE:
+		if (size > MEDIUM_MAX) {
+			size_t offset = (uintptr_t) addr - (uintptr_t) chunk;
+
+			/* Check for integer overflow. */
+			if (size > SIZE_MAX - offset - PAGE_SIZE)
+				return NULL;
+
+			size_t asize = ALIGN_UP(offset + size, PAGE_SIZE);
+
+			fibril_rmutex_lock(&arena->lock);
+			errno_t rc = as_area_resize(chunk, asize, 0);
+			if (rc == EOK)
+				chunk->size = asize;
+			fibril_rmutex_unlock(&arena->lock);
+
+			if (rc == EOK)
+				return addr;
+		}
+		break;
+	}
+
+	void *ptr = malloc(size);
+	if (ptr != NULL) {
+		memcpy(ptr, addr, min(orig_size, size));
+		free(addr);
+	}
+
+	return ptr;
+}
+
+/** Free a memory block
+ *
+ * @param addr The address of the block.
+ *
+ */
+void free(void *const addr)
+{
+	if (addr == NULL)
+		return;
+
+	chunk_t *chunk = chunk_of(addr);
+	arena_t *arena = chunk->arena;
+
+	switch (chunk->kind) {
+	case CHUNK_SMALL:
+		fibril_rmutex_lock(&arena->lock);
+		small_free(arena, chunk, addr);
+		fibril_rmutex_unlock(&arena->lock);
+		break;
+	case CHUNK_MEDIUM:
+		fibril_rmutex_lock(&arena->lock);
+		medium_free(arena, chunk, addr);
+		fibril_rmutex_unlock(&arena->lock);
+		break;
+	default:
+		malloc_assert(chunk->kind == CHUNK_LARGE);
+		large_free(chunk);
+		break;
+	}
+}
+
+/** Check the blocks of a medium chunk.
+ *
+ * @return NULL if the chunk is consistent, the address of the first
+ *         corrupted block header otherwise.
+ *
+ */
+static void *medium_check(chunk_t *chunk)
+{
+	size_t prev_size = 0;
+	size_t used = 0;
+	bool prev_free = false;
+
+	for (medium_head_t *head = (medium_head_t *)
+	    ((uintptr_t) chunk + CHUNK_HEADER_SIZE); head != NULL;
+	    head = medium_next(chunk, head)) {
+		size_t size = head->size & ~MEDIUM_USED;
+		bool free = !(head->size & MEDIUM_USED);
+
+		if ((head->prev_size != prev_size) ||
+		    (size < MEDIUM_BLOCK_MIN) || (size % BASE_ALIGN != 0) ||
+		    ((uintptr_t) head + size > (uintptr_t) chunk + CHUNK_SIZE) ||
+		    (free && prev_free))
+			return head;
+
+		if (!free)
+			used++;
+
+		prev_size = size;
+		prev_free = free;
+	}
+
+	if (used != chunk->used)
+		return chunk;
+
+	return NULL;
+}
+
+void *heap_check(void)
+{
+	if (atomic_load_explicit(&arenas[0], memory_order_acquire) == NULL)
+		return (void *) -1;
+
+	for (unsigned i = 0; i < ARENAS; i++) {
+		arena_t *arena = atomic_load_explicit(&arenas[i],
+		    memory_order_acquire);
+		if (arena == NULL)
+			continue;
+
+		void *bad = NULL;
+
+		fibril_rmutex_lock(&arena->lock);
+
+		list_foreach(arena->chunks, chunks_link, chunk_t, chunk) {
+			/* Check chunk consistency */
+			if ((chunk->magic != CHUNK_MAGIC) ||
+			    (chunk->arena != arena) ||
+			    ((uintptr_t) chunk % CHUNK_SIZE != 0)) {
+				bad = chunk;
+				break;
+			}
+
+			if (chunk->kind == CHUNK_MEDIUM) {
+				bad = medium_check(chunk);
+				if (bad != NULL)
+					break;
+			}
+		}
+
+		fibril_rmutex_unlock(&arena->lock);
+
+		if (bad != NULL)
+			return bad;
+	}
+
+	return NULL;
+}
+
+/** @}
+ */
@@ -34,14 +34,37 @@
  */
 
 #include <mem.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <stddef.h>
 #include <stdint.h>
 #include "private/cc.h"
+#include "private/mem.h"
+
+mem_ops_t __mem_ops = {
+	.memcpy = __memcpy_generic,
+	.memset = __memset_generic,
+	.memcmp = __memcmp_generic,
+	.memchr = __memchr_generic,
+	.strlen = __strlen_generic,
+	.strchr = __strchr_generic
+};
+
+/** Select the memory and string routines best suited to this CPU.
+ *
+ * Until this is called (and on architectures without optimized routines)
+ * the portable implementations are used.
+ */
+void __mem_init(void)
+{
+#ifdef LIBARCH_MEM_OPS
+	__mem_arch_init(&__mem_ops);
+#endif
+}
 
-/** Fill memory block with a constant value. */
+/** Fill memory block with a constant value (portable version). */
 ATTRIBUTE_OPTIMIZE_NO_TLDP
-    void *memset(void *dest, int b, size_t n)
+    void *__memset_generic(void *dest, int b, size_t n)
 {
 	char *pb;
 	unsigned long *pw;
@@ -114,9 +137,9 @@ static void *unaligned_memcpy(void *dst, const void *src, size_t n)
 	return (char *) dst;
 }
 
-/** Copy memory block. */
+/** Copy memory block (portable version). */
 ATTRIBUTE_OPTIMIZE_NO_TLDP
-    void *memcpy(void *dst, const void *src, size_t n)
+    void *__memcpy_generic(void *dst, const void *src, size_t n)
 {
 	size_t i;
 	size_t mod, fill;
@@ -192,11 +215,26 @@ ATTRIBUTE_OPTIMIZE_NO_TLDP
 	return dst;
 }
 
+/** Fill memory block with a constant value. */
+void *memset(void *dest, int b, size_t n)
+{
+	return __mem_ops.memset(dest, b, n);
+}
+
+/** Copy memory block. */
+void *memcpy(void *dst, const void *src, size_t n)
+{
+	return __mem_ops.memcpy(dst, src, n);
+}
+
 /** Move memory block with possible overlapping. */
-void *memmove(void *dst, const void *src, size_t n)
+ATTRIBUTE_OPTIMIZE_NO_TLDP
+    void *memmove(void *dst, const void *src, size_t n)
 {
 	const uint8_t *sp;
 	uint8_t *dp;
+	const mem_word_t *sw;
+	mem_word_t *dw;
 
 	/* Nothing to do? */
 	if (src == dst)
@@ -207,26 +245,112 @@ void *memmove(void *dst, const void *src, size_t n)
 		return memcpy(dst, src, n);
 	}
 
+	/*
+	 * When source and destination are congruent modulo word size, the
+	 * bulk can be moved by words. Moving a word in the same direction
+	 * as the bytes is safe since it is read before anything overlapping
+	 * it is written.
+	 */
+	bool words = ((uintptr_t) dst & (sizeof(mem_word_t) - 1)) ==
+	    ((uintptr_t) src & (sizeof(mem_word_t) - 1));
+
 	/* Which direction? */
 	if (src > dst) {
 		/* Forwards. */
 		sp = src;
 		dp = dst;
 
+		if (words) {
+			while (n != 0 && !MEM_WORD_ALIGNED(dp)) {
+				*dp++ = *sp++;
+				n--;
+			}
+
+			sw = (const mem_word_t *) sp;
+			dw = (mem_word_t *) dp;
+			while (n >= sizeof(mem_word_t)) {
+				*dw++ = *sw++;
+				n -= sizeof(mem_word_t);
+			}
+
+			sp = (const uint8_t *) sw;
+			dp = (uint8_t *) dw;
+		}
+
 		while (n-- != 0)
 			*dp++ = *sp++;
 	} else {
 		/* Backwards. */
-		sp = src + (n - 1);
-		dp = dst + (n - 1);
+		sp = src + n;
+		dp = dst + n;
+
+		if (words) {
+			while (n != 0 && !MEM_WORD_ALIGNED(dp)) {
+				*--dp = *--sp;
+				n--;
+			}
+
+			sw = (const mem_word_t *) sp;
+			dw = (mem_word_t *) dp;
+			while (n >= sizeof(mem_word_t)) {
+				*--dw = *--sw;
+				n -= sizeof(mem_word_t);
+			}
+
+			sp = (const uint8_t *) sw;
+			dp = (uint8_t *) dw;
+		}
 
 		while (n-- != 0)
-			*dp-- = *sp--;
+			*--dp = *--sp;
 	}
 
 	return dst;
 }
 
+/** Compare two memory areas (portable version).
+ *
+ * If both areas are congruent modulo word size, whole words are compared
+ * until a difference is found, which is then located byte by byte.
+ */
+int __memcmp_generic(const void *s1, const void *s2, size_t len)
+{
+	const uint8_t *u1 = s1;
+	const uint8_t *u2 = s2;
+
+	while (len != 0 && !MEM_WORD_ALIGNED(u1)) {
+		if (*u1 != *u2)
+			return (int)(*u1) - (int)(*u2);
+		++u1;
+		++u2;
+		--len;
+	}
+
+	if (MEM_WORD_ALIGNED(u2)) {
+		const mem_word_t *w1 = (const mem_word_t *) u1;
+		const mem_word_t *w2 = (const mem_word_t *) u2;
+
+		while (len >= sizeof(mem_word_t) && *w1 == *w2) {
+			++w1;
+			++w2;
+			len -= sizeof(mem_word_t);
+		}
+
+		u1 = (const uint8_t *) w1;
+		u2 = (const uint8_t *) w2;
+	}
+
+	while (len != 0) {
+		if (*u1 != *u2)
+			return (int)(*u1) - (int)(*u2);
+		++u1;
+		++u2;
+		--len;
+	}
+
+	return 0;
+}
+
 /** Compare two memory areas.
  *
  * @param s1  Pointer to the first area to compare.
@@ -240,18 +364,40 @@ void *memmove(void *dst, const void *src, size_t n)
  */
 int memcmp(const void *s1, const void *s2, size_t len)
 {
-	uint8_t *u1 = (uint8_t *) s1;
-	uint8_t *u2 = (uint8_t *) s2;
-	size_t i;
+	return __mem_ops.memcmp(s1, s2, len);
+}
 
-	for (i = 0; i < len; i++) {
-		if (*u1 != *u2)
-			return (int)(*u1) - (int)(*u2);
-		++u1;
-		++u2;
+/** Search memory area (portable version).
+ *
+ * The area is scanned a word at a time. XORing a word with the searched
+ * byte replicated into every byte turns matching bytes into zero bytes.
+ */
+void *__memchr_generic(const void *s, int c, size_t n)
+{
+	const uint8_t *u = s;
+	uint8_t uc = (uint8_t) c;
+
+	while (n != 0 && !MEM_WORD_ALIGNED(u)) {
+		if (*u == uc)
+			return (void *) u;
+		++u;
+		--n;
 	}
 
-	return 0;
+	const mem_word_t *w = (const mem_word_t *) u;
+	unsigned long pattern = MEM_WORD_ONES * uc;
+
+	while (n >= sizeof(mem_word_t) && !MEM_WORD_HAS_ZERO(*w ^ pattern)) {
+		++w;
+		n -= sizeof(mem_word_t);
+	}
+
+	for (u = (const uint8_t *) w; n != 0; ++u, --n) {
+		if (*u == uc)
+			return (void *) u;
+	}
+
+	return NULL;
 }
 
 /** Search memory area.
@@ -265,16 +411,7 @@ int memcmp(const void *s1, const void *s2, size_t len)
  */
 void *memchr(const void *s, int c, size_t n)
 {
-	uint8_t *u = (uint8_t *) s;
-	unsigned char uc = (unsigned char) c;
-	size_t i;
-
-	for (i = 0; i < n; i++) {
-		if (u[i] == uc)
-			return (void *) &u[i];
-	}
-
-	return NULL;
+	return __mem_ops.memchr(s, c, n);
 }
 
 /** @}
@@ -62,6 +62,18 @@ struct fibril {
 
 	fibril_t *thread_ctx;
 
+	/*
+	 * Fibril we switched from and the type of that switch. The switch
+	 * is finished in this fibril, once the other one's context is saved.
+	 */
+	fibril_t *switched_from;
+	int switch_type;
+
+	/* Ready list of the thread, only meaningful in helper fibrils. */
+	int runner;
+	/* Preferred runner plus one, zero if the fibril has no preference. */
+	int affinity;
+
 	bool is_running : 1;
 	bool is_writer : 1;
 	/* In some places, we use fibril structs that can't be freed. */
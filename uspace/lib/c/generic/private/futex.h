@@ -140,8 +140,9 @@ static inline errno_t futex_down_composable(futex_t *futex,
 		} else {
 			struct timespec tv;
 			getuptime(&tv);
+			/* Round up, zero would mean no timeout at all. */
 			timeout = ts_gteq(&tv, expires) ? 1 :
-			    NSEC2USEC(ts_sub_diff(expires, &tv));
+			    NSEC2USEC(ts_sub_diff(expires, &tv) + 999);
 		}
 
 		assert(timeout > 0);
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup libc
+ * @{
+ */
+/** @file
+ */
+
+#ifndef _LIBC_PRIVATE_MEM_H_
+#define _LIBC_PRIVATE_MEM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <libarch/config.h>
+
+/*
+ * Word-at-a-time helpers. A word is searched for a zero byte with the usual
+ * (w - 0x01..01) & ~w & 0x80..80 trick, which is exact as to whether there
+ * is a zero byte, but not as to which one it is on big-endian machines, so
+ * callers locate the byte with a plain loop.
+ */
+typedef unsigned long __attribute__((may_alias)) mem_word_t;
+
+#define MEM_WORD_ONES  ((unsigned long) -1 / 0xff)
+#define MEM_WORD_HIGHS (MEM_WORD_ONES << 7)
+
+#define MEM_WORD_HAS_ZERO(w) \
+	(((w) - MEM_WORD_ONES) & ~(w) & MEM_WORD_HIGHS)
+
+#define MEM_WORD_ALIGNED(p) \
+	(((uintptr_t) (p) & (sizeof(mem_word_t) - 1)) == 0)
+
+/** Implementations of the performance critical memory and string routines.
+ *
+ * The public functions dispatch through this table. It starts out pointing
+ * to the portable word-at-a-time implementations and architectures that
+ * define LIBARCH_MEM_OPS can replace its entries with vectorized ones once
+ * the CPU features are known.
+ */
+typedef struct {
+	void *(*memcpy)(void *, const void *, size_t);
+	void *(*memset)(void *, int, size_t);
+	int (*memcmp)(const void *, const void *, size_t);
+	void *(*memchr)(const void *, int, size_t);
+	size_t (*strlen)(const char *);
+	char *(*strchr)(const char *, int);
+} mem_ops_t;
+
+extern mem_ops_t __mem_ops;
+
+extern void __mem_init(void);
+
+extern void *__memcpy_generic(void *, const void *, size_t);
+extern void *__memset_generic(void *, int, size_t);
+extern int __memcmp_generic(const void *, const void *, size_t);
+extern void *__memchr_generic(const void *, int, size_t);
+extern size_t __strlen_generic(const char *);
+extern char *__strchr_generic(const char *, int);
+
+#ifdef LIBARCH_MEM_OPS
+extern void __mem_arch_init(mem_ops_t *);
+#endif
+
+#endif
+
+/** @}
+ */
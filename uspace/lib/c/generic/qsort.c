@@ -33,20 +33,13 @@
 /**
  * @file
  * @brief Quicksort.
+ *
+ * The sorting itself is done by the introsort in sort.c.
  */
 
 #include <qsort.h>
-#include <stdbool.h>
 #include <stddef.h>
-
-/** Quicksort spec */
-typedef struct {
-	void *base;
-	size_t nmemb;
-	size_t size;
-	int (*compar)(const void *, const void *, void *);
-	void *arg;
-} qs_spec_t;
+#include "private/sort.h"
 
 /** Comparison function wrapper.
  *
@@ -64,103 +57,6 @@ static int compar_wrap(const void *a, const void *b, void *arg)
 	return compar(a, b);
 }
 
-/** Determine if one element is less-than another element.
- *
- * @param qs Quicksort spec
- * @param i First element index
- * @param j Second element index
- */
-static bool elem_lt(qs_spec_t *qs, size_t i, size_t j)
-{
-	const void *a;
-	const void *b;
-	int r;
-
-	a = qs->base + i * qs->size;
-	b = qs->base + j * qs->size;
-
-	r = qs->compar(a, b, qs->arg);
-
-	return r < 0;
-}
-
-/** Swap two elements.
- *
- * @param qs Quicksort spec
- * @param i First element index
- * @param j Second element index
- */
-static void elem_swap(qs_spec_t *qs, size_t i, size_t j)
-{
-	char *a;
-	char *b;
-	char t;
-	size_t k;
-
-	a = qs->base + i * qs->size;
-	b = qs->base + j * qs->size;
-
-	for (k = 0; k < qs->size; k++) {
-		t = a[k];
-		a[k] = b[k];
-		b[k] = t;
-	}
-}
-
-/** Partition a range of indices.
- *
- * @param qs Quicksort spec
- * @param lo Lower bound (inclusive)
- * @param hi Upper bound (inclusive)
- * @return Pivot index
- */
-static size_t partition(qs_spec_t *qs, size_t lo, size_t hi)
-{
-	size_t pivot;
-	size_t i, j;
-
-	pivot = lo + (hi - lo) / 2;
-	i = lo;
-	j = hi;
-	while (true) {
-		while (elem_lt(qs, i, pivot))
-			++i;
-		while (elem_lt(qs, pivot, j))
-			--j;
-
-		if (i >= j)
-			return j;
-
-		elem_swap(qs, i, j);
-
-		/* Need to follow pivot movement */
-		if (i == pivot)
-			pivot = j;
-		else if (j == pivot)
-			pivot = i;
-
-		i++;
-		j--;
-	}
-}
-
-/** Sort a range of indices.
- *
- * @param qs Quicksort spec
- * @param lo Lower bound (inclusive)
- * @param hi Upper bound (inclusive)
- */
-static void quicksort(qs_spec_t *qs, size_t lo, size_t hi)
-{
-	size_t p;
-
-	if (lo < hi) {
-		p = partition(qs, lo, hi);
-		quicksort(qs, lo, p);
-		quicksort(qs, p + 1, hi);
-	}
-}
-
 /** Quicksort.
  *
  * @param base Array to sort
@@ -171,18 +67,7 @@ static void quicksort(qs_spec_t *qs, size_t lo, size_t hi)
 void qsort(void *base, size_t nmemb, size_t size, int (*compar)(const void *,
     const void *))
 {
-	qs_spec_t qs;
-
-	if (nmemb == 0)
-		return;
-
-	qs.base = base;
-	qs.nmemb = nmemb;
-	qs.size = size;
-	qs.compar = compar_wrap;
-	qs.arg = compar;
-
-	quicksort(&qs, 0, nmemb - 1);
+	__sort(base, nmemb, size, compar_wrap, compar);
 }
 
 /** Quicksort with extra argument to comparison function.
@@ -196,18 +81,7 @@ void qsort(void *base, size_t nmemb, size_t size, int (*compar)(const void *,
 void qsort_r(void *base, size_t nmemb, size_t size, int (*compar)(const void *,
     const void *, void *), void *arg)
 {
-	qs_spec_t qs;
-
-	if (nmemb == 0)
-		return;
-
-	qs.base = base;
-	qs.nmemb = nmemb;
-	qs.size = size;
-	qs.compar = compar;
-	qs.arg = arg;
-
-	quicksort(&qs, 0, nmemb - 1);
+	__sort(base, nmemb, size, compar, arg);
 }
 
 /** @}
@@ -0,0 +1,453 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup libc
+ * @{
+ */
+
+/**
+ * @file
+ * @brief Sorting engine shared by qsort() and gsort().
+ *
+ * __sort() is an introsort: a quicksort with median-of-three pivots that
+ * finishes small partitions with insertion sort and falls back to heapsort
+ * when the recursion gets too deep, which bounds the worst case by
+ * O(n log n).
+ *
+ * __sort_stable() is an in-place merge sort (insertion sorted blocks merged
+ * with the SymMerge algorithm by Kim and Kutzner). It needs no extra memory
+ * and does O(n log n) comparisons and O(n log^2 n) swaps.
+ *
+ * Elements are only ever moved by swapping. Swapping of 4, 8 and 16 byte
+ * elements (and of elements made of whole words) is done with wide loads
+ * and stores instead of byte by byte.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "private/sort.h"
+
+/** Partitions up to this size are sorted by insertion sort. */
+#define INSERTION_SORT_MAX  16
+
+/** Size of blocks sorted by insertion sort before merging. */
+#define MERGE_BLOCK  20
+
+typedef uint32_t __attribute__((may_alias)) u32_alias_t;
+typedef uint64_t __attribute__((may_alias)) u64_alias_t;
+typedef unsigned long __attribute__((may_alias)) word_alias_t;
+
+typedef enum {
+	swap_bytes,
+	swap_words,
+	swap_4,
+	swap_8,
+	swap_16
+} swap_type_t;
+
+/** Sort spec */
+typedef struct {
+	char *base;
+	size_t size;
+	swap_type_t swap;
+	__sort_cmp_t cmp;
+	void *arg;
+} sort_spec_t;
+
+static void sort_spec_init(sort_spec_t *s, void *base, size_t size,
+    __sort_cmp_t cmp, void *arg)
+{
+	/* Every element is aligned at least as well as this. */
+	uintptr_t align = (uintptr_t) base | size;
+
+	s->base = base;
+	s->size = size;
+	s->cmp = cmp;
+	s->arg = arg;
+
+	if (size == 4 && (align & (__alignof__(uint32_t) - 1)) == 0)
+		s->swap = swap_4;
+	else if (size == 8 && (align & (__alignof__(uint64_t) - 1)) == 0)
+		s->swap = swap_8;
+	else if (size == 16 && (align & (__alignof__(uint64_t) - 1)) == 0)
+		s->swap = swap_16;
+	else if ((align & (sizeof(unsigned long) - 1)) == 0)
+		s->swap = swap_words;
+	else
+		s->swap = swap_bytes;
+}
+
+/** Address of element with index @a i */
+static inline char *elem(sort_spec_t *s, size_t i)
+{
+	return s->base + i * s->size;
+}
+
+static inline bool elem_lt(sort_spec_t *s, const void *a, const void *b)
+{
+	return s->cmp(a, b, s->arg) < 0;
+}
+
+static inline void elem_swap(sort_spec_t *s, void *a, void *b)
+{
+	switch (s->swap) {
+	case swap_4: {
+		uint32_t t = *(u32_alias_t *) a;
+		*(u32_alias_t *) a = *(u32_alias_t *) b;
+		*(u32_alias_t *) b = t;
+		break;
+	}
+	case swap_16: {
+		uint64_t t = ((u64_alias_t *) a)[1];
+		((u64_alias_t *) a)[1] = ((u64_alias_t *) b)[1];
+		((u64_alias_t *) b)[1] = t;
+	}
+		/* Fallthrough */
+	case swap_8: {
+		uint64_t t = *(u64_alias_t *) a;
+		*(u64_alias_t *) a = *(u64_alias_t *) b;
+		*(u64_alias_t *) b = t;
+		break;
+	}
+	case swap_words: {
+		word_alias_t *wa = a;
+		word_alias_t *wb = b;
+
+		for (size_t k = 0; k < s->size / sizeof(unsigned long); k++) {
+			unsigned long t = wa[k];
+			wa[k] = wb[k];
+			wb[k] = t;
+		}
+		break;
+	}
+	case swap_bytes: {
+		char *ca = a;
+		char *cb = b;
+
+		for (size_t k = 0; k < s->size; k++) {
+			char t = ca[k];
+			ca[k] = cb[k];
+			cb[k] = t;
+		}
+		break;
+	}
+	}
+}
+
+/** Sort elements [lo, hi) by (stable) insertion sort. */
+static void insertion_sort(sort_spec_t *s, size_t lo, size_t hi)
+{
+	for (size_t i = lo + 1; i < hi; i++) {
+		for (size_t j = i; j > lo; j--) {
+			char *a = elem(s, j - 1);
+			char *b = elem(s, j);
+
+			if (!elem_lt(s, b, a))
+				break;
+			elem_swap(s, a, b);
+		}
+	}
+}
+
+/** Restore heap property of the heap [lo, lo + n) at @a root. */
+static void sift_down(sort_spec_t *s, size_t lo, size_t root, size_t n)
+{
+	while (true) {
+		size_t child = 2 * root + 1;
+		if (child >= n)
+			return;
+
+		if (child + 1 < n &&
+		    elem_lt(s, elem(s, lo + child), elem(s, lo + child + 1)))
+			child++;
+
+		if (!elem_lt(s, elem(s, lo + root), elem(s, lo + child)))
+			return;
+
+		elem_swap(s, elem(s, lo + root), elem(s, lo + child));
+		root = child;
+	}
+}
+
+/** Sort elements [lo, lo + n) by heapsort. */
+static void heap_sort(sort_spec_t *s, size_t lo, size_t n)
+{
+	for (size_t i = n / 2; i-- > 0; )
+		sift_down(s, lo, i, n);
+
+	for (size_t end = n - 1; end > 0; end--) {
+		elem_swap(s, elem(s, lo), elem(s, lo + end));
+		sift_down(s, lo, 0, end);
+	}
+}
+
+/** Order three elements. */
+static void sort3(sort_spec_t *s, char *a, char *b, char *c)
+{
+	if (elem_lt(s, b, a))
+		elem_swap(s, a, b);
+
+	if (elem_lt(s, c, b)) {
+		elem_swap(s, b, c);
+		if (elem_lt(s, b, a))
+			elem_swap(s, a, b);
+	}
+}
+
+/** Sort elements [lo, lo + n) by introsort.
+ *
+ * @param s     Sort spec
+ * @param lo    Index of the first element
+ * @param n     Number of elements
+ * @param depth Number of partitioning levels left before switching
+ *              to heapsort
+ */
+static void introsort(sort_spec_t *s, size_t lo, size_t n, unsigned depth)
+{
+	while (n > INSERTION_SORT_MAX) {
+		if (depth == 0) {
+			heap_sort(s, lo, n);
+			return;
+		}
+
+		depth--;
+
+		/*
+		 * Put the median of the first, middle and last element to the
+		 * front as the pivot. The last element is then not less than
+		 * the pivot and the pivot not less than itself, which stops
+		 * both scans below without bound checks.
+		 */
+		char *pivot = elem(s, lo);
+		sort3(s, pivot, elem(s, lo + n / 2), elem(s, lo + n - 1));
+		elem_swap(s, pivot, elem(s, lo + n / 2));
+
+		size_t i = lo;
+		size_t j = lo + n;
+
+		while (true) {
+			do {
+				i++;
+			} while (elem_lt(s, elem(s, i), pivot));
+
+			do {
+				j--;
+			} while (elem_lt(s, pivot, elem(s, j)));
+
+			if (i >= j)
+				break;
+
+			elem_swap(s, elem(s, i), elem(s, j));
+		}
+
+		elem_swap(s, pivot, elem(s, j));
+
+		/* Recurse into the smaller part, iterate on the larger one. */
+		size_t nl = j - lo;
+		size_t nr = n - nl - 1;
+
+		if (nl < nr) {
+			introsort(s, lo, nl, depth);
+			lo = j + 1;
+			n = nr;
+		} else {
+			introsort(s, j + 1, nr, depth);
+			n = nl;
+		}
+	}
+
+	insertion_sort(s, lo, lo + n);
+}
+
+/** Sort an array (not stable).
+ *
+ * @param base Array to sort
+ * @param nmemb Number of array members
+ * @param size Size of member in bytes
+ * @param cmp Comparison function
+ * @param arg Argument to comparison function
+ */
+void __sort(void *base, size_t nmemb, size_t size, __sort_cmp_t cmp,
+    void *arg)
+{
+	sort_spec_t s;
+	unsigned depth = 0;
+
+	if (nmemb < 2 || size == 0)
+		return;
+
+	sort_spec_init(&s, base, size, cmp, arg);
+
+	/* Allow 2 * log2(nmemb) levels of partitioning. */
+	for (size_t n = nmemb; n > 1; n >>= 1)
+		depth += 2;
+
+	introsort(&s, 0, nmemb, depth);
+}
+
+/** Swap elements [a, a + n) with [b, b + n). */
+static void swap_range(sort_spec_t *s, size_t a, size_t b, size_t n)
+{
+	for (size_t i = 0; i < n; i++)
+		elem_swap(s, elem(s, a + i), elem(s, b + i));
+}
+
+/** Rotate elements [a, b) so that the element at @a m comes first. */
+static void rotate(sort_spec_t *s, size_t a, size_t m, size_t b)
+{
+	size_t i = m - a;
+	size_t j = b - m;
+
+	while (i != j) {
+		if (i > j) {
+			swap_range(s, m - i, m, j);
+			i -= j;
+		} else {
+			swap_range(s, m - i, m + j - i, i);
+			j -= i;
+		}
+	}
+
+	swap_range(s, m - i, m, i);
+}
+
+/** Merge sorted runs [a, m) and [m, b) in place, keeping it stable.
+ *
+ * This is the SymMerge algorithm from P. Kim and A. Kutzner, "Stable
+ * Minimum Storage Merging by Symmetric Comparisons", ESA 2004.
+ */
+static void sym_merge(sort_spec_t *s, size_t a, size_t m, size_t b)
+{
+	size_t i, j, h;
+
+	if (m - a == 1) {
+		/* Insert the single element at a into [m, b). */
+		i = m;
+		j = b;
+		while (i < j) {
+			h = i + (j - i) / 2;
+			if (elem_lt(s, elem(s, h), elem(s, a)))
+				i = h + 1;
+			else
+				j = h;
+		}
+
+		for (size_t k = a; k + 1 < i; k++)
+			elem_swap(s, elem(s, k), elem(s, k + 1));
+		return;
+	}
+
+	if (b - m == 1) {
+		/* Insert the single element at m into [a, m). */
+		i = a;
+		j = m;
+		while (i < j) {
+			h = i + (j - i) / 2;
+			if (!elem_lt(s, elem(s, m), elem(s, h)))
+				i = h + 1;
+			else
+				j = h;
+		}
+
+		for (size_t k = m; k > i; k--)
+			elem_swap(s, elem(s, k), elem(s, k - 1));
+		return;
+	}
+
+	size_t mid = a + (b - a) / 2;
+	size_t n = mid + m;
+	size_t start, r;
+
+	if (m > mid) {
+		start = n - b;
+		r = mid;
+	} else {
+		start = a;
+		r = m;
+	}
+
+	size_t p = n - 1;
+	while (start < r) {
+		size_t c = start + (r - start) / 2;
+		if (!elem_lt(s, elem(s, p - c), elem(s, c)))
+			start = c + 1;
+		else
+			r = c;
+	}
+
+	size_t end = n - start;
+	if (start < m && m < end)
+		rotate(s, start, m, end);
+	if (a < start && start < mid)
+		sym_merge(s, a, start, mid);
+	if (mid < end && end < b)
+		sym_merge(s, mid, end, b);
+}
+
+/** Merge sorted runs [a, m) and [m, b) unless they are in order already. */
+static void merge(sort_spec_t *s, size_t a, size_t m, size_t b)
+{
+	if (elem_lt(s, elem(s, m), elem(s, m - 1)))
+		sym_merge(s, a, m, b);
+}
+
+/** Sort an array, keeping equal elements in their original order.
+ *
+ * @param base Array to sort
+ * @param nmemb Number of array members
+ * @param size Size of member in bytes
+ * @param cmp Comparison function
+ * @param arg Argument to comparison function
+ */
+void __sort_stable(void *base, size_t nmemb, size_t size, __sort_cmp_t cmp,
+    void *arg)
+{
+	sort_spec_t s;
+	size_t a;
+
+	if (nmemb < 2 || size == 0)
+		return;
+
+	sort_spec_init(&s, base, size, cmp, arg);
+
+	for (a = 0; a + MERGE_BLOCK < nmemb; a += MERGE_BLOCK)
+		insertion_sort(&s, a, a + MERGE_BLOCK);
+	insertion_sort(&s, a, nmemb);
+
+	for (size_t block = MERGE_BLOCK; block < nmemb; block *= 2) {
+		for (a = 0; a + 2 * block <= nmemb; a += 2 * block)
+			merge(&s, a, a + block, a + 2 * block);
+
+		if (a + block < nmemb)
+			merge(&s, a, a + block, nmemb);
+	}
+}
+
+/** @}
+ */
@@ -104,6 +104,32 @@ stats_physmem_t *stats_get_physmem(void)
 	return stats_physmem;
 }
 
+/** Get slab cache statistics
+ *
+ * @param count Number of records returned.
+ *
+ * @return Array of stats_slab_t structures.
+ *         If non-NULL then it should be eventually freed
+ *         by free().
+ *
+ */
+stats_slab_t *stats_get_slabs(size_t *count)
+{
+	size_t size = 0;
+	stats_slab_t *stats_slabs =
+	    (stats_slab_t *) sysinfo_get_data("system.slabs", &size);
+
+	if ((size % sizeof(stats_slab_t)) != 0) {
+		if (stats_slabs != NULL)
+			free(stats_slabs);
+		*count = 0;
+		return NULL;
+	}
+
+	*count = size / sizeof(stats_slab_t);
+	return stats_slabs;
+}
+
 /** Get task statistics
  *
  * @param count Number of records returned.
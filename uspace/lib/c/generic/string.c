@@ -37,6 +37,7 @@
 #include <stdlib.h>
 #include <str_error.h>
 #include <string.h>
+#include "private/mem.h"
 
 /** Copy string.
  *
@@ -244,6 +245,31 @@ size_t strxfrm(char *s1, const char *s2, size_t n)
  */
 char *strchr(const char *s, int c)
 {
+	return __mem_ops.strchr(s, c);
+}
+
+/** Find the first occurrence of a character in a string (portable version).
+ *
+ * Once the string is word aligned, it is scanned a word at a time for
+ * either a null byte or the character. Aligned words never straddle a page
+ * boundary, so reading past the terminator cannot fault.
+ */
+char *__strchr_generic(const char *s, int c)
+{
+	while (!MEM_WORD_ALIGNED(s)) {
+		if (*s == (char) c)
+			return (char *) s;
+		if (*s++ == '\0')
+			return NULL;
+	}
+
+	const mem_word_t *w = (const mem_word_t *) s;
+	unsigned long pattern = MEM_WORD_ONES * (uint8_t) c;
+
+	while (!MEM_WORD_HAS_ZERO(*w) && !MEM_WORD_HAS_ZERO(*w ^ pattern))
+		++w;
+
+	s = (const char *) w;
 	do {
 		if (*s == (char) c)
 			return (char *) s;
@@ -378,14 +404,19 @@ char *strstr(const char *s1, const char *s2)
 	size_t len;
 
 	/*
-	 * Naive search algorithm.
+	 * Naive search algorithm, but candidate positions are found with
+	 * strchr(), which skips over the haystack a word (or vector) at
+	 * a time.
 	 *
 	 * Two-Way String-Matching might be a plausible alternative
 	 * for larger haystack+needle combinations.
 	 */
 
+	if (*s2 == '\0')
+		return (char *) s1;
+
 	len = strlen(s2);
-	while (*s1 != '\0') {
+	while ((s1 = strchr(s1, *s2)) != NULL) {
 		if (strncmp(s1, s2, len) == 0)
 			return (char *) s1;
 		++s1;
@@ -490,15 +521,32 @@ char *strerror(int errnum)
  */
 size_t strlen(const char *s)
 {
-	size_t n;
+	return __mem_ops.strlen(s);
+}
 
-	n = 0;
-	while (*s != '\0') {
-		++s;
-		++n;
+/** Return number of characters in string (portable version).
+ *
+ * The string is scanned a word at a time once it is word aligned.
+ */
+size_t __strlen_generic(const char *s)
+{
+	const char *p = s;
+
+	while (!MEM_WORD_ALIGNED(p)) {
+		if (*p == '\0')
+			return p - s;
+		++p;
 	}
 
-	return n;
+	const mem_word_t *w = (const mem_word_t *) p;
+	while (!MEM_WORD_HAS_ZERO(*w))
+		++w;
+
+	p = (const char *) w;
+	while (*p != '\0')
+		++p;
+
+	return p - s;
 }
 
 /** Return number of characters in string with length limit.
@@ -509,15 +557,9 @@ size_t strlen(const char *s)
  */
 size_t strnlen(const char *s, size_t maxlen)
 {
-	size_t n;
+	const char *end = memchr(s, '\0', maxlen);
 
-	n = 0;
-	while (n < maxlen && *s != '\0') {
-		++s;
-		++n;
-	}
-
-	return n;
+	return end != NULL ? (size_t) (end - s) : maxlen;
 }
 
 /** Allocate a new duplicate of string.
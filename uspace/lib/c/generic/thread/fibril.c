@@ -46,6 +46,7 @@
 #include <mem.h>
 #include <str.h>
 #include <ipc/ipc.h>
+#include <sysinfo.h>
 #include <libarch/faddr.h>
 
 #include "../private/thread.h"
@@ -56,11 +57,14 @@
 #define DPRINTF(...) ((void)0)
 #undef READY_DEBUG
 
-/** Member of timeout_list. */
+/** Member of the timeout wheel. */
 typedef struct {
 	link_t link;
 	struct timespec expires;
 	fibril_event_t *event;
+	/* Position in the wheel. */
+	uint8_t level;
+	uint8_t slot;
 } _timeout_t;
 
 typedef struct {
@@ -83,6 +87,33 @@ typedef enum {
 	SWITCH_FROM_BLOCKED,
 } _switch_type_t;
 
+/** Maximum number of separate ready lists. */
+#define RUNNERS_MAX  64
+
+/**
+ * Every RUNNER_STEAL_PERIOD-th pop looks at the other ready lists before
+ * the runner's own one, so that fibrils left on the list of a busy or
+ * exited thread cannot starve.
+ */
+#define RUNNER_STEAL_PERIOD  61
+
+/**
+ * Ready list of one runner.
+ *
+ * Every thread running fibrils has a ready list of its own, which is where
+ * it puts fibrils it makes ready. A thread takes fibrils from its own list
+ * first and steals from the other lists when its own list is empty.
+ * If more than RUNNERS_MAX threads ever run fibrils, some lists are shared.
+ */
+typedef struct {
+	futex_t lock;
+	list_t ready;
+	/* Number of fibrils in the list, readable without the lock. */
+	atomic_size_t count;
+	atomic_uint pops;
+	atomic_bool active;
+} _runner_t;
+
 static bool multithreaded = false;
 
 /* This futex serializes access to global data. */
@@ -90,9 +121,36 @@ static futex_t fibril_futex;
 static futex_t ready_semaphore;
 static long ready_st_count;
 
-static LIST_INITIALIZE(ready_list);
+/* List 0 belongs to the main thread and to threads without a helper. */
+static _runner_t runners[RUNNERS_MAX];
+static atomic_int runners_used = 1;
+static thread_id_t main_thread_id;
+
 static LIST_INITIALIZE(fibril_list);
-static LIST_INITIALIZE(timeout_list);
+
+/*
+ * Pending timeouts are kept in a hierarchical timer wheel, so that arming
+ * and cancelling a timeout takes constant time, no matter how many other
+ * timeouts are pending.
+ *
+ * A slot on level L spans 2^(WHEEL_BITS * L) ticks, all slots of a level
+ * span one slot of the level above. A timeout is put on the lowest level
+ * whose slots cover its expiration within the current slot of the level
+ * above. Once the wheel reaches the slot of a timeout on level L > 0, the
+ * timeout is moved down, until it expires from a slot on level 0.
+ * Timeouts beyond the range of the top level wait in one of its slots
+ * and move down when the wheel gets there.
+ */
+#define WHEEL_TICK_SHIFT  20  /* One tick is 2^20 ns, about a millisecond. */
+#define WHEEL_BITS        6
+#define WHEEL_SLOTS       (1 << WHEEL_BITS)
+#define WHEEL_LEVELS      4
+
+static list_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+/* Bitmaps of non-empty slots. */
+static uint64_t wheel_occupied[WHEEL_LEVELS];
+/* First tick whose timeouts have not all fired yet. */
+static uint64_t wheel_tick;
 
 static futex_t ipc_lists_futex;
 static LIST_INITIALIZE(ipc_waiter_list);
@@ -110,8 +168,9 @@ static inline void _ready_debug_check(void)
 {
 #ifdef READY_DEBUG
 	assert(!multithreaded);
-	long count = (long) list_count(&ready_list) +
-	    (long) list_count(&ipc_buffer_free_list);
+	long count = (long) list_count(&ipc_buffer_free_list);
+	for (int i = 0; i < RUNNERS_MAX; i++)
+		count += (long) atomic_load(&runners[i].count);
 	assert(ready_st_count == count);
 #endif
 }
@@ -138,6 +197,152 @@ static inline errno_t _ready_down(const struct timespec *expires)
 
 static atomic_int threads_in_ipc_wait;
 
+static errno_t _runner_init(_runner_t *r)
+{
+	errno_t rc = futex_initialize(&r->lock, 1);
+	if (rc != EOK)
+		return rc;
+
+	list_initialize(&r->ready);
+	atomic_store_explicit(&r->active, true, memory_order_release);
+	return EOK;
+}
+
+/** Assign a ready list to a new thread. */
+static int _runner_register(void)
+{
+	if (thread_get_id() == main_thread_id)
+		return 0;
+
+	int id = atomic_fetch_add_explicit(&runners_used, 1,
+	    memory_order_relaxed);
+	if (id >= RUNNERS_MAX) {
+		/* Share a list with an older thread. */
+		id %= RUNNERS_MAX;
+	} else if (_runner_init(&runners[id]) != EOK) {
+		return 0;
+	}
+
+	if (!atomic_load_explicit(&runners[id].active, memory_order_acquire))
+		return 0;
+
+	return id;
+}
+
+static inline int _runner_count(void)
+{
+	int n = atomic_load_explicit(&runners_used, memory_order_relaxed);
+	return (n < RUNNERS_MAX) ? n : RUNNERS_MAX;
+}
+
+/** @return ready list of the running thread. */
+static inline _runner_t *_runner_self(void)
+{
+	fibril_t *helper = fibril_self()->thread_ctx;
+	return &runners[helper ? helper->runner : 0];
+}
+
+static fibril_t *_runner_pop(_runner_t *r)
+{
+	if (!atomic_load_explicit(&r->active, memory_order_acquire))
+		return NULL;
+
+	/* Pairs with the increment in _ready_list_push(). */
+	if (atomic_load_explicit(&r->count, memory_order_seq_cst) == 0)
+		return NULL;
+
+	futex_lock(&r->lock);
+	fibril_t *f = list_pop(&r->ready, fibril_t, link);
+	if (f)
+		atomic_fetch_sub_explicit(&r->count, 1, memory_order_relaxed);
+	futex_unlock(&r->lock);
+	return f;
+}
+
+/**
+ * Take a ready fibril, preferably from the ready list of the running thread.
+ * Only called with a token from ready_semaphore, so the fibril we are
+ * looking for is usually there, but we might have to look on other lists.
+ */
+static fibril_t *_ready_take(void)
+{
+	_runner_t *self = _runner_self();
+	fibril_t *f;
+
+	unsigned pops = atomic_fetch_add_explicit(&self->pops, 1,
+	    memory_order_relaxed);
+	bool own_first = (pops % RUNNER_STEAL_PERIOD) != 0;
+
+	if (own_first) {
+		f = _runner_pop(self);
+		if (f)
+			return f;
+	}
+
+	int n = _runner_count();
+	int id = self - runners;
+
+	for (int i = 1; i <= n; i++) {
+		_runner_t *victim = &runners[(id + i) % n];
+		if (victim == self && own_first)
+			continue;
+
+		f = _runner_pop(victim);
+		if (f)
+			return f;
+	}
+
+	return NULL;
+}
+
+/**
+ * Clean up after a dead fibril from which we restored context, if any.
+ * Called after a switch is made.
+ */
+static void _fibril_cleanup_dead(void)
+{
+	fibril_t *srcf = fibril_self();
+	if (!srcf->clean_after_me)
+		return;
+
+	void *stack = srcf->clean_after_me->stack;
+	assert(stack);
+	as_area_destroy(stack);
+	fibril_teardown(srcf->clean_after_me);
+	srcf->clean_after_me = NULL;
+}
+
+static void _ready_list_push(fibril_t *);
+
+/**
+ * Finish a switch in the fibril switched to.
+ *
+ * The fibril we switched from must not be run by another thread before
+ * context_swap() saves its context, so it is only made ready here.
+ * A blocked fibril is protected by fibril_futex, which is held across
+ * the switch and unlocked here.
+ */
+static void _fibril_switch_finish(void)
+{
+	fibril_t *self = fibril_self();
+	fibril_t *prev = self->switched_from;
+	self->switched_from = NULL;
+
+	switch ((_switch_type_t) self->switch_type) {
+	case SWITCH_FROM_YIELD:
+		_ready_list_push(prev);
+		break;
+	case SWITCH_FROM_BLOCKED:
+		futex_unlock(&fibril_futex);
+		break;
+	case SWITCH_FROM_DEAD:
+		_fibril_cleanup_dead();
+		break;
+	case SWITCH_FROM_HELPER:
+		break;
+	}
+}
+
 /** Function that spans the whole life-cycle of a fibril.
  *
  * Each fibril begins execution in this function. Then the function implementing
@@ -147,8 +352,7 @@ static atomic_int threads_in_ipc_wait;
  */
 static void _fibril_main(void)
 {
-	/* fibril_futex is locked when a fibril is started. */
-	futex_unlock(&fibril_futex);
+	_fibril_switch_finish();
 
 	fibril_t *fibril = fibril_self();
 
@@ -251,7 +455,8 @@ static errno_t _ipc_wait(ipc_call_t *call, const struct timespec *expires)
 	if (ts_gteq(&now, expires))
 		return ipc_wait(call, SYNCH_NO_TIMEOUT, SYNCH_FLAGS_NON_BLOCKING);
 
-	return ipc_wait(call, NSEC2USEC(ts_sub_diff(expires, &now)),
+	/* Round up, zero would mean no timeout at all. */
+	return ipc_wait(call, NSEC2USEC(ts_sub_diff(expires, &now) + 999),
 	    SYNCH_FLAGS_NONE);
 }
 
@@ -282,14 +487,21 @@ static fibril_t *_ready_list_pop(const struct timespec *expires, bool locked)
 	 * for each entry of the call buffer.
 	 */
 
-	if (!locked)
-		futex_lock(&fibril_futex);
-	fibril_t *f = list_pop(&ready_list, fibril_t, link);
-	if (!f)
+	fibril_t *f = _ready_take();
+	if (!f) {
 		atomic_fetch_add_explicit(&threads_in_ipc_wait, 1,
-		    memory_order_relaxed);
-	if (!locked)
-		futex_unlock(&fibril_futex);
+		    memory_order_seq_cst);
+
+		/*
+		 * A fibril might have been made ready after we looked, by
+		 * a thread that did not see us waiting for IPC yet.
+		 */
+		f = _ready_take();
+		if (f) {
+			atomic_fetch_sub_explicit(&threads_in_ipc_wait, 1,
+			    memory_order_relaxed);
+		}
+	}
 
 	if (f)
 		return f;
@@ -364,13 +576,23 @@ static void _ready_list_push(fibril_t *f)
 	if (!f)
 		return;
 
-	futex_assert_is_locked(&fibril_futex);
+	_runner_t *r = NULL;
+	if (f->affinity > 0) {
+		r = &runners[(f->affinity - 1) % RUNNERS_MAX];
+		if (!atomic_load_explicit(&r->active, memory_order_acquire))
+			r = NULL;
+	}
+	if (!r)
+		r = _runner_self();
 
-	/* Enqueue in ready_list. */
-	list_append(&f->link, &ready_list);
+	futex_lock(&r->lock);
+	list_append(&f->link, &r->ready);
+	atomic_fetch_add_explicit(&r->count, 1, memory_order_seq_cst);
+	futex_unlock(&r->lock);
 	_ready_up();
 
-	if (atomic_load_explicit(&threads_in_ipc_wait, memory_order_relaxed)) {
+	/* Pairs with the increment in _ready_list_pop(). */
+	if (atomic_load_explicit(&threads_in_ipc_wait, memory_order_seq_cst)) {
 		DPRINTF("Poking.\n");
 		/* Wakeup one thread sleeping in SYS_IPC_WAIT. */
 		ipc_poke();
@@ -414,49 +636,188 @@ static errno_t _wait_ipc(ipc_call_t *call, const struct timespec *expires)
 	return rc;
 }
 
+static uint64_t _ts_to_tick(const struct timespec *ts)
+{
+	if (ts->tv_sec < 0)
+		return 0;
+
+	if ((uint64_t) ts->tv_sec >= UINT64_MAX / 1000000000 - 1)
+		return UINT64_MAX >> WHEEL_TICK_SHIFT;
+
+	return ((uint64_t) ts->tv_sec * 1000000000 + ts->tv_nsec) >>
+	    WHEEL_TICK_SHIFT;
+}
+
+static void _insert_timeout(_timeout_t *timeout)
+{
+	futex_assert_is_locked(&fibril_futex);
+	assert(timeout);
+
+	uint64_t tick = _ts_to_tick(&timeout->expires);
+	if (tick < wheel_tick)
+		tick = wheel_tick;
+
+	unsigned level = 0;
+	while (level < WHEEL_LEVELS) {
+		unsigned span = WHEEL_BITS * (level + 1);
+		if ((tick >> span) == (wheel_tick >> span))
+			break;
+		level++;
+	}
+
+	unsigned slot;
+	if (level < WHEEL_LEVELS) {
+		slot = (tick >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1);
+	} else {
+		/*
+		 * Beyond the current span of the top level. Slots behind the
+		 * current one stand for the next span. Use the slot of the
+		 * timeout if that is in the next span, or the farthest one.
+		 */
+		level = WHEEL_LEVELS - 1;
+		unsigned shift = WHEEL_BITS * level;
+		unsigned cur = (wheel_tick >> shift) & (WHEEL_SLOTS - 1);
+
+		slot = (tick >> shift) & (WHEEL_SLOTS - 1);
+		if (tick - wheel_tick >= ((uint64_t) 1 << (shift + WHEEL_BITS)) ||
+		    slot == cur)
+			slot = (cur - 1) & (WHEEL_SLOTS - 1);
+	}
+
+	timeout->level = level;
+	timeout->slot = slot;
+	list_append(&timeout->link, &wheel[level][slot]);
+	wheel_occupied[level] |= (uint64_t) 1 << slot;
+}
+
+static void _remove_timeout(_timeout_t *timeout)
+{
+	futex_assert_is_locked(&fibril_futex);
+
+	list_remove(&timeout->link);
+	if (list_empty(&wheel[timeout->level][timeout->slot]))
+		wheel_occupied[timeout->level] &= ~((uint64_t) 1 << timeout->slot);
+}
+
+/**
+ * Find the first non-empty slot of the wheel.
+ *
+ * @param[out] tick   First tick of the slot.
+ * @param[out] level  Level of the slot.
+ * @return false if there are no timeouts.
+ */
+static bool _wheel_next(uint64_t *tick, unsigned *level)
+{
+	/* Any slot on a lower level comes before all slots on higher levels. */
+	for (unsigned l = 0; l < WHEEL_LEVELS; l++) {
+		uint64_t occupied = wheel_occupied[l];
+		if (occupied == 0)
+			continue;
+
+		unsigned shift = WHEEL_BITS * l;
+		unsigned cur = (wheel_tick >> shift) & (WHEEL_SLOTS - 1);
+		uint64_t base = (wheel_tick >> (shift + WHEEL_BITS)) <<
+		    (shift + WHEEL_BITS);
+
+		unsigned slot;
+		if ((occupied >> cur) != 0) {
+			slot = cur + __builtin_ctzll(occupied >> cur);
+		} else {
+			/* Slots behind the current one, only on the top level. */
+			assert(l == WHEEL_LEVELS - 1);
+			slot = __builtin_ctzll(occupied);
+			base += (uint64_t) 1 << (shift + WHEEL_BITS);
+		}
+
+		*tick = base + ((uint64_t) slot << shift);
+		*level = l;
+		return true;
+	}
+
+	return false;
+}
+
 /** Fire all timeouts that expired. */
 static struct timespec *_handle_expired_timeouts(struct timespec *next_timeout)
 {
 	struct timespec ts;
 	getuptime(&ts);
+	uint64_t now = _ts_to_tick(&ts);
 
 	futex_lock(&fibril_futex);
 
-	while (!list_empty(&timeout_list)) {
-		link_t *cur = list_first(&timeout_list);
-		_timeout_t *to = list_get_instance(cur, _timeout_t, link);
+	uint64_t tick;
+	unsigned level;
 
-		if (ts_gt(&to->expires, &ts)) {
-			*next_timeout = to->expires;
-			futex_unlock(&fibril_futex);
-			return next_timeout;
+	while (_wheel_next(&tick, &level) && tick <= now) {
+		unsigned idx = (tick >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1);
+		list_t *slot = &wheel[level][idx];
+
+		if (level > 0) {
+			/* Move the timeouts of the slot to lower levels. */
+			wheel_tick = tick;
+			wheel_occupied[level] &= ~((uint64_t) 1 << idx);
+
+			list_t moved;
+			list_initialize(&moved);
+			list_concat(&moved, slot);
+
+			link_t *cur;
+			while ((cur = list_first(&moved)) != NULL) {
+				list_remove(cur);
+				_insert_timeout(list_get_instance(cur, _timeout_t, link));
+			}
+			continue;
+		}
+
+		list_foreach_safe(*slot, cur, next) {
+			_timeout_t *to = list_get_instance(cur, _timeout_t, link);
+			if (ts_gt(&to->expires, &ts))
+				continue;
+
+			_remove_timeout(to);
+			_ready_list_push(_fibril_trigger_internal(
+			    to->event, _EVENT_TIMED_OUT));
 		}
 
-		list_remove(&to->link);
+		if (tick == now) {
+			/* Timeouts later in the current tick stay. */
+			break;
+		}
 
-		_ready_list_push(_fibril_trigger_internal(
-		    to->event, _EVENT_TIMED_OUT));
+		assert(list_empty(slot));
+		wheel_tick = tick + 1;
 	}
 
-	futex_unlock(&fibril_futex);
-	return NULL;
-}
+	if (wheel_tick < now)
+		wheel_tick = now;
 
-/**
- * Clean up after a dead fibril from which we restored context, if any.
- * Called after a switch is made and fibril_futex is unlocked.
- */
-static void _fibril_cleanup_dead(void)
-{
-	fibril_t *srcf = fibril_self();
-	if (!srcf->clean_after_me)
-		return;
+	if (!_wheel_next(&tick, &level)) {
+		futex_unlock(&fibril_futex);
+		return NULL;
+	}
 
-	void *stack = srcf->clean_after_me->stack;
-	assert(stack);
-	as_area_destroy(stack);
-	fibril_teardown(srcf->clean_after_me);
-	srcf->clean_after_me = NULL;
+	if (level == 0) {
+		/* Wake up exactly when the first timeout expires. */
+		list_t *slot = &wheel[0][tick & (WHEEL_SLOTS - 1)];
+		*next_timeout = list_get_instance(list_first(slot),
+		    _timeout_t, link)->expires;
+
+		list_foreach(*slot, link, _timeout_t, to) {
+			if (ts_gt(next_timeout, &to->expires))
+				*next_timeout = to->expires;
+		}
+	} else {
+		/* Wake up when timeouts need to move down a level. */
+		if (tick > (UINT64_MAX >> WHEEL_TICK_SHIFT))
+			tick = UINT64_MAX >> WHEEL_TICK_SHIFT;
+
+		next_timeout->tv_sec = (tick << WHEEL_TICK_SHIFT) / 1000000000;
+		next_timeout->tv_nsec = (tick << WHEEL_TICK_SHIFT) % 1000000000;
+	}
+
+	futex_unlock(&fibril_futex);
+	return next_timeout;
 }
 
 /** Switch to a fibril. */
@@ -464,32 +825,30 @@ static void _fibril_switch_to(_switch_type_t type, fibril_t *dstf, bool locked)
 {
 	assert(fibril_self()->rmutex_locks == 0);
 
-	if (!locked)
-		futex_lock(&fibril_futex);
-	else
+	if (locked)
 		futex_assert_is_locked(&fibril_futex);
+	else
+		futex_assert_is_not_locked(&fibril_futex);
 
 	fibril_t *srcf = fibril_self();
 	assert(srcf);
 	assert(dstf);
 
-	switch (type) {
-	case SWITCH_FROM_YIELD:
-		_ready_list_push(srcf);
-		break;
-	case SWITCH_FROM_DEAD:
+	/* Only a switch from a blocked fibril holds fibril_futex. */
+	assert(locked == (type == SWITCH_FROM_BLOCKED));
+
+	if (type == SWITCH_FROM_DEAD)
 		dstf->clean_after_me = srcf;
-		break;
-	case SWITCH_FROM_HELPER:
-	case SWITCH_FROM_BLOCKED:
-		break;
-	}
+
+	dstf->switched_from = srcf;
+	dstf->switch_type = type;
 
 	dstf->thread_ctx = srcf->thread_ctx;
 	srcf->thread_ctx = NULL;
 
 	/* Just some bookkeeping to allow better debugging of futex locks. */
-	futex_give_to(&fibril_futex, dstf);
+	if (locked)
+		futex_give_to(&fibril_futex, dstf);
 
 	/* Swap to the next fibril. */
 	context_swap(&srcf->ctx, &dstf->ctx);
@@ -497,11 +856,7 @@ static void _fibril_switch_to(_switch_type_t type, fibril_t *dstf, bool locked)
 	assert(srcf == fibril_self());
 	assert(srcf->thread_ctx);
 
-	if (!locked) {
-		/* Must be after context_swap()! */
-		futex_unlock(&fibril_futex);
-		_fibril_cleanup_dead();
-	}
+	_fibril_switch_finish();
 }
 
 /**
@@ -595,24 +950,6 @@ void fibril_destroy(fid_t fid)
 	fibril_teardown(fibril);
 }
 
-static void _insert_timeout(_timeout_t *timeout)
-{
-	futex_assert_is_locked(&fibril_futex);
-	assert(timeout);
-
-	link_t *tmp = timeout_list.head.next;
-	while (tmp != &timeout_list.head) {
-		_timeout_t *cur = list_get_instance(tmp, _timeout_t, link);
-
-		if (ts_gteq(&cur->expires, &timeout->expires))
-			break;
-
-		tmp = tmp->next;
-	}
-
-	list_insert_before(&timeout->link, tmp);
-}
-
 /**
  * Same as `fibril_wait_for()`, except with a timeout.
  *
@@ -631,10 +968,13 @@ errno_t fibril_wait_timeout(fibril_event_t *event,
 	DPRINTF("### Fibril %p sleeping on event %p.\n", fibril_self(), event);
 
 	if (!fibril_self()->thread_ctx) {
-		fibril_self()->thread_ctx =
+		fibril_t *helper =
 		    fibril_create_generic(_helper_fibril_fn, NULL, PAGE_SIZE);
-		if (!fibril_self()->thread_ctx)
+		if (!helper)
 			return ENOMEM;
+
+		helper->runner = _runner_register();
+		fibril_self()->thread_ctx = helper;
 	}
 
 	futex_lock(&fibril_futex);
@@ -693,16 +1033,18 @@ errno_t fibril_wait_timeout(fibril_event_t *event,
 
 	_fibril_switch_to(SWITCH_FROM_BLOCKED, dstf, true);
 
+	futex_lock(&fibril_futex);
+
 	assert(event->fibril != srcf);
 	assert(event->fibril != _EVENT_INITIAL);
 	assert(event->fibril == _EVENT_TIMED_OUT || event->fibril == _EVENT_TRIGGERED);
 
-	list_remove(&timeout.link);
+	if (link_in_use(&timeout.link))
+		_remove_timeout(&timeout);
 	errno_t rc = (event->fibril == _EVENT_TIMED_OUT) ? ETIMEOUT : EOK;
 	event->fibril = _EVENT_INITIAL;
 
 	futex_unlock(&fibril_futex);
-	_fibril_cleanup_dead();
 	return rc;
 }
 
@@ -782,13 +1124,15 @@ void fibril_yield(void)
 
 static void _runner_fn(void *arg)
 {
+	fibril_self()->runner = _runner_register();
 	_helper_fibril_fn(arg);
 }
 
 /**
  * Spawn a given number of runners (i.e. OS threads) immediately, and
- * unconditionally. This is meant to be used for tests and debugging.
- * Regular programs should just use `fibril_enable_multithreaded()`.
+ * unconditionally. Regular programs should just use
+ * `fibril_enable_multithreaded()`, which sizes the number of runners
+ * to the number of CPUs.
  *
  * @param n  Number of runners to spawn.
  * @return   Number of runners successfully spawned.
@@ -817,24 +1161,77 @@ int fibril_test_spawn_runners(int n)
 	return n;
 }
 
+/** @return number of active CPUs, at least one. */
+static int _cpu_count(void)
+{
+	size_t size = 0;
+	stats_cpu_t *cpus = sysinfo_get_data("system.cpus", &size);
+	if (!cpus)
+		return 1;
+
+	int active = 0;
+	for (size_t i = 0; i < size / sizeof(stats_cpu_t); i++) {
+		if (cpus[i].active)
+			active++;
+	}
+
+	free(cpus);
+	return (active > 0) ? active : 1;
+}
+
 /**
  * Opt-in to have more than one runner thread.
  *
  * Currently, a task only ever runs in one thread because multithreading
  * might break some existing code.
  *
+ * The task gets one runner per CPU, including the thread calling this
+ * function, but at least two, so that a fibril blocked in a system call
+ * does not stop all the others.
+ *
  * Eventually, the number of runner threads for a given task should become
  * configurable in the environment and this function becomes no-op.
  */
 void fibril_enable_multithreaded(void)
 {
-	// TODO: Implement better.
-	//       For now, 4 total runners is a sensible default.
 	if (!multithreaded) {
-		fibril_test_spawn_runners(3);
+		int cpus = _cpu_count();
+		fibril_test_spawn_runners((cpus > 1) ? cpus - 1 : 1);
 	}
 }
 
+/**
+ * Get the runner executing the calling fibril.
+ *
+ * Runners are numbered from zero, the main thread being runner zero.
+ * The number can be passed to fibril_set_affinity() to keep related
+ * fibrils on the same runner.
+ *
+ * @return Index of the runner.
+ */
+int fibril_get_runner(void)
+{
+	fibril_t *helper = fibril_self()->thread_ctx;
+	return helper ? helper->runner : 0;
+}
+
+/**
+ * Set the preferred runner of a fibril.
+ *
+ * Whenever the fibril becomes ready, it is put on the ready list of its
+ * preferred runner instead of that of the running thread. This is only
+ * a hint, an idle runner may still steal the fibril.
+ *
+ * @param fid     Fibril to set the preference for.
+ * @param runner  Index of the runner, as returned by fibril_get_runner(),
+ *                or FIBRIL_RUNNER_ANY to drop the preference.
+ */
+void fibril_set_affinity(fid_t fid, int runner)
+{
+	fibril_t *fibril = (fibril_t *) fid;
+	fibril->affinity = (runner < 0) ? 0 : runner + 1;
+}
+
 /**
  * Detach a fibril.
  */
@@ -869,6 +1266,19 @@ void __fibrils_init(void)
 		abort();
 	if (futex_initialize(&ipc_lists_futex, 1) != EOK)
 		abort();
+	if (_runner_init(&runners[0]) != EOK)
+		abort();
+
+	for (int l = 0; l < WHEEL_LEVELS; l++) {
+		for (int i = 0; i < WHEEL_SLOTS; i++)
+			list_initialize(&wheel[l][i]);
+	}
+
+	struct timespec ts;
+	getuptime(&ts);
+	wheel_tick = _ts_to_tick(&ts);
+
+	main_thread_id = thread_get_id();
 
 	/*
 	 * We allow a fixed, small amount of parallelism for IPC reads, but
@@ -889,6 +1299,7 @@ void __fibrils_fini(void)
 {
 	futex_destroy(&fibril_futex);
 	futex_destroy(&ipc_lists_futex);
+	futex_destroy(&runners[0].lock);
 }
 
 void fibril_usleep(usec_t timeout)
@@ -190,6 +190,63 @@ void fibril_mutex_lock(fibril_mutex_t *fm)
 	fibril_wait_for(&wdata.event);
 }
 
+/** Lock a mutex, giving up if it is not acquired in time.
+ *
+ * @param fm       Mutex to lock.
+ * @param timeout  Timeout in microseconds, zero means no timeout.
+ *
+ * @return EOK if the mutex was locked, ETIMEOUT otherwise.
+ */
+errno_t fibril_mutex_lock_timeout(fibril_mutex_t *fm, usec_t timeout)
+{
+	if (timeout < 0)
+		return ETIMEOUT;
+
+	fibril_t *f = (fibril_t *) fibril_get_id();
+
+	futex_lock(&fibril_synch_futex);
+
+	if (fm->counter-- > 0) {
+		fm->oi.owned_by = f;
+		futex_unlock(&fibril_synch_futex);
+		return EOK;
+	}
+
+	/*
+	 * No deadlock detection here, waiting in a cycle is not
+	 * a deadlock when one of the waiters gives up eventually.
+	 */
+	awaiter_t wdata = AWAITER_INIT;
+	list_append(&wdata.link, &fm->waiters);
+
+	futex_unlock(&fibril_synch_futex);
+
+	struct timespec ts;
+	struct timespec *expires = NULL;
+	if (timeout) {
+		getuptime(&ts);
+		ts_add_diff(&ts, USEC2NSEC(timeout));
+		expires = &ts;
+	}
+
+	errno_t rc = fibril_wait_timeout(&wdata.event, expires);
+	if (rc == EOK)
+		return EOK;
+
+	futex_lock(&fibril_synch_futex);
+	if (!link_in_use(&wdata.link)) {
+		/* The mutex was handed over to us before we could give up. */
+		futex_unlock(&fibril_synch_futex);
+		return EOK;
+	}
+
+	list_remove(&wdata.link);
+	fm->counter++;
+	futex_unlock(&fibril_synch_futex);
+
+	return rc;
+}
+
 bool fibril_mutex_trylock(fibril_mutex_t *fm)
 {
 	bool locked = false;
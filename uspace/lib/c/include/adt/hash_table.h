@@ -79,6 +79,11 @@ typedef struct {
 	size_t item_cnt;
 	size_t max_load;
 	bool apply_ongoing;
+	/** Buckets still being migrated after a resize or NULL. */
+	list_t *old_bucket;
+	size_t old_bucket_cnt;
+	/** Number of old buckets already migrated. */
+	size_t migrate_idx;
 } hash_table_t;
 
 #define hash_table_get_inst(item, type, member) \
@@ -50,6 +50,9 @@ typedef struct {
 
 typedef fibril_t *fid_t;
 
+/** Fibril may run on any runner */
+#define FIBRIL_RUNNER_ANY  (-1)
+
 #ifndef __cplusplus
 /** Fibril-local variable specifier */
 #define fibril_local __thread
@@ -67,6 +70,8 @@ extern void fibril_sleep(sec_t);
 
 extern void fibril_enable_multithreaded(void);
 extern int fibril_test_spawn_runners(int);
+extern int fibril_get_runner(void);
+extern void fibril_set_affinity(fid_t, int);
 
 extern void fibril_detach(fid_t fid);
 
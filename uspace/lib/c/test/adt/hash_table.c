@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <adt/hash_table.h>
+#include <pcut/pcut.h>
+#include <stdlib.h>
+
+/** Test entry */
+typedef struct {
+	ht_link_t link;
+	size_t key;
+} test_entry_t;
+
+enum {
+	/** Number of entries, enough for the table to be resized many times */
+	test_cnt = 5000,
+	/** Number of entries sharing each key in the duplicate test */
+	test_dup = 3
+};
+
+/** Number of entries passed to the remove callback */
+static size_t removed_cnt;
+
+static size_t test_hash(const ht_link_t *item)
+{
+	return hash_table_get_inst(item, test_entry_t, link)->key;
+}
+
+static size_t test_key_hash(const void *key)
+{
+	return *(const size_t *) key;
+}
+
+static bool test_equal(const ht_link_t *item1, const ht_link_t *item2)
+{
+	return hash_table_get_inst(item1, test_entry_t, link)->key ==
+	    hash_table_get_inst(item2, test_entry_t, link)->key;
+}
+
+static bool test_key_equal(const void *key, const ht_link_t *item)
+{
+	return *(const size_t *) key ==
+	    hash_table_get_inst(item, test_entry_t, link)->key;
+}
+
+static void test_remove_callback(ht_link_t *item)
+{
+	++removed_cnt;
+}
+
+static hash_table_ops_t test_ops = {
+	.hash = test_hash,
+	.key_hash = test_key_hash,
+	.equal = test_equal,
+	.key_equal = test_key_equal,
+	.remove_callback = test_remove_callback
+};
+
+/** Counts the entries visited by hash_table_apply(). */
+static bool count_entry(ht_link_t *item, void *arg)
+{
+	size_t *cnt = arg;
+
+	++*cnt;
+	return true;
+}
+
+/** Removes every other entry while walking the table. */
+static bool remove_odd(ht_link_t *item, void *arg)
+{
+	hash_table_t *h = arg;
+
+	if (hash_table_get_inst(item, test_entry_t, link)->key % 2 == 1)
+		hash_table_remove_item(h, item);
+	return true;
+}
+
+PCUT_INIT;
+
+PCUT_TEST_SUITE(hash_table);
+
+/** Entries stay reachable while the table grows and shrinks. */
+PCUT_TEST(grow_shrink)
+{
+	hash_table_t h;
+	test_entry_t *e = calloc(test_cnt, sizeof(test_entry_t));
+	PCUT_ASSERT_NOT_NULL(e);
+
+	PCUT_ASSERT_TRUE(hash_table_create(&h, 0, 0, &test_ops));
+	removed_cnt = 0;
+
+	for (size_t i = 0; i < test_cnt; i++) {
+		e[i].key = i;
+		hash_table_insert(&h, &e[i].link);
+
+		/* Check the newest entry and a couple of old ones. */
+		for (size_t j = 0; j <= i; j += 1 + i / 8) {
+			PCUT_ASSERT_TRUE(hash_table_find(&h, &e[j].key) ==
+			    &e[j].link);
+		}
+		PCUT_ASSERT_TRUE(hash_table_find(&h, &e[i].key) == &e[i].link);
+	}
+
+	PCUT_ASSERT_INT_EQUALS(test_cnt, hash_table_size(&h));
+
+	for (size_t i = 0; i < test_cnt; i++)
+		PCUT_ASSERT_TRUE(hash_table_find(&h, &e[i].key) == &e[i].link);
+
+	size_t key = test_cnt;
+	PCUT_ASSERT_NULL(hash_table_find(&h, &key));
+
+	/* Remove the first half by key and the rest item by item. */
+	for (size_t i = 0; i < test_cnt / 2; i++) {
+		PCUT_ASSERT_INT_EQUALS(1, hash_table_remove(&h, &e[i].key));
+		PCUT_ASSERT_NULL(hash_table_find(&h, &e[i].key));
+		PCUT_ASSERT_TRUE(hash_table_find(&h, &e[test_cnt - 1].key) ==
+		    &e[test_cnt - 1].link);
+	}
+
+	for (size_t i = test_cnt / 2; i < test_cnt; i++) {
+		PCUT_ASSERT_TRUE(hash_table_find(&h, &e[i].key) == &e[i].link);
+		hash_table_remove_item(&h, &e[i].link);
+		PCUT_ASSERT_NULL(hash_table_find(&h, &e[i].key));
+	}
+
+	PCUT_ASSERT_INT_EQUALS(test_cnt, removed_cnt);
+	PCUT_ASSERT_TRUE(hash_table_empty(&h));
+
+	hash_table_destroy(&h);
+	free(e);
+}
+
+/** Entries with equal keys can all be found while the table grows. */
+PCUT_TEST(duplicates)
+{
+	hash_table_t h;
+	size_t cnt = test_cnt * test_dup;
+	test_entry_t *e = calloc(cnt, sizeof(test_entry_t));
+	PCUT_ASSERT_NOT_NULL(e);
+
+	PCUT_ASSERT_TRUE(hash_table_create(&h, 0, 0, &test_ops));
+
+	for (size_t i = 0; i < cnt; i++) {
+		e[i].key = i % test_cnt;
+		if (i < test_cnt) {
+			PCUT_ASSERT_TRUE(hash_table_insert_unique(&h, &e[i].link));
+		} else {
+			PCUT_ASSERT_FALSE(hash_table_insert_unique(&h, &e[i].link));
+			hash_table_insert(&h, &e[i].link);
+		}
+	}
+
+	PCUT_ASSERT_INT_EQUALS(cnt, hash_table_size(&h));
+
+	for (size_t key = 0; key < test_cnt; key++) {
+		size_t found = 0;
+		ht_link_t *first = hash_table_find(&h, &key);
+		ht_link_t *cur = first;
+
+		while (cur != NULL) {
+			PCUT_ASSERT_INT_EQUALS(key,
+			    hash_table_get_inst(cur, test_entry_t, link)->key);
+			++found;
+			cur = hash_table_find_next(&h, first, cur);
+		}
+
+		PCUT_ASSERT_INT_EQUALS(test_dup, found);
+	}
+
+	removed_cnt = 0;
+	for (size_t key = 0; key < test_cnt; key++)
+		PCUT_ASSERT_INT_EQUALS(test_dup, hash_table_remove(&h, &key));
+
+	PCUT_ASSERT_INT_EQUALS(cnt, removed_cnt);
+	PCUT_ASSERT_TRUE(hash_table_empty(&h));
+
+	hash_table_destroy(&h);
+	free(e);
+}
+
+/** Walking and clearing the table visit every entry exactly once. */
+PCUT_TEST(apply_clear)
+{
+	hash_table_t h;
+	test_entry_t *e = calloc(test_cnt, sizeof(test_entry_t));
+	PCUT_ASSERT_NOT_NULL(e);
+
+	PCUT_ASSERT_TRUE(hash_table_create(&h, 0, 0, &test_ops));
+
+	for (size_t i = 0; i < test_cnt; i++) {
+		e[i].key = i;
+		hash_table_insert(&h, &e[i].link);
+
+		size_t visited = 0;
+		hash_table_apply(&h, count_entry, &visited);
+		PCUT_ASSERT_INT_EQUALS(i + 1, visited);
+	}
+
+	removed_cnt = 0;
+	hash_table_apply(&h, remove_odd, &h);
+	PCUT_ASSERT_INT_EQUALS(test_cnt / 2, removed_cnt);
+	PCUT_ASSERT_INT_EQUALS(test_cnt - test_cnt / 2, hash_table_size(&h));
+
+	for (size_t i = 0; i < test_cnt; i++) {
+		if (i % 2 == 1)
+			PCUT_ASSERT_NULL(hash_table_find(&h, &e[i].key));
+		else
+			PCUT_ASSERT_TRUE(hash_table_find(&h, &e[i].key) == &e[i].link);
+	}
+
+	hash_table_clear(&h);
+	PCUT_ASSERT_INT_EQUALS(test_cnt, removed_cnt);
+	PCUT_ASSERT_TRUE(hash_table_empty(&h));
+
+	/* The table is usable again after being cleared. */
+	hash_table_insert(&h, &e[0].link);
+	PCUT_ASSERT_TRUE(hash_table_find(&h, &e[0].key) == &e[0].link);
+
+	hash_table_destroy(&h);
+	free(e);
+}
+
+PCUT_EXPORT(hash_table);
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <errno.h>
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <pcut/pcut.h>
+
+PCUT_INIT;
+
+PCUT_TEST_SUITE(fibril_runner);
+
+#define WORKER_COUNT 16
+#define WORKER_ITERATIONS 100
+
+typedef struct {
+	fibril_mutex_t lock;
+	fibril_condvar_t done_cv;
+	int counter;
+	int done;
+	int runner;
+	bool on_runner;
+} shared_t;
+
+static void shared_init(shared_t *shared)
+{
+	fibril_mutex_initialize(&shared->lock);
+	fibril_condvar_initialize(&shared->done_cv);
+	shared->counter = 0;
+	shared->done = 0;
+	shared->runner = FIBRIL_RUNNER_ANY;
+	shared->on_runner = true;
+}
+
+static void shared_wait(shared_t *shared, int count)
+{
+	fibril_mutex_lock(&shared->lock);
+	while (shared->done < count)
+		fibril_condvar_wait(&shared->done_cv, &shared->lock);
+	fibril_mutex_unlock(&shared->lock);
+}
+
+static errno_t worker_fn(void *arg)
+{
+	shared_t *shared = arg;
+
+	for (int i = 0; i < WORKER_ITERATIONS; i++) {
+		fibril_mutex_lock(&shared->lock);
+		shared->counter++;
+		fibril_mutex_unlock(&shared->lock);
+		fibril_yield();
+	}
+
+	fibril_mutex_lock(&shared->lock);
+	shared->done++;
+	fibril_condvar_broadcast(&shared->done_cv);
+	fibril_mutex_unlock(&shared->lock);
+	return EOK;
+}
+
+static errno_t affine_fn(void *arg)
+{
+	shared_t *shared = arg;
+
+	fibril_mutex_lock(&shared->lock);
+	if (fibril_get_runner() != shared->runner)
+		shared->on_runner = false;
+	shared->done++;
+	fibril_condvar_broadcast(&shared->done_cv);
+	fibril_mutex_unlock(&shared->lock);
+	return EOK;
+}
+
+/** Without extra runners, everything runs on runner zero. */
+PCUT_TEST(single_runner_affinity)
+{
+	shared_t shared;
+
+	shared_init(&shared);
+	shared.runner = fibril_get_runner();
+	PCUT_ASSERT_INT_EQUALS(0, shared.runner);
+
+	fid_t fid = fibril_create(affine_fn, &shared);
+	PCUT_ASSERT_NOT_NULL(fid);
+	fibril_set_affinity(fid, shared.runner);
+	fibril_start(fid);
+
+	shared_wait(&shared, 1);
+	PCUT_ASSERT_TRUE(shared.on_runner);
+}
+
+/** Fibrils made ready on many runners all run to completion. */
+PCUT_TEST(many_runners)
+{
+	shared_t shared;
+
+	shared_init(&shared);
+	PCUT_ASSERT_INT_EQUALS(2, fibril_test_spawn_runners(2));
+
+	for (int i = 0; i < WORKER_COUNT; i++) {
+		fid_t fid = fibril_create(worker_fn, &shared);
+		PCUT_ASSERT_NOT_NULL(fid);
+		if (i % 2 == 0)
+			fibril_set_affinity(fid, i % 3);
+		fibril_start(fid);
+	}
+
+	shared_wait(&shared, WORKER_COUNT);
+	PCUT_ASSERT_INT_EQUALS(WORKER_COUNT * WORKER_ITERATIONS, shared.counter);
+}
+
+PCUT_EXPORT(fibril_runner);
@@ -27,6 +27,7 @@
  */
 
 #include <async.h>
+#include <errno.h>
 #include <fibril_synch.h>
 #include <pcut/pcut.h>
 
@@ -138,4 +139,59 @@ PCUT_TEST(fire)
 	fibril_timer_destroy(t);
 }
 
+typedef struct {
+	usec_t delay;
+	fibril_mutex_t *lock;
+	fibril_condvar_t *cv;
+	int *order;
+	int pos;
+} sleeper_t;
+
+static errno_t sleeper_fn(void *arg)
+{
+	sleeper_t *s = arg;
+
+	fibril_usleep(s->delay);
+
+	fibril_mutex_lock(s->lock);
+	s->pos = (*s->order)++;
+	fibril_condvar_broadcast(s->cv);
+	fibril_mutex_unlock(s->lock);
+	return EOK;
+}
+
+/** Timeouts expire in order, no matter how far in the future they are. */
+PCUT_TEST(timeouts_in_order)
+{
+	fibril_mutex_t lock;
+	fibril_condvar_t cv;
+	sleeper_t sleepers[4];
+	usec_t delays[4] = { 300 * 1000, 1000, 70 * 1000, 5 * 1000 };
+	int expected[4] = { 3, 0, 2, 1 };
+	int order = 0;
+
+	fibril_mutex_initialize(&lock);
+	fibril_condvar_initialize(&cv);
+
+	for (int i = 0; i < 4; i++) {
+		sleepers[i].delay = delays[i];
+		sleepers[i].lock = &lock;
+		sleepers[i].cv = &cv;
+		sleepers[i].order = &order;
+		sleepers[i].pos = -1;
+
+		fid_t fid = fibril_create(sleeper_fn, &sleepers[i]);
+		PCUT_ASSERT_NOT_NULL(fid);
+		fibril_add_ready(fid);
+	}
+
+	fibril_mutex_lock(&lock);
+	while (order < 4)
+		fibril_condvar_wait(&cv, &lock);
+	fibril_mutex_unlock(&lock);
+
+	for (int i = 0; i < 4; i++)
+		PCUT_ASSERT_INT_EQUALS(expected[i], sleepers[i].pos);
+}
+
 PCUT_EXPORT(fibril_timer);
@@ -105,4 +105,41 @@ PCUT_TEST(gsort_desc)
 	}
 }
 
+typedef struct {
+	int key;
+	int pos;
+} pair_t;
+
+static int pair_cmp(void *a, void *b, void *param)
+{
+	pair_t *pa = a;
+	pair_t *pb = b;
+
+	if (pa->key == pb->key)
+		return 0;
+
+	return pa->key < pb->key ? -1 : 1;
+}
+
+/* equal elements keep their order, also across merged blocks */
+PCUT_TEST(gsort_stable)
+{
+	int size = 1000;
+	pair_t data[size];
+
+	for (int i = 0; i < size; i++) {
+		data[i].key = (i * 7919) % 13;
+		data[i].pos = i;
+	}
+
+	bool ret = gsort(data, size, sizeof(pair_t), pair_cmp, NULL);
+	PCUT_ASSERT_TRUE(ret);
+
+	for (int i = 1; i < size; i++) {
+		PCUT_ASSERT_TRUE(data[i - 1].key <= data[i].key);
+		if (data[i - 1].key == data[i].key)
+			PCUT_ASSERT_TRUE(data[i - 1].pos < data[i].pos);
+	}
+}
+
 PCUT_EXPORT(gsort);
@@ -35,12 +35,15 @@ PCUT_IMPORT(capa);
 PCUT_IMPORT(casting);
 PCUT_IMPORT(circ_buf);
 PCUT_IMPORT(double_to_str);
+PCUT_IMPORT(fibril_runner);
 PCUT_IMPORT(fibril_timer);
 PCUT_IMPORT(getopt);
 PCUT_IMPORT(gsort);
+PCUT_IMPORT(hash_table);
 PCUT_IMPORT(ieee_double);
 PCUT_IMPORT(imath);
 PCUT_IMPORT(inttypes);
+PCUT_IMPORT(malloc);
 PCUT_IMPORT(mem);
 PCUT_IMPORT(odict);
 PCUT_IMPORT(perf);
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <macros.h>
+#include <malloc.h>
+#include <mem.h>
+#include <pcut/pcut.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+PCUT_INIT;
+
+PCUT_TEST_SUITE(malloc);
+
+/* Sizes around the boundaries between small, medium and large blocks. */
+static const size_t sizes[] = {
+	0, 1, 15, 16, 17, 128, 129, 1000, 1024, 1025, 4096, 20000,
+	65535, 65536, 65537, 200000, 1048576
+};
+
+#define SIZES (sizeof(sizes) / sizeof(sizes[0]))
+
+static void fill(uint8_t *buf, size_t size, uint8_t seed)
+{
+	for (size_t i = 0; i < size; i++)
+		buf[i] = (uint8_t) (seed + i);
+}
+
+static bool check(const uint8_t *buf, size_t size, uint8_t seed)
+{
+	for (size_t i = 0; i < size; i++) {
+		if (buf[i] != (uint8_t) (seed + i))
+			return false;
+	}
+
+	return true;
+}
+
+/** Blocks of all kinds can be allocated and do not overlap */
+PCUT_TEST(sizes)
+{
+	uint8_t *blocks[SIZES];
+
+	for (size_t i = 0; i < SIZES; i++) {
+		blocks[i] = malloc(sizes[i]);
+		PCUT_ASSERT_NOT_NULL(blocks[i]);
+		PCUT_ASSERT_INT_EQUALS(0, (uintptr_t) blocks[i] % 16);
+		fill(blocks[i], sizes[i], i);
+	}
+
+	PCUT_ASSERT_NULL(heap_check());
+
+	for (size_t i = 0; i < SIZES; i++) {
+		PCUT_ASSERT_TRUE(check(blocks[i], sizes[i], i));
+		free(blocks[i]);
+	}
+
+	PCUT_ASSERT_NULL(heap_check());
+}
+
+/** calloc returns zeroed blocks */
+PCUT_TEST(calloc)
+{
+	for (size_t i = 0; i < SIZES; i++) {
+		uint8_t *block = calloc(1, sizes[i]);
+		PCUT_ASSERT_NOT_NULL(block);
+
+		for (size_t j = 0; j < sizes[i]; j++)
+			PCUT_ASSERT_INT_EQUALS(0, block[j]);
+
+		/* Make the memory dirty for the next round. */
+		fill(block, sizes[i], 1);
+		free(block);
+	}
+}
+
+/** calloc fails on overflow */
+PCUT_TEST(calloc_overflow)
+{
+	PCUT_ASSERT_NULL(calloc(SIZE_MAX / 2, 4));
+}
+
+/** memalign honors the alignment */
+PCUT_TEST(memalign)
+{
+	for (size_t align = 1; align <= 65536; align *= 2) {
+		for (size_t i = 0; i < SIZES; i++) {
+			uint8_t *block = memalign(align, sizes[i]);
+			PCUT_ASSERT_NOT_NULL(block);
+			PCUT_ASSERT_INT_EQUALS(0, (uintptr_t) block % align);
+			fill(block, sizes[i], 0);
+			free(block);
+		}
+	}
+
+	PCUT_ASSERT_NULL(heap_check());
+}
+
+/** realloc preserves the contents of the block */
+PCUT_TEST(realloc)
+{
+	uint8_t *block = NULL;
+	size_t size = 0;
+
+	/* Grow through all kinds of blocks, then shrink back. */
+	for (size_t i = 1; i < 2 * SIZES - 1; i++) {
+		size_t new_size = (i < SIZES) ? sizes[i] : sizes[2 * SIZES - i - 1];
+
+		block = realloc(block, new_size);
+		PCUT_ASSERT_NOT_NULL(block);
+		PCUT_ASSERT_TRUE(check(block, min(size, new_size), 0));
+
+		fill(block, new_size, 0);
+		size = new_size;
+	}
+
+	free(block);
+	PCUT_ASSERT_NULL(heap_check());
+}
+
+/** Freed memory is reused */
+PCUT_TEST(reuse)
+{
+	void *blocks[1000];
+
+	for (unsigned round = 0; round < 3; round++) {
+		for (size_t i = 0; i < 1000; i++) {
+			blocks[i] = malloc(sizes[i % SIZES] % 8192);
+			PCUT_ASSERT_NOT_NULL(blocks[i]);
+		}
+
+		/* Free every other block first to fragment the heap. */
+		for (size_t i = 0; i < 1000; i += 2)
+			free(blocks[i]);
+
+		PCUT_ASSERT_NULL(heap_check());
+
+		for (size_t i = 1; i < 1000; i += 2)
+			free(blocks[i]);
+	}
+
+	PCUT_ASSERT_NULL(heap_check());
+}
+
+PCUT_EXPORT(malloc);
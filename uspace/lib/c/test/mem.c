@@ -28,6 +28,8 @@
 
 #include <mem.h>
 #include <pcut/pcut.h>
+#include <stddef.h>
+#include <stdint.h>
 
 PCUT_INIT;
 
@@ -115,4 +117,129 @@ PCUT_TEST(memset)
 	PCUT_ASSERT_INT_EQUALS('x', buf[4]);
 }
 
+/*
+ * The following tests go over a range of lengths and misalignments, so
+ * that every path of the word-at-a-time and vectorized implementations is
+ * exercised, including the handling of the head and the tail.
+ */
+
+#define LONG_SIZE 300
+#define LONG_ALIGN 40
+
+static uint8_t src_buf[LONG_SIZE + LONG_ALIGN + 16];
+static uint8_t dst_buf[LONG_SIZE + LONG_ALIGN + 16];
+
+/* Pattern bytes stay below 0x80, so that they can be incremented safely. */
+static uint8_t pattern_byte(size_t i)
+{
+	return (i * 37 + 11) & 0x7f;
+}
+
+static void fill_pattern(uint8_t *buf, size_t n)
+{
+	for (size_t i = 0; i < n; i++)
+		buf[i] = pattern_byte(i);
+}
+
+/** memcpy function with various lengths and alignments */
+PCUT_TEST(memcpy_long)
+{
+	fill_pattern(src_buf, sizeof(src_buf));
+
+	for (size_t n = 0; n <= LONG_SIZE; n++) {
+		for (size_t a = 0; a < LONG_ALIGN; a += 3) {
+			size_t b = (a * 7) % LONG_ALIGN;
+
+			memset(dst_buf, 0, sizeof(dst_buf));
+			memcpy(dst_buf + b, src_buf + a, n);
+
+			for (size_t i = 0; i < sizeof(dst_buf); i++) {
+				if (i >= b && i < b + n)
+					PCUT_ASSERT_INT_EQUALS(src_buf[a + i - b], dst_buf[i]);
+				else
+					PCUT_ASSERT_INT_EQUALS(0, dst_buf[i]);
+			}
+		}
+	}
+}
+
+/** memset function with various lengths and alignments */
+PCUT_TEST(memset_long)
+{
+	for (size_t n = 0; n <= LONG_SIZE; n++) {
+		for (size_t a = 0; a < LONG_ALIGN; a += 3) {
+			memset(dst_buf, 0, sizeof(dst_buf));
+			memset(dst_buf + a, 0xa5, n);
+
+			for (size_t i = 0; i < sizeof(dst_buf); i++) {
+				if (i >= a && i < a + n)
+					PCUT_ASSERT_INT_EQUALS(0xa5, dst_buf[i]);
+				else
+					PCUT_ASSERT_INT_EQUALS(0, dst_buf[i]);
+			}
+		}
+	}
+}
+
+/** memmove function with overlapping areas */
+PCUT_TEST(memmove_long)
+{
+	for (size_t n = 0; n <= LONG_SIZE; n += 7) {
+		for (size_t a = 0; a < LONG_ALIGN; a += 3) {
+			for (size_t b = 0; b < LONG_ALIGN; b += 5) {
+				fill_pattern(dst_buf, sizeof(dst_buf));
+				memmove(dst_buf + b, dst_buf + a, n);
+
+				for (size_t i = 0; i < n; i++) {
+					PCUT_ASSERT_INT_EQUALS(pattern_byte(a + i),
+					    dst_buf[b + i]);
+				}
+			}
+		}
+	}
+}
+
+/** memcmp function with a difference at various positions */
+PCUT_TEST(memcmp_long)
+{
+	fill_pattern(src_buf, sizeof(src_buf));
+
+	for (size_t n = 1; n <= LONG_SIZE; n += 3) {
+		for (size_t a = 0; a < LONG_ALIGN; a += 7) {
+			size_t b = (a * 3) % LONG_ALIGN;
+
+			memcpy(dst_buf + b, src_buf + a, n);
+			PCUT_ASSERT_INT_EQUALS(0, memcmp(src_buf + a, dst_buf + b, n));
+
+			for (size_t i = 0; i < n; i += 5) {
+				dst_buf[b + i]++;
+				PCUT_ASSERT_TRUE(memcmp(src_buf + a, dst_buf + b, n) < 0);
+				PCUT_ASSERT_TRUE(memcmp(dst_buf + b, src_buf + a, n) > 0);
+				PCUT_ASSERT_INT_EQUALS(0, memcmp(src_buf + a, dst_buf + b, i));
+				dst_buf[b + i]--;
+			}
+		}
+	}
+}
+
+/** memchr function with various lengths and alignments */
+PCUT_TEST(memchr_long)
+{
+	for (size_t n = 0; n <= LONG_SIZE; n++) {
+		for (size_t a = 0; a < LONG_ALIGN; a += 3) {
+			memset(src_buf, 'x', sizeof(src_buf));
+			src_buf[a + n] = 'y';
+
+			PCUT_ASSERT_NULL(memchr(src_buf + a, 'y', n));
+			PCUT_ASSERT_TRUE(memchr(src_buf + a, 'y', n + 1) ==
+			    src_buf + a + n);
+
+			if (a > 0) {
+				src_buf[a - 1] = 'z';
+				PCUT_ASSERT_NULL(memchr(src_buf + a, 'z', n));
+			}
+		}
+	}
+}
+
 PCUT_EXPORT(mem);
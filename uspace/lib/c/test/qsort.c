@@ -26,8 +26,12 @@
  * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <macros.h>
+#include <mem.h>
 #include <pcut/pcut.h>
 #include <qsort.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -171,4 +175,96 @@ PCUT_TEST(pseudorandom_seq)
 	free(seq2);
 }
 
+enum {
+	/** Length of long test sequences */
+	test_long_len = 2000
+};
+
+/** Key of a long sequence element (stored in its first two bytes) */
+static uint16_t elem_key(const void *e)
+{
+	uint16_t key;
+
+	memcpy(&key, e, sizeof(key));
+	return key;
+}
+
+static int elem_cmp(const void *a, const void *b)
+{
+	uint16_t ka = elem_key(a);
+	uint16_t kb = elem_key(b);
+
+	return (ka > kb) - (ka < kb);
+}
+
+/** Sort a long sequence with elements of @a size bytes.
+ *
+ * The sequence is increasing, decreasing, pseudorandom with many
+ * duplicates, constant or organ pipe shaped, depending on @a kind.
+ *
+ * @return True if the result is sorted and has the same key sum
+ */
+static bool sort_long_seq(size_t size, int kind)
+{
+	char *seq;
+	unsigned long sum = 0;
+	uint16_t key;
+	int v = 1;
+	int i;
+
+	seq = calloc(test_long_len, size);
+	if (seq == NULL)
+		return false;
+
+	for (i = 0; i < test_long_len; i++) {
+		switch (kind) {
+		case 0:
+			key = i;
+			break;
+		case 1:
+			key = test_long_len - i;
+			break;
+		case 2:
+			key = v % 500;
+			v = seq_next(v);
+			break;
+		case 3:
+			key = 42;
+			break;
+		default:
+			key = min(i, test_long_len - i);
+			break;
+		}
+
+		memcpy(seq + i * size, &key, sizeof(key));
+		sum += key;
+	}
+
+	qsort(seq, test_long_len, size, elem_cmp);
+
+	for (i = 0; i < test_long_len; i++) {
+		if (i > 0 && elem_cmp(seq + (i - 1) * size, seq + i * size) > 0)
+			break;
+		sum -= elem_key(seq + i * size);
+	}
+
+	free(seq);
+	return i == test_long_len && sum == 0;
+}
+
+/** Test sorting long sequences with elements of various sizes.
+ *
+ * This covers the specialized swaps of 4, 8 and 16 byte elements as well
+ * as the generic ones.
+ */
+PCUT_TEST(long_seq)
+{
+	size_t sizes[] = { 2, 3, 4, 8, 12, 16, 24 };
+
+	for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+		for (int kind = 0; kind < 5; kind++)
+			PCUT_ASSERT_TRUE(sort_long_seq(sizes[i], kind));
+	}
+}
+
 PCUT_EXPORT(qsort);
@@ -720,6 +720,41 @@ PCUT_TEST(strlen_nonempty)
 	PCUT_ASSERT_INT_EQUALS(3, strlen("abc"));
 }
 
+/** strlen function with various lengths and alignments */
+PCUT_TEST(strlen_long)
+{
+	char buf[200];
+
+	for (size_t n = 0; n < 150; n++) {
+		for (size_t a = 0; a < 40; a++) {
+			memset(buf, 'a', sizeof(buf));
+			buf[a + n] = '\0';
+			PCUT_ASSERT_INT_EQUALS(n, strlen(buf + a));
+			PCUT_ASSERT_INT_EQUALS(n, strnlen(buf + a, n + 1));
+			PCUT_ASSERT_INT_EQUALS(n / 2, strnlen(buf + a, n / 2));
+		}
+	}
+}
+
+/** strchr function with various lengths and alignments */
+PCUT_TEST(strchr_long)
+{
+	char buf[200];
+
+	for (size_t n = 0; n < 150; n++) {
+		for (size_t a = 0; a < 40; a++) {
+			memset(buf, 'a', sizeof(buf));
+			buf[a + n] = 'b';
+			buf[a + n + 1] = '\0';
+			PCUT_ASSERT_TRUE(strchr(buf + a, 'b') == buf + a + n);
+			PCUT_ASSERT_TRUE(strchr(buf + a, '\0') == buf + a + n + 1);
+
+			buf[a + n] = '\0';
+			PCUT_ASSERT_NULL(strchr(buf + a, 'b'));
+		}
+	}
+}
+
 /** strlen function with empty string and non-zero limit */
 PCUT_TEST(strnlen_empty_short)
 {
@@ -0,0 +1,515 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_ADT_FLAT_HASH_MAP
+#define LIBCPP_BITS_ADT_FLAT_HASH_MAP
+
+#include <__bits/adt/flat_hash_table.hpp>
+#include <__bits/adt/key_extractors.hpp>
+#include <initializer_list>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace std::__ext
+{
+    /**
+     * Open addressing counterpart of std::unordered_map,
+     * see aux::flat_hash_table for details.
+     *
+     * Note: Unlike in std::unordered_map, references and
+     *       iterators are invalidated by every insertion and
+     *       erasure may move the elements that followed the
+     *       erased one. There is no bucket interface.
+     */
+    template<
+        class Key, class Value,
+        class Hash = hash<Key>,
+        class Pred = equal_to<Key>,
+        class Alloc = allocator<pair<const Key, Value>>
+    >
+    class flat_hash_map
+    {
+        private:
+            using table_type = aux::flat_hash_table<
+                pair<const Key, Value>, Key,
+                aux::key_value_key_extractor<Key, Value>,
+                Hash, Pred, Alloc
+            >;
+
+        public:
+            using key_type        = Key;
+            using mapped_type     = Value;
+            using value_type      = pair<const key_type, mapped_type>;
+            using hasher          = Hash;
+            using key_equal       = Pred;
+            using allocator_type  = Alloc;
+            using pointer         = typename allocator_traits<allocator_type>::pointer;
+            using const_pointer   = typename allocator_traits<allocator_type>::const_pointer;
+            using reference       = value_type&;
+            using const_reference = const value_type&;
+            using size_type       = size_t;
+            using difference_type = ptrdiff_t;
+
+            using iterator       = typename table_type::iterator;
+            using const_iterator = typename table_type::const_iterator;
+
+            flat_hash_map()
+                : flat_hash_map{default_bucket_count_}
+            { /* DUMMY BODY */ }
+
+            explicit flat_hash_map(size_type bucket_count,
+                                   const hasher& hf = hasher{},
+                                   const key_equal& eql = key_equal{},
+                                   const allocator_type& alloc = allocator_type{})
+                : table_{bucket_count, hf, eql, alloc}
+            { /* DUMMY BODY */ }
+
+            template<class InputIterator>
+            flat_hash_map(InputIterator first, InputIterator last,
+                          size_type bucket_count = default_bucket_count_,
+                          const hasher& hf = hasher{},
+                          const key_equal& eql = key_equal{},
+                          const allocator_type& alloc = allocator_type{})
+                : flat_hash_map{bucket_count, hf, eql, alloc}
+            {
+                insert(first, last);
+            }
+
+            flat_hash_map(const flat_hash_map& other) = default;
+
+            flat_hash_map(flat_hash_map&& other) = default;
+
+            explicit flat_hash_map(const allocator_type& alloc)
+                : table_{default_bucket_count_, hasher{}, key_equal{}, alloc}
+            { /* DUMMY BODY */ }
+
+            flat_hash_map(const flat_hash_map& other, const allocator_type& alloc)
+                : table_{other.table_, alloc}
+            { /* DUMMY BODY */ }
+
+            flat_hash_map(flat_hash_map&& other, const allocator_type& alloc)
+                : table_{move(other.table_), alloc}
+            { /* DUMMY BODY */ }
+
+            flat_hash_map(initializer_list<value_type> init,
+                          size_type bucket_count = default_bucket_count_,
+                          const hasher& hf = hasher{},
+                          const key_equal& eql = key_equal{},
+                          const allocator_type& alloc = allocator_type{})
+                : flat_hash_map{bucket_count, hf, eql, alloc}
+            {
+                insert(init.begin(), init.end());
+            }
+
+            flat_hash_map& operator=(const flat_hash_map& other) = default;
+
+            flat_hash_map& operator=(flat_hash_map&& other) = default;
+
+            flat_hash_map& operator=(initializer_list<value_type> init)
+            {
+                table_.clear();
+                table_.reserve(init.size());
+
+                insert(init.begin(), init.end());
+
+                return *this;
+            }
+
+            allocator_type get_allocator() const noexcept
+            {
+                return table_.get_allocator();
+            }
+
+            bool empty() const noexcept
+            {
+                return table_.empty();
+            }
+
+            size_type size() const noexcept
+            {
+                return table_.size();
+            }
+
+            size_type max_size() const noexcept
+            {
+                return table_.max_size();
+            }
+
+            iterator begin() noexcept
+            {
+                return table_.begin();
+            }
+
+            const_iterator begin() const noexcept
+            {
+                return table_.begin();
+            }
+
+            iterator end() noexcept
+            {
+                return table_.end();
+            }
+
+            const_iterator end() const noexcept
+            {
+                return table_.end();
+            }
+
+            const_iterator cbegin() const noexcept
+            {
+                return table_.begin();
+            }
+
+            const_iterator cend() const noexcept
+            {
+                return table_.end();
+            }
+
+            template<class... Args>
+            pair<iterator, bool> emplace(Args&&... args)
+            {
+                return table_.emplace(forward<Args>(args)...);
+            }
+
+            template<class... Args>
+            iterator emplace_hint(const_iterator, Args&&... args)
+            {
+                return emplace(forward<Args>(args)...).first;
+            }
+
+            pair<iterator, bool> insert(const value_type& val)
+            {
+                return table_.emplace_key(val.first, val);
+            }
+
+            pair<iterator, bool> insert(value_type&& val)
+            {
+                return table_.emplace_key(val.first, move(val));
+            }
+
+            template<class T>
+            pair<iterator, bool> insert(
+                T&& val,
+                enable_if_t<is_constructible_v<value_type, T&&>>* = nullptr
+            )
+            {
+                return emplace(forward<T>(val));
+            }
+
+            iterator insert(const_iterator, const value_type& val)
+            {
+                return insert(val).first;
+            }
+
+            iterator insert(const_iterator, value_type&& val)
+            {
+                return insert(move(val)).first;
+            }
+
+            template<class InputIterator>
+            void insert(InputIterator first, InputIterator last)
+            {
+                while (first != last)
+                    insert(*first++);
+            }
+
+            void insert(initializer_list<value_type> init)
+            {
+                insert(init.begin(), init.end());
+            }
+
+            template<class... Args>
+            pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
+            {
+                return table_.emplace_key_with(
+                    key, [&](allocator_type& alloc, value_type* slot) {
+                        construct_(alloc, slot, key, forward<Args>(args)...);
+                    }
+                );
+            }
+
+            template<class... Args>
+            pair<iterator, bool> try_emplace(key_type&& key, Args&&... args)
+            {
+                return table_.emplace_key_with(
+                    key, [&](allocator_type& alloc, value_type* slot) {
+                        construct_(alloc, slot, move(key), forward<Args>(args)...);
+                    }
+                );
+            }
+
+            template<class... Args>
+            iterator try_emplace(const_iterator, const key_type& key, Args&&... args)
+            {
+                return try_emplace(key, forward<Args>(args)...).first;
+            }
+
+            template<class... Args>
+            iterator try_emplace(const_iterator, key_type&& key, Args&&... args)
+            {
+                return try_emplace(move(key), forward<Args>(args)...).first;
+            }
+
+            template<class T>
+            pair<iterator, bool> insert_or_assign(const key_type& key, T&& val)
+            {
+                auto res = try_emplace(key, forward<T>(val));
+                if (!res.second)
+                    res.first->second = forward<T>(val);
+
+                return res;
+            }
+
+            template<class T>
+            pair<iterator, bool> insert_or_assign(key_type&& key, T&& val)
+            {
+                auto res = try_emplace(move(key), forward<T>(val));
+                if (!res.second)
+                    res.first->second = forward<T>(val);
+
+                return res;
+            }
+
+            template<class T>
+            iterator insert_or_assign(const_iterator, const key_type& key, T&& val)
+            {
+                return insert_or_assign(key, forward<T>(val)).first;
+            }
+
+            template<class T>
+            iterator insert_or_assign(const_iterator, key_type&& key, T&& val)
+            {
+                return insert_or_assign(move(key), forward<T>(val)).first;
+            }
+
+            iterator erase(const_iterator position)
+            {
+                return table_.erase(position);
+            }
+
+            iterator erase(iterator position)
+            {
+                return table_.erase(const_iterator{position});
+            }
+
+            size_type erase(const key_type& key)
+            {
+                return table_.erase(key);
+            }
+
+            void clear() noexcept
+            {
+                table_.clear();
+            }
+
+            void swap(flat_hash_map& other)
+                noexcept(allocator_traits<allocator_type>::is_always_equal::value &&
+                         noexcept(std::swap(declval<hasher&>(), declval<hasher&>())) &&
+                         noexcept(std::swap(declval<key_equal&>(), declval<key_equal&>())))
+            {
+                table_.swap(other.table_);
+            }
+
+            hasher hash_function() const
+            {
+                return table_.hash_function();
+            }
+
+            key_equal key_eq() const
+            {
+                return table_.key_eq();
+            }
+
+            iterator find(const key_type& key)
+            {
+                return table_.find(key);
+            }
+
+            const_iterator find(const key_type& key) const
+            {
+                return table_.find(key);
+            }
+
+            size_type count(const key_type& key) const
+            {
+                return contains(key) ? 1 : 0;
+            }
+
+            bool contains(const key_type& key) const
+            {
+                return table_.find(key) != table_.end();
+            }
+
+            pair<iterator, iterator> equal_range(const key_type& key)
+            {
+                auto it = find(key);
+                if (it == end())
+                    return make_pair(it, it);
+
+                auto last = it;
+
+                return make_pair(it, ++last);
+            }
+
+            pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+            {
+                auto it = find(key);
+                if (it == end())
+                    return make_pair(it, it);
+
+                auto last = it;
+
+                return make_pair(it, ++last);
+            }
+
+            mapped_type& operator[](const key_type& key)
+            {
+                return try_emplace(key).first->second;
+            }
+
+            mapped_type& operator[](key_type&& key)
+            {
+                return try_emplace(move(key)).first->second;
+            }
+
+            mapped_type& at(const key_type& key)
+            {
+                auto it = find(key);
+
+                // TODO: throw out_of_range if it == end()
+                return it->second;
+            }
+
+            const mapped_type& at(const key_type& key) const
+            {
+                auto it = find(key);
+
+                // TODO: throw out_of_range if it == end()
+                return it->second;
+            }
+
+            size_type bucket_count() const noexcept
+            {
+                return table_.bucket_count();
+            }
+
+            float load_factor() const noexcept
+            {
+                return table_.load_factor();
+            }
+
+            float max_load_factor() const noexcept
+            {
+                return table_.max_load_factor();
+            }
+
+            void rehash(size_type bucket_count)
+            {
+                table_.rehash(bucket_count);
+            }
+
+            void reserve(size_type count)
+            {
+                table_.reserve(count);
+            }
+
+            /**
+             * Nonzero while elements are being incrementally
+             * moved from the previous array after growth.
+             */
+            size_type __migrating_bucket_count() const noexcept
+            {
+                return table_.migrating_capacity();
+            }
+
+        private:
+            table_type table_;
+
+            static constexpr size_type default_bucket_count_{0};
+
+            /**
+             * Note: Our tuple cannot hold rvalue references, so
+             *       piecewise construction is not an option and
+             *       the mapped value is constructed aside unless
+             *       it is given directly.
+             */
+            template<class K, class... Args>
+            static void construct_(allocator_type& alloc, value_type* slot,
+                                   K&& key, Args&&... args)
+            {
+                if constexpr (sizeof...(Args) == 1)
+                {
+                    allocator_traits<allocator_type>::construct(
+                        alloc, slot, forward<K>(key), forward<Args>(args)...
+                    );
+                }
+                else
+                {
+                    allocator_traits<allocator_type>::construct(
+                        alloc, slot, forward<K>(key),
+                        mapped_type(forward<Args>(args)...)
+                    );
+                }
+            }
+    };
+
+    template<class K, class V, class H, class P, class A>
+    void swap(flat_hash_map<K, V, H, P, A>& lhs, flat_hash_map<K, V, H, P, A>& rhs)
+        noexcept(noexcept(lhs.swap(rhs)))
+    {
+        lhs.swap(rhs);
+    }
+
+    template<class K, class V, class H, class P, class A>
+    bool operator==(const flat_hash_map<K, V, H, P, A>& lhs,
+                    const flat_hash_map<K, V, H, P, A>& rhs)
+    {
+        if (lhs.size() != rhs.size())
+            return false;
+
+        for (const auto& x: lhs)
+        {
+            auto it = rhs.find(x.first);
+            if (it == rhs.end() || !(it->second == x.second))
+                return false;
+        }
+
+        return true;
+    }
+
+    template<class K, class V, class H, class P, class A>
+    bool operator!=(const flat_hash_map<K, V, H, P, A>& lhs,
+                    const flat_hash_map<K, V, H, P, A>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+}
+
+#endif
@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_ADT_FLAT_HASH_SET
+#define LIBCPP_BITS_ADT_FLAT_HASH_SET
+
+#include <__bits/adt/flat_hash_table.hpp>
+#include <__bits/adt/key_extractors.hpp>
+#include <initializer_list>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace std::__ext
+{
+    /**
+     * Open addressing counterpart of std::unordered_set,
+     * with the same iterator invalidation caveats as
+     * flat_hash_map.
+     */
+    template<
+        class Key,
+        class Hash = hash<Key>,
+        class Pred = equal_to<Key>,
+        class Alloc = allocator<Key>
+    >
+    class flat_hash_set
+    {
+        private:
+            using table_type = aux::flat_hash_table<
+                Key, Key, aux::key_no_value_key_extractor<Key>,
+                Hash, Pred, Alloc
+            >;
+
+        public:
+            using key_type        = Key;
+            using value_type      = Key;
+            using hasher          = Hash;
+            using key_equal       = Pred;
+            using allocator_type  = Alloc;
+            using pointer         = typename allocator_traits<allocator_type>::pointer;
+            using const_pointer   = typename allocator_traits<allocator_type>::const_pointer;
+            using reference       = value_type&;
+            using const_reference = const value_type&;
+            using size_type       = size_t;
+            using difference_type = ptrdiff_t;
+
+            /**
+             * Keys must not be modified through the iterators.
+             */
+            using iterator       = typename table_type::const_iterator;
+            using const_iterator = typename table_type::const_iterator;
+
+            flat_hash_set()
+                : flat_hash_set{default_bucket_count_}
+            { /* DUMMY BODY */ }
+
+            explicit flat_hash_set(size_type bucket_count,
+                                   const hasher& hf = hasher{},
+                                   const key_equal& eql = key_equal{},
+                                   const allocator_type& alloc = allocator_type{})
+                : table_{bucket_count, hf, eql, alloc}
+            { /* DUMMY BODY */ }
+
+            template<class InputIterator>
+            flat_hash_set(InputIterator first, InputIterator last,
+                          size_type bucket_count = default_bucket_count_,
+                          const hasher& hf = hasher{},
+                          const key_equal& eql = key_equal{},
+                          const allocator_type& alloc = allocator_type{})
+                : flat_hash_set{bucket_count, hf, eql, alloc}
+            {
+                insert(first, last);
+            }
+
+            flat_hash_set(const flat_hash_set& other) = default;
+
+            flat_hash_set(flat_hash_set&& other) = default;
+
+            explicit flat_hash_set(const allocator_type& alloc)
+                : table_{default_bucket_count_, hasher{}, key_equal{}, alloc}
+            { /* DUMMY BODY */ }
+
+            flat_hash_set(const flat_hash_set& other, const allocator_type& alloc)
+                : table_{other.table_, alloc}
+            { /* DUMMY BODY */ }
+
+            flat_hash_set(flat_hash_set&& other, const allocator_type& alloc)
+                : table_{move(other.table_), alloc}
+            { /* DUMMY BODY */ }
+
+            flat_hash_set(initializer_list<value_type> init,
+                          size_type bucket_count = default_bucket_count_,
+                          const hasher& hf = hasher{},
+                          const key_equal& eql = key_equal{},
+                          const allocator_type& alloc = allocator_type{})
+                : flat_hash_set{bucket_count, hf, eql, alloc}
+            {
+                insert(init.begin(), init.end());
+            }
+
+            flat_hash_set& operator=(const flat_hash_set& other) = default;
+
+            flat_hash_set& operator=(flat_hash_set&& other) = default;
+
+            flat_hash_set& operator=(initializer_list<value_type> init)
+            {
+                table_.clear();
+                table_.reserve(init.size());
+
+                insert(init.begin(), init.end());
+
+                return *this;
+            }
+
+            allocator_type get_allocator() const noexcept
+            {
+                return table_.get_allocator();
+            }
+
+            bool empty() const noexcept
+            {
+                return table_.empty();
+            }
+
+            size_type size() const noexcept
+            {
+                return table_.size();
+            }
+
+            size_type max_size() const noexcept
+            {
+                return table_.max_size();
+            }
+
+            iterator begin() const noexcept
+            {
+                return table_.begin();
+            }
+
+            iterator end() const noexcept
+            {
+                return table_.end();
+            }
+
+            const_iterator cbegin() const noexcept
+            {
+                return table_.begin();
+            }
+
+            const_iterator cend() const noexcept
+            {
+                return table_.end();
+            }
+
+            template<class... Args>
+            pair<iterator, bool> emplace(Args&&... args)
+            {
+                return table_.emplace(forward<Args>(args)...);
+            }
+
+            template<class... Args>
+            iterator emplace_hint(const_iterator, Args&&... args)
+            {
+                return emplace(forward<Args>(args)...).first;
+            }
+
+            pair<iterator, bool> insert(const value_type& val)
+            {
+                return table_.emplace_key(val, val);
+            }
+
+            pair<iterator, bool> insert(value_type&& val)
+            {
+                return table_.emplace_key(val, move(val));
+            }
+
+            iterator insert(const_iterator, const value_type& val)
+            {
+                return insert(val).first;
+            }
+
+            iterator insert(const_iterator, value_type&& val)
+            {
+                return insert(move(val)).first;
+            }
+
+            template<class InputIterator>
+            void insert(InputIterator first, InputIterator last)
+            {
+                while (first != last)
+                    insert(*first++);
+            }
+
+            void insert(initializer_list<value_type> init)
+            {
+                insert(init.begin(), init.end());
+            }
+
+            iterator erase(const_iterator position)
+            {
+                return table_.erase(position);
+            }
+
+            size_type erase(const key_type& key)
+            {
+                return table_.erase(key);
+            }
+
+            void clear() noexcept
+            {
+                table_.clear();
+            }
+
+            void swap(flat_hash_set& other)
+                noexcept(allocator_traits<allocator_type>::is_always_equal::value &&
+                         noexcept(std::swap(declval<hasher&>(), declval<hasher&>())) &&
+                         noexcept(std::swap(declval<key_equal&>(), declval<key_equal&>())))
+            {
+                table_.swap(other.table_);
+            }
+
+            hasher hash_function() const
+            {
+                return table_.hash_function();
+            }
+
+            key_equal key_eq() const
+            {
+                return table_.key_eq();
+            }
+
+            iterator find(const key_type& key) const
+            {
+                return table_.find(key);
+            }
+
+            size_type count(const key_type& key) const
+            {
+                return contains(key) ? 1 : 0;
+            }
+
+            bool contains(const key_type& key) const
+            {
+                return table_.find(key) != table_.end();
+            }
+
+            pair<iterator, iterator> equal_range(const key_type& key) const
+            {
+                auto it = find(key);
+                if (it == end())
+                    return make_pair(it, it);
+
+                auto last = it;
+
+                return make_pair(it, ++last);
+            }
+
+            size_type bucket_count() const noexcept
+            {
+                return table_.bucket_count();
+            }
+
+            float load_factor() const noexcept
+            {
+                return table_.load_factor();
+            }
+
+            float max_load_factor() const noexcept
+            {
+                return table_.max_load_factor();
+            }
+
+            void rehash(size_type bucket_count)
+            {
+                table_.rehash(bucket_count);
+            }
+
+            void reserve(size_type count)
+            {
+                table_.reserve(count);
+            }
+
+            size_type __migrating_bucket_count() const noexcept
+            {
+                return table_.migrating_capacity();
+            }
+
+        private:
+            table_type table_;
+
+            static constexpr size_type default_bucket_count_{0};
+    };
+
+    template<class K, class H, class P, class A>
+    void swap(flat_hash_set<K, H, P, A>& lhs, flat_hash_set<K, H, P, A>& rhs)
+        noexcept(noexcept(lhs.swap(rhs)))
+    {
+        lhs.swap(rhs);
+    }
+
+    template<class K, class H, class P, class A>
+    bool operator==(const flat_hash_set<K, H, P, A>& lhs,
+                    const flat_hash_set<K, H, P, A>& rhs)
+    {
+        if (lhs.size() != rhs.size())
+            return false;
+
+        for (const auto& x: lhs)
+        {
+            if (!rhs.contains(x))
+                return false;
+        }
+
+        return true;
+    }
+
+    template<class K, class H, class P, class A>
+    bool operator!=(const flat_hash_set<K, H, P, A>& lhs,
+                    const flat_hash_set<K, H, P, A>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+}
+
+#endif
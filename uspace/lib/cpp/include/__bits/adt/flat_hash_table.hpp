@@ -0,0 +1,1072 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_ADT_FLAT_HASH_TABLE
+#define LIBCPP_BITS_ADT_FLAT_HASH_TABLE
+
+#include <__bits/memory/allocator_traits.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace std::aux
+{
+    /**
+     * Control bytes of the open addressing tables, one per slot,
+     * stored in a separate array so that a whole group of them
+     * can be compared against a hash fragment at once. An empty
+     * slot has the high bit set, a full slot stores the low seven
+     * bits of the hash of its key (H2).
+     */
+    inline constexpr uint8_t flat_hash_ctrl_empty{0x80};
+
+#if defined(__SSE2__)
+    /**
+     * SSE2 group of 16 control bytes, matched with a single
+     * compare and a movemask.
+     */
+    class flat_hash_group
+    {
+        public:
+            using mask_type = uint32_t;
+
+            static constexpr size_t width{16};
+
+            explicit flat_hash_group(const uint8_t* ctrl) noexcept
+            {
+                __builtin_memcpy(&ctrl_, ctrl, width);
+            }
+
+            mask_type match(uint8_t h2) const noexcept
+            {
+                auto eq = (ctrl_ == static_cast<char>(h2));
+
+                return static_cast<mask_type>(
+                    __builtin_ia32_pmovmskb128(reinterpret_cast<vector_type>(eq))
+                );
+            }
+
+            mask_type match_empty() const noexcept
+            {
+                return static_cast<mask_type>(__builtin_ia32_pmovmskb128(ctrl_));
+            }
+
+            static size_t index(mask_type mask) noexcept
+            {
+                return static_cast<size_t>(__builtin_ctz(mask));
+            }
+
+        private:
+            using vector_type = char __attribute__((vector_size(16)));
+
+            vector_type ctrl_;
+    };
+#else
+    /**
+     * Portable group of 8 control bytes packed into a single
+     * 64-bit word, every byte of a mask has either its high
+     * bit set or is zero.
+     *
+     * Note: The zero byte detection in match() can report
+     *       a false positive for a full slot that follows
+     *       a real match, which is harmless because every
+     *       candidate is compared by key anyway. Empty slots
+     *       are never reported.
+     */
+    class flat_hash_group
+    {
+        public:
+            using mask_type = uint64_t;
+
+            static constexpr size_t width{8};
+
+            explicit flat_hash_group(const uint8_t* ctrl) noexcept
+            {
+                __builtin_memcpy(&ctrl_, ctrl, width);
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+                ctrl_ = __builtin_bswap64(ctrl_);
+#endif
+            }
+
+            mask_type match(uint8_t h2) const noexcept
+            {
+                auto x = ctrl_ ^ (lsbs_ * h2);
+
+                return (x - lsbs_) & ~x & msbs_;
+            }
+
+            mask_type match_empty() const noexcept
+            {
+                return ctrl_ & msbs_;
+            }
+
+            static size_t index(mask_type mask) noexcept
+            {
+                return static_cast<size_t>(__builtin_ctzll(mask)) >> 3;
+            }
+
+        private:
+            static constexpr uint64_t lsbs_{0x0101010101010101ULL};
+            static constexpr uint64_t msbs_{0x8080808080808080ULL};
+
+            uint64_t ctrl_;
+    };
+#endif
+
+    /**
+     * Moves a value between two slots, the keys of maps are
+     * stored as const so they need to be cast away in order
+     * to be moved instead of copied.
+     */
+    template<class Alloc, class T>
+    void flat_hash_relocate(Alloc& alloc, T* to, T* from)
+    {
+        allocator_traits<Alloc>::construct(alloc, to, move(*from));
+        allocator_traits<Alloc>::destroy(alloc, from);
+    }
+
+    template<class Alloc, class K, class V>
+    void flat_hash_relocate(Alloc& alloc, pair<const K, V>* to, pair<const K, V>* from)
+    {
+        allocator_traits<Alloc>::construct(
+            alloc, to, move(const_cast<K&>(from->first)), move(from->second)
+        );
+        allocator_traits<Alloc>::destroy(alloc, from);
+    }
+
+    template<class Table, class Value, class Reference, class Pointer>
+    class flat_hash_table_const_iterator;
+
+    /**
+     * The iterators address slots by their logical position,
+     * positions below the capacity of the current array map
+     * to its slots starting right after an empty slot (see
+     * flat_hash_table::array::origin) and the rest map to
+     * the array that is still being migrated.
+     */
+    template<class Table, class Value, class Reference, class Pointer>
+    class flat_hash_table_iterator
+    {
+        public:
+            using value_type      = Value;
+            using reference       = Reference;
+            using pointer         = Pointer;
+            using difference_type = ptrdiff_t;
+
+            using iterator_category = forward_iterator_tag;
+
+            flat_hash_table_iterator(Table* table = nullptr, size_t pos = size_t{})
+                : table_{table}, pos_{pos}
+            { /* DUMMY BODY */ }
+
+            flat_hash_table_iterator(const flat_hash_table_iterator&) = default;
+            flat_hash_table_iterator& operator=(const flat_hash_table_iterator&) = default;
+
+            reference operator*() const
+            {
+                return *table_->slot_at_(pos_);
+            }
+
+            pointer operator->() const
+            {
+                return table_->slot_at_(pos_);
+            }
+
+            flat_hash_table_iterator& operator++()
+            {
+                pos_ = table_->next_full_(pos_ + 1);
+
+                return *this;
+            }
+
+            flat_hash_table_iterator operator++(int)
+            {
+                auto tmp = *this;
+                ++(*this);
+
+                return tmp;
+            }
+
+            size_t position() const noexcept
+            {
+                return pos_;
+            }
+
+            bool operator==(const flat_hash_table_iterator& other) const noexcept
+            {
+                return pos_ == other.pos_;
+            }
+
+            bool operator!=(const flat_hash_table_iterator& other) const noexcept
+            {
+                return pos_ != other.pos_;
+            }
+
+        private:
+            Table* table_;
+            size_t pos_;
+
+            template<class, class, class, class>
+            friend class flat_hash_table_const_iterator;
+    };
+
+    template<class Table, class Value, class Reference, class Pointer>
+    class flat_hash_table_const_iterator
+    {
+        public:
+            using value_type      = Value;
+            using reference       = Reference;
+            using pointer         = Pointer;
+            using difference_type = ptrdiff_t;
+
+            using iterator_category = forward_iterator_tag;
+
+            flat_hash_table_const_iterator(const Table* table = nullptr, size_t pos = size_t{})
+                : table_{table}, pos_{pos}
+            { /* DUMMY BODY */ }
+
+            template<class NonConstReference, class NonConstPointer>
+            flat_hash_table_const_iterator(
+                const flat_hash_table_iterator<
+                    Table, Value, NonConstReference, NonConstPointer
+                >& other
+            )
+                : table_{other.table_}, pos_{other.pos_}
+            { /* DUMMY BODY */ }
+
+            flat_hash_table_const_iterator(const flat_hash_table_const_iterator&) = default;
+            flat_hash_table_const_iterator& operator=(const flat_hash_table_const_iterator&) = default;
+
+            reference operator*() const
+            {
+                return *table_->slot_at_(pos_);
+            }
+
+            pointer operator->() const
+            {
+                return table_->slot_at_(pos_);
+            }
+
+            flat_hash_table_const_iterator& operator++()
+            {
+                pos_ = table_->next_full_(pos_ + 1);
+
+                return *this;
+            }
+
+            flat_hash_table_const_iterator operator++(int)
+            {
+                auto tmp = *this;
+                ++(*this);
+
+                return tmp;
+            }
+
+            size_t position() const noexcept
+            {
+                return pos_;
+            }
+
+            bool operator==(const flat_hash_table_const_iterator& other) const noexcept
+            {
+                return pos_ == other.pos_;
+            }
+
+            bool operator!=(const flat_hash_table_const_iterator& other) const noexcept
+            {
+                return pos_ != other.pos_;
+            }
+
+        private:
+            const Table* table_;
+            size_t pos_;
+    };
+
+    /**
+     * Open addressing hash table with unique keys used by
+     * flat_hash_map and flat_hash_set. Values are stored
+     * directly in a power of two sized slot array, probed
+     * linearly one group of control bytes at a time.
+     *
+     * Erasure does not leave tombstones behind, instead the
+     * elements that follow the erased one in its probe run
+     * are shifted back (backward shift deletion). Growing
+     * keeps the previous array around and moves a bounded
+     * number of its slots into the new one on every insertion,
+     * so that no single insertion has to rehash the whole
+     * table; lookups consult both arrays in the meantime.
+     */
+    template<
+        class Value, class Key, class KeyExtractor,
+        class Hasher, class KeyEq, class Alloc
+    >
+    class flat_hash_table
+    {
+        public:
+            using value_type      = Value;
+            using key_type        = Key;
+            using size_type       = size_t;
+            using allocator_type  = Alloc;
+            using key_extract     = KeyExtractor;
+            using hasher          = Hasher;
+            using key_equal       = KeyEq;
+
+            using alloc_traits = allocator_traits<allocator_type>;
+
+            using iterator       = flat_hash_table_iterator<
+                flat_hash_table, value_type, value_type&, value_type*
+            >;
+            using const_iterator = flat_hash_table_const_iterator<
+                flat_hash_table, value_type, const value_type&, const value_type*
+            >;
+
+            using group = flat_hash_group;
+
+            flat_hash_table(size_type capacity, const hasher& hf, const key_equal& eql,
+                            const allocator_type& alloc)
+                : current_{}, old_{}, old_next_{}, hasher_{hf},
+                  key_eq_{eql}, key_extractor_{}, allocator_{alloc}
+            {
+                if (capacity > 0)
+                    current_ = allocate_(capacity_for_(capacity));
+            }
+
+            flat_hash_table(const flat_hash_table& other)
+                : flat_hash_table{
+                    other, alloc_traits::select_on_container_copy_construction(
+                        other.allocator_
+                    )
+                  }
+            { /* DUMMY BODY */ }
+
+            flat_hash_table(const flat_hash_table& other, const allocator_type& alloc)
+                : flat_hash_table{0, other.hasher_, other.key_eq_, alloc}
+            {
+                insert_all_(other);
+            }
+
+            flat_hash_table(flat_hash_table&& other)
+                : current_{other.current_}, old_{other.old_}, old_next_{other.old_next_},
+                  hasher_{move(other.hasher_)}, key_eq_{move(other.key_eq_)},
+                  key_extractor_{}, allocator_{move(other.allocator_)}
+            {
+                other.current_ = array{};
+                other.old_ = array{};
+                other.old_next_ = 0;
+            }
+
+            flat_hash_table(flat_hash_table&& other, const allocator_type& alloc)
+                : flat_hash_table{0, other.hasher_, other.key_eq_, alloc}
+            {
+                if (alloc == other.allocator_)
+                    swap(other);
+                else
+                    insert_all_(other);
+            }
+
+            flat_hash_table& operator=(const flat_hash_table& other)
+            {
+                if (this == &other)
+                    return *this;
+
+                clear();
+                hasher_ = other.hasher_;
+                key_eq_ = other.key_eq_;
+                insert_all_(other);
+
+                return *this;
+            }
+
+            flat_hash_table& operator=(flat_hash_table&& other)
+            {
+                flat_hash_table tmp{move(other)};
+                swap(tmp);
+
+                return *this;
+            }
+
+            ~flat_hash_table()
+            {
+                release_(current_);
+                release_(old_);
+            }
+
+            iterator begin() noexcept
+            {
+                return iterator{this, next_full_(0)};
+            }
+
+            const_iterator begin() const noexcept
+            {
+                return const_iterator{this, next_full_(0)};
+            }
+
+            iterator end() noexcept
+            {
+                return iterator{this, end_position_()};
+            }
+
+            const_iterator end() const noexcept
+            {
+                return const_iterator{this, end_position_()};
+            }
+
+            bool empty() const noexcept
+            {
+                return size() == 0;
+            }
+
+            size_type size() const noexcept
+            {
+                return current_.size + old_.size;
+            }
+
+            size_type max_size() const noexcept
+            {
+                return alloc_traits::max_size(allocator_);
+            }
+
+            size_type bucket_count() const noexcept
+            {
+                return current_.capacity;
+            }
+
+            float load_factor() const noexcept
+            {
+                if (current_.capacity == 0)
+                    return 0.f;
+
+                return size() / static_cast<float>(current_.capacity);
+            }
+
+            static constexpr float max_load_factor() noexcept
+            {
+                return max_load_numerator_ / static_cast<float>(max_load_denominator_);
+            }
+
+            template<class... Args>
+            pair<iterator, bool> emplace(Args&&... args)
+            {
+                /**
+                 * The key is not known until the value is
+                 * constructed, so we construct it aside and
+                 * relocate it into the slot once we know there
+                 * is no equivalent key.
+                 */
+                alignas(value_type) unsigned char storage[sizeof(value_type)];
+                auto tmp = reinterpret_cast<value_type*>(storage);
+                alloc_traits::construct(allocator_, tmp, forward<Args>(args)...);
+
+                auto res = prepare_insert_(key_extractor_(*tmp));
+                if (res.second)
+                {
+                    flat_hash_relocate(allocator_, current_.slots + res.first, tmp);
+
+                    return make_pair(iterator{this, logical_(res.first)}, true);
+                }
+
+                alloc_traits::destroy(allocator_, tmp);
+
+                return make_pair(iterator{this, res.first}, false);
+            }
+
+            /**
+             * Constructs the value from the given arguments
+             * only if there is no value with a key equivalent
+             * to the given one.
+             */
+            template<class... Args>
+            pair<iterator, bool> emplace_key(const key_type& key, Args&&... args)
+            {
+                auto res = prepare_insert_(key);
+                if (res.second)
+                {
+                    alloc_traits::construct(
+                        allocator_, current_.slots + res.first,
+                        forward<Args>(args)...
+                    );
+
+                    return make_pair(iterator{this, logical_(res.first)}, true);
+                }
+
+                return make_pair(iterator{this, res.first}, false);
+            }
+
+            /**
+             * Same as emplace_key, but the value is constructed
+             * by the given function, which gets the allocator
+             * and the slot.
+             */
+            template<class Constructor>
+            pair<iterator, bool> emplace_key_with(const key_type& key, Constructor&& ctor)
+            {
+                auto res = prepare_insert_(key);
+                if (res.second)
+                {
+                    ctor(allocator_, current_.slots + res.first);
+
+                    return make_pair(iterator{this, logical_(res.first)}, true);
+                }
+
+                return make_pair(iterator{this, res.first}, false);
+            }
+
+            size_type erase(const key_type& key)
+            {
+                auto pos = find_position_(key);
+                if (pos == end_position_())
+                    return 0;
+
+                erase_position_(pos);
+
+                return 1;
+            }
+
+            iterator erase(const_iterator it)
+            {
+                auto pos = it.position();
+                erase_position_(pos);
+
+                /**
+                 * If an element got shifted back into the erased
+                 * slot, it has not been visited yet because probe
+                 * runs never wrap around the start of the iteration.
+                 */
+                if (pos_full_(pos))
+                    return iterator{this, pos};
+                else
+                    return iterator{this, next_full_(pos + 1)};
+            }
+
+            void clear() noexcept
+            {
+                clear_(current_);
+                release_(old_);
+                old_ = array{};
+                old_next_ = 0;
+            }
+
+            iterator find(const key_type& key)
+            {
+                return iterator{this, find_position_(key)};
+            }
+
+            const_iterator find(const key_type& key) const
+            {
+                return const_iterator{this, find_position_(key)};
+            }
+
+            /**
+             * Both of these finish any pending incremental
+             * migration, rehash can also shrink the table.
+             */
+            void reserve(size_type count)
+            {
+                auto capacity = capacity_for_(count > size() ? count : size());
+                if (capacity < current_.capacity)
+                    capacity = current_.capacity;
+
+                if (old_.capacity == 0 && capacity == current_.capacity)
+                    return;
+
+                resize_(capacity);
+            }
+
+            void rehash(size_type count)
+            {
+                auto capacity = capacity_for_(size());
+                while (capacity < count)
+                    capacity *= 2;
+
+                if (old_.capacity == 0 && capacity == current_.capacity)
+                    return;
+
+                resize_(capacity);
+            }
+
+            void swap(flat_hash_table& other)
+                noexcept(allocator_traits<allocator_type>::is_always_equal::value)
+            {
+                std::swap(current_, other.current_);
+                std::swap(old_, other.old_);
+                std::swap(old_next_, other.old_next_);
+                std::swap(hasher_, other.hasher_);
+                std::swap(key_eq_, other.key_eq_);
+                std::swap(allocator_, other.allocator_);
+            }
+
+            hasher hash_function() const
+            {
+                return hasher_;
+            }
+
+            key_equal key_eq() const
+            {
+                return key_eq_;
+            }
+
+            allocator_type get_allocator() const noexcept
+            {
+                return allocator_;
+            }
+
+            /**
+             * Number of slots of the array that is being migrated,
+             * zero when there is no migration in progress.
+             */
+            size_type migrating_capacity() const noexcept
+            {
+                return old_.capacity;
+            }
+
+        private:
+            /**
+             * Control array holds capacity + group::width - 1
+             * bytes, the last ones mirror the first group so
+             * that a group can be loaded at any slot without
+             * wrapping. The origin is an empty slot, iteration
+             * starts right after it.
+             */
+            struct array
+            {
+                uint8_t* ctrl;
+                value_type* slots;
+                size_type capacity;
+                size_type size;
+                size_type origin;
+            };
+
+            array current_;
+            array old_;
+            size_type old_next_;
+
+            hasher hasher_;
+            key_equal key_eq_;
+            key_extract key_extractor_;
+            allocator_type allocator_;
+
+            static constexpr size_type max_load_numerator_{7};
+            static constexpr size_type max_load_denominator_{8};
+
+            /**
+             * Number of slots of the old array examined per
+             * insertion, this bounds the latency of a single
+             * insertion while still finishing the migration
+             * long before the new array fills up.
+             */
+            static constexpr size_type migration_step_{2 * group::width};
+
+            static size_type growth_limit_(size_type capacity) noexcept
+            {
+                return capacity / max_load_denominator_ * max_load_numerator_;
+            }
+
+            static size_type capacity_for_(size_type count) noexcept
+            {
+                size_type capacity{group::width};
+                while (growth_limit_(capacity) < count)
+                    capacity *= 2;
+
+                return capacity;
+            }
+
+            size_type hash_(const key_type& key) const
+            {
+                /**
+                 * Our std::hash is identity for integers,
+                 * so the bits have to be mixed before we can
+                 * take H1 from the high and H2 from the low
+                 * part.
+                 */
+                uint64_t x = hasher_(key);
+                x *= 0x9e3779b97f4a7c15ULL;
+
+                return static_cast<size_type>(x ^ (x >> 32));
+            }
+
+            static size_type h1_(size_type hash) noexcept
+            {
+                return hash >> 7;
+            }
+
+            static uint8_t h2_(size_type hash) noexcept
+            {
+                return static_cast<uint8_t>(hash & 0x7F);
+            }
+
+            array allocate_(size_type capacity)
+            {
+                array res{};
+                res.capacity = capacity;
+                res.ctrl = new uint8_t[capacity + group::width - 1];
+                res.slots = alloc_traits::allocate(allocator_, capacity);
+                __builtin_memset(res.ctrl, flat_hash_ctrl_empty, capacity + group::width - 1);
+
+                return res;
+            }
+
+            void clear_(array& a) noexcept
+            {
+                if (a.size > 0)
+                {
+                    for (size_type i = 0; i < a.capacity; ++i)
+                    {
+                        if (a.ctrl[i] != flat_hash_ctrl_empty)
+                            alloc_traits::destroy(allocator_, a.slots + i);
+                    }
+
+                    __builtin_memset(
+                        a.ctrl, flat_hash_ctrl_empty,
+                        a.capacity + group::width - 1
+                    );
+                }
+
+                a.size = 0;
+                a.origin = 0;
+            }
+
+            void release_(array& a) noexcept
+            {
+                if (a.capacity == 0)
+                    return;
+
+                clear_(a);
+                alloc_traits::deallocate(allocator_, a.slots, a.capacity);
+                delete[] a.ctrl;
+            }
+
+            static void set_ctrl_(array& a, size_type idx, uint8_t value) noexcept
+            {
+                a.ctrl[idx] = value;
+                if (idx < group::width - 1)
+                    a.ctrl[a.capacity + idx] = value;
+            }
+
+            size_type find_in_(const array& a, const key_type& key, size_type hash) const
+            {
+                if (a.size == 0)
+                    return a.capacity;
+
+                auto mask = a.capacity - 1;
+                auto idx = h1_(hash) & mask;
+                auto h2 = h2_(hash);
+
+                while (true)
+                {
+                    group g{a.ctrl + idx};
+                    for (auto m = g.match(h2); m; m &= m - 1)
+                    {
+                        auto slot = (idx + group::index(m)) & mask;
+                        if (key_eq_(key_extractor_(a.slots[slot]), key))
+                            return slot;
+                    }
+
+                    if (g.match_empty())
+                        return a.capacity;
+
+                    idx = (idx + group::width) & mask;
+                }
+            }
+
+            static size_type find_empty_(const array& a, size_type hash) noexcept
+            {
+                auto mask = a.capacity - 1;
+                auto idx = h1_(hash) & mask;
+
+                while (true)
+                {
+                    auto m = group{a.ctrl + idx}.match_empty();
+                    if (m)
+                        return (idx + group::index(m)) & mask;
+
+                    idx = (idx + group::width) & mask;
+                }
+            }
+
+            size_type find_position_(const key_type& key) const
+            {
+                if (size() == 0)
+                    return end_position_();
+
+                auto hash = hash_(key);
+                auto idx = find_in_(current_, key, hash);
+                if (idx < current_.capacity)
+                    return logical_(idx);
+
+                idx = find_in_(old_, key, hash);
+                if (idx < old_.capacity)
+                    return logical_old_(idx);
+
+                return end_position_();
+            }
+
+            /**
+             * Returns the logical position of an existing element
+             * with an equivalent key and false, or an empty slot
+             * of the current array and true. In the latter case
+             * the slot is already marked as full and the caller
+             * has to construct the value in it.
+             */
+            pair<size_type, bool> prepare_insert_(const key_type& key)
+            {
+                auto pos = find_position_(key);
+                if (pos != end_position_())
+                    return make_pair(pos, false);
+
+                if (old_.capacity > 0)
+                    migrate_(migration_step_);
+
+                if (current_.size + 1 > growth_limit_(current_.capacity))
+                    grow_();
+
+                auto hash = hash_(key);
+                auto idx = find_empty_(current_, hash);
+                take_slot_(idx, h2_(hash));
+
+                return make_pair(idx, true);
+            }
+
+            void take_slot_(size_type idx, uint8_t h2)
+            {
+                set_ctrl_(current_, idx, h2);
+                ++current_.size;
+
+                if (idx == current_.origin)
+                    current_.origin = next_empty_(current_, idx);
+            }
+
+            static size_type next_empty_(const array& a, size_type idx) noexcept
+            {
+                auto mask = a.capacity - 1;
+                while (a.ctrl[idx] != flat_hash_ctrl_empty)
+                    idx = (idx + 1) & mask;
+
+                return idx;
+            }
+
+            void insert_relocated_(value_type* value)
+            {
+                auto hash = hash_(key_extractor_(*value));
+                auto idx = find_empty_(current_, hash);
+
+                flat_hash_relocate(allocator_, current_.slots + idx, value);
+                take_slot_(idx, h2_(hash));
+            }
+
+            /**
+             * Backward shift deletion, the elements following
+             * the erased one are moved into the hole as long as
+             * the hole lies between their home slot and their
+             * current slot.
+             */
+            void erase_at_(array& a, size_type idx)
+            {
+                alloc_traits::destroy(allocator_, a.slots + idx);
+                relocate_hole_(a, idx);
+            }
+
+            void relocate_hole_(array& a, size_type hole)
+            {
+                auto mask = a.capacity - 1;
+                auto idx = hole;
+
+                while (true)
+                {
+                    idx = (idx + 1) & mask;
+                    if (a.ctrl[idx] == flat_hash_ctrl_empty)
+                        break;
+
+                    auto home = h1_(hash_(key_extractor_(a.slots[idx]))) & mask;
+                    if (((idx - home) & mask) >= ((idx - hole) & mask))
+                    {
+                        flat_hash_relocate(allocator_, a.slots + hole, a.slots + idx);
+                        set_ctrl_(a, hole, a.ctrl[idx]);
+                        hole = idx;
+                    }
+                }
+
+                set_ctrl_(a, hole, flat_hash_ctrl_empty);
+                --a.size;
+            }
+
+            void erase_position_(size_type pos)
+            {
+                if (pos < current_.capacity)
+                    erase_at_(current_, physical_(current_, pos));
+                else
+                    erase_at_(old_, physical_(old_, pos - current_.capacity));
+            }
+
+            /**
+             * Moves elements from the old array into the current
+             * one, removing them from the old array the same way
+             * erasure does. Everything below old_next_ is thus
+             * kept empty and the old array stays consistent for
+             * lookups.
+             */
+            void migrate_(size_type steps)
+            {
+                while (steps-- > 0 && old_next_ < old_.capacity)
+                {
+                    if (old_.ctrl[old_next_] == flat_hash_ctrl_empty)
+                    {
+                        ++old_next_;
+                        continue;
+                    }
+
+                    insert_relocated_(old_.slots + old_next_);
+                    relocate_hole_(old_, old_next_);
+                }
+
+                if (old_next_ == old_.capacity || old_.size == 0)
+                {
+                    release_(old_);
+                    old_ = array{};
+                    old_next_ = 0;
+                }
+            }
+
+            void finish_migration_()
+            {
+                while (old_.capacity > 0)
+                    migrate_(old_.capacity);
+            }
+
+            void grow_()
+            {
+                finish_migration_();
+
+                auto capacity = current_.capacity > 0 ? 2 * current_.capacity : group::width;
+
+                old_ = current_;
+                old_next_ = 0;
+                current_ = allocate_(capacity);
+
+                if (old_.size == 0)
+                {
+                    release_(old_);
+                    old_ = array{};
+                }
+            }
+
+            void resize_(size_type capacity)
+            {
+                finish_migration_();
+
+                auto prev = current_;
+                current_ = allocate_(capacity);
+
+                for (size_type i = 0; prev.size > 0 && i < prev.capacity; ++i)
+                {
+                    if (prev.ctrl[i] != flat_hash_ctrl_empty)
+                    {
+                        insert_relocated_(prev.slots + i);
+                        prev.ctrl[i] = flat_hash_ctrl_empty;
+                        --prev.size;
+                    }
+                }
+
+                release_(prev);
+            }
+
+            template<class Table>
+            void insert_all_(Table&& other)
+            {
+                reserve(other.size());
+                for (auto&& x: other)
+                    emplace_key(key_extractor_(x), forward_like_(x));
+            }
+
+            template<class T>
+            static auto&& forward_like_(T& x)
+            {
+                if constexpr (is_const_v<remove_reference_t<T>>)
+                    return x;
+                else
+                    return move(x);
+            }
+
+            static size_type physical_(const array& a, size_type pos) noexcept
+            {
+                return (a.origin + 1 + pos) & (a.capacity - 1);
+            }
+
+            size_type logical_(size_type idx) const noexcept
+            {
+                return (idx - current_.origin - 1) & (current_.capacity - 1);
+            }
+
+            size_type logical_old_(size_type idx) const noexcept
+            {
+                return current_.capacity + ((idx - old_.origin - 1) & (old_.capacity - 1));
+            }
+
+            size_type end_position_() const noexcept
+            {
+                return current_.capacity + old_.capacity;
+            }
+
+            bool pos_full_(size_type pos) const noexcept
+            {
+                if (pos < current_.capacity)
+                    return current_.ctrl[physical_(current_, pos)] != flat_hash_ctrl_empty;
+                else if (pos < end_position_())
+                {
+                    auto idx = physical_(old_, pos - current_.capacity);
+
+                    return old_.ctrl[idx] != flat_hash_ctrl_empty;
+                }
+                else
+                    return false;
+            }
+
+            value_type* slot_at_(size_type pos) const noexcept
+            {
+                if (pos < current_.capacity)
+                    return current_.slots + physical_(current_, pos);
+                else
+                    return old_.slots + physical_(old_, pos - current_.capacity);
+            }
+
+            size_type next_full_(size_type pos) const noexcept
+            {
+                auto end = end_position_();
+                while (pos < end && !pos_full_(pos))
+                    ++pos;
+
+                return pos;
+            }
+
+            friend iterator;
+            friend const_iterator;
+    };
+}
+
+#endif
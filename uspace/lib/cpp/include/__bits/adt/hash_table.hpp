@@ -86,22 +86,45 @@ namespace std::aux
                 list_node<value_type>*, size_type
             >;
 
+            using node_allocator_type = typename allocator_traits<
+                allocator_type
+            >::template rebind_alloc<node_type>;
+            using node_traits = allocator_traits<node_allocator_type>;
+
             hash_table(size_type buckets, float max_load_factor = 1.f)
                 : table_{new hash_table_bucket<value_type, size_type>[buckets]()},
                   bucket_count_{buckets}, size_{}, hasher_{}, key_eq_{},
-                  key_extractor_{}, max_load_factor_{max_load_factor}
+                  key_extractor_{}, max_load_factor_{max_load_factor},
+                  node_allocator_{}
             { /* DUMMY BODY */ }
 
             hash_table(size_type buckets, const hasher& hf, const key_equal& eql,
                        float max_load_factor = 1.f)
                 : table_{new hash_table_bucket<value_type, size_type>[buckets]()},
                   bucket_count_{buckets}, size_{}, hasher_{hf}, key_eq_{eql},
-                  key_extractor_{}, max_load_factor_{max_load_factor}
+                  key_extractor_{}, max_load_factor_{max_load_factor},
+                  node_allocator_{}
+            { /* DUMMY BODY */ }
+
+            hash_table(size_type buckets, const hasher& hf, const key_equal& eql,
+                       const node_allocator_type& alloc, float max_load_factor = 1.f)
+                : table_{new hash_table_bucket<value_type, size_type>[buckets]()},
+                  bucket_count_{buckets}, size_{}, hasher_{hf}, key_eq_{eql},
+                  key_extractor_{}, max_load_factor_{max_load_factor},
+                  node_allocator_{alloc}
             { /* DUMMY BODY */ }
 
             hash_table(const hash_table& other)
+                : hash_table{
+                    other, node_traits::select_on_container_copy_construction(
+                        other.node_allocator_
+                    )
+                  }
+            { /* DUMMY BODY */ }
+
+            hash_table(const hash_table& other, const node_allocator_type& alloc)
                 : hash_table{other.bucket_count_, other.hasher_, other.key_eq_,
-                             other.max_load_factor_}
+                             alloc, other.max_load_factor_}
             {
                 for (const auto& x: other)
                     insert(x);
@@ -111,7 +134,8 @@ namespace std::aux
                 : table_{other.table_}, bucket_count_{other.bucket_count_},
                   size_{other.size_}, hasher_{move(other.hasher_)},
                   key_eq_{move(other.key_eq_)}, key_extractor_{move(other.key_extractor_)},
-                  max_load_factor_{other.max_load_factor_}
+                  max_load_factor_{other.max_load_factor_},
+                  node_allocator_{move(other.node_allocator_)}
             {
                 other.table_ = nullptr;
                 other.bucket_count_ = size_type{};
@@ -119,6 +143,29 @@ namespace std::aux
                 other.max_load_factor_ = 1.f;
             }
 
+            hash_table(hash_table&& other, const node_allocator_type& alloc)
+                : hash_table{other.bucket_count_, other.hasher_, other.key_eq_,
+                             alloc, other.max_load_factor_}
+            {
+                /**
+                 * Nodes can only be stolen if our allocator
+                 * can free them, otherwise we move the values
+                 * one by one.
+                 */
+                if (node_allocator_ == other.node_allocator_)
+                {
+                    std::swap(table_, other.table_);
+                    std::swap(bucket_count_, other.bucket_count_);
+                    std::swap(size_, other.size_);
+                }
+                else
+                {
+                    for (auto& x: other)
+                        insert(move(x));
+                    other.clear();
+                }
+            }
+
             hash_table& operator=(const hash_table& other)
             {
                 hash_table tmp{other};
@@ -135,6 +182,11 @@ namespace std::aux
                 return *this;
             }
 
+            allocator_type get_allocator() const noexcept
+            {
+                return allocator_type{node_allocator_};
+            }
+
             bool empty() const noexcept
             {
                 return size_ == 0;
@@ -221,7 +273,7 @@ namespace std::aux
                  * Note: This way we will continue on the next bucket
                  *       if this is the last element in its bucket.
                  */
-                iterator res{table_, idx, size_, node};
+                iterator res{table_, idx, bucket_count_, node};
                 ++res;
 
                 if (table_[idx].head == node)
@@ -234,7 +286,7 @@ namespace std::aux
                 --size_;
 
                 node->unlink();
-                delete node;
+                destroy_node(node);
 
                 if (empty())
                     return end();
@@ -245,7 +297,7 @@ namespace std::aux
             void clear() noexcept
             {
                 for (size_type i = 0; i < bucket_count_; ++i)
-                    table_[i].clear();
+                    table_[i].clear(node_allocator_);
                 size_ = size_type{};
             }
 
@@ -260,6 +312,7 @@ namespace std::aux
                 std::swap(hasher_, other.hasher_);
                 std::swap(key_eq_, other.key_eq_);
                 std::swap(max_load_factor_, other.max_load_factor_);
+                std::swap(node_allocator_, other.node_allocator_);
             }
 
             hasher hash_function() const
@@ -284,7 +337,7 @@ namespace std::aux
                 do
                 {
                     if (key_eq_(key, key_extractor_(current->value)))
-                        return iterator{table_, idx, size_, current};
+                        return iterator{table_, idx, bucket_count_, current};
                     current = current->next;
                 }
                 while (current && current != head);
@@ -304,7 +357,7 @@ namespace std::aux
                 do
                 {
                     if (key_eq_(key, key_extractor_(current->value)))
-                        return iterator{table_, idx, size_, current};
+                        return iterator{table_, idx, bucket_count_, current};
                     current = current->next;
                 }
                 while (current != head);
@@ -408,7 +461,9 @@ namespace std::aux
                  *       be thrown and no changes to this have been
                  *       made, we're ok.
                  */
-                hash_table new_table{count, max_load_factor_};
+                hash_table new_table{
+                    count, hasher_, key_eq_, node_allocator_, max_load_factor_
+                };
 
                 for (std::size_t i = 0; i < bucket_count_; ++i)
                 {
@@ -496,9 +551,11 @@ namespace std::aux
 
             ~hash_table()
             {
-                // Lists are deleted in ~hash_table_bucket.
                 if (table_)
+                {
+                    clear();
                     delete[] table_;
+                }
             }
 
             place_type find_insertion_spot(const key_type& key) const
@@ -557,6 +614,17 @@ namespace std::aux
                 --size_;
             }
 
+            template<class... Args>
+            node_type* create_node(Args&&... args)
+            {
+                return aux::create_node(node_allocator_, forward<Args>(args)...);
+            }
+
+            void destroy_node(node_type* node)
+            {
+                aux::destroy_node(node_allocator_, node);
+            }
+
         private:
             hash_table_bucket<value_type, size_type>* table_;
             size_type bucket_count_;
@@ -565,6 +633,7 @@ namespace std::aux
             key_equal key_eq_;
             key_extract key_extractor_;
             float max_load_factor_;
+            node_allocator_type node_allocator_;
 
             static constexpr float bucket_count_growth_factor_{1.25};
 
@@ -30,6 +30,7 @@
 #define LIBCPP_BITS_ADT_HASH_TABLE_BUCKET
 
 #include <__bits/adt/list_node.hpp>
+#include <__bits/memory/allocator_traits.hpp>
 
 namespace std::aux
 {
@@ -79,7 +80,14 @@ namespace std::aux
                 head->prepend(node);
         }
 
-        void clear()
+        /**
+         * Note: The nodes are owned by the table
+         *       (which owns the allocator they came
+         *       from), so buckets do not free them
+         *       on destruction.
+         */
+        template<class Alloc>
+        void clear(Alloc& alloc)
         {
             if (!head)
                 return;
@@ -89,17 +97,12 @@ namespace std::aux
             {
                 auto tmp = current;
                 current = current->next;
-                delete tmp;
+                destroy_node(alloc, tmp);
             }
             while (current && current != head);
 
             head = nullptr;
         }
-
-        ~hash_table_bucket()
-        {
-            clear();
-        }
     };
 }
 
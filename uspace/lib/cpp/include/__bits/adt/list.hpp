@@ -360,6 +360,12 @@ namespace std
             using reverse_iterator       = std::reverse_iterator<iterator>;
             using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
+            using node_type           = aux::list_node<value_type>;
+            using node_allocator_type = typename allocator_traits<
+                allocator_type
+            >::template rebind_alloc<node_type>;
+            using node_traits         = allocator_traits<node_allocator_type>;
+
             /**
              * 23.3.5.2, construct/copy/destroy:
              */
@@ -400,7 +406,11 @@ namespace std
             }
 
             list(const list& other)
-                : list{other, other.allocator_}
+                : list{
+                    other, node_traits::select_on_container_copy_construction(
+                        other.allocator_
+                    )
+                  }
             { /* DUMMY BODY */ }
 
             list(list&& other)
@@ -419,12 +429,9 @@ namespace std
             }
 
             list(list&& other, const allocator_type& alloc)
-                : allocator_{alloc},
-                  head_{move(other.head_)},
-                  size_{move(other.size_)}
+                : allocator_{alloc}, head_{nullptr}, size_{}
             {
-                other.head_ = nullptr;
-                other.size_ = size_type{};
+                steal_(other);
             }
 
             list(initializer_list<value_type> init, const allocator_type& alloc = allocator_type{})
@@ -440,9 +447,13 @@ namespace std
 
             list& operator=(const list& other)
             {
+                if (this == &other)
+                    return *this;
+
                 fini_();
 
-                allocator_ = other.allocator_;
+                if constexpr (node_traits::propagate_on_container_copy_assignment::value)
+                    allocator_ = other.allocator_;
 
                 init_(other.begin(), other.end());
 
@@ -454,12 +465,9 @@ namespace std
             {
                 fini_();
 
-                head_ = move(other.head_);
-                size_ = move(other.size_);
-                allocator_ = move(other.allocator_);
-
-                other.head_ = nullptr;
-                other.size_ = size_type{};
+                if constexpr (node_traits::propagate_on_container_move_assignment::value)
+                    allocator_ = move(other.allocator_);
+                steal_(other);
 
                 return *this;
             }
@@ -500,7 +508,7 @@ namespace std
 
             allocator_type get_allocator() const noexcept
             {
-                return allocator_;
+                return allocator_type{allocator_};
             }
 
             iterator begin() noexcept
@@ -574,7 +582,7 @@ namespace std
 
             size_type max_size() const noexcept
             {
-                return allocator_traits<allocator_type>::max_size(allocator_);
+                return node_traits::max_size(allocator_);
             }
 
             void resize(size_type sz)
@@ -636,7 +644,7 @@ namespace std
 
                     if (head_->next == head_)
                     {
-                        delete head_;
+                        destroy_node_(head_);
                         head_ = nullptr;
                     }
                     else
@@ -646,7 +654,7 @@ namespace std
                         head_->next->prev = head_->prev;
                         head_ = head_->next;
 
-                        delete tmp;
+                        destroy_node_(tmp);
                     }
                 }
             }
@@ -684,19 +692,17 @@ namespace std
                     --size_;
                     auto target = head_->prev;
 
-                    if (!target)
+                    if (target == head_)
                     {
-                        delete head_;
+                        destroy_node_(head_);
                         head_ = nullptr;
                     }
                     else
                     {
-                        auto tmp = target;
                         target->prev->next = target->next;
                         target->next->prev = target->prev;
-                        target = target->next;
 
-                        delete tmp;
+                        destroy_node_(target);
                     }
                 }
             }
@@ -705,7 +711,7 @@ namespace std
             iterator emplace(const_iterator position, Args&&... args)
             {
                 auto node = position.node();
-                node->prepend(new aux::list_node<value_type>{forward<Args>(args)...});
+                node->prepend(create_node_(forward<Args>(args)...));
                 ++size_;
 
                 if (node == head_)
@@ -740,7 +746,7 @@ namespace std
 
                 while (first != last)
                 {
-                    node->append(new aux::list_node<value_type>{*first++});
+                    node->append(create_node_(*first++));
                     node = node->next;
                     ++size_;
                 }
@@ -761,7 +767,7 @@ namespace std
                 {
                     if (size_ == 1)
                     {
-                        delete head_;
+                        destroy_node_(head_);
                         head_ = nullptr;
                         size_ = 0;
 
@@ -776,7 +782,7 @@ namespace std
                 --size_;
 
                 node->unlink();
-                delete node;
+                destroy_node_(node);
 
                 return iterator{next, head_, size_ == 0U};
             }
@@ -808,7 +814,7 @@ namespace std
                     first_node = first_node->next;
                     --size_;
 
-                    delete tmp;
+                    destroy_node_(tmp);
                 }
 
                 return iterator{next, head_, size_ == 0U};
@@ -1085,7 +1091,7 @@ namespace std
             }
 
         private:
-            allocator_type allocator_;
+            node_allocator_type allocator_;
             aux::list_node<value_type>* head_;
             size_type size_;
 
@@ -1093,10 +1099,40 @@ namespace std
             void init_(InputIterator first, InputIterator last)
             {
                 while (first != last)
+                    append_new_(*first++);
+            }
+
+            template<class... Args>
+            aux::list_node<value_type>* create_node_(Args&&... args)
+            {
+                return aux::create_node(allocator_, forward<Args>(args)...);
+            }
+
+            void destroy_node_(aux::list_node<value_type>* node)
+            {
+                aux::destroy_node(allocator_, node);
+            }
+
+            void steal_(list& other)
+            {
+                /**
+                 * Nodes can only be taken over if our allocator
+                 * can free them, otherwise the values are moved.
+                 */
+                if (allocator_ == other.allocator_)
                 {
-                    auto node = append_new_();
-                    allocator_.construct(&node->value, *first++);
+                    head_ = other.head_;
+                    size_ = other.size_;
                 }
+                else
+                {
+                    for (auto& x: other)
+                        append_new_(move(x));
+                    other.fini_();
+                }
+
+                other.head_ = nullptr;
+                other.size_ = size_type{};
             }
 
             void fini_()
@@ -1110,7 +1146,7 @@ namespace std
                     auto tmp = head_;
                     head_ = head_->next;
 
-                    delete tmp;
+                    destroy_node_(tmp);
                 }
 
                 head_ = nullptr;
@@ -1120,7 +1156,7 @@ namespace std
             template<class... Args>
             aux::list_node<value_type>* append_new_(Args&&... args)
             {
-                auto node = new aux::list_node<value_type>{forward<Args>(args)...};
+                auto node = create_node_(forward<Args>(args)...);
                 auto last = get_last_();
 
                 if (!last)
@@ -1136,7 +1172,7 @@ namespace std
             template<class... Args>
             aux::list_node<value_type>* prepend_new_(Args&&... args)
             {
-                auto node = new aux::list_node<value_type>{forward<Args>(args)...};
+                auto node = create_node_(forward<Args>(args)...);
 
                 if (!head_)
                     head_ = node;
@@ -1171,7 +1207,7 @@ namespace std
 
                 while (first != last)
                 {
-                    where->append(new aux::list_node<value_type>{*first++});
+                    where->append(create_node_(*first++));
                     where = where->next;
                 }
             }
@@ -29,6 +29,8 @@
 #ifndef LIBCPP_BITS_ADT_LIST_NODE
 #define LIBCPP_BITS_ADT_LIST_NODE
 
+#include <utility>
+
 namespace std::aux
 {
     template<class T>
@@ -106,7 +106,7 @@ namespace std
 
             explicit map(const key_compare& comp,
                          const allocator_type& alloc = allocator_type{})
-                : tree_{comp}, allocator_{alloc}
+                : tree_{comp, alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             template<class InputIterator>
@@ -119,7 +119,11 @@ namespace std
             }
 
             map(const map& other)
-                : map{other, other.allocator_}
+                : map{
+                    other, allocator_traits<
+                        allocator_type
+                    >::select_on_container_copy_construction(other.allocator_)
+                  }
             { /* DUMMY BODY */ }
 
             map(map&& other)
@@ -127,15 +131,15 @@ namespace std
             { /* DUMMY BODY */ }
 
             explicit map(const allocator_type& alloc)
-                : tree_{}, allocator_{alloc}
+                : tree_{key_compare{}, alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             map(const map& other, const allocator_type& alloc)
-                : tree_{other.tree_}, allocator_{alloc}
+                : tree_{other.tree_, alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             map(map&& other, const allocator_type& alloc)
-                : tree_{move(other.tree_)}, allocator_{alloc}
+                : tree_{move(other.tree_), alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             map(initializer_list<value_type> init,
@@ -277,7 +281,7 @@ namespace std
                 if (parent && tree_.keys_equal(tree_.get_key(parent->value), key))
                     return parent->value.second;
 
-                auto node = new node_type{value_type{key, mapped_type{}}};
+                auto node = tree_.create_node(key, mapped_type{});
                 tree_.insert_node(node, parent);
 
                 return node->value.second;
@@ -289,7 +293,7 @@ namespace std
                 if (parent && tree_.keys_equal(tree_.get_key(parent->value), key))
                     return parent->value.second;
 
-                auto node = new node_type{value_type{move(key), mapped_type{}}};
+                auto node = tree_.create_node(move(key), mapped_type{});
                 tree_.insert_node(node, parent);
 
                 return node->value.second;
@@ -386,7 +390,7 @@ namespace std
                     return make_pair(iterator{parent, false}, false);
                 else
                 {
-                    auto node = new node_type{value_type{key, forward<Args>(args)...}};
+                    auto node = tree_.create_node(key, forward<Args>(args)...);
                     tree_.insert_node(node, parent);
 
                     return make_pair(iterator{node, false}, true);
@@ -401,7 +405,7 @@ namespace std
                     return make_pair(iterator{parent, false}, false);
                 else
                 {
-                    auto node = new node_type{value_type{move(key), forward<Args>(args)...}};
+                    auto node = tree_.create_node(move(key), forward<Args>(args)...);
                     tree_.insert_node(node, parent);
 
                     return make_pair(iterator{node, false}, true);
@@ -432,7 +436,7 @@ namespace std
                 }
                 else
                 {
-                    auto node = new node_type{value_type{key, forward<T>(val)}};
+                    auto node = tree_.create_node(key, forward<T>(val));
                     tree_.insert_node(node, parent);
 
                     return make_pair(iterator{node, false}, true);
@@ -451,7 +455,7 @@ namespace std
                 }
                 else
                 {
-                    auto node = new node_type{value_type{move(key), forward<T>(val)}};
+                    auto node = tree_.create_node(move(key), forward<T>(val));
                     tree_.insert_node(node, parent);
 
                     return make_pair(iterator{node, false}, true);
@@ -765,7 +769,7 @@ namespace std
 
             explicit multimap(const key_compare& comp,
                               const allocator_type& alloc = allocator_type{})
-                : tree_{comp}, allocator_{alloc}
+                : tree_{comp, alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             template<class InputIterator>
@@ -778,7 +782,11 @@ namespace std
             }
 
             multimap(const multimap& other)
-                : multimap{other, other.allocator_}
+                : multimap{
+                    other, allocator_traits<
+                        allocator_type
+                    >::select_on_container_copy_construction(other.allocator_)
+                  }
             { /* DUMMY BODY */ }
 
             multimap(multimap&& other)
@@ -786,15 +794,15 @@ namespace std
             { /* DUMMY BODY */ }
 
             explicit multimap(const allocator_type& alloc)
-                : tree_{}, allocator_{alloc}
+                : tree_{key_compare{}, alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             multimap(const multimap& other, const allocator_type& alloc)
-                : tree_{other.tree_}, allocator_{alloc}
+                : tree_{other.tree_, alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             multimap(multimap&& other, const allocator_type& alloc)
-                : tree_{move(other.tree_)}, allocator_{alloc}
+                : tree_{move(other.tree_), alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             multimap(initializer_list<value_type> init,
@@ -33,6 +33,7 @@
 #include <__bits/adt/rbtree_iterators.hpp>
 #include <__bits/adt/rbtree_node.hpp>
 #include <__bits/adt/rbtree_policies.hpp>
+#include <__bits/memory/allocator_traits.hpp>
 
 namespace std::aux
 {
@@ -60,13 +61,28 @@ namespace std::aux
 
             using node_type = Node;
 
-            rbtree(const key_compare& kcmp = key_compare{})
-                : root_{nullptr}, size_{}, key_compare_{},
-                  key_extractor_{}
+            using node_allocator_type = typename allocator_traits<
+                allocator_type
+            >::template rebind_alloc<node_type>;
+            using node_traits = allocator_traits<node_allocator_type>;
+
+            rbtree(const key_compare& kcmp = key_compare{},
+                   const allocator_type& alloc = allocator_type{})
+                : root_{nullptr}, size_{}, key_compare_{kcmp},
+                  key_extractor_{}, node_allocator_{alloc}
             { /* DUMMY BODY */ }
 
             rbtree(const rbtree& other)
-                : rbtree{other.key_compare_}
+                : rbtree{
+                    other, node_traits::select_on_container_copy_construction(
+                        other.node_allocator_
+                    )
+                  }
+            { /* DUMMY BODY */ }
+
+            rbtree(const rbtree& other, const node_allocator_type& alloc)
+                : root_{nullptr}, size_{}, key_compare_{other.key_compare_},
+                  key_extractor_{other.key_extractor_}, node_allocator_{alloc}
             {
                 for (const auto& x: other)
                     insert(x);
@@ -75,16 +91,53 @@ namespace std::aux
             rbtree(rbtree&& other)
                 : root_{other.root_}, size_{other.size_},
                   key_compare_{move(other.key_compare_)},
-                  key_extractor_{move(other.key_extractor_)}
+                  key_extractor_{move(other.key_extractor_)},
+                  node_allocator_{move(other.node_allocator_)}
             {
                 other.root_ = nullptr;
                 other.size_ = size_type{};
             }
 
+            rbtree(rbtree&& other, const node_allocator_type& alloc)
+                : root_{nullptr}, size_{},
+                  key_compare_{move(other.key_compare_)},
+                  key_extractor_{move(other.key_extractor_)},
+                  node_allocator_{alloc}
+            {
+                /**
+                 * Nodes can only be stolen if our allocator
+                 * can free them, otherwise we move the values
+                 * one by one.
+                 */
+                if (node_allocator_ == other.node_allocator_)
+                {
+                    root_ = other.root_;
+                    size_ = other.size_;
+
+                    other.root_ = nullptr;
+                    other.size_ = size_type{};
+                }
+                else
+                {
+                    for (auto& x: other)
+                        insert(move(x));
+                    other.clear();
+                }
+            }
+
             rbtree& operator=(const rbtree& other)
             {
-                auto tmp{other};
-                tmp.swap(*this);
+                if (this == &other)
+                    return *this;
+
+                clear();
+                if constexpr (node_traits::propagate_on_container_copy_assignment::value)
+                    node_allocator_ = other.node_allocator_;
+
+                key_compare_ = other.key_compare_;
+                key_extractor_ = other.key_extractor_;
+                for (const auto& x: other)
+                    insert(x);
 
                 return *this;
             }
@@ -97,6 +150,16 @@ namespace std::aux
                 return *this;
             }
 
+            ~rbtree()
+            {
+                clear();
+            }
+
+            allocator_type get_allocator() const noexcept
+            {
+                return allocator_type{node_allocator_};
+            }
+
             bool empty() const noexcept
             {
                 return size_ == 0U;
@@ -114,7 +177,10 @@ namespace std::aux
 
             iterator begin()
             {
-                return iterator{find_smallest_(), false};
+                // An empty tree has begin() == end().
+                auto res = find_smallest_();
+
+                return iterator{res, !res};
             }
 
             const_iterator begin() const
@@ -163,7 +229,9 @@ namespace std::aux
 
             const_iterator cbegin() const
             {
-                return const_iterator{find_smallest_(), false};
+                auto res = find_smallest_();
+
+                return const_iterator{res, !res};
             }
 
             const_iterator cend() const
@@ -222,12 +290,42 @@ namespace std::aux
 
             void clear() noexcept
             {
-                if (root_)
+                /**
+                 * Descend to a leaf, free it (along with
+                 * its list of equivalent nodes) and continue
+                 * from its parent, this way we do not need
+                 * recursion even if the tree is degenerate.
+                 */
+                auto current = root_;
+                while (current)
                 {
-                    delete root_;
-                    root_ = nullptr;
-                    size_ = size_type{};
+                    if (current->left())
+                        current = current->left();
+                    else if (current->right())
+                        current = current->right();
+                    else
+                    {
+                        auto parent = current->parent();
+                        if (parent && parent->left() == current)
+                            parent->left(nullptr);
+                        else if (parent)
+                            parent->right(nullptr);
+
+                        auto next = current->next();
+                        destroy_node(current);
+                        while (next)
+                        {
+                            auto tmp = next->next();
+                            destroy_node(next);
+                            next = tmp;
+                        }
+
+                        current = parent;
+                    }
                 }
+
+                root_ = nullptr;
+                size_ = size_type{};
             }
 
             void swap(rbtree& other)
@@ -238,6 +336,7 @@ namespace std::aux
                 std::swap(size_, other.size_);
                 std::swap(key_compare_, other.key_compare_);
                 std::swap(key_extractor_, other.key_extractor_);
+                std::swap(node_allocator_, other.node_allocator_);
             }
 
             key_compare key_comp() const
@@ -365,59 +464,61 @@ namespace std::aux
                      * and return the successor which was the next
                      * in the list.
                      */
-                    delete tmp;
+                    destroy_node(tmp);
 
                     update_root_(succ); // Incase the first in list was root.
                     return succ;
                 }
-                else if (node == root_)
-                { // Only executed if root_ is unique.
-                    root_ = nullptr;
-                    delete node;
 
-                    return nullptr;
-                }
+                /**
+                 * Child is the node that takes the place of
+                 * the one removed from the tree (possibly null),
+                 * if the removed node was black, the path through
+                 * child is missing one black node.
+                 */
+                auto removed_color = node->color;
+                node_type* child{};
+                node_type* child_parent{};
 
                 if (node->left() && node->right())
                 {
-                    node->swap(succ);
-                    if (succ && !succ->parent())
-                        root_ = succ;
-
-                    // Node now has at most one child.
-                    // Also: If succ was nullptr, the swap
-                    //       didn't do anything and we can
-                    //       safely delete node.
-                    return delete_node(node);
-                }
+                    /**
+                     * The successor is the smallest node in
+                     * the right subtree and has no left child,
+                     * so it can take the place of node.
+                     */
+                    removed_color = succ->color;
+                    child = succ->right();
 
-                auto child = node->right() ? node->right() : node->left();
-                if (!child)
-                {
-                    // Simply remove the node.
-                    // TODO: repair here too?
-                    node->unlink();
-                    delete node;
+                    if (succ->parent() != node)
+                    {
+                        child_parent = succ->parent();
+
+                        transplant_(succ, succ->right());
+                        succ->right(node->right());
+                        succ->right()->parent(succ);
+                    }
+                    else
+                        child_parent = succ;
+
+                    transplant_(node, succ);
+                    succ->left(node->left());
+                    succ->left()->parent(succ);
+                    succ->color = node->color;
                 }
                 else
                 {
-                    // Replace with the child.
-                    child->parent(node->parent());
-                    if (node->is_left_child())
-                        child->parent()->left(child);
-                    else if (node->is_right_child())
-                        child->parent()->right(child);
-                    node->parent(nullptr);
-                    node->left(nullptr);
-                    node->right(nullptr);
-
-                    // Repair if needed.
-                    repair_after_erase_(node, child);
-                    update_root_(child);
-
-                    delete node;
+                    child = node->right() ? node->right() : node->left();
+                    child_parent = node->parent();
+
+                    transplant_(node, child);
                 }
 
+                if (removed_color == rbcolor::black)
+                    repair_after_erase_(child, child_parent);
+
+                destroy_node(node);
+
                 return succ;
             }
 
@@ -426,11 +527,23 @@ namespace std::aux
                 Policy::insert(*this, node, parent);
             }
 
+            template<class... Args>
+            node_type* create_node(Args&&... args)
+            {
+                return aux::create_node(node_allocator_, forward<Args>(args)...);
+            }
+
+            void destroy_node(node_type* node)
+            {
+                aux::destroy_node(node_allocator_, node);
+            }
+
         private:
             node_type* root_;
             size_type size_;
             key_compare key_compare_;
             key_extract key_extractor_;
+            node_allocator_type node_allocator_;
 
             node_type* find_(const key_type& key) const
             {
@@ -464,6 +577,24 @@ namespace std::aux
                     return nullptr;
             }
 
+            /**
+             * Puts the subtree rooted at v in place
+             * of the subtree rooted at u.
+             */
+            void transplant_(node_type* u, node_type* v)
+            {
+                auto parent = u->parent();
+                if (!parent)
+                    root_ = v;
+                else if (parent->left() == u)
+                    parent->left(v);
+                else
+                    parent->right(v);
+
+                if (v)
+                    v->parent(parent);
+            }
+
             void update_root_(const node_type* node)
             {
                 if (!node)
@@ -474,14 +605,155 @@ namespace std::aux
                     root_ = root_->parent();
             }
 
-            void repair_after_insert_(const node_type* node)
+            static bool is_black_(const node_type* node)
             {
-                // TODO: implement
+                // Leaves (null) are black.
+                return !node || node->color == rbcolor::black;
             }
 
-            void repair_after_erase_(const node_type* node, const node_type* child)
+            /**
+             * Restores the red-black properties after node
+             * (which is red) was linked into the tree.
+             */
+            void repair_after_insert_(node_type* node)
             {
-                // TODO: implement
+                while (node->parent() && !is_black_(node->parent()))
+                {
+                    auto parent = node->parent();
+                    auto grandparent = parent->parent();
+                    if (!grandparent)
+                        break;
+
+                    auto uncle = node->uncle();
+                    if (!is_black_(uncle))
+                    {
+                        parent->color = rbcolor::black;
+                        uncle->color = rbcolor::black;
+                        grandparent->color = rbcolor::red;
+                        node = grandparent;
+
+                        continue;
+                    }
+
+                    if (parent->is_left_child())
+                    {
+                        if (node->is_right_child())
+                        {
+                            node = parent;
+                            node->rotate_left();
+                            parent = node->parent();
+                        }
+
+                        parent->color = rbcolor::black;
+                        grandparent->color = rbcolor::red;
+                        grandparent->rotate_right();
+                    }
+                    else
+                    {
+                        if (node->is_left_child())
+                        {
+                            node = parent;
+                            node->rotate_right();
+                            parent = node->parent();
+                        }
+
+                        parent->color = rbcolor::black;
+                        grandparent->color = rbcolor::red;
+                        grandparent->rotate_left();
+                    }
+                }
+
+                update_root_(node);
+                root_->color = rbcolor::black;
+            }
+
+            /**
+             * Restores the red-black properties after a black
+             * node was removed from above child, which now
+             * hangs under parent. Note that child can be null
+             * so we need the parent explicitly.
+             */
+            void repair_after_erase_(node_type* child, node_type* parent)
+            {
+                while (parent && is_black_(child))
+                {
+                    if (child == parent->left())
+                    {
+                        auto brother = parent->right();
+                        if (!is_black_(brother))
+                        {
+                            brother->color = rbcolor::black;
+                            parent->color = rbcolor::red;
+                            parent->rotate_left();
+                            brother = parent->right();
+                        }
+
+                        if (is_black_(brother->left()) && is_black_(brother->right()))
+                        {
+                            brother->color = rbcolor::red;
+                            child = parent;
+                            parent = child->parent();
+
+                            continue;
+                        }
+
+                        if (is_black_(brother->right()))
+                        {
+                            brother->left()->color = rbcolor::black;
+                            brother->color = rbcolor::red;
+                            brother->rotate_right();
+                            brother = parent->right();
+                        }
+
+                        brother->color = parent->color;
+                        parent->color = rbcolor::black;
+                        brother->right()->color = rbcolor::black;
+                        parent->rotate_left();
+                    }
+                    else
+                    {
+                        auto brother = parent->left();
+                        if (!is_black_(brother))
+                        {
+                            brother->color = rbcolor::black;
+                            parent->color = rbcolor::red;
+                            parent->rotate_right();
+                            brother = parent->left();
+                        }
+
+                        if (is_black_(brother->left()) && is_black_(brother->right()))
+                        {
+                            brother->color = rbcolor::red;
+                            child = parent;
+                            parent = child->parent();
+
+                            continue;
+                        }
+
+                        if (is_black_(brother->left()))
+                        {
+                            brother->right()->color = rbcolor::black;
+                            brother->color = rbcolor::red;
+                            brother->rotate_left();
+                            brother = parent->left();
+                        }
+
+                        brother->color = parent->color;
+                        parent->color = rbcolor::black;
+                        brother->left()->color = rbcolor::black;
+                        parent->rotate_right();
+                    }
+
+                    break;
+                }
+
+                if (child)
+                    child->color = rbcolor::black;
+
+                // The rotations might have moved the root down.
+                update_root_(root_);
+                if (root_)
+                    root_->color = rbcolor::black;
             }
 
             friend Policy;
@@ -99,14 +99,61 @@ namespace std::aux
                 return false;
         }
 
+        /**
+         * Note: The rotations do not know about the root
+         *       of the tree, the caller has to update it
+         *       if node was the root.
+         */
         static void rotate_left(Node* node)
         {
-            // TODO: implement
+            if (!node || !node->right())
+                return;
+
+            auto pivot = node->right();
+            auto parent = node->parent();
+            auto left = is_left_child(node);
+
+            node->right(pivot->left());
+            if (pivot->left())
+                pivot->left()->parent(node);
+
+            pivot->parent(parent);
+            if (parent)
+            {
+                if (left)
+                    parent->left(pivot);
+                else
+                    parent->right(pivot);
+            }
+
+            pivot->left(node);
+            node->parent(pivot);
         }
 
         static void rotate_right(Node* node)
         {
-            // TODO: implement
+            if (!node || !node->left())
+                return;
+
+            auto pivot = node->left();
+            auto parent = node->parent();
+            auto left = is_left_child(node);
+
+            node->left(pivot->right());
+            if (pivot->right())
+                pivot->right()->parent(node);
+
+            pivot->parent(parent);
+            if (parent)
+            {
+                if (left)
+                    parent->left(pivot);
+                else
+                    parent->right(pivot);
+            }
+
+            pivot->right(node);
+            node->parent(pivot);
         }
 
         static Node* find_smallest(Node* node)
@@ -410,13 +457,9 @@ namespace std::aux
                 return this;
             }
 
-            ~rbtree_single_node()
+            rbtree_single_node* next() const
             {
-                parent_ = nullptr;
-                if (left_)
-                    delete left_;
-                if (right_)
-                    delete right_;
+                return nullptr;
             }
 
         private:
@@ -557,10 +600,15 @@ namespace std::aux
 
             const rbtree_multi_node* successor() const
             {
+                /**
+                 * Only the first node of the list is linked
+                 * from its parent, so the tree has to be
+                 * walked from it.
+                 */
                 if (next_)
                     return next_;
                 else
-                    return utils::successor(this);
+                    return utils::successor(first_);
             }
 
             rbtree_multi_node* predecessor()
@@ -620,19 +668,45 @@ namespace std::aux
                  * update then list and return this
                  * for deletion.
                  */
-                if (next_)
+                if (this != first_)
+                {
+                    /**
+                     * Nodes other than the first one are not
+                     * linked from the tree, we only need to
+                     * remove them from the list.
+                     */
+                    auto prev = first_;
+                    while (prev->next_ != this)
+                        prev = prev->next_;
+                    prev->next_ = next_;
+
+                    parent_ = nullptr;
+                    left_ = nullptr;
+                    right_ = nullptr;
+                    next_ = nullptr;
+                    first_ = nullptr;
+
+                    return this;
+                }
+                else if (next_)
                 {
                     // Make next the new this.
                     next_->first_ = next_;
+                    next_->color = color;
+
+                    /**
+                     * Use the setters so that the lists of
+                     * our neighbours get updated as well.
+                     */
                     if (is_left_child())
-                        parent_->left_ = next_;
+                        parent_->left(next_);
                     else if (is_right_child())
-                        parent_->right_ = next_;
+                        parent_->right(next_);
 
                     if (left_)
-                        left_->parent_ = next_;
+                        left_->parent(next_);
                     if (right_)
-                        right_->parent_ = next_;
+                        right_->parent(next_);
 
                     /**
                      * Update the first_ pointer
@@ -646,8 +720,8 @@ namespace std::aux
                     }
 
                     /**
-                     * Otherwise destructor could
-                     * destroy them.
+                     * Detach this node so that it does
+                     * not keep pointers into the tree.
                      */
                     parent_ = nullptr;
                     left_ = nullptr;
@@ -704,15 +778,14 @@ namespace std::aux
                 }
             }
 
-            ~rbtree_multi_node()
+            /**
+             * Returns the next node in the list of nodes
+             * with equivalent keys, the tree uses this to
+             * free the whole list when it gets cleared.
+             */
+            rbtree_multi_node* next() const
             {
-                parent_ = nullptr;
-                if (left_)
-                    delete left_;
-                if (right_)
-                    delete right_;
-
-                // TODO: delete the list
+                return next_;
             }
 
         private:
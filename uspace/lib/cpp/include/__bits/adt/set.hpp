@@ -82,7 +82,7 @@ namespace std
 
             explicit set(const key_compare& comp,
                          const allocator_type& alloc = allocator_type{})
-                : tree_{comp}, allocator_{alloc}
+                : tree_{comp, alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             template<class InputIterator>
@@ -95,7 +95,11 @@ namespace std
             }
 
             set(const set& other)
-                : set{other, other.allocator_}
+                : set{
+                    other, allocator_traits<
+                        allocator_type
+                    >::select_on_container_copy_construction(other.allocator_)
+                  }
             { /* DUMMY BODY */ }
 
             set(set&& other)
@@ -103,15 +107,15 @@ namespace std
             { /* DUMMY BODY */ }
 
             explicit set(const allocator_type& alloc)
-                : tree_{}, allocator_{alloc}
+                : tree_{key_compare{}, alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             set(const set& other, const allocator_type& alloc)
-                : tree_{other.tree_}, allocator_{alloc}
+                : tree_{other.tree_, alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             set(set&& other, const allocator_type& alloc)
-                : tree_{move(other.tree_)}, allocator_{alloc}
+                : tree_{move(other.tree_), alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             set(initializer_list<value_type> init,
@@ -563,7 +567,7 @@ namespace std
 
             explicit multiset(const key_compare& comp,
                               const allocator_type& alloc = allocator_type{})
-                : tree_{comp}, allocator_{alloc}
+                : tree_{comp, alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             template<class InputIterator>
@@ -576,7 +580,11 @@ namespace std
             }
 
             multiset(const multiset& other)
-                : multiset{other, other.allocator_}
+                : multiset{
+                    other, allocator_traits<
+                        allocator_type
+                    >::select_on_container_copy_construction(other.allocator_)
+                  }
             { /* DUMMY BODY */ }
 
             multiset(multiset&& other)
@@ -584,15 +592,15 @@ namespace std
             { /* DUMMY BODY */ }
 
             explicit multiset(const allocator_type& alloc)
-                : tree_{}, allocator_{alloc}
+                : tree_{key_compare{}, alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             multiset(const multiset& other, const allocator_type& alloc)
-                : tree_{other.tree_}, allocator_{alloc}
+                : tree_{other.tree_, alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             multiset(multiset&& other, const allocator_type& alloc)
-                : tree_{move(other.tree_)}, allocator_{alloc}
+                : tree_{move(other.tree_), alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             multiset(initializer_list<value_type> init,
@@ -85,7 +85,7 @@ namespace std
                                    const hasher& hf = hasher{},
                                    const key_equal& eql = key_equal{},
                                    const allocator_type& alloc = allocator_type{})
-                : table_{bucket_count, hf, eql}, allocator_{alloc}
+                : table_{bucket_count, hf, eql, alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             template<class InputIterator>
@@ -100,7 +100,11 @@ namespace std
             }
 
             unordered_map(const unordered_map& other)
-                : unordered_map{other, other.allocator_}
+                : unordered_map{
+                    other, allocator_traits<
+                        allocator_type
+                    >::select_on_container_copy_construction(other.allocator_)
+                  }
             { /* DUMMY BODY */ }
 
             unordered_map(unordered_map&& other)
@@ -108,15 +112,16 @@ namespace std
             { /* DUMMY BODY */ }
 
             explicit unordered_map(const allocator_type& alloc)
-                : table_{default_bucket_count_}, allocator_{alloc}
+                : table_{default_bucket_count_, hasher{}, key_equal{}, alloc},
+                  allocator_{alloc}
             { /* DUMMY BODY */ }
 
             unordered_map(const unordered_map& other, const allocator_type& alloc)
-                : table_{other.table_}, allocator_{alloc}
+                : table_{other.table_, alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             unordered_map(unordered_map&& other, const allocator_type& alloc)
-                : table_{move(other.table_)}, allocator_{alloc}
+                : table_{move(other.table_), alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             unordered_map(initializer_list<value_type> init,
@@ -335,7 +340,7 @@ namespace std
                 }
                 else
                 {
-                    auto node = new node_type{key, forward<Args>(args)...};
+                    auto node = table_.create_node(key, forward<Args>(args)...);
                     bucket->append(node);
 
                     return make_pair(iterator{
@@ -370,7 +375,7 @@ namespace std
                 }
                 else
                 {
-                    auto node = new node_type{move(key), forward<Args>(args)...};
+                    auto node = table_.create_node(move(key), forward<Args>(args)...);
                     bucket->append(node);
 
                     return make_pair(iterator{
@@ -418,7 +423,7 @@ namespace std
                 }
                 else
                 {
-                    auto node = new node_type{key, forward<T>(val)};
+                    auto node = table_.create_node(key, forward<T>(val));
                     bucket->append(node);
 
                     return make_pair(iterator{
@@ -454,7 +459,7 @@ namespace std
                 }
                 else
                 {
-                    auto node = new node_type{move(key), forward<T>(val)};
+                    auto node = table_.create_node(move(key), forward<T>(val));
                     bucket->append(node);
 
                     return make_pair(iterator{
@@ -567,7 +572,7 @@ namespace std
                     while (current != head);
                 }
 
-                auto node = new node_type{key, mapped_type{}};
+                auto node = table_.create_node(key, mapped_type{});
                 bucket->append(node);
 
                 table_.increment_size();
@@ -595,7 +600,7 @@ namespace std
                     while (current != head);
                 }
 
-                auto node = new node_type{move(key), mapped_type{}};
+                auto node = table_.create_node(move(key), mapped_type{});
                 bucket->append(node);
 
                 table_.increment_size();
@@ -760,7 +765,7 @@ namespace std
                                         const hasher& hf = hasher{},
                                         const key_equal& eql = key_equal{},
                                         const allocator_type& alloc = allocator_type{})
-                : table_{bucket_count, hf, eql}, allocator_{alloc}
+                : table_{bucket_count, hf, eql, alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             template<class InputIterator>
@@ -775,7 +780,11 @@ namespace std
             }
 
             unordered_multimap(const unordered_multimap& other)
-                : unordered_multimap{other, other.allocator_}
+                : unordered_multimap{
+                    other, allocator_traits<
+                        allocator_type
+                    >::select_on_container_copy_construction(other.allocator_)
+                  }
             { /* DUMMY BODY */ }
 
             unordered_multimap(unordered_multimap&& other)
@@ -783,15 +792,16 @@ namespace std
             { /* DUMMY BODY */ }
 
             explicit unordered_multimap(const allocator_type& alloc)
-                : table_{default_bucket_count_}, allocator_{alloc}
+                : table_{default_bucket_count_, hasher{}, key_equal{}, alloc},
+                  allocator_{alloc}
             { /* DUMMY BODY */ }
 
             unordered_multimap(const unordered_multimap& other, const allocator_type& alloc)
-                : table_{other.table_}, allocator_{alloc}
+                : table_{other.table_, alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             unordered_multimap(unordered_multimap&& other, const allocator_type& alloc)
-                : table_{move(other.table_)}, allocator_{alloc}
+                : table_{move(other.table_), alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             unordered_multimap(initializer_list<value_type> init,
@@ -90,7 +90,7 @@ namespace std
                                    const hasher& hf = hasher{},
                                    const key_equal& eql = key_equal{},
                                    const allocator_type& alloc = allocator_type{})
-                : table_{bucket_count, hf, eql}, allocator_{alloc}
+                : table_{bucket_count, hf, eql, alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             template<class InputIterator>
@@ -105,7 +105,11 @@ namespace std
             }
 
             unordered_set(const unordered_set& other)
-                : unordered_set{other, other.allocator_}
+                : unordered_set{
+                    other, allocator_traits<
+                        allocator_type
+                    >::select_on_container_copy_construction(other.allocator_)
+                  }
             { /* DUMMY BODY */ }
 
             unordered_set(unordered_set&& other)
@@ -113,15 +117,16 @@ namespace std
             { /* DUMMY BODY */ }
 
             explicit unordered_set(const allocator_type& alloc)
-                : table_{default_bucket_count_}, allocator_{alloc}
+                : table_{default_bucket_count_, hasher{}, key_equal{}, alloc},
+                  allocator_{alloc}
             { /* DUMMY BODY */ }
 
             unordered_set(const unordered_set& other, const allocator_type& alloc)
-                : table_{other.table_}, allocator_{alloc}
+                : table_{other.table_, alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             unordered_set(unordered_set&& other, const allocator_type& alloc)
-                : table_{move(other.table_)}, allocator_{alloc}
+                : table_{move(other.table_), alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             unordered_set(initializer_list<value_type> init,
@@ -506,7 +511,7 @@ namespace std
                                         const hasher& hf = hasher{},
                                         const key_equal& eql = key_equal{},
                                         const allocator_type& alloc = allocator_type{})
-                : table_{bucket_count, hf, eql}, allocator_{alloc}
+                : table_{bucket_count, hf, eql, alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             template<class InputIterator>
@@ -521,7 +526,11 @@ namespace std
             }
 
             unordered_multiset(const unordered_multiset& other)
-                : unordered_multiset{other, other.allocator_}
+                : unordered_multiset{
+                    other, allocator_traits<
+                        allocator_type
+                    >::select_on_container_copy_construction(other.allocator_)
+                  }
             { /* DUMMY BODY */ }
 
             unordered_multiset(unordered_multiset&& other)
@@ -529,15 +538,16 @@ namespace std
             { /* DUMMY BODY */ }
 
             explicit unordered_multiset(const allocator_type& alloc)
-                : table_{default_bucket_count_}, allocator_{alloc}
+                : table_{default_bucket_count_, hasher{}, key_equal{}, alloc},
+                  allocator_{alloc}
             { /* DUMMY BODY */ }
 
             unordered_multiset(const unordered_multiset& other, const allocator_type& alloc)
-                : table_{other.table_}, allocator_{alloc}
+                : table_{other.table_, alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             unordered_multiset(unordered_multiset&& other, const allocator_type& alloc)
-                : table_{move(other.table_)}, allocator_{alloc}
+                : table_{move(other.table_), alloc}, allocator_{alloc}
             { /* DUMMY BODY */ }
 
             unordered_multiset(initializer_list<value_type> init,
@@ -29,6 +29,1255 @@
 #ifndef LIBCPP_BITS_ADT_VALARRAY
 #define LIBCPP_BITS_ADT_VALARRAY
 
-#error "<valarray> is not implemented"
+#include <__bits/adt/valarray_expr.hpp>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+namespace std
+{
+    /**
+     * 26.6.4, class slice:
+     */
+
+    class slice
+    {
+        public:
+            slice()
+                : start_{}, size_{}, stride_{}
+            { /* DUMMY BODY */ }
+
+            slice(size_t start, size_t size, size_t stride)
+                : start_{start}, size_{size}, stride_{stride}
+            { /* DUMMY BODY */ }
+
+            slice(const slice&) = default;
+
+            slice& operator=(const slice&) = default;
+
+            size_t start() const
+            {
+                return start_;
+            }
+
+            size_t size() const
+            {
+                return size_;
+            }
+
+            size_t stride() const
+            {
+                return stride_;
+            }
+
+        private:
+            size_t start_;
+            size_t size_;
+            size_t stride_;
+    };
+
+    class gslice;
+
+    template<class T>
+    class slice_array;
+
+    template<class T>
+    class gslice_array;
+
+    template<class T>
+    class mask_array;
+
+    template<class T>
+    class indirect_array;
+
+    namespace aux
+    {
+        valarray<size_t> gslice_indices(const gslice& gs);
+        valarray<size_t> mask_indices(const valarray<bool>& mask);
+    }
+
+    /**
+     * 26.6.2, class template valarray:
+     */
+
+    template<class T>
+    class valarray
+    {
+        public:
+            using value_type = T;
+
+            /**
+             * 26.6.2.2, construct/destroy:
+             */
+
+            valarray()
+                : data_{nullptr}, size_{}
+            { /* DUMMY BODY */ }
+
+            explicit valarray(size_t n)
+                : valarray(T{}, n)
+            { /* DUMMY BODY */ }
+
+            valarray(const T& val, size_t n)
+                : data_{aux::va_allocate<T>(n)}, size_{data_ ? n : 0}
+            {
+                aux::va_construct(data_, aux::va_scalar<T>{val, size_}, size_);
+            }
+
+            valarray(const T* vals, size_t n)
+                : data_{aux::va_allocate<T>(n)}, size_{data_ ? n : 0}
+            {
+                aux::va_construct(data_, aux::va_ref<T>{vals, size_}, size_);
+            }
+
+            valarray(const valarray& other)
+                : valarray(other.data_, other.size_)
+            { /* DUMMY BODY */ }
+
+            valarray(valarray&& other) noexcept
+                : data_{other.data_}, size_{other.size_}
+            {
+                other.data_ = nullptr;
+                other.size_ = 0;
+            }
+
+            valarray(const slice_array<T>& arr)
+                : data_{aux::va_allocate<T>(arr.size_())}, size_{data_ ? arr.size_() : 0}
+            {
+                arr.construct_(data_);
+            }
+
+            valarray(const gslice_array<T>& arr)
+                : data_{aux::va_allocate<T>(arr.size_())}, size_{data_ ? arr.size_() : 0}
+            {
+                arr.construct_(data_);
+            }
+
+            valarray(const mask_array<T>& arr)
+                : data_{aux::va_allocate<T>(arr.size_())}, size_{data_ ? arr.size_() : 0}
+            {
+                arr.construct_(data_);
+            }
+
+            valarray(const indirect_array<T>& arr)
+                : data_{aux::va_allocate<T>(arr.size_())}, size_{data_ ? arr.size_() : 0}
+            {
+                arr.construct_(data_);
+            }
+
+            valarray(initializer_list<T> init)
+                : valarray(init.begin(), init.size())
+            { /* DUMMY BODY */ }
+
+            /**
+             * Evaluates an expression in a single pass,
+             * see aux::va_expr.
+             */
+            template<class E, class = enable_if_t<is_same_v<typename E::value_type, T>>>
+            valarray(const aux::va_expr<E>& expr)
+                : data_{aux::va_allocate<T>(expr.size())}, size_{data_ ? expr.size() : 0}
+            {
+                aux::va_construct(data_, expr.node(), size_);
+            }
+
+            ~valarray()
+            {
+                aux::va_deallocate(data_, size_);
+            }
+
+            /**
+             * 26.6.2.3, assignment:
+             */
+
+            valarray& operator=(const valarray& other)
+            {
+                if (this != &other)
+                    assign_(aux::va_ref<T>{other.data_, other.size_});
+
+                return *this;
+            }
+
+            valarray& operator=(valarray&& other) noexcept
+            {
+                swap(other);
+
+                return *this;
+            }
+
+            valarray& operator=(initializer_list<T> init)
+            {
+                assign_(aux::va_ref<T>{init.begin(), init.size()});
+
+                return *this;
+            }
+
+            valarray& operator=(const T& val)
+            {
+                aux::va_update(data_, aux::va_scalar<T>{val, size_},
+                               size_, aux::va_assign<T>{});
+
+                return *this;
+            }
+
+            valarray& operator=(const slice_array<T>& arr)
+            {
+                return *this = valarray{arr};
+            }
+
+            valarray& operator=(const gslice_array<T>& arr)
+            {
+                return *this = valarray{arr};
+            }
+
+            valarray& operator=(const mask_array<T>& arr)
+            {
+                return *this = valarray{arr};
+            }
+
+            valarray& operator=(const indirect_array<T>& arr)
+            {
+                return *this = valarray{arr};
+            }
+
+            template<class E, class = enable_if_t<is_same_v<typename E::value_type, T>>>
+            valarray& operator=(const aux::va_expr<E>& expr)
+            {
+                assign_(expr.node());
+
+                return *this;
+            }
+
+            /**
+             * 26.6.2.4, element access:
+             */
+
+            const T& operator[](size_t idx) const
+            {
+                return data_[idx];
+            }
+
+            T& operator[](size_t idx)
+            {
+                return data_[idx];
+            }
+
+            /**
+             * 26.6.2.5, subset operations:
+             */
+
+            valarray operator[](slice s) const
+            {
+                return valarray{slice_array<T>{data_, s}};
+            }
+
+            slice_array<T> operator[](slice s)
+            {
+                return slice_array<T>{data_, s};
+            }
+
+            valarray operator[](const gslice& gs) const
+            {
+                return valarray{gslice_array<T>{data_, aux::gslice_indices(gs)}};
+            }
+
+            gslice_array<T> operator[](const gslice& gs)
+            {
+                return gslice_array<T>{data_, aux::gslice_indices(gs)};
+            }
+
+            valarray operator[](const valarray<bool>& mask) const
+            {
+                return valarray{mask_array<T>{data_, aux::mask_indices(mask)}};
+            }
+
+            mask_array<T> operator[](const valarray<bool>& mask)
+            {
+                return mask_array<T>{data_, aux::mask_indices(mask)};
+            }
+
+            valarray operator[](const valarray<size_t>& idx) const
+            {
+                return valarray{indirect_array<T>{data_, valarray<size_t>{idx}}};
+            }
+
+            indirect_array<T> operator[](const valarray<size_t>& idx)
+            {
+                return indirect_array<T>{data_, valarray<size_t>{idx}};
+            }
+
+            /**
+             * 26.6.2.6, unary operators:
+             */
+
+            auto operator+() const
+            {
+                return aux::va_make_unary<aux::va_unary_plus<T>>(*this);
+            }
+
+            auto operator-() const
+            {
+                return aux::va_make_unary<negate<T>>(*this);
+            }
+
+            auto operator~() const
+            {
+                return aux::va_make_unary<bit_not<T>>(*this);
+            }
+
+            auto operator!() const
+            {
+                return aux::va_make_unary<logical_not<T>>(*this);
+            }
+
+            /**
+             * 26.6.2.7, computed assignment:
+             */
+
+            valarray& operator*=(const T& val)
+            {
+                return update_(aux::va_scalar<T>{val, size_}, multiplies<T>{});
+            }
+
+            valarray& operator/=(const T& val)
+            {
+                return update_(aux::va_scalar<T>{val, size_}, divides<T>{});
+            }
+
+            valarray& operator%=(const T& val)
+            {
+                return update_(aux::va_scalar<T>{val, size_}, modulus<T>{});
+            }
+
+            valarray& operator+=(const T& val)
+            {
+                return update_(aux::va_scalar<T>{val, size_}, plus<T>{});
+            }
+
+            valarray& operator-=(const T& val)
+            {
+                return update_(aux::va_scalar<T>{val, size_}, minus<T>{});
+            }
+
+            valarray& operator^=(const T& val)
+            {
+                return update_(aux::va_scalar<T>{val, size_}, bit_xor<T>{});
+            }
+
+            valarray& operator&=(const T& val)
+            {
+                return update_(aux::va_scalar<T>{val, size_}, bit_and<T>{});
+            }
+
+            valarray& operator|=(const T& val)
+            {
+                return update_(aux::va_scalar<T>{val, size_}, bit_or<T>{});
+            }
+
+            valarray& operator<<=(const T& val)
+            {
+                return update_(aux::va_scalar<T>{val, size_}, aux::va_shift_left<T>{});
+            }
+
+            valarray& operator>>=(const T& val)
+            {
+                return update_(aux::va_scalar<T>{val, size_}, aux::va_shift_right<T>{});
+            }
+
+            /**
+             * Note: These also take expressions, the
+             *       right hand side is evaluated on the fly.
+             */
+
+            template<class V>
+            enable_if_t<aux::is_va_operand_v<V>, valarray&> operator*=(const V& v)
+            {
+                return update_(aux::va_traits<V>::node(v), multiplies<T>{});
+            }
+
+            template<class V>
+            enable_if_t<aux::is_va_operand_v<V>, valarray&> operator/=(const V& v)
+            {
+                return update_(aux::va_traits<V>::node(v), divides<T>{});
+            }
+
+            template<class V>
+            enable_if_t<aux::is_va_operand_v<V>, valarray&> operator%=(const V& v)
+            {
+                return update_(aux::va_traits<V>::node(v), modulus<T>{});
+            }
+
+            template<class V>
+            enable_if_t<aux::is_va_operand_v<V>, valarray&> operator+=(const V& v)
+            {
+                return update_(aux::va_traits<V>::node(v), plus<T>{});
+            }
+
+            template<class V>
+            enable_if_t<aux::is_va_operand_v<V>, valarray&> operator-=(const V& v)
+            {
+                return update_(aux::va_traits<V>::node(v), minus<T>{});
+            }
+
+            template<class V>
+            enable_if_t<aux::is_va_operand_v<V>, valarray&> operator^=(const V& v)
+            {
+                return update_(aux::va_traits<V>::node(v), bit_xor<T>{});
+            }
+
+            template<class V>
+            enable_if_t<aux::is_va_operand_v<V>, valarray&> operator|=(const V& v)
+            {
+                return update_(aux::va_traits<V>::node(v), bit_or<T>{});
+            }
+
+            template<class V>
+            enable_if_t<aux::is_va_operand_v<V>, valarray&> operator&=(const V& v)
+            {
+                return update_(aux::va_traits<V>::node(v), bit_and<T>{});
+            }
+
+            template<class V>
+            enable_if_t<aux::is_va_operand_v<V>, valarray&> operator<<=(const V& v)
+            {
+                return update_(aux::va_traits<V>::node(v), aux::va_shift_left<T>{});
+            }
+
+            template<class V>
+            enable_if_t<aux::is_va_operand_v<V>, valarray&> operator>>=(const V& v)
+            {
+                return update_(aux::va_traits<V>::node(v), aux::va_shift_right<T>{});
+            }
+
+            /**
+             * 26.6.2.8, member functions:
+             */
+
+            void swap(valarray& other) noexcept
+            {
+                std::swap(data_, other.data_);
+                std::swap(size_, other.size_);
+            }
+
+            size_t size() const
+            {
+                return size_;
+            }
+
+            T sum() const
+            {
+                T res = data_[0];
+                for (size_t i = 1; i < size_; ++i)
+                    res += data_[i];
+
+                return res;
+            }
+
+            T min() const
+            {
+                T res = data_[0];
+                for (size_t i = 1; i < size_; ++i)
+                {
+                    if (data_[i] < res)
+                        res = data_[i];
+                }
+
+                return res;
+            }
+
+            T max() const
+            {
+                T res = data_[0];
+                for (size_t i = 1; i < size_; ++i)
+                {
+                    if (res < data_[i])
+                        res = data_[i];
+                }
+
+                return res;
+            }
+
+            valarray shift(int n) const
+            {
+                valarray res(size_);
+
+                /**
+                 * Element i of the result is element i + n
+                 * of this, or value initialized if that
+                 * is out of bounds.
+                 */
+                auto count = static_cast<size_t>(n < 0 ? -static_cast<long>(n) : n);
+                if (count >= size_)
+                    return res;
+
+                if (n >= 0)
+                {
+                    for (size_t i = 0; i < size_ - count; ++i)
+                        res.data_[i] = data_[i + count];
+                }
+                else
+                {
+                    for (size_t i = count; i < size_; ++i)
+                        res.data_[i] = data_[i - count];
+                }
+
+                return res;
+            }
+
+            valarray cshift(int n) const
+            {
+                if (size_ == 0)
+                    return valarray{};
+
+                auto count = static_cast<size_t>(n < 0 ? -static_cast<long>(n) : n) % size_;
+                if (n < 0)
+                    count = (size_ - count) % size_;
+
+                valarray res{};
+                res.data_ = aux::va_allocate<T>(size_);
+                if (!res.data_)
+                    return res;
+                res.size_ = size_;
+
+                /**
+                 * Note: The second half is not aligned, so we
+                 *       cannot use aux::va_construct here.
+                 */
+                for (size_t i = 0; i < size_; ++i)
+                    ::new(static_cast<void*>(res.data_ + i)) T(data_[(i + count) % size_]);
+
+                return res;
+            }
+
+            valarray apply(T func(T)) const
+            {
+                using node_type = aux::va_unary<T(*)(T), aux::va_ref<T>>;
+
+                return valarray{aux::va_expr<node_type>{
+                    node_type{aux::va_ref<T>{data_, size_}, func}
+                }};
+            }
+
+            valarray apply(T func(const T&)) const
+            {
+                using node_type = aux::va_unary<T(*)(const T&), aux::va_ref<T>>;
+
+                return valarray{aux::va_expr<node_type>{
+                    node_type{aux::va_ref<T>{data_, size_}, func}
+                }};
+            }
+
+            void resize(size_t n, T val = T{})
+            {
+                valarray(val, n).swap(*this);
+            }
+
+        private:
+            T* data_;
+            size_t size_;
+
+            /**
+             * Assignment from a valarray of a different size
+             * resizes this one (26.6.2.3). We evaluate into new
+             * storage in that case, so that the expression
+             * can still read our old elements.
+             */
+            template<class E>
+            void assign_(const E& e)
+            {
+                if (size_ == e.size())
+                    aux::va_update(data_, e, size_, aux::va_assign<T>{});
+                else
+                {
+                    valarray tmp{};
+                    tmp.data_ = aux::va_allocate<T>(e.size());
+                    if (!tmp.data_)
+                        return;
+                    tmp.size_ = e.size();
+
+                    aux::va_construct(tmp.data_, e, tmp.size_);
+                    swap(tmp);
+                }
+            }
+
+            template<class E, class Op>
+            valarray& update_(const E& e, const Op& op)
+            {
+                aux::va_update(data_, e, size_, op);
+
+                return *this;
+            }
+    };
+
+    template<class T, size_t N>
+    valarray(const T(&)[N], size_t) -> valarray<T>;
+
+    /**
+     * 26.6.6, class gslice:
+     */
+
+    class gslice
+    {
+        public:
+            gslice()
+                : start_{}, sizes_{}, strides_{}
+            { /* DUMMY BODY */ }
+
+            gslice(size_t start, const valarray<size_t>& sizes,
+                   const valarray<size_t>& strides)
+                : start_{start}, sizes_{sizes}, strides_{strides}
+            { /* DUMMY BODY */ }
+
+            gslice(const gslice&) = default;
+
+            gslice& operator=(const gslice&) = default;
+
+            size_t start() const
+            {
+                return start_;
+            }
+
+            valarray<size_t> size() const
+            {
+                return sizes_;
+            }
+
+            valarray<size_t> stride() const
+            {
+                return strides_;
+            }
+
+        private:
+            size_t start_;
+            valarray<size_t> sizes_;
+            valarray<size_t> strides_;
+    };
+
+    namespace aux
+    {
+        /**
+         * Common part of slice_array, gslice_array, mask_array
+         * and indirect_array. The element at index i of the
+         * subset is at data_[index_(i)], Derived provides
+         * index_ and size_.
+         */
+        template<class T, class Derived>
+        class va_subset
+        {
+            public:
+                using value_type = T;
+
+                void operator=(const valarray<T>& v) const
+                {
+                    update_(v, va_assign<T>{});
+                }
+
+                void operator=(const T& val) const
+                {
+                    update_(va_scalar<T>{val, derived_().size_()}, va_assign<T>{});
+                }
+
+                template<class E>
+                void operator=(const va_expr<E>& e) const
+                {
+                    update_(e.node(), va_assign<T>{});
+                }
+
+                template<class V>
+                enable_if_t<is_va_operand_v<V>> operator*=(const V& v) const
+                {
+                    update_(va_traits<V>::node(v), multiplies<T>{});
+                }
+
+                template<class V>
+                enable_if_t<is_va_operand_v<V>> operator/=(const V& v) const
+                {
+                    update_(va_traits<V>::node(v), divides<T>{});
+                }
+
+                template<class V>
+                enable_if_t<is_va_operand_v<V>> operator%=(const V& v) const
+                {
+                    update_(va_traits<V>::node(v), modulus<T>{});
+                }
+
+                template<class V>
+                enable_if_t<is_va_operand_v<V>> operator+=(const V& v) const
+                {
+                    update_(va_traits<V>::node(v), plus<T>{});
+                }
+
+                template<class V>
+                enable_if_t<is_va_operand_v<V>> operator-=(const V& v) const
+                {
+                    update_(va_traits<V>::node(v), minus<T>{});
+                }
+
+                template<class V>
+                enable_if_t<is_va_operand_v<V>> operator^=(const V& v) const
+                {
+                    update_(va_traits<V>::node(v), bit_xor<T>{});
+                }
+
+                template<class V>
+                enable_if_t<is_va_operand_v<V>> operator&=(const V& v) const
+                {
+                    update_(va_traits<V>::node(v), bit_and<T>{});
+                }
+
+                template<class V>
+                enable_if_t<is_va_operand_v<V>> operator|=(const V& v) const
+                {
+                    update_(va_traits<V>::node(v), bit_or<T>{});
+                }
+
+                template<class V>
+                enable_if_t<is_va_operand_v<V>> operator<<=(const V& v) const
+                {
+                    update_(va_traits<V>::node(v), va_shift_left<T>{});
+                }
+
+                template<class V>
+                enable_if_t<is_va_operand_v<V>> operator>>=(const V& v) const
+                {
+                    update_(va_traits<V>::node(v), va_shift_right<T>{});
+                }
+
+            protected:
+                T* data_;
+
+                explicit va_subset(T* data)
+                    : data_{data}
+                { /* DUMMY BODY */ }
+
+                void copy_(const va_subset& other) const
+                {
+                    auto& src = static_cast<const Derived&>(other);
+                    for (size_t i = 0; i < src.size_(); ++i)
+                        data_[derived_().index_(i)] = other.data_[src.index_(i)];
+                }
+
+                void construct_(T* res) const
+                {
+                    for (size_t i = 0; i < derived_().size_(); ++i)
+                        ::new(static_cast<void*>(res + i)) T(data_[derived_().index_(i)]);
+                }
+
+                template<class E, class Op>
+                void update_(const E& e, const Op& op) const
+                {
+                    for (size_t i = 0; i < derived_().size_(); ++i)
+                    {
+                        auto& elem = data_[derived_().index_(i)];
+                        elem = op(elem, e[i]);
+                    }
+                }
+
+            private:
+                const Derived& derived_() const
+                {
+                    return static_cast<const Derived&>(*this);
+                }
+
+                template<class U, class V>
+                void update_(const valarray<U>& v, const V& op) const
+                {
+                    update_(va_ref<U>{v.size() ? &v[0] : nullptr, v.size()}, op);
+                }
+        };
+
+        inline valarray<size_t> gslice_indices(const gslice& gs)
+        {
+            auto sizes = gs.size();
+            auto strides = gs.stride();
+            auto dims = sizes.size();
+
+            size_t count = dims ? 1 : 0;
+            for (size_t i = 0; i < dims; ++i)
+                count *= sizes[i];
+
+            /**
+             * Odometer over the dimensions, the last one
+             * changes fastest (26.6.6.1).
+             */
+            valarray<size_t> res(count);
+            valarray<size_t> pos(dims);
+            auto idx = gs.start();
+            for (size_t i = 0; i < count; ++i)
+            {
+                res[i] = idx;
+
+                for (size_t d = dims; d-- > 0;)
+                {
+                    idx += strides[d];
+                    if (++pos[d] < sizes[d])
+                        break;
+
+                    idx -= pos[d] * strides[d];
+                    pos[d] = 0;
+                }
+            }
+
+            return res;
+        }
+
+        inline valarray<size_t> mask_indices(const valarray<bool>& mask)
+        {
+            size_t count{};
+            for (size_t i = 0; i < mask.size(); ++i)
+                count += mask[i] ? 1 : 0;
+
+            valarray<size_t> res(count);
+            for (size_t i = 0, j = 0; i < mask.size(); ++i)
+            {
+                if (mask[i])
+                    res[j++] = i;
+            }
+
+            return res;
+        }
+    }
+
+    /**
+     * 26.6.5, class template slice_array:
+     */
+
+    template<class T>
+    class slice_array: public aux::va_subset<T, slice_array<T>>
+    {
+        using base_type = aux::va_subset<T, slice_array<T>>;
+
+        public:
+            using value_type = T;
+
+            using base_type::operator=;
+
+            slice_array(const slice_array&) = default;
+
+            const slice_array& operator=(const slice_array& other) const
+            {
+                this->copy_(other);
+
+                return *this;
+            }
+
+            ~slice_array() = default;
+
+            slice_array() = delete;
+
+        private:
+            slice slice_;
+
+            slice_array(T* data, slice s)
+                : base_type{data}, slice_{s}
+            { /* DUMMY BODY */ }
+
+            size_t index_(size_t i) const
+            {
+                return slice_.start() + i * slice_.stride();
+            }
+
+            size_t size_() const
+            {
+                return slice_.size();
+            }
+
+            friend class valarray<T>;
+            friend base_type;
+    };
+
+    namespace aux
+    {
+        /**
+         * Common part of gslice_array, mask_array and
+         * indirect_array, which all have a list of indices.
+         */
+        template<class T, class Derived>
+        class va_indirect_subset: public va_subset<T, Derived>
+        {
+            protected:
+                valarray<size_t> indices_;
+
+                va_indirect_subset(T* data, valarray<size_t>&& indices)
+                    : va_subset<T, Derived>{data}, indices_{move(indices)}
+                { /* DUMMY BODY */ }
+
+                size_t index_(size_t i) const
+                {
+                    return indices_[i];
+                }
+
+                size_t size_() const
+                {
+                    return indices_.size();
+                }
+
+                friend va_subset<T, Derived>;
+        };
+    }
+
+    /**
+     * 26.6.7, class template gslice_array:
+     */
+
+    template<class T>
+    class gslice_array: public aux::va_indirect_subset<T, gslice_array<T>>
+    {
+        using base_type = aux::va_indirect_subset<T, gslice_array<T>>;
+
+        public:
+            using value_type = T;
+
+            using aux::va_subset<T, gslice_array<T>>::operator=;
+
+            gslice_array(const gslice_array&) = default;
+
+            const gslice_array& operator=(const gslice_array& other) const
+            {
+                this->copy_(other);
+
+                return *this;
+            }
+
+            ~gslice_array() = default;
+
+            gslice_array() = delete;
+
+        private:
+            gslice_array(T* data, valarray<size_t>&& indices)
+                : base_type{data, move(indices)}
+            { /* DUMMY BODY */ }
+
+            friend class valarray<T>;
+            friend aux::va_subset<T, gslice_array<T>>;
+    };
+
+    /**
+     * 26.6.8, class template mask_array:
+     */
+
+    template<class T>
+    class mask_array: public aux::va_indirect_subset<T, mask_array<T>>
+    {
+        using base_type = aux::va_indirect_subset<T, mask_array<T>>;
+
+        public:
+            using value_type = T;
+
+            using aux::va_subset<T, mask_array<T>>::operator=;
+
+            mask_array(const mask_array&) = default;
+
+            const mask_array& operator=(const mask_array& other) const
+            {
+                this->copy_(other);
+
+                return *this;
+            }
+
+            ~mask_array() = default;
+
+            mask_array() = delete;
+
+        private:
+            mask_array(T* data, valarray<size_t>&& indices)
+                : base_type{data, move(indices)}
+            { /* DUMMY BODY */ }
+
+            friend class valarray<T>;
+            friend aux::va_subset<T, mask_array<T>>;
+    };
+
+    /**
+     * 26.6.9, class template indirect_array:
+     */
+
+    template<class T>
+    class indirect_array: public aux::va_indirect_subset<T, indirect_array<T>>
+    {
+        using base_type = aux::va_indirect_subset<T, indirect_array<T>>;
+
+        public:
+            using value_type = T;
+
+            using aux::va_subset<T, indirect_array<T>>::operator=;
+
+            indirect_array(const indirect_array&) = default;
+
+            const indirect_array& operator=(const indirect_array& other) const
+            {
+                this->copy_(other);
+
+                return *this;
+            }
+
+            ~indirect_array() = default;
+
+            indirect_array() = delete;
+
+        private:
+            indirect_array(T* data, valarray<size_t>&& indices)
+                : base_type{data, move(indices)}
+            { /* DUMMY BODY */ }
+
+            friend class valarray<T>;
+            friend aux::va_subset<T, indirect_array<T>>;
+    };
+
+    /**
+     * 26.6.2.8, specialized algorithms:
+     */
+
+    template<class T>
+    void swap(valarray<T>& lhs, valarray<T>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    /**
+     * 26.6.3, valarray non-member operations:
+     * Note: All of these accept both valarrays and
+     *       expressions and return an expression.
+     */
+
+#define LIBCPP_VALARRAY_BINARY_OP(op, functor) \
+    template<class L, class R> \
+    enable_if_t< \
+        aux::is_va_operand_v<L> && aux::is_va_operand_v<R>, \
+        aux::va_expr<aux::va_binary< \
+            functor<aux::va_value_t<L>>, aux::va_node_t<L>, aux::va_node_t<R> \
+        >> \
+    > \
+    operator op(const L& lhs, const R& rhs) \
+    { \
+        return aux::va_make_binary<functor<aux::va_value_t<L>>>(lhs, rhs); \
+    } \
+    \
+    template<class L> \
+    enable_if_t< \
+        aux::is_va_operand_v<L>, \
+        aux::va_expr<aux::va_binary< \
+            functor<aux::va_value_t<L>>, aux::va_node_t<L>, \
+            aux::va_scalar<aux::va_value_t<L>> \
+        >> \
+    > \
+    operator op(const L& lhs, const aux::va_value_t<L>& rhs) \
+    { \
+        return aux::va_make_binary_rscalar<functor<aux::va_value_t<L>>>(lhs, rhs); \
+    } \
+    \
+    template<class R> \
+    enable_if_t< \
+        aux::is_va_operand_v<R>, \
+        aux::va_expr<aux::va_binary< \
+            functor<aux::va_value_t<R>>, aux::va_scalar<aux::va_value_t<R>>, \
+            aux::va_node_t<R> \
+        >> \
+    > \
+    operator op(const aux::va_value_t<R>& lhs, const R& rhs) \
+    { \
+        return aux::va_make_binary_lscalar<functor<aux::va_value_t<R>>>(lhs, rhs); \
+    }
+
+    LIBCPP_VALARRAY_BINARY_OP(*, multiplies)
+    LIBCPP_VALARRAY_BINARY_OP(/, divides)
+    LIBCPP_VALARRAY_BINARY_OP(%, modulus)
+    LIBCPP_VALARRAY_BINARY_OP(+, plus)
+    LIBCPP_VALARRAY_BINARY_OP(-, minus)
+    LIBCPP_VALARRAY_BINARY_OP(^, bit_xor)
+    LIBCPP_VALARRAY_BINARY_OP(&, bit_and)
+    LIBCPP_VALARRAY_BINARY_OP(|, bit_or)
+    LIBCPP_VALARRAY_BINARY_OP(<<, aux::va_shift_left)
+    LIBCPP_VALARRAY_BINARY_OP(>>, aux::va_shift_right)
+    LIBCPP_VALARRAY_BINARY_OP(&&, logical_and)
+    LIBCPP_VALARRAY_BINARY_OP(||, logical_or)
+
+    /**
+     * 26.6.3.2, logical operators:
+     */
+
+    LIBCPP_VALARRAY_BINARY_OP(==, equal_to)
+    LIBCPP_VALARRAY_BINARY_OP(!=, not_equal_to)
+    LIBCPP_VALARRAY_BINARY_OP(<, less)
+    LIBCPP_VALARRAY_BINARY_OP(>, greater)
+    LIBCPP_VALARRAY_BINARY_OP(<=, less_equal)
+    LIBCPP_VALARRAY_BINARY_OP(>=, greater_equal)
+
+#undef LIBCPP_VALARRAY_BINARY_OP
+
+    /**
+     * Unary operators of expressions, valarray
+     * has them as members.
+     */
+
+    template<class E>
+    auto operator+(const aux::va_expr<E>& e)
+    {
+        return aux::va_make_unary<aux::va_unary_plus<typename E::value_type>>(e);
+    }
+
+    template<class E>
+    auto operator-(const aux::va_expr<E>& e)
+    {
+        return aux::va_make_unary<negate<typename E::value_type>>(e);
+    }
+
+    template<class E>
+    auto operator~(const aux::va_expr<E>& e)
+    {
+        return aux::va_make_unary<bit_not<typename E::value_type>>(e);
+    }
+
+    template<class E>
+    auto operator!(const aux::va_expr<E>& e)
+    {
+        return aux::va_make_unary<logical_not<typename E::value_type>>(e);
+    }
+
+    /**
+     * 26.6.3.3, transcendentals:
+     */
+
+#define LIBCPP_VALARRAY_UNARY_FUNCTION(name, functor) \
+    template<class V> \
+    enable_if_t<aux::is_va_operand_v<V>, aux::va_expr<aux::va_unary<functor, aux::va_node_t<V>>>> \
+    name(const V& v) \
+    { \
+        return aux::va_make_unary<functor>(v); \
+    }
+
+    LIBCPP_VALARRAY_UNARY_FUNCTION(abs, aux::va_abs<aux::va_value_t<V>>)
+    LIBCPP_VALARRAY_UNARY_FUNCTION(acos, aux::va_acos)
+    LIBCPP_VALARRAY_UNARY_FUNCTION(asin, aux::va_asin)
+    LIBCPP_VALARRAY_UNARY_FUNCTION(atan, aux::va_atan)
+    LIBCPP_VALARRAY_UNARY_FUNCTION(cos, aux::va_cos)
+    LIBCPP_VALARRAY_UNARY_FUNCTION(cosh, aux::va_cosh)
+    LIBCPP_VALARRAY_UNARY_FUNCTION(exp, aux::va_exp)
+    LIBCPP_VALARRAY_UNARY_FUNCTION(log, aux::va_log)
+    LIBCPP_VALARRAY_UNARY_FUNCTION(log10, aux::va_log10)
+    LIBCPP_VALARRAY_UNARY_FUNCTION(sin, aux::va_sin)
+    LIBCPP_VALARRAY_UNARY_FUNCTION(sinh, aux::va_sinh)
+    LIBCPP_VALARRAY_UNARY_FUNCTION(sqrt, aux::va_sqrt)
+    LIBCPP_VALARRAY_UNARY_FUNCTION(tan, aux::va_tan)
+    LIBCPP_VALARRAY_UNARY_FUNCTION(tanh, aux::va_tanh)
+
+#undef LIBCPP_VALARRAY_UNARY_FUNCTION
+
+#define LIBCPP_VALARRAY_BINARY_FUNCTION(name, functor) \
+    template<class L, class R> \
+    enable_if_t< \
+        aux::is_va_operand_v<L> && aux::is_va_operand_v<R>, \
+        aux::va_expr<aux::va_binary<functor, aux::va_node_t<L>, aux::va_node_t<R>>> \
+    > \
+    name(const L& lhs, const R& rhs) \
+    { \
+        return aux::va_make_binary<functor>(lhs, rhs); \
+    } \
+    \
+    template<class L> \
+    enable_if_t< \
+        aux::is_va_operand_v<L>, \
+        aux::va_expr<aux::va_binary< \
+            functor, aux::va_node_t<L>, aux::va_scalar<aux::va_value_t<L>> \
+        >> \
+    > \
+    name(const L& lhs, const aux::va_value_t<L>& rhs) \
+    { \
+        return aux::va_make_binary_rscalar<functor>(lhs, rhs); \
+    } \
+    \
+    template<class R> \
+    enable_if_t< \
+        aux::is_va_operand_v<R>, \
+        aux::va_expr<aux::va_binary< \
+            functor, aux::va_scalar<aux::va_value_t<R>>, aux::va_node_t<R> \
+        >> \
+    > \
+    name(const aux::va_value_t<R>& lhs, const R& rhs) \
+    { \
+        return aux::va_make_binary_lscalar<functor>(lhs, rhs); \
+    }
+
+    LIBCPP_VALARRAY_BINARY_FUNCTION(atan2, aux::va_atan2)
+    LIBCPP_VALARRAY_BINARY_FUNCTION(pow, aux::va_pow)
+
+#undef LIBCPP_VALARRAY_BINARY_FUNCTION
+
+    /**
+     * Expressions live in std::aux, so argument dependent
+     * lookup searches for their operators and functions there
+     * and not in std. Without these, a * b + c would not
+     * compile outside of std.
+     */
+    namespace aux
+    {
+        using std::operator*;
+        using std::operator/;
+        using std::operator%;
+        using std::operator+;
+        using std::operator-;
+        using std::operator^;
+        using std::operator&;
+        using std::operator|;
+        using std::operator<<;
+        using std::operator>>;
+        using std::operator&&;
+        using std::operator||;
+        using std::operator==;
+        using std::operator!=;
+        using std::operator<;
+        using std::operator>;
+        using std::operator<=;
+        using std::operator>=;
+        using std::operator~;
+        using std::operator!;
+
+        using std::abs;
+        using std::acos;
+        using std::asin;
+        using std::atan;
+        using std::cos;
+        using std::cosh;
+        using std::exp;
+        using std::log;
+        using std::log10;
+        using std::sin;
+        using std::sinh;
+        using std::sqrt;
+        using std::tan;
+        using std::tanh;
+        using std::atan2;
+        using std::pow;
+    }
+
+    /**
+     * 26.6.10, valarray range access:
+     */
+
+    template<class T>
+    T* begin(valarray<T>& v)
+    {
+        return v.size() ? &v[0] : nullptr;
+    }
+
+    template<class T>
+    const T* begin(const valarray<T>& v)
+    {
+        return v.size() ? &v[0] : nullptr;
+    }
+
+    template<class T>
+    T* end(valarray<T>& v)
+    {
+        return begin(v) + v.size();
+    }
+
+    template<class T>
+    const T* end(const valarray<T>& v)
+    {
+        return begin(v) + v.size();
+    }
+}
+
+#undef LIBCPP_VALARRAY_IVDEP
 
 #endif
@@ -0,0 +1,566 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_ADT_VALARRAY_EXPR
+#define LIBCPP_BITS_ADT_VALARRAY_EXPR
+
+#include <__bits/functional/arithmetic_operations.hpp>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <malloc.h>
+
+/**
+ * The evaluation loops never carry a dependency from one
+ * iteration to another, see va_construct.
+ */
+#if defined(__GNUC__) && !defined(__clang__)
+#define LIBCPP_VALARRAY_IVDEP _Pragma("GCC ivdep")
+#else
+#define LIBCPP_VALARRAY_IVDEP
+#endif
+
+namespace std
+{
+    template<class T>
+    class valarray;
+}
+
+namespace std::aux
+{
+    /**
+     * Expression templates for valarray. An operator applied
+     * to valarrays does not compute anything, it returns
+     * a va_expr that holds a tree of the nodes below and
+     * the whole tree is evaluated in a single loop once it is
+     * assigned to a valarray. This means that a * b + c
+     * does one pass over the operands and creates no
+     * temporaries, as 26.6.1(3) allows.
+     *
+     * Every node has a value_type, size() and an operator[]
+     * that computes a single element. Nodes are held by value,
+     * leaves only keep a pointer to the data of the valarray
+     * they refer to, so an expression must not outlive its
+     * operands (which is the case for all other implementations
+     * as well).
+     */
+
+    /**
+     * Alignment of valarray storage, a cache line
+     * fits the widest vector registers we have.
+     */
+    inline constexpr size_t va_alignment{64};
+
+    template<class T>
+    T* va_allocate(size_t n)
+    {
+        if (n == 0)
+            return nullptr;
+
+        auto align = alignof(T) > va_alignment ? alignof(T) : va_alignment;
+        auto res = static_cast<T*>(::helenos::memalign(align, n * sizeof(T)));
+        if (!res)
+            throw bad_alloc{};
+
+        return res;
+    }
+
+    template<class T>
+    void va_deallocate(T* data, size_t n)
+    {
+        if (!data)
+            return;
+
+        if constexpr (!is_trivially_destructible_v<T>)
+        {
+            for (size_t i = 0; i < n; ++i)
+                data[i].~T();
+        }
+
+        ::std::free(data);
+    }
+
+    /**
+     * Leaf referring to the elements of a valarray.
+     */
+    template<class T>
+    class va_ref
+    {
+        public:
+            using value_type = T;
+
+            va_ref(const T* data, size_t size)
+                : data_{data}, size_{size}
+            { /* DUMMY BODY */ }
+
+            const T& operator[](size_t i) const
+            {
+                return data_[i];
+            }
+
+            size_t size() const
+            {
+                return size_;
+            }
+
+        private:
+            const T* data_;
+            size_t size_;
+    };
+
+    /**
+     * Leaf that repeats a single value, for the
+     * operators that take a scalar operand.
+     */
+    template<class T>
+    class va_scalar
+    {
+        public:
+            using value_type = T;
+
+            va_scalar(const T& value, size_t size)
+                : value_{value}, size_{size}
+            { /* DUMMY BODY */ }
+
+            const T& operator[](size_t) const
+            {
+                return value_;
+            }
+
+            size_t size() const
+            {
+                return size_;
+            }
+
+        private:
+            T value_;
+            size_t size_;
+    };
+
+    template<class Op, class E>
+    class va_unary
+    {
+        public:
+            using value_type = decay_t<
+                decltype(declval<const Op&>()(declval<typename E::value_type>()))
+            >;
+
+            va_unary(const E& e, const Op& op = Op{})
+                : e_{e}, op_{op}
+            { /* DUMMY BODY */ }
+
+            value_type operator[](size_t i) const
+            {
+                return op_(e_[i]);
+            }
+
+            size_t size() const
+            {
+                return e_.size();
+            }
+
+        private:
+            E e_;
+            Op op_;
+    };
+
+    template<class Op, class L, class R>
+    class va_binary
+    {
+        public:
+            using value_type = decay_t<
+                decltype(declval<const Op&>()(
+                    declval<typename L::value_type>(),
+                    declval<typename R::value_type>()
+                ))
+            >;
+
+            va_binary(const L& lhs, const R& rhs)
+                : lhs_{lhs}, rhs_{rhs}, op_{}
+            { /* DUMMY BODY */ }
+
+            value_type operator[](size_t i) const
+            {
+                return op_(lhs_[i], rhs_[i]);
+            }
+
+            size_t size() const
+            {
+                return lhs_.size();
+            }
+
+        private:
+            L lhs_;
+            R rhs_;
+            Op op_;
+    };
+
+    /**
+     * Loops all evaluation goes through. The destination is
+     * aligned and iteration i only ever reads element i of
+     * the operands, even if one of them is the destination
+     * itself, so the loops can be vectorized without the
+     * runtime alias checks the compiler would otherwise
+     * have to emit.
+     */
+    template<class T, class E>
+    void va_construct(T* data, const E& e, size_t n)
+    {
+        data = static_cast<T*>(__builtin_assume_aligned(data, va_alignment));
+
+        /**
+         * Note: Our placement new is not inline and its call
+         *       would prevent vectorization, for trivial
+         *       types assignment has the same effect.
+         */
+        if constexpr (is_trivial_v<T>)
+        {
+            LIBCPP_VALARRAY_IVDEP
+            for (size_t i = 0; i < n; ++i)
+                data[i] = e[i];
+        }
+        else
+        {
+            for (size_t i = 0; i < n; ++i)
+                ::new(static_cast<void*>(data + i)) T(e[i]);
+        }
+    }
+
+    template<class T, class E, class Op>
+    void va_update(T* data, const E& e, size_t n, const Op& op)
+    {
+        data = static_cast<T*>(__builtin_assume_aligned(data, va_alignment));
+
+        LIBCPP_VALARRAY_IVDEP
+        for (size_t i = 0; i < n; ++i)
+            data[i] = op(data[i], e[i]);
+    }
+
+    template<class E>
+    class va_expr;
+
+    /**
+     * Operand of the valarray operators, that is either
+     * a valarray or an expression.
+     */
+    template<class X>
+    struct va_traits
+    {
+        static constexpr bool is_operand = false;
+    };
+
+    template<class T>
+    struct va_traits<valarray<T>>
+    {
+        static constexpr bool is_operand = true;
+
+        using value_type = T;
+        using node_type  = va_ref<T>;
+
+        static node_type node(const valarray<T>& v)
+        {
+            return node_type{v.size() ? &v[0] : nullptr, v.size()};
+        }
+    };
+
+    template<class E>
+    struct va_traits<va_expr<E>>
+    {
+        static constexpr bool is_operand = true;
+
+        using value_type = typename E::value_type;
+        using node_type  = E;
+
+        static const node_type& node(const va_expr<E>& e)
+        {
+            return e.node();
+        }
+    };
+
+    template<class X>
+    inline constexpr bool is_va_operand_v = va_traits<X>::is_operand;
+
+    template<class X>
+    using va_value_t = typename va_traits<X>::value_type;
+
+    template<class X>
+    using va_node_t = typename va_traits<X>::node_type;
+
+    /**
+     * The type operators return, provides the const
+     * members of valarray so that it can be used in
+     * its place.
+     */
+    template<class E>
+    class va_expr
+    {
+        public:
+            using value_type = typename E::value_type;
+
+            explicit va_expr(const E& e)
+                : e_{e}
+            { /* DUMMY BODY */ }
+
+            value_type operator[](size_t i) const
+            {
+                return e_[i];
+            }
+
+            size_t size() const
+            {
+                return e_.size();
+            }
+
+            value_type sum() const
+            {
+                value_type res = e_[0];
+                for (size_t i = 1; i < e_.size(); ++i)
+                    res += e_[i];
+
+                return res;
+            }
+
+            value_type min() const
+            {
+                return valarray<value_type>(*this).min();
+            }
+
+            value_type max() const
+            {
+                return valarray<value_type>(*this).max();
+            }
+
+            valarray<value_type> shift(int n) const
+            {
+                return valarray<value_type>(*this).shift(n);
+            }
+
+            valarray<value_type> cshift(int n) const
+            {
+                return valarray<value_type>(*this).cshift(n);
+            }
+
+            valarray<value_type> apply(value_type func(value_type)) const
+            {
+                return valarray<value_type>(*this).apply(func);
+            }
+
+            valarray<value_type> apply(value_type func(const value_type&)) const
+            {
+                return valarray<value_type>(*this).apply(func);
+            }
+
+            const E& node() const
+            {
+                return e_;
+            }
+
+        private:
+            E e_;
+    };
+
+    template<class Op, class X>
+    auto va_make_unary(const X& x)
+    {
+        using node_type = va_unary<Op, va_node_t<X>>;
+
+        return va_expr<node_type>{node_type{va_traits<X>::node(x)}};
+    }
+
+    template<class Op, class L, class R>
+    auto va_make_binary(const L& lhs, const R& rhs)
+    {
+        using node_type = va_binary<Op, va_node_t<L>, va_node_t<R>>;
+
+        return va_expr<node_type>{
+            node_type{va_traits<L>::node(lhs), va_traits<R>::node(rhs)}
+        };
+    }
+
+    template<class Op, class L>
+    auto va_make_binary_rscalar(const L& lhs, const va_value_t<L>& rhs)
+    {
+        using value_type = va_value_t<L>;
+        using node_type = va_binary<Op, va_node_t<L>, va_scalar<value_type>>;
+
+        return va_expr<node_type>{
+            node_type{va_traits<L>::node(lhs), va_scalar<value_type>{rhs, lhs.size()}}
+        };
+    }
+
+    template<class Op, class R>
+    auto va_make_binary_lscalar(const va_value_t<R>& lhs, const R& rhs)
+    {
+        using value_type = va_value_t<R>;
+        using node_type = va_binary<Op, va_scalar<value_type>, va_node_t<R>>;
+
+        return va_expr<node_type>{
+            node_type{va_scalar<value_type>{lhs, rhs.size()}, va_traits<R>::node(rhs)}
+        };
+    }
+
+    /**
+     * Functors that <functional> does not have.
+     */
+
+    template<class T>
+    struct va_unary_plus
+    {
+        T operator()(const T& x) const
+        {
+            return +x;
+        }
+    };
+
+    template<class T>
+    struct va_shift_left
+    {
+        T operator()(const T& lhs, const T& rhs) const
+        {
+            return lhs << rhs;
+        }
+    };
+
+    template<class T>
+    struct va_shift_right
+    {
+        T operator()(const T& lhs, const T& rhs) const
+        {
+            return lhs >> rhs;
+        }
+    };
+
+    template<class T>
+    struct va_assign
+    {
+        const T& operator()(const T&, const T& rhs) const
+        {
+            return rhs;
+        }
+    };
+
+    template<class T>
+    struct va_abs
+    {
+        T operator()(const T& x) const
+        {
+            return x < T{} ? -x : x;
+        }
+    };
+
+    /**
+     * We have no <cmath>, so the transcendental functions
+     * use the compiler builtins for the floating point types.
+     * Other types are expected to provide the function
+     * in their own namespace, as std::complex does.
+     */
+#define LIBCPP_VALARRAY_MATH_FUNCTOR(name) \
+    struct va_##name \
+    { \
+        float operator()(float x) const \
+        { \
+            return __builtin_##name##f(x); \
+        } \
+        \
+        double operator()(double x) const \
+        { \
+            return __builtin_##name(x); \
+        } \
+        \
+        long double operator()(long double x) const \
+        { \
+            return __builtin_##name##l(x); \
+        } \
+        \
+        template<class T> \
+        T operator()(const T& x) const \
+        { \
+            if constexpr (is_integral_v<T>) \
+                return static_cast<T>(__builtin_##name(static_cast<double>(x))); \
+            else \
+                return name(x); \
+        } \
+    };
+
+    LIBCPP_VALARRAY_MATH_FUNCTOR(acos)
+    LIBCPP_VALARRAY_MATH_FUNCTOR(asin)
+    LIBCPP_VALARRAY_MATH_FUNCTOR(atan)
+    LIBCPP_VALARRAY_MATH_FUNCTOR(cos)
+    LIBCPP_VALARRAY_MATH_FUNCTOR(cosh)
+    LIBCPP_VALARRAY_MATH_FUNCTOR(exp)
+    LIBCPP_VALARRAY_MATH_FUNCTOR(log)
+    LIBCPP_VALARRAY_MATH_FUNCTOR(log10)
+    LIBCPP_VALARRAY_MATH_FUNCTOR(sin)
+    LIBCPP_VALARRAY_MATH_FUNCTOR(sinh)
+    LIBCPP_VALARRAY_MATH_FUNCTOR(sqrt)
+    LIBCPP_VALARRAY_MATH_FUNCTOR(tan)
+    LIBCPP_VALARRAY_MATH_FUNCTOR(tanh)
+
+#undef LIBCPP_VALARRAY_MATH_FUNCTOR
+
+#define LIBCPP_VALARRAY_MATH_FUNCTOR2(name) \
+    struct va_##name \
+    { \
+        float operator()(float x, float y) const \
+        { \
+            return __builtin_##name##f(x, y); \
+        } \
+        \
+        double operator()(double x, double y) const \
+        { \
+            return __builtin_##name(x, y); \
+        } \
+        \
+        long double operator()(long double x, long double y) const \
+        { \
+            return __builtin_##name##l(x, y); \
+        } \
+        \
+        template<class T> \
+        T operator()(const T& x, const T& y) const \
+        { \
+            if constexpr (is_integral_v<T>) \
+            { \
+                return static_cast<T>(__builtin_##name( \
+                    static_cast<double>(x), static_cast<double>(y) \
+                )); \
+            } \
+            else \
+                return name(x, y); \
+        } \
+    };
+
+    LIBCPP_VALARRAY_MATH_FUNCTOR2(atan2)
+    LIBCPP_VALARRAY_MATH_FUNCTOR2(pow)
+
+#undef LIBCPP_VALARRAY_MATH_FUNCTOR2
+}
+
+#endif
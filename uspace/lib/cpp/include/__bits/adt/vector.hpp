@@ -33,6 +33,7 @@
 #include <initializer_list>
 #include <iterator>
 #include <memory>
+#include <type_traits>
 #include <utility>
 
 namespace std
@@ -82,15 +83,27 @@ namespace std
                 data_ = allocator_.allocate(capacity_);
 
                 for (size_type i = 0; i < size_; ++i)
-                    data_[i] = val;
+                    allocator_traits<Allocator>::construct(allocator_, data_ + i, val);
             }
 
             template<class InputIterator>
             vector(InputIterator first, InputIterator last,
                    const Allocator& alloc = Allocator{})
+                : data_{nullptr}, size_{}, capacity_{}, allocator_{alloc}
             {
-                // TODO: research constraints and provide multiple
-                //       implementations via enable_if
+                if constexpr (is_integral<InputIterator>::value)
+                { // Required by the standard.
+                    auto n = static_cast<size_type>(first);
+
+                    reserve(n);
+                    while (size_ < n)
+                        emplace_back(static_cast<value_type>(last));
+                }
+                else
+                {
+                    while (first != last)
+                        emplace_back(*first++);
+                }
             }
 
             vector(const vector& other)
@@ -100,7 +113,7 @@ namespace std
                 data_ = allocator_.allocate(capacity_);
 
                 for (size_type i = 0; i < size_; ++i)
-                    data_[i] = other.data_[i];
+                    allocator_traits<Allocator>::construct(allocator_, data_ + i, other.data_[i]);
             }
 
             vector(vector&& other) noexcept
@@ -119,7 +132,7 @@ namespace std
                 data_ = allocator_.allocate(capacity_);
 
                 for (size_type i = 0; i < size_; ++i)
-                    data_[i] = other.data_[i];
+                    allocator_traits<Allocator>::construct(allocator_, data_ + i, other.data_[i]);
             }
 
             vector(initializer_list<T> init, const Allocator& alloc = Allocator{})
@@ -130,13 +143,12 @@ namespace std
 
                 auto it = init.begin();
                 for (size_type i = 0; it != init.end(); ++i, ++it)
-                {
-                    data_[i] = *it;
-                }
+                    allocator_traits<Allocator>::construct(allocator_, data_ + i, *it);
             }
 
             ~vector()
             {
+                clear();
                 allocator_.deallocate(data_, capacity_);
             }
 
@@ -153,7 +165,10 @@ namespace std
                          allocator_traits<Allocator>::is_always_equal::value)
             {
                 if (data_)
+                {
+                    clear();
                     allocator_.deallocate(data_, capacity_);
+                }
 
                 // TODO: test this
                 data_ = other.data_;
@@ -274,16 +289,26 @@ namespace std
 
             void resize(size_type sz)
             {
-                resize_with_copy_(size_, capacity_);
+                if (sz <= size_)
+                    resize_with_copy_(sz, capacity_);
+                else
+                {
+                    reserve(sz);
+                    while (size_ < sz)
+                        emplace_back();
+                }
             }
 
             void resize(size_type sz, const value_type& val)
             {
-                auto old_size = size_;
-                resize_with_copy_(sz, capacity_);
-
-                for (size_type i = old_size - 1; i < size_; ++i)
-                    data_[i] = val;
+                if (sz <= size_)
+                    resize_with_copy_(sz, capacity_);
+                else
+                {
+                    reserve(sz);
+                    while (size_ < sz)
+                        emplace_back(val);
+                }
             }
 
             size_type capacity() const noexcept
@@ -377,22 +402,19 @@ namespace std
 
                 allocator_traits<Allocator>::construct(allocator_,
                                                        begin() + size_, forward<Args>(args)...);
+                ++size_;
 
                 return back();
             }
 
             void push_back(const T& x)
             {
-                if (size_ >= capacity_)
-                    resize_with_copy_(size_, next_capacity_());
-                data_[size_++] = x;
+                emplace_back(x);
             }
 
             void push_back(T&& x)
             {
-                if (size_ >= capacity_)
-                    resize_with_copy_(size_, next_capacity_());
-                data_[size_++] = forward<T>(x);
+                emplace_back(forward<T>(x));
             }
 
             void pop_back()
@@ -407,39 +429,32 @@ namespace std
                 auto pos = const_cast<iterator>(position);
 
                 pos = shift_(pos, 1);
-                allocator_.construct(pos, forward<Args>(args)...);
+                allocator_traits<Allocator>::construct(allocator_, pos, forward<Args>(args)...);
 
                 return pos;
             }
 
             iterator insert(const_iterator position, const value_type& x)
             {
-                auto pos = const_cast<iterator>(position);
-
-                pos = shift_(pos, 1);
-                *pos = x;
+                // x may refer to an element that shift_ moves.
+                value_type tmp{x};
 
-                return pos;
+                return emplace(position, move(tmp));
             }
 
             iterator insert(const_iterator position, value_type&& x)
             {
-                auto pos = const_cast<iterator>(position);
-
-                pos = shift_(pos, 1);
-                *pos = forward<value_type>(x);
-
-                return pos;
+                return emplace(position, forward<value_type>(x));
             }
 
             iterator insert(const_iterator position, size_type count, const value_type& x)
             {
                 auto pos = const_cast<iterator>(position);
+                value_type tmp{x};
 
                 pos = shift_(pos, count);
-                auto copy_target = pos;
                 for (size_type i = 0; i < count; ++i)
-                    *copy_target++ = x;
+                    allocator_traits<Allocator>::construct(allocator_, pos + i, tmp);
 
                 return pos;
             }
@@ -452,7 +467,8 @@ namespace std
                 auto count = static_cast<size_type>(last - first);
 
                 pos = shift_(pos, count);
-                copy(first, last, pos);
+                for (auto target = pos; first != last; ++first, ++target)
+                    allocator_traits<Allocator>::construct(allocator_, target, *first);
 
                 return pos;
             }
@@ -462,25 +478,27 @@ namespace std
                 auto pos = const_cast<iterator>(position);
 
                 pos = shift_(pos, init.size());
-                copy(init.begin(), init.end(), pos);
+                auto target = pos;
+                for (const auto& x: init)
+                    allocator_traits<Allocator>::construct(allocator_, target++, x);
 
                 return pos;
             }
 
             iterator erase(const_iterator position)
             {
-                iterator pos = const_cast<iterator>(position);
-                copy(position + 1, cend(), pos);
-                --size_;
-
-                return pos;
+                return erase(position, position + 1);
             }
 
             iterator erase(const_iterator first, const_iterator last)
             {
                 iterator pos = const_cast<iterator>(first);
-                copy(last, cend(), pos);
-                size_ -= static_cast<size_type>(last - first);
+                if (first == last)
+                    return pos;
+
+                auto new_end = std::move(const_cast<iterator>(last), end(), pos);
+                destroy_from_end_until_(new_end);
+                size_ = static_cast<size_type>(new_end - begin());
 
                 return pos;
             }
@@ -507,16 +525,6 @@ namespace std
             size_type capacity_;
             allocator_type allocator_;
 
-            void resize_without_copy_(size_type capacity)
-            {
-                if (data_)
-                    allocator_.deallocate(data_, capacity_);
-
-                data_ = allocator_.allocate(capacity);
-                size_ = 0;
-                capacity_ = capacity;
-            }
-
             void resize_with_copy_(size_type size, size_type capacity)
             {
                 if (size < size_)
@@ -526,16 +534,26 @@ namespace std
                 {
                     auto new_data = allocator_.allocate(capacity);
 
+                    /**
+                     * The new storage is raw memory, so the elements
+                     * have to be constructed in it (not assigned)
+                     * and the old ones destroyed.
+                     */
                     auto to_copy = min(size, size_);
                     for (size_type i = 0; i < to_copy; ++i)
-                        new_data[i] = move(data_[i]);
+                    {
+                        allocator_traits<Allocator>::construct(
+                            allocator_, new_data + i, move(data_[i])
+                        );
+                        allocator_traits<Allocator>::destroy(allocator_, data_ + i);
+                    }
 
                     std::swap(data_, new_data);
 
                     allocator_.deallocate(new_data, capacity_);
+                    capacity_ = capacity;
                 }
 
-                capacity_ = capacity;
                 size_ = size;
             }
 
@@ -557,33 +575,52 @@ namespace std
                     return max(capacity_ * 2, size_type{2u});
             }
 
+            /**
+             * Opens a gap of count raw (unconstructed) slots at position
+             * and returns the (possibly reallocated) start of the gap.
+             * The caller has to construct elements in the gap.
+             */
             iterator shift_(iterator position, size_type count)
             {
-                if (size_ + count < capacity_)
+                auto start_idx = static_cast<size_type>(position - begin());
+
+                if (size_ + count <= capacity_)
                 {
-                    copy_backward(position, end(), end() + count);
+                    /**
+                     * Going from the back, the target slot of each
+                     * element is either past the old end or has already
+                     * been moved out of and destroyed.
+                     */
+                    for (auto i = size_; i > start_idx; --i)
+                    {
+                        allocator_traits<Allocator>::construct(
+                            allocator_, data_ + i - 1 + count, move(data_[i - 1])
+                        );
+                        allocator_traits<Allocator>::destroy(allocator_, data_ + i - 1);
+                    }
                     size_ += count;
 
                     return position;
                 }
                 else
                 {
-                    auto start_idx = static_cast<size_type>(position - begin());
-                    auto end_idx = start_idx + count;
-                    auto new_size = size_ + count;
-
-                    // Auxiliary vector for easier swap.
-                    vector tmp{};
-                    tmp.resize_without_copy_(max(new_size, capacity_));
-                    tmp.size_ = new_size;
-
-                    // Copy before insertion index.
-                    copy(begin(), begin() + start_idx, tmp.begin());
-
-                    // Copy after insertion index.
-                    copy(begin() + start_idx, end(), tmp.begin() + end_idx);
-
-                    swap(tmp);
+                    auto new_capacity = next_capacity_(size_ + count);
+                    auto new_data = allocator_.allocate(new_capacity);
+
+                    for (size_type i = 0; i < size_; ++i)
+                    {
+                        auto target = i < start_idx ? i : i + count;
+                        allocator_traits<Allocator>::construct(
+                            allocator_, new_data + target, move(data_[i])
+                        );
+                        allocator_traits<Allocator>::destroy(allocator_, data_ + i);
+                    }
+
+                    if (data_)
+                        allocator_.deallocate(data_, capacity_);
+                    data_ = new_data;
+                    capacity_ = new_capacity;
+                    size_ += count;
 
                     // Position was invalidated!
                     return begin() + start_idx;
@@ -30,6 +30,7 @@
 #define LIBCPP_BITS_ALGORITHM
 
 #include <iterator>
+#include <new>
 #include <utility>
 
 namespace std
@@ -653,7 +654,39 @@ namespace std
      * 25.3.11, rotate:
      */
 
-    // TODO: implement
+    template<class ForwardIterator>
+    ForwardIterator rotate(ForwardIterator first, ForwardIterator middle,
+                           ForwardIterator last)
+    {
+        if (first == middle)
+            return last;
+        if (middle == last)
+            return first;
+
+        /**
+         * Swap the second range into place and then
+         * rotate what's left of the first range.
+         */
+        auto write = first;
+        auto next = first;
+        for (auto read = middle; read != last; ++write, ++read)
+        {
+            if (write == next)
+                next = read;
+            iter_swap(write, read);
+        }
+
+        rotate(write, next, last);
+
+        return write;
+    }
+
+    template<class ForwardIterator, class OutputIterator>
+    OutputIterator rotate_copy(ForwardIterator first, ForwardIterator middle,
+                               ForwardIterator last, OutputIterator result)
+    {
+        return copy(first, middle, copy(middle, last, result));
+    }
 
     /**
      * 25.3.12, shuffle:
@@ -687,6 +720,311 @@ namespace std
     void sort_heap(RandomAccessIterator, RandomAccessIterator,
                    Compare);
 
+    template<class RandomAccessIterator, class Compare>
+    void partial_sort(RandomAccessIterator, RandomAccessIterator,
+                      RandomAccessIterator, Compare);
+
+    template<class ForwardIterator, class T, class Compare>
+    ForwardIterator lower_bound(ForwardIterator, ForwardIterator,
+                                const T&, Compare);
+
+    template<class ForwardIterator, class T, class Compare>
+    ForwardIterator upper_bound(ForwardIterator, ForwardIterator,
+                                const T&, Compare);
+
+    namespace aux
+    {
+        template<class RandomAccessIterator, class Size, class Compare>
+        void correct_children(RandomAccessIterator, Size, Size, Compare);
+
+        /**
+         * Ranges of this size or smaller are sorted by
+         * insertion sort, which beats the partitioning
+         * and merging approaches on short runs.
+         */
+        inline constexpr ptrdiff_t sort_threshold{16};
+
+        template<class Size>
+        Size sort_depth_limit(Size count)
+        {
+            Size res{};
+            while (count > 1)
+            {
+                count /= 2;
+                ++res;
+            }
+
+            return 2 * res;
+        }
+
+        template<class RandomAccessIterator, class Compare>
+        void insertion_sort(RandomAccessIterator first,
+                            RandomAccessIterator last,
+                            Compare comp)
+        {
+            if (first == last)
+                return;
+
+            for (auto it = first + 1; it != last; ++it)
+            {
+                auto tmp = std::move(*it);
+                auto hole = it;
+
+                /**
+                 * Note: The check against first is kept in the
+                 *       loop so that this is also safe to use on
+                 *       ranges without a sentinel.
+                 */
+                while (hole != first && comp(tmp, *(hole - 1)))
+                {
+                    *hole = std::move(*(hole - 1));
+                    --hole;
+                }
+
+                *hole = std::move(tmp);
+            }
+        }
+
+        /**
+         * Moves the median of *a, *b and *c to result.
+         */
+        template<class RandomAccessIterator, class Compare>
+        void move_median_to_first(RandomAccessIterator result,
+                                  RandomAccessIterator a,
+                                  RandomAccessIterator b,
+                                  RandomAccessIterator c,
+                                  Compare comp)
+        {
+            if (comp(*a, *b))
+            {
+                if (comp(*b, *c))
+                    iter_swap(result, b);
+                else if (comp(*a, *c))
+                    iter_swap(result, c);
+                else
+                    iter_swap(result, a);
+            }
+            else if (comp(*a, *c))
+                iter_swap(result, a);
+            else if (comp(*b, *c))
+                iter_swap(result, c);
+            else
+                iter_swap(result, b);
+        }
+
+        /**
+         * Partitions [first, last) around *pivot and returns
+         * the start of the second partition. The range must
+         * contain elements that stop both scans, which the
+         * median of three guarantees.
+         */
+        template<class RandomAccessIterator, class Compare>
+        RandomAccessIterator unguarded_partition(RandomAccessIterator first,
+                                                 RandomAccessIterator last,
+                                                 RandomAccessIterator pivot,
+                                                 Compare comp)
+        {
+            while (true)
+            {
+                while (comp(*first, *pivot))
+                    ++first;
+
+                --last;
+                while (comp(*pivot, *last))
+                    --last;
+
+                if (!(first < last))
+                    return first;
+
+                iter_swap(first, last);
+                ++first;
+            }
+        }
+
+        template<class RandomAccessIterator, class Compare>
+        RandomAccessIterator partition_pivot(RandomAccessIterator first,
+                                             RandomAccessIterator last,
+                                             Compare comp)
+        {
+            auto mid = first + (last - first) / 2;
+            move_median_to_first(first, first + 1, mid, last - 1, comp);
+
+            return unguarded_partition(first + 1, last, first, comp);
+        }
+
+        template<class RandomAccessIterator, class Size, class Compare>
+        void introsort_loop(RandomAccessIterator first,
+                            RandomAccessIterator last,
+                            Size depth_limit, Compare comp)
+        {
+            while (last - first > sort_threshold)
+            {
+                if (depth_limit == 0)
+                {
+                    /**
+                     * Too many bad pivots, switch to heap sort
+                     * to keep the worst case at O(n log n).
+                     */
+                    partial_sort(first, last, last, comp);
+
+                    return;
+                }
+                --depth_limit;
+
+                /**
+                 * Recurse into the right part and loop on
+                 * the left one.
+                 */
+                auto cut = partition_pivot(first, last, comp);
+                introsort_loop(cut, last, depth_limit, comp);
+                last = cut;
+            }
+        }
+
+        template<class RandomAccessIterator, class Compare>
+        void heap_select(RandomAccessIterator first,
+                         RandomAccessIterator middle,
+                         RandomAccessIterator last,
+                         Compare comp)
+        {
+            make_heap(first, middle, comp);
+
+            auto count = middle - first;
+            for (auto it = middle; it < last; ++it)
+            {
+                if (comp(*it, *first))
+                {
+                    swap(*it, *first);
+                    correct_children(first, decltype(count){}, count, comp);
+                }
+            }
+        }
+
+        /**
+         * Moves the left run to the buffer and merges it
+         * back with the right run. Ties are resolved in
+         * favour of the left run to keep the sort stable.
+         */
+        template<class RandomAccessIterator, class Pointer, class Compare>
+        void merge_with_buffer(RandomAccessIterator first,
+                               RandomAccessIterator middle,
+                               RandomAccessIterator last,
+                               Pointer buffer, Compare comp)
+        {
+            using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+            // Already in order, typical for presorted input.
+            if (!comp(*middle, *(middle - 1)))
+                return;
+
+            auto buffer_end = buffer;
+            for (auto it = first; it != middle; ++it, ++buffer_end)
+                ::new(static_cast<void*>(buffer_end)) value_type(std::move(*it));
+
+            auto left = buffer;
+            auto right = middle;
+            auto res = first;
+            while (left != buffer_end && right != last)
+            {
+                if (comp(*right, *left))
+                    *res++ = std::move(*right++);
+                else
+                    *res++ = std::move(*left++);
+            }
+
+            while (left != buffer_end)
+                *res++ = std::move(*left++);
+
+            for (auto it = buffer; it != buffer_end; ++it)
+                it->~value_type();
+        }
+
+        template<class RandomAccessIterator, class Pointer, class Compare>
+        void merge_sort_with_buffer(RandomAccessIterator first,
+                                    RandomAccessIterator last,
+                                    Pointer buffer, Compare comp)
+        {
+            if (last - first <= sort_threshold)
+            {
+                insertion_sort(first, last, comp);
+
+                return;
+            }
+
+            auto middle = first + (last - first) / 2;
+            merge_sort_with_buffer(first, middle, buffer, comp);
+            merge_sort_with_buffer(middle, last, buffer, comp);
+            merge_with_buffer(first, middle, last, buffer, comp);
+        }
+
+        /**
+         * Fallback for when we cannot get a buffer, merges
+         * the runs in place by rotations in O(n log n).
+         */
+        template<class RandomAccessIterator, class Size, class Compare>
+        void merge_without_buffer(RandomAccessIterator first,
+                                  RandomAccessIterator middle,
+                                  RandomAccessIterator last,
+                                  Size len1, Size len2, Compare comp)
+        {
+            if (len1 == 0 || len2 == 0)
+                return;
+
+            if (len1 + len2 == 2)
+            {
+                if (comp(*middle, *first))
+                    iter_swap(first, middle);
+
+                return;
+            }
+
+            RandomAccessIterator first_cut{first};
+            RandomAccessIterator second_cut{middle};
+            Size len11{};
+            Size len22{};
+
+            if (len1 > len2)
+            {
+                len11 = len1 / 2;
+                first_cut += len11;
+                second_cut = lower_bound(middle, last, *first_cut, comp);
+                len22 = second_cut - middle;
+            }
+            else
+            {
+                len22 = len2 / 2;
+                second_cut += len22;
+                first_cut = upper_bound(first, middle, *second_cut, comp);
+                len11 = first_cut - first;
+            }
+
+            auto new_middle = rotate(first_cut, middle, second_cut);
+            merge_without_buffer(first, first_cut, new_middle,
+                                 len11, len22, comp);
+            merge_without_buffer(new_middle, second_cut, last,
+                                 len1 - len11, len2 - len22, comp);
+        }
+
+        template<class RandomAccessIterator, class Compare>
+        void merge_sort_without_buffer(RandomAccessIterator first,
+                                       RandomAccessIterator last,
+                                       Compare comp)
+        {
+            if (last - first <= sort_threshold)
+            {
+                insertion_sort(first, last, comp);
+
+                return;
+            }
+
+            auto middle = first + (last - first) / 2;
+            merge_sort_without_buffer(first, middle, comp);
+            merge_sort_without_buffer(middle, last, comp);
+            merge_without_buffer(first, middle, last,
+                                 middle - first, last - middle, comp);
+        }
+    }
+
     template<class RandomAccessIterator>
     void sort(RandomAccessIterator first, RandomAccessIterator last)
     {
@@ -700,63 +1038,157 @@ namespace std
               Compare comp)
     {
         /**
-         * Note: This isn't the most effective approach,
-         *       but since we already have these two functions
-         *       and they satisfy asymptotic limitations
-         *       imposed by the standard, we're using them at
-         *       the moment. Might be good to change it to qsort
-         *       or merge sort later.
+         * Introsort: quicksort with median of three pivots
+         * that falls back to heap sort when the recursion
+         * gets too deep, with short partitions left for
+         * a final insertion sort pass.
          */
+        if (last - first < 2)
+            return;
 
-        make_heap(first, last, comp);
-        sort_heap(first, last, comp);
+        aux::introsort_loop(
+            first, last,
+            aux::sort_depth_limit(last - first), comp
+        );
+        aux::insertion_sort(first, last, comp);
     }
 
     /**
      * 25.4.1.2, stable_sort:
      */
 
-    // TODO: implement
+    template<class RandomAccessIterator>
+    void stable_sort(RandomAccessIterator first, RandomAccessIterator last)
+    {
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+        stable_sort(first, last, less<value_type>{});
+    }
+
+    template<class RandomAccessIterator, class Compare>
+    void stable_sort(RandomAccessIterator first, RandomAccessIterator last,
+                     Compare comp)
+    {
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+        auto count = last - first;
+        if (count < 2)
+            return;
+
+        /**
+         * Merging needs room only for the left run,
+         * which is at most half of the range.
+         */
+        auto size = static_cast<size_t>(count / 2) * sizeof(value_type);
+        auto buffer = static_cast<value_type*>(::operator new(size, nothrow));
+
+        if (buffer)
+        {
+            aux::merge_sort_with_buffer(first, last, buffer, comp);
+            ::operator delete(buffer);
+        }
+        else
+            aux::merge_sort_without_buffer(first, last, comp);
+    }
 
     /**
      * 25.4.1.3, partial_sort:
      */
 
-    // TODO: implement
+    template<class RandomAccessIterator>
+    void partial_sort(RandomAccessIterator first,
+                      RandomAccessIterator middle,
+                      RandomAccessIterator last)
+    {
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
 
-    /**
-     * 25.4.1.4, partial_sort_copy:
-     */
+        partial_sort(first, middle, last, less<value_type>{});
+    }
 
-    // TODO: implement
+    template<class RandomAccessIterator, class Compare>
+    void partial_sort(RandomAccessIterator first,
+                      RandomAccessIterator middle,
+                      RandomAccessIterator last,
+                      Compare comp)
+    {
+        if (first == middle)
+            return;
+
+        aux::heap_select(first, middle, last, comp);
+        sort_heap(first, middle, comp);
+    }
 
     /**
-     * 25.4.1.5, is_sorted:
+     * 25.4.1.4, partial_sort_copy:
      */
 
-    template<class ForwardIterator>
-    bool is_sorted(ForwardIterator first, ForwardIterator last)
+    template<class InputIterator, class RandomAccessIterator>
+    RandomAccessIterator partial_sort_copy(InputIterator first,
+                                           InputIterator last,
+                                           RandomAccessIterator result_first,
+                                           RandomAccessIterator result_last)
     {
-        return is_sorted_until(first, last) == last;
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+        return partial_sort_copy(
+            first, last, result_first, result_last,
+            less<value_type>{}
+        );
     }
 
-    template<class ForwardIterator, class Comp>
-    bool is_sorted(ForwardIterator first, ForwardIterator last,
-                   Comp comp)
+    template<class InputIterator, class RandomAccessIterator, class Compare>
+    RandomAccessIterator partial_sort_copy(InputIterator first,
+                                           InputIterator last,
+                                           RandomAccessIterator result_first,
+                                           RandomAccessIterator result_last,
+                                           Compare comp)
     {
-        return is_sorted_until(first, last, comp) == last;
+        if (result_first == result_last)
+            return result_last;
+
+        auto result_real_last = result_first;
+        while (first != last && result_real_last != result_last)
+            *result_real_last++ = *first++;
+
+        /**
+         * Keep the smallest elements seen so far in a max heap
+         * and replace its top whenever we find a smaller one.
+         */
+        make_heap(result_first, result_real_last, comp);
+
+        auto count = result_real_last - result_first;
+        for (; first != last; ++first)
+        {
+            if (comp(*first, *result_first))
+            {
+                *result_first = *first;
+                aux::correct_children(
+                    result_first, decltype(count){}, count, comp
+                );
+            }
+        }
+
+        sort_heap(result_first, result_real_last, comp);
+
+        return result_real_last;
     }
 
+    /**
+     * 25.4.1.5, is_sorted:
+     */
+
     template<class ForwardIterator>
     ForwardIterator is_sorted_until(ForwardIterator first, ForwardIterator last)
     {
-        if (distance(first, last) < 2)
+        if (first == last)
             return last;
 
-        while (first != last)
+        auto next = first;
+        while (++next != last)
         {
-            if (*first > *(++first))
-                return first;
+            if (*next < *first)
+                return next;
+            first = next;
         }
 
         return last;
@@ -766,23 +1198,79 @@ namespace std
     ForwardIterator is_sorted_until(ForwardIterator first, ForwardIterator last,
                                     Comp comp)
     {
-        if (distance(first, last) < 2)
+        if (first == last)
             return last;
 
-        while (first != last)
+        auto next = first;
+        while (++next != last)
         {
-            if (!comp(*first, *(++first)))
-                return first;
+            if (comp(*next, *first))
+                return next;
+            first = next;
         }
 
         return last;
     }
 
+    template<class ForwardIterator>
+    bool is_sorted(ForwardIterator first, ForwardIterator last)
+    {
+        return is_sorted_until(first, last) == last;
+    }
+
+    template<class ForwardIterator, class Comp>
+    bool is_sorted(ForwardIterator first, ForwardIterator last,
+                   Comp comp)
+    {
+        return is_sorted_until(first, last, comp) == last;
+    }
+
     /**
      * 25.4.2, nth_element:
      */
 
-    // TODO: implement
+    template<class RandomAccessIterator>
+    void nth_element(RandomAccessIterator first, RandomAccessIterator nth,
+                     RandomAccessIterator last)
+    {
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+        nth_element(first, nth, last, less<value_type>{});
+    }
+
+    template<class RandomAccessIterator, class Compare>
+    void nth_element(RandomAccessIterator first, RandomAccessIterator nth,
+                     RandomAccessIterator last, Compare comp)
+    {
+        if (first == last || nth == last)
+            return;
+
+        /**
+         * Introselect: partition only the side that contains
+         * nth and fall back to heap selection when the pivots
+         * keep being bad.
+         */
+        auto depth_limit = aux::sort_depth_limit(last - first);
+        while (last - first > 3)
+        {
+            if (depth_limit == 0)
+            {
+                aux::heap_select(first, nth + 1, last, comp);
+                iter_swap(first, nth);
+
+                return;
+            }
+            --depth_limit;
+
+            auto cut = aux::partition_pivot(first, last, comp);
+            if (cut <= nth)
+                first = cut;
+            else
+                last = cut;
+        }
+
+        aux::insertion_sort(first, last, comp);
+    }
 
     /**
      * 25.4.3, binary search:
@@ -792,13 +1280,79 @@ namespace std
      * 25.4.3.1, lower_bound
      */
 
-    // TODO: implement
+    template<class ForwardIterator, class T>
+    ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last,
+                                const T& value)
+    {
+        return lower_bound(
+            first, last, value,
+            [](const auto& lhs, const auto& rhs){
+                return lhs < rhs;
+            }
+        );
+    }
+
+    template<class ForwardIterator, class T, class Compare>
+    ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last,
+                                const T& value, Compare comp)
+    {
+        auto count = distance(first, last);
+        while (count > 0)
+        {
+            auto step = count / 2;
+            auto it = first;
+            advance(it, step);
+
+            if (comp(*it, value))
+            {
+                first = ++it;
+                count -= step + 1;
+            }
+            else
+                count = step;
+        }
+
+        return first;
+    }
 
     /**
      * 25.4.3.2, upper_bound
      */
 
-    // TODO: implement
+    template<class ForwardIterator, class T>
+    ForwardIterator upper_bound(ForwardIterator first, ForwardIterator last,
+                                const T& value)
+    {
+        return upper_bound(
+            first, last, value,
+            [](const auto& lhs, const auto& rhs){
+                return lhs < rhs;
+            }
+        );
+    }
+
+    template<class ForwardIterator, class T, class Compare>
+    ForwardIterator upper_bound(ForwardIterator first, ForwardIterator last,
+                                const T& value, Compare comp)
+    {
+        auto count = distance(first, last);
+        while (count > 0)
+        {
+            auto step = count / 2;
+            auto it = first;
+            advance(it, step);
+
+            if (!comp(value, *it))
+            {
+                first = ++it;
+                count -= step + 1;
+            }
+            else
+                count = step;
+        }
+
+        return first;
+    }
 
     /**
      * 25.4.3.3, equal_range:
@@ -883,32 +1437,26 @@ namespace std
             using aux::heap_left_child;
             using aux::heap_right_child;
 
-            auto left = heap_left_child(idx);
-            auto right = heap_right_child(idx);
-
-            bool left_incorrect{comp(first[idx], first[left])};
-            bool right_incorrect{comp(first[idx], first[right])};
-            while ((left < count && left_incorrect) ||
-                   (right < count && right_incorrect))
+            /**
+             * Sift the element down, always swapping it with
+             * the bigger of its children.
+             */
+            while (true)
             {
-                if (right >= count || (left_incorrect && comp(first[right], first[left])))
-                {
-                    swap(first[idx], first[left]);
-
-                    idx = left;
-                }
-                else if (right < count && right_incorrect)
-                {
-                    swap(first[idx], first[right]);
+                auto left = heap_left_child(idx);
+                if (left >= count)
+                    return;
 
-                    idx = right;
-                } // Else should not happen because of the while condition.
+                auto right = heap_right_child(idx);
+                auto child = left;
+                if (right < count && comp(first[left], first[right]))
+                    child = right;
 
-                left = heap_left_child(idx);
-                right = heap_right_child(idx);
+                if (!comp(first[idx], first[child]))
+                    return;
 
-                left_incorrect = comp(first[idx], first[left]);
-                right_incorrect = comp(first[idx], first[right]);
+                swap(first[idx], first[child]);
+                idx = child;
             }
         }
     }
@@ -971,7 +1519,7 @@ namespace std
             return;
 
         swap(first[0], first[count - 1]);
-        aux::correct_children(first, decltype(count){}, count - 2, comp);
+        aux::correct_children(first, decltype(count){}, count - 1, comp);
     }
 
     /**
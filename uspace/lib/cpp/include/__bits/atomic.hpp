@@ -29,6 +29,986 @@
 #ifndef LIBCPP_BITS_ATOMIC
 #define LIBCPP_BITS_ATOMIC
 
-#error "<atomic> is not implemented"
+#include <__bits/type_traits/type_traits.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace std
+{
+    /**
+     * 29.3, order and consistency:
+     */
+
+    enum memory_order
+    {
+        memory_order_relaxed = __ATOMIC_RELAXED,
+        memory_order_consume = __ATOMIC_CONSUME,
+        memory_order_acquire = __ATOMIC_ACQUIRE,
+        memory_order_release = __ATOMIC_RELEASE,
+        memory_order_acq_rel = __ATOMIC_ACQ_REL,
+        memory_order_seq_cst = __ATOMIC_SEQ_CST
+    };
+
+    template<class T>
+    T kill_dependency(T y) noexcept
+    {
+        return y;
+    }
+
+    /**
+     * 29.4, lock-free property:
+     */
+
+#define ATOMIC_BOOL_LOCK_FREE     __GCC_ATOMIC_BOOL_LOCK_FREE
+#define ATOMIC_CHAR_LOCK_FREE     __GCC_ATOMIC_CHAR_LOCK_FREE
+#define ATOMIC_CHAR16_T_LOCK_FREE __GCC_ATOMIC_CHAR16_T_LOCK_FREE
+#define ATOMIC_CHAR32_T_LOCK_FREE __GCC_ATOMIC_CHAR32_T_LOCK_FREE
+#define ATOMIC_WCHAR_T_LOCK_FREE  __GCC_ATOMIC_WCHAR_T_LOCK_FREE
+#define ATOMIC_SHORT_LOCK_FREE    __GCC_ATOMIC_SHORT_LOCK_FREE
+#define ATOMIC_INT_LOCK_FREE      __GCC_ATOMIC_INT_LOCK_FREE
+#define ATOMIC_LONG_LOCK_FREE     __GCC_ATOMIC_LONG_LOCK_FREE
+#define ATOMIC_LLONG_LOCK_FREE    __GCC_ATOMIC_LLONG_LOCK_FREE
+#define ATOMIC_POINTER_LOCK_FREE  __GCC_ATOMIC_POINTER_LOCK_FREE
+
+#define ATOMIC_VAR_INIT(value) { value }
+#define ATOMIC_FLAG_INIT { false }
+
+    namespace aux
+    {
+        /**
+         * Waiting and notification (an extension taken
+         * from C++20). Waiters sleep in one of a few
+         * buckets chosen by the address they wait on,
+         * changed() is checked with the bucket locked,
+         * so that a notification cannot get lost.
+         */
+        using atomic_changed_t = bool (*)(const volatile void*, const void*);
+
+        void atomic_wait(const volatile void* addr, atomic_changed_t changed,
+                         const void* old) noexcept;
+        void atomic_notify(const volatile void* addr, bool all) noexcept;
+
+        constexpr int atomic_failure_order(memory_order order) noexcept
+        {
+            if (order == memory_order_acq_rel)
+                return __ATOMIC_ACQUIRE;
+            else if (order == memory_order_release)
+                return __ATOMIC_RELAXED;
+            else
+                return order;
+        }
+
+        /**
+         * Types with a power of two size up to 16 bytes
+         * are aligned to their size, this lets the compiler
+         * use the lock-free instructions for them.
+         */
+        template<class T>
+        constexpr size_t atomic_alignment() noexcept
+        {
+            constexpr auto size = sizeof(T);
+            if ((size & (size - 1)) == 0 && size <= 16 && size > alignof(T))
+                return size;
+            else
+                return alignof(T);
+        }
+
+        /**
+         * Types the compiler cannot handle lock-free would
+         * need libatomic, which we do not have, so these
+         * are guarded by one of a few hashed spinlocks.
+         */
+        void atomic_lock(const volatile void* addr) noexcept;
+        void atomic_unlock(const volatile void* addr) noexcept;
+
+        template<class T>
+        class atomic_base
+        {
+            static_assert(is_trivially_copyable_v<T>, "atomic<T> requires a trivially copyable T");
+
+            public:
+                atomic_base() noexcept = default;
+
+                constexpr atomic_base(T desired) noexcept
+                    : value_{desired}
+                { /* DUMMY BODY */ }
+
+                atomic_base(const atomic_base&) = delete;
+                atomic_base& operator=(const atomic_base&) = delete;
+                atomic_base& operator=(const atomic_base&) volatile = delete;
+
+                static constexpr bool is_always_lock_free =
+                    __atomic_always_lock_free(sizeof(T), 0);
+
+                bool is_lock_free() const volatile noexcept
+                {
+                    return is_always_lock_free;
+                }
+
+                bool is_lock_free() const noexcept
+                {
+                    return is_always_lock_free;
+                }
+
+                void store(T desired, memory_order order = memory_order_seq_cst) volatile noexcept
+                {
+                    store_(&value_, desired, order);
+                }
+
+                void store(T desired, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    store_(&value_, desired, order);
+                }
+
+                T load(memory_order order = memory_order_seq_cst) const volatile noexcept
+                {
+                    return load_(&value_, order);
+                }
+
+                T load(memory_order order = memory_order_seq_cst) const noexcept
+                {
+                    return load_(&value_, order);
+                }
+
+                operator T() const volatile noexcept
+                {
+                    return load();
+                }
+
+                operator T() const noexcept
+                {
+                    return load();
+                }
+
+                T exchange(T desired, memory_order order = memory_order_seq_cst) volatile noexcept
+                {
+                    return exchange_(&value_, desired, order);
+                }
+
+                T exchange(T desired, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    return exchange_(&value_, desired, order);
+                }
+
+                bool compare_exchange_weak(T& expected, T desired, memory_order success,
+                                           memory_order failure) volatile noexcept
+                {
+                    return compare_exchange_(&value_, expected, desired, true, success, failure);
+                }
+
+                bool compare_exchange_weak(T& expected, T desired, memory_order success,
+                                           memory_order failure) noexcept
+                {
+                    return compare_exchange_(&value_, expected, desired, true, success, failure);
+                }
+
+                bool compare_exchange_strong(T& expected, T desired, memory_order success,
+                                             memory_order failure) volatile noexcept
+                {
+                    return compare_exchange_(&value_, expected, desired, false, success, failure);
+                }
+
+                bool compare_exchange_strong(T& expected, T desired, memory_order success,
+                                             memory_order failure) noexcept
+                {
+                    return compare_exchange_(&value_, expected, desired, false, success, failure);
+                }
+
+                bool compare_exchange_weak(T& expected, T desired,
+                                           memory_order order = memory_order_seq_cst) volatile noexcept
+                {
+                    return compare_exchange_(&value_, expected, desired, true,
+                                             order, atomic_failure_order(order));
+                }
+
+                bool compare_exchange_weak(T& expected, T desired,
+                                           memory_order order = memory_order_seq_cst) noexcept
+                {
+                    return compare_exchange_(&value_, expected, desired, true,
+                                             order, atomic_failure_order(order));
+                }
+
+                bool compare_exchange_strong(T& expected, T desired,
+                                             memory_order order = memory_order_seq_cst) volatile noexcept
+                {
+                    return compare_exchange_(&value_, expected, desired, false,
+                                             order, atomic_failure_order(order));
+                }
+
+                bool compare_exchange_strong(T& expected, T desired,
+                                             memory_order order = memory_order_seq_cst) noexcept
+                {
+                    return compare_exchange_(&value_, expected, desired, false,
+                                             order, atomic_failure_order(order));
+                }
+
+                /**
+                 * Extension: Blocks until the value stops being
+                 * equal to old and a notification arrives.
+                 */
+                void wait(T old, memory_order order = memory_order_seq_cst) const noexcept
+                {
+                    /**
+                     * Short changes are common, so spin for a
+                     * while before going to sleep.
+                     */
+                    for (int i = 0; i < spin_count_; ++i)
+                    {
+                        if (!equal_(load(order), old))
+                            return;
+                    }
+
+                    aux::atomic_wait(&value_, &changed_, &old);
+                }
+
+                void notify_one() noexcept
+                {
+                    aux::atomic_notify(&value_, false);
+                }
+
+                void notify_all() noexcept
+                {
+                    aux::atomic_notify(&value_, true);
+                }
+
+            protected:
+                alignas(atomic_alignment<T>()) T value_;
+
+            private:
+                static constexpr int spin_count_{64};
+
+                static T* raw_(const volatile T* ptr) noexcept
+                {
+                    return const_cast<T*>(ptr);
+                }
+
+                static void store_(volatile T* ptr, T desired, int order) noexcept
+                {
+                    if constexpr (is_always_lock_free)
+                        __atomic_store(ptr, &desired, order);
+                    else
+                    {
+                        aux::atomic_lock(ptr);
+                        __builtin_memcpy(raw_(ptr), &desired, sizeof(T));
+                        aux::atomic_unlock(ptr);
+                    }
+                }
+
+                static T load_(const volatile T* ptr, int order) noexcept
+                {
+                    T res;
+                    if constexpr (is_always_lock_free)
+                        __atomic_load(ptr, &res, order);
+                    else
+                    {
+                        aux::atomic_lock(ptr);
+                        __builtin_memcpy(&res, raw_(ptr), sizeof(T));
+                        aux::atomic_unlock(ptr);
+                    }
+
+                    return res;
+                }
+
+                static T exchange_(volatile T* ptr, T desired, int order) noexcept
+                {
+                    T res;
+                    if constexpr (is_always_lock_free)
+                        __atomic_exchange(ptr, &desired, &res, order);
+                    else
+                    {
+                        aux::atomic_lock(ptr);
+                        __builtin_memcpy(&res, raw_(ptr), sizeof(T));
+                        __builtin_memcpy(raw_(ptr), &desired, sizeof(T));
+                        aux::atomic_unlock(ptr);
+                    }
+
+                    return res;
+                }
+
+                static bool compare_exchange_(volatile T* ptr, T& expected, T desired,
+                                              bool weak, int success, int failure) noexcept
+                {
+                    if constexpr (is_always_lock_free)
+                    {
+                        return __atomic_compare_exchange(ptr, &expected, &desired,
+                                                         weak, success, failure);
+                    }
+                    else
+                    {
+                        aux::atomic_lock(ptr);
+                        bool res = equal_(*raw_(ptr), expected);
+                        if (res)
+                            __builtin_memcpy(raw_(ptr), &desired, sizeof(T));
+                        else
+                            __builtin_memcpy(&expected, raw_(ptr), sizeof(T));
+                        aux::atomic_unlock(ptr);
+
+                        return res;
+                    }
+                }
+
+                static bool equal_(const T& lhs, const T& rhs) noexcept
+                {
+                    return __builtin_memcmp(&lhs, &rhs, sizeof(T)) == 0;
+                }
+
+                static bool changed_(const volatile void* addr, const void* old) noexcept
+                {
+                    auto curr = load_(static_cast<const volatile T*>(addr), __ATOMIC_SEQ_CST);
+
+                    return !equal_(curr, *static_cast<const T*>(old));
+                }
+        };
+
+        template<class T>
+        class atomic_integral: public atomic_base<T>
+        {
+            public:
+                using atomic_base<T>::atomic_base;
+
+                T fetch_add(T arg, memory_order order = memory_order_seq_cst) volatile noexcept
+                {
+                    return __atomic_fetch_add(&this->value_, arg, order);
+                }
+
+                T fetch_add(T arg, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    return __atomic_fetch_add(&this->value_, arg, order);
+                }
+
+                T fetch_sub(T arg, memory_order order = memory_order_seq_cst) volatile noexcept
+                {
+                    return __atomic_fetch_sub(&this->value_, arg, order);
+                }
+
+                T fetch_sub(T arg, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    return __atomic_fetch_sub(&this->value_, arg, order);
+                }
+
+                T fetch_and(T arg, memory_order order = memory_order_seq_cst) volatile noexcept
+                {
+                    return __atomic_fetch_and(&this->value_, arg, order);
+                }
+
+                T fetch_and(T arg, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    return __atomic_fetch_and(&this->value_, arg, order);
+                }
+
+                T fetch_or(T arg, memory_order order = memory_order_seq_cst) volatile noexcept
+                {
+                    return __atomic_fetch_or(&this->value_, arg, order);
+                }
+
+                T fetch_or(T arg, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    return __atomic_fetch_or(&this->value_, arg, order);
+                }
+
+                T fetch_xor(T arg, memory_order order = memory_order_seq_cst) volatile noexcept
+                {
+                    return __atomic_fetch_xor(&this->value_, arg, order);
+                }
+
+                T fetch_xor(T arg, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    return __atomic_fetch_xor(&this->value_, arg, order);
+                }
+
+                T operator++(int) volatile noexcept
+                {
+                    return fetch_add(1);
+                }
+
+                T operator++(int) noexcept
+                {
+                    return fetch_add(1);
+                }
+
+                T operator--(int) volatile noexcept
+                {
+                    return fetch_sub(1);
+                }
+
+                T operator--(int) noexcept
+                {
+                    return fetch_sub(1);
+                }
+
+                T operator++() volatile noexcept
+                {
+                    return __atomic_add_fetch(&this->value_, 1, __ATOMIC_SEQ_CST);
+                }
+
+                T operator++() noexcept
+                {
+                    return __atomic_add_fetch(&this->value_, 1, __ATOMIC_SEQ_CST);
+                }
+
+                T operator--() volatile noexcept
+                {
+                    return __atomic_sub_fetch(&this->value_, 1, __ATOMIC_SEQ_CST);
+                }
+
+                T operator--() noexcept
+                {
+                    return __atomic_sub_fetch(&this->value_, 1, __ATOMIC_SEQ_CST);
+                }
+
+                T operator+=(T arg) volatile noexcept
+                {
+                    return __atomic_add_fetch(&this->value_, arg, __ATOMIC_SEQ_CST);
+                }
+
+                T operator+=(T arg) noexcept
+                {
+                    return __atomic_add_fetch(&this->value_, arg, __ATOMIC_SEQ_CST);
+                }
+
+                T operator-=(T arg) volatile noexcept
+                {
+                    return __atomic_sub_fetch(&this->value_, arg, __ATOMIC_SEQ_CST);
+                }
+
+                T operator-=(T arg) noexcept
+                {
+                    return __atomic_sub_fetch(&this->value_, arg, __ATOMIC_SEQ_CST);
+                }
+
+                T operator&=(T arg) volatile noexcept
+                {
+                    return __atomic_and_fetch(&this->value_, arg, __ATOMIC_SEQ_CST);
+                }
+
+                T operator&=(T arg) noexcept
+                {
+                    return __atomic_and_fetch(&this->value_, arg, __ATOMIC_SEQ_CST);
+                }
+
+                T operator|=(T arg) volatile noexcept
+                {
+                    return __atomic_or_fetch(&this->value_, arg, __ATOMIC_SEQ_CST);
+                }
+
+                T operator|=(T arg) noexcept
+                {
+                    return __atomic_or_fetch(&this->value_, arg, __ATOMIC_SEQ_CST);
+                }
+
+                T operator^=(T arg) volatile noexcept
+                {
+                    return __atomic_xor_fetch(&this->value_, arg, __ATOMIC_SEQ_CST);
+                }
+
+                T operator^=(T arg) noexcept
+                {
+                    return __atomic_xor_fetch(&this->value_, arg, __ATOMIC_SEQ_CST);
+                }
+        };
+
+        /**
+         * Note: The builtins do no pointer arithmetic,
+         *       they add the given number of bytes.
+         */
+        template<class T>
+        class atomic_pointer: public atomic_base<T*>
+        {
+            public:
+                using atomic_base<T*>::atomic_base;
+
+                T* fetch_add(ptrdiff_t arg, memory_order order = memory_order_seq_cst) volatile noexcept
+                {
+                    return __atomic_fetch_add(&this->value_, arg * sizeof(T), order);
+                }
+
+                T* fetch_add(ptrdiff_t arg, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    return __atomic_fetch_add(&this->value_, arg * sizeof(T), order);
+                }
+
+                T* fetch_sub(ptrdiff_t arg, memory_order order = memory_order_seq_cst) volatile noexcept
+                {
+                    return __atomic_fetch_sub(&this->value_, arg * sizeof(T), order);
+                }
+
+                T* fetch_sub(ptrdiff_t arg, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    return __atomic_fetch_sub(&this->value_, arg * sizeof(T), order);
+                }
+
+                T* operator++(int) volatile noexcept
+                {
+                    return fetch_add(1);
+                }
+
+                T* operator++(int) noexcept
+                {
+                    return fetch_add(1);
+                }
+
+                T* operator--(int) volatile noexcept
+                {
+                    return fetch_sub(1);
+                }
+
+                T* operator--(int) noexcept
+                {
+                    return fetch_sub(1);
+                }
+
+                T* operator++() volatile noexcept
+                {
+                    return fetch_add(1) + 1;
+                }
+
+                T* operator++() noexcept
+                {
+                    return fetch_add(1) + 1;
+                }
+
+                T* operator--() volatile noexcept
+                {
+                    return fetch_sub(1) - 1;
+                }
+
+                T* operator--() noexcept
+                {
+                    return fetch_sub(1) - 1;
+                }
+
+                T* operator+=(ptrdiff_t arg) volatile noexcept
+                {
+                    return fetch_add(arg) + arg;
+                }
+
+                T* operator+=(ptrdiff_t arg) noexcept
+                {
+                    return fetch_add(arg) + arg;
+                }
+
+                T* operator-=(ptrdiff_t arg) volatile noexcept
+                {
+                    return fetch_sub(arg) - arg;
+                }
+
+                T* operator-=(ptrdiff_t arg) noexcept
+                {
+                    return fetch_sub(arg) - arg;
+                }
+        };
+
+        /**
+         * Keeps the value arguments of the free
+         * functions from taking part in deduction.
+         */
+        template<class T>
+        struct atomic_arg
+        {
+            using type = T;
+        };
+
+        template<class T>
+        using atomic_arg_t = typename atomic_arg<T>::type;
+
+        template<class T>
+        using atomic_select_t = conditional_t<
+            is_integral<T>::value && !is_same_v<remove_cv_t<T>, bool>,
+            atomic_integral<T>, atomic_base<T>
+        >;
+    }
+
+    /**
+     * 29.5, atomic types:
+     */
+
+    template<class T>
+    struct atomic: aux::atomic_select_t<T>
+    {
+        using base_type = aux::atomic_select_t<T>;
+
+        atomic() noexcept = default;
+
+        constexpr atomic(T desired) noexcept
+            : base_type{desired}
+        { /* DUMMY BODY */ }
+
+        atomic(const atomic&) = delete;
+        atomic& operator=(const atomic&) = delete;
+        atomic& operator=(const atomic&) volatile = delete;
+
+        T operator=(T desired) volatile noexcept
+        {
+            this->store(desired);
+
+            return desired;
+        }
+
+        T operator=(T desired) noexcept
+        {
+            this->store(desired);
+
+            return desired;
+        }
+    };
+
+    template<class T>
+    struct atomic<T*>: aux::atomic_pointer<T>
+    {
+        using base_type = aux::atomic_pointer<T>;
+
+        atomic() noexcept = default;
+
+        constexpr atomic(T* desired) noexcept
+            : base_type{desired}
+        { /* DUMMY BODY */ }
+
+        atomic(const atomic&) = delete;
+        atomic& operator=(const atomic&) = delete;
+        atomic& operator=(const atomic&) volatile = delete;
+
+        T* operator=(T* desired) volatile noexcept
+        {
+            this->store(desired);
+
+            return desired;
+        }
+
+        T* operator=(T* desired) noexcept
+        {
+            this->store(desired);
+
+            return desired;
+        }
+    };
+
+    using atomic_bool     = atomic<bool>;
+    using atomic_char     = atomic<char>;
+    using atomic_schar    = atomic<signed char>;
+    using atomic_uchar    = atomic<unsigned char>;
+    using atomic_short    = atomic<short>;
+    using atomic_ushort   = atomic<unsigned short>;
+    using atomic_int      = atomic<int>;
+    using atomic_uint     = atomic<unsigned int>;
+    using atomic_long     = atomic<long>;
+    using atomic_ulong    = atomic<unsigned long>;
+    using atomic_llong    = atomic<long long>;
+    using atomic_ullong   = atomic<unsigned long long>;
+    using atomic_char16_t = atomic<char16_t>;
+    using atomic_char32_t = atomic<char32_t>;
+    using atomic_wchar_t  = atomic<wchar_t>;
+
+    using atomic_int8_t   = atomic<int8_t>;
+    using atomic_uint8_t  = atomic<uint8_t>;
+    using atomic_int16_t  = atomic<int16_t>;
+    using atomic_uint16_t = atomic<uint16_t>;
+    using atomic_int32_t  = atomic<int32_t>;
+    using atomic_uint32_t = atomic<uint32_t>;
+    using atomic_int64_t  = atomic<int64_t>;
+    using atomic_uint64_t = atomic<uint64_t>;
+
+    using atomic_int_least8_t   = atomic<int_least8_t>;
+    using atomic_uint_least8_t  = atomic<uint_least8_t>;
+    using atomic_int_least16_t  = atomic<int_least16_t>;
+    using atomic_uint_least16_t = atomic<uint_least16_t>;
+    using atomic_int_least32_t  = atomic<int_least32_t>;
+    using atomic_uint_least32_t = atomic<uint_least32_t>;
+    using atomic_int_least64_t  = atomic<int_least64_t>;
+    using atomic_uint_least64_t = atomic<uint_least64_t>;
+
+    using atomic_int_fast8_t   = atomic<int_fast8_t>;
+    using atomic_uint_fast8_t  = atomic<uint_fast8_t>;
+    using atomic_int_fast16_t  = atomic<int_fast16_t>;
+    using atomic_uint_fast16_t = atomic<uint_fast16_t>;
+    using atomic_int_fast32_t  = atomic<int_fast32_t>;
+    using atomic_uint_fast32_t = atomic<uint_fast32_t>;
+    using atomic_int_fast64_t  = atomic<int_fast64_t>;
+    using atomic_uint_fast64_t = atomic<uint_fast64_t>;
+
+    using atomic_intptr_t  = atomic<intptr_t>;
+    using atomic_uintptr_t = atomic<uintptr_t>;
+    using atomic_size_t    = atomic<size_t>;
+    using atomic_ptrdiff_t = atomic<ptrdiff_t>;
+    using atomic_intmax_t  = atomic<intmax_t>;
+    using atomic_uintmax_t = atomic<uintmax_t>;
+
+    /**
+     * 29.6, operations on atomic types:
+     */
+
+    template<class T>
+    bool atomic_is_lock_free(const atomic<T>* obj) noexcept
+    {
+        return obj->is_lock_free();
+    }
+
+    template<class T>
+    void atomic_init(atomic<T>* obj, aux::atomic_arg_t<T> desired) noexcept
+    {
+        obj->store(desired, memory_order_relaxed);
+    }
+
+    template<class T>
+    void atomic_store(atomic<T>* obj, aux::atomic_arg_t<T> desired) noexcept
+    {
+        obj->store(desired);
+    }
+
+    template<class T>
+    void atomic_store_explicit(atomic<T>* obj, aux::atomic_arg_t<T> desired,
+                               memory_order order) noexcept
+    {
+        obj->store(desired, order);
+    }
+
+    template<class T>
+    T atomic_load(const atomic<T>* obj) noexcept
+    {
+        return obj->load();
+    }
+
+    template<class T>
+    T atomic_load_explicit(const atomic<T>* obj, memory_order order) noexcept
+    {
+        return obj->load(order);
+    }
+
+    template<class T>
+    T atomic_exchange(atomic<T>* obj, aux::atomic_arg_t<T> desired) noexcept
+    {
+        return obj->exchange(desired);
+    }
+
+    template<class T>
+    T atomic_exchange_explicit(atomic<T>* obj, aux::atomic_arg_t<T> desired,
+                               memory_order order) noexcept
+    {
+        return obj->exchange(desired, order);
+    }
+
+    template<class T>
+    bool atomic_compare_exchange_weak(atomic<T>* obj, aux::atomic_arg_t<T>* expected,
+                                      aux::atomic_arg_t<T> desired) noexcept
+    {
+        return obj->compare_exchange_weak(*expected, desired);
+    }
+
+    template<class T>
+    bool atomic_compare_exchange_strong(atomic<T>* obj, aux::atomic_arg_t<T>* expected,
+                                        aux::atomic_arg_t<T> desired) noexcept
+    {
+        return obj->compare_exchange_strong(*expected, desired);
+    }
+
+    template<class T>
+    bool atomic_compare_exchange_weak_explicit(atomic<T>* obj, aux::atomic_arg_t<T>* expected,
+                                               aux::atomic_arg_t<T> desired,
+                                               memory_order success,
+                                               memory_order failure) noexcept
+    {
+        return obj->compare_exchange_weak(*expected, desired, success, failure);
+    }
+
+    template<class T>
+    bool atomic_compare_exchange_strong_explicit(atomic<T>* obj, aux::atomic_arg_t<T>* expected,
+                                                 aux::atomic_arg_t<T> desired,
+                                                 memory_order success,
+                                                 memory_order failure) noexcept
+    {
+        return obj->compare_exchange_strong(*expected, desired, success, failure);
+    }
+
+    template<class T, class U>
+    T atomic_fetch_add(atomic<T>* obj, U arg) noexcept
+    {
+        return obj->fetch_add(arg);
+    }
+
+    template<class T, class U>
+    T atomic_fetch_add_explicit(atomic<T>* obj, U arg, memory_order order) noexcept
+    {
+        return obj->fetch_add(arg, order);
+    }
+
+    template<class T, class U>
+    T atomic_fetch_sub(atomic<T>* obj, U arg) noexcept
+    {
+        return obj->fetch_sub(arg);
+    }
+
+    template<class T, class U>
+    T atomic_fetch_sub_explicit(atomic<T>* obj, U arg, memory_order order) noexcept
+    {
+        return obj->fetch_sub(arg, order);
+    }
+
+    template<class T>
+    T atomic_fetch_and(atomic<T>* obj, aux::atomic_arg_t<T> arg) noexcept
+    {
+        return obj->fetch_and(arg);
+    }
+
+    template<class T>
+    T atomic_fetch_and_explicit(atomic<T>* obj, aux::atomic_arg_t<T> arg,
+                                memory_order order) noexcept
+    {
+        return obj->fetch_and(arg, order);
+    }
+
+    template<class T>
+    T atomic_fetch_or(atomic<T>* obj, aux::atomic_arg_t<T> arg) noexcept
+    {
+        return obj->fetch_or(arg);
+    }
+
+    template<class T>
+    T atomic_fetch_or_explicit(atomic<T>* obj, aux::atomic_arg_t<T> arg,
+                               memory_order order) noexcept
+    {
+        return obj->fetch_or(arg, order);
+    }
+
+    template<class T>
+    T atomic_fetch_xor(atomic<T>* obj, aux::atomic_arg_t<T> arg) noexcept
+    {
+        return obj->fetch_xor(arg);
+    }
+
+    template<class T>
+    T atomic_fetch_xor_explicit(atomic<T>* obj, aux::atomic_arg_t<T> arg,
+                                memory_order order) noexcept
+    {
+        return obj->fetch_xor(arg, order);
+    }
+
+    template<class T>
+    void atomic_wait(const atomic<T>* obj, aux::atomic_arg_t<T> old) noexcept
+    {
+        obj->wait(old);
+    }
+
+    template<class T>
+    void atomic_notify_one(atomic<T>* obj) noexcept
+    {
+        obj->notify_one();
+    }
+
+    template<class T>
+    void atomic_notify_all(atomic<T>* obj) noexcept
+    {
+        obj->notify_all();
+    }
+
+    /**
+     * 29.7, flag type and operations:
+     */
+
+    struct atomic_flag
+    {
+        atomic_flag() noexcept = default;
+
+        /**
+         * Note: Needed for ATOMIC_FLAG_INIT.
+         */
+        constexpr atomic_flag(bool value) noexcept
+            : value_{value}
+        { /* DUMMY BODY */ }
+
+        atomic_flag(const atomic_flag&) = delete;
+        atomic_flag& operator=(const atomic_flag&) = delete;
+        atomic_flag& operator=(const atomic_flag&) volatile = delete;
+
+        bool test_and_set(memory_order order = memory_order_seq_cst) volatile noexcept
+        {
+            return __atomic_test_and_set(&value_, order);
+        }
+
+        bool test_and_set(memory_order order = memory_order_seq_cst) noexcept
+        {
+            return __atomic_test_and_set(&value_, order);
+        }
+
+        void clear(memory_order order = memory_order_seq_cst) volatile noexcept
+        {
+            __atomic_clear(&value_, order);
+        }
+
+        void clear(memory_order order = memory_order_seq_cst) noexcept
+        {
+            __atomic_clear(&value_, order);
+        }
+
+        /**
+         * Extension: test, wait and notification
+         * as in C++20.
+         */
+        bool test(memory_order order = memory_order_seq_cst) const noexcept
+        {
+            return __atomic_load_n(&value_, order);
+        }
+
+        void wait(bool old, memory_order order = memory_order_seq_cst) const noexcept
+        {
+            if (test(order) != old)
+                return;
+
+            aux::atomic_wait(&value_, &changed_, &old);
+        }
+
+        void notify_one() noexcept
+        {
+            aux::atomic_notify(&value_, false);
+        }
+
+        void notify_all() noexcept
+        {
+            aux::atomic_notify(&value_, true);
+        }
+
+        private:
+            bool value_;
+
+            static bool changed_(const volatile void* addr, const void* old) noexcept
+            {
+                auto curr = __atomic_load_n(static_cast<const volatile bool*>(addr), __ATOMIC_SEQ_CST);
+
+                return curr != *static_cast<const bool*>(old);
+            }
+    };
+
+    inline bool atomic_flag_test_and_set(atomic_flag* obj) noexcept
+    {
+        return obj->test_and_set();
+    }
+
+    inline bool atomic_flag_test_and_set_explicit(atomic_flag* obj, memory_order order) noexcept
+    {
+        return obj->test_and_set(order);
+    }
+
+    inline void atomic_flag_clear(atomic_flag* obj) noexcept
+    {
+        obj->clear();
+    }
+
+    inline void atomic_flag_clear_explicit(atomic_flag* obj, memory_order order) noexcept
+    {
+        obj->clear(order);
+    }
+
+    /**
+     * 29.8, fences:
+     */
+
+    inline void atomic_thread_fence(memory_order order) noexcept
+    {
+        __atomic_thread_fence(order);
+    }
+
+    inline void atomic_signal_fence(memory_order order) noexcept
+    {
+        __atomic_signal_fence(order);
+    }
+}
 
 #endif
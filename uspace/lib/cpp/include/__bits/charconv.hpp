@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_CHARCONV
+#define LIBCPP_BITS_CHARCONV
+
+#include <__bits/limits.hpp>
+#include <__bits/system_error.hpp>
+#include <cstdint>
+#include <type_traits>
+
+namespace std
+{
+    /**
+     * 23.2.1, primitive numeric output conversion (C++17):
+     */
+
+    enum class chars_format
+    {
+        scientific = 0x1,
+        fixed      = 0x2,
+        hex        = 0x4,
+        general    = fixed | scientific
+    };
+
+    struct to_chars_result
+    {
+        char* ptr;
+        errc ec;
+    };
+
+    struct from_chars_result
+    {
+        const char* ptr;
+        errc ec;
+    };
+
+    namespace aux
+    {
+        /**
+         * "00" "01" ... "99", the decimal conversion
+         * produces two digits per division.
+         */
+        extern const char digit_pairs[200];
+
+        inline constexpr char digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+        /**
+         * The integral types are converted using the
+         * narrowest of these that fits them.
+         */
+        template<class T>
+        using chars_uint_t = conditional_t<
+            sizeof(T) <= sizeof(uint32_t), uint32_t, uint64_t
+        >;
+
+        template<class U>
+        int count_dec_digits(U val)
+        {
+            int res{1};
+            while (true)
+            {
+                if (val < 10)
+                    return res;
+                if (val < 100)
+                    return res + 1;
+                if (val < 1000)
+                    return res + 2;
+                if (val < 10000)
+                    return res + 3;
+
+                val /= 10000U;
+                res += 4;
+            }
+        }
+
+        template<class U>
+        int count_digits(U val, int base)
+        {
+            int res{1};
+            while (val >= static_cast<U>(base))
+            {
+                val /= static_cast<U>(base);
+                ++res;
+            }
+
+            return res;
+        }
+
+        /**
+         * Writes the digits of val so that they end at last.
+         */
+        template<class U>
+        void write_dec_digits(char* last, U val)
+        {
+            while (val >= 100)
+            {
+                auto idx = static_cast<unsigned>(val % 100) * 2;
+                val /= 100;
+
+                *--last = digit_pairs[idx + 1];
+                *--last = digit_pairs[idx];
+            }
+
+            if (val >= 10)
+            {
+                auto idx = static_cast<unsigned>(val) * 2;
+
+                *--last = digit_pairs[idx + 1];
+                *--last = digit_pairs[idx];
+            }
+            else
+                *--last = static_cast<char>('0' + val);
+        }
+
+        template<class U>
+        to_chars_result to_chars_unsigned(char* first, char* last, U val, int base)
+        {
+            if (base == 10)
+            {
+                auto len = count_dec_digits(val);
+                if (last - first < len)
+                    return {last, errc::value_too_large};
+
+                write_dec_digits(first + len, val);
+
+                return {first + len, errc{}};
+            }
+
+            auto len = count_digits(val, base);
+            if (last - first < len)
+                return {last, errc::value_too_large};
+
+            auto res = first + len;
+            if ((base & (base - 1)) == 0)
+            {
+                auto shift = __builtin_ctz(static_cast<unsigned>(base));
+                auto mask = static_cast<U>(base - 1);
+                for (auto it = res; it != first; val >>= shift)
+                    *--it = digits[val & mask];
+            }
+            else
+            {
+                for (auto it = res; it != first; val /= static_cast<U>(base))
+                    *--it = digits[val % static_cast<U>(base)];
+            }
+
+            return {res, errc{}};
+        }
+
+        inline int digit_value(char c)
+        {
+            if ('0' <= c && c <= '9')
+                return c - '0';
+            else if ('a' <= c && c <= 'z')
+                return c - 'a' + 10;
+            else if ('A' <= c && c <= 'Z')
+                return c - 'A' + 10;
+            else
+                return 36;
+        }
+
+        /**
+         * Parses digits in [first, last) into val, saturating
+         * at max. Returns the end of the digits and sets
+         * overflow if the value did not fit.
+         */
+        template<class U>
+        const char* from_chars_unsigned(const char* first, const char* last,
+                                        U& val, U max, int base, bool& overflow)
+        {
+            U res{};
+            overflow = false;
+
+            auto it = first;
+            for (; it != last; ++it)
+            {
+                auto d = digit_value(*it);
+                if (d >= base)
+                    break;
+
+                auto ubase = static_cast<U>(base);
+                auto ud = static_cast<U>(d);
+                if (res > (max - ud) / ubase)
+                    overflow = true;
+                else
+                    res = res * ubase + ud;
+            }
+
+            val = res;
+
+            return it;
+        }
+
+        to_chars_result to_chars_float(char* first, char* last, double val,
+                                       bool single, chars_format fmt,
+                                       bool shortest, int precision);
+    }
+
+    template<class Int>
+    enable_if_t<is_integral_v<Int>, to_chars_result>
+    to_chars(char* first, char* last, Int val, int base = 10)
+    {
+        using uint_type = aux::chars_uint_t<Int>;
+
+        auto uval = static_cast<uint_type>(val);
+        if constexpr (is_signed_v<Int>)
+        {
+            if (val < 0)
+            {
+                if (first == last)
+                    return {last, errc::value_too_large};
+
+                *first++ = '-';
+                uval = uint_type{} - uval;
+            }
+        }
+
+        return aux::to_chars_unsigned(first, last, uval, base);
+    }
+
+    to_chars_result to_chars(char* first, char* last, bool val, int base = 10) = delete;
+
+    to_chars_result to_chars(char* first, char* last, float val);
+    to_chars_result to_chars(char* first, char* last, double val);
+    to_chars_result to_chars(char* first, char* last, long double val);
+
+    to_chars_result to_chars(char* first, char* last, float val,
+                             chars_format fmt);
+    to_chars_result to_chars(char* first, char* last, double val,
+                             chars_format fmt);
+    to_chars_result to_chars(char* first, char* last, long double val,
+                             chars_format fmt);
+
+    to_chars_result to_chars(char* first, char* last, float val,
+                             chars_format fmt, int precision);
+    to_chars_result to_chars(char* first, char* last, double val,
+                             chars_format fmt, int precision);
+    to_chars_result to_chars(char* first, char* last, long double val,
+                             chars_format fmt, int precision);
+
+    /**
+     * 23.2.2, primitive numeric input conversion (C++17):
+     */
+
+    template<class Int>
+    enable_if_t<is_integral_v<Int> && !is_same_v<Int, bool>, from_chars_result>
+    from_chars(const char* first, const char* last, Int& val, int base = 10)
+    {
+        using uint_type = aux::chars_uint_t<Int>;
+
+        auto it = first;
+        bool negative{false};
+        if constexpr (is_signed_v<Int>)
+        {
+            if (it != last && *it == '-')
+            {
+                negative = true;
+                ++it;
+            }
+        }
+
+        auto max = static_cast<uint_type>(numeric_limits<Int>::max());
+        if (negative)
+            max += 1;
+
+        uint_type uval{};
+        bool overflow{};
+        auto end = aux::from_chars_unsigned(it, last, uval, max, base, overflow);
+
+        if (end == it)
+            return {first, errc::invalid_argument};
+        else if (overflow)
+            return {end, errc::result_out_of_range};
+
+        if (negative)
+            val = static_cast<Int>(uint_type{} - uval);
+        else
+            val = static_cast<Int>(uval);
+
+        return {end, errc{}};
+    }
+
+    from_chars_result from_chars(const char* first, const char* last, float& val,
+                                 chars_format fmt = chars_format::general);
+    from_chars_result from_chars(const char* first, const char* last, double& val,
+                                 chars_format fmt = chars_format::general);
+    from_chars_result from_chars(const char* first, const char* last, long double& val,
+                                 chars_format fmt = chars_format::general);
+}
+
+#endif
@@ -30,9 +30,12 @@
 #define LIBCPP_BITS_FUNCTIONAL_FUNCTION
 
 #include <__bits/functional/conditional_function_typedefs.hpp>
+#include <__bits/functional/invoke.hpp>
 #include <__bits/functional/reference_wrapper.hpp>
 #include <__bits/memory/allocator_arg.hpp>
 #include <__bits/memory/allocator_traits.hpp>
+#include <cstddef>
+#include <new>
 #include <typeinfo>
 #include <type_traits>
 #include <utility>
@@ -61,24 +64,250 @@ namespace std
         /* struct is_callable: is_callable_impl<void_t<>, T> */
         /* { /1* DUMMY BODY *1/ }; */
 
-        template<class Callable, class R, class... Args>
-        R invoke_callable(Callable* clbl, Args&&... args)
+        /**
+         * Storage for the target of function and
+         * move_only_function. Small callables (function
+         * pointers, lambdas capturing a few pointers,
+         * reference_wrappers) are placed into the inline
+         * buffer, others are allocated on the heap.
+         */
+        union function_storage
         {
-            return (*clbl)(forward<Args>(args)...);
-        }
+            static constexpr size_t local_size{3 * sizeof(void*)};
+
+            void* heap;
+            alignas(void*) unsigned char local[local_size];
+        };
+
+        /**
+         * Moves of inline targets happen in swap and
+         * move construction/assignment, which are
+         * noexcept, so we require nothrow moves.
+         */
+        template<class F>
+        inline constexpr bool function_is_local_v =
+            sizeof(F) <= function_storage::local_size &&
+            alignof(function_storage) % alignof(F) == 0 &&
+            noexcept(F(declval<F>()));
+
+        enum class function_op
+        {
+            copy, move, destroy, type, target
+        };
+
+        /**
+         * The type erasure is done through a single
+         * manager function per target type, which
+         * performs the operation given as its first
+         * argument, and an invoker.
+         */
+        using function_manager_t = const void* (*)(
+            function_op, function_storage*, function_storage*
+        );
+
+        /**
+         * Copyable is false for move_only_function, which
+         * never copies its target, so the callable need not
+         * be copy constructible.
+         */
+        template<class F, bool Copyable>
+        struct function_manager
+        {
+            static F* get(function_storage* storage) noexcept
+            {
+                if constexpr (function_is_local_v<F>)
+                    return reinterpret_cast<F*>(storage->local);
+                else
+                    return static_cast<F*>(storage->heap);
+            }
+
+            template<class... Args>
+            static void create(function_storage* storage, Args&&... args)
+            {
+                if constexpr (function_is_local_v<F>)
+                    new(storage->local) F(forward<Args>(args)...);
+                else
+                    storage->heap = new F(forward<Args>(args)...);
+            }
+
+            static const void* manage(function_op op, function_storage* dst,
+                                      function_storage* src)
+            {
+                switch (op)
+                {
+                    case function_op::copy:
+                        if constexpr (Copyable)
+                            create(dst, *get(src));
+                        break;
+                    case function_op::move:
+                        if constexpr (function_is_local_v<F>)
+                        {
+                            create(dst, move(*get(src)));
+                            get(src)->~F();
+                        }
+                        else
+                            dst->heap = src->heap;
+                        break;
+                    case function_op::destroy:
+                        if constexpr (function_is_local_v<F>)
+                            get(src)->~F();
+                        else
+                            delete get(src);
+                        break;
+                    case function_op::type:
+                        return &typeid(F);
+                    case function_op::target:
+                        return get(src);
+                }
 
-        template<class Callable>
-        void copy_callable(Callable* to, Callable* from)
+                return nullptr;
+            }
+
+            template<class R, class... Args>
+            static R invoke(function_storage* storage, Args&&... args)
+            {
+                if constexpr (is_void_v<R>)
+                    INVOKE(*get(storage), forward<Args>(args)...);
+                else
+                    return INVOKE(*get(storage), forward<Args>(args)...);
+            }
+        };
+
+        template<class F>
+        bool function_is_null(const F& f) noexcept
         {
-            new(to) Callable{*from};
+            if constexpr (is_pointer_v<F> || is_member_pointer_v<F>)
+                return f == nullptr;
+            else
+                return false;
         }
 
-        template<class Callable>
-        void destroy_callable(Callable* clbl)
+        /**
+         * Common part of function and move_only_function,
+         * the only difference between the two is whether
+         * the target has to be copied.
+         */
+        template<class R, class... Args>
+        class function_base
         {
-            if (clbl)
-                clbl->~Callable();
-        }
+            public:
+                explicit operator bool() const noexcept
+                {
+                    return manager_ != nullptr;
+                }
+
+                R operator()(Args... args) const
+                {
+                    // TODO: throw bad_function_call if !manager_
+                    if constexpr (is_void_v<R>)
+                        (*invoker_)(&storage_, forward<Args>(args)...);
+                    else
+                        return (*invoker_)(&storage_, forward<Args>(args)...);
+                }
+
+                const type_info& target_type() const noexcept
+                {
+                    if (manager_)
+                        return *static_cast<const type_info*>((*manager_)(function_op::type, nullptr, nullptr));
+                    else
+                        return typeid(void);
+                }
+
+                template<class T>
+                T* target() noexcept
+                {
+                    return const_cast<T*>(static_cast<const function_base*>(this)->template target<T>());
+                }
+
+                template<class T>
+                const T* target() const noexcept
+                {
+                    if (manager_ && target_type() == typeid(T))
+                        return static_cast<const T*>((*manager_)(function_op::target, nullptr, &storage_));
+                    else
+                        return nullptr;
+                }
+
+            protected:
+                using invoker_t = R (*)(function_storage*, Args&&...);
+
+                function_base() noexcept
+                    : storage_{}, manager_{}, invoker_{}
+                { /* DUMMY BODY */ }
+
+                ~function_base()
+                {
+                    clear_();
+                }
+
+                template<bool Copyable, class F>
+                void init_(F&& f)
+                {
+                    using callable_t = decay_t<F>;
+                    using manager_t = function_manager<callable_t, Copyable>;
+
+                    if (function_is_null(f))
+                        return;
+
+                    manager_t::create(&storage_, forward<F>(f));
+                    manager_ = &manager_t::manage;
+                    invoker_ = &manager_t::template invoke<R, Args...>;
+                }
+
+                void copy_from_(const function_base& other)
+                {
+                    if (other.manager_)
+                    {
+                        (*other.manager_)(function_op::copy, &storage_, &other.storage_);
+                        manager_ = other.manager_;
+                        invoker_ = other.invoker_;
+                    }
+                }
+
+                /**
+                 * Never allocates, heap targets
+                 * change owners and inline targets
+                 * are moved.
+                 */
+                void move_from_(function_base& other) noexcept
+                {
+                    if (other.manager_)
+                    {
+                        (*other.manager_)(function_op::move, &storage_, &other.storage_);
+                        manager_ = other.manager_;
+                        invoker_ = other.invoker_;
+
+                        other.manager_ = nullptr;
+                        other.invoker_ = nullptr;
+                    }
+                }
+
+                void swap_(function_base& other) noexcept
+                {
+                    if (this == &other)
+                        return;
+
+                    function_base tmp{};
+                    tmp.move_from_(other);
+                    other.move_from_(*this);
+                    move_from_(tmp);
+                }
+
+                void clear_() noexcept
+                {
+                    if (manager_)
+                    {
+                        (*manager_)(function_op::destroy, nullptr, &storage_);
+                        manager_ = nullptr;
+                        invoker_ = nullptr;
+                    }
+                }
+
+            private:
+                mutable function_storage storage_;
+                function_manager_t manager_;
+                invoker_t invoker_;
+        };
     }
 
     // TODO: implement
@@ -87,18 +316,13 @@ namespace std
     template<class>
     class function; // undefined
 
-    /**
-     * Note: Ideally, this implementation wouldn't
-     *       copy the target if it was a pointer to
-     *       a function, but for the simplicity of the
-     *       implementation, we do copy even in that
-     *       case for now. It would be a nice optimization
-     *       if this was changed in the future.
-     */
     template<class R, class... Args>
     class function<R(Args...)>
-        : public aux::conditional_function_typedefs<Args...>
+        : public aux::conditional_function_typedefs<Args...>,
+          public aux::function_base<R, Args...>
     {
+        using base_t = aux::function_base<R, Args...>;
+
         public:
             using result_type = R;
 
@@ -107,8 +331,7 @@ namespace std
              */
 
             function() noexcept
-                : callable_{}, callable_size_{}, call_{},
-                  copy_{}, dest_{}
+                : base_t{}
             { /* DUMMY BODY */ }
 
             function(nullptr_t) noexcept
@@ -116,34 +339,23 @@ namespace std
             { /* DUMMY BODY */ }
 
             function(const function& other)
-                : callable_{}, callable_size_{other.callable_size_},
-                  call_{other.call_}, copy_{other.copy_}, dest_{other.dest_}
+                : function{}
             {
-                callable_ = new uint8_t[callable_size_];
-                (*copy_)(callable_, other.callable_);
+                this->copy_from_(other);
             }
 
-            function(function&& other)
-                : callable_{other.callable_}, callable_size_{other.callable_size_},
-                  call_{other.call_}, copy_{other.copy_}, dest_{other.dest_}
+            function(function&& other) noexcept
+                : function{}
             {
-                other.callable_ = nullptr;
-                other.callable_size_ = size_t{};
-                other.call_ = nullptr;
-                other.copy_ = nullptr;
-                other.dest_ = nullptr;
+                this->move_from_(other);
             }
 
             // TODO: shall not participate in overloading unless aux::is_callable<F>
             template<class F>
             function(F f)
-                : callable_{}, callable_size_{sizeof(F)},
-                  call_{(call_t)aux::invoke_callable<F, R, Args...>},
-                  copy_{(copy_t)aux::copy_callable<F>},
-                  dest_{(dest_t)aux::destroy_callable<F>}
+                : function{}
             {
-                callable_ = new uint8_t[callable_size_];
-                (*copy_)(callable_, (uint8_t*)&f);
+                this->template init_<true>(move(f));
             }
 
             /**
@@ -174,7 +386,7 @@ namespace std
             // TODO: shall not participate in overloading unless aux::is_callable<F>
             template<class F, class A>
             function(allocator_arg_t, const A& a, F f)
-                : function{f}
+                : function{move(f)}
             { /* DUMMY BODY */ }
 
             function& operator=(const function& rhs)
@@ -184,33 +396,20 @@ namespace std
                 return *this;
             }
 
-            /**
-             * Note: We have to copy call_, copy_
-             *       and dest_ because they can be templated
-             *       by a type F we don't know.
-             */
-            function& operator=(function&& rhs)
+            function& operator=(function&& rhs) noexcept
             {
-                clear_();
-
-                callable_ = rhs.callable_;
-                callable_size_ = rhs.callable_size_;
-                call_ = rhs.call_;
-                copy_ = rhs.copy_;
-                dest_ = rhs.dest_;
-
-                rhs.callable_ = nullptr;
-                rhs.callable_size_ = size_t{};
-                rhs.call_ = nullptr;
-                rhs.copy_ = nullptr;
-                rhs.dest_ = nullptr;
+                if (this != &rhs)
+                {
+                    this->clear_();
+                    this->move_from_(rhs);
+                }
 
                 return *this;
             }
 
             function& operator=(nullptr_t) noexcept
             {
-                clear_();
+                this->clear_();
 
                 return *this;
             }
@@ -219,41 +418,28 @@ namespace std
             template<class F>
             function& operator=(F&& f)
             {
-                callable_size_ = sizeof(F);
-                callable_ = new uint8_t[callable_size_];
-                call_ = aux::invoke_callable<F, R, Args...>;
-                copy_ = aux::copy_callable<F>;
-                dest_ = aux::destroy_callable<F>;
+                function{forward<F>(f)}.swap(*this);
 
-                (*copy_)(callable_, (uint8_t*)&f);
+                return *this;
             }
 
             template<class F>
             function& operator=(reference_wrapper<F> ref) noexcept
             {
-                return (*this) = ref.get();
-            }
+                function{ref}.swap(*this);
 
-            ~function()
-            {
-                if (callable_)
-                {
-                    (*dest_)(callable_);
-                    delete[] callable_;
-                }
+                return *this;
             }
 
+            ~function() = default;
+
             /**
              * 20.9.12.2.2, function modifiers:
              */
 
             void swap(function& other) noexcept
             {
-                std::swap(callable_, other.callable_);
-                std::swap(callable_size_, other.callable_size_);
-                std::swap(call_, other.call_);
-                std::swap(copy_, other.copy_);
-                std::swap(dest_, other.dest_);
+                this->swap_(other);
             }
 
             template<class F, class A>
@@ -264,73 +450,10 @@ namespace std
 
             /**
              * 20.9.12.2.3, function capacity:
-             */
-
-            explicit operator bool() const noexcept
-            {
-                return callable_ != nullptr;
-            }
-
-            /**
              * 20.9.12.2.4, function invocation:
-             */
-
-            result_type operator()(Args... args) const
-            {
-                // TODO: throw bad_function_call if !callable_ || !call_
-                if constexpr (is_same_v<R, void>)
-                    (*call_)(callable_, forward<Args>(args)...);
-                else
-                    return (*call_)(callable_, forward<Args>(args)...);
-            }
-
-            /**
              * 20.9.12.2.5, function target access:
+             * (see aux::function_base)
              */
-
-            const type_info& target_type() const noexcept
-            {
-                return typeid(*callable_);
-            }
-
-            template<class T>
-            T* target() noexcept
-            {
-                if (target_type() == typeid(T))
-                    return (T*)callable_;
-                else
-                    return nullptr;
-            }
-
-            template<class T>
-            const T* target() const noexcept
-            {
-                if (target_type() == typeid(T))
-                    return (T*)callable_;
-                else
-                    return nullptr;
-            }
-
-        private:
-            using call_t = R(*)(uint8_t*, Args&&...);
-            using copy_t = void (*)(uint8_t*, uint8_t*);
-            using dest_t = void (*)(uint8_t*);
-
-            uint8_t* callable_;
-            size_t callable_size_;
-            call_t call_;
-            copy_t copy_;
-            dest_t dest_;
-
-            void clear_()
-            {
-                if (callable_)
-                {
-                    (*dest_)(callable_);
-                    delete[] callable_;
-                    callable_ = nullptr;
-                }
-            }
     };
 
     /**
@@ -377,4 +500,109 @@ namespace std
     { /* DUMMY BODY */ };
 }
 
+namespace std::__ext
+{
+    /**
+     * Extension: Move-only counterpart of std::function
+     * (similar to C++23 std::move_only_function), it can
+     * hold callables that cannot be copied (e.g. ones that
+     * own a promise or a unique_ptr) and never allocates
+     * when moved, which makes it suitable for task queues.
+     */
+    template<class>
+    class move_only_function; // undefined
+
+    template<class R, class... Args>
+    class move_only_function<R(Args...)>
+        : public aux::function_base<R, Args...>
+    {
+        using base_t = aux::function_base<R, Args...>;
+
+        public:
+            using result_type = R;
+
+            move_only_function() noexcept
+                : base_t{}
+            { /* DUMMY BODY */ }
+
+            move_only_function(nullptr_t) noexcept
+                : move_only_function{}
+            { /* DUMMY BODY */ }
+
+            move_only_function(const move_only_function&) = delete;
+
+            move_only_function(move_only_function&& other) noexcept
+                : move_only_function{}
+            {
+                this->move_from_(other);
+            }
+
+            template<
+                class F,
+                class = enable_if_t<!is_same_v<decay_t<F>, move_only_function>>
+            >
+            move_only_function(F&& f)
+                : move_only_function{}
+            {
+                this->template init_<false>(forward<F>(f));
+            }
+
+            move_only_function& operator=(const move_only_function&) = delete;
+
+            move_only_function& operator=(move_only_function&& rhs) noexcept
+            {
+                if (this != &rhs)
+                {
+                    this->clear_();
+                    this->move_from_(rhs);
+                }
+
+                return *this;
+            }
+
+            move_only_function& operator=(nullptr_t) noexcept
+            {
+                this->clear_();
+
+                return *this;
+            }
+
+            template<
+                class F,
+                class = enable_if_t<!is_same_v<decay_t<F>, move_only_function>>
+            >
+            move_only_function& operator=(F&& f)
+            {
+                move_only_function{forward<F>(f)}.swap(*this);
+
+                return *this;
+            }
+
+            ~move_only_function() = default;
+
+            void swap(move_only_function& other) noexcept
+            {
+                this->swap_(other);
+            }
+    };
+
+    template<class R, class... Args>
+    bool operator==(const move_only_function<R(Args...)>& f, nullptr_t) noexcept
+    {
+        return !f;
+    }
+
+    template<class R, class... Args>
+    bool operator!=(const move_only_function<R(Args...)>& f, nullptr_t) noexcept
+    {
+        return (bool)f;
+    }
+
+    template<class R, class... Args>
+    void swap(move_only_function<R(Args...)>& f1, move_only_function<R(Args...)>& f2)
+    {
+        f1.swap(f2);
+    }
+}
+
 #endif
@@ -75,7 +75,13 @@ namespace std
             static_assert(is_arithmetic<T>::value || is_pointer<T>::value,
                           "invalid type passed to aux::hash");
 
+            /**
+             * Clear the whole union first, otherwise types
+             * smaller than uint64_t would leave garbage
+             * in the upper bytes of the hash.
+             */
             converter<T> conv;
+            conv.converted = 0;
             conv.value = x;
 
             return hash_<size_t>(conv.converted);
@@ -33,14 +33,47 @@
 #include <cstdio>
 #include <ios>
 #include <iosfwd>
+#include <istream>
 #include <locale>
+#include <ostream>
 #include <streambuf>
 #include <string>
 
 namespace std
 {
+    namespace __ext
+    {
+        /**
+         * Open mode extension for input only file streams,
+         * the whole file is brought into memory on open
+         * and reads and seeks never touch the file again.
+         * Streams fall back to buffered reading if the file
+         * cannot be mapped.
+         */
+        inline constexpr ios_base::openmode mapped = 0b100'0000;
+    }
+
+    namespace aux
+    {
+        /**
+         * File access used by basic_filebuf, see src/fstream.cpp.
+         * Positions are in bytes and explicit, the handles
+         * returned by filebuf_open keep no position of their own.
+         */
+        int filebuf_open(const char* name, ios_base::openmode mode);
+        bool filebuf_close(int fd);
+        streamsize filebuf_read(int fd, streamoff pos, void* buf, size_t size);
+        streamsize filebuf_write(int fd, streamoff pos, const void* buf, size_t size);
+        streamoff filebuf_size(int fd);
+        void* filebuf_map(int fd, size_t size);
+        void filebuf_unmap(void* map);
+    }
+
     /**
      * 27.9.1.1, class template basic_filebuf:
+     * Note: We do not use codecvt, characters are written
+     *       to the file as they are and positions count
+     *       characters, not bytes.
      */
     template<class Char, class Traits>
     class basic_filebuf: public basic_streambuf<Char, Traits>
@@ -58,26 +91,25 @@ namespace std
 
             basic_filebuf()
                 : basic_streambuf<char_type, traits_type>{},
-                  obuf_{nullptr}, ibuf_{nullptr}, mode_{}, file_{nullptr}
+                  fd_{-1}, mode_{}, buf_{nullptr}, buf_size_{default_buf_size_},
+                  buf_owned_{false}, buf_pos_{}, map_{nullptr}
             { /* DUMMY BODY */ }
 
             basic_filebuf(const basic_filebuf&) = delete;
 
             basic_filebuf(basic_filebuf&& other)
-                : mode_{other.mode_}
+                : basic_filebuf{}
             {
-                close();
-                std::swap(obuf_, other.obuf_);
-                std::swap(ibuf_, other.ibuf_);
-                std::swap(file_, other.file_);
-
-                basic_streambuf<char_type, traits_type>::swap(other);
+                swap(other);
             }
 
             virtual ~basic_filebuf()
             {
                 // TODO: exception here caught and not rethrown
                 close();
+
+                if (buf_owned_)
+                    delete[] buf_;
             }
 
             /**
@@ -96,9 +128,13 @@ namespace std
 
             void swap(basic_filebuf& rhs)
             {
+                std::swap(fd_, rhs.fd_);
                 std::swap(mode_, rhs.mode_);
-                std::swap(obuf_, rhs.obuf_);
-                std::swap(ibuf_, rhs.ibuf_);
+                std::swap(buf_, rhs.buf_);
+                std::swap(buf_size_, rhs.buf_size_);
+                std::swap(buf_owned_, rhs.buf_owned_);
+                std::swap(buf_pos_, rhs.buf_pos_);
+                std::swap(map_, rhs.map_);
 
                 basic_streambuf<char_type, traits_type>::swap(rhs);
             }
@@ -109,39 +145,37 @@ namespace std
 
             bool is_open() const
             {
-                return file_ != nullptr;
+                return fd_ >= 0;
             }
 
             basic_filebuf<char_type, traits_type>* open(const char* name, ios_base::openmode mode)
             {
-                if (file_)
+                if (is_open())
                     return nullptr;
 
-                mode_ = mode;
-                mode = (mode & (~ios_base::ate));
-                const char* mode_str = get_mode_str_(mode);
-
-                if (!mode_str)
+                auto fd = aux::filebuf_open(name, mode & ~__ext::mapped);
+                if (fd < 0)
                     return nullptr;
 
-                file_ = fopen(name, mode_str);
-                if (!file_)
-                    return nullptr;
+                fd_ = fd;
+                mode_ = mode;
+                buf_pos_ = 0;
 
-                if ((mode_ & ios_base::ate) != 0)
+                if ((mode_ & ios_base::ate) != 0 || mode_is_mapped_(mode_))
                 {
-                    if (fseek(file_, 0, SEEK_END) != 0)
+                    auto size = size_();
+                    if (size < 0)
                     {
                         close();
                         return nullptr;
                     }
-                }
 
-                if (!ibuf_ && mode_is_in_(mode_))
-                    ibuf_ = new char_type[buf_size_];
-                if (!obuf_ && mode_is_out_(mode_))
-                    obuf_ = new char_type[buf_size_];
-                init_();
+                    if ((mode_ & ios_base::ate) != 0)
+                        buf_pos_ = size;
+
+                    if (mode_is_mapped_(mode_) && size > 0)
+                        map_file_(size);
+                }
 
                 return this;
             }
@@ -154,18 +188,37 @@ namespace std
             basic_filebuf<char_type, traits_type>* close()
             {
                 // TODO: caught exceptions are to be rethrown after closing the file
-                if (!file_)
+                if (!is_open())
                     return nullptr;
-                // TODO: deallocate buffers?
-
-                if (this->output_next_ != this->output_begin_)
-                    overflow(traits_type::eof());
                 // TODO: unshift? (p. 1084 at the top)
 
-                fclose(file_);
-                file_ = nullptr;
+                bool ok = flush_();
 
-                return this;
+                if (map_)
+                {
+                    aux::filebuf_unmap(map_);
+                    map_ = nullptr;
+                }
+
+                if (!aux::filebuf_close(fd_))
+                    ok = false;
+                fd_ = -1;
+
+                /**
+                 * User provided buffers stay in use
+                 * if the file is opened again.
+                 */
+                if (buf_owned_)
+                {
+                    delete[] buf_;
+                    buf_ = nullptr;
+                    buf_owned_ = false;
+                }
+
+                this->setg(nullptr, nullptr, nullptr);
+                this->setp(nullptr, nullptr);
+
+                return ok ? this : nullptr;
             }
 
         protected:
@@ -173,50 +226,83 @@ namespace std
              * 27.9.1.5, overriden virtual functions:
              */
 
+            streamsize showmanyc() override
+            {
+                if (!is_open() || !mode_is_in_(mode_))
+                    return -1;
+
+                if (map_)
+                    return this->input_end_ - this->input_next_;
+
+                auto size = size_();
+                auto pos = pos_();
+                if (size < 0 || pos >= size)
+                    return -1;
+
+                return size - pos;
+            }
+
             int_type underflow() override
             {
-                // TODO: use codecvt
-                if (!mode_is_in_(mode_))
+                if (!is_open() || !mode_is_in_(mode_))
                     return traits_type::eof();
 
-                if (!ibuf_)
-                {
-                    ibuf_ = new char_type[buf_size_];
-                    this->input_begin_ = this->input_next_ = this->input_end_ = ibuf_;
-                }
+                if (this->read_avail_())
+                    return traits_type::to_int_type(*this->input_next_);
 
-                off_type i{};
-                if (this->input_next_ < this->input_end_)
-                {
-                    auto idx = static_cast<off_type>(this->input_next_ - this->input_begin_);
-                    auto count = static_cast<off_type>(buf_size_) - idx;
+                if (map_ || !settle_() || !ensure_buf_())
+                    return traits_type::eof();
 
-                    for (; i < count; ++i, ++idx)
-                        ibuf_[i] = ibuf_[idx];
-                }
+                auto count = read_(buf_pos_, buf_, static_cast<streamsize>(buf_size_));
+                if (count <= 0)
+                    return traits_type::eof();
 
-                for (; i < static_cast<off_type>(buf_size_); ++i)
-                {
-                    auto c = fgetc(file_);
-                    if (c == traits_type::eof())
-                        break;
+                this->setg(buf_, buf_, buf_ + count);
 
-                    ibuf_[i] = static_cast<char_type>(c);
+                return traits_type::to_int_type(*this->input_next_);
+            }
+
+            streamsize xsgetn(char_type* s, streamsize n) override
+            {
+                if (!s || n <= 0)
+                    return 0;
 
-                    if (ibuf_[i] == '\n')
+                streamsize res{};
+                while (res < n)
+                {
+                    if (this->read_avail_())
                     {
-                        ++i;
-                        break;
+                        auto count = min(
+                            static_cast<streamsize>(this->input_end_ - this->input_next_),
+                            n - res
+                        );
+                        traits_type::copy(s + res, this->input_next_, count);
+
+                        this->input_next_ += count;
+                        res += count;
                     }
+                    else if (!map_ && n - res >= static_cast<streamsize>(buf_size_))
+                    {
+                        /**
+                         * Large reads go straight to the caller's
+                         * memory, copying them through the buffer
+                         * would only double the work.
+                         */
+                        if (!is_open() || !mode_is_in_(mode_) || !settle_())
+                            break;
+
+                        auto count = read_(buf_pos_, s + res, n - res);
+                        if (count <= 0)
+                            break;
+
+                        buf_pos_ += count;
+                        res += count;
+                    }
+                    else if (traits_type::eq_int_type(underflow(), traits_type::eof()))
+                        break;
                 }
 
-                this->input_next_ = this->input_begin_;
-                this->input_end_ = this->input_begin_ + i;
-
-                if (i == 0)
-                    return traits_type::eof();
-
-                return traits_type::to_int_type(*this->input_next_);
+                return res;
             }
 
             int_type pbackfail(int_type c = traits_type::eof()) override
@@ -231,8 +317,13 @@ namespace std
                     return c;
                 }
                 else if (!traits_type::eq_int_type(c, traits_type::eof()) &&
-                         this->putback_avail_() && (mode_ & ios_base::out) != 0)
+                         this->putback_avail_() && !map_ && mode_is_out_(mode_))
                 {
+                    /**
+                     * The changed character only lives in the buffer,
+                     * same as with any other implementation that does
+                     * not write back the get area.
+                     */
                     *--this->input_next_ = cc;
 
                     return c;
@@ -250,49 +341,165 @@ namespace std
 
             int_type overflow(int_type c = traits_type::eof()) override
             {
-                // TODO: use codecvt
-                if (!mode_is_out_(mode_))
+                if (!is_open() || !mode_is_out_(mode_) || map_)
                     return traits_type::eof();
 
-                auto count = static_cast<size_t>(this->output_next_ - this->output_begin_);
-                fwrite(obuf_, sizeof(char_type), count, file_);
-                fflush(file_);
+                if (!this->output_begin_)
+                {
+                    if (!settle_() || !ensure_buf_())
+                        return traits_type::eof();
 
-                this->output_next_ = this->output_begin_;
+                    if (buf_size_ > 1)
+                        this->setp(buf_, buf_ + buf_size_);
+                }
+                else if (!flush_())
+                    return traits_type::eof();
 
-                return traits_type::not_eof(c);
+                if (traits_type::eq_int_type(c, traits_type::eof()))
+                    return traits_type::not_eof(c);
+
+                auto cc = traits_type::to_char_type(c);
+                if (this->write_avail_())
+                    *this->output_next_++ = cc;
+                else if (!write_(&cc, 1))
+                    return traits_type::eof();
+
+                return c;
+            }
+
+            streamsize xsputn(const char_type* s, streamsize n) override
+            {
+                if (!s || n <= 0)
+                    return 0;
+
+                streamsize res{};
+                while (res < n)
+                {
+                    if (this->write_avail_())
+                    {
+                        auto count = min(
+                            static_cast<streamsize>(this->output_end_ - this->output_next_),
+                            n - res
+                        );
+                        traits_type::copy(this->output_next_, s + res, count);
+
+                        this->output_next_ += count;
+                        res += count;
+                    }
+                    else if (n - res >= static_cast<streamsize>(buf_size_))
+                    {
+                        /**
+                         * Same as in xsgetn, large writes skip
+                         * the buffer once it is flushed.
+                         */
+                        if (!is_open() || !mode_is_out_(mode_) || map_ || !settle_())
+                            break;
+
+                        if (!write_(s + res, n - res))
+                            break;
+                        res = n;
+                    }
+                    else if (traits_type::eq_int_type(overflow(), traits_type::eof()))
+                        break;
+                }
+
+                return res;
             }
 
             basic_streambuf<char_type, traits_type>*
             setbuf(char_type* s, streamsize n) override
             {
-                // TODO: implement
-                __unimplemented();
-                return nullptr;
+                /**
+                 * setbuf(nullptr, 0) makes the stream unbuffered,
+                 * setbuf(nullptr, n) only changes the size of the
+                 * buffer we allocate ourselves.
+                 */
+                if (!settle_())
+                    return nullptr;
+
+                if (buf_owned_)
+                    delete[] buf_;
+
+                if (s && n > 0)
+                {
+                    buf_ = s;
+                    buf_size_ = static_cast<size_t>(n);
+                }
+                else
+                {
+                    buf_ = nullptr;
+                    buf_size_ = n > 1 ? static_cast<size_t>(n) : 1;
+                }
+                buf_owned_ = false;
+
+                return this;
             }
 
             pos_type seekoff(off_type off, ios_base::seekdir dir,
                              ios_base::openmode mode = ios_base::in | ios_base::out) override
             {
-                // TODO: implement
-                __unimplemented();
-                return pos_type{};
+                if (!is_open())
+                    return pos_type(off_type(-1));
+
+                if (map_)
+                {
+                    auto size = this->input_end_ - this->input_begin_;
+                    auto pos = seek_target_(off, dir, this->input_next_ - this->input_begin_, size);
+                    if (pos < 0 || pos > size)
+                        return pos_type(off_type(-1));
+
+                    this->input_next_ = this->input_begin_ + pos;
+
+                    return pos_type(pos);
+                }
+
+                if (dir == ios_base::cur && off == 0)
+                    return pos_type(pos_());
+
+                if (this->input_begin_ && dir != ios_base::end)
+                {
+                    /**
+                     * Seeks inside of the get area keep the buffer,
+                     * which makes rereading (and tellg/seekg pairs)
+                     * cheap.
+                     */
+                    auto pos = seek_target_(off, dir, pos_(), 0);
+                    if (pos >= buf_pos_ && pos <= buf_pos_ + (this->input_end_ - this->input_begin_))
+                    {
+                        this->input_next_ = this->input_begin_ + (pos - buf_pos_);
+
+                        return pos_type(pos);
+                    }
+                }
+
+                if (!settle_())
+                    return pos_type(off_type(-1));
+
+                off_type size{};
+                if (dir == ios_base::end)
+                {
+                    size = size_();
+                    if (size < 0)
+                        return pos_type(off_type(-1));
+                }
+
+                auto pos = seek_target_(off, dir, buf_pos_, size);
+                if (pos < 0)
+                    return pos_type(off_type(-1));
+                buf_pos_ = pos;
+
+                return pos_type(pos);
             }
 
             pos_type seekpos(pos_type pos,
                              ios_base::openmode mode = ios_base::in | ios_base::out) override
             {
-                // TODO: implement
-                __unimplemented();
-                return pos_type{};
+                return seekoff(off_type(pos), ios_base::beg, mode);
             }
 
             int sync() override
             {
-                if (mode_is_out_(mode_))
-                    overflow();
-
-                return 0; // TODO: what is the correct return value?
+                return flush_() ? 0 : -1;
             }
 
             void imbue(const locale& loc) override
@@ -302,77 +509,177 @@ namespace std
             }
 
         private:
-            char_type* obuf_;
-            char_type* ibuf_;
-
+            int fd_;
             ios_base::openmode mode_;
 
-            FILE* file_;
+            /**
+             * Single buffer shared by the get and put areas,
+             * at most one of them is in use at any time. The
+             * buf_pos_ member is the position of the start of
+             * the area in use or, if there is none, the current
+             * position in the file.
+             */
+            char_type* buf_;
+            size_t buf_size_;
+            bool buf_owned_;
+            off_type buf_pos_;
+
+            void* map_;
 
-            static constexpr size_t buf_size_{128};
+            /**
+             * One page, the VFS passes whole pages
+             * around anyway.
+             */
+            static constexpr size_t default_buf_size_{4096};
 
-            const char* get_mode_str_(ios_base::openmode mode)
+            bool mode_is_in_(ios_base::openmode mode) const
             {
-                /**
-                 * See table 132.
-                 */
-                switch (mode)
+                return (mode & ios_base::in) != 0;
+            }
+
+            bool mode_is_out_(ios_base::openmode mode) const
+            {
+                return (mode & (ios_base::out | ios_base::app | ios_base::trunc)) != 0;
+            }
+
+            bool mode_is_mapped_(ios_base::openmode mode) const
+            {
+                return (mode & __ext::mapped) != 0 && !mode_is_out_(mode);
+            }
+
+            bool ensure_buf_()
+            {
+                if (!buf_)
                 {
-                    case ios_base::out:
-                    case ios_base::out | ios_base::trunc:
-                        return "w";
-                    case ios_base::out | ios_base::app:
-                    case ios_base::app:
-                        return "a";
-                    case ios_base::in:
-                        return "r";
-                    case ios_base::in | ios_base::out:
-                        return "r+";
-                    case ios_base::in | ios_base::out | ios_base::trunc:
-                        return "w+";
-                    case ios_base::in | ios_base::out | ios_base::app:
-                    case ios_base::in | ios_base::app:
-                        return "a+";
-                    case ios_base::binary | ios_base::out:
-                    case ios_base::binary | ios_base::out | ios_base::trunc:
-                        return "wb";
-                    case ios_base::binary | ios_base::out | ios_base::app:
-                    case ios_base::binary | ios_base::app:
-                        return "ab";
-                    case ios_base::binary | ios_base::in:
-                        return "rb";
-                    case ios_base::binary | ios_base::in | ios_base::out:
-                        return "r+b";
-                    case ios_base::binary | ios_base::in | ios_base::out | ios_base::trunc:
-                        return "w+b";
-                    case ios_base::binary | ios_base::in | ios_base::out | ios_base::app:
-                    case ios_base::binary | ios_base::in | ios_base::app:
-                        return "a+b";
-                    default:
-                        return nullptr;
+                    buf_ = new char_type[buf_size_];
+                    buf_owned_ = true;
                 }
+
+                return buf_ != nullptr;
             }
 
-            bool mode_is_in_(ios_base::openmode mode)
+            off_type pos_() const
             {
-                return (mode & ios_base::in) != 0;
+                if (this->input_begin_)
+                    return buf_pos_ + (this->input_next_ - this->input_begin_);
+                else if (this->output_begin_)
+                    return buf_pos_ + (this->output_next_ - this->output_begin_);
+                else
+                    return buf_pos_;
             }
 
-            bool mode_is_out_(ios_base::openmode mode)
+            off_type size_() const
             {
-                return (mode & (ios_base::out | ios_base::app | ios_base::trunc)) != 0;
+                auto size = aux::filebuf_size(fd_);
+                if (size < 0)
+                    return size;
+
+                return size / static_cast<off_type>(sizeof(char_type));
+            }
+
+            off_type seek_target_(off_type off, ios_base::seekdir dir,
+                                  off_type cur, off_type size) const
+            {
+                if (dir == ios_base::beg)
+                    return off;
+                else if (dir == ios_base::cur)
+                    return cur + off;
+                else
+                    return size + off;
+            }
+
+            streamsize read_(off_type pos, char_type* s, streamsize n)
+            {
+                auto res = aux::filebuf_read(
+                    fd_, pos * sizeof(char_type), s, n * sizeof(char_type)
+                );
+                if (res < 0)
+                    return res;
+
+                return res / static_cast<streamsize>(sizeof(char_type));
             }
 
-            void init_()
+            /**
+             * Writes the whole range at buf_pos_ and moves
+             * buf_pos_ after it.
+             */
+            bool write_(const char_type* s, streamsize n)
             {
-                if (ibuf_)
-                    this->input_begin_ = this->input_next_ = this->input_end_ = ibuf_;
+                while (n > 0)
+                {
+                    auto res = aux::filebuf_write(
+                        fd_, buf_pos_ * sizeof(char_type), s, n * sizeof(char_type)
+                    );
+                    if (res <= 0 || res % static_cast<streamsize>(sizeof(char_type)) != 0)
+                        return false;
+
+                    auto count = res / static_cast<streamsize>(sizeof(char_type));
+                    buf_pos_ += count;
+                    s += count;
+                    n -= count;
+                }
 
-                if (obuf_)
+                if ((mode_ & ios_base::app) != 0)
                 {
-                    this->output_begin_ = this->output_next_ = obuf_;
-                    this->output_end_ = obuf_ + buf_size_;
+                    /**
+                     * The VFS puts appended data at the end no matter
+                     * what position we ask for, which need not be
+                     * where we think it is if somebody else writes
+                     * to the file too.
+                     */
+                    auto size = size_();
+                    if (size >= 0)
+                        buf_pos_ = size;
                 }
+
+                return true;
+            }
+
+            /**
+             * Writes out the put area, the area is left
+             * empty but in use.
+             */
+            bool flush_()
+            {
+                if (!this->output_begin_)
+                    return true;
+
+                auto count = this->output_next_ - this->output_begin_;
+                this->output_next_ = this->output_begin_;
+
+                return write_(this->output_begin_, count);
+            }
+
+            /**
+             * Flushes the put area and drops both areas,
+             * buf_pos_ is the current position afterwards.
+             */
+            bool settle_()
+            {
+                if (map_)
+                    return true;
+
+                bool ok = flush_();
+                buf_pos_ = pos_();
+
+                this->setg(nullptr, nullptr, nullptr);
+                this->setp(nullptr, nullptr);
+
+                return ok;
+            }
+
+            void map_file_(off_type size)
+            {
+                auto map = aux::filebuf_map(fd_, size * sizeof(char_type));
+                if (!map)
+                    return;
+
+                map_ = map;
+
+                auto data = static_cast<char_type*>(map_);
+                auto pos = min(buf_pos_, size);
+                this->setg(data, data + pos, data + size);
+                buf_pos_ = 0;
             }
     };
 
@@ -425,7 +732,7 @@ namespace std
 
             basic_ifstream(basic_ifstream&& other)
                 : basic_istream<char_type, traits_type>{move(other)},
-                  rdbuf_{other.rdbuf_}
+                  rdbuf_{move(other.rdbuf_)}
             {
                 basic_istream<char_type, traits_type>::set_rdbuf(&rdbuf_);
             }
@@ -439,6 +746,8 @@ namespace std
             basic_ifstream& operator=(basic_ifstream&& other)
             {
                 swap(other);
+
+                return *this;
             }
 
             void swap(basic_ifstream& rhs)
@@ -534,7 +843,7 @@ namespace std
 
             basic_ofstream(basic_ofstream&& other)
                 : basic_ostream<char_type, traits_type>{move(other)},
-                  rdbuf_{other.rdbuf_}
+                  rdbuf_{move(other.rdbuf_)}
             {
                 basic_ostream<char_type, traits_type>::set_rdbuf(&rdbuf_);
             }
@@ -548,6 +857,8 @@ namespace std
             basic_ofstream& operator=(basic_ofstream&& other)
             {
                 swap(other);
+
+                return *this;
             }
 
             void swap(basic_ofstream& rhs)
@@ -645,7 +956,7 @@ namespace std
 
             basic_fstream(basic_fstream&& other)
                 : basic_iostream<char_type, traits_type>{move(other)},
-                  rdbuf_{other.rdbuf_}
+                  rdbuf_{move(other.rdbuf_)}
             {
                 basic_iostream<char_type, traits_type>::set_rdbuf(&rdbuf_);
             }
@@ -659,6 +970,8 @@ namespace std
             basic_fstream& operator=(basic_fstream&& other)
             {
                 swap(other);
+
+                return *this;
             }
 
             void swap(basic_fstream& rhs)
@@ -479,9 +479,9 @@ namespace std
                 width_      = rhs.width_;
                 precision_  = rhs.precision_;
                 fill_       = rhs.fill_;
-                locale_     = move(rhs.locale_);
+                locale_     = std::move(rhs.locale_);
                 rdstate_    = rhs.rdstate_;
-                callbacks_  = move(rhs.callbacks_);
+                callbacks_  = std::move(rhs.callbacks_);
 
                 delete[] iarray_;
                 iarray_      = rhs.iarray_;
@@ -505,7 +505,7 @@ namespace std
                 width_      = rhs.width_;
                 precision_  = rhs.precision_;
                 fill_       = rhs.fill_;
-                locale_     = move(rhs.locale_);
+                locale_     = std::move(rhs.locale_);
                 rdstate_    = rhs.rdstate_;
                 callbacks_.swap(rhs.callbacks_);
 
@@ -525,19 +525,19 @@ namespace std
             void swap(basic_ios& rhs) noexcept
             {
                 // Swap everything but rdbuf_.
-                swap(tie_, rhs.tie_);
-                swap(exceptions_, rhs.exceptions_);
-                swap(flags_, rhs.flags_);
-                swap(width_, rhs.width_);
-                swap(precision_, rhs.precision_);
-                swap(fill_, rhs.fill_);
-                swap(locale_, rhs.locale_);
-                swap(rdstate_, rhs.rdstate_);
-                swap(callbacks_, rhs.callbacks_);
-                swap(iarray_);
-                swap(iarray_size_);
-                swap(parray_);
-                swap(parray_size_);
+                std::swap(tie_, rhs.tie_);
+                std::swap(exceptions_, rhs.exceptions_);
+                std::swap(flags_, rhs.flags_);
+                std::swap(width_, rhs.width_);
+                std::swap(precision_, rhs.precision_);
+                std::swap(fill_, rhs.fill_);
+                std::swap(locale_, rhs.locale_);
+                std::swap(rdstate_, rhs.rdstate_);
+                std::swap(callbacks_, rhs.callbacks_);
+                std::swap(iarray_, rhs.iarray_);
+                std::swap(iarray_size_, rhs.iarray_size_);
+                std::swap(parray_, rhs.parray_);
+                std::swap(parray_size_, rhs.parray_size_);
             }
 
             void set_rdbuf(basic_streambuf<Char, Traits>* sb)
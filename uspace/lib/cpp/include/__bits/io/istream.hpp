@@ -604,17 +604,9 @@ namespace std
                     return *this;
                 }
 
-                while (gcount_ < n)
-                {
-                    auto c = this->rdbuf()->sbumpc();
-                    if (traits_type::eq_int_type(c, traits_type::eof()))
-                    {
-                        this->setstate(ios_base::failbit | ios_base::eofbit);
-                        break;
-                    }
-
-                    s[gcount_++] = traits_type::to_char_type(c);
-                }
+                gcount_ = this->rdbuf()->sgetn(s, n);
+                if (gcount_ < n)
+                    this->setstate(ios_base::failbit | ios_base::eofbit);
 
                 return *this;
             }
@@ -730,9 +722,8 @@ namespace std
 
                 sentry sen{*this, true};
 
-                if (!this->fail())
-                    this->rdbuf()->pubseekoff(pos, ios_base::in);
-                else
+                if (this->fail() ||
+                    this->rdbuf()->pubseekpos(pos, ios_base::in) == pos_type(off_type(-1)))
                     this->setstate(ios_base::failbit);
 
                 return *this;
@@ -742,9 +733,8 @@ namespace std
             {
                 sentry sen{*this, true};
 
-                if (!this->fail())
-                    this->rdbuf()->pubseekoff(off, dir, ios_base::in);
-                else
+                if (this->fail() ||
+                    this->rdbuf()->pubseekoff(off, dir, ios_base::in) == pos_type(off_type(-1)))
                     this->setstate(ios_base::failbit);
 
                 return *this;
@@ -757,7 +747,7 @@ namespace std
 
             basic_istream(basic_istream&& rhs)
             {
-                gcount_ = rhs.gcout_;
+                gcount_ = rhs.gcount_;
 
                 basic_ios<Char, Traits>::move(rhs);
 
@@ -418,18 +418,8 @@ namespace std
             {
                 sentry sen{*this};
 
-                if (sen)
-                {
-                    for (streamsize i = 0; i < n; ++i)
-                    {
-                        auto ret = this->rdbuf()->sputc(s[i]);
-                        if (traits_type::eq_int_type(ret, traits_type::eof()))
-                        {
-                            this->setstate(ios_base::badbit);
-                            break;
-                        }
-                    }
-                }
+                if (sen && this->rdbuf()->sputn(s, n) != n)
+                    this->setstate(ios_base::badbit);
 
                 return *this;
             }
@@ -457,22 +447,27 @@ namespace std
 
             pos_type tellp()
             {
-                // TODO: implement
-                __unimplemented();
-                return pos_type{};
+                if (this->fail())
+                    return pos_type(off_type(-1));
+                else
+                    return this->rdbuf()->pubseekoff(0, ios_base::cur, ios_base::out);
             }
 
             basic_ostream<Char, Traits>& seekp(pos_type pos)
             {
-                // TODO: implement
-                __unimplemented();
+                if (this->fail() ||
+                    this->rdbuf()->pubseekpos(pos, ios_base::out) == pos_type(off_type(-1)))
+                    this->setstate(ios_base::failbit);
+
                 return *this;
             }
 
             basic_ostream<Char, Traits>& seekp(off_type off, ios_base::seekdir dir)
             {
-                // TODO: implement
-                __unimplemented();
+                if (this->fail() ||
+                    this->rdbuf()->pubseekoff(off, dir, ios_base::out) == pos_type(off_type(-1)))
+                    this->setstate(ios_base::failbit);
+
                 return *this;
             }
 
@@ -104,7 +104,7 @@ namespace std
             {
                 if (mode_ & ios_base::out)
                     return basic_string<char_type, traits_type, allocator_type>{
-                        this->output_begin_, this->output_next_ - 1, str_.get_allocator()
+                        this->output_begin_, this->output_next_, str_.get_allocator()
                     };
                 else if (mode_ == ios_base::in)
                     return basic_string<char_type, traits_type, allocator_type>{
@@ -127,6 +127,14 @@ namespace std
 
             int_type underflow() override
             {
+                /**
+                 * Characters written since the last overflow
+                 * are not in the input area yet.
+                 */
+                if ((mode_ & ios_base::in) != 0 && (mode_ & ios_base::out) != 0 &&
+                    this->input_end_ < this->output_next_)
+                    this->input_end_ = this->output_next_;
+
                 if (this->read_avail_())
                     return traits_type::to_int_type(*this->gptr());
                 else
@@ -244,9 +252,14 @@ namespace std
 
                 if ((mode_ & ios_base::out) != 0)
                 {
+                    /**
+                     * The whole storage of the string is available
+                     * for writing, its size is only updated when we
+                     * run out of it in overflow.
+                     */
                     this->output_begin_ = str_.begin();
                     this->output_next_ = str_.end();
-                    this->output_end_ = str_.begin() + str_.size() + 1;
+                    this->output_end_ = str_.begin() + str_.capacity() + 1;
                 }
             }
 
@@ -214,15 +214,15 @@ namespace std
 
             void swap(basic_streambuf& rhs)
             {
-                swap(input_begin_, rhs.input_begin_);
-                swap(input_next_, rhs.input_next_);
-                swap(input_end_, rhs.input_end_);
+                std::swap(input_begin_, rhs.input_begin_);
+                std::swap(input_next_, rhs.input_next_);
+                std::swap(input_end_, rhs.input_end_);
 
-                swap(output_begin_, rhs.output_begin_);
-                swap(output_next_, rhs.output_next_);
-                swap(output_end_, rhs.output_end_);
+                std::swap(output_begin_, rhs.output_begin_);
+                std::swap(output_next_, rhs.output_next_);
+                std::swap(output_end_, rhs.output_end_);
 
-                swap(locale_, rhs.locale_);
+                std::swap(locale_, rhs.locale_);
             }
 
             /**
@@ -336,13 +336,18 @@ namespace std
                     return 0;
 
                 streamsize i{0};
-                auto eof = traits_type::eof();
-                for (; i <= n; ++i)
+                for (; i < n; ++i)
                 {
-                    if (!read_avail_() && traits_type::eq_int_type(uflow(), eof))
-                        break;
-
-                    *s++ = *input_next_++;
+                    if (read_avail_())
+                        *s++ = *input_next_++;
+                    else
+                    {
+                        auto c = uflow();
+                        if (traits_type::eq_int_type(c, traits_type::eof()))
+                            break;
+
+                        *s++ = traits_type::to_char_type(c);
+                    }
                 }
 
                 return i;
@@ -381,12 +386,13 @@ namespace std
                     return 0;
 
                 streamsize i{0};
-                for (; i <= n; ++i)
+                for (; i < n; ++i, ++s)
                 {
-                    if (!write_avail_() && traits_type::eq_int_type(overflow(), traits_type::eof()))
+                    if (write_avail_())
+                        *output_next_++ = *s;
+                    else if (traits_type::eq_int_type(overflow(traits_type::to_int_type(*s)),
+                                                      traits_type::eof()))
                         break;
-
-                    *output_next_++ = *s++;
                 }
 
                 return i;
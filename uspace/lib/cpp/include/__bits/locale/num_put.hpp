@@ -31,8 +31,11 @@
 
 #include <__bits/locale/locale.hpp>
 #include <__bits/locale/numpunct.hpp>
+#include <charconv>
+#include <cstdint>
 #include <ios>
 #include <iterator>
+#include <type_traits>
 
 namespace std
 {
@@ -113,141 +116,170 @@ namespace std
 
             iter_type do_put(iter_type it, ios_base& base, char_type fill, long v) const
             {
-                auto basefield = (base.flags() & ios_base::basefield);
-                auto uppercase = (base.flags() & ios_base::uppercase);
+                return put_integer_(it, base, fill, v);
+            }
 
-                int ret{};
-                if (basefield == ios_base::oct)
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%lo", v);
-                else if ((basefield == ios_base::hex) && !uppercase)
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%lx", v);
-                else if (basefield == ios_base::hex)
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%lX", v);
-                else
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%ld", v);
+            iter_type do_put(iter_type it, ios_base& base, char_type fill, long long v) const
+            {
+                return put_integer_(it, base, fill, v);
+            }
 
-                return put_adjusted_buffer_(it, base, fill, ret);
+            iter_type do_put(iter_type it, ios_base& base, char_type fill, unsigned long v) const
+            {
+                return put_integer_(it, base, fill, v);
             }
 
-            iter_type do_put(iter_type it, ios_base& base, char_type fill, long long v) const
+            iter_type do_put(iter_type it, ios_base& base, char_type fill, unsigned long long v) const
             {
-                auto basefield = (base.flags() & ios_base::basefield);
-                auto uppercase = (base.flags() & ios_base::uppercase);
+                return put_integer_(it, base, fill, v);
+            }
 
-                int ret{};
-                if (basefield == ios_base::oct)
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%llo", v);
-                else if ((basefield == ios_base::hex) && !uppercase)
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%llx", v);
-                else if (basefield == ios_base::hex)
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%llX", v);
-                else
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%lld", v);
+            iter_type do_put(iter_type it, ios_base& base, char_type fill, double v) const
+            {
+                return put_float_(it, base, fill, v);
+            }
 
-                return put_adjusted_buffer_(it, base, fill, ret);
+            iter_type do_put(iter_type it, ios_base& base, char_type fill, long double v) const
+            {
+                /**
+                 * Note: Long double is formatted as double at the moment.
+                 */
+                return put_float_(it, base, fill, static_cast<double>(v));
             }
 
-            iter_type do_put(iter_type it, ios_base& base, char_type fill, unsigned long v) const
+            iter_type do_put(iter_type it, ios_base& base, char_type fill, const void* v) const
             {
-                auto basefield = (base.flags() & ios_base::basefield);
-                auto uppercase = (base.flags() & ios_base::uppercase);
+                /**
+                 * Same as %p, zero padded hexadecimal address
+                 * with the 0x prefix.
+                 */
+                auto first = base.buffer_;
+                auto size = 2 + 2 * sizeof(v);
 
-                int ret{};
-                if (basefield == ios_base::oct)
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%lo", v);
-                else if ((basefield == ios_base::hex) && !uppercase)
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%lx", v);
-                else if (basefield == ios_base::hex)
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%lX", v);
-                else
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%lu", v);
+                first[0] = '0';
+                first[1] = 'x';
+
+                auto val = reinterpret_cast<uintptr_t>(v);
+                for (size_t i = size; i > 2; --i)
+                {
+                    first[i - 1] = aux::digits[val & 0xf];
+                    val >>= 4;
+                }
 
-                return put_adjusted_buffer_(it, base, fill, ret);
+                return put_adjusted_buffer_(it, base, fill, first, size);
             }
 
-            iter_type do_put(iter_type it, ios_base& base, char_type fill, unsigned long long v) const
+        private:
+            template<class Int>
+            iter_type put_integer_(iter_type it, ios_base& base, char_type fill, Int v) const
             {
                 auto basefield = (base.flags() & ios_base::basefield);
                 auto uppercase = (base.flags() & ios_base::uppercase);
 
+                auto first = base.buffer_;
+                auto last = first + ios_base::buffer_size_;
+
                 // TODO: showbase
-                int ret{};
+                to_chars_result res{};
                 if (basefield == ios_base::oct)
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%llo", v);
-                else if ((basefield == ios_base::hex) && !uppercase)
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%llx", v);
+                    res = to_chars(first, last, static_cast<aux::chars_uint_t<Int>>(v), 8);
                 else if (basefield == ios_base::hex)
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%llX", v);
+                {
+                    res = to_chars(first, last, static_cast<aux::chars_uint_t<Int>>(v), 16);
+                    if (uppercase)
+                        to_upper_(first, res.ptr);
+                }
                 else
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%llu", v);
+                    res = to_chars(first, last, v);
 
-                return put_adjusted_buffer_(it, base, fill, ret);
+                return put_adjusted_buffer_(it, base, fill, first, res.ptr - first);
             }
 
-            iter_type do_put(iter_type it, ios_base& base, char_type fill, double v) const
+            iter_type put_float_(iter_type it, ios_base& base, char_type fill, double v) const
             {
                 auto floatfield = (base.flags() & ios_base::floatfield);
                 auto uppercase = (base.flags() & ios_base::uppercase);
+                auto precision = static_cast<int>(base.precision());
 
-                // TODO: showbase
-                // TODO: precision
-                int ret{};
-                if (floatfield == ios_base::fixed)
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%f", v);
-                else if (floatfield == ios_base::scientific && !uppercase)
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%e", v);
-                else if (floatfield == ios_base::scientific)
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%E", v);
-                else if (floatfield == (ios_base::fixed | ios_base::scientific) && !uppercase)
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%a", v);
-                else if (floatfield == (ios_base::fixed | ios_base::scientific))
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%A", v);
-                else if (!uppercase)
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%g", v);
-                else
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%G", v);
+                /**
+                 * Large values in fixed notation do not fit
+                 * into the buffer of the stream, for these we
+                 * allocate a temporary one.
+                 */
+                auto first = base.buffer_;
+                auto last = first + ios_base::buffer_size_;
+                char* tmp{};
+
+                // TODO: showbase, showpoint, showpos
+                to_chars_result res{};
+                while (true)
+                {
+                    if (floatfield == ios_base::fixed)
+                        res = to_chars(first, last, v, chars_format::fixed, precision);
+                    else if (floatfield == ios_base::scientific)
+                        res = to_chars(first, last, v, chars_format::scientific, precision);
+                    else if (floatfield == (ios_base::fixed | ios_base::scientific))
+                        res = put_hex_float_(first, last, v);
+                    else
+                        res = to_chars(first, last, v, chars_format::general, precision);
+
+                    if (res.ec == errc::value_too_large && !tmp)
+                    {
+                        auto size = 330 + static_cast<size_t>(precision > 0 ? precision : 0);
 
-                return put_adjusted_buffer_(it, base, fill, ret);
+                        tmp = new char[size];
+                        first = tmp;
+                        last = tmp + size;
+                    }
+                    else
+                        break;
+                }
+
+                if (uppercase)
+                    to_upper_(first, res.ptr);
+
+                it = put_adjusted_buffer_(it, base, fill, first, res.ptr - first);
+                delete[] tmp;
+
+                return it;
             }
 
-            iter_type do_put(iter_type it, ios_base& base, char_type fill, long double v) const
+            /**
+             * Same as %a, the hexadecimal digits come after
+             * the sign and the 0x prefix.
+             */
+            to_chars_result put_hex_float_(char* first, char* last, double v) const
             {
-                /**
-                 * Note: Long double is not support at the moment in snprintf.
-                 */
-                auto floatfield = (base.flags() & ios_base::floatfield);
-                auto uppercase = (base.flags() & ios_base::uppercase);
+                if (v - v != v - v)
+                    return to_chars(first, last, v, chars_format::hex);
 
-                // TODO: showbase
-                // TODO: precision
-                int ret{};
-                if (floatfield == ios_base::fixed)
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%Lf", v);
-                else if (floatfield == ios_base::scientific && !uppercase)
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%Le", v);
-                else if (floatfield == ios_base::scientific)
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%LE", v);
-                else if (floatfield == (ios_base::fixed | ios_base::scientific) && !uppercase)
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%La", v);
-                else if (floatfield == (ios_base::fixed | ios_base::scientific))
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%LA", v);
-                else if (!uppercase)
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%Lg", v);
-                else
-                    ret = snprintf(base.buffer_, ios_base::buffer_size_, "%LG", v);
+                auto prefix = first + (v < 0 ? 1 : 0);
+                if (last - prefix < 2)
+                    return {last, errc::value_too_large};
 
-                return put_adjusted_buffer_(it, base, fill, ret);
+                auto res = to_chars(prefix + 1, last, v, chars_format::hex);
+                if (res.ec == errc{})
+                {
+                    prefix[0] = '0';
+                    prefix[1] = 'x';
+                    if (v < 0)
+                        first[0] = '-';
+                }
+
+                return res;
             }
 
-            iter_type do_put(iter_type it, ios_base& base, char_type fill, const void* v) const
+            void to_upper_(char* first, char* last) const
             {
-                int ret = snprintf(base.buffer_, ios_base::buffer_size_, "%p", v);
-
-                return put_adjusted_buffer_(it, base, fill, ret);
+                for (; first != last; ++first)
+                {
+                    if ('a' <= *first && *first <= 'z')
+                        *first -= 'a' - 'A';
+                }
             }
 
-        private:
-            iter_type put_adjusted_buffer_(iter_type it, ios_base& base, char_type fill, size_t size) const
+            iter_type put_adjusted_buffer_(iter_type it, ios_base& base, char_type fill,
+                                           const char* buf, size_t size) const
             {
                 auto adjustfield = (base.flags() & ios_base::adjustfield);
 
@@ -261,7 +293,7 @@ namespace std
                 {
                     if (adjustfield == ios_base::left)
                     {
-                        it = put_buffer_(it, base, fill, 0, size);
+                        it = put_buffer_(it, base, buf, size);
                         for (size_t i = 0; i < to_fill; ++i)
                             *it++ = fill;
                     }
@@ -269,7 +301,7 @@ namespace std
                     {
                         for (size_t i = 0; i < to_fill; ++i)
                             *it++ = fill;
-                        it = put_buffer_(it, base, fill, 0, size);
+                        it = put_buffer_(it, base, buf, size);
                     }
                     else if (adjustfield == ios_base::internal)
                     {
@@ -279,28 +311,47 @@ namespace std
                     {
                         for (size_t i = 0; i < to_fill; ++i)
                             *it++ = fill;
-                        it = put_buffer_(it, base, fill, 0, size);
+                        it = put_buffer_(it, base, buf, size);
                     }
                 }
                 else
-                    it = put_buffer_(it, base, fill, 0, size);
+                    it = put_buffer_(it, base, buf, size);
                 base.width(0);
 
                 return it;
             }
 
-            iter_type put_buffer_(iter_type it, ios_base& base, char_type fill, size_t start, size_t size) const
+            iter_type put_buffer_(iter_type it, ios_base& base, const char* buf, size_t size) const
             {
+                /**
+                 * Only the decimal point depends on the locale, so
+                 * narrow output without one can skip the facets.
+                 */
+                if constexpr (is_same_v<char_type, char>)
+                {
+                    size_t i{};
+                    while (i < size && buf[i] != '.')
+                        ++i;
+
+                    if (i == size)
+                    {
+                        for (i = 0; i < size; ++i)
+                            *it++ = buf[i];
+
+                        return it;
+                    }
+                }
+
                 const auto& loc = base.getloc();
                 const auto& ct = use_facet<ctype<char_type>>(loc);
                 const auto& punct = use_facet<numpunct<char_type>>(loc);
 
-                for (size_t i = start; i < size; ++i)
+                for (size_t i = 0; i < size; ++i)
                 {
-                    if (base.buffer_[i] == '.')
+                    if (buf[i] == '.')
                         *it++ = punct.decimal_point();
                     else
-                        *it++ = ct.widen(base.buffer_[i]);
+                        *it++ = ct.widen(buf[i]);
                     // TODO: Should do grouping & thousands_sep, but that's a low
                     //       priority for now.
                 }
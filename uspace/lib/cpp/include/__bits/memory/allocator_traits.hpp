@@ -87,7 +87,7 @@ namespace std
         using is_always_equal                        = typename aux::alloc_get_always_equal<Alloc>::type;
 
         template<class T>
-        using rebind_alloc = typename aux::alloc_get_rebind_alloc<Alloc, T>;
+        using rebind_alloc = typename aux::alloc_get_rebind_alloc<Alloc, T>::type;
 
         template<class T>
         using rebind_traits = allocator_traits<rebind_alloc<T>>;
@@ -218,7 +218,7 @@ namespace std
 
             void deallocate(pointer ptr, size_type n)
             {
-                ::operator delete(ptr, n);
+                ::operator delete(ptr, n * sizeof(value_type));
             }
 
             size_type max_size() const noexcept
@@ -250,6 +250,37 @@ namespace std
     {
         return false;
     }
+
+    namespace aux
+    {
+        /**
+         * Node based containers allocate their nodes
+         * through an allocator rebound to the node type,
+         * these two take care of the allocate + construct
+         * and destroy + deallocate pairs.
+         */
+
+        template<class Alloc, class... Args>
+        typename allocator_traits<Alloc>::pointer
+        create_node(Alloc& alloc, Args&&... args)
+        {
+            using traits = allocator_traits<Alloc>;
+
+            auto node = traits::allocate(alloc, 1);
+            traits::construct(alloc, node, forward<Args>(args)...);
+
+            return node;
+        }
+
+        template<class Alloc>
+        void destroy_node(Alloc& alloc, typename allocator_traits<Alloc>::pointer node)
+        {
+            using traits = allocator_traits<Alloc>;
+
+            traits::destroy(alloc, node);
+            traits::deallocate(alloc, node, 1);
+        }
+    }
 }
 
 #endif
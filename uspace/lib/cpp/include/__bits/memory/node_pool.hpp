@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_MEMORY_NODE_POOL
+#define LIBCPP_BITS_MEMORY_NODE_POOL
+
+#include <__bits/memory/allocator_traits.hpp>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace std::aux
+{
+    /**
+     * Free list of equally sized nodes carved from chunks
+     * that are requested from the global heap in batches.
+     * Released nodes are kept for reuse and the chunks are
+     * returned only when the last allocator that shares
+     * the pool goes away.
+     *
+     * Note: The pool is not synchronized, it is meant to
+     *       be owned by a single container.
+     */
+    class node_pool
+    {
+        public:
+            node_pool() = default;
+
+            node_pool(const node_pool&) = delete;
+            node_pool& operator=(const node_pool&) = delete;
+
+            void* allocate(size_t size);
+            void deallocate(void* ptr, size_t size);
+
+            /**
+             * Nodes of a different size than the one the pool
+             * got bound to by its first allocation are passed
+             * to the global heap.
+             */
+            bool serves(size_t size) const noexcept;
+
+            void reference() noexcept;
+            bool release() noexcept;
+
+            size_t chunk_count() const noexcept;
+            size_t free_count() const noexcept;
+
+            ~node_pool();
+
+        private:
+            struct free_node
+            {
+                free_node* next;
+            };
+
+            struct chunk
+            {
+                chunk* next;
+                size_t nodes;
+            };
+
+            static constexpr size_t min_chunk_nodes_{16};
+            static constexpr size_t max_chunk_nodes_{1024};
+
+            size_t node_size_{};
+            size_t refcount_{1};
+
+            free_node* free_{};
+            size_t free_count_{};
+
+            chunk* chunks_{};
+            size_t chunk_count_{};
+
+            /**
+             * Unused tail of the newest chunk, nodes
+             * are carved from it lazily.
+             */
+            char* tail_{};
+            char* tail_end_{};
+
+            void grow_();
+
+            static size_t chunk_header_size_() noexcept;
+    };
+}
+
+namespace std::__ext
+{
+    /**
+     * Allocator that serves single node allocations from
+     * a node_pool. Default constructed allocators (and
+     * copies of containers) get a new pool, copies and
+     * rebinds of an allocator share it, so a container
+     * that rebinds its allocator for nodes gets its own
+     * free list.
+     */
+    template<class T>
+    class node_pool_allocator
+    {
+        public:
+            using size_type       = size_t;
+            using difference_type = ptrdiff_t;
+            using pointer         = T*;
+            using const_pointer   = const T*;
+            using reference       = T&;
+            using const_reference = const T&;
+            using value_type      = T;
+
+            template<class U>
+            struct rebind
+            {
+                using other = node_pool_allocator<U>;
+            };
+
+            using propagate_on_container_copy_assignment = false_type;
+            using propagate_on_container_move_assignment = true_type;
+            using propagate_on_container_swap            = true_type;
+            using is_always_equal                        = false_type;
+
+            node_pool_allocator()
+                : pool_{new aux::node_pool{}}
+            { /* DUMMY BODY */ }
+
+            node_pool_allocator(const node_pool_allocator& other) noexcept
+                : pool_{other.pool_}
+            {
+                pool_->reference();
+            }
+
+            template<class U>
+            node_pool_allocator(const node_pool_allocator<U>& other) noexcept
+                : pool_{other.pool_}
+            {
+                pool_->reference();
+            }
+
+            node_pool_allocator& operator=(const node_pool_allocator& other) noexcept
+            {
+                other.pool_->reference();
+                release_();
+                pool_ = other.pool_;
+
+                return *this;
+            }
+
+            ~node_pool_allocator()
+            {
+                release_();
+            }
+
+            pointer allocate(size_type n)
+            {
+                if (n == 1 && pool_->serves(sizeof(value_type)) &&
+                    alignof(value_type) <= alignof(max_align_t))
+                {
+                    return static_cast<pointer>(pool_->allocate(sizeof(value_type)));
+                }
+                else
+                    return static_cast<pointer>(::operator new(n * sizeof(value_type)));
+            }
+
+            void deallocate(pointer ptr, size_type n)
+            {
+                if (n == 1 && pool_->serves(sizeof(value_type)) &&
+                    alignof(value_type) <= alignof(max_align_t))
+                {
+                    pool_->deallocate(ptr, sizeof(value_type));
+                }
+                else
+                    ::operator delete(ptr);
+            }
+
+            node_pool_allocator select_on_container_copy_construction() const
+            {
+                return node_pool_allocator{};
+            }
+
+            aux::node_pool* pool() const noexcept
+            {
+                return pool_;
+            }
+
+        private:
+            aux::node_pool* pool_;
+
+            void release_()
+            {
+                if (pool_->release())
+                    delete pool_;
+            }
+
+            template<class U>
+            friend class node_pool_allocator;
+    };
+
+    template<class T1, class T2>
+    bool operator==(const node_pool_allocator<T1>& lhs,
+                    const node_pool_allocator<T2>& rhs) noexcept
+    {
+        return lhs.pool() == rhs.pool();
+    }
+
+    template<class T1, class T2>
+    bool operator!=(const node_pool_allocator<T1>& lhs,
+                    const node_pool_allocator<T2>& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+}
+
+#endif
@@ -29,8 +29,12 @@
 #ifndef LIBCPP_BITS_MEMORY_SHARED_PAYLOAD
 #define LIBCPP_BITS_MEMORY_SHARED_PAYLOAD
 
+#include <__bits/memory/allocator_traits.hpp>
 #include <__bits/refcount_obj.hpp>
+#include <__bits/trycatch.hpp>
 #include <cinttypes>
+#include <new>
+#include <type_traits>
 #include <utility>
 
 namespace std
@@ -67,11 +71,50 @@ namespace std::aux
 
             virtual uint8_t* deleter() const noexcept = 0;
 
-            virtual shared_payload_base* lock() noexcept = 0;
+            /**
+             * Destroys the held object, called when
+             * the last strong reference is released.
+             */
+            virtual void dispose() noexcept = 0;
+
+            /**
+             * Frees the payload itself, called when
+             * the last weak reference is released.
+             */
+            virtual void deallocate() noexcept = 0;
+
+            void destroy() override
+            {
+                dispose();
+
+                // Release the weak reference held by the strong ones.
+                if (this->decrement_weak())
+                    deallocate();
+            }
+
+            shared_payload_base* lock() noexcept
+            {
+                refcount_t rfs = this->refs();
+                while (rfs != 0L)
+                {
+                    if (__atomic_compare_exchange_n(&this->refcount_, &rfs, rfs + 1,
+                                                    true, __ATOMIC_RELAXED,
+                                                    __ATOMIC_RELAXED))
+                    {
+                        return this;
+                    }
+                }
+
+                return nullptr;
+            }
 
             virtual ~shared_payload_base() = default;
     };
 
+    /**
+     * Payload of a shared_ptr that was given a pointer
+     * to an already existing object (and a deleter).
+     */
     template<class T, class D = default_delete<T>>
     class shared_payload: public shared_payload_base<T>
     {
@@ -80,73 +123,112 @@ namespace std::aux
                 : data_{ptr}, deleter_{deleter}
             { /* DUMMY BODY */ }
 
-            template<class... Args>
-            shared_payload(Args&&... args)
-                : data_{new T{forward<Args>(args)...}},
-                  deleter_{}
-            { /* DUMMY BODY */ }
-
-            template<class Alloc, class... Args>
-            shared_payload(allocator_arg_t, Alloc alloc, Args&&... args)
-                : data_{alloc.allocate(1)},
-                  deleter_{}
+            T* get() const noexcept override
             {
-                alloc.construct(data_, forward<Args>(args)...);
+                return data_;
             }
 
-            template<class Alloc, class... Args>
-            shared_payload(D deleter, Alloc alloc, Args&&... args)
-                : data_{alloc.allocate(1)},
-                  deleter_{deleter}
+            uint8_t* deleter() const noexcept override
             {
-                alloc.construct(data_, forward<Args>(args)...);
+                return (uint8_t*)&deleter_;
             }
 
-            void destroy() override
+            void dispose() noexcept override
             {
-                if (this->refs() == 0)
+                if (data_)
                 {
-                    if (data_)
-                    {
-                        deleter_(data_);
-                        data_ = nullptr;
-                    }
-
-                    if (this->weak_refs() == 0)
-                        delete this;
+                    deleter_(data_);
+                    data_ = nullptr;
                 }
             }
 
+            void deallocate() noexcept override
+            {
+                delete this;
+            }
+
+        private:
+            T* data_;
+            D deleter_;
+    };
+
+    /**
+     * Payload created by make_shared and allocate_shared,
+     * the object lives inside of the payload so only one
+     * allocation (done by the given allocator) is needed.
+     */
+    template<class T, class Alloc>
+    class shared_inplace_payload: public shared_payload_base<T>
+    {
+        using object_alloc_t = typename allocator_traits<Alloc>::template rebind_alloc<remove_cv_t<T>>;
+        using object_traits_t = allocator_traits<object_alloc_t>;
+
+        public:
+            using payload_alloc_t = typename allocator_traits<Alloc>::template rebind_alloc<shared_inplace_payload>;
+            using payload_traits_t = allocator_traits<payload_alloc_t>;
+
+            template<class... Args>
+            shared_inplace_payload(const Alloc& alloc, Args&&... args)
+                : alloc_{alloc}
+            {
+                object_traits_t::construct(alloc_, object_(), forward<Args>(args)...);
+            }
+
             T* get() const noexcept override
             {
-                return data_;
+                return const_cast<shared_inplace_payload*>(this)->object_();
             }
 
             uint8_t* deleter() const noexcept override
             {
-                return (uint8_t*)&deleter_;
+                return nullptr;
             }
 
-            shared_payload_base<T>* lock() noexcept override
+            void dispose() noexcept override
             {
-                refcount_t rfs = this->refs();
-                while (rfs != 0L)
-                {
-                    if (__atomic_compare_exchange_n(&this->refcount_, &rfs, rfs + 1,
-                                                    true, __ATOMIC_RELAXED,
-                                                    __ATOMIC_RELAXED))
-                    {
-                        return this;
-                    }
-                }
+                object_traits_t::destroy(alloc_, object_());
+            }
 
-                return nullptr;
+            void deallocate() noexcept override
+            {
+                payload_alloc_t alloc{alloc_};
+
+                this->~shared_inplace_payload();
+                payload_traits_t::deallocate(alloc, this, 1);
             }
 
         private:
-            T* data_;
-            D deleter_;
+            object_alloc_t alloc_;
+            alignas(T) unsigned char storage_[sizeof(T)];
+
+            remove_cv_t<T>* object_() noexcept
+            {
+                return reinterpret_cast<remove_cv_t<T>*>(storage_);
+            }
     };
+
+    template<class T, class Alloc, class... Args>
+    shared_inplace_payload<T, Alloc>* make_inplace_payload(const Alloc& alloc, Args&&... args)
+    {
+        using payload_t = shared_inplace_payload<T, Alloc>;
+        using traits_t = typename payload_t::payload_traits_t;
+
+        typename payload_t::payload_alloc_t payload_alloc{alloc};
+        auto payload = traits_t::allocate(payload_alloc, 1);
+
+        try
+        {
+            ::new(static_cast<void*>(payload)) payload_t{alloc, forward<Args>(args)...};
+        }
+        catch (...)
+        {
+            traits_t::deallocate(payload_alloc, payload, 1);
+
+            throw;
+        }
+
+        return payload;
+    }
 }
 
 #endif
@@ -191,6 +191,9 @@ namespace std
 
             shared_ptr<T> lock() const noexcept
             {
+                if (!payload_)
+                    return shared_ptr<T>{};
+
                 return shared_ptr{aux::payload_tag, payload_->lock()};
             }
 
@@ -212,7 +215,7 @@ namespace std
             void remove_payload_()
             {
                 if (payload_ && payload_->decrement_weak())
-                    payload_->destroy();
+                    payload_->deallocate();
                 payload_ = nullptr;
             }
 
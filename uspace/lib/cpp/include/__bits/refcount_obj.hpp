@@ -32,8 +32,9 @@
 namespace std::aux
 {
     /**
-     * At the moment we do not have atomics, change this
-     * to std::atomic<long> once we do.
+     * The counters are manipulated with the GCC atomic
+     * builtins, so that objects can be shared between
+     * kernel threads and not just fibrils.
      */
     using refcount_t = long;
 
@@ -44,8 +45,14 @@ namespace std::aux
 
             void increment() noexcept;
             void increment_weak() noexcept;
+
+            /**
+             * Both return true if the counter dropped
+             * to zero, i.e. the caller was the last owner.
+             */
             bool decrement() noexcept;
             bool decrement_weak() noexcept;
+
             refcount_t refs() const noexcept;
             refcount_t weak_refs() const noexcept;
             bool expired() const noexcept;
@@ -55,11 +62,12 @@ namespace std::aux
 
         protected:
             /**
-             * We're using a trick where refcount_ > 0
-             * means weak_refcount_ has 1 added to it,
-             * this makes it easier for weak_ptrs that
-             * can't decrement the weak_refcount_ to
-             * zero with shared_ptrs using this object.
+             * All strong references together hold one
+             * weak reference, which is released only after
+             * the held object was destroyed. This way the
+             * last weak reference can free the control
+             * block without racing with the destruction
+             * of the object.
              */
             refcount_t refcount_{1};
             refcount_t weak_refcount_{1};
@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_ALGORITHMS
+#define LIBCPP_BITS_REGEX_ALGORITHMS
+
+#include <__bits/adt/vector.hpp>
+#include <__bits/iterator.hpp>
+#include <__bits/regex/basic_regex.hpp>
+#include <__bits/regex/constants.hpp>
+#include <__bits/regex/match_results.hpp>
+#include <__bits/regex/program.hpp>
+#include <__bits/string/string.hpp>
+#include <__bits/type_traits/type_traits.hpp>
+
+namespace std
+{
+    namespace aux
+    {
+        /**
+         * Glue between the matchers, which work on
+         * contiguous arrays of characters and report
+         * offsets, and match_results.
+         */
+        struct regex_access
+        {
+            template<class BidirectionalIterator, class Allocator,
+                     class charT, class traits>
+            static bool run(BidirectionalIterator first, BidirectionalIterator last,
+                            match_results<BidirectionalIterator, Allocator>* m,
+                            const basic_regex<charT, traits>& e,
+                            regex_constants::match_flag_type flags, bool full,
+                            BidirectionalIterator base)
+            {
+                using namespace regex_constants;
+
+                auto state = e.__state();
+                if (!state)
+                {
+                    if (m)
+                        clear_(*m);
+
+                    return false;
+                }
+
+                regex_input<charT> in{};
+                in.flags = flags;
+
+                vector<charT> buffer{};
+                if constexpr (is_pointer_v<BidirectionalIterator> &&
+                              is_same_v<remove_cv_t<remove_pointer_t<BidirectionalIterator>>, charT>)
+                {
+                    in.first = first;
+                    in.last = last;
+                }
+                else
+                {
+                    /**
+                     * Iterators that are not pointers do not
+                     * guarantee contiguous storage, so we match
+                     * against a copy.
+                     */
+                    for (auto it = first; it != last; ++it)
+                        buffer.push_back(*it);
+                    in.first = buffer.data();
+                    in.last = buffer.data() + buffer.size();
+                }
+
+                if ((flags & match_prev_avail) != match_default)
+                {
+                    in.has_prev = true;
+                    in.prev = *prev(first);
+                }
+
+                vector<size_t> caps{};
+                if (m)
+                    caps.resize(2 * state->prog.group_count, regex_npos);
+
+                bool res = state->exec(in, full, m ? caps.data() : nullptr);
+                if (!m)
+                    return res;
+
+                if (!res)
+                {
+                    clear_(*m);
+
+                    return false;
+                }
+
+                fill_(*m, first, last, caps, e.mark_count() + 1, base);
+
+                return true;
+            }
+
+            /**
+             * Adjusts a result of a search that did not start
+             * at the beginning of the sequence, as regex_iterator
+             * requires.
+             */
+            template<class BidirectionalIterator, class Allocator>
+            static void rebase(match_results<BidirectionalIterator, Allocator>& m,
+                               BidirectionalIterator prefix_first,
+                               BidirectionalIterator base)
+            {
+                m.prefix_.first = prefix_first;
+                m.prefix_.matched = m.prefix_.first != m.prefix_.second;
+                m.base_ = base;
+            }
+
+            private:
+                template<class BidirectionalIterator, class Allocator>
+                static void clear_(match_results<BidirectionalIterator, Allocator>& m)
+                {
+                    m.subs_.clear();
+                    m.ready_ = true;
+                }
+
+                template<class BidirectionalIterator, class Allocator>
+                static void fill_(match_results<BidirectionalIterator, Allocator>& m,
+                                  BidirectionalIterator first, BidirectionalIterator last,
+                                  const vector<size_t>& caps, size_t count,
+                                  BidirectionalIterator base)
+                {
+                    m.subs_.resize(count);
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        auto& sub = m.subs_[i];
+                        if (2 * i + 1 < caps.size() && caps[2 * i] != regex_npos &&
+                            caps[2 * i + 1] != regex_npos)
+                        {
+                            sub.first = next(first, caps[2 * i]);
+                            sub.second = next(first, caps[2 * i + 1]);
+                            sub.matched = true;
+                        }
+                        else
+                        {
+                            sub.first = last;
+                            sub.second = last;
+                            sub.matched = false;
+                        }
+                    }
+
+                    m.prefix_.first = first;
+                    m.prefix_.second = m.subs_[0].first;
+                    m.prefix_.matched = m.prefix_.first != m.prefix_.second;
+
+                    m.suffix_.first = m.subs_[0].second;
+                    m.suffix_.second = last;
+                    m.suffix_.matched = m.suffix_.first != m.suffix_.second;
+
+                    m.unmatched_.first = last;
+                    m.unmatched_.second = last;
+                    m.unmatched_.matched = false;
+
+                    m.base_ = base;
+                    m.ready_ = true;
+                }
+        };
+    }
+
+    /**
+     * 28.11.2, function template regex_match:
+     */
+
+    template<class BidirectionalIterator, class Allocator, class charT, class traits>
+    bool regex_match(BidirectionalIterator first, BidirectionalIterator last,
+                     match_results<BidirectionalIterator, Allocator>& m,
+                     const basic_regex<charT, traits>& e,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return aux::regex_access::run(first, last, &m, e, flags, true, first);
+    }
+
+    template<class BidirectionalIterator, class charT, class traits>
+    bool regex_match(BidirectionalIterator first, BidirectionalIterator last,
+                     const basic_regex<charT, traits>& e,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        match_results<BidirectionalIterator>* m{};
+
+        return aux::regex_access::run(first, last, m, e, flags, true, first);
+    }
+
+    template<class charT, class Allocator, class traits>
+    bool regex_match(const charT* str, match_results<const charT*, Allocator>& m,
+                     const basic_regex<charT, traits>& e,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_match(str, str + char_traits<charT>::length(str), m, e, flags);
+    }
+
+    template<class ST, class SA, class Allocator, class charT, class traits>
+    bool regex_match(const basic_string<charT, ST, SA>& s,
+                     match_results<typename basic_string<charT, ST, SA>::const_iterator, Allocator>& m,
+                     const basic_regex<charT, traits>& e,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_match(s.begin(), s.end(), m, e, flags);
+    }
+
+    template<class ST, class SA, class Allocator, class charT, class traits>
+    bool regex_match(const basic_string<charT, ST, SA>&&,
+                     match_results<typename basic_string<charT, ST, SA>::const_iterator, Allocator>&,
+                     const basic_regex<charT, traits>&,
+                     regex_constants::match_flag_type = regex_constants::match_default) = delete;
+
+    template<class charT, class traits>
+    bool regex_match(const charT* str, const basic_regex<charT, traits>& e,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_match(str, str + char_traits<charT>::length(str), e, flags);
+    }
+
+    template<class ST, class SA, class charT, class traits>
+    bool regex_match(const basic_string<charT, ST, SA>& s,
+                     const basic_regex<charT, traits>& e,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_match(s.begin(), s.end(), e, flags);
+    }
+
+    /**
+     * 28.11.3, function template regex_search:
+     */
+
+    template<class BidirectionalIterator, class Allocator, class charT, class traits>
+    bool regex_search(BidirectionalIterator first, BidirectionalIterator last,
+                      match_results<BidirectionalIterator, Allocator>& m,
+                      const basic_regex<charT, traits>& e,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return aux::regex_access::run(first, last, &m, e, flags, false, first);
+    }
+
+    template<class BidirectionalIterator, class charT, class traits>
+    bool regex_search(BidirectionalIterator first, BidirectionalIterator last,
+                      const basic_regex<charT, traits>& e,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        match_results<BidirectionalIterator>* m{};
+
+        return aux::regex_access::run(first, last, m, e, flags, false, first);
+    }
+
+    template<class charT, class Allocator, class traits>
+    bool regex_search(const charT* str, match_results<const charT*, Allocator>& m,
+                      const basic_regex<charT, traits>& e,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_search(str, str + char_traits<charT>::length(str), m, e, flags);
+    }
+
+    template<class charT, class traits>
+    bool regex_search(const charT* str, const basic_regex<charT, traits>& e,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_search(str, str + char_traits<charT>::length(str), e, flags);
+    }
+
+    template<class ST, class SA, class charT, class traits>
+    bool regex_search(const basic_string<charT, ST, SA>& s,
+                      const basic_regex<charT, traits>& e,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_search(s.begin(), s.end(), e, flags);
+    }
+
+    template<class ST, class SA, class Allocator, class charT, class traits>
+    bool regex_search(const basic_string<charT, ST, SA>& s,
+                      match_results<typename basic_string<charT, ST, SA>::const_iterator, Allocator>& m,
+                      const basic_regex<charT, traits>& e,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_search(s.begin(), s.end(), m, e, flags);
+    }
+
+    template<class ST, class SA, class Allocator, class charT, class traits>
+    bool regex_search(const basic_string<charT, ST, SA>&&,
+                      match_results<typename basic_string<charT, ST, SA>::const_iterator, Allocator>&,
+                      const basic_regex<charT, traits>&,
+                      regex_constants::match_flag_type = regex_constants::match_default) = delete;
+}
+
+#endif
@@ -0,0 +1,359 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_BACKTRACK
+#define LIBCPP_BITS_REGEX_BACKTRACK
+
+#include <__bits/adt/vector.hpp>
+#include <__bits/regex/constants.hpp>
+#include <__bits/regex/program.hpp>
+
+namespace std::aux
+{
+    /**
+     * Depth first execution of a program, needed only for
+     * backreferences and lookaheads. The alternatives that
+     * were not taken are kept on an explicit stack together
+     * with the old values of the registers, so the recursion
+     * depth is bounded by the nesting of lookaheads.
+     */
+    template<class charT, class Traits>
+    class regex_backtracker
+    {
+        public:
+            using program_type = regex_program<charT, Traits>;
+
+            regex_backtracker(const program_type& prog, const regex_input<charT>& in)
+                : prog_{prog}, in_{in}, caps_(2 * prog.group_count, regex_npos),
+                  best_(2 * prog.group_count, regex_npos),
+                  loops_(prog.loop_count, regex_npos), stack_{},
+                  steps_{}, full_{}, matched_{}, aborted_{}
+            { /* DUMMY BODY */ }
+
+            bool run(bool full, bool anchored, size_t* caps)
+            {
+                full_ = full;
+                matched_ = false;
+
+                for (auto pos = in_.first; ; ++pos)
+                {
+                    pos = skip_(pos, anchored);
+
+                    for (auto& c: caps_)
+                        c = regex_npos;
+                    for (auto& l: loops_)
+                        l = regex_npos;
+                    stack_.clear();
+
+                    if (run_(prog_.start, pos, 0) || matched_)
+                    {
+                        if (matched_)
+                            caps_ = best_;
+                        for (size_t i = 0; i < caps_.size(); ++i)
+                            caps[i] = caps_[i];
+
+                        return true;
+                    }
+
+                    if (aborted_ || anchored || pos == in_.last)
+                        return false;
+                }
+            }
+
+        private:
+            enum class frame_kind
+            {
+                branch, restore_cap, restore_loop
+            };
+
+            struct frame
+            {
+                frame_kind kind;
+                size_t pc;
+                const charT* pos;
+                size_t slot;
+                size_t old;
+            };
+
+            /**
+             * Bound on the work done by one execution,
+             * after which we give up with error_complexity.
+             */
+            static constexpr size_t max_steps_{size_t{1} << 26};
+
+            const program_type& prog_;
+            const regex_input<charT>& in_;
+            vector<size_t> caps_;
+            vector<size_t> best_;
+            vector<size_t> loops_;
+            vector<frame> stack_;
+            size_t steps_;
+            bool full_;
+            bool matched_;
+            bool aborted_;
+
+            const charT* skip_(const charT* pos, bool anchored) const
+            {
+                if (anchored || prog_.first_any)
+                    return pos;
+
+                while (pos != in_.last)
+                {
+                    auto idx = regex_index(*pos);
+                    if (idx >= 256 || prog_.first_set.test(idx))
+                        break;
+                    ++pos;
+                }
+
+                return pos;
+            }
+
+            size_t offset_(const charT* pos) const
+            {
+                return static_cast<size_t>(pos - in_.first);
+            }
+
+            bool equal_(charT lhs, charT rhs) const
+            {
+                if (prog_.icase)
+                    return prog_.traits.translate_nocase(lhs) == prog_.traits.translate_nocase(rhs);
+                else
+                    return prog_.traits.translate(lhs) == prog_.traits.translate(rhs);
+            }
+
+            /**
+             * Runs from pc until a match (or the end of a lookahead)
+             * is reached or all alternatives above base fail.
+             */
+            bool run_(size_t pc, const charT* pos, size_t base)
+            {
+                using namespace regex_constants;
+
+                while (true)
+                {
+                    if (++steps_ > max_steps_)
+                    {
+                        aborted_ = true;
+                        throw regex_error{error_complexity};
+
+                        return false;
+                    }
+
+                    const auto& inst = prog_.insts[pc];
+                    bool ok{true};
+
+                    switch (inst.op)
+                    {
+                        case regex_op::chr:
+                        case regex_op::any:
+                        case regex_op::cls:
+                            ok = pos != in_.last && prog_.consumes(inst, *pos);
+                            if (ok)
+                            {
+                                ++pos;
+                                ++pc;
+                            }
+                            break;
+                        case regex_op::split:
+                            stack_.push_back(frame{frame_kind::branch, inst.y, pos, 0, 0});
+                            pc = inst.x;
+                            break;
+                        case regex_op::jmp:
+                            pc = inst.x;
+                            break;
+                        case regex_op::save:
+                            stack_.push_back(frame{
+                                frame_kind::restore_cap, 0, nullptr, inst.x, caps_[inst.x]
+                            });
+                            caps_[inst.x] = offset_(pos);
+                            ++pc;
+                            break;
+                        case regex_op::clear:
+                            for (auto slot = inst.x; slot < inst.y; ++slot)
+                            {
+                                if (caps_[slot] == regex_npos)
+                                    continue;
+
+                                stack_.push_back(frame{
+                                    frame_kind::restore_cap, 0, nullptr, slot, caps_[slot]
+                                });
+                                caps_[slot] = regex_npos;
+                            }
+                            ++pc;
+                            break;
+                        case regex_op::match:
+                            if (full_ && pos != in_.last)
+                                ok = false;
+                            else if (in_.flag(match_not_null) && offset_(pos) == caps_[0])
+                                ok = false;
+                            else if (!prog_.longest)
+                                return true;
+                            else
+                            {
+                                /**
+                                 * POSIX wants the longest match, so
+                                 * we remember this one and go on.
+                                 */
+                                if (!matched_ || best_[1] < caps_[1])
+                                    best_ = caps_;
+                                matched_ = true;
+                                ok = false;
+                            }
+                            break;
+                        case regex_op::look_end:
+                            return true;
+                        case regex_op::bol:
+                        case regex_op::eol:
+                        case regex_op::word:
+                            ok = regex_assert(prog_, inst, in_, pos);
+                            ++pc;
+                            break;
+                        case regex_op::backref:
+                            ok = backref_(inst.x, pos);
+                            ++pc;
+                            break;
+                        case regex_op::look:
+                            ok = lookahead_(inst, pc, pos);
+                            break;
+                        case regex_op::loop_mark:
+                            stack_.push_back(frame{
+                                frame_kind::restore_loop, 0, nullptr, inst.x, loops_[inst.x]
+                            });
+                            loops_[inst.x] = offset_(pos);
+                            ++pc;
+                            break;
+                        case regex_op::loop_check:
+                            ok = loops_[inst.x] != offset_(pos);
+                            ++pc;
+                            break;
+                    }
+
+                    if (aborted_)
+                        return false;
+                    if (ok)
+                        continue;
+
+                    if (!backtrack_(pc, pos, base))
+                        return false;
+                }
+            }
+
+            bool backtrack_(size_t& pc, const charT*& pos, size_t base)
+            {
+                while (stack_.size() > base)
+                {
+                    auto f = stack_.back();
+                    stack_.pop_back();
+
+                    switch (f.kind)
+                    {
+                        case frame_kind::restore_cap:
+                            caps_[f.slot] = f.old;
+                            break;
+                        case frame_kind::restore_loop:
+                            loops_[f.slot] = f.old;
+                            break;
+                        case frame_kind::branch:
+                            pc = f.pc;
+                            pos = f.pos;
+                            return true;
+                    }
+                }
+
+                return false;
+            }
+
+            bool backref_(size_t group, const charT*& pos) const
+            {
+                auto begin = caps_[2 * group];
+                auto end = caps_[2 * group + 1];
+
+                /**
+                 * In ECMAScript, a reference to a group
+                 * that did not participate matches empty.
+                 */
+                if (begin == regex_npos || end == regex_npos)
+                    return !prog_.longest;
+
+                auto len = end - begin;
+                if (static_cast<size_t>(in_.last - pos) < len)
+                    return false;
+
+                for (size_t i = 0; i < len; ++i)
+                {
+                    if (!equal_(in_.first[begin + i], pos[i]))
+                        return false;
+                }
+                pos += len;
+
+                return true;
+            }
+
+            /**
+             * Lookaheads are atomic, once their body matches
+             * its alternatives are dropped. The captures set
+             * by a positive lookahead are kept, so we have to
+             * be able to restore them when backtracking.
+             */
+            bool lookahead_(const regex_inst<charT>& inst, size_t& pc, const charT* pos)
+            {
+                auto saved = caps_;
+                auto base = stack_.size();
+
+                bool ok = run_(pc + 1, pos, base);
+                while (stack_.size() > base)
+                    stack_.pop_back();
+                if (aborted_)
+                    return false;
+
+                if (inst.flag)
+                {
+                    caps_ = saved;
+                    ok = !ok;
+                }
+                else if (ok)
+                {
+                    for (size_t i = 0; i < caps_.size(); ++i)
+                    {
+                        if (caps_[i] != saved[i])
+                        {
+                            stack_.push_back(frame{
+                                frame_kind::restore_cap, 0, nullptr, i, saved[i]
+                            });
+                        }
+                    }
+                }
+
+                pc = inst.x;
+
+                return ok;
+            }
+    };
+}
+
+#endif
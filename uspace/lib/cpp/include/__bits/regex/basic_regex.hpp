@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_BASIC_REGEX
+#define LIBCPP_BITS_REGEX_BASIC_REGEX
+
+#include <__bits/regex/compiler.hpp>
+#include <__bits/regex/constants.hpp>
+#include <__bits/regex/exec.hpp>
+#include <__bits/regex/regex_traits.hpp>
+#include <__bits/string/string.hpp>
+#include <initializer_list>
+#include <memory>
+
+namespace std
+{
+    /**
+     * 28.8, class template basic_regex:
+     */
+
+    template<class charT, class traits = regex_traits<charT>>
+    class basic_regex
+    {
+        public:
+            using value_type  = charT;
+            using traits_type = traits;
+            using string_type = typename traits::string_type;
+            using flag_type   = regex_constants::syntax_option_type;
+            using locale_type = typename traits::locale_type;
+
+            /**
+             * 28.8.1, constants:
+             */
+
+            static constexpr flag_type icase      = regex_constants::icase;
+            static constexpr flag_type nosubs     = regex_constants::nosubs;
+            static constexpr flag_type optimize   = regex_constants::optimize;
+            static constexpr flag_type collate    = regex_constants::collate;
+            static constexpr flag_type ECMAScript = regex_constants::ECMAScript;
+            static constexpr flag_type basic      = regex_constants::basic;
+            static constexpr flag_type extended   = regex_constants::extended;
+            static constexpr flag_type awk        = regex_constants::awk;
+            static constexpr flag_type grep       = regex_constants::grep;
+            static constexpr flag_type egrep      = regex_constants::egrep;
+            static constexpr flag_type multiline  = regex_constants::multiline;
+
+            /**
+             * 28.8.2, construct/copy/destroy:
+             */
+
+            basic_regex()
+                : state_{}, flags_{ECMAScript}, traits_{}
+            { /* DUMMY BODY */ }
+
+            explicit basic_regex(const charT* p, flag_type f = ECMAScript)
+                : basic_regex{}
+            {
+                assign(p, f);
+            }
+
+            basic_regex(const charT* p, size_t len, flag_type f = ECMAScript)
+                : basic_regex{}
+            {
+                assign(p, len, f);
+            }
+
+            basic_regex(const basic_regex&) = default;
+
+            basic_regex(basic_regex&& other) noexcept
+                : state_{move(other.state_)}, flags_{other.flags_},
+                  traits_{move(other.traits_)}
+            { /* DUMMY BODY */ }
+
+            template<class ST, class SA>
+            explicit basic_regex(const basic_string<charT, ST, SA>& p,
+                                 flag_type f = ECMAScript)
+                : basic_regex{}
+            {
+                assign(p, f);
+            }
+
+            template<class ForwardIterator>
+            basic_regex(ForwardIterator first, ForwardIterator last,
+                        flag_type f = ECMAScript)
+                : basic_regex{}
+            {
+                assign(first, last, f);
+            }
+
+            basic_regex(initializer_list<charT> init, flag_type f = ECMAScript)
+                : basic_regex{}
+            {
+                assign(init, f);
+            }
+
+            ~basic_regex() = default;
+
+            basic_regex& operator=(const basic_regex&) = default;
+
+            basic_regex& operator=(basic_regex&& other) noexcept
+            {
+                return assign(move(other));
+            }
+
+            basic_regex& operator=(const charT* p)
+            {
+                return assign(p);
+            }
+
+            basic_regex& operator=(initializer_list<charT> init)
+            {
+                return assign(init);
+            }
+
+            template<class ST, class SA>
+            basic_regex& operator=(const basic_string<charT, ST, SA>& p)
+            {
+                return assign(p);
+            }
+
+            /**
+             * 28.8.3, assign:
+             */
+
+            basic_regex& assign(const basic_regex& other)
+            {
+                return *this = other;
+            }
+
+            basic_regex& assign(basic_regex&& other) noexcept
+            {
+                state_ = move(other.state_);
+                flags_ = other.flags_;
+                traits_ = move(other.traits_);
+
+                return *this;
+            }
+
+            basic_regex& assign(const charT* p, flag_type f = ECMAScript)
+            {
+                return assign_(p, p + char_traits<charT>::length(p), f);
+            }
+
+            basic_regex& assign(const charT* p, size_t len, flag_type f = ECMAScript)
+            {
+                return assign_(p, p + len, f);
+            }
+
+            template<class ST, class SA>
+            basic_regex& assign(const basic_string<charT, ST, SA>& p,
+                                flag_type f = ECMAScript)
+            {
+                return assign_(p.data(), p.data() + p.size(), f);
+            }
+
+            template<class InputIterator>
+            basic_regex& assign(InputIterator first, InputIterator last,
+                                flag_type f = ECMAScript)
+            {
+                basic_string<charT> p(first, last);
+
+                return assign_(p.data(), p.data() + p.size(), f);
+            }
+
+            basic_regex& assign(initializer_list<charT> init, flag_type f = ECMAScript)
+            {
+                return assign_(init.begin(), init.end(), f);
+            }
+
+            /**
+             * 28.8.4, const operations:
+             */
+
+            unsigned mark_count() const
+            {
+                if (state_)
+                    return static_cast<unsigned>(state_->mark_count);
+                else
+                    return 0U;
+            }
+
+            flag_type flags() const
+            {
+                return flags_;
+            }
+
+            /**
+             * 28.8.5, locale:
+             */
+
+            locale_type imbue(locale_type loc)
+            {
+                state_.reset();
+
+                return traits_.imbue(loc);
+            }
+
+            locale_type getloc() const
+            {
+                return traits_.getloc();
+            }
+
+            /**
+             * 28.8.6, swap:
+             */
+
+            void swap(basic_regex& other)
+            {
+                std::swap(state_, other.state_);
+                std::swap(flags_, other.flags_);
+                std::swap(traits_, other.traits_);
+            }
+
+            /**
+             * Extension: The compiled program, null if this
+             * regex does not hold a valid expression.
+             */
+            const aux::regex_state<charT, traits>* __state() const
+            {
+                return state_.get();
+            }
+
+        private:
+            using state_type = aux::regex_state<charT, traits>;
+
+            /**
+             * The compiled program is immutable, so copies
+             * of a regex share it.
+             */
+            shared_ptr<state_type> state_;
+            flag_type flags_;
+            traits traits_;
+
+            basic_regex& assign_(const charT* first, const charT* last, flag_type f)
+            {
+                auto state = make_shared<state_type>();
+                aux::regex_compiler<charT, traits> comp{traits_, f};
+
+                flags_ = f;
+                if (!comp.compile(first, last, state->prog))
+                {
+                    state_.reset();
+                    throw regex_error{comp.error()};
+
+                    return *this;
+                }
+
+                if ((f & nosubs) != flag_type{})
+                    state->mark_count = 0;
+                else
+                    state->mark_count = comp.mark_count();
+                state_ = move(state);
+
+                return *this;
+            }
+    };
+
+    using regex  = basic_regex<char>;
+    using wregex = basic_regex<wchar_t>;
+
+    template<class charT, class traits>
+    void swap(basic_regex<charT, traits>& lhs, basic_regex<charT, traits>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+}
+
+#endif
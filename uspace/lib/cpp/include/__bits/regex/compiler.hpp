@@ -0,0 +1,1362 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_COMPILER
+#define LIBCPP_BITS_REGEX_COMPILER
+
+#include <__bits/adt/vector.hpp>
+#include <__bits/regex/constants.hpp>
+#include <__bits/regex/program.hpp>
+#include <cstdint>
+
+namespace std::aux
+{
+    /**
+     * Parses a pattern into a syntax tree and generates
+     * a program for it. Errors are reported through the
+     * return value of compile() and error(), the caller
+     * is the one who throws.
+     */
+    template<class charT, class Traits>
+    class regex_compiler
+    {
+        public:
+            using program_type = regex_program<charT, Traits>;
+            using flag_type    = regex_constants::syntax_option_type;
+            using error_type   = regex_constants::error_type;
+
+            regex_compiler(const Traits& traits, flag_type flags)
+                : traits_{traits}, flags_{flags}, grammar_{}, nodes_{},
+                  pos_{}, end_{}, groups_{}, loops_{}, loop_depth_{}, depth_{},
+                  error_{}, failed_{false}, has_backrefs_{false},
+                  max_backref_{}, prog_{}
+            {
+                using namespace regex_constants;
+
+                if ((flags & basic) != syntax_option_type{})
+                    grammar_ = grammar::basic;
+                else if ((flags & grep) != syntax_option_type{})
+                    grammar_ = grammar::grep;
+                else if ((flags & extended) != syntax_option_type{})
+                    grammar_ = grammar::extended;
+                else if ((flags & egrep) != syntax_option_type{})
+                    grammar_ = grammar::egrep;
+                else if ((flags & awk) != syntax_option_type{})
+                    grammar_ = grammar::awk;
+                else
+                    grammar_ = grammar::ecma;
+            }
+
+            bool compile(const charT* first, const charT* last, program_type& prog)
+            {
+                pos_ = first;
+                end_ = last;
+                prog_ = &prog;
+
+                prog.traits = traits_;
+                prog.insts.clear();
+                prog.classes.clear();
+                prog.loop_depths.clear();
+                prog.icase = option_(regex_constants::icase);
+                prog.multiline = option_(regex_constants::multiline);
+                prog.longest = grammar_ != grammar::ecma;
+
+                auto root = parse_disjunction_();
+                if (failed_)
+                    return false;
+                if (pos_ != end_)
+                    return fail_(regex_constants::error_paren);
+                if (max_backref_ > groups_)
+                    return fail_(regex_constants::error_backref);
+
+                emit_program_(root);
+                if (failed_)
+                    return false;
+
+                analyze_();
+
+                return true;
+            }
+
+            error_type error() const
+            {
+                return error_;
+            }
+
+            size_t mark_count() const
+            {
+                return groups_;
+            }
+
+        private:
+            enum class grammar
+            {
+                ecma, basic, extended, awk, grep, egrep
+            };
+
+            enum class node_kind
+            {
+                empty, chr, any, cls, concat, alt, group,
+                repeat, bol, eol, word, backref, look
+            };
+
+            struct node
+            {
+                node_kind kind;
+                bool flag;
+                charT c;
+                size_t idx;
+                size_t min;
+                size_t max;
+                bool greedy;
+                vector<size_t> kids;
+            };
+
+            /**
+             * Limits that keep both the compiler and
+             * the matchers within sane resources.
+             */
+            static constexpr size_t max_depth_{256};
+            static constexpr size_t max_insts_{1 << 16};
+            static constexpr size_t max_count_{1000};
+
+            Traits traits_;
+            flag_type flags_;
+            grammar grammar_;
+            vector<node> nodes_;
+            const charT* pos_;
+            const charT* end_;
+            size_t groups_;
+            size_t loops_;
+            size_t loop_depth_;
+            size_t depth_;
+            error_type error_;
+            bool failed_;
+            bool has_backrefs_;
+            size_t max_backref_;
+            program_type* prog_;
+
+            bool option_(flag_type opt) const
+            {
+                return (flags_ & opt) != flag_type{};
+            }
+
+            bool posix_() const
+            {
+                return grammar_ != grammar::ecma;
+            }
+
+            bool basic_() const
+            {
+                return grammar_ == grammar::basic || grammar_ == grammar::grep;
+            }
+
+            bool fail_(error_type err)
+            {
+                if (!failed_)
+                {
+                    failed_ = true;
+                    error_ = err;
+                }
+
+                return false;
+            }
+
+            size_t fail_node_(error_type err)
+            {
+                fail_(err);
+
+                return regex_npos;
+            }
+
+            bool at_end_() const
+            {
+                return pos_ == end_;
+            }
+
+            bool peek_(char c) const
+            {
+                return pos_ != end_ && *pos_ == charT(c);
+            }
+
+            bool peek_(char c1, char c2) const
+            {
+                return end_ - pos_ >= 2 && pos_[0] == charT(c1) && pos_[1] == charT(c2);
+            }
+
+            size_t add_node_(node_kind kind)
+            {
+                nodes_.push_back(node{kind, false, charT{}, 0, 0, 0, true, {}});
+
+                return nodes_.size() - 1;
+            }
+
+            size_t add_char_(charT c)
+            {
+                auto res = add_node_(node_kind::chr);
+                nodes_[res].c = c;
+
+                return res;
+            }
+
+            size_t add_class_()
+            {
+                regex_class<charT, Traits> cls{};
+                cls.icase = option_(regex_constants::icase);
+                prog_->classes.push_back(cls);
+
+                auto res = add_node_(node_kind::cls);
+                nodes_[res].idx = prog_->classes.size() - 1;
+
+                return res;
+            }
+
+            /**
+             * Grammar, in the terms of ECMA-262 with
+             * the POSIX variants handled inline:
+             *
+             *   disjunction: alternative ('|' alternative)*
+             *   alternative: term*
+             *   term:        assertion | atom quantifier?
+             */
+
+            bool at_alternation_() const
+            {
+                if (grammar_ == grammar::grep || grammar_ == grammar::egrep)
+                {
+                    if (peek_('\n'))
+                        return true;
+                }
+
+                if (basic_())
+                    return false;
+                else
+                    return peek_('|');
+            }
+
+            bool at_group_end_() const
+            {
+                if (basic_())
+                    return peek_('\\', ')');
+                else
+                    return peek_(')');
+            }
+
+            size_t parse_disjunction_()
+            {
+                if (++depth_ > max_depth_)
+                    return fail_node_(regex_constants::error_stack);
+
+                vector<size_t> alts{};
+                alts.push_back(parse_alternative_());
+
+                while (!failed_ && at_alternation_())
+                {
+                    ++pos_;
+                    alts.push_back(parse_alternative_());
+                }
+                --depth_;
+
+                if (failed_)
+                    return regex_npos;
+                if (alts.size() == 1)
+                    return alts.front();
+
+                auto res = add_node_(node_kind::alt);
+                nodes_[res].kids = move(alts);
+
+                return res;
+            }
+
+            size_t parse_alternative_()
+            {
+                vector<size_t> terms{};
+                auto begin = pos_;
+
+                while (!at_end_() && !at_alternation_() && !at_group_end_())
+                {
+                    auto term = parse_term_(pos_ == begin);
+                    if (failed_)
+                        return regex_npos;
+
+                    terms.push_back(term);
+                }
+
+                if (terms.empty())
+                    return add_node_(node_kind::empty);
+                if (terms.size() == 1)
+                    return terms.front();
+
+                auto res = add_node_(node_kind::concat);
+                nodes_[res].kids = move(terms);
+
+                return res;
+            }
+
+            size_t parse_term_(bool first)
+            {
+                if (peek_('^'))
+                {
+                    /**
+                     * In basic regular expressions, the anchors
+                     * only have a special meaning at the start
+                     * or end of the expression or a group.
+                     */
+                    if (!basic_() || first)
+                    {
+                        ++pos_;
+                        auto res = add_node_(node_kind::bol);
+                        nodes_[res].flag = option_(regex_constants::multiline);
+
+                        return quantified_assertion_(res);
+                    }
+                }
+
+                if (peek_('$'))
+                {
+                    if (!basic_() || pos_ + 1 == end_ || (end_ - pos_ >= 3 && pos_[1] == charT('\\') &&
+                        pos_[2] == charT(')')))
+                    {
+                        ++pos_;
+                        auto res = add_node_(node_kind::eol);
+                        nodes_[res].flag = option_(regex_constants::multiline);
+
+                        return quantified_assertion_(res);
+                    }
+                }
+
+                if (grammar_ == grammar::ecma)
+                {
+                    if (peek_('\\', 'b') || peek_('\\', 'B'))
+                    {
+                        auto res = add_node_(node_kind::word);
+                        nodes_[res].flag = pos_[1] == charT('B');
+                        pos_ += 2;
+
+                        return quantified_assertion_(res);
+                    }
+
+                    if (end_ - pos_ >= 3 && pos_[0] == charT('(') && pos_[1] == charT('?') &&
+                        (pos_[2] == charT('=') || pos_[2] == charT('!')))
+                    {
+                        bool negative = pos_[2] == charT('!');
+                        pos_ += 3;
+
+                        auto body = parse_disjunction_();
+                        if (failed_)
+                            return regex_npos;
+                        if (!peek_(')'))
+                            return fail_node_(regex_constants::error_paren);
+                        ++pos_;
+
+                        auto res = add_node_(node_kind::look);
+                        nodes_[res].flag = negative;
+                        nodes_[res].kids.push_back(body);
+
+                        return quantified_assertion_(res);
+                    }
+                }
+
+                auto atom = parse_atom_(first);
+                if (failed_)
+                    return regex_npos;
+
+                return parse_quantifiers_(atom);
+            }
+
+            size_t quantified_assertion_(size_t res)
+            {
+                if (grammar_ == grammar::ecma && at_quantifier_())
+                    return fail_node_(regex_constants::error_badrepeat);
+
+                return res;
+            }
+
+            bool at_quantifier_() const
+            {
+                if (peek_('*'))
+                    return true;
+
+                if (basic_())
+                    return peek_('\\', '{');
+                else
+                    return peek_('+') || peek_('?') || peek_('{');
+            }
+
+            size_t parse_quantifiers_(size_t atom)
+            {
+                while (!failed_ && at_quantifier_())
+                {
+                    size_t min{};
+                    size_t max{regex_npos};
+
+                    if (peek_('*'))
+                        ++pos_;
+                    else if (peek_('+'))
+                    {
+                        ++pos_;
+                        min = 1;
+                    }
+                    else if (peek_('?'))
+                    {
+                        ++pos_;
+                        max = 1;
+                    }
+                    else if (!parse_interval_(min, max))
+                        return regex_npos;
+
+                    bool greedy{true};
+                    if (grammar_ == grammar::ecma && peek_('?'))
+                    {
+                        ++pos_;
+                        greedy = false;
+                    }
+
+                    auto res = add_node_(node_kind::repeat);
+                    nodes_[res].min = min;
+                    nodes_[res].max = max;
+                    nodes_[res].greedy = greedy;
+                    nodes_[res].kids.push_back(atom);
+                    atom = res;
+
+                    if (grammar_ == grammar::ecma && at_quantifier_())
+                        return fail_node_(regex_constants::error_badrepeat);
+                }
+
+                return atom;
+            }
+
+            bool parse_number_(size_t& res)
+            {
+                if (at_end_() || traits_.value(*pos_, 10) < 0)
+                    return false;
+
+                res = 0;
+                while (!at_end_() && traits_.value(*pos_, 10) >= 0)
+                {
+                    res = res * 10 + traits_.value(*pos_, 10);
+                    if (res > max_count_)
+                        res = max_count_ + 1;
+                    ++pos_;
+                }
+
+                return true;
+            }
+
+            bool parse_interval_(size_t& min, size_t& max)
+            {
+                pos_ += basic_() ? 2 : 1;
+
+                if (!parse_number_(min))
+                    return fail_(at_end_() ? regex_constants::error_brace : regex_constants::error_badbrace);
+
+                max = min;
+                if (peek_(','))
+                {
+                    ++pos_;
+                    if (!parse_number_(max))
+                        max = regex_npos;
+                }
+
+                if (basic_())
+                {
+                    if (!peek_('\\', '}'))
+                        return fail_(at_end_() ? regex_constants::error_brace : regex_constants::error_badbrace);
+                    pos_ += 2;
+                }
+                else
+                {
+                    if (!peek_('}'))
+                        return fail_(at_end_() ? regex_constants::error_brace : regex_constants::error_badbrace);
+                    ++pos_;
+                }
+
+                if (min > max_count_ || (max != regex_npos && (max > max_count_ || max < min)))
+                    return fail_(regex_constants::error_badbrace);
+
+                return true;
+            }
+
+            size_t parse_atom_(bool first)
+            {
+                auto c = *pos_;
+
+                if (c == charT('.'))
+                {
+                    ++pos_;
+                    auto res = add_node_(node_kind::any);
+                    nodes_[res].flag = grammar_ == grammar::ecma;
+
+                    return res;
+                }
+
+                if (c == charT('['))
+                {
+                    ++pos_;
+
+                    return parse_bracket_();
+                }
+
+                if (basic_() && peek_('\\', '('))
+                {
+                    pos_ += 2;
+
+                    return parse_group_(true);
+                }
+
+                if (!basic_() && c == charT('('))
+                {
+                    ++pos_;
+                    if (grammar_ == grammar::ecma && peek_('?', ':'))
+                    {
+                        pos_ += 2;
+
+                        return parse_group_(false);
+                    }
+
+                    return parse_group_(true);
+                }
+
+                if (c == charT('\\'))
+                {
+                    ++pos_;
+                    if (at_end_())
+                        return fail_node_(regex_constants::error_escape);
+
+                    return parse_escape_();
+                }
+
+                if (c == charT('*'))
+                {
+                    if (basic_() && first)
+                    {
+                        ++pos_;
+
+                        return add_char_(translate_(c));
+                    }
+
+                    return fail_node_(regex_constants::error_badrepeat);
+                }
+
+                if (!basic_() && (c == charT('+') || c == charT('?') || c == charT('{')))
+                    return fail_node_(regex_constants::error_badrepeat);
+
+                if (!basic_() && c == charT(')'))
+                    return fail_node_(regex_constants::error_paren);
+
+                ++pos_;
+
+                return add_char_(translate_(c));
+            }
+
+            size_t parse_group_(bool capture)
+            {
+                size_t idx{regex_npos};
+                if (capture)
+                    idx = ++groups_;
+
+                auto body = parse_disjunction_();
+                if (failed_)
+                    return regex_npos;
+
+                if (!at_group_end_())
+                    return fail_node_(regex_constants::error_paren);
+                pos_ += basic_() ? 2 : 1;
+
+                auto res = add_node_(node_kind::group);
+                nodes_[res].idx = idx;
+                nodes_[res].kids.push_back(body);
+
+                return res;
+            }
+
+            charT translate_(charT c) const
+            {
+                if (option_(regex_constants::icase))
+                    return traits_.translate_nocase(c);
+                else
+                    return traits_.translate(c);
+            }
+
+            size_t parse_escape_()
+            {
+                auto c = *pos_;
+
+                if (traits_.value(c, 10) > 0)
+                {
+                    if (basic_() || grammar_ == grammar::ecma)
+                    {
+                        size_t n{};
+                        if (basic_())
+                        {
+                            n = static_cast<size_t>(traits_.value(c, 10));
+                            ++pos_;
+                        }
+                        else
+                            parse_number_(n);
+
+                        has_backrefs_ = true;
+                        if (n > max_backref_)
+                            max_backref_ = n;
+
+                        auto res = add_node_(node_kind::backref);
+                        nodes_[res].idx = n;
+
+                        return res;
+                    }
+                }
+
+                if (grammar_ == grammar::ecma)
+                {
+                    auto cls = parse_class_escape_();
+                    if (cls != regex_npos || failed_)
+                        return cls;
+
+                    charT res{};
+                    if (!parse_char_escape_(res))
+                        return regex_npos;
+
+                    return add_char_(translate_(res));
+                }
+
+                if (grammar_ == grammar::awk)
+                {
+                    charT res{};
+                    if (!parse_awk_escape_(res))
+                        return regex_npos;
+
+                    return add_char_(translate_(res));
+                }
+
+                ++pos_;
+
+                return add_char_(translate_(c));
+            }
+
+            /**
+             * Handles \d, \s, \w and their negations,
+             * returns regex_npos if there is none.
+             */
+            size_t parse_class_escape_()
+            {
+                auto mask = class_escape_mask_(*pos_);
+                if (!mask)
+                    return regex_npos;
+
+                bool negated = is_upper_escape_(*pos_);
+                ++pos_;
+
+                auto res = add_class_();
+                auto& cls = prog_->classes.back();
+                cls.mask = mask;
+                cls.negated = negated;
+
+                return res;
+            }
+
+            typename Traits::char_class_type class_escape_mask_(charT c) const
+            {
+                switch (aux::regex_tolower(c))
+                {
+                    case charT('d'):
+                        return Traits::class_digit;
+                    case charT('s'):
+                        return Traits::class_space;
+                    case charT('w'):
+                        return Traits::class_word;
+                    default:
+                        return typename Traits::char_class_type{};
+                }
+            }
+
+            bool is_upper_escape_(charT c) const
+            {
+                return c == charT('D') || c == charT('S') || c == charT('W');
+            }
+
+            bool parse_hex_(size_t digits, charT& res)
+            {
+                uint32_t val{};
+                for (size_t i = 0; i < digits; ++i)
+                {
+                    if (at_end_() || traits_.value(*pos_, 16) < 0)
+                        return fail_(regex_constants::error_escape);
+
+                    val = val * 16 + static_cast<uint32_t>(traits_.value(*pos_, 16));
+                    ++pos_;
+                }
+
+                res = static_cast<charT>(val);
+
+                return true;
+            }
+
+            bool parse_char_escape_(charT& res)
+            {
+                auto c = *pos_++;
+
+                switch (c)
+                {
+                    case charT('f'):
+                        res = charT('\f');
+                        return true;
+                    case charT('n'):
+                        res = charT('\n');
+                        return true;
+                    case charT('r'):
+                        res = charT('\r');
+                        return true;
+                    case charT('t'):
+                        res = charT('\t');
+                        return true;
+                    case charT('v'):
+                        res = charT('\v');
+                        return true;
+                    case charT('0'):
+                        if (!at_end_() && traits_.value(*pos_, 10) >= 0)
+                            return fail_(regex_constants::error_escape);
+                        res = charT{};
+                        return true;
+                    case charT('c'):
+                        if (at_end_() || !traits_.isctype(*pos_, Traits::class_alpha))
+                            return fail_(regex_constants::error_escape);
+                        res = static_cast<charT>(static_cast<uint32_t>(*pos_++) % 32);
+                        return true;
+                    case charT('x'):
+                        return parse_hex_(2, res);
+                    case charT('u'):
+                        return parse_hex_(4, res);
+                    default:
+                        if (traits_.isctype(c, Traits::class_word))
+                            return fail_(regex_constants::error_escape);
+                        res = c;
+                        return true;
+                }
+            }
+
+            bool parse_awk_escape_(charT& res)
+            {
+                auto c = *pos_;
+
+                if (traits_.value(c, 8) >= 0)
+                {
+                    uint32_t val{};
+                    for (size_t i = 0; i < 3 && !at_end_() && traits_.value(*pos_, 8) >= 0; ++i)
+                        val = val * 8 + static_cast<uint32_t>(traits_.value(*pos_++, 8));
+                    res = static_cast<charT>(val);
+
+                    return true;
+                }
+
+                ++pos_;
+                switch (c)
+                {
+                    case charT('a'):
+                        res = charT('\a');
+                        return true;
+                    case charT('b'):
+                        res = charT('\b');
+                        return true;
+                    case charT('f'):
+                        res = charT('\f');
+                        return true;
+                    case charT('n'):
+                        res = charT('\n');
+                        return true;
+                    case charT('r'):
+                        res = charT('\r');
+                        return true;
+                    case charT('t'):
+                        res = charT('\t');
+                        return true;
+                    case charT('v'):
+                        res = charT('\v');
+                        return true;
+                    default:
+                        res = c;
+                        return true;
+                }
+            }
+
+            /**
+             * Parses the contents of a bracket expression,
+             * the opening bracket has already been consumed.
+             */
+            size_t parse_bracket_()
+            {
+                auto res = add_class_();
+                auto cls_idx = nodes_[res].idx;
+
+                if (peek_('^'))
+                {
+                    ++pos_;
+                    prog_->classes[cls_idx].negated = true;
+                }
+
+                bool first{true};
+                while (true)
+                {
+                    if (at_end_())
+                        return fail_node_(regex_constants::error_brack);
+
+                    if (peek_(']') && (!first || grammar_ == grammar::ecma))
+                    {
+                        ++pos_;
+                        break;
+                    }
+                    first = false;
+
+                    charT lo{};
+                    if (!parse_class_atom_(cls_idx, lo))
+                    {
+                        if (failed_)
+                            return regex_npos;
+                        continue;
+                    }
+
+                    if (peek_('-') && end_ - pos_ >= 2 && pos_[1] != charT(']'))
+                    {
+                        ++pos_;
+
+                        charT hi{};
+                        if (!parse_class_atom_(cls_idx, hi))
+                            return fail_node_(regex_constants::error_range);
+                        if (hi < lo)
+                            return fail_node_(regex_constants::error_range);
+
+                        prog_->classes[cls_idx].ranges.push_back(make_pair(lo, hi));
+                    }
+                    else
+                        prog_->classes[cls_idx].chars.push_back(lo);
+                }
+
+                return res;
+            }
+
+            /**
+             * Returns true if the atom is a single character
+             * (stored in c) and false if it was a class that
+             * was added to the bracket directly.
+             */
+            bool parse_class_atom_(size_t cls_idx, charT& c)
+            {
+                auto& cls = prog_->classes[cls_idx];
+
+                if (peek_('[', ':') || peek_('[', '.') || peek_('[', '='))
+                {
+                    auto kind = pos_[1];
+                    pos_ += 2;
+
+                    auto name = pos_;
+                    while (end_ - pos_ >= 2 && !(pos_[0] == kind && pos_[1] == charT(']')))
+                        ++pos_;
+                    if (end_ - pos_ < 2)
+                        return fail_(regex_constants::error_brack);
+
+                    auto name_end = pos_;
+                    pos_ += 2;
+
+                    if (kind == charT(':'))
+                    {
+                        auto mask = traits_.lookup_classname(
+                            name, name_end, option_(regex_constants::icase)
+                        );
+                        if (!mask)
+                            return fail_(regex_constants::error_ctype);
+
+                        cls.mask |= mask;
+
+                        return false;
+                    }
+
+                    auto coll = traits_.lookup_collatename(name, name_end);
+                    if (coll.size() != 1)
+                        return fail_(regex_constants::error_collate);
+
+                    c = coll[0];
+
+                    return true;
+                }
+
+                if (peek_('\\') && (grammar_ == grammar::ecma || grammar_ == grammar::awk))
+                {
+                    ++pos_;
+                    if (at_end_())
+                        return fail_(regex_constants::error_escape);
+
+                    if (grammar_ == grammar::awk)
+                        return parse_awk_escape_(c);
+
+                    auto mask = class_escape_mask_(*pos_);
+                    if (mask)
+                    {
+                        if (is_upper_escape_(*pos_))
+                            cls.neg_mask |= mask;
+                        else
+                            cls.mask |= mask;
+                        ++pos_;
+
+                        return false;
+                    }
+
+                    if (peek_('b'))
+                    {
+                        ++pos_;
+                        c = charT('\b');
+
+                        return true;
+                    }
+
+                    if (peek_('-'))
+                    {
+                        ++pos_;
+                        c = charT('-');
+
+                        return true;
+                    }
+
+                    return parse_char_escape_(c);
+                }
+
+                c = *pos_++;
+
+                return true;
+            }
+
+            /**
+             * Code generation.
+             */
+
+            using inst_type = regex_inst<charT>;
+
+            size_t emit_(regex_op op, bool flag = false, charT c = charT{},
+                         size_t x = 0, size_t y = 0)
+            {
+                prog_->insts.push_back(inst_type{op, flag, c, x, y});
+
+                return prog_->insts.size() - 1;
+            }
+
+            size_t here_() const
+            {
+                return prog_->insts.size();
+            }
+
+            bool nullable_(size_t idx) const
+            {
+                const auto& n = nodes_[idx];
+
+                switch (n.kind)
+                {
+                    case node_kind::chr:
+                    case node_kind::any:
+                    case node_kind::cls:
+                        return false;
+                    case node_kind::concat:
+                        for (auto kid: n.kids)
+                        {
+                            if (!nullable_(kid))
+                                return false;
+                        }
+                        return true;
+                    case node_kind::alt:
+                        for (auto kid: n.kids)
+                        {
+                            if (nullable_(kid))
+                                return true;
+                        }
+                        return false;
+                    case node_kind::group:
+                        return nullable_(n.kids.front());
+                    case node_kind::repeat:
+                        return n.min == 0 || nullable_(n.kids.front());
+                    default:
+                        return true;
+                }
+            }
+
+            void emit_program_(size_t root)
+            {
+                /**
+                 * The unanchored prefix, see regex_program.
+                 */
+                auto split = emit_(regex_op::split);
+                emit_(regex_op::any, false);
+                emit_(regex_op::jmp, false, charT{}, split);
+
+                prog_->unanchored_start = split;
+                prog_->start = here_();
+                prog_->insts[split].x = prog_->start;
+                prog_->insts[split].y = split + 1;
+
+                emit_(regex_op::save, false, charT{}, 0);
+                emit_node_(root);
+                emit_(regex_op::save, false, charT{}, 1);
+                emit_(regex_op::match);
+
+                prog_->group_count = groups_ + 1;
+                prog_->loop_count = loops_;
+            }
+
+            void emit_node_(size_t idx)
+            {
+                if (failed_)
+                    return;
+                if (here_() > max_insts_)
+                {
+                    fail_(regex_constants::error_space);
+                    return;
+                }
+
+                /**
+                 * Note: Copies are taken on purpose, emitting
+                 *       does not add nodes but this keeps us
+                 *       safe should that ever change.
+                 */
+                auto kind = nodes_[idx].kind;
+                auto flag = nodes_[idx].flag;
+
+                switch (kind)
+                {
+                    case node_kind::empty:
+                        break;
+                    case node_kind::chr:
+                        emit_(regex_op::chr, false, nodes_[idx].c);
+                        break;
+                    case node_kind::any:
+                        emit_(regex_op::any, flag);
+                        break;
+                    case node_kind::cls:
+                        emit_(regex_op::cls, false, charT{}, nodes_[idx].idx);
+                        break;
+                    case node_kind::concat:
+                        for (size_t i = 0; i < nodes_[idx].kids.size(); ++i)
+                            emit_node_(nodes_[idx].kids[i]);
+                        break;
+                    case node_kind::alt:
+                        emit_alternation_(idx);
+                        break;
+                    case node_kind::group:
+                        emit_group_(idx);
+                        break;
+                    case node_kind::repeat:
+                        emit_repeat_(idx);
+                        break;
+                    case node_kind::bol:
+                        emit_(regex_op::bol, flag);
+                        break;
+                    case node_kind::eol:
+                        emit_(regex_op::eol, flag);
+                        break;
+                    case node_kind::word:
+                        emit_(regex_op::word, flag);
+                        break;
+                    case node_kind::backref:
+                        emit_(regex_op::backref, false, charT{}, nodes_[idx].idx);
+                        break;
+                    case node_kind::look:
+                    {
+                        auto look = emit_(regex_op::look, flag);
+                        emit_node_(nodes_[idx].kids.front());
+                        emit_(regex_op::look_end);
+                        prog_->insts[look].x = here_();
+                        break;
+                    }
+                }
+            }
+
+            void emit_alternation_(size_t idx)
+            {
+                vector<size_t> jumps{};
+                auto count = nodes_[idx].kids.size();
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    size_t split{regex_npos};
+                    if (i + 1 < count)
+                    {
+                        split = emit_(regex_op::split);
+                        prog_->insts[split].x = here_();
+                    }
+
+                    emit_node_(nodes_[idx].kids[i]);
+                    if (failed_)
+                        return;
+
+                    if (i + 1 < count)
+                    {
+                        jumps.push_back(emit_(regex_op::jmp));
+                        prog_->insts[split].y = here_();
+                    }
+                }
+
+                for (auto jmp: jumps)
+                    prog_->insts[jmp].x = here_();
+            }
+
+            void emit_group_(size_t idx)
+            {
+                auto group = nodes_[idx].idx;
+                bool saves = group != regex_npos &&
+                    (!option_(regex_constants::nosubs) || has_backrefs_);
+
+                if (saves)
+                    emit_(regex_op::save, false, charT{}, 2 * group);
+                emit_node_(nodes_[idx].kids.front());
+                if (saves)
+                    emit_(regex_op::save, false, charT{}, 2 * group + 1);
+            }
+
+            /**
+             * Emits a split where x is the preferred
+             * branch, to be patched later.
+             */
+            size_t emit_split_(bool greedy, size_t body, size_t out)
+            {
+                if (greedy)
+                    return emit_(regex_op::split, false, charT{}, body, out);
+                else
+                    return emit_(regex_op::split, false, charT{}, out, body);
+            }
+
+            void patch_split_(size_t split, bool greedy, size_t out)
+            {
+                if (greedy)
+                    prog_->insts[split].y = out;
+                else
+                    prog_->insts[split].x = out;
+            }
+
+            /**
+             * Groups are numbered in the order of their opening
+             * parentheses, so the groups of a subexpression form
+             * a range, [lo, hi) is empty if there are none.
+             */
+            void group_range_(size_t idx, size_t& lo, size_t& hi) const
+            {
+                const auto& n = nodes_[idx];
+
+                if (n.kind == node_kind::group && n.idx != regex_npos)
+                {
+                    lo = min(lo, n.idx);
+                    hi = max(hi, n.idx + 1);
+                }
+
+                for (auto kid: n.kids)
+                    group_range_(kid, lo, hi);
+            }
+
+            /**
+             * In ECMAScript, every iteration of a repeat starts
+             * with the captures of its groups unset, POSIX keeps
+             * the last ones that matched.
+             */
+            void emit_iteration_(size_t kid)
+            {
+                size_t lo{regex_npos};
+                size_t hi{0};
+                if (!posix_() && (!option_(regex_constants::nosubs) || has_backrefs_))
+                    group_range_(kid, lo, hi);
+
+                if (lo < hi)
+                    emit_(regex_op::clear, false, charT{}, 2 * lo, 2 * hi);
+                emit_node_(kid);
+            }
+
+            size_t emit_loop_mark_()
+            {
+                auto loop = loops_++;
+                prog_->loop_depths.push_back(loop_depth_++);
+                emit_(regex_op::loop_mark, false, charT{}, loop);
+
+                return loop;
+            }
+
+            void emit_loop_check_(size_t loop)
+            {
+                --loop_depth_;
+                emit_(regex_op::loop_check, false, charT{}, loop);
+            }
+
+            void emit_repeat_(size_t idx)
+            {
+                auto kid = nodes_[idx].kids.front();
+                auto min = nodes_[idx].min;
+                auto max = nodes_[idx].max;
+                auto greedy = nodes_[idx].greedy;
+
+                for (size_t i = 0; i < min; ++i)
+                    emit_iteration_(kid);
+                if (failed_ || max == min)
+                    return;
+
+                /**
+                 * Iterations that match an empty string would
+                 * loop forever in the backtracking matcher,
+                 * ECMAScript says that they fail instead.
+                 */
+                bool check = nullable_(kid);
+
+                if (max == regex_npos)
+                {
+                    auto split = emit_split_(greedy, here_() + 1, 0);
+                    size_t loop{};
+                    if (check)
+                        loop = emit_loop_mark_();
+
+                    emit_iteration_(kid);
+
+                    if (check)
+                        emit_loop_check_(loop);
+                    emit_(regex_op::jmp, false, charT{}, split);
+                    patch_split_(split, greedy, here_());
+
+                    return;
+                }
+
+                vector<size_t> splits{};
+                for (size_t i = min; i < max && !failed_; ++i)
+                {
+                    splits.push_back(emit_split_(greedy, here_() + 1, 0));
+
+                    size_t loop{};
+                    if (check)
+                        loop = emit_loop_mark_();
+
+                    emit_iteration_(kid);
+
+                    if (check)
+                        emit_loop_check_(loop);
+                }
+
+                for (auto split: splits)
+                    patch_split_(split, greedy, here_());
+            }
+
+            /**
+             * Computes the properties of the program that
+             * the matchers use to pick their strategy.
+             */
+            void analyze_()
+            {
+                auto& prog = *prog_;
+
+                for (auto& cls: prog.classes)
+                    cls.build_table(prog.traits);
+
+                prog.needs_backtrack = false;
+                prog.dfa_capable = sizeof(charT) == 1;
+                for (const auto& inst: prog.insts)
+                {
+                    switch (inst.op)
+                    {
+                        case regex_op::backref:
+                        case regex_op::look:
+                            prog.needs_backtrack = true;
+                            prog.dfa_capable = false;
+                            break;
+                        case regex_op::word:
+                            prog.dfa_capable = false;
+                            break;
+                        case regex_op::bol:
+                        case regex_op::eol:
+                            if (inst.flag)
+                                prog.dfa_capable = false;
+                            break;
+                        default:
+                            break;
+                    }
+                }
+
+                compute_first_set_();
+            }
+
+            void compute_first_set_()
+            {
+                auto& prog = *prog_;
+
+                prog.first_set = regex_byte_set{};
+                prog.first_any = false;
+
+                vector<bool> visited(prog.insts.size(), false);
+                vector<size_t> stack{};
+                stack.push_back(prog.start);
+
+                while (!stack.empty())
+                {
+                    auto pc = stack.back();
+                    stack.pop_back();
+                    if (visited[pc])
+                        continue;
+                    visited[pc] = true;
+
+                    const auto& inst = prog.insts[pc];
+                    switch (inst.op)
+                    {
+                        case regex_op::chr:
+                        case regex_op::any:
+                        case regex_op::cls:
+                            for (size_t i = 0; i < 256; ++i)
+                            {
+                                auto c = static_cast<charT>(i);
+                                if (regex_index(c) == i && prog.consumes(inst, c))
+                                    prog.first_set.set(i);
+                            }
+                            break;
+                        case regex_op::split:
+                            stack.push_back(inst.y);
+                            stack.push_back(inst.x);
+                            break;
+                        case regex_op::jmp:
+                            stack.push_back(inst.x);
+                            break;
+                        case regex_op::match:
+                        case regex_op::backref:
+                        case regex_op::look:
+                            prog.first_any = true;
+                            break;
+                        default:
+                            stack.push_back(pc + 1);
+                            break;
+                    }
+                }
+
+                if (!prog.first_any)
+                {
+                    prog.first_any = true;
+                    for (auto bits: prog.first_set.bits)
+                    {
+                        if (bits != ~uint64_t{})
+                            prog.first_any = false;
+                    }
+                }
+            }
+    };
+}
+
+#endif
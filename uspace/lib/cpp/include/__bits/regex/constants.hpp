@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_CONSTANTS
+#define LIBCPP_BITS_REGEX_CONSTANTS
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace std
+{
+    /**
+     * 28.5, namespace std::regex_constants:
+     */
+
+    namespace regex_constants
+    {
+        /**
+         * 28.5.1, bitmask type syntax_option_type:
+         */
+
+        enum syntax_option_type: uint16_t
+        { /* DUMMY BODY */ };
+
+        inline constexpr syntax_option_type icase      = syntax_option_type{0b0000'0000'0001};
+        inline constexpr syntax_option_type nosubs     = syntax_option_type{0b0000'0000'0010};
+        inline constexpr syntax_option_type optimize   = syntax_option_type{0b0000'0000'0100};
+        inline constexpr syntax_option_type collate    = syntax_option_type{0b0000'0000'1000};
+        inline constexpr syntax_option_type ECMAScript = syntax_option_type{0b0000'0001'0000};
+        inline constexpr syntax_option_type basic      = syntax_option_type{0b0000'0010'0000};
+        inline constexpr syntax_option_type extended   = syntax_option_type{0b0000'0100'0000};
+        inline constexpr syntax_option_type awk        = syntax_option_type{0b0000'1000'0000};
+        inline constexpr syntax_option_type grep       = syntax_option_type{0b0001'0000'0000};
+        inline constexpr syntax_option_type egrep      = syntax_option_type{0b0010'0000'0000};
+        inline constexpr syntax_option_type multiline  = syntax_option_type{0b0100'0000'0000};
+
+        /**
+         * 28.5.2, bitmask type match_flag_type:
+         */
+
+        enum match_flag_type: uint16_t
+        { /* DUMMY BODY */ };
+
+        inline constexpr match_flag_type match_default     = match_flag_type{0b0000'0000'0000};
+        inline constexpr match_flag_type match_not_bol     = match_flag_type{0b0000'0000'0001};
+        inline constexpr match_flag_type match_not_eol     = match_flag_type{0b0000'0000'0010};
+        inline constexpr match_flag_type match_not_bow     = match_flag_type{0b0000'0000'0100};
+        inline constexpr match_flag_type match_not_eow     = match_flag_type{0b0000'0000'1000};
+        inline constexpr match_flag_type match_any         = match_flag_type{0b0000'0001'0000};
+        inline constexpr match_flag_type match_not_null    = match_flag_type{0b0000'0010'0000};
+        inline constexpr match_flag_type match_continuous  = match_flag_type{0b0000'0100'0000};
+        inline constexpr match_flag_type match_prev_avail  = match_flag_type{0b0000'1000'0000};
+        inline constexpr match_flag_type format_default    = match_flag_type{0b0000'0000'0000};
+        inline constexpr match_flag_type format_sed        = match_flag_type{0b0001'0000'0000};
+        inline constexpr match_flag_type format_no_copy    = match_flag_type{0b0010'0000'0000};
+        inline constexpr match_flag_type format_first_only = match_flag_type{0b0100'0000'0000};
+
+        /**
+         * 28.5.3, implementation defined error_type:
+         */
+
+        enum error_type
+        {
+            error_collate,
+            error_ctype,
+            error_escape,
+            error_backref,
+            error_brack,
+            error_paren,
+            error_brace,
+            error_badbrace,
+            error_range,
+            error_space,
+            error_badrepeat,
+            error_complexity,
+            error_stack
+        };
+
+        /**
+         * Bitmask operations, both of the option types
+         * are enumerations so that they do not convert to
+         * each other or to the integral types used as
+         * lengths in the basic_regex constructors.
+         */
+
+#define LIBCPP_REGEX_BITMASK_OPS(type) \
+        constexpr type operator&(type lhs, type rhs) \
+        { \
+            return type(static_cast<uint16_t>(lhs) & static_cast<uint16_t>(rhs)); \
+        } \
+        \
+        constexpr type operator|(type lhs, type rhs) \
+        { \
+            return type(static_cast<uint16_t>(lhs) | static_cast<uint16_t>(rhs)); \
+        } \
+        \
+        constexpr type operator^(type lhs, type rhs) \
+        { \
+            return type(static_cast<uint16_t>(lhs) ^ static_cast<uint16_t>(rhs)); \
+        } \
+        \
+        constexpr type operator~(type val) \
+        { \
+            return type(static_cast<uint16_t>(~static_cast<uint16_t>(val))); \
+        } \
+        \
+        inline type& operator&=(type& lhs, type rhs) \
+        { \
+            return lhs = lhs & rhs; \
+        } \
+        \
+        inline type& operator|=(type& lhs, type rhs) \
+        { \
+            return lhs = lhs | rhs; \
+        } \
+        \
+        inline type& operator^=(type& lhs, type rhs) \
+        { \
+            return lhs = lhs ^ rhs; \
+        }
+
+        LIBCPP_REGEX_BITMASK_OPS(syntax_option_type)
+        LIBCPP_REGEX_BITMASK_OPS(match_flag_type)
+
+#undef LIBCPP_REGEX_BITMASK_OPS
+    }
+
+    /**
+     * 28.6, class regex_error:
+     */
+
+    class regex_error: public runtime_error
+    {
+        public:
+            explicit regex_error(regex_constants::error_type ecode);
+
+            regex_constants::error_type code() const;
+
+        private:
+            regex_constants::error_type code_;
+    };
+}
+
+#endif
@@ -0,0 +1,426 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_DFA
+#define LIBCPP_BITS_REGEX_DFA
+
+#include <__bits/adt/vector.hpp>
+#include <__bits/algorithm.hpp>
+#include <__bits/regex/program.hpp>
+#include <cstdint>
+
+namespace std::aux
+{
+    /**
+     * Lazily constructed DFA over a compiled program. Each
+     * state is the set of program positions the Pike VM
+     * would have threads at, states and transitions are
+     * only built when the input needs them and are cached
+     * across executions. When the cache grows too large,
+     * it is flushed and rebuilt from the current state.
+     *
+     * The input alphabet is reduced to classes of bytes
+     * that no instruction of the program distinguishes,
+     * so the transition table has one column per class.
+     *
+     * Only used for single byte character types and for
+     * programs that regex_program::dfa_capable allows.
+     */
+    template<class charT, class Traits>
+    class regex_dfa
+    {
+        public:
+            using program_type = regex_program<charT, Traits>;
+
+            explicit regex_dfa(const program_type& prog)
+                : prog_{prog}, class_count_{}, pool_{}, states_{},
+                  trans_{}, table_{}, marks_{}, generation_{},
+                  stack_{}, work_{}
+            {
+                compute_classes_();
+                marks_.resize(prog_.insts.size(), 0);
+                reset_();
+            }
+
+            /**
+             * Returns true if the program matches the whole
+             * input, ignoring match_not_null.
+             */
+            bool full_match(const regex_input<charT>& in)
+            {
+                auto state = start_(true, in);
+                for (auto pos = in.first; pos != in.last; ++pos)
+                {
+                    state = next_(state, *pos);
+                    if (state == dead_)
+                        return false;
+                }
+
+                return accepts_at_end_(state, in);
+            }
+
+            /**
+             * Returns true if a match (possibly anchored at
+             * the start of the input) exists.
+             */
+            bool search(const regex_input<charT>& in, bool anchored)
+            {
+                auto state = start_(anchored, in);
+                for (auto pos = in.first; pos != in.last; ++pos)
+                {
+                    if (states_[state].match)
+                        return true;
+
+                    state = next_(state, *pos);
+                    if (state == dead_)
+                        return false;
+                }
+
+                return states_[state].match || accepts_at_end_(state, in);
+            }
+
+        private:
+            struct state_info
+            {
+                size_t begin;
+                size_t size;
+                bool match;
+
+                /**
+                 * Whether the state matches at the end
+                 * of the input, -1 if not computed yet.
+                 */
+                int8_t end_match;
+            };
+
+            static constexpr int32_t unknown_{-1};
+            static constexpr int32_t dead_{0};
+            static constexpr size_t max_states_{2048};
+            static constexpr size_t max_pool_{1 << 18};
+            static constexpr size_t min_table_{64};
+
+            const program_type& prog_;
+
+            uint8_t class_of_[256];
+            uint8_t representative_[256];
+            size_t class_count_;
+
+            vector<size_t> pool_;
+            vector<state_info> states_;
+            vector<int32_t> trans_;
+            vector<int32_t> table_;
+            int32_t starts_[4];
+
+            vector<uint32_t> marks_;
+            uint32_t generation_;
+            vector<size_t> stack_;
+            vector<size_t> work_;
+
+            void compute_classes_()
+            {
+                for (size_t i = 0; i < 256; ++i)
+                    class_of_[i] = 0;
+                class_count_ = 1;
+
+                int16_t remap[512];
+                uint8_t refined[256];
+                for (const auto& inst: prog_.insts)
+                {
+                    if (inst.op != regex_op::chr && inst.op != regex_op::any &&
+                        inst.op != regex_op::cls)
+                        continue;
+
+                    for (auto& r: remap)
+                        r = -1;
+
+                    size_t count{};
+                    for (size_t i = 0; i < 256; ++i)
+                    {
+                        bool accepted = prog_.consumes(inst, static_cast<charT>(i));
+                        auto key = class_of_[i] * 2 + accepted;
+
+                        if (remap[key] < 0)
+                            remap[key] = static_cast<int16_t>(count++);
+                        refined[i] = static_cast<uint8_t>(remap[key]);
+                    }
+
+                    for (size_t i = 0; i < 256; ++i)
+                        class_of_[i] = refined[i];
+                    class_count_ = count;
+                }
+
+                for (size_t i = 256; i > 0; --i)
+                    representative_[class_of_[i - 1]] = static_cast<uint8_t>(i - 1);
+            }
+
+            void reset_()
+            {
+                pool_.clear();
+                states_.clear();
+                trans_.clear();
+                table_.assign(min_table_, unknown_);
+
+                for (auto& s: starts_)
+                    s = unknown_;
+
+                /**
+                 * State 0 is the dead state, all of its
+                 * transitions lead back to it.
+                 */
+                add_state_(vector<size_t>{});
+                for (size_t i = 0; i < class_count_; ++i)
+                    trans_[i] = dead_;
+            }
+
+            int32_t start_(bool anchored, const regex_input<charT>& in)
+            {
+                bool at_begin = !in.has_prev && !in.flag(regex_constants::match_not_bol);
+                auto& start = starts_[anchored * 2 + at_begin];
+
+                if (start == unknown_)
+                {
+                    work_.clear();
+                    work_.push_back(anchored ? prog_.start : prog_.unanchored_start);
+                    closure_(work_, at_begin, false);
+                    start = find_or_add_(work_);
+                }
+
+                return start;
+            }
+
+            int32_t next_(int32_t state, charT c)
+            {
+                auto cls = class_of_[static_cast<unsigned char>(c)];
+                auto res = trans_[state * class_count_ + cls];
+                if (res != unknown_)
+                    return res;
+
+                work_.clear();
+                auto info = states_[state];
+                for (size_t i = 0; i < info.size; ++i)
+                {
+                    auto pc = pool_[info.begin + i];
+                    if (prog_.consumes(prog_.insts[pc], representative_[cls]))
+                        work_.push_back(pc + 1);
+                }
+                closure_(work_, false, false);
+
+                if (states_.size() >= max_states_ || pool_.size() + work_.size() > max_pool_)
+                {
+                    /**
+                     * Note: The new state is already in work_,
+                     *       and it is all we need from now on.
+                     */
+                    reset_();
+
+                    return find_or_add_(work_);
+                }
+
+                res = find_or_add_(work_);
+                trans_[state * class_count_ + cls] = res;
+
+                return res;
+            }
+
+            bool accepts_at_end_(int32_t state, const regex_input<charT>& in)
+            {
+                auto& info = states_[state];
+                if (info.match)
+                    return true;
+                if (in.flag(regex_constants::match_not_eol))
+                    return false;
+
+                if (info.end_match < 0)
+                {
+                    work_.clear();
+                    for (size_t i = 0; i < info.size; ++i)
+                    {
+                        auto pc = pool_[info.begin + i];
+                        if (prog_.insts[pc].op == regex_op::eol)
+                            work_.push_back(pc);
+                    }
+
+                    closure_(work_, false, true);
+
+                    info.end_match = 0;
+                    for (auto pc: work_)
+                    {
+                        if (prog_.insts[pc].op == regex_op::match)
+                            info.end_match = 1;
+                    }
+                }
+
+                return info.end_match > 0;
+            }
+
+            /**
+             * Replaces the seeds in set with their closure over
+             * the instructions that do not consume input, sorted
+             * so that equal sets have equal representations.
+             */
+            void closure_(vector<size_t>& set, bool at_begin, bool at_end)
+            {
+                if (++generation_ == 0)
+                {
+                    for (auto& m: marks_)
+                        m = 0;
+                    generation_ = 1;
+                }
+
+                stack_.clear();
+                for (size_t i = set.size(); i > 0; --i)
+                    stack_.push_back(set[i - 1]);
+                set.clear();
+
+                while (!stack_.empty())
+                {
+                    auto pc = stack_.back();
+                    stack_.pop_back();
+
+                    if (marks_[pc] == generation_)
+                        continue;
+                    marks_[pc] = generation_;
+
+                    const auto& inst = prog_.insts[pc];
+                    switch (inst.op)
+                    {
+                        case regex_op::split:
+                            stack_.push_back(inst.y);
+                            stack_.push_back(inst.x);
+                            break;
+                        case regex_op::jmp:
+                            stack_.push_back(inst.x);
+                            break;
+                        case regex_op::bol:
+                            if (at_begin)
+                                stack_.push_back(pc + 1);
+                            break;
+                        case regex_op::eol:
+                            if (at_end)
+                                stack_.push_back(pc + 1);
+                            else
+                                set.push_back(pc);
+                            break;
+                        case regex_op::save:
+                        case regex_op::clear:
+                        case regex_op::loop_mark:
+                        case regex_op::loop_check:
+                            stack_.push_back(pc + 1);
+                            break;
+                        default:
+                            set.push_back(pc);
+                            break;
+                    }
+                }
+
+                sort(set.begin(), set.end(), [](size_t lhs, size_t rhs) {
+                    return lhs < rhs;
+                });
+            }
+
+            static size_t hash_(const size_t* set, size_t size)
+            {
+                size_t res{2166136261U};
+                for (size_t i = 0; i < size; ++i)
+                    res = (res ^ set[i]) * 16777619U;
+
+                return res;
+            }
+
+            bool equal_(const state_info& info, const vector<size_t>& set) const
+            {
+                if (info.size != set.size())
+                    return false;
+
+                for (size_t i = 0; i < info.size; ++i)
+                {
+                    if (pool_[info.begin + i] != set[i])
+                        return false;
+                }
+
+                return true;
+            }
+
+            int32_t find_or_add_(const vector<size_t>& set)
+            {
+                auto mask = table_.size() - 1;
+                auto idx = hash_(set.data(), set.size()) & mask;
+
+                while (table_[idx] != unknown_)
+                {
+                    if (equal_(states_[table_[idx]], set))
+                        return table_[idx];
+                    idx = (idx + 1) & mask;
+                }
+
+                return add_state_(set);
+            }
+
+            int32_t add_state_(const vector<size_t>& set)
+            {
+                state_info info{pool_.size(), set.size(), false, -1};
+                for (auto pc: set)
+                {
+                    pool_.push_back(pc);
+                    if (prog_.insts[pc].op == regex_op::match)
+                        info.match = true;
+                }
+
+                auto res = static_cast<int32_t>(states_.size());
+                states_.push_back(info);
+                trans_.resize(trans_.size() + class_count_, unknown_);
+
+                if (2 * states_.size() > table_.size())
+                    rehash_(2 * table_.size());
+                else
+                    insert_(res);
+
+                return res;
+            }
+
+            void insert_(int32_t state)
+            {
+                const auto& info = states_[state];
+                auto mask = table_.size() - 1;
+                auto idx = hash_(pool_.data() + info.begin, info.size) & mask;
+
+                while (table_[idx] != unknown_)
+                    idx = (idx + 1) & mask;
+                table_[idx] = state;
+            }
+
+            void rehash_(size_t size)
+            {
+                table_.assign(size, unknown_);
+                for (size_t i = 0; i < states_.size(); ++i)
+                    insert_(static_cast<int32_t>(i));
+            }
+    };
+}
+
+#endif
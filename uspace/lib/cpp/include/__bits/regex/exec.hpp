@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_EXEC
+#define LIBCPP_BITS_REGEX_EXEC
+
+#include <__bits/adt/vector.hpp>
+#include <__bits/regex/backtrack.hpp>
+#include <__bits/regex/dfa.hpp>
+#include <__bits/regex/pike_vm.hpp>
+#include <__bits/regex/program.hpp>
+#include <__bits/thread/threading.hpp>
+
+namespace std::aux
+{
+    /**
+     * The compiled form of a basic_regex, shared by its
+     * copies. Picks the cheapest matcher that can answer
+     * the question asked:
+     *
+     *   - programs with backreferences or lookaheads are
+     *     run by the backtracking matcher,
+     *   - otherwise the lazy DFA decides whether there
+     *     is a match at all, in a single pass,
+     *   - and the Pike VM finds the match and its captures
+     *     only if there is one and they are needed.
+     *
+     * All but the first are linear in the length of the input.
+     */
+    template<class charT, class Traits>
+    class regex_state
+    {
+        public:
+            using program_type = regex_program<charT, Traits>;
+            using dfa_type     = regex_dfa<charT, Traits>;
+
+            regex_state()
+                : prog{}, mark_count{}, mtx_{}, dfa_{}
+            {
+                threading::mutex::init(mtx_);
+            }
+
+            regex_state(const regex_state&) = delete;
+            regex_state& operator=(const regex_state&) = delete;
+
+            ~regex_state()
+            {
+                delete dfa_;
+            }
+
+            /**
+             * Runs the program on the input, if caps is not null
+             * it gets the offsets of all captures of the match.
+             */
+            bool exec(const regex_input<charT>& in, bool full, size_t* caps) const
+            {
+                using namespace regex_constants;
+
+                bool anchored = full || in.flag(match_continuous);
+
+                if (prog.needs_backtrack)
+                    return backtrack_(in, full, anchored, caps);
+
+                if (prog.dfa_capable && !in.flag(match_not_null))
+                {
+                    if (!dfa_exec_(in, full, anchored))
+                        return false;
+                    if (!caps)
+                        return true;
+
+                    if (full && prog.group_count == 1)
+                    {
+                        caps[0] = 0;
+                        caps[1] = static_cast<size_t>(in.last - in.first);
+
+                        return true;
+                    }
+                }
+
+                vector<size_t> local{};
+                if (!caps)
+                {
+                    local.resize(2 * prog.group_count, regex_npos);
+                    caps = local.data();
+                }
+
+                regex_pike_vm<charT, Traits> vm{prog, in};
+
+                return vm.run(full, anchored, caps);
+            }
+
+            program_type prog;
+            size_t mark_count;
+
+        private:
+            mutable mutex_t mtx_;
+
+            /**
+             * The DFA cache is shared by all executions, but
+             * if another thread is using it, we rather build
+             * a private one than wait.
+             */
+            mutable dfa_type* dfa_;
+
+            bool dfa_exec_(const regex_input<charT>& in, bool full, bool anchored) const
+            {
+                if (threading::mutex::try_lock(mtx_))
+                {
+                    if (!dfa_)
+                        dfa_ = new dfa_type{prog};
+
+                    bool res = full ? dfa_->full_match(in) : dfa_->search(in, anchored);
+                    threading::mutex::unlock(mtx_);
+
+                    return res;
+                }
+
+                dfa_type dfa{prog};
+
+                return full ? dfa.full_match(in) : dfa.search(in, anchored);
+            }
+
+            bool backtrack_(const regex_input<charT>& in, bool full,
+                            bool anchored, size_t* caps) const
+            {
+                vector<size_t> local{};
+                if (!caps)
+                {
+                    local.resize(2 * prog.group_count, regex_npos);
+                    caps = local.data();
+                }
+
+                regex_backtracker<charT, Traits> bt{prog, in};
+
+                return bt.run(full, anchored, caps);
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_PIKE_VM
+#define LIBCPP_BITS_REGEX_PIKE_VM
+
+#include <__bits/adt/vector.hpp>
+#include <__bits/regex/program.hpp>
+#include <__bits/utility/utility.hpp>
+
+namespace std::aux
+{
+    /**
+     * Simulates all the threads of a program in lockstep,
+     * so that every character of the input is looked at
+     * only once (for each thread). The threads are kept
+     * in the order of their priority, which gives us the
+     * leftmost first (ECMAScript) semantics by dropping all
+     * threads of lower priority than the one that matched.
+     *
+     * Captures are kept as offsets from in.first,
+     * regex_npos marks the unset ones. Each thread also
+     * has its own copy of the loop registers, which are
+     * stored after its captures.
+     *
+     * A thread that entered a loop at the current position
+     * cannot leave it before consuming a character (its
+     * loop_check fails), so the loops that were entered at
+     * the current position are the innermost ones around
+     * the thread. Within one position, threads are thus told
+     * apart by their pc and the depth of the outermost loop
+     * they entered here, once they consume a character, the
+     * pc is enough.
+     */
+    template<class charT, class Traits>
+    class regex_pike_vm
+    {
+        public:
+            using program_type = regex_program<charT, Traits>;
+
+            regex_pike_vm(const program_type& prog, const regex_input<charT>& in)
+                : prog_{prog}, in_{in}, cap_count_{2 * prog.group_count},
+                  slot_count_{cap_count_ + prog.loop_count},
+                  clist_{prog.insts.size(), slot_count_},
+                  nlist_{prog.insts.size(), slot_count_},
+                  tmp_(slot_count_, regex_npos), stack_{}
+            { /* DUMMY BODY */ }
+
+            /**
+             * If full is set, only matches of the whole input
+             * are accepted, if anchored is set, only matches
+             * starting at in.first are. The captures of the
+             * match are copied to caps.
+             */
+            bool run(bool full, bool anchored, size_t* caps)
+            {
+                using namespace regex_constants;
+
+                bool matched{false};
+                bool longest = prog_.longest;
+                bool not_null = in_.flag(match_not_null);
+                bool any = in_.flag(match_any);
+
+                auto pos = in_.first;
+                auto clist = &clist_;
+                auto nlist = &nlist_;
+                clist->clear();
+                nlist->clear();
+
+                while (true)
+                {
+                    if (!matched && (!anchored || pos == in_.first))
+                    {
+                        if (!anchored && clist->size == 0)
+                            pos = skip_(pos);
+
+                        for (auto& c: tmp_)
+                            c = regex_npos;
+                        add_thread_(*clist, prog_.start, pos);
+                    }
+
+                    /**
+                     * Without threads, an unanchored search goes on
+                     * with a new thread at the next position.
+                     */
+                    if (clist->size == 0 && (matched || anchored || pos == in_.last))
+                        break;
+
+                    auto off = static_cast<size_t>(pos - in_.first);
+                    for (size_t i = 0; i < clist->size; ++i)
+                    {
+                        auto pc = clist->dense[i];
+                        const auto& inst = prog_.insts[pc];
+                        auto thread_caps = clist->caps_of(i);
+
+                        if (matched && longest && thread_caps[0] > caps[0])
+                            continue;
+
+                        if (inst.op == regex_op::match)
+                        {
+                            if (full && pos != in_.last)
+                                continue;
+                            if (not_null && thread_caps[0] == off)
+                                continue;
+
+                            /**
+                             * Without longest, every thread still alive
+                             * has a higher priority than the last match.
+                             */
+                            if (!matched || !longest || thread_caps[0] < caps[0] ||
+                                caps[1] < off)
+                            {
+                                for (size_t j = 0; j < cap_count_; ++j)
+                                    caps[j] = thread_caps[j];
+                            }
+                            matched = true;
+
+                            if (any)
+                                return true;
+
+                            /**
+                             * All of the remaining threads have a lower
+                             * priority, so they cannot win anymore.
+                             */
+                            if (!longest)
+                                break;
+
+                            continue;
+                        }
+
+                        if (pos != in_.last && prog_.consumes(inst, *pos))
+                        {
+                            for (size_t j = 0; j < slot_count_; ++j)
+                                tmp_[j] = thread_caps[j];
+                            add_thread_(*nlist, pc + 1, pos + 1);
+                        }
+                    }
+
+                    if (pos == in_.last)
+                        break;
+
+                    swap(clist, nlist);
+                    nlist->clear();
+                    ++pos;
+                }
+
+                return matched;
+            }
+
+        private:
+            /**
+             * Sparse set of program positions that keeps
+             * the insertion order and the slots (captures
+             * and loop registers) of each thread.
+             */
+            struct thread_list
+            {
+                vector<size_t> dense;
+                vector<size_t> sparse;
+                vector<size_t> caps;
+                size_t size;
+                size_t slot_count;
+
+                /**
+                 * The (pc, level) pairs visited at this position,
+                 * stamps tell which entries of levels are current.
+                 */
+                vector<size_t> stamps;
+                vector<uint64_t> levels;
+                size_t generation;
+
+                thread_list(size_t n, size_t slot_count)
+                    : dense(n, 0), sparse(n, 0), caps(n * slot_count, regex_npos),
+                      size{}, slot_count{slot_count}, stamps(n, 0), levels(n, 0),
+                      generation{1}
+                { /* DUMMY BODY */ }
+
+                bool visit(size_t pc, size_t level)
+                {
+                    if (stamps[pc] != generation)
+                    {
+                        stamps[pc] = generation;
+                        levels[pc] = 0;
+                    }
+
+                    auto bit = uint64_t{1} << level;
+                    if (levels[pc] & bit)
+                        return false;
+                    levels[pc] |= bit;
+
+                    return true;
+                }
+
+                bool contains(size_t pc) const
+                {
+                    auto idx = sparse[pc];
+
+                    return idx < size && dense[idx] == pc;
+                }
+
+                size_t add(size_t pc)
+                {
+                    sparse[pc] = size;
+                    dense[size] = pc;
+
+                    return size++;
+                }
+
+                size_t* caps_of(size_t idx)
+                {
+                    return caps.data() + idx * slot_count;
+                }
+
+                void clear()
+                {
+                    size = 0;
+                    ++generation;
+                }
+            };
+
+            struct entry
+            {
+                size_t pc;
+                size_t slot;
+                size_t old;
+                size_t level;
+            };
+
+            /**
+             * Level 0 is for threads that did not enter a loop at
+             * the current position, deeper loops than we have bits
+             * for share the last level.
+             */
+            static constexpr size_t max_level_{63};
+
+            const program_type& prog_;
+            const regex_input<charT>& in_;
+            size_t cap_count_;
+            size_t slot_count_;
+            thread_list clist_;
+            thread_list nlist_;
+            vector<size_t> tmp_;
+            vector<entry> stack_;
+
+            const charT* skip_(const charT* pos) const
+            {
+                if (prog_.first_any)
+                    return pos;
+
+                while (pos != in_.last)
+                {
+                    auto idx = regex_index(*pos);
+                    if (idx >= 256 || prog_.first_set.test(idx))
+                        break;
+                    ++pos;
+                }
+
+                return pos;
+            }
+
+            /**
+             * Follows the instructions that do not consume input
+             * from pc (in the order of priority) with the slots
+             * in tmp_ and adds the threads that wait for input
+             * (or have matched) to the list.
+             */
+            void add_thread_(thread_list& list, size_t pc, const charT* pos)
+            {
+                auto off = static_cast<size_t>(pos - in_.first);
+
+                stack_.clear();
+                push_(pc, 0);
+
+                while (!stack_.empty())
+                {
+                    auto e = stack_.back();
+                    stack_.pop_back();
+
+                    if (e.slot != regex_npos)
+                    {
+                        tmp_[e.slot] = e.old;
+                        continue;
+                    }
+
+                    if (!list.visit(e.pc, e.level))
+                        continue;
+
+                    const auto& inst = prog_.insts[e.pc];
+                    switch (inst.op)
+                    {
+                        case regex_op::jmp:
+                            push_(inst.x, e.level);
+                            break;
+                        case regex_op::split:
+                            push_(inst.y, e.level);
+                            push_(inst.x, e.level);
+                            break;
+                        case regex_op::save:
+                            set_slot_(inst.x, off);
+                            push_(e.pc + 1, e.level);
+                            break;
+                        case regex_op::clear:
+                            for (auto slot = inst.x; slot < inst.y; ++slot)
+                                set_slot_(slot, regex_npos);
+                            push_(e.pc + 1, e.level);
+                            break;
+                        case regex_op::bol:
+                        case regex_op::eol:
+                        case regex_op::word:
+                            if (regex_assert(prog_, inst, in_, pos))
+                                push_(e.pc + 1, e.level);
+                            break;
+                        case regex_op::loop_mark:
+                        {
+                            set_slot_(cap_count_ + inst.x, off);
+
+                            auto level = e.level;
+                            if (level == 0)
+                                level = min(prog_.loop_depths[inst.x] + 1, max_level_);
+                            push_(e.pc + 1, level);
+                            break;
+                        }
+                        case regex_op::loop_check:
+                            // An iteration that consumed nothing dies here.
+                            if (tmp_[cap_count_ + inst.x] != off)
+                                push_(e.pc + 1, e.level);
+                            break;
+                        default:
+                        {
+                            if (list.contains(e.pc))
+                                break;
+
+                            auto caps = list.caps_of(list.add(e.pc));
+                            for (size_t j = 0; j < slot_count_; ++j)
+                                caps[j] = tmp_[j];
+                            break;
+                        }
+                    }
+                }
+            }
+
+            void push_(size_t pc, size_t level)
+            {
+                stack_.push_back(entry{pc, regex_npos, 0, level});
+            }
+
+            /**
+             * Changes a slot in tmp_, the old value gets
+             * restored once the stack unwinds past this point.
+             */
+            void set_slot_(size_t slot, size_t val)
+            {
+                if (tmp_[slot] == val)
+                    return;
+
+                stack_.push_back(entry{0, slot, tmp_[slot], 0});
+                tmp_[slot] = val;
+            }
+    };
+}
+
+#endif
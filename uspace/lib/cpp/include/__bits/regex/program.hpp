@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_PROGRAM
+#define LIBCPP_BITS_REGEX_PROGRAM
+
+#include <__bits/adt/vector.hpp>
+#include <__bits/regex/constants.hpp>
+#include <__bits/regex/regex_traits.hpp>
+#include <__bits/utility/utility.hpp>
+#include <cstdint>
+
+namespace std::aux
+{
+    /**
+     * Compiled patterns are programs for a small virtual
+     * machine in the style of Thompson and Pike. The same
+     * program is executed by the lazy DFA, the Pike VM
+     * and the backtracking matcher.
+     */
+    enum class regex_op: uint8_t
+    {
+        chr,         // Matches c.
+        any,         // Matches anything, but line terminators if flag is set.
+        cls,         // Matches the character class x.
+        split,       // Continues at x and then at y.
+        jmp,         // Continues at x.
+        save,        // Stores the position to capture slot x.
+        clear,       // Unsets the capture slots from x up to y.
+        match,
+        bol,         // Beginning of line if flag is set, otherwise of input.
+        eol,         // Same as above, for the end.
+        word,        // Word boundary, its negation if flag is set.
+        backref,     // Matches the text of group x again.
+        look,        // Lookahead starting at the next instruction,
+                     // continues at x, negative if flag is set.
+        look_end,
+        loop_mark,   // Stores the position to loop register x.
+        loop_check   // Fails if nothing was consumed since loop_mark x.
+    };
+
+    template<class charT>
+    struct regex_inst
+    {
+        regex_op op;
+        bool flag;
+        charT c;
+        size_t x;
+        size_t y;
+    };
+
+    inline constexpr size_t regex_npos{static_cast<size_t>(-1)};
+
+    /**
+     * Index of a character in the tables that
+     * cover its first 256 values.
+     */
+    template<class charT>
+    size_t regex_index(charT c)
+    {
+        if constexpr (sizeof(charT) == 1)
+            return static_cast<unsigned char>(c);
+        else
+            return static_cast<size_t>(c);
+    }
+
+    struct regex_byte_set
+    {
+        uint64_t bits[4];
+
+        void set(size_t i)
+        {
+            bits[i / 64] |= uint64_t{1} << (i % 64);
+        }
+
+        bool test(size_t i) const
+        {
+            return (bits[i / 64] >> (i % 64)) & 1;
+        }
+    };
+
+    template<class charT>
+    bool regex_is_newline(charT c)
+    {
+        return c == charT('\n') || c == charT('\r');
+    }
+
+    template<class charT, class Traits>
+    struct regex_class
+    {
+        using class_type = typename Traits::char_class_type;
+
+        vector<charT> chars;
+        vector<pair<charT, charT>> ranges;
+        class_type mask;
+        class_type neg_mask;
+        bool negated;
+        bool icase;
+
+        /**
+         * Membership of the first 256 characters is
+         * precomputed when the pattern gets compiled.
+         */
+        regex_byte_set table;
+
+        bool matches(const Traits& traits, charT c) const
+        {
+            auto idx = regex_index(c);
+            if (idx < 256)
+                return table.test(idx);
+            else
+                return evaluate(traits, c);
+        }
+
+        bool evaluate(const Traits& traits, charT c) const
+        {
+            bool res = contains_(traits, c);
+            if (!res && icase)
+            {
+                res = contains_(traits, traits.translate_nocase(c)) ||
+                      contains_(traits, regex_toupper(c));
+            }
+
+            return res != negated;
+        }
+
+        void build_table(const Traits& traits)
+        {
+            table = regex_byte_set{};
+
+            for (size_t i = 0; i < 256; ++i)
+            {
+                /**
+                 * Skip values that do not fit
+                 * into a signed character type.
+                 */
+                auto c = static_cast<charT>(i);
+                if (regex_index(c) != i)
+                    continue;
+
+                if (evaluate(traits, c))
+                    table.set(i);
+            }
+        }
+
+        private:
+            bool contains_(const Traits& traits, charT c) const
+            {
+                for (auto ch: chars)
+                {
+                    if (ch == c)
+                        return true;
+                }
+
+                for (const auto& r: ranges)
+                {
+                    if (r.first <= c && c <= r.second)
+                        return true;
+                }
+
+                if (mask && traits.isctype(c, mask))
+                    return true;
+
+                for (class_type bit = 1; bit != 0 && bit <= neg_mask; bit <<= 1)
+                {
+                    if ((neg_mask & bit) && !traits.isctype(c, bit))
+                        return true;
+                }
+
+                return false;
+            }
+    };
+
+    template<class charT, class Traits>
+    struct regex_program
+    {
+        Traits traits;
+        vector<regex_inst<charT>> insts;
+        vector<regex_class<charT, Traits>> classes;
+
+        /**
+         * The start of the anchored program and of the
+         * unanchored one, which is prefixed with a lazy
+         * loop over any character (used by the DFA).
+         */
+        size_t start;
+        size_t unanchored_start;
+
+        size_t group_count;
+        size_t loop_count;
+
+        /**
+         * Number of loop registers in use around each loop,
+         * see regex_pike_vm.
+         */
+        vector<size_t> loop_depths;
+
+        bool icase;
+        bool multiline;
+
+        /**
+         * POSIX grammars want the leftmost longest match,
+         * ECMAScript wants the leftmost match that comes
+         * first in the order of alternatives.
+         */
+        bool longest;
+
+        /**
+         * Backreferences and lookaheads are beyond the
+         * automata, those need the backtracking matcher.
+         */
+        bool needs_backtrack;
+
+        /**
+         * The DFA supports anchors at the beginning and end
+         * of the input but not word boundaries or line anchors.
+         */
+        bool dfa_capable;
+
+        /**
+         * Characters that can start a match, searches can skip
+         * all other characters. If first_any is set, a match
+         * can start with any character or be empty.
+         */
+        regex_byte_set first_set;
+        bool first_any;
+
+        bool consumes(const regex_inst<charT>& inst, charT c) const
+        {
+            switch (inst.op)
+            {
+                case regex_op::chr:
+                    if (icase)
+                        return traits.translate_nocase(c) == inst.c;
+                    else
+                        return traits.translate(c) == inst.c;
+                case regex_op::any:
+                    return !inst.flag || !regex_is_newline(c);
+                case regex_op::cls:
+                    return classes[inst.x].matches(traits, c);
+                default:
+                    return false;
+            }
+        }
+
+        bool is_word(charT c) const
+        {
+            return traits.isctype(c, Traits::class_word);
+        }
+    };
+
+    /**
+     * The input of a single execution, the matchers never
+     * look before first, the character before it (if any)
+     * is passed in prev.
+     */
+    template<class charT>
+    struct regex_input
+    {
+        const charT* first;
+        const charT* last;
+        bool has_prev;
+        charT prev;
+        regex_constants::match_flag_type flags;
+
+        bool flag(regex_constants::match_flag_type f) const
+        {
+            return (flags & f) != regex_constants::match_default;
+        }
+    };
+
+    template<class charT, class Traits>
+    bool regex_assert(const regex_program<charT, Traits>& prog,
+                      const regex_inst<charT>& inst,
+                      const regex_input<charT>& in, const charT* pos)
+    {
+        using namespace regex_constants;
+
+        switch (inst.op)
+        {
+            case regex_op::bol:
+                if (pos != in.first)
+                    return inst.flag && regex_is_newline(pos[-1]);
+                else if (in.has_prev)
+                    return inst.flag && regex_is_newline(in.prev);
+                else
+                    return !in.flag(match_not_bol);
+            case regex_op::eol:
+                if (pos != in.last)
+                    return inst.flag && regex_is_newline(*pos);
+                else
+                    return !in.flag(match_not_eol);
+            case regex_op::word:
+            {
+                bool before{};
+                if (pos != in.first)
+                    before = prog.is_word(pos[-1]);
+                else if (in.has_prev)
+                    before = prog.is_word(in.prev);
+                else if (in.flag(match_not_bow))
+                    return inst.flag;
+
+                bool after{};
+                if (pos != in.last)
+                    after = prog.is_word(*pos);
+                else if (in.flag(match_not_eow))
+                    return inst.flag;
+
+                return (before != after) != inst.flag;
+            }
+            default:
+                return true;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,406 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_REGEX_ITERATOR
+#define LIBCPP_BITS_REGEX_REGEX_ITERATOR
+
+#include <__bits/adt/vector.hpp>
+#include <__bits/iterator.hpp>
+#include <__bits/regex/algorithms.hpp>
+#include <__bits/regex/basic_regex.hpp>
+#include <__bits/regex/constants.hpp>
+#include <__bits/regex/match_results.hpp>
+#include <__bits/regex/sub_match.hpp>
+#include <initializer_list>
+
+namespace std
+{
+    /**
+     * 28.12.1, class template regex_iterator:
+     */
+
+    template<class BidirectionalIterator,
+             class charT = typename iterator_traits<BidirectionalIterator>::value_type,
+             class traits = regex_traits<charT>>
+    class regex_iterator
+    {
+        public:
+            using regex_type        = basic_regex<charT, traits>;
+            using value_type        = match_results<BidirectionalIterator>;
+            using difference_type   = ptrdiff_t;
+            using pointer           = const value_type*;
+            using reference         = const value_type&;
+            using iterator_category = forward_iterator_tag;
+
+            regex_iterator()
+                : begin_{}, end_{}, regex_{}, flags_{}, match_{}
+            { /* DUMMY BODY */ }
+
+            regex_iterator(BidirectionalIterator a, BidirectionalIterator b,
+                           const regex_type& re,
+                           regex_constants::match_flag_type m = regex_constants::match_default)
+                : begin_{a}, end_{b}, regex_{&re}, flags_{m}, match_{}
+            {
+                if (!regex_search(begin_, end_, match_, *regex_, flags_))
+                    regex_ = nullptr;
+            }
+
+            regex_iterator(BidirectionalIterator, BidirectionalIterator,
+                           const regex_type&&,
+                           regex_constants::match_flag_type = regex_constants::match_default) = delete;
+
+            regex_iterator(const regex_iterator&) = default;
+            regex_iterator& operator=(const regex_iterator&) = default;
+
+            bool operator==(const regex_iterator& other) const
+            {
+                if (!regex_ || !other.regex_)
+                    return regex_ == other.regex_;
+
+                return regex_ == other.regex_ && begin_ == other.begin_ &&
+                       end_ == other.end_ && flags_ == other.flags_ &&
+                       match_[0] == other.match_[0];
+            }
+
+            bool operator!=(const regex_iterator& other) const
+            {
+                return !(*this == other);
+            }
+
+            const value_type& operator*() const
+            {
+                return match_;
+            }
+
+            const value_type* operator->() const
+            {
+                return &match_;
+            }
+
+            regex_iterator& operator++()
+            {
+                using namespace regex_constants;
+
+                auto start = match_[0].second;
+                auto prefix_first = start;
+
+                if (match_[0].first == match_[0].second)
+                {
+                    /**
+                     * An empty match, we first try to find
+                     * a non-empty one at the same position
+                     * and only then move on.
+                     */
+                    if (start == end_)
+                    {
+                        regex_ = nullptr;
+
+                        return *this;
+                    }
+
+                    if (search_(start, prefix_first, match_not_null | match_continuous))
+                        return *this;
+
+                    ++start;
+                }
+
+                if (!search_(start, prefix_first, match_default))
+                    regex_ = nullptr;
+
+                return *this;
+            }
+
+            regex_iterator operator++(int)
+            {
+                auto tmp = *this;
+                ++(*this);
+
+                return tmp;
+            }
+
+        private:
+            BidirectionalIterator begin_;
+            BidirectionalIterator end_;
+
+            /**
+             * Null for the end-of-sequence iterator.
+             */
+            const regex_type* regex_;
+            regex_constants::match_flag_type flags_;
+            value_type match_;
+
+            bool search_(BidirectionalIterator start, BidirectionalIterator prefix_first,
+                         regex_constants::match_flag_type flags)
+            {
+                flags = flags | flags_;
+                if (start != begin_)
+                    flags = flags | regex_constants::match_prev_avail;
+
+                if (!regex_search(start, end_, match_, *regex_, flags))
+                    return false;
+
+                aux::regex_access::rebase(match_, prefix_first, begin_);
+
+                return true;
+            }
+    };
+
+    using cregex_iterator  = regex_iterator<const char*>;
+    using wcregex_iterator = regex_iterator<const wchar_t*>;
+    using sregex_iterator  = regex_iterator<string::const_iterator>;
+    using wsregex_iterator = regex_iterator<wstring::const_iterator>;
+
+    /**
+     * 28.12.2, class template regex_token_iterator:
+     */
+
+    template<class BidirectionalIterator,
+             class charT = typename iterator_traits<BidirectionalIterator>::value_type,
+             class traits = regex_traits<charT>>
+    class regex_token_iterator
+    {
+        public:
+            using regex_type        = basic_regex<charT, traits>;
+            using value_type        = sub_match<BidirectionalIterator>;
+            using difference_type   = ptrdiff_t;
+            using pointer           = const value_type*;
+            using reference         = const value_type&;
+            using iterator_category = forward_iterator_tag;
+
+            regex_token_iterator()
+                : position_{}, result_{}, suffix_{}, n_{}, subs_{}
+            { /* DUMMY BODY */ }
+
+            regex_token_iterator(BidirectionalIterator a, BidirectionalIterator b,
+                                 const regex_type& re, int submatch = 0,
+                                 regex_constants::match_flag_type m = regex_constants::match_default)
+                : position_{a, b, re, m}, result_{}, suffix_{}, n_{}, subs_{submatch}
+            {
+                init_(a, b);
+            }
+
+            regex_token_iterator(BidirectionalIterator a, BidirectionalIterator b,
+                                 const regex_type& re, const vector<int>& submatches,
+                                 regex_constants::match_flag_type m = regex_constants::match_default)
+                : position_{a, b, re, m}, result_{}, suffix_{}, n_{}, subs_{submatches}
+            {
+                init_(a, b);
+            }
+
+            regex_token_iterator(BidirectionalIterator a, BidirectionalIterator b,
+                                 const regex_type& re, initializer_list<int> submatches,
+                                 regex_constants::match_flag_type m = regex_constants::match_default)
+                : position_{a, b, re, m}, result_{}, suffix_{}, n_{}, subs_{submatches}
+            {
+                init_(a, b);
+            }
+
+            template<size_t N>
+            regex_token_iterator(BidirectionalIterator a, BidirectionalIterator b,
+                                 const regex_type& re, const int (&submatches)[N],
+                                 regex_constants::match_flag_type m = regex_constants::match_default)
+                : position_{a, b, re, m}, result_{}, suffix_{}, n_{}, subs_{}
+            {
+                subs_.reserve(N);
+                for (auto sub: submatches)
+                    subs_.push_back(sub);
+                init_(a, b);
+            }
+
+            regex_token_iterator(BidirectionalIterator, BidirectionalIterator,
+                                 const regex_type&&, int = 0,
+                                 regex_constants::match_flag_type = regex_constants::match_default) = delete;
+
+            regex_token_iterator(BidirectionalIterator, BidirectionalIterator,
+                                 const regex_type&&, const vector<int>&,
+                                 regex_constants::match_flag_type = regex_constants::match_default) = delete;
+
+            regex_token_iterator(BidirectionalIterator, BidirectionalIterator,
+                                 const regex_type&&, initializer_list<int>,
+                                 regex_constants::match_flag_type = regex_constants::match_default) = delete;
+
+            template<size_t N>
+            regex_token_iterator(BidirectionalIterator, BidirectionalIterator,
+                                 const regex_type&&, const int (&)[N],
+                                 regex_constants::match_flag_type = regex_constants::match_default) = delete;
+
+            regex_token_iterator(const regex_token_iterator& other)
+                : position_{other.position_}, result_{}, suffix_{other.suffix_},
+                  n_{other.n_}, subs_{other.subs_}
+            {
+                rebind_(other);
+            }
+
+            regex_token_iterator& operator=(const regex_token_iterator& other)
+            {
+                position_ = other.position_;
+                suffix_ = other.suffix_;
+                n_ = other.n_;
+                subs_ = other.subs_;
+                rebind_(other);
+
+                return *this;
+            }
+
+            bool operator==(const regex_token_iterator& other) const
+            {
+                if (!result_ || !other.result_)
+                    return result_ == other.result_;
+                if (is_suffix_() || other.is_suffix_())
+                    return is_suffix_() && other.is_suffix_() && suffix_ == other.suffix_;
+
+                return position_ == other.position_ && n_ == other.n_ &&
+                       subs_ == other.subs_;
+            }
+
+            bool operator!=(const regex_token_iterator& other) const
+            {
+                return !(*this == other);
+            }
+
+            const value_type& operator*() const
+            {
+                return *result_;
+            }
+
+            const value_type* operator->() const
+            {
+                return result_;
+            }
+
+            regex_token_iterator& operator++()
+            {
+                if (is_suffix_())
+                {
+                    result_ = nullptr;
+
+                    return *this;
+                }
+
+                if (n_ + 1 < subs_.size())
+                {
+                    ++n_;
+                    result_ = current_();
+
+                    return *this;
+                }
+
+                auto prev = position_;
+                n_ = 0;
+                ++position_;
+
+                if (position_ != position_type{})
+                    result_ = current_();
+                else if (wants_suffix_() && prev->suffix().length() != 0)
+                {
+                    suffix_ = prev->suffix();
+                    result_ = &suffix_;
+                }
+                else
+                    result_ = nullptr;
+
+                return *this;
+            }
+
+            regex_token_iterator operator++(int)
+            {
+                auto tmp = *this;
+                ++(*this);
+
+                return tmp;
+            }
+
+        private:
+            using position_type = regex_iterator<BidirectionalIterator, charT, traits>;
+
+            position_type position_;
+
+            /**
+             * Points either into the current match, to suffix_
+             * or is null for the end-of-sequence iterator.
+             */
+            const value_type* result_;
+            value_type suffix_;
+            size_t n_;
+            vector<int> subs_;
+
+            void init_(BidirectionalIterator a, BidirectionalIterator b)
+            {
+                if (position_ != position_type{})
+                    result_ = current_();
+                else if (wants_suffix_() && a != b)
+                {
+                    suffix_.first = a;
+                    suffix_.second = b;
+                    suffix_.matched = true;
+                    result_ = &suffix_;
+                }
+            }
+
+            void rebind_(const regex_token_iterator& other)
+            {
+                if (other.is_suffix_())
+                    result_ = &suffix_;
+                else if (other.result_)
+                    result_ = current_();
+                else
+                    result_ = nullptr;
+            }
+
+            const value_type* current_() const
+            {
+                if (subs_[n_] == -1)
+                    return &position_->prefix();
+                else
+                    return &(*position_)[static_cast<size_t>(subs_[n_])];
+            }
+
+            bool is_suffix_() const
+            {
+                return result_ == &suffix_;
+            }
+
+            bool wants_suffix_() const
+            {
+                for (auto sub: subs_)
+                {
+                    if (sub == -1)
+                        return true;
+                }
+
+                return false;
+            }
+    };
+
+    using cregex_token_iterator  = regex_token_iterator<const char*>;
+    using wcregex_token_iterator = regex_token_iterator<const wchar_t*>;
+    using sregex_token_iterator  = regex_token_iterator<string::const_iterator>;
+    using wsregex_token_iterator = regex_token_iterator<wstring::const_iterator>;
+}
+
+#endif
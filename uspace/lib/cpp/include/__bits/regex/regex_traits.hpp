@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_TRAITS
+#define LIBCPP_BITS_REGEX_TRAITS
+
+#include <__bits/locale/locale.hpp>
+#include <__bits/string/string.hpp>
+#include <cstdint>
+
+namespace std
+{
+    namespace aux
+    {
+        /**
+         * HelenOS only has the C locale, so the character
+         * classes only contain ASCII characters and are
+         * resolved without any facets.
+         */
+        template<class charT>
+        constexpr bool regex_is_ascii(charT c)
+        {
+            return static_cast<uint32_t>(c) < 128U;
+        }
+
+        template<class charT>
+        constexpr charT regex_tolower(charT c)
+        {
+            if (c >= charT('A') && c <= charT('Z'))
+                return charT(c - charT('A') + charT('a'));
+            else
+                return c;
+        }
+
+        template<class charT>
+        constexpr charT regex_toupper(charT c)
+        {
+            if (c >= charT('a') && c <= charT('z'))
+                return charT(c - charT('a') + charT('A'));
+            else
+                return c;
+        }
+    }
+
+    /**
+     * 28.7, class template regex_traits:
+     */
+
+    template<class charT>
+    struct regex_traits
+    {
+        using char_type       = charT;
+        using string_type     = basic_string<char_type>;
+        using locale_type     = locale;
+        using char_class_type = uint16_t;
+
+        static constexpr char_class_type class_alnum  = 0b0000'0000'0000'0001;
+        static constexpr char_class_type class_alpha  = 0b0000'0000'0000'0010;
+        static constexpr char_class_type class_blank  = 0b0000'0000'0000'0100;
+        static constexpr char_class_type class_cntrl  = 0b0000'0000'0000'1000;
+        static constexpr char_class_type class_digit  = 0b0000'0000'0001'0000;
+        static constexpr char_class_type class_graph  = 0b0000'0000'0010'0000;
+        static constexpr char_class_type class_lower  = 0b0000'0000'0100'0000;
+        static constexpr char_class_type class_print  = 0b0000'0000'1000'0000;
+        static constexpr char_class_type class_punct  = 0b0000'0001'0000'0000;
+        static constexpr char_class_type class_space  = 0b0000'0010'0000'0000;
+        static constexpr char_class_type class_upper  = 0b0000'0100'0000'0000;
+        static constexpr char_class_type class_xdigit = 0b0000'1000'0000'0000;
+        static constexpr char_class_type class_word   = 0b0001'0000'0000'0000;
+
+        regex_traits()
+            : loc_{}
+        { /* DUMMY BODY */ }
+
+        static size_t length(const char_type* p)
+        {
+            return char_traits<char_type>::length(p);
+        }
+
+        char_type translate(char_type c) const
+        {
+            return c;
+        }
+
+        char_type translate_nocase(char_type c) const
+        {
+            return aux::regex_tolower(c);
+        }
+
+        template<class ForwardIterator>
+        string_type transform(ForwardIterator first, ForwardIterator last) const
+        {
+            return string_type(first, last);
+        }
+
+        template<class ForwardIterator>
+        string_type transform_primary(ForwardIterator first, ForwardIterator last) const
+        {
+            string_type res{};
+            for (; first != last; ++first)
+                res.push_back(translate_nocase(*first));
+
+            return res;
+        }
+
+        /**
+         * Only single character collating elements
+         * are supported in the C locale.
+         */
+        template<class ForwardIterator>
+        string_type lookup_collatename(ForwardIterator first, ForwardIterator last) const
+        {
+            string_type res(first, last);
+            if (res.size() == 1)
+                return res;
+            else
+                return string_type{};
+        }
+
+        template<class ForwardIterator>
+        char_class_type lookup_classname(ForwardIterator first, ForwardIterator last,
+                                         bool icase = false) const
+        {
+            static constexpr struct
+            {
+                const char* name;
+                char_class_type mask;
+            } classes[] = {
+                {"alnum",  class_alnum},
+                {"alpha",  class_alpha},
+                {"blank",  class_blank},
+                {"cntrl",  class_cntrl},
+                {"digit",  class_digit},
+                {"d",      class_digit},
+                {"graph",  class_graph},
+                {"lower",  class_lower},
+                {"print",  class_print},
+                {"punct",  class_punct},
+                {"space",  class_space},
+                {"s",      class_space},
+                {"upper",  class_upper},
+                {"w",      class_word},
+                {"xdigit", class_xdigit}
+            };
+
+            for (const auto& cls: classes)
+            {
+                auto it = first;
+                auto name = cls.name;
+                for (; it != last && *name; ++it, ++name)
+                {
+                    if (aux::regex_tolower(*it) != char_type(*name))
+                        break;
+                }
+
+                if (it != last || *name)
+                    continue;
+
+                if (icase && (cls.mask & (class_lower | class_upper)))
+                    return class_alpha;
+                else
+                    return cls.mask;
+            }
+
+            return char_class_type{};
+        }
+
+        bool isctype(char_type c, char_class_type f) const
+        {
+            if (!aux::regex_is_ascii(c))
+                return false;
+
+            auto ch = static_cast<uint32_t>(c);
+            bool lower = ch >= 'a' && ch <= 'z';
+            bool upper = ch >= 'A' && ch <= 'Z';
+            bool digit = ch >= '0' && ch <= '9';
+            bool alpha = lower || upper;
+            bool cntrl = ch < 0x20 || ch == 0x7F;
+            bool space = ch == ' ' || (ch >= '\t' && ch <= '\r');
+            bool graph = ch > 0x20 && ch < 0x7F;
+
+            if ((f & class_alnum) && (alpha || digit))
+                return true;
+            if ((f & class_alpha) && alpha)
+                return true;
+            if ((f & class_blank) && (ch == ' ' || ch == '\t'))
+                return true;
+            if ((f & class_cntrl) && cntrl)
+                return true;
+            if ((f & class_digit) && digit)
+                return true;
+            if ((f & class_graph) && graph)
+                return true;
+            if ((f & class_lower) && lower)
+                return true;
+            if ((f & class_print) && (graph || ch == ' '))
+                return true;
+            if ((f & class_punct) && graph && !alpha && !digit)
+                return true;
+            if ((f & class_space) && space)
+                return true;
+            if ((f & class_upper) && upper)
+                return true;
+            if ((f & class_xdigit) && (digit || (ch >= 'a' && ch <= 'f') || (ch >= 'A' && ch <= 'F')))
+                return true;
+            if ((f & class_word) && (alpha || digit || ch == '_'))
+                return true;
+
+            return false;
+        }
+
+        int value(char_type ch, int radix) const
+        {
+            int res{-1};
+            if (ch >= char_type('0') && ch <= char_type('9'))
+                res = static_cast<int>(ch - char_type('0'));
+            else if (ch >= char_type('a') && ch <= char_type('z'))
+                res = static_cast<int>(ch - char_type('a')) + 10;
+            else if (ch >= char_type('A') && ch <= char_type('Z'))
+                res = static_cast<int>(ch - char_type('A')) + 10;
+
+            if (res >= radix)
+                return -1;
+            else
+                return res;
+        }
+
+        locale_type imbue(locale_type loc)
+        {
+            auto old = loc_;
+            loc_ = loc;
+
+            return old;
+        }
+
+        locale_type getloc() const
+        {
+            return loc_;
+        }
+
+        private:
+            locale_type loc_;
+    };
+}
+
+#endif
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_REPLACE
+#define LIBCPP_BITS_REGEX_REPLACE
+
+#include <__bits/algorithm.hpp>
+#include <__bits/iterator.hpp>
+#include <__bits/regex/basic_regex.hpp>
+#include <__bits/regex/constants.hpp>
+#include <__bits/regex/regex_iterator.hpp>
+#include <__bits/string/string.hpp>
+
+namespace std
+{
+    namespace aux
+    {
+        template<class OutputIterator, class BidirectionalIterator,
+                 class traits, class charT>
+        OutputIterator regex_replace(OutputIterator out,
+                                     BidirectionalIterator first, BidirectionalIterator last,
+                                     const basic_regex<charT, traits>& e,
+                                     const charT* fmt_first, const charT* fmt_last,
+                                     regex_constants::match_flag_type flags)
+        {
+            using namespace regex_constants;
+            using iterator = regex_iterator<BidirectionalIterator, charT, traits>;
+
+            bool copy_rest = (flags & format_no_copy) == match_default;
+            bool first_only = (flags & format_first_only) != match_default;
+
+            iterator it{first, last, e, flags};
+            iterator end{};
+
+            if (it == end)
+            {
+                if (copy_rest)
+                    out = copy(first, last, out);
+
+                return out;
+            }
+
+            auto rest = first;
+            for (; it != end; ++it)
+            {
+                if (copy_rest)
+                    out = copy(it->prefix().first, it->prefix().second, out);
+                out = it->format(out, fmt_first, fmt_last, flags);
+                rest = it->suffix().first;
+
+                if (first_only)
+                    break;
+            }
+
+            if (copy_rest)
+                out = copy(rest, last, out);
+
+            return out;
+        }
+    }
+
+    /**
+     * 28.11.4, function template regex_replace:
+     */
+
+    template<class OutputIterator, class BidirectionalIterator,
+             class traits, class charT, class ST, class SA>
+    OutputIterator regex_replace(OutputIterator out,
+                                 BidirectionalIterator first, BidirectionalIterator last,
+                                 const basic_regex<charT, traits>& e,
+                                 const basic_string<charT, ST, SA>& fmt,
+                                 regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return aux::regex_replace(out, first, last, e, fmt.data(),
+                                  fmt.data() + fmt.size(), flags);
+    }
+
+    template<class OutputIterator, class BidirectionalIterator,
+             class traits, class charT>
+    OutputIterator regex_replace(OutputIterator out,
+                                 BidirectionalIterator first, BidirectionalIterator last,
+                                 const basic_regex<charT, traits>& e, const charT* fmt,
+                                 regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return aux::regex_replace(out, first, last, e, fmt,
+                                  fmt + char_traits<charT>::length(fmt), flags);
+    }
+
+    template<class traits, class charT, class ST, class SA, class FST, class FSA>
+    basic_string<charT, ST, SA> regex_replace(const basic_string<charT, ST, SA>& s,
+                                              const basic_regex<charT, traits>& e,
+                                              const basic_string<charT, FST, FSA>& fmt,
+                                              regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        basic_string<charT, ST, SA> res{};
+        regex_replace(back_inserter(res), s.begin(), s.end(), e, fmt, flags);
+
+        return res;
+    }
+
+    template<class traits, class charT, class ST, class SA>
+    basic_string<charT, ST, SA> regex_replace(const basic_string<charT, ST, SA>& s,
+                                              const basic_regex<charT, traits>& e,
+                                              const charT* fmt,
+                                              regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        basic_string<charT, ST, SA> res{};
+        regex_replace(back_inserter(res), s.begin(), s.end(), e, fmt, flags);
+
+        return res;
+    }
+
+    template<class traits, class charT, class ST, class SA>
+    basic_string<charT> regex_replace(const charT* s,
+                                      const basic_regex<charT, traits>& e,
+                                      const basic_string<charT, ST, SA>& fmt,
+                                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        basic_string<charT> res{};
+        regex_replace(back_inserter(res), s, s + char_traits<charT>::length(s),
+                      e, fmt, flags);
+
+        return res;
+    }
+
+    template<class traits, class charT>
+    basic_string<charT> regex_replace(const charT* s,
+                                      const basic_regex<charT, traits>& e,
+                                      const charT* fmt,
+                                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        basic_string<charT> res{};
+        regex_replace(back_inserter(res), s, s + char_traits<charT>::length(s),
+                      e, fmt, flags);
+
+        return res;
+    }
+}
+
+#endif
@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_REGEX_SUB_MATCH
+#define LIBCPP_BITS_REGEX_SUB_MATCH
+
+#include <__bits/io/ostream.hpp>
+#include <__bits/iterator.hpp>
+#include <__bits/string/string.hpp>
+#include <__bits/utility/utility.hpp>
+
+namespace std
+{
+    /**
+     * 28.9, class template sub_match:
+     */
+
+    template<class BidirectionalIterator>
+    class sub_match: public pair<BidirectionalIterator, BidirectionalIterator>
+    {
+        public:
+            using value_type      = typename iterator_traits<BidirectionalIterator>::value_type;
+            using difference_type = typename iterator_traits<BidirectionalIterator>::difference_type;
+            using iterator        = BidirectionalIterator;
+            using string_type     = basic_string<value_type>;
+
+            bool matched;
+
+            constexpr sub_match()
+                : pair<BidirectionalIterator, BidirectionalIterator>{}, matched{false}
+            { /* DUMMY BODY */ }
+
+            difference_type length() const
+            {
+                if (matched)
+                    return distance(this->first, this->second);
+                else
+                    return difference_type{};
+            }
+
+            operator string_type() const
+            {
+                return str();
+            }
+
+            string_type str() const
+            {
+                if (matched)
+                    return string_type(this->first, this->second);
+                else
+                    return string_type{};
+            }
+
+            int compare(const sub_match& s) const
+            {
+                return str().compare(s.str());
+            }
+
+            int compare(const string_type& s) const
+            {
+                return str().compare(s);
+            }
+
+            int compare(const value_type* s) const
+            {
+                return str().compare(s);
+            }
+    };
+
+    using csub_match  = sub_match<const char*>;
+    using wcsub_match = sub_match<const wchar_t*>;
+    using ssub_match  = sub_match<string::const_iterator>;
+    using wssub_match = sub_match<wstring::const_iterator>;
+
+    namespace aux
+    {
+        template<class BidirectionalIterator>
+        using sub_match_value_t = typename iterator_traits<BidirectionalIterator>::value_type;
+
+        /**
+         * Strings with other traits or allocators
+         * get compared as plain strings.
+         */
+        template<class BidirectionalIterator, class ST, class SA>
+        auto sub_match_string(const basic_string<sub_match_value_t<BidirectionalIterator>, ST, SA>& str)
+        {
+            return typename sub_match<BidirectionalIterator>::string_type(str.data(), str.size());
+        }
+    }
+
+    /**
+     * 28.9.2, sub_match non-member operators:
+     */
+
+    template<class BidirectionalIterator>
+    bool operator==(const sub_match<BidirectionalIterator>& lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return lhs.compare(rhs) == 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator!=(const sub_match<BidirectionalIterator>& lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return lhs.compare(rhs) != 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator<(const sub_match<BidirectionalIterator>& lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return lhs.compare(rhs) < 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator<=(const sub_match<BidirectionalIterator>& lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return lhs.compare(rhs) <= 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator>(const sub_match<BidirectionalIterator>& lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return lhs.compare(rhs) > 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator>=(const sub_match<BidirectionalIterator>& lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return lhs.compare(rhs) >= 0;
+    }
+
+    template<class BidirectionalIterator, class ST, class SA>
+    bool operator==(const basic_string<aux::sub_match_value_t<BidirectionalIterator>, ST, SA>& lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return -rhs.compare(aux::sub_match_string<BidirectionalIterator>(lhs)) == 0;
+    }
+
+    template<class BidirectionalIterator, class ST, class SA>
+    bool operator!=(const basic_string<aux::sub_match_value_t<BidirectionalIterator>, ST, SA>& lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return -rhs.compare(aux::sub_match_string<BidirectionalIterator>(lhs)) != 0;
+    }
+
+    template<class BidirectionalIterator, class ST, class SA>
+    bool operator<(const basic_string<aux::sub_match_value_t<BidirectionalIterator>, ST, SA>& lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return -rhs.compare(aux::sub_match_string<BidirectionalIterator>(lhs)) < 0;
+    }
+
+    template<class BidirectionalIterator, class ST, class SA>
+    bool operator<=(const basic_string<aux::sub_match_value_t<BidirectionalIterator>, ST, SA>& lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return -rhs.compare(aux::sub_match_string<BidirectionalIterator>(lhs)) <= 0;
+    }
+
+    template<class BidirectionalIterator, class ST, class SA>
+    bool operator>(const basic_string<aux::sub_match_value_t<BidirectionalIterator>, ST, SA>& lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return -rhs.compare(aux::sub_match_string<BidirectionalIterator>(lhs)) > 0;
+    }
+
+    template<class BidirectionalIterator, class ST, class SA>
+    bool operator>=(const basic_string<aux::sub_match_value_t<BidirectionalIterator>, ST, SA>& lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return -rhs.compare(aux::sub_match_string<BidirectionalIterator>(lhs)) >= 0;
+    }
+
+    template<class BidirectionalIterator, class ST, class SA>
+    bool operator==(const sub_match<BidirectionalIterator>& lhs, const basic_string<aux::sub_match_value_t<BidirectionalIterator>, ST, SA>& rhs)
+    {
+        return lhs.compare(aux::sub_match_string<BidirectionalIterator>(rhs)) == 0;
+    }
+
+    template<class BidirectionalIterator, class ST, class SA>
+    bool operator!=(const sub_match<BidirectionalIterator>& lhs, const basic_string<aux::sub_match_value_t<BidirectionalIterator>, ST, SA>& rhs)
+    {
+        return lhs.compare(aux::sub_match_string<BidirectionalIterator>(rhs)) != 0;
+    }
+
+    template<class BidirectionalIterator, class ST, class SA>
+    bool operator<(const sub_match<BidirectionalIterator>& lhs, const basic_string<aux::sub_match_value_t<BidirectionalIterator>, ST, SA>& rhs)
+    {
+        return lhs.compare(aux::sub_match_string<BidirectionalIterator>(rhs)) < 0;
+    }
+
+    template<class BidirectionalIterator, class ST, class SA>
+    bool operator<=(const sub_match<BidirectionalIterator>& lhs, const basic_string<aux::sub_match_value_t<BidirectionalIterator>, ST, SA>& rhs)
+    {
+        return lhs.compare(aux::sub_match_string<BidirectionalIterator>(rhs)) <= 0;
+    }
+
+    template<class BidirectionalIterator, class ST, class SA>
+    bool operator>(const sub_match<BidirectionalIterator>& lhs, const basic_string<aux::sub_match_value_t<BidirectionalIterator>, ST, SA>& rhs)
+    {
+        return lhs.compare(aux::sub_match_string<BidirectionalIterator>(rhs)) > 0;
+    }
+
+    template<class BidirectionalIterator, class ST, class SA>
+    bool operator>=(const sub_match<BidirectionalIterator>& lhs, const basic_string<aux::sub_match_value_t<BidirectionalIterator>, ST, SA>& rhs)
+    {
+        return lhs.compare(aux::sub_match_string<BidirectionalIterator>(rhs)) >= 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator==(const aux::sub_match_value_t<BidirectionalIterator>* lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return -rhs.compare(lhs) == 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator!=(const aux::sub_match_value_t<BidirectionalIterator>* lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return -rhs.compare(lhs) != 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator<(const aux::sub_match_value_t<BidirectionalIterator>* lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return -rhs.compare(lhs) < 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator<=(const aux::sub_match_value_t<BidirectionalIterator>* lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return -rhs.compare(lhs) <= 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator>(const aux::sub_match_value_t<BidirectionalIterator>* lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return -rhs.compare(lhs) > 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator>=(const aux::sub_match_value_t<BidirectionalIterator>* lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return -rhs.compare(lhs) >= 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator==(const sub_match<BidirectionalIterator>& lhs, const aux::sub_match_value_t<BidirectionalIterator>* rhs)
+    {
+        return lhs.compare(rhs) == 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator!=(const sub_match<BidirectionalIterator>& lhs, const aux::sub_match_value_t<BidirectionalIterator>* rhs)
+    {
+        return lhs.compare(rhs) != 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator<(const sub_match<BidirectionalIterator>& lhs, const aux::sub_match_value_t<BidirectionalIterator>* rhs)
+    {
+        return lhs.compare(rhs) < 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator<=(const sub_match<BidirectionalIterator>& lhs, const aux::sub_match_value_t<BidirectionalIterator>* rhs)
+    {
+        return lhs.compare(rhs) <= 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator>(const sub_match<BidirectionalIterator>& lhs, const aux::sub_match_value_t<BidirectionalIterator>* rhs)
+    {
+        return lhs.compare(rhs) > 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator>=(const sub_match<BidirectionalIterator>& lhs, const aux::sub_match_value_t<BidirectionalIterator>* rhs)
+    {
+        return lhs.compare(rhs) >= 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator==(const aux::sub_match_value_t<BidirectionalIterator>& lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return -rhs.compare(typename sub_match<BidirectionalIterator>::string_type(1, lhs)) == 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator!=(const aux::sub_match_value_t<BidirectionalIterator>& lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return -rhs.compare(typename sub_match<BidirectionalIterator>::string_type(1, lhs)) != 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator<(const aux::sub_match_value_t<BidirectionalIterator>& lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return -rhs.compare(typename sub_match<BidirectionalIterator>::string_type(1, lhs)) < 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator<=(const aux::sub_match_value_t<BidirectionalIterator>& lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return -rhs.compare(typename sub_match<BidirectionalIterator>::string_type(1, lhs)) <= 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator>(const aux::sub_match_value_t<BidirectionalIterator>& lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return -rhs.compare(typename sub_match<BidirectionalIterator>::string_type(1, lhs)) > 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator>=(const aux::sub_match_value_t<BidirectionalIterator>& lhs, const sub_match<BidirectionalIterator>& rhs)
+    {
+        return -rhs.compare(typename sub_match<BidirectionalIterator>::string_type(1, lhs)) >= 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator==(const sub_match<BidirectionalIterator>& lhs, const aux::sub_match_value_t<BidirectionalIterator>& rhs)
+    {
+        return lhs.compare(typename sub_match<BidirectionalIterator>::string_type(1, rhs)) == 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator!=(const sub_match<BidirectionalIterator>& lhs, const aux::sub_match_value_t<BidirectionalIterator>& rhs)
+    {
+        return lhs.compare(typename sub_match<BidirectionalIterator>::string_type(1, rhs)) != 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator<(const sub_match<BidirectionalIterator>& lhs, const aux::sub_match_value_t<BidirectionalIterator>& rhs)
+    {
+        return lhs.compare(typename sub_match<BidirectionalIterator>::string_type(1, rhs)) < 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator<=(const sub_match<BidirectionalIterator>& lhs, const aux::sub_match_value_t<BidirectionalIterator>& rhs)
+    {
+        return lhs.compare(typename sub_match<BidirectionalIterator>::string_type(1, rhs)) <= 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator>(const sub_match<BidirectionalIterator>& lhs, const aux::sub_match_value_t<BidirectionalIterator>& rhs)
+    {
+        return lhs.compare(typename sub_match<BidirectionalIterator>::string_type(1, rhs)) > 0;
+    }
+
+    template<class BidirectionalIterator>
+    bool operator>=(const sub_match<BidirectionalIterator>& lhs, const aux::sub_match_value_t<BidirectionalIterator>& rhs)
+    {
+        return lhs.compare(typename sub_match<BidirectionalIterator>::string_type(1, rhs)) >= 0;
+    }
+
+    template<class charT, class ST, class BidirectionalIterator>
+    basic_ostream<charT, ST>& operator<<(basic_ostream<charT, ST>& os,
+                                         const sub_match<BidirectionalIterator>& m)
+    {
+        return os << m.str();
+    }
+}
+
+#endif
@@ -136,7 +136,11 @@ namespace std
 
         static constexpr int_type to_int_type(char_type c) noexcept
         {
-            return static_cast<int_type>(c);
+            /**
+             * Through unsigned char, otherwise the byte 0xFF
+             * would be indistinguishable from eof().
+             */
+            return static_cast<int_type>(static_cast<unsigned char>(c));
         }
 
         static constexpr bool eq_int_type(int_type c1, int_type c2) noexcept
@@ -462,7 +466,6 @@ namespace std
             /**
              * 21.4.2, construct/copy/destroy:
              * TODO: tagged constructor that moves the char*
-             *       and use that with asprintf in to_string
              */
 
             basic_string() noexcept
@@ -470,7 +473,7 @@ namespace std
             { /* DUMMY BODY */ }
 
             explicit basic_string(const allocator_type& alloc)
-                : data_{}, size_{}, capacity_{}, allocator_{alloc}
+                : data_{local_}, size_{}, allocator_{alloc}
             {
                 /**
                  * Postconditions:
@@ -478,29 +481,24 @@ namespace std
                  *  size() = 0
                  *  capacity() = unspecified
                  */
-                data_ = allocator_.allocate(default_capacity_);
-                capacity_ = default_capacity_;
+                ensure_null_terminator_();
             }
 
             basic_string(const basic_string& other)
-                : data_{}, size_{other.size_}, capacity_{other.capacity_},
-                  allocator_{other.allocator_}
+                : data_{local_}, size_{}, allocator_{other.allocator_}
             {
-                init_(other.data(), size_);
+                init_(other.data(), other.size_);
             }
 
             basic_string(basic_string&& other)
-                : data_{other.data_}, size_{other.size_},
-                  capacity_{other.capacity_}, allocator_{move(other.allocator_)}
+                : data_{local_}, size_{}, allocator_{move(other.allocator_)}
             {
-                other.data_ = nullptr;
-                other.size_ = 0;
-                other.capacity_ = 0;
+                steal_(other);
             }
 
             basic_string(const basic_string& other, size_type pos, size_type n = npos,
                          const allocator_type& alloc = allocator_type{})
-                : data_{}, size_{}, capacity_{}, allocator_{alloc}
+                : data_{local_}, size_{}, allocator_{alloc}
             {
                 // TODO: if pos < other.size() throw out_of_range.
                 auto len = min(n, other.size() - pos);
@@ -508,21 +506,23 @@ namespace std
             }
 
             basic_string(const value_type* str, size_type n, const allocator_type& alloc = allocator_type{})
-                : data_{}, size_{n}, capacity_{n}, allocator_{alloc}
+                : data_{local_}, size_{}, allocator_{alloc}
             {
-                init_(str, size_);
+                init_(str, n);
             }
 
             basic_string(const value_type* str, const allocator_type& alloc = allocator_type{})
-                : data_{}, size_{}, capacity_{}, allocator_{alloc}
+                : data_{local_}, size_{}, allocator_{alloc}
             {
                 init_(str, traits_type::length(str));
             }
 
             basic_string(size_type n, value_type c, const allocator_type& alloc = allocator_type{})
-                : data_{}, size_{n}, capacity_{n}, allocator_{alloc}
+                : data_{local_}, size_{}, allocator_{alloc}
             {
-                data_ = allocator_.allocate(capacity_);
+                resize_without_copy_(n + 1);
+                size_ = n;
+
                 for (size_type i = 0; i < size_; ++i)
                     traits_type::assign(data_[i], c);
                 ensure_null_terminator_();
@@ -531,13 +531,12 @@ namespace std
             template<class InputIterator>
             basic_string(InputIterator first, InputIterator last,
                          const allocator_type& alloc = allocator_type{})
-                : data_{}, size_{}, capacity_{}, allocator_{alloc}
+                : data_{local_}, size_{}, allocator_{alloc}
             {
                 if constexpr (is_integral<InputIterator>::value)
                 { // Required by the standard.
+                    resize_without_copy_(static_cast<size_type>(first) + 1);
                     size_ = static_cast<size_type>(first);
-                    capacity_ = size_;
-                    data_ = allocator_.allocate(capacity_);
 
                     for (size_type i = 0; i < size_; ++i)
                         traits_type::assign(data_[i], static_cast<value_type>(last));
@@ -555,22 +554,23 @@ namespace std
             { /* DUMMY BODY */ }
 
             basic_string(const basic_string& other, const allocator_type& alloc)
-                : data_{}, size_{other.size_}, capacity_{other.capacity_}, allocator_{alloc}
+                : data_{local_}, size_{}, allocator_{alloc}
             {
-                init_(other.data(), size_);
+                init_(other.data(), other.size_);
             }
 
             basic_string(basic_string&& other, const allocator_type& alloc)
-                : data_{other.data_}, size_{other.size_}, capacity_{other.capacity_}, allocator_{alloc}
+                : data_{local_}, size_{}, allocator_{alloc}
             {
-                other.data_ = nullptr;
-                other.size_ = 0;
-                other.capacity_ = 0;
+                if (allocator_ == other.allocator_)
+                    steal_(other);
+                else
+                    init_(other.data(), other.size_);
             }
 
             ~basic_string()
             {
-                allocator_.deallocate(data_, capacity_);
+                release_();
             }
 
             basic_string& operator=(const basic_string& other)
@@ -589,7 +589,10 @@ namespace std
                          allocator_traits<allocator_type>::is_always_equal::value)
             {
                 if (this != &other)
-                    swap(other);
+                {
+                    release_();
+                    steal_(other);
+                }
 
                 return *this;
             }
@@ -704,9 +707,9 @@ namespace std
                 // TODO: if new_size > max_size() throw length_error.
                 if (new_size > size_)
                 {
-                    ensure_free_space_(new_size - size_ + 1);
+                    ensure_free_space_(new_size - size_);
                     for (size_type i = size_; i < new_size; ++i)
-                        traits_type::assign(data_[i], i);
+                        traits_type::assign(data_[i], c);
                 }
 
                 size_ = new_size;
@@ -720,7 +723,8 @@ namespace std
 
             size_type capacity() const noexcept
             {
-                return capacity_;
+                // One slot is reserved for the null terminator.
+                return storage_size_() - 1;
             }
 
             void reserve(size_type new_capacity = 0)
@@ -728,16 +732,37 @@ namespace std
                 // TODO: if new_capacity > max_size() throw
                 //       length_error (this function shall have no
                 //       effect in such case)
-                if (new_capacity > capacity_)
-                    resize_with_copy_(size_, new_capacity);
-                else if (new_capacity < capacity_)
+                if (new_capacity > capacity())
+                    resize_with_copy_(size_, new_capacity + 1);
+                else if (new_capacity < capacity())
                     shrink_to_fit(); // Non-binding request, but why not.
             }
 
             void shrink_to_fit()
             {
-                if (size_ != capacity_)
-                    resize_with_copy_(size_, capacity_);
+                if (is_local_() || heap_capacity_ == size_ + 1)
+                    return;
+
+                if (size_ < local_size_)
+                {
+                    auto old_data = data_;
+                    auto old_capacity = heap_capacity_;
+
+                    data_ = local_;
+                    traits_type::copy(data_, old_data, size_);
+                    allocator_.deallocate(old_data, old_capacity);
+                }
+                else
+                {
+                    auto new_data = allocator_.allocate(size_ + 1);
+                    traits_type::copy(new_data, data_, size_);
+
+                    release_();
+                    data_ = new_data;
+                    heap_capacity_ = size_ + 1;
+                }
+
+                ensure_null_terminator_();
             }
 
             void clear() noexcept
@@ -907,8 +932,21 @@ namespace std
             basic_string& assign(const value_type* str, size_type n)
             {
                 // TODO: if (n > max_size()) throw length_error.
-                resize_without_copy_(n);
-                traits_type::copy(begin(), str, n);
+                if (n < storage_size_())
+                {
+                    // Str can point into our own buffer.
+                    traits_type::move(data_, str, n);
+                }
+                else
+                {
+                    auto new_data = allocator_.allocate(n + 1);
+                    traits_type::copy(new_data, str, n);
+
+                    release_();
+                    data_ = new_data;
+                    heap_capacity_ = n + 1;
+                }
+
                 size_ = n;
                 ensure_null_terminator_();
 
@@ -1031,7 +1069,7 @@ namespace std
             basic_string& erase(size_type pos = 0, size_type n = npos)
             {
                 auto len = min(n, size_ - pos);
-                copy_(begin() + pos + n, end(), begin() + pos);
+                copy_(begin() + pos + len, end(), begin() + pos);
                 size_ -= len;
                 ensure_null_terminator_();
 
@@ -1083,7 +1121,7 @@ namespace std
                 auto len = min(n1, size_ - pos);
 
                 basic_string tmp{};
-                tmp.resize_without_copy_(size_ - len + n2);
+                tmp.resize_without_copy_(size_ - len + n2 + 1);
 
                 // Prefix.
                 copy_(begin(), begin() + pos, tmp.begin());
@@ -1095,6 +1133,7 @@ namespace std
                 copy_(begin() + pos + len, end(), tmp.begin() + pos + n2);
 
                 tmp.size_ = size_ - len + n2;
+                tmp.ensure_null_terminator_();
                 swap(tmp);
                 return *this;
             }
@@ -1160,9 +1199,22 @@ namespace std
                 noexcept(allocator_traits<allocator_type>::propagate_on_container_swap::value ||
                          allocator_traits<allocator_type>::is_always_equal::value)
             {
-                std::swap(data_, other.data_);
-                std::swap(size_, other.size_);
-                std::swap(capacity_, other.capacity_);
+                if (!is_local_() && !other.is_local_())
+                {
+                    std::swap(data_, other.data_);
+                    std::swap(size_, other.size_);
+                    std::swap(heap_capacity_, other.heap_capacity_);
+                }
+                else
+                {
+                    /**
+                     * Inline buffers cannot be exchanged by
+                     * swapping pointers, move through a temporary.
+                     */
+                    basic_string tmp{move(other)};
+                    other.steal_(*this);
+                    steal_(tmp);
+                }
             }
 
             /**
@@ -1476,31 +1528,85 @@ namespace std
             }
 
         private:
+            /**
+             * Number of elements (including the null terminator)
+             * that fit into the inline buffer, for char this
+             * means strings of up to 15 characters never
+             * allocate.
+             */
+            static constexpr size_type local_size_{
+                sizeof(value_type) < 16 ? 16 / sizeof(value_type) : 1
+            };
+
+            /**
+             * Data_ always points to the characters, either to
+             * local_ or to the heap, so that data() and c_str()
+             * need no branch. The heap capacity is only needed
+             * when the buffer is not inline, so it shares
+             * space with it.
+             */
             value_type* data_;
             size_type size_;
-            size_type capacity_;
+            union
+            {
+                size_type heap_capacity_;
+                value_type local_[local_size_];
+            };
             allocator_type allocator_;
 
             template<class C, class T, class A>
             friend class basic_stringbuf;
 
+            bool is_local_() const noexcept
+            {
+                return data_ == local_;
+            }
+
+            size_type storage_size_() const noexcept
+            {
+                return is_local_() ? local_size_ : heap_capacity_;
+            }
+
             /**
-             * Arbitrary value, standard just requires
-             * data() to have some capacity.
-             * (Well, we could've done data_ = &data_ and
-             * set capacity to 0, but that would be too cryptic.)
+             * Frees heap storage (if any) and switches back
+             * to the inline buffer, contents are lost.
              */
-            static constexpr size_type default_capacity_{4};
+            void release_()
+            {
+                if (!is_local_())
+                    allocator_.deallocate(data_, heap_capacity_);
+                data_ = local_;
+            }
+
+            /**
+             * Takes the contents of other, which is left
+             * empty. Expects that we do not own any heap
+             * storage. Short strings are simply copied.
+             */
+            void steal_(basic_string& other)
+            {
+                if (other.is_local_())
+                {
+                    data_ = local_;
+                    traits_type::copy(local_, other.local_, other.size_ + 1);
+                }
+                else
+                {
+                    data_ = other.data_;
+                    heap_capacity_ = other.heap_capacity_;
+                }
+                size_ = other.size_;
+
+                other.data_ = other.local_;
+                other.size_ = 0;
+                other.ensure_null_terminator_();
+            }
 
             void init_(const value_type* str, size_type size)
             {
-                if (data_)
-                    allocator_.deallocate(data_, capacity_);
+                resize_without_copy_(size + 1);
 
                 size_ = size;
-                capacity_ = size + 1;
-
-                data_ = allocator_.allocate(capacity_);
                 traits_type::copy(data_, str, size);
                 ensure_null_terminator_();
             }
@@ -1508,9 +1614,9 @@ namespace std
             size_type next_capacity_(size_type hint = 0) const noexcept
             {
                 if (hint != 0)
-                    return max(capacity_ * 2, hint);
+                    return max(storage_size_() * 2, hint);
                 else
-                    return max(capacity_ * 2, size_type{2u});
+                    return max(storage_size_() * 2, size_type{2u});
             }
 
             void ensure_free_space_(size_type n)
@@ -1520,36 +1626,45 @@ namespace std
                  *       did in vector, because in string
                  *       reserve can cause shrinking.
                  */
-                if (size_ + 1 + n > capacity_)
+                if (size_ + 1 + n > storage_size_())
                     resize_with_copy_(size_, max(size_ + 1 + n, next_capacity_()));
             }
 
+            /**
+             * Makes room for capacity elements (including
+             * the null terminator), contents are lost.
+             */
             void resize_without_copy_(size_type capacity)
             {
-                if (data_)
-                    allocator_.deallocate(data_, capacity_);
+                if (capacity > storage_size_())
+                {
+                    release_();
+
+                    if (capacity > local_size_)
+                    {
+                        data_ = allocator_.allocate(capacity);
+                        heap_capacity_ = capacity;
+                    }
+                }
 
-                data_ = allocator_.allocate(capacity);
                 size_ = 0;
-                capacity_ = capacity;
                 ensure_null_terminator_();
             }
 
             void resize_with_copy_(size_type size, size_type capacity)
             {
-                if(capacity_ == 0 || capacity_ < capacity)
+                if (capacity > storage_size_())
                 {
                     auto new_data = allocator_.allocate(capacity);
 
                     auto to_copy = min(size, size_);
                     traits_type::move(new_data, data_, to_copy);
 
-                    std::swap(data_, new_data);
-
-                    allocator_.deallocate(new_data, capacity_);
+                    release_();
+                    data_ = new_data;
+                    heap_capacity_ = capacity;
                 }
 
-                capacity_ = capacity;
                 size_ = size;
                 ensure_null_terminator_();
             }
@@ -39,9 +39,13 @@ namespace std
     class error_condition;
     class error_code;
 
+    /**
+     * Note: Zero is reserved for success, as in
+     *       to_chars_result and from_chars_result.
+     */
     enum class errc
     { // TODO: add matching values
-        address_family_not_supported,
+        address_family_not_supported = 1,
         address_in_use,
         address_not_available,
         already_connected,
@@ -105,6 +105,7 @@ namespace std::test
             void test_construction_and_assignment();
             void test_insert();
             void test_erase();
+            void test_non_trivial();
     };
 
     class string_test: public test_suite
@@ -123,6 +124,7 @@ namespace std::test
             void test_find();
             void test_substr();
             void test_compare();
+            void test_short_strings();
     };
 
     class bitset_test: public test_suite
@@ -254,6 +256,7 @@ namespace std::test
             void test_weak_ptr();
             void test_allocators();
             void test_pointers();
+            void test_node_pool();
     };
 
     class list_test: public test_suite
@@ -293,6 +296,7 @@ namespace std::test
         private:
             void test_non_modifying();
             void test_mutating();
+            void test_sorting();
     };
 
     class future_test: public test_suite
@@ -308,6 +312,92 @@ namespace std::test
             void test_packaged_task();
             void test_shared_future();
     };
+
+    class atomic_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+        private:
+            void test_integral();
+            void test_pointer();
+            void test_trivial();
+            void test_flag();
+            void test_free_functions();
+            void test_wait_notify();
+    };
+
+    class regex_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+        private:
+            void test_match();
+            void test_search();
+            void test_captures();
+            void test_syntax();
+            void test_backrefs();
+            void test_posix();
+            void test_replace();
+            void test_iterators();
+            void test_errors();
+    };
+
+    class fstream_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+        private:
+            void test_write_read();
+            void test_large();
+            void test_seek();
+            void test_setbuf();
+            void test_modes();
+            void test_mapped();
+    };
+
+    class valarray_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+        private:
+            void test_construction();
+            void test_operators();
+            void test_expressions();
+            void test_members();
+            void test_subsets();
+            void test_math();
+    };
+
+    class charconv_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+        private:
+            void test_to_chars_int();
+            void test_from_chars_int();
+            void test_to_chars_float();
+            void test_from_chars_float();
+            void test_streams();
+    };
+
+    class flat_hash_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+        private:
+            void test_map();
+            void test_set();
+            void test_erase();
+            void test_collisions();
+            void test_incremental_rehash();
+            void test_values();
+    };
 }
 
 #endif
@@ -29,6 +29,7 @@
 #ifndef LIBCPP_BITS_THREAD_ASYNC
 #define LIBCPP_BITS_THREAD_ASYNC
 
+#include <__bits/thread/executor.hpp>
 #include <__bits/thread/future.hpp>
 #include <__bits/thread/future_common.hpp>
 #include <__bits/thread/shared_state.hpp>
@@ -69,33 +70,27 @@ namespace std
             /**
              * Note: The case when async | deferred is set in policy
              *       is implementation defined, feel free to change.
-             * Rationale: We chose the 'deferred' policy, because unlike
-             *            the 'async' policy it carries no possible
-             *            surprise ('async' can fail due to thread
-             *            creation error).
+             * Rationale: We chose the 'async' policy, because the
+             *            tasks run in the executor's thread pool,
+             *            so they do not need to create a thread
+             *            and cannot fail because of that. Only
+             *            if the executor has no workers, we fall
+             *            back to 'deferred'.
              */
             if (async && deferred)
+                async = executor::instance().worker_count() > 0;
+
+            if (async)
             {
-                return future<result_t>{
-                    new aux::deferred_shared_state<
-                        result_t, F, Args...
-                    >{forward<F>(f), forward<Args>(args)...}
-                };
-            }
-            else if (async)
-            {
-                return future<result_t>{
-                    new aux::async_shared_state<
-                        result_t, F, Args...
-                    >{forward<F>(f), forward<Args>(args)...}
-                };
+                auto state = new aux::async_shared_state<
+                    result_t, F, Args...
+                >{forward<F>(f), forward<Args>(args)...};
+                state->launch();
+
+                return future<result_t>{state};
             }
             else if (deferred)
             {
-               /**
-                * Duplicated on purpose because of the default.
-                * Do not remove!
-                */
                 return future<result_t>{
                     new aux::deferred_shared_state<
                         result_t, F, Args...
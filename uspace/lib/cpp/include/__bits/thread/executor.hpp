@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LIBCPP_BITS_THREAD_EXECUTOR
+#define LIBCPP_BITS_THREAD_EXECUTOR
+
+#include <__bits/thread/threading.hpp>
+#include <cstdlib>
+
+namespace std::aux
+{
+    class executor;
+
+    /**
+     * Unit of work run by the executor, tasks are linked
+     * directly into the worker queues so submitting one
+     * does not allocate.
+     */
+    class executor_task
+    {
+        public:
+            virtual void run() = 0;
+
+        protected:
+            ~executor_task() = default;
+
+        private:
+            executor_task* prev_{};
+            executor_task* next_{};
+
+            /**
+             * Queue the task currently sits in, null once
+             * it has been taken out by a worker or revoked.
+             */
+            void* queue_{};
+
+            friend class executor;
+    };
+
+    /**
+     * Pool of worker fibrils that runs std::async tasks,
+     * one worker per CPU. Every worker owns a queue, it
+     * takes new work from the back of its own queue and
+     * when that is empty, steals from the front of the
+     * queues of the other workers. Idle workers sleep
+     * on a condition variable, so they do not occupy
+     * runner threads.
+     */
+    class executor
+    {
+        public:
+            static executor& instance();
+
+            /**
+             * Returns false if the executor has no workers,
+             * the caller has to run the task itself then.
+             */
+            bool submit(executor_task* task);
+
+            /**
+             * Removes the task from its queue if no worker
+             * has taken it yet, in which case the caller is
+             * responsible for running it and true is returned.
+             */
+            bool revoke(executor_task* task);
+
+            size_t worker_count() const noexcept;
+
+        private:
+            struct worker
+            {
+                executor* exec;
+                size_t index;
+                thread_t fid;
+
+                mutex_t mtx;
+                executor_task* head;
+                executor_task* tail;
+            };
+
+            worker* workers_;
+            size_t worker_count_;
+
+            mutex_t idle_mtx_;
+            condvar_t idle_cv_;
+            size_t pending_;
+            size_t next_;
+
+            executor();
+
+            executor_task* pop_(worker& w);
+            executor_task* steal_(worker& w);
+            executor_task* pop_front_(worker& w);
+            void unlink_(worker& w, executor_task* task);
+
+            static int worker_main_(void* arg);
+    };
+}
+
+#endif
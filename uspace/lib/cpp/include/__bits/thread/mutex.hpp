@@ -117,7 +117,7 @@ namespace std
             {
                 auto time = aux::threading::time::convert(rel_time);
 
-                return aux::threading::mutex::try_lock_for(time);
+                return aux::threading::mutex::try_lock_for(mtx_, time);
             }
 
             template<class Clock, class Duration>
@@ -126,7 +126,7 @@ namespace std
                 auto dur = (abs_time - Clock::now());
                 auto time = aux::threading::time::convert(dur);
 
-                return aux::threading::mutex::try_lock_for(time);
+                return aux::threading::mutex::try_lock_for(mtx_, time);
             }
 
             using native_handle_type = aux::mutex_t*;
@@ -161,30 +161,18 @@ namespace std
             template<class Rep, class Period>
             bool try_lock_for(const chrono::duration<Rep, Period>& rel_time)
             {
-                if (owner_ == this_thread::get_id())
-                    return true;
-
                 auto time = aux::threading::time::convert(rel_time);
-                auto ret = aux::threading::mutex::try_lock_for(time);
 
-                if (ret)
-                    ++lock_level_;
-                return ret;
+                return try_lock_for_(time);
             }
 
             template<class Clock, class Duration>
             bool try_lock_until(const chrono::time_point<Clock, Duration>& abs_time)
             {
-                if (owner_ == this_thread::get_id())
-                    return true;
-
                 auto dur = (abs_time - Clock::now());
                 auto time = aux::threading::time::convert(dur);
-                auto ret = aux::threading::mutex::try_lock_for(time);
 
-                if (ret)
-                    ++lock_level_;
-                return ret;
+                return try_lock_for_(time);
             }
 
             using native_handle_type = aux::mutex_t*;
@@ -194,6 +182,8 @@ namespace std
             aux::mutex_t mtx_;
             size_t lock_level_;
             thread::id owner_;
+
+            bool try_lock_for_(aux::time_unit_t time);
     };
 
     struct defer_lock_t
@@ -216,7 +216,7 @@ namespace std
             }
 
         private:
-            function<R(Args...)> func_;
+            __ext::move_only_function<R(Args...)> func_;
 
             aux::shared_state<R>* state_;
     };
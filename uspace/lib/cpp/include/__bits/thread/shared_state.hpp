@@ -37,6 +37,7 @@
 #include <__bits/functional/function.hpp>
 #include <__bits/functional/invoke.hpp>
 #include <__bits/refcount_obj.hpp>
+#include <__bits/thread/executor.hpp>
 #include <__bits/thread/future_common.hpp>
 #include <__bits/thread/threading.hpp>
 #include <cerrno>
@@ -206,10 +207,9 @@ namespace std::aux
                 aux::threading::mutex::lock(mutex_);
                 value_ = val;
                 value_set_ = set;
-                aux::threading::mutex::unlock(mutex_);
-
                 if (set)
                     aux::threading::condvar::broadcast(condvar_);
+                aux::threading::mutex::unlock(mutex_);
             }
 
             void set_value(R&& val, bool set = true)
@@ -217,10 +217,9 @@ namespace std::aux
                 aux::threading::mutex::lock(mutex_);
                 value_ = std::move(val);
                 value_set_ = set;
-                aux::threading::mutex::unlock(mutex_);
-
                 if (set)
                     aux::threading::condvar::broadcast(condvar_);
+                aux::threading::mutex::unlock(mutex_);
             }
 
             R& get()
@@ -242,8 +241,10 @@ namespace std::aux
 
             void set_value()
             {
+                aux::threading::mutex::lock(mutex_);
                 value_set_ = true;
                 aux::threading::condvar::broadcast(condvar_);
+                aux::threading::mutex::unlock(mutex_);
             }
 
             void get()
@@ -269,43 +270,55 @@ namespace std::aux
      * R template parameter and void.
      */
 
+    /**
+     * The function is run by the executor's workers. A waiter
+     * that gets to the state before any worker does takes the
+     * task back from the executor and runs it itself, which
+     * also prevents workers from blocking on tasks that sit
+     * in their own queue.
+     */
     template<class R, class F, class... Args>
-    class async_shared_state: public shared_state<R>
+    class async_shared_state: public shared_state<R>, public executor_task
     {
         public:
-            async_shared_state(F&& f, Args&&... args)
-                : shared_state<R>{}, thread_{}
+            template<class G>
+            async_shared_state(G&& f, Args&&... args)
+                : shared_state<R>{}, func_{forward<F>(f)},
+                  args_{forward<Args>(args)...}
+            { /* DUMMY BODY */ }
+
+            /**
+             * Hands the task to the executor, if there are
+             * no workers to run it, it is run right away.
+             */
+            void launch()
             {
-                thread_ = thread{
-                    [=](){
-                        try
-                        {
-                            if constexpr (!is_same_v<R, void>)
-                                this->set_value(invoke(f, args...));
-                            else
-                            {
-                                invoke(f, args...);
-                                this->mark_set(true);
-                            }
-                        }
-                        catch(const exception& __exception)
-                        {
-                            this->set_exception(make_exception_ptr(__exception));
-                        }
-                    }
-                };
+                if (!executor::instance().submit(this))
+                    run();
+            }
+
+            void run() override
+            {
+                /**
+                 * Note: The state can be destroyed as soon as
+                 *       it is marked ready, so nothing may touch
+                 *       it after that.
+                 */
+                invoke_(make_index_sequence<sizeof...(Args)>{});
             }
 
             void destroy() override
             {
-                if (!this->is_set())
-                    thread_.join();
+                wait();
             }
 
             void wait() const override
             {
-                if (!this->is_set())
-                    const_cast<thread&>(thread_).join();
+                auto self = const_cast<async_shared_state*>(this);
+                if (executor::instance().revoke(self))
+                    self->run();
+
+                shared_state<R>::wait();
             }
 
             ~async_shared_state() override
@@ -314,21 +327,31 @@ namespace std::aux
             }
 
         protected:
-            future_status timed_wait_(aux::time_unit_t time) const override
+            __ext::move_only_function<R(decay_t<Args>...)> func_;
+            tuple<decay_t<Args>...> args_;
+
+            template<size_t... Is>
+            void invoke_(index_sequence<Is...>)
             {
-                /**
-                 * Note: Currently we have no timed join, but this
-                 *       behaviour should be compliant.
-                 */
-                aux::threading::time::sleep(time);
-                if (this->value_set_)
-                    return future_status::ready;
-                else
-                    return future_status::timeout;
+                try
+                {
+                    if constexpr (!is_same_v<R, void>)
+                        this->set_value(invoke(move(func_), get<Is>(move(args_))...));
+                    else
+                    {
+                        invoke(move(func_), get<Is>(move(args_))...);
+                        this->set_value();
+                    }
+                }
+                catch(const exception& __exception)
+                {
+                    aux::threading::mutex::lock(this->mutex_);
+                    this->set_exception(make_exception_ptr(__exception));
+                    this->value_set_ = true;
+                    aux::threading::condvar::broadcast(this->condvar_);
+                    aux::threading::mutex::unlock(this->mutex_);
+                }
             }
-
-        private:
-            thread thread_;
     };
 
     template<class R, class F, class... Args>
@@ -343,10 +366,11 @@ namespace std::aux
 
             void destroy() override
             {
-                aux::threading::mutex::lock(this->mutex_);
+                /**
+                 * Note: Synchronization done in invoke_ -> set_value.
+                 */
                 if (!this->is_set())
                     invoke_(make_index_sequence<sizeof...(Args)>{});
-                aux::threading::mutex::unlock(this->mutex_);
             }
 
             void wait() const override
@@ -368,7 +392,7 @@ namespace std::aux
             }
 
         protected:
-            function<R(decay_t<Args>...)> func_;
+            __ext::move_only_function<R(decay_t<Args>...)> func_;
             tuple<decay_t<Args>...> args_;
 
             template<size_t... Is>
@@ -72,7 +72,9 @@ namespace std
 
                 void detach()
                 {
+                    aux::threading::mutex::lock(join_mtx_);
                     detached_ = true;
+                    aux::threading::mutex::unlock(join_mtx_);
                 }
 
                 bool detached() const
@@ -80,6 +82,8 @@ namespace std
                     return detached_;
                 }
 
+                virtual ~joinable_wrapper() = default;
+
             protected:
                 aux::mutex_t join_mtx_;
                 aux::condvar_t join_cv_;
@@ -95,15 +99,26 @@ namespace std
                     : joinable_wrapper{}, callable_{forward<Callable>(clbl)}
                 { /* DUMMY BODY */ }
 
-                void operator()()
+                /**
+                 * Returns true if the thread was detached, in which
+                 * case it is the caller who destroys the wrapper.
+                 */
+                bool operator()()
                 {
                     callable_();
 
+                    /**
+                     * The joining thread may destroy us as soon
+                     * as it sees finished_, so broadcast before
+                     * letting go of the mutex.
+                     */
                     aux::threading::mutex::lock(join_mtx_);
                     finished_ = true;
+                    bool detached = detached_;
+                    aux::threading::condvar::broadcast(join_cv_);
                     aux::threading::mutex::unlock(join_mtx_);
 
-                    aux::threading::condvar::broadcast(join_cv_);
+                    return detached;
                 }
 
             private:
@@ -137,8 +152,8 @@ namespace std
             explicit thread(F&& f, Args&&... args)
                 : id_{}
             {
-                auto callable = [=](){
-                    return f(forward<Args>(args)...);
+                auto callable = [=]() mutable {
+                    return f(move(args)...);
                 };
 
                 auto callable_wrapper = new aux::callable_wrapper<decltype(callable)>{move(callable)};
@@ -194,9 +209,7 @@ namespace std
                 return 1;
 
             auto callable = static_cast<CallablePtr>(clbl);
-            (*callable)();
-
-            if (callable->detached())
+            if ((*callable)())
                 delete callable;
 
             return 0;
@@ -29,7 +29,9 @@
 #ifndef LIBCPP_BITS_THREAD_THREADING
 #define LIBCPP_BITS_THREAD_THREADING
 
+#include <cerrno>
 #include <chrono>
+#include <type_traits>
 
 #include <fibril.h>
 #include <fibril_synch.h>
@@ -77,6 +79,16 @@ namespace std::aux
                 ::helenos::fibril_yield();
             }
 
+            /**
+             * Gives the task a runner (i.e. a kernel thread
+             * that runs fibrils) per CPU, so that fibrils
+             * can run in parallel.
+             */
+            static void enable_multithreaded()
+            {
+                ::helenos::fibril_enable_multithreaded();
+            }
+
             /**
              * Note: join & detach are performed at the C++
              *       level at the moment, but eventually should
@@ -108,8 +120,11 @@ namespace std::aux
 
             static bool try_lock_for(mutex_type& mtx, time_unit timeout)
             {
-                // TODO: we need fibril_mutex_trylock_for() :/
-                return try_lock(mtx);
+                // Zero means no timeout to fibril_mutex_lock_timeout.
+                if (timeout <= 0)
+                    return try_lock(mtx);
+
+                return ::helenos::fibril_mutex_lock_timeout(&mtx, timeout) == EOK;
             }
         };
 
@@ -192,7 +207,7 @@ namespace std::aux
 
             static bool try_lock_shared(shared_mutex_type& mtx)
             {
-                lock(mtx);
+                lock_shared(mtx);
 
                 return true;
             }
@@ -204,7 +219,7 @@ namespace std::aux
 
             static bool try_lock_shared_for(shared_mutex_type& mtx, time_unit timeout)
             {
-                return try_lock(mtx);
+                return try_lock_shared(mtx);
             }
         };
     };
@@ -29,8 +29,10 @@
 #include <__bits/test/tests.hpp>
 #include <algorithm>
 #include <array>
+#include <functional>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace std::test
 {
@@ -41,6 +43,7 @@ namespace std::test
 
         test_non_modifying();
         test_mutating();
+        test_sorting();
 
         return end();
     }
@@ -292,5 +295,101 @@ namespace std::test
             data10.begin(), data10.end()
         );
         test_eq("transform pt2", res6, data10.end());
+
+        auto check8 = {4, 5, 6, 1, 2, 3};
+        std::array<int, 6> data11{1, 2, 3, 4, 5, 6};
+
+        auto res7 = std::rotate(
+            data11.begin(), data11.begin() + 3, data11.end()
+        );
+        test_eq(
+            "rotate pt1",
+            check8.begin(), check8.end(),
+            data11.begin(), data11.end()
+        );
+        test_eq("rotate pt2", res7, &data11[3]);
+    }
+
+    void algorithm_test::test_sorting()
+    {
+        std::vector<int> data1{};
+        for (int i = 0; i < 200; ++i)
+            data1.push_back((i * 7919) % 211);
+        auto data2 = data1;
+        auto data3 = data1;
+
+        std::sort(data1.begin(), data1.end());
+        test("sort pt1", std::is_sorted(data1.begin(), data1.end()));
+
+        std::sort(data2.begin(), data2.end(), std::greater<int>{});
+        test(
+            "sort pt2",
+            std::is_sorted(data2.begin(), data2.end(), std::greater<int>{})
+        );
+
+        std::make_heap(data3.begin(), data3.end());
+        std::sort_heap(data3.begin(), data3.end());
+        test_eq(
+            "sort_heap",
+            data1.begin(), data1.end(),
+            data3.begin(), data3.end()
+        );
+
+        /**
+         * Sort by the first element only, the second
+         * one records the original order.
+         */
+        std::vector<std::pair<int, int>> data4{};
+        for (int i = 0; i < 100; ++i)
+            data4.emplace_back(i % 3, i);
+
+        std::stable_sort(
+            data4.begin(), data4.end(),
+            [](const auto& lhs, const auto& rhs){
+                return lhs.first < rhs.first;
+            }
+        );
+        auto res1 = std::is_sorted(
+            data4.begin(), data4.end(),
+            [](const auto& lhs, const auto& rhs){
+                return lhs < rhs;
+            }
+        );
+        test("stable_sort", res1);
+
+        auto check1 = {0, 1, 2, 3, 4};
+        std::array<int, 10> data5{9, 3, 7, 1, 0, 8, 2, 6, 4, 5};
+        std::partial_sort(data5.begin(), data5.begin() + 5, data5.end());
+        test_eq(
+            "partial_sort",
+            check1.begin(), check1.end(),
+            data5.begin(), data5.begin() + 5
+        );
+
+        std::array<int, 10> data6{9, 3, 7, 1, 0, 8, 2, 6, 4, 5};
+        std::array<int, 5> data7{};
+        auto res2 = std::partial_sort_copy(
+            data6.begin(), data6.end(),
+            data7.begin(), data7.end()
+        );
+        test_eq(
+            "partial_sort_copy pt1",
+            check1.begin(), check1.end(),
+            data7.begin(), data7.end()
+        );
+        test_eq("partial_sort_copy pt2", res2, data7.end());
+
+        std::nth_element(data6.begin(), data6.begin() + 6, data6.end());
+        auto res3 = std::all_of(
+            data6.begin(), data6.begin() + 6,
+            [](auto x){ return x < 6; }
+        );
+        test_eq("nth_element pt1", data6[6], 6);
+        test("nth_element pt2", res3);
+
+        auto res4 = std::lower_bound(data1.begin(), data1.end(), 100);
+        auto res5 = std::upper_bound(data1.begin(), data1.end(), 100);
+        test_eq("lower_bound", *res4, 100);
+        test("upper_bound", res5 == data1.end() || *res5 > 100);
     }
 }
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace
+{
+    struct pair_type
+    {
+        std::uint32_t first;
+        std::uint32_t second;
+    };
+
+    struct big_type
+    {
+        char data[40];
+    };
+}
+
+namespace std::test
+{
+    bool atomic_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_integral();
+        test_pointer();
+        test_trivial();
+        test_flag();
+        test_free_functions();
+        test_wait_notify();
+
+        return end();
+    }
+
+    const char* atomic_test::name()
+    {
+        return "atomic";
+    }
+
+    void atomic_test::test_integral()
+    {
+        std::atomic<int> a{5};
+        test_eq("load", a.load(), 5);
+        test("is_lock_free", a.is_lock_free());
+
+        a.store(7, std::memory_order_release);
+        test_eq("store", a.load(std::memory_order_acquire), 7);
+
+        test_eq("exchange pt1", a.exchange(10), 7);
+        test_eq("exchange pt2", a.load(), 10);
+
+        test_eq("fetch_add pt1", a.fetch_add(5), 10);
+        test_eq("fetch_add pt2", a.load(), 15);
+        test_eq("fetch_sub pt1", a.fetch_sub(3, std::memory_order_relaxed), 15);
+        test_eq("fetch_sub pt2", a.load(), 12);
+        test_eq("fetch_and", (a.fetch_and(0x6), a.load()), 0x4);
+        test_eq("fetch_or", (a.fetch_or(0x3), a.load()), 0x7);
+        test_eq("fetch_xor", (a.fetch_xor(0x5), a.load()), 0x2);
+
+        test_eq("operator++ prefix", ++a, 3);
+        test_eq("operator++ postfix", a++, 3);
+        test_eq("operator-- prefix", --a, 3);
+        test_eq("operator+=", a += 10, 13);
+        test_eq("operator-=", a -= 3, 10);
+        test_eq("operator=", a = 42, 42);
+        test_eq("implicit load", static_cast<int>(a), 42);
+
+        int expected{41};
+        test("compare_exchange_strong failure pt1", !a.compare_exchange_strong(expected, 1));
+        test_eq("compare_exchange_strong failure pt2", expected, 42);
+        test("compare_exchange_strong success pt1", a.compare_exchange_strong(expected, 1));
+        test_eq("compare_exchange_strong success pt2", a.load(), 1);
+
+        expected = 1;
+        while (!a.compare_exchange_weak(expected, 2, std::memory_order_acq_rel))
+        { /* DUMMY BODY */ }
+        test_eq("compare_exchange_weak", a.load(), 2);
+
+        std::atomic<std::uint64_t> b{~std::uint64_t{}};
+        test_eq("uint64 fetch_add wraps", (b.fetch_add(1), b.load()), std::uint64_t{});
+
+        std::atomic<bool> c{false};
+        test("bool exchange pt1", !c.exchange(true));
+        test("bool exchange pt2", c.load());
+    }
+
+    void atomic_test::test_pointer()
+    {
+        int arr[]{1, 2, 3, 4};
+        std::atomic<int*> p{arr};
+
+        test_eq("fetch_add", p.fetch_add(2), &arr[0]);
+        test_eq("fetch_add scaled", p.load(), &arr[2]);
+        test_eq("operator--", --p, &arr[1]);
+        test_eq("operator+=", p += 2, &arr[3]);
+        test_eq("fetch_sub", (p.fetch_sub(3), p.load()), &arr[0]);
+
+        int* expected{&arr[0]};
+        test("compare_exchange", p.compare_exchange_strong(expected, &arr[1]));
+        test_eq("deref", *p.load(), 2);
+    }
+
+    void atomic_test::test_trivial()
+    {
+        std::atomic<pair_type> a{pair_type{1, 2}};
+        test("small struct is_lock_free", a.is_lock_free());
+
+        auto old = a.exchange(pair_type{3, 4});
+        test("exchange pt1", old.first == 1 && old.second == 2);
+        test("exchange pt2", a.load().first == 3);
+
+        pair_type expected{3, 4};
+        test("compare_exchange", a.compare_exchange_strong(expected, pair_type{5, 6}));
+        test_eq("compare_exchange value", a.load().second, 6U);
+
+        std::atomic<big_type> b{};
+        test("big struct is not lock free", !b.is_lock_free());
+        big_type val{};
+        val.data[39] = 'x';
+        b.store(val);
+        test_eq("big store/load", b.load().data[39], 'x');
+    }
+
+    void atomic_test::test_flag()
+    {
+        std::atomic_flag flag = ATOMIC_FLAG_INIT;
+
+        test("test_and_set pt1", !flag.test_and_set());
+        test("test_and_set pt2", flag.test_and_set());
+        test("test", flag.test());
+        flag.clear(std::memory_order_release);
+        test("clear", !flag.test());
+        test("free test_and_set", !std::atomic_flag_test_and_set(&flag));
+        std::atomic_flag_clear(&flag);
+        test("free clear", !flag.test());
+    }
+
+    void atomic_test::test_free_functions()
+    {
+        std::atomic<long> a{};
+        std::atomic_init(&a, 3L);
+        test_eq("atomic_init", std::atomic_load(&a), 3L);
+
+        std::atomic_store_explicit(&a, 4L, std::memory_order_relaxed);
+        test_eq("atomic_store", std::atomic_load_explicit(&a, std::memory_order_relaxed), 4L);
+        test_eq("atomic_exchange", std::atomic_exchange(&a, 5L), 4L);
+        test_eq("atomic_fetch_add", std::atomic_fetch_add(&a, 1), 5L);
+        test_eq("atomic_fetch_or", std::atomic_fetch_or(&a, 8L), 6L);
+        test_eq("atomic_fetch_and", std::atomic_fetch_and(&a, 4L), 14L);
+
+        long expected{4L};
+        test(
+            "atomic_compare_exchange_strong",
+            std::atomic_compare_exchange_strong(&a, &expected, 9L)
+        );
+        test_eq("atomic_compare_exchange_strong value", a.load(), 9L);
+        test("atomic_is_lock_free", std::atomic_is_lock_free(&a));
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+
+    void atomic_test::test_wait_notify()
+    {
+        std::atomic<int> a{};
+
+        /**
+         * Waiting for a value that has already changed
+         * must not block.
+         */
+        a.wait(1);
+        test("wait changed", true);
+
+        std::atomic<int> done{};
+        std::thread thr{[&a, &done]() {
+            for (int i = 0; i < 100; ++i)
+            {
+                a.wait(2 * i);
+                a.store(2 * i + 2);
+                a.notify_one();
+            }
+            done.store(1);
+            done.notify_all();
+        }};
+
+        /**
+         * Ping-pong: the main thread makes the value odd,
+         * the other thread makes it even again.
+         */
+        for (int i = 0; i < 100; ++i)
+        {
+            a.store(2 * i + 1);
+            a.notify_one();
+            a.wait(2 * i + 1);
+        }
+        done.wait(0);
+        thr.join();
+
+        test_eq("ping-pong", a.load(), 200);
+        test_eq("done", done.load(), 1);
+    }
+}
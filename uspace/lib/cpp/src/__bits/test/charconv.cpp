@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    template<class... Args>
+    std::string to_str(Args... args)
+    {
+        char buf[128];
+        auto res = std::to_chars(buf, buf + sizeof(buf), args...);
+
+        return std::string(buf, static_cast<std::size_t>(res.ptr - buf));
+    }
+
+    template<class T>
+    bool round_trips(T val)
+    {
+        char buf[64];
+        auto res1 = std::to_chars(buf, buf + sizeof(buf), val);
+
+        T tmp{};
+        auto res2 = std::from_chars(buf, res1.ptr, tmp);
+
+        return res2.ec == std::errc{} && res2.ptr == res1.ptr && tmp == val;
+    }
+}
+
+namespace std::test
+{
+    bool charconv_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_to_chars_int();
+        test_from_chars_int();
+        test_to_chars_float();
+        test_from_chars_float();
+        test_streams();
+
+        return end();
+    }
+
+    const char* charconv_test::name()
+    {
+        return "charconv";
+    }
+
+    void charconv_test::test_to_chars_int()
+    {
+        test_eq("zero", to_str(0), std::string{"0"});
+        test_eq("positive", to_str(1234567890), std::string{"1234567890"});
+        test_eq("negative", to_str(-42), std::string{"-42"});
+        test_eq("int min", to_str(std::numeric_limits<int>::min()), std::string{"-2147483648"});
+        test_eq(
+            "unsigned long long max",
+            to_str(std::numeric_limits<unsigned long long>::max()),
+            std::string{"18446744073709551615"}
+        );
+        test_eq(
+            "long long min",
+            to_str(std::numeric_limits<long long>::min()),
+            std::string{"-9223372036854775808"}
+        );
+        test_eq("signed char min", to_str(static_cast<signed char>(-128)), std::string{"-128"});
+
+        test_eq("base 2", to_str(10, 2), std::string{"1010"});
+        test_eq("base 8", to_str(511, 8), std::string{"777"});
+        test_eq("base 16", to_str(0xbeef, 16), std::string{"beef"});
+        test_eq("base 16 negative", to_str(-255, 16), std::string{"-ff"});
+        test_eq("base 36", to_str(35, 36), std::string{"z"});
+        test_eq("base 7", to_str(49, 7), std::string{"100"});
+
+        char buf[4];
+        auto res = std::to_chars(buf, buf + sizeof(buf), 12345);
+        test_eq("too large error", res.ec, std::errc::value_too_large);
+        test_eq("too large ptr", res.ptr, buf + sizeof(buf));
+
+        res = std::to_chars(buf, buf + sizeof(buf), 1234);
+        test_eq("exact fit error", res.ec, std::errc{});
+        test_eq("exact fit ptr", res.ptr, buf + sizeof(buf));
+    }
+
+    void charconv_test::test_from_chars_int()
+    {
+        const char* str1 = "12345xyz";
+        int val1{};
+        auto res1 = std::from_chars(str1, str1 + std::strlen(str1), val1);
+        test_eq("value", val1, 12345);
+        test_eq("stops at first non digit", res1.ptr, str1 + 5);
+        test_eq("no error", res1.ec, std::errc{});
+
+        const char* str2 = "-7f";
+        int val2{};
+        std::from_chars(str2, str2 + 3, val2, 16);
+        test_eq("negative hex", val2, -0x7f);
+
+        const char* str3 = "+1";
+        int val3{42};
+        auto res3 = std::from_chars(str3, str3 + 2, val3);
+        test_eq("plus sign invalid", res3.ec, std::errc::invalid_argument);
+        test_eq("invalid ptr", res3.ptr, str3);
+        test_eq("invalid keeps value", val3, 42);
+
+        const char* str4 = "300";
+        unsigned char val4{7};
+        auto res4 = std::from_chars(str4, str4 + 3, val4);
+        test_eq("overflow error", res4.ec, std::errc::result_out_of_range);
+        test_eq("overflow ptr", res4.ptr, str4 + 3);
+        test_eq("overflow keeps value", val4, 7U);
+
+        const char* str5 = "-128";
+        signed char val5{};
+        auto res5 = std::from_chars(str5, str5 + 4, val5);
+        test_eq("signed min no error", res5.ec, std::errc{});
+        test_eq("signed min", val5, -128);
+
+        const char* str6 = "-5";
+        unsigned val6{3};
+        auto res6 = std::from_chars(str6, str6 + 2, val6);
+        test_eq("minus for unsigned invalid", res6.ec, std::errc::invalid_argument);
+
+        const char* str7 = "18446744073709551615";
+        unsigned long long val7{};
+        std::from_chars(str7, str7 + std::strlen(str7), val7);
+        test_eq("unsigned long long max", val7, std::numeric_limits<unsigned long long>::max());
+
+        const char* str8 = "ZzZ";
+        int val8{};
+        std::from_chars(str8, str8 + 3, val8, 36);
+        test_eq("base 36 mixed case", val8, 35 * 36 * 36 + 35 * 36 + 35);
+    }
+
+    void charconv_test::test_to_chars_float()
+    {
+        test_eq("shortest simple", to_str(0.1), std::string{"0.1"});
+        test_eq("shortest integer", to_str(100.0), std::string{"100"});
+        test_eq("shortest prefers scientific", to_str(1e22), std::string{"1e+22"});
+        test_eq("shortest small", to_str(1e-7), std::string{"1e-07"});
+        test_eq("shortest negative zero", to_str(-0.0), std::string{"-0"});
+        test_eq("shortest float", to_str(0.3f), std::string{"0.3"});
+        test_eq("shortest max exponent", to_str(1e308), std::string{"1e+308"});
+        test_eq("shortest denormal min", to_str(5e-324), std::string{"5e-324"});
+        test_eq("shortest fixed", to_str(1e22, std::chars_format::fixed), std::string{"10000000000000000000000"});
+        test_eq("shortest scientific", to_str(1234.5, std::chars_format::scientific), std::string{"1.2345e+03"});
+        test_eq("shortest general", to_str(0.0001, std::chars_format::general), std::string{"0.0001"});
+        test_eq("shortest general exponent", to_str(0.00001, std::chars_format::general), std::string{"1e-05"});
+        test_eq("shortest hex", to_str(1.5, std::chars_format::hex), std::string{"1.8p+0"});
+        test_eq("shortest beats grisu", to_str(1e23), std::string{"1e+23"});
+        test_eq("shortest beats grisu fixed", to_str(4.7386607e19), std::string{"4.7386607e+19"});
+        test_eq("shortest beats grisu long", to_str(4.9719072e21), std::string{"4.9719072e+21"});
+        test_eq("shortest closest", to_str(0.0013436424411240122), std::string{"0.0013436424411240122"});
+        test_eq("shortest closest max", to_str(1.7976931348623157e308), std::string{"1.7976931348623157e+308"});
+
+        test("round trip double", round_trips(0.1) && round_trips(1.0 / 3) && round_trips(1.7976931348623157e308));
+        test("round trip float", round_trips(0.1f) && round_trips(3.4028235e38f) && round_trips(1e-45f));
+
+        test_eq("fixed precision", to_str(3.14159, std::chars_format::fixed, 2), std::string{"3.14"});
+        test_eq("fixed rounds half to even", to_str(0.125, std::chars_format::fixed, 2), std::string{"0.12"});
+        test_eq("fixed exact value", to_str(449.0, std::chars_format::fixed, 2), std::string{"449.00"});
+        test_eq("fixed carry", to_str(9.996, std::chars_format::fixed, 2), std::string{"10.00"});
+        test_eq("fixed zero precision", to_str(2.5, std::chars_format::fixed, 0), std::string{"2"});
+        test_eq(
+            "fixed long", to_str(0.1, std::chars_format::fixed, 20),
+            std::string{"0.10000000000000000555"}
+        );
+        test_eq("scientific precision", to_str(123456.0, std::chars_format::scientific, 3), std::string{"1.235e+05"});
+        test_eq("scientific carry", to_str(9.9999, std::chars_format::scientific, 2), std::string{"1.00e+01"});
+        test_eq("scientific zero", to_str(0.0, std::chars_format::scientific, 2), std::string{"0.00e+00"});
+        test_eq("general precision", to_str(123456.0, std::chars_format::general, 6), std::string{"123456"});
+        test_eq("general switches", to_str(1234567.0, std::chars_format::general, 6), std::string{"1.23457e+06"});
+        test_eq("general carry", to_str(99.99, std::chars_format::general, 2), std::string{"1e+02"});
+        test_eq("general trims", to_str(0.5, std::chars_format::general, 6), std::string{"0.5"});
+        test_eq("hex precision", to_str(1.0 / 3, std::chars_format::hex, 3), std::string{"1.555p-2"});
+        test_eq("hex precision carry", to_str(1.96875, std::chars_format::hex, 1), std::string{"2.0p+0"});
+
+        test_eq("infinity", to_str(__builtin_huge_val()), std::string{"inf"});
+        test_eq("negative infinity", to_str(-__builtin_huge_val()), std::string{"-inf"});
+        test_eq("nan", to_str(__builtin_nan("")), std::string{"nan"});
+
+        char buf[3];
+        auto res = std::to_chars(buf, buf + sizeof(buf), 1.25);
+        test_eq("float too large error", res.ec, std::errc::value_too_large);
+        test_eq("float too large ptr", res.ptr, buf + sizeof(buf));
+    }
+
+    void charconv_test::test_from_chars_float()
+    {
+        const char* str1 = "1.5e3x";
+        double val1{};
+        auto res1 = std::from_chars(str1, str1 + 6, val1);
+        test_eq("value", val1, 1500.0);
+        test_eq("ptr after exponent", res1.ptr, str1 + 5);
+
+        const char* str2 = "2e";
+        double val2{};
+        auto res2 = std::from_chars(str2, str2 + 2, val2);
+        test_eq("dangling exponent value", val2, 2.0);
+        test_eq("dangling exponent ptr", res2.ptr, str2 + 1);
+
+        const char* str3 = "1e5";
+        double val3{};
+        auto res3 = std::from_chars(str3, str3 + 3, val3, std::chars_format::fixed);
+        test_eq("fixed ignores exponent", res3.ptr, str3 + 1);
+
+        res3 = std::from_chars(str3, str3 + 1, val3, std::chars_format::scientific);
+        test_eq("scientific requires exponent", res3.ec, std::errc::invalid_argument);
+
+        const char* str4 = "1.8p1";
+        double val4{};
+        std::from_chars(str4, str4 + 5, val4, std::chars_format::hex);
+        test_eq("hex", val4, 3.0);
+
+        const char* str5 = "9007199254740993";
+        double val5{};
+        std::from_chars(str5, str5 + std::strlen(str5), val5);
+        test_eq("halfway rounds to even", val5, 9007199254740992.0);
+
+        const char* str6 = "2.4703282292062328e-324";
+        double val6{};
+        std::from_chars(str6, str6 + std::strlen(str6), val6);
+        test_eq("just above half denormal min", val6, 5e-324);
+
+        const char* str7 = "1e400";
+        double val7{1.0};
+        auto res7 = std::from_chars(str7, str7 + 5, val7);
+        test_eq("overflow error", res7.ec, std::errc::result_out_of_range);
+        test_eq("overflow keeps value", val7, 1.0);
+
+        const char* str8 = "-InFiNiTy";
+        double val8{};
+        auto res8 = std::from_chars(str8, str8 + 9, val8);
+        test_eq("infinity", val8, -__builtin_huge_val());
+        test_eq("infinity ptr", res8.ptr, str8 + 9);
+
+        const char* str9 = "nan(123)";
+        double val9{};
+        auto res9 = std::from_chars(str9, str9 + 8, val9);
+        test("nan", val9 != val9);
+        test_eq("nan ptr", res9.ptr, str9 + 8);
+
+        const char* str10 = ".";
+        double val10{};
+        auto res10 = std::from_chars(str10, str10 + 1, val10);
+        test_eq("no digits", res10.ec, std::errc::invalid_argument);
+
+        const char* str11 = "3.4028235e38";
+        float val11{};
+        auto res11 = std::from_chars(str11, str11 + std::strlen(str11), val11);
+        test_eq("float rounds to max", val11, std::numeric_limits<float>::max());
+        test_eq("float no error", res11.ec, std::errc{});
+
+        const char* str12 = "3.4028236e38";
+        auto res12 = std::from_chars(str12, str12 + std::strlen(str12), val11);
+        test_eq("float rounds to infinity", res12.ec, std::errc::result_out_of_range);
+    }
+
+    void charconv_test::test_streams()
+    {
+        std::ostringstream oss1{};
+        oss1 << 42 << ' ' << -7L << ' ' << 18446744073709551615ULL;
+        test_eq("integers", oss1.str(), std::string{"42 -7 18446744073709551615"});
+
+        std::ostringstream oss2{};
+        oss2 << std::hex << 255 << ' ' << std::uppercase << 255 << ' ' << std::oct << 8;
+        test_eq("bases", oss2.str(), std::string{"ff FF 10"});
+
+        std::ostringstream oss3{};
+        oss3 << 0.1 << ' ' << 1e100 << ' ' << 123456789.0;
+        test_eq("default floats", oss3.str(), std::string{"0.1 1e+100 1.23457e+08"});
+
+        std::ostringstream oss4{};
+        oss4.precision(3);
+        oss4 << std::fixed << 2.0 / 3 << ' ' << std::scientific << 2.0 / 3;
+        test_eq("precision", oss4.str(), std::string{"0.667 6.667e-01"});
+
+        std::ostringstream oss5{};
+        oss5 << std::fixed << 1e100;
+        test_eq("fixed longer than the stream buffer", oss5.str().size(), 108U);
+
+        std::ostringstream oss6{};
+        oss6.width(6);
+        oss6 << 42;
+        test_eq("width", oss6.str(), std::string{"    42"});
+
+        test_eq("to_string int", std::to_string(-123), std::string{"-123"});
+        test_eq("to_string double", std::to_string(1.5), std::string{"1.500000"});
+        test_eq("to_string large", std::to_string(1e20), std::string{"100000000000000000000.000000"});
+    }
+}
@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/mock.hpp>
+#include <__bits/test/tests.hpp>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace
+{
+    /**
+     * Puts all keys into the same few probe runs so that
+     * backward shifts and wrapping around the end of the
+     * slot array get exercised.
+     */
+    struct bad_hash
+    {
+        std::size_t operator()(int x) const noexcept
+        {
+            return static_cast<std::size_t>(x % 3);
+        }
+    };
+}
+
+namespace std::test
+{
+    bool flat_hash_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_map();
+        test_set();
+        test_erase();
+        test_collisions();
+        test_incremental_rehash();
+        test_values();
+
+        return end();
+    }
+
+    const char* flat_hash_test::name()
+    {
+        return "flat_hash";
+    }
+
+    void flat_hash_test::test_map()
+    {
+        auto check1 = {1, 2, 3, 4, 5, 6, 7};
+        auto src1 = {
+            std::pair<const int, int>{3, 3},
+            std::pair<const int, int>{1, 1},
+            std::pair<const int, int>{5, 5},
+            std::pair<const int, int>{2, 2},
+            std::pair<const int, int>{7, 7},
+            std::pair<const int, int>{6, 6},
+            std::pair<const int, int>{4, 4}
+        };
+
+        std::__ext::flat_hash_map<int, int> m0{};
+        test_eq("default constructed empty", m0.empty(), true);
+        test_eq("default constructed does not allocate", m0.bucket_count(), 0U);
+        test("find in empty", m0.find(1) == m0.end());
+
+        std::__ext::flat_hash_map<int, int> m1{src1};
+        test_contains(
+            "initializer list initialization",
+            check1.begin(), check1.end(), m1
+        );
+        test_eq("size", m1.size(), 7U);
+
+        std::__ext::flat_hash_map<int, int> m2{m1};
+        test_contains("copy initialization", check1.begin(), check1.end(), m2);
+        test("copy equal", m1 == m2);
+
+        std::__ext::flat_hash_map<int, int> m3{std::move(m2)};
+        test_contains("move initialization", check1.begin(), check1.end(), m3);
+        test_eq("move initialization - origin empty", m2.size(), 0U);
+
+        m2 = m3;
+        test_contains("copy assignment", check1.begin(), check1.end(), m2);
+
+        auto res1 = m1.emplace(8, 8);
+        test("emplace new", res1.second);
+        test_eq("emplace new key", res1.first->first, 8);
+
+        auto res2 = m1.emplace(8, 9);
+        test("emplace existing", !res2.second);
+        test_eq("emplace existing value", res2.first->second, 8);
+
+        auto res3 = m1.try_emplace(9, 9);
+        test("try_emplace new", res3.second);
+
+        auto res4 = m1.insert_or_assign(9, 10);
+        test("insert_or_assign existing", !res4.second);
+        test_eq("insert_or_assign value", m1.at(9), 10);
+
+        m1[10] = 10;
+        ++m1[10];
+        test_eq("operator[]", m1[10], 11);
+        test_eq("size after insertions", m1.size(), 10U);
+        test("not equal", m1 != m2);
+
+        std::size_t count{};
+        for (const auto& x: m1)
+        {
+            if (m1.find(x.first) != m1.end())
+                ++count;
+        }
+        test_eq("iteration visits all", count, m1.size());
+
+        test_eq("count", m1.count(10), 1U);
+        test_eq("count missing", m1.count(42), 0U);
+        test("contains", m1.contains(3));
+
+        m1.clear();
+        test_eq("clear", m1.size(), 0U);
+        test("clear keeps buckets", m1.bucket_count() > 0);
+        test("find after clear", m1.find(3) == m1.end());
+    }
+
+    void flat_hash_test::test_set()
+    {
+        auto check1 = {1, 2, 3, 4, 5, 6, 7};
+        std::__ext::flat_hash_set<int> s1{3, 1, 5, 2, 7, 6, 4};
+        test_contains("initializer list initialization", check1.begin(), check1.end(), s1);
+        test_eq("size", s1.size(), 7U);
+
+        auto res1 = s1.insert(4);
+        test("insert existing", !res1.second);
+        test_eq("insert existing iterator", *res1.first, 4);
+
+        auto res2 = s1.emplace(8);
+        test("emplace new", res2.second);
+        test_eq("erase", s1.erase(8), 1U);
+        test_eq("erase missing", s1.erase(8), 0U);
+
+        std::__ext::flat_hash_set<int> s2{7, 6, 5, 4, 3, 2, 1};
+        test("equality", s1 == s2);
+
+        std::__ext::flat_hash_set<std::string> s3{};
+        s3.insert("alpha");
+        s3.insert("beta");
+        s3.insert(std::string{"gamma"});
+        test("string contains", s3.contains("beta"));
+        test("string missing", !s3.contains("delta"));
+    }
+
+    void flat_hash_test::test_erase()
+    {
+        std::__ext::flat_hash_map<int, int> m1{};
+        for (int i = 0; i < 1000; ++i)
+            m1.emplace(i, i);
+
+        for (int i = 0; i < 1000; i += 2)
+            m1.erase(i);
+        test_eq("erase half", m1.size(), 500U);
+
+        bool ok{true};
+        for (int i = 0; i < 1000; ++i)
+        {
+            auto it = m1.find(i);
+            if ((i % 2 == 0) != (it == m1.end()))
+                ok = false;
+            else if (it != m1.end() && it->second != i)
+                ok = false;
+        }
+        test("lookups after erase", ok);
+
+        std::size_t visited{};
+        for (auto it = m1.begin(); it != m1.end();)
+        {
+            ++visited;
+            if (it->first % 3 == 0)
+                it = m1.erase(it);
+            else
+                ++it;
+        }
+        test_eq("erase while iterating visits all", visited, 500U);
+        test_eq("erase while iterating size", m1.size(), 333U);
+
+        ok = true;
+        for (const auto& x: m1)
+        {
+            if (x.first % 2 == 0 || x.first % 3 == 0)
+                ok = false;
+        }
+        test("erase while iterating erases matching", ok);
+
+        for (auto it = m1.begin(); it != m1.end();)
+            it = m1.erase(it);
+        test_eq("erase everything", m1.size(), 0U);
+        test("erase everything begin", m1.begin() == m1.end());
+    }
+
+    void flat_hash_test::test_collisions()
+    {
+        std::__ext::flat_hash_set<int, bad_hash> s1{};
+        for (int i = 0; i < 300; ++i)
+            s1.insert(i);
+        test_eq("colliding insert", s1.size(), 300U);
+
+        bool ok{true};
+        for (int i = 0; i < 300; ++i)
+        {
+            if (!s1.contains(i))
+                ok = false;
+        }
+        test("colliding lookup", ok);
+
+        for (int i = 0; i < 300; i += 7)
+            s1.erase(i);
+
+        ok = true;
+        for (int i = 0; i < 300; ++i)
+        {
+            if (s1.contains(i) == (i % 7 == 0))
+                ok = false;
+        }
+        test("colliding erase", ok);
+
+        std::size_t visited{};
+        for (auto it = s1.begin(); it != s1.end();)
+        {
+            ++visited;
+            if (*it % 2 == 0)
+                it = s1.erase(it);
+            else
+                ++it;
+        }
+        test_eq("colliding erase while iterating visits all", visited, 257U);
+
+        ok = true;
+        for (int i = 0; i < 300; ++i)
+        {
+            if (s1.contains(i) != (i % 2 == 1 && i % 7 != 0))
+                ok = false;
+        }
+        test("colliding erase while iterating", ok);
+    }
+
+    void flat_hash_test::test_incremental_rehash()
+    {
+        std::__ext::flat_hash_map<int, int> m1{};
+        std::size_t capacity{};
+        bool migrated{};
+        bool ok{true};
+
+        for (int i = 0; i < 10000; ++i)
+        {
+            m1.emplace(i, 2 * i);
+            if (m1.bucket_count() != capacity)
+            {
+                capacity = m1.bucket_count();
+
+                /**
+                 * Check lookups right after growing, while
+                 * most of the elements still live in the old
+                 * array.
+                 */
+                if (m1.__migrating_bucket_count() > 0)
+                {
+                    migrated = true;
+                    for (int j = 0; j <= i; ++j)
+                    {
+                        auto it = m1.find(j);
+                        if (it == m1.end() || it->second != 2 * j)
+                            ok = false;
+                    }
+
+                    std::size_t count{};
+                    for (auto it = m1.begin(); it != m1.end(); ++it)
+                        ++count;
+                    if (count != m1.size())
+                        ok = false;
+
+                    m1.erase(i);
+                    if (m1.contains(i) || m1.size() != static_cast<std::size_t>(i))
+                        ok = false;
+                    m1.emplace(i, 2 * i);
+                }
+            }
+        }
+        test("growth is incremental", migrated);
+        test("lookups during migration", ok);
+        test_eq("size after growth", m1.size(), 10000U);
+        test("load factor bound", m1.load_factor() <= m1.max_load_factor());
+
+        m1.reserve(100000);
+        test_eq("reserve finishes migration", m1.__migrating_bucket_count(), 0U);
+        test("reserve grows", m1.bucket_count() * m1.max_load_factor() >= 100000);
+
+        ok = true;
+        for (int i = 0; i < 10000; ++i)
+        {
+            if (m1.at(i) != 2 * i)
+                ok = false;
+        }
+        test("lookups after reserve", ok);
+
+        m1.rehash(0);
+        test("rehash shrinks", m1.bucket_count() < 100000);
+        test_eq("size after rehash", m1.size(), 10000U);
+    }
+
+    void flat_hash_test::test_values()
+    {
+        mock::clear();
+        {
+            std::__ext::flat_hash_map<int, mock> m1{};
+            for (int i = 0; i < 1000; ++i)
+                m1.try_emplace(i);
+
+            for (int i = 0; i < 1000; i += 3)
+                m1.erase(i);
+
+            test_eq("values constructed once", mock::constructor_calls, 1000U);
+            test_eq("values never copied", mock::copy_constructor_calls, 0U);
+        }
+        test_eq(
+            "all values destroyed",
+            mock::constructor_calls + mock::copy_constructor_calls +
+            mock::move_constructor_calls, mock::destructor_calls
+        );
+
+        std::__ext::flat_hash_map<std::string, std::string> m2{};
+        for (int i = 0; i < 200; ++i)
+            m2[std::to_string(i)] = std::to_string(i * i);
+        for (int i = 0; i < 200; i += 2)
+            m2.erase(std::to_string(i));
+
+        bool ok{true};
+        for (int i = 0; i < 200; ++i)
+        {
+            auto it = m2.find(std::to_string(i));
+            if (i % 2 == 0)
+                ok = ok && it == m2.end();
+            else
+                ok = ok && it != m2.end() && it->second == std::to_string(i * i);
+        }
+        test("string keys and values", ok);
+    }
+}
@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <utility>
+
+namespace
+{
+    /**
+     * Note: The test needs a writable /tmp,
+     *       which is a tmpfs in the default
+     *       configuration.
+     */
+    const char* path = "/tmp/cpptest_fstream";
+
+    std::string contents()
+    {
+        std::ifstream in{path};
+        std::string res{};
+
+        char buf[64];
+        while (in.read(buf, sizeof(buf)), in.gcount() > 0)
+            res.append(buf, static_cast<std::size_t>(in.gcount()));
+
+        return res;
+    }
+
+    std::string pattern(std::size_t size)
+    {
+        std::string res{};
+        res.reserve(size);
+
+        for (std::size_t i = 0; i < size; ++i)
+            res.push_back(static_cast<char>('a' + (i * 7) % 26));
+
+        return res;
+    }
+}
+
+namespace std::test
+{
+    bool fstream_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_write_read();
+        test_large();
+        test_seek();
+        test_setbuf();
+        test_modes();
+        test_mapped();
+
+        std::remove(path);
+
+        return end();
+    }
+
+    const char* fstream_test::name()
+    {
+        return "fstream";
+    }
+
+    void fstream_test::test_write_read()
+    {
+        {
+            std::ofstream out{path};
+            test("open for writing", out.is_open());
+
+            out << "hello " << 42 << '\n';
+            out.write("world\n", 6);
+        }
+        test_eq("contents after close", contents(), std::string{"hello 42\nworld\n"});
+
+        std::ifstream in{path};
+        std::string word{};
+        int num{};
+        in >> word >> num;
+        test_eq("formatted read string", word, std::string{"hello"});
+        test_eq("formatted read number", num, 42);
+
+        in.get();
+        char buf[16]{};
+        in.read(buf, 16);
+        test_eq("short read count", in.gcount(), 6);
+        test("short read sets eof", in.eof());
+        test_eq("short read data", std::string{buf}, std::string{"world\n"});
+
+        std::ifstream missing{"/tmp/cpptest_fstream_missing"};
+        test("open missing file fails", !missing.is_open() && missing.fail());
+
+        std::filebuf buf1{};
+        buf1.open(path, std::ios_base::in);
+        std::filebuf buf2{std::move(buf1)};
+        test("move construction source closed", !buf1.is_open());
+        test("move construction destination open", buf2.is_open());
+        test_eq("moved filebuf reads", static_cast<char>(buf2.sbumpc()), 'h');
+
+        {
+            std::ofstream out{path, std::ios_base::out | std::ios_base::binary};
+            out.put('\xff');
+        }
+        std::ifstream bin{path, std::ios_base::in | std::ios_base::binary};
+        test_eq("byte 0xff is not eof", bin.get(), 0xff);
+    }
+
+    void fstream_test::test_large()
+    {
+        /**
+         * Larger than the buffer so that the direct
+         * transfers are used, not a multiple of the
+         * page size so that the tail goes through it.
+         */
+        auto data = pattern(3 * 4096 + 123);
+        {
+            std::ofstream out{path};
+            out << 'x';
+            out.write(data.data(), static_cast<std::streamsize>(data.size()));
+            out << 'y';
+        }
+
+        std::string res(data.size() + 2, '\0');
+        std::ifstream in{path};
+        in.read(&res[0], 1);
+        in.read(&res[1], static_cast<std::streamsize>(data.size() + 1));
+        test_eq("large read count", in.gcount(), static_cast<std::streamsize>(data.size() + 1));
+        test_eq("large write and read", res, std::string{"x"} + data + "y");
+        test_eq("eof after large read", in.get(), std::ifstream::traits_type::eof());
+    }
+
+    void fstream_test::test_seek()
+    {
+        {
+            std::ofstream out{path};
+            out << "0123456789";
+            test_eq("tellp", static_cast<int>(out.tellp()), 10);
+
+            out.seekp(2);
+            out << "ab";
+            test_eq("tellp after seekp", static_cast<int>(out.tellp()), 4);
+        }
+        test_eq("overwrite after seekp", contents(), std::string{"01ab456789"});
+
+        std::ifstream in{path};
+        in.seekg(5);
+        test_eq("get after seekg", in.get(), '5');
+        test_eq("tellg", static_cast<int>(in.tellg()), 6);
+
+        in.seekg(-3, std::ios_base::end);
+        test_eq("seekg from end", in.get(), '7');
+
+        in.seekg(-5, std::ios_base::cur);
+        test_eq("seekg backwards from current", in.get(), 'b');
+
+        in.seekg(0);
+        test_eq("seekg to beginning", in.get(), '0');
+
+        std::fstream io{path, std::ios_base::in | std::ios_base::out};
+        test_eq("read before write", io.get(), '0');
+        io.seekp(0, std::ios_base::cur);
+        io.put('X');
+        io.seekg(0);
+        std::string line{};
+        io >> line;
+        test_eq("mixed reads and writes", line, std::string{"0Xab456789"});
+    }
+
+    void fstream_test::test_setbuf()
+    {
+        char buf[8];
+        {
+            std::ofstream out{};
+            out.rdbuf()->pubsetbuf(buf, sizeof(buf));
+            out.open(path);
+            out << "user buffer is small";
+        }
+        test_eq("user buffer", contents(), std::string{"user buffer is small"});
+
+        {
+            std::ofstream out{};
+            out.rdbuf()->pubsetbuf(nullptr, 0);
+            out.open(path);
+            out << "unbuffered";
+            test_eq("unbuffered write is immediate", contents(), std::string{"unbuffered"});
+        }
+
+        {
+            std::ofstream out{path};
+            out << "flush";
+            out.flush();
+            test_eq("flush writes the buffer", contents(), std::string{"flush"});
+        }
+    }
+
+    void fstream_test::test_modes()
+    {
+        {
+            std::ofstream out{path};
+            out << "first";
+        }
+        {
+            std::ofstream out{path, std::ios_base::app};
+            out << " second";
+        }
+        test_eq("append", contents(), std::string{"first second"});
+
+        {
+            std::fstream io{path, std::ios_base::in | std::ios_base::out | std::ios_base::ate};
+            test_eq("ate starts at the end", static_cast<int>(io.tellp()), 12);
+            io << '!';
+        }
+        test_eq("write at the end", contents(), std::string{"first second!"});
+
+        {
+            std::ofstream out{path, std::ios_base::out | std::ios_base::trunc};
+        }
+        test_eq("truncate", contents(), std::string{});
+
+        std::filebuf buf{};
+        test("invalid mode", !buf.open(path, std::ios_base::trunc));
+    }
+
+    void fstream_test::test_mapped()
+    {
+        auto data = pattern(2 * 4096 + 7);
+        {
+            std::ofstream out{path};
+            out << data;
+        }
+
+        std::ifstream in{path, std::ios_base::in | std::__ext::mapped};
+        test("mapped open", in.is_open());
+        test_eq("mapped data available", in.rdbuf()->in_avail(),
+                static_cast<std::streamsize>(data.size()));
+
+        std::string res(data.size(), '\0');
+        in.read(&res[0], static_cast<std::streamsize>(data.size()));
+        test_eq("mapped read", res, data);
+
+        in.seekg(4096);
+        test_eq("mapped seekg", in.get(), static_cast<int>(data[4096]));
+        test_eq("mapped tellg", static_cast<int>(in.tellg()), 4097);
+
+        in.seekg(1, std::ios_base::end);
+        test("mapped seekg past the end fails", in.fail());
+    }
+}
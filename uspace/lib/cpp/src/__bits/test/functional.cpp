@@ -28,7 +28,9 @@
 
 #include <__bits/test/tests.hpp>
 #include <functional>
+#include <memory>
 #include <type_traits>
+#include <typeinfo>
 #include <utility>
 
 using namespace std::placeholders;
@@ -121,6 +123,56 @@ namespace std::test
         test("function operator bool", (bool)f2);
         f2 = nullptr;
         test("function nullptr assignment", !f2);
+
+        test(
+            "function target_type",
+            f1.target_type() == typeid(int (*)(int, int))
+        );
+        test_eq("function target", *f1.target<int (*)(int, int)>(), &aux::f1);
+        test("function target of wrong type", f1.target<int>() == nullptr);
+
+        std::function<int(int, int)> f3{f1};
+        test_eq("function copy", f3(3, 4), 7);
+
+        std::function<int(int, int)> f4{std::move(f3)};
+        test_eq("function move", f4(3, 4), 7);
+        test("function moved from is empty", !f3);
+
+        int (*null_ptr)(int, int) = nullptr;
+        std::function<int(int, int)> f5{null_ptr};
+        test("function from null pointer is empty", !f5);
+
+        /**
+         * This one is too big for the inline
+         * buffer and has to be allocated.
+         */
+        long big[8]{1, 2, 3, 4, 5, 6, 7, 8};
+        std::function<int(int, int)> f6{[big](int a, int b){ return a + b + big[7]; }};
+        test_eq("function big callable", f6(1, 2), 11);
+
+        f4.swap(f6);
+        test_eq("function swap small with big pt1", f4(1, 2), 11);
+        test_eq("function swap small with big pt2", f6(1, 2), 3);
+
+        auto f7 = f4;
+        test_eq("function copy of big callable", f7(0, 0), 8);
+        test_eq("function copy keeps source", f4(0, 0), 8);
+
+        std::__ext::move_only_function<int(int)> mf1{};
+        test("move_only_function default is empty", !mf1);
+
+        std::unique_ptr<int> ptr{new int{5}};
+        mf1 = [p = std::move(ptr)](int a){ return a + *p; };
+        test_eq("move_only_function with move-only capture", mf1(2), 7);
+
+        std::__ext::move_only_function<int(int)> mf2{std::move(mf1)};
+        test_eq("move_only_function move", mf2(3), 8);
+        test("move_only_function moved from is empty", !mf1);
+
+        mf1 = [](int a){ return -a; };
+        mf1.swap(mf2);
+        test_eq("move_only_function swap pt1", mf1(3), 8);
+        test_eq("move_only_function swap pt2", mf2(3), -3);
     }
 
     void functional_test::test_bind()
@@ -33,6 +33,7 @@
 #include <future>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 using namespace std::chrono_literals;
 
@@ -275,6 +276,44 @@ namespace std::test
 
         res4.get();
         test_eq("void async", x, 42);
+
+        std::vector<std::future<int>> futures{};
+        for (int i = 0; i < 64; ++i)
+        {
+            futures.push_back(std::async(
+                std::launch::async, [i](){
+                    return i;
+                }
+            ));
+        }
+
+        int sum{};
+        for (auto& f: futures)
+            sum += f.get();
+        test_eq("many async tasks", sum, 64 * 63 / 2);
+
+        auto res5 = std::async(
+            std::launch::async, [](){
+                auto inner = std::async(
+                    std::launch::async, [](){
+                        return 21;
+                    }
+                );
+
+                return inner.get() * 2;
+            }
+        );
+        test_eq("nested async", res5.get(), 42);
+
+        int y{};
+        {
+            auto res6 = std::async(
+                std::launch::async, [&y](){
+                    y = 42;
+                }
+            );
+        }
+        test_eq("async future destructor waits", y, 42);
     }
 
     void future_test::test_packaged_task()
@@ -29,6 +29,8 @@
 #include <__bits/test/mock.hpp>
 #include <__bits/test/tests.hpp>
 #include <initializer_list>
+#include <list>
+#include <map>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -82,6 +84,41 @@ namespace std::test
             using propagate_on_container_swap            = std::true_type;
             using is_always_equal                        = std::true_type;
         };
+
+        struct counting_allocator_stats
+        {
+            static size_t allocations;
+            static size_t deallocations;
+        };
+
+        size_t counting_allocator_stats::allocations{};
+        size_t counting_allocator_stats::deallocations{};
+
+        template<class T>
+        struct counting_allocator
+        {
+            using value_type = T;
+
+            counting_allocator() = default;
+
+            template<class U>
+            counting_allocator(const counting_allocator<U>&)
+            { /* DUMMY BODY */ }
+
+            T* allocate(size_t n)
+            {
+                ++counting_allocator_stats::allocations;
+
+                return std::allocator<T>{}.allocate(n);
+            }
+
+            void deallocate(T* ptr, size_t n)
+            {
+                ++counting_allocator_stats::deallocations;
+
+                std::allocator<T>{}.deallocate(ptr, n);
+            }
+        };
     }
 
     bool memory_test::run(bool report)
@@ -94,6 +131,7 @@ namespace std::test
         test_weak_ptr();
         test_allocators();
         test_pointers();
+        test_node_pool();
 
         return end();
     }
@@ -177,6 +215,25 @@ namespace std::test
             test_eq("shared_ptr copy out of scope", mock::destructor_calls, 0U);
         }
         test_eq("shared_ptr original out of scope", mock::destructor_calls, 1U);
+
+        using stats = aux::counting_allocator_stats;
+        mock::clear();
+        stats::allocations = 0U;
+        stats::deallocations = 0U;
+        {
+            auto ptr1 = std::allocate_shared<mock>(aux::counting_allocator<mock>{});
+            test_eq("allocate_shared single allocation", stats::allocations, 1U);
+            test_eq("allocate_shared constructs", mock::constructor_calls, 1U);
+
+            auto ptr2 = ptr1;
+            test_eq("allocate_shared copy no allocation", stats::allocations, 1U);
+        }
+        test_eq("allocate_shared out of scope", mock::destructor_calls, 1U);
+        test_eq("allocate_shared deallocation", stats::deallocations, 1U);
+
+        auto ptr3 = std::make_shared<std::pair<int, char>>(42, 'a');
+        test_eq("make_shared with arguments pt1", ptr3->first, 42);
+        test_eq("make_shared with arguments pt2", ptr3->second, 'a');
     }
 
     void memory_test::test_weak_ptr()
@@ -198,7 +255,23 @@ namespace std::test
             }
             test_eq("weak_ptr expired after all shared_ptrs die", wptr1.expired(), true);
             test_eq("shared object destroyed while weak_ptr exists", mock::destructor_calls, 1U);
+            test_eq("lock of expired weak_ptr", (bool)wptr1.lock(), false);
         }
+
+        using stats = aux::counting_allocator_stats;
+        mock::clear();
+        stats::allocations = 0U;
+        stats::deallocations = 0U;
+        {
+            std::weak_ptr<mock> wptr{};
+            {
+                auto ptr = std::allocate_shared<mock>(aux::counting_allocator<mock>{});
+                wptr = ptr;
+            }
+            test_eq("inplace object destroyed before weak_ptr", mock::destructor_calls, 1U);
+            test_eq("inplace payload kept by weak_ptr", stats::deallocations, 0U);
+        }
+        test_eq("inplace payload freed by last weak_ptr", stats::deallocations, 1U);
     }
 
     void memory_test::test_allocators()
@@ -359,4 +432,56 @@ namespace std::test
         test_eq("pointer_traits<Ptr>::pointer_to", dummy_traits1::pointer_to(x).tag, 10);
         test_eq("pointer_traits<T*>::pointer_to", int_traits::pointer_to(x), &x);
     }
+
+    void memory_test::test_node_pool()
+    {
+        using pool_map = std::map<
+            int, int, std::less<int>,
+            std::__ext::node_pool_allocator<std::pair<const int, int>>
+        >;
+        using pool_list = std::list<int, std::__ext::node_pool_allocator<int>>;
+
+        pool_map m{};
+        for (int i = 0; i < 100; ++i)
+            m.emplace(i, i * i);
+        test_eq("node_pool map size", m.size(), 100U);
+        test_eq("node_pool map find", m.find(7)->second, 49);
+
+        auto pool = m.get_allocator().pool();
+        auto chunks = pool->chunk_count();
+
+        /**
+         * Erased nodes go to the free list and are
+         * reused by the following insertions, so the
+         * pool must not grow.
+         */
+        for (int i = 0; i < 1000; ++i)
+        {
+            m.erase(i % 100);
+            m.emplace(i % 100, i);
+        }
+        test_eq("node_pool map size after churn", m.size(), 100U);
+        test_eq("node_pool map reuses nodes", pool->chunk_count(), chunks);
+
+        m.clear();
+        test_eq("node_pool map clear", m.size(), 0U);
+        test("node_pool map nodes returned", pool->free_count() >= 100U);
+
+        auto copy = m;
+        test("node_pool copy gets own pool", copy.get_allocator() != m.get_allocator());
+
+        pool_list l1{1, 2, 3};
+        pool_list l2{std::move(l1)};
+        test_eq("node_pool list move steals nodes", l2.size(), 3U);
+        test_eq("node_pool list move content", l2.back(), 3);
+
+        pool_list l3{4, 5};
+        l3 = l2;
+        test_eq("node_pool list copy assign size", l3.size(), 3U);
+        test("node_pool list copy assign keeps pool", l3.get_allocator() != l2.get_allocator());
+
+        std::__ext::node_pool_allocator<int> alloc1{};
+        std::__ext::node_pool_allocator<long> alloc2{alloc1};
+        test("node_pool rebind shares pool", alloc1 == alloc2);
+    }
 }
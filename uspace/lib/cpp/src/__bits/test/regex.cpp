@@ -0,0 +1,479 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <iterator>
+#include <list>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::regex_constants::error_type compile_error(
+        const char* pattern,
+        std::regex_constants::syntax_option_type flags = std::regex_constants::ECMAScript
+    )
+    {
+        using traits_type = std::regex_traits<char>;
+
+        std::aux::regex_program<char, traits_type> prog{};
+        std::aux::regex_compiler<char, traits_type> comp{traits_type{}, flags};
+
+        auto last = pattern + std::char_traits<char>::length(pattern);
+        if (comp.compile(pattern, last, prog))
+            return std::regex_constants::error_type(-1);
+        else
+            return comp.error();
+    }
+}
+
+namespace std::test
+{
+    bool regex_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_match();
+        test_search();
+        test_captures();
+        test_syntax();
+        test_backrefs();
+        test_posix();
+        test_replace();
+        test_iterators();
+        test_errors();
+
+        return end();
+    }
+
+    const char* regex_test::name()
+    {
+        return "regex";
+    }
+
+    void regex_test::test_match()
+    {
+        std::regex r1{"abc"};
+        test("match literal", std::regex_match("abc", r1));
+        test("match literal prefix only", !std::regex_match("abcd", r1));
+        test("match literal suffix only", !std::regex_match("xabc", r1));
+        test_eq("mark_count no groups", r1.mark_count(), 0U);
+
+        std::regex r2{"a.c"};
+        test("match any", std::regex_match("axc", r2));
+        test("match any not newline", !std::regex_match("a\nc", r2));
+
+        std::regex r3{"[a-c]+x?"};
+        test("match class plus", std::regex_match("abcab", r3));
+        test("match class plus optional", std::regex_match("cx", r3));
+        test("match class outside", !std::regex_match("abd", r3));
+
+        std::regex r4{"HeLLo", std::regex::icase};
+        test("match icase", std::regex_match("hello", r4));
+
+        std::regex r5{"(a|ab)(c|bcd)(d*)"};
+        test("match backtracks into alternatives", std::regex_match("abcd", r5));
+
+        std::string s1{"hello world"};
+        std::regex r6{"hello \\w+"};
+        test("match string", std::regex_match(s1, r6));
+
+        std::list<char> l1(s1.begin(), s1.end());
+        test("match list iterators", std::regex_match(l1.begin(), l1.end(), r6));
+
+        std::regex r7{""};
+        test("match empty pattern empty string", std::regex_match("", r7));
+        test("match empty pattern nonempty string", !std::regex_match("a", r7));
+
+        std::wregex r8{L"\\d{3}-\\d{4}"};
+        test("match wide", std::regex_match(L"555-1234", r8));
+    }
+
+    void regex_test::test_search()
+    {
+        std::regex r1{"b+"};
+        test("search found", std::regex_search("aabbbcc", r1));
+        test("search not found", !std::regex_search("aacc", r1));
+
+        std::cmatch m1{};
+        std::regex_search("aabbbcc", m1, r1);
+        test_eq("search position", m1.position(), 2);
+        test_eq("search length", m1.length(), 3);
+        test_eq("search prefix", m1.prefix().str(), std::string{"aa"});
+        test_eq("search suffix", m1.suffix().str(), std::string{"cc"});
+
+        std::regex r2{"^abc"};
+        test("search anchored begin", std::regex_search("abcdef", r2));
+        test("search anchored begin fails", !std::regex_search("xabc", r2));
+        test("search match_not_bol", !std::regex_search("abc", r2, std::regex_constants::match_not_bol));
+
+        std::regex r3{"abc$"};
+        test("search anchored end", std::regex_search("xxabc", r3));
+        test("search match_not_eol", !std::regex_search("xxabc", r3, std::regex_constants::match_not_eol));
+
+        std::regex r4{"^b", std::regex::multiline};
+        test("search multiline", std::regex_search("a\nb", r4));
+
+        std::regex r5{"\\bfoo\\b"};
+        test("search word boundary", std::regex_search("a foo b", r5));
+        test("search word boundary fails", !std::regex_search("afoob", r5));
+
+        std::regex r6{"x*"};
+        std::cmatch m2{};
+        test("search empty match", std::regex_search("abc", m2, r6));
+        test_eq("search empty match position", m2.position(), 0);
+        test("search match_not_null", !std::regex_search("abc", r6, std::regex_constants::match_not_null));
+
+        std::regex r7{"bc"};
+        test("search match_continuous", !std::regex_search("abc", r7, std::regex_constants::match_continuous));
+
+        std::string s1(10000, 'a');
+        s1 += "needle";
+        s1 += std::string(10000, 'b');
+        std::smatch m3{};
+        test("search long input", std::regex_search(s1, m3, std::regex{"ne+dle"}));
+        test_eq("search long input position", m3.position(), 10000);
+    }
+
+    void regex_test::test_captures()
+    {
+        std::regex r1{"(\\w+)@(\\w+)\\.com"};
+        std::smatch m1{};
+        std::string s1{"mail: joe@example.com."};
+
+        test("captures found", std::regex_search(s1, m1, r1));
+        test_eq("captures size", m1.size(), 3U);
+        test_eq("captures mark_count", r1.mark_count(), 2U);
+        test_eq("captures whole", m1.str(0), std::string{"joe@example.com"});
+        test_eq("captures first", m1.str(1), std::string{"joe"});
+        test_eq("captures second", m1.str(2), std::string{"example"});
+        test_eq("captures position", m1.position(1), 6);
+        test("captures ready", m1.ready());
+        test("captures out of range unmatched", !m1[5].matched);
+
+        std::regex r2{"(a)|(b)"};
+        std::cmatch m2{};
+        std::regex_match("b", m2, r2);
+        test("captures unmatched group", !m2[1].matched);
+        test("captures matched group", m2[2].matched);
+
+        std::regex r3{"(a*)*"};
+        std::cmatch m3{};
+        test("captures empty loop terminates", std::regex_match("aa", m3, r3));
+
+        std::regex r4{"(a+)(b+)?", std::regex::nosubs};
+        std::cmatch m4{};
+        std::regex_match("aab", m4, r4);
+        test_eq("captures nosubs", m4.size(), 1U);
+
+        std::regex r5{"(ab|a)(bc|c)"};
+        std::cmatch m5{};
+        std::regex_match("abc", m5, r5);
+        test_eq("captures leftmost first", m5.str(1), std::string{"ab"});
+
+        std::regex r6{"(?:a)(b)"};
+        std::cmatch m6{};
+        std::regex_match("ab", m6, r6);
+        test_eq("captures non-capturing group", m6.size(), 2U);
+        test_eq("captures after non-capturing group", m6.str(1), std::string{"b"});
+
+        std::regex r7{"(\\d+)-(\\d+)"};
+        std::cmatch m7{};
+        std::regex_search("x 10-20 y", m7, r7);
+        test_eq("format", m7.format("$2..$1 [$&] <$`> <$'> $$"),
+                std::string{"20..10 [10-20] <x > < y> $"});
+        test_eq("format sed", m7.format("\\2-\\1 &", std::regex_constants::format_sed),
+                std::string{"20-10 10-20"});
+
+        std::cmatch m8{};
+        test("not ready before use", !m8.ready());
+        test("results empty after failure", !std::regex_search("abc", m8, r7) && m8.empty());
+
+        std::regex r8{"c(b*?\\d*){1,2}"};
+        std::cmatch m9{};
+        std::regex_search("c11b1", m9, r8);
+        test_eq("empty iteration backtracks", m9.length(), 5);
+
+        std::regex r9{"(?:.*?)?"};
+        std::regex_search("11", m9, r9);
+        test_eq("empty iteration lazy", m9.length(), 1);
+
+        std::regex r10{"(?:(a)|b)+"};
+        std::regex_match("ab", m9, r10);
+        test("captures reset per iteration", !m9[1].matched);
+
+        std::regex r11{"(?:(a)|b)+(?=$)"};
+        std::regex_match("ab", m9, r11);
+        test("captures reset per iteration backtracking", !m9[1].matched);
+    }
+
+    void regex_test::test_syntax()
+    {
+        std::regex r1{"a{2,3}"};
+        test("interval min", std::regex_match("aa", r1));
+        test("interval max", std::regex_match("aaa", r1));
+        test("interval over", !std::regex_match("aaaa", r1));
+
+        std::regex r2{"a{2,}"};
+        test("interval unbounded", std::regex_match("aaaaa", r2));
+
+        std::regex r3{"<.+?>"};
+        std::cmatch m1{};
+        std::regex_search("<a><b>", m1, r3);
+        test_eq("lazy plus", m1.str(), std::string{"<a>"});
+
+        std::regex r4{"<.+>"};
+        std::regex_search("<a><b>", m1, r4);
+        test_eq("greedy plus", m1.str(), std::string{"<a><b>"});
+
+        std::regex r5{"[[:digit:]]+[[:alpha:]]"};
+        test("named classes", std::regex_match("123x", r5));
+
+        std::regex r6{"[^a-z]+"};
+        test("negated class", std::regex_match("ABC123", r6));
+        test("negated class fails", !std::regex_match("AbC", r6));
+
+        std::regex r7{"\\s*\\S+\\s*"};
+        test("escape classes", std::regex_match("  word  ", r7));
+
+        std::regex r8{"\\x41\\u0042\\t\\n"};
+        test("character escapes", std::regex_match("AB\t\n", r8));
+
+        std::regex r9{"cat|dog|bird"};
+        test("alternation", std::regex_match("dog", r9));
+        test("alternation fails", !std::regex_match("cow", r9));
+
+        std::regex r10{"[\\d.]+"};
+        test("escape in brackets", std::regex_match("3.14", r10));
+
+        std::regex r11{"a\\.b\\*"};
+        test("escaped specials", std::regex_match("a.b*", r11));
+        test("escaped specials literal", !std::regex_match("axb", r11));
+
+        std::regex r12{"(ab){2}"};
+        test("group repeat", std::regex_match("abab", r12));
+
+        std::regex r13{"[a-z]+", std::regex::icase};
+        test("icase class", std::regex_match("MiXeD", r13));
+    }
+
+    void regex_test::test_backrefs()
+    {
+        std::regex r1{"(\\w+) \\1"};
+        test("backref", std::regex_match("hello hello", r1));
+        test("backref mismatch", !std::regex_match("hello world", r1));
+
+        std::regex r2{"(a+)b\\1", std::regex::icase};
+        test("backref icase", std::regex_match("aaBAA", r2));
+
+        std::regex r3{"foo(?=bar)"};
+        std::cmatch m1{};
+        test("lookahead", std::regex_search("foobaz foobar", m1, r3));
+        test_eq("lookahead position", m1.position(), 7);
+        test_eq("lookahead not consumed", m1.length(), 3);
+
+        std::regex r4{"foo(?!bar)"};
+        std::regex_search("foobar foobaz", m1, r4);
+        test_eq("negative lookahead", m1.position(), 7);
+
+        std::regex r5{"(\\d)(\\d)\\2\\1"};
+        test("backref palindrome", std::regex_search("x1221y", r5));
+
+        std::regex r6{"(a*)b\\1"};
+        std::smatch m2{};
+        std::string s1(1000, 'a');
+        s1 += 'b';
+        s1 += std::string(999, 'a');
+        test("backref long", std::regex_search(s1, m2, r6));
+        test_eq("backref long leftmost", m2.position(), 1);
+    }
+
+    void regex_test::test_posix()
+    {
+        std::regex r1{"a\\(b*\\)c", std::regex::basic};
+        std::cmatch m1{};
+        test("basic groups", std::regex_match("abbc", m1, r1));
+        test_eq("basic groups capture", m1.str(1), std::string{"bb"});
+
+        std::regex r2{"a\\{2\\}", std::regex::basic};
+        test("basic interval", std::regex_match("aa", r2));
+
+        std::regex r3{"a+|b", std::regex::basic};
+        test("basic plus literal", std::regex_match("a+|b", r3));
+
+        std::regex r4{"(a|ab)(c|bcd)(d*)", std::regex::extended};
+        std::cmatch m2{};
+        std::regex_match("abcd", m2, r4);
+        test_eq("extended leftmost longest", m2.str(0), std::string{"abcd"});
+
+        std::regex r5{"a|ab", std::regex::extended};
+        std::regex_search("abc", m2, r5);
+        test_eq("extended longest alternative", m2.str(), std::string{"ab"});
+
+        std::regex r6{"ab|a", std::regex::ECMAScript};
+        std::regex_search("abc", m2, r6);
+        test_eq("ecma first alternative", m2.str(), std::string{"ab"});
+
+        std::regex r7{"a|ab"};
+        std::regex_search("abc", m2, r7);
+        test_eq("ecma first alternative short", m2.str(), std::string{"a"});
+
+        std::regex r8{"foo\nbar", std::regex::grep};
+        test("grep newline alternation", std::regex_search("xbar", r8));
+
+        std::regex r9{"\\(a\\)\\1", std::regex::grep};
+        test("grep backref", std::regex_match("aa", r9));
+
+        std::regex r10{"[[:upper:]]+", std::regex::egrep};
+        test("egrep class", std::regex_match("ABC", r10));
+
+        std::regex r11{"a\\tb", std::regex::awk};
+        test("awk escapes", std::regex_match("a\tb", r11));
+    }
+
+    void regex_test::test_replace()
+    {
+        std::regex r1{"a(\\d)"};
+        test_eq("replace all",
+                std::regex_replace(std::string{"a1 a2 b3 a4"}, r1, "<$1>"),
+                std::string{"<1> <2> b3 <4>"});
+        test_eq("replace first only",
+                std::regex_replace(std::string{"a1 a2"}, r1, "x",
+                                   std::regex_constants::format_first_only),
+                std::string{"x a2"});
+        test_eq("replace no copy",
+                std::regex_replace(std::string{"a1 b a2"}, r1, "$1",
+                                   std::regex_constants::format_no_copy),
+                std::string{"12"});
+        test_eq("replace no match",
+                std::regex_replace("nothing", r1, std::string{"x"}),
+                std::string{"nothing"});
+
+        std::regex r2{"x*"};
+        test_eq("replace empty matches",
+                std::regex_replace(std::string{"abc"}, r2, "-"),
+                std::string{"-a-b-c-"});
+
+        std::regex r3{"(\\w+) (\\w+)"};
+        test_eq("replace sed",
+                std::regex_replace("hello world", r3, "\\2 \\1",
+                                   std::regex_constants::format_sed),
+                std::string{"world hello"});
+
+        std::string res{};
+        std::string s1{"a1a2"};
+        std::regex_replace(std::back_inserter(res), s1.begin(), s1.end(), r1, "$1");
+        test_eq("replace output iterator", res, std::string{"12"});
+    }
+
+    void regex_test::test_iterators()
+    {
+        std::string s1{"one 2 three 45 six"};
+        std::regex r1{"\\d+"};
+
+        std::vector<std::string> v1{};
+        for (std::sregex_iterator it{s1.begin(), s1.end(), r1}, end{}; it != end; ++it)
+            v1.push_back(it->str());
+
+        const char* e1[] = {"2", "45"};
+        test_eq("regex_iterator", v1.begin(), v1.end(), std::begin(e1), std::end(e1));
+
+        std::sregex_iterator it1{s1.begin(), s1.end(), r1};
+        ++it1;
+        test_eq("regex_iterator position", it1->position(), 12);
+        test_eq("regex_iterator prefix", it1->prefix().str(), std::string{" three "});
+
+        std::regex r2{"\\b"};
+        auto count = std::distance(
+            std::sregex_iterator{s1.begin(), s1.end(), r2}, std::sregex_iterator{}
+        );
+        test_eq("regex_iterator empty matches", count, 10);
+
+        std::string s2{"a,b,,c"};
+        std::regex r3{","};
+        std::vector<std::string> v2{};
+        for (std::sregex_token_iterator it{s2.begin(), s2.end(), r3, -1}, end{}; it != end; ++it)
+            v2.push_back(it->str());
+
+        const char* e2[] = {"a", "b", "", "c"};
+        test_eq("token_iterator split", v2.begin(), v2.end(), std::begin(e2), std::end(e2));
+
+        std::string s3{"k1=v1;k2=v2"};
+        std::regex r4{"(\\w+)=(\\w+)"};
+        std::vector<std::string> v3{};
+        for (std::sregex_token_iterator it{s3.begin(), s3.end(), r4, {2, 1}}, end{}; it != end; ++it)
+            v3.push_back(it->str());
+
+        const char* e3[] = {"v1", "k1", "v2", "k2"};
+        test_eq("token_iterator submatches", v3.begin(), v3.end(), std::begin(e3), std::end(e3));
+
+        std::sregex_token_iterator it2{s2.begin(), s2.end(), r3, -1};
+        auto it3 = it2;
+        ++it2;
+        ++it3;
+        test("token_iterator copy", it2 == it3 && it3->str() == "b");
+
+        std::string s4{"nothing"};
+        std::sregex_token_iterator it4{s4.begin(), s4.end(), r3, -1};
+        test_eq("token_iterator no match suffix", it4->str(), s4);
+        ++it4;
+        test("token_iterator no match end", it4 == std::sregex_token_iterator{});
+    }
+
+    void regex_test::test_errors()
+    {
+        using namespace std::regex_constants;
+
+        test_eq("error paren", compile_error("(a"), error_paren);
+        test_eq("error paren close", compile_error("a)"), error_paren);
+        test_eq("error brack", compile_error("[a"), error_brack);
+        test_eq("error range", compile_error("[z-a]"), error_range);
+        test_eq("error badrepeat", compile_error("*a"), error_badrepeat);
+        test_eq("error brace", compile_error("a{2"), error_brace);
+        test_eq("error badbrace", compile_error("a{3,2}"), error_badbrace);
+        test_eq("error escape", compile_error("a\\"), error_escape);
+        test_eq("error backref", compile_error("(a)\\2"), error_backref);
+        test_eq("error ctype", compile_error("[[:nope:]]"), error_ctype);
+        test_eq("error collate", compile_error("[[.nope.]]"), error_collate);
+        test_eq("basic error paren", compile_error("\\(a", basic), error_paren);
+
+        std::regex_error err{error_stack};
+        test_eq("regex_error code", err.code(), error_stack);
+
+        std::aux::exception_thrown = false;
+        std::regex r1{"(a"};
+        test("invalid pattern throws", std::aux::exception_thrown);
+        test("invalid pattern matches nothing", !std::regex_search("a", r1));
+        std::aux::exception_thrown = false;
+
+        std::regex r2{};
+        test("default regex matches nothing", !std::regex_match("", r2));
+    }
+}
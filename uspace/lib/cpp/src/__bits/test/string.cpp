@@ -47,6 +47,7 @@ namespace std::test
         test_find();
         test_substr();
         test_compare();
+        test_short_strings();
 
         return end();
     }
@@ -703,4 +704,60 @@ namespace std::test
             res, 0
         );
     }
+
+    void string_test::test_short_strings()
+    {
+        auto is_inline = [](const std::string& str){
+            auto ptr = reinterpret_cast<const char*>(str.data());
+            auto obj = reinterpret_cast<const char*>(&str);
+
+            return obj <= ptr && ptr < obj + sizeof(str);
+        };
+
+        std::string empty{};
+        test("empty string is inline", is_inline(empty));
+        test_eq("empty string is terminated", empty.c_str()[0], '\0');
+
+        std::string str1{"short string"};
+        test("short string is inline", is_inline(str1));
+
+        std::string str2{"a string that is too long to be inline"};
+        test("long string is on the heap", !is_inline(str2));
+
+        std::string str3{std::move(str1)};
+        test_eq("move of short string", str3, std::string{"short string"});
+        test("move of short string is inline", is_inline(str3));
+        test("moved from short string is empty", str1.empty());
+
+        auto data = str2.data();
+        std::string str4{std::move(str2)};
+        test_eq("move of long string steals buffer", str4.data(), data);
+        test("moved from long string is inline", is_inline(str2));
+
+        str3.swap(str4);
+        test_eq(
+            "swap of short and long string",
+            str3, std::string{"a string that is too long to be inline"}
+        );
+        test_eq("swap of long and short string", str4, std::string{"short string"});
+        test_eq("swap keeps long buffer", str3.data(), data);
+
+        std::string str5{"abc"};
+        str5.append(20, 'x');
+        test_eq("append past inline buffer", str5.size(), 23ul);
+        test_eq("append past inline buffer terminated", str5.c_str()[23], '\0');
+        test("append past inline buffer moves to heap", !is_inline(str5));
+
+        str5.erase(3);
+        str5.shrink_to_fit();
+        test_eq("shrink_to_fit back to inline", str5, std::string{"abc"});
+        test("shrink_to_fit back to inline buffer", is_inline(str5));
+
+        str5.reserve(100);
+        test("reserve", str5.capacity() >= 100ul);
+        test_eq("reserve keeps content", str5, std::string{"abc"});
+
+        str5.assign(str5.c_str() + 1);
+        test_eq("assign from own buffer", str5, std::string{"bc"});
+    }
 }
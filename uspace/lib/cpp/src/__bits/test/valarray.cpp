@@ -0,0 +1,462 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/test/tests.hpp>
+#include <cstdlib>
+#include <initializer_list>
+#include <utility>
+#include <valarray>
+
+namespace valarray_adl
+{
+    /**
+     * Outside of std, the operators and functions of
+     * expressions are only found by ADL. None of the
+     * types in sqrt(a) come from std.
+     */
+    std::valarray<double> eval(const std::valarray<double>& a,
+                               const std::valarray<double>& b)
+    {
+        return -sqrt(a) * -abs(b) + pow(sqrt(b), 2.0);
+    }
+}
+
+namespace std::test
+{
+    bool valarray_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_construction();
+        test_operators();
+        test_expressions();
+        test_members();
+        test_subsets();
+        test_math();
+
+        return end();
+    }
+
+    const char* valarray_test::name()
+    {
+        return "valarray";
+    }
+
+    void valarray_test::test_construction()
+    {
+        std::valarray<int> v1{};
+        test_eq("default constructor size", v1.size(), 0U);
+
+        std::valarray<int> v2(5);
+        auto check2 = {0, 0, 0, 0, 0};
+        test_eq(
+            "size constructor",
+            std::begin(v2), std::end(v2),
+            check2.begin(), check2.end()
+        );
+
+        std::valarray<int> v3(7, 3);
+        auto check3 = {7, 7, 7};
+        test_eq(
+            "value constructor",
+            std::begin(v3), std::end(v3),
+            check3.begin(), check3.end()
+        );
+
+        int arr[] = {1, 2, 3, 4};
+        std::valarray<int> v4(arr, 4);
+        test_eq(
+            "pointer constructor",
+            std::begin(v4), std::end(v4),
+            std::begin(arr), std::end(arr)
+        );
+
+        std::valarray<int> v5{1, 2, 3, 4};
+        test_eq(
+            "initializer_list constructor",
+            std::begin(v5), std::end(v5),
+            std::begin(arr), std::end(arr)
+        );
+
+        auto v6 = v5;
+        test_eq(
+            "copy constructor",
+            std::begin(v6), std::end(v6),
+            std::begin(arr), std::end(arr)
+        );
+        test("copy constructor copies", std::begin(v6) != std::begin(v5));
+
+        auto data = std::begin(v6);
+        auto v7 = std::move(v6);
+        test_eq("move constructor steals data", std::begin(v7), data);
+        test_eq("move constructor source empty", v6.size(), 0U);
+
+        test_eq(
+            "storage aligned",
+            reinterpret_cast<std::uintptr_t>(std::begin(v7)) % 64, 0U
+        );
+
+        std::valarray<int> v8(2);
+        v8 = v5;
+        test_eq(
+            "copy assignment resizes",
+            std::begin(v8), std::end(v8),
+            std::begin(arr), std::end(arr)
+        );
+
+        v8 = 3;
+        auto check8 = {3, 3, 3, 3};
+        test_eq(
+            "scalar assignment",
+            std::begin(v8), std::end(v8),
+            check8.begin(), check8.end()
+        );
+
+        v8 = {5, 6};
+        auto check9 = {5, 6};
+        test_eq(
+            "initializer_list assignment",
+            std::begin(v8), std::end(v8),
+            check9.begin(), check9.end()
+        );
+    }
+
+    void valarray_test::test_operators()
+    {
+        std::valarray<int> v1{1, 2, 3, 4};
+        std::valarray<int> v2{4, 3, 2, 1};
+
+        std::valarray<int> res1 = v1 + v2;
+        auto check1 = {5, 5, 5, 5};
+        test_eq(
+            "operator+",
+            std::begin(res1), std::end(res1),
+            check1.begin(), check1.end()
+        );
+
+        std::valarray<int> res2 = v1 * 2;
+        auto check2 = {2, 4, 6, 8};
+        test_eq(
+            "operator* scalar rhs",
+            std::begin(res2), std::end(res2),
+            check2.begin(), check2.end()
+        );
+
+        std::valarray<int> res3 = 10 - v1;
+        auto check3 = {9, 8, 7, 6};
+        test_eq(
+            "operator- scalar lhs",
+            std::begin(res3), std::end(res3),
+            check3.begin(), check3.end()
+        );
+
+        std::valarray<int> res4 = -v1;
+        auto check4 = {-1, -2, -3, -4};
+        test_eq(
+            "unary operator-",
+            std::begin(res4), std::end(res4),
+            check4.begin(), check4.end()
+        );
+
+        std::valarray<bool> res5 = v1 < v2;
+        auto check5 = {true, true, false, false};
+        test_eq(
+            "operator<",
+            std::begin(res5), std::end(res5),
+            check5.begin(), check5.end()
+        );
+
+        std::valarray<int> res6 = v1 << 1;
+        auto check6 = {2, 4, 6, 8};
+        test_eq(
+            "operator<<",
+            std::begin(res6), std::end(res6),
+            check6.begin(), check6.end()
+        );
+
+        std::valarray<int> res7 = v1 % 2;
+        auto check7 = {1, 0, 1, 0};
+        test_eq(
+            "operator%",
+            std::begin(res7), std::end(res7),
+            check7.begin(), check7.end()
+        );
+
+        v1 += v2;
+        test_eq(
+            "operator+= valarray",
+            std::begin(v1), std::end(v1),
+            check1.begin(), check1.end()
+        );
+
+        v1 -= 1;
+        auto check8 = {4, 4, 4, 4};
+        test_eq(
+            "operator-= scalar",
+            std::begin(v1), std::end(v1),
+            check8.begin(), check8.end()
+        );
+
+        v1 *= v2 + 1;
+        auto check9 = {20, 16, 12, 8};
+        test_eq(
+            "operator*= expression",
+            std::begin(v1), std::end(v1),
+            check9.begin(), check9.end()
+        );
+    }
+
+    void valarray_test::test_expressions()
+    {
+        std::valarray<double> a{1.0, 2.0, 3.0};
+        std::valarray<double> b{4.0, 5.0, 6.0};
+        std::valarray<double> c{0.5, 0.5, 0.5};
+
+        std::valarray<double> res1 = a * b + c;
+        auto check1 = {4.5, 10.5, 18.5};
+        test_eq(
+            "fused multiply add",
+            std::begin(res1), std::end(res1),
+            check1.begin(), check1.end()
+        );
+
+        auto expr = (a + b) * (a - c) / 2.0;
+        test_eq("expression size", expr.size(), 3U);
+        test_eq("expression element", expr[1], 5.25);
+        test_eq("expression sum", expr.sum(), 1.25 + 5.25 + 11.25);
+        test_eq("expression max", expr.max(), 11.25);
+
+        a = a * 2.0 + a;
+        auto check2 = {3.0, 6.0, 9.0};
+        test_eq(
+            "aliased assignment",
+            std::begin(a), std::end(a),
+            check2.begin(), check2.end()
+        );
+
+        std::valarray<double> res3(1);
+        res3 = b - c;
+        auto check3 = {3.5, 4.5, 5.5};
+        test_eq(
+            "expression assignment resizes",
+            std::begin(res3), std::end(res3),
+            check3.begin(), check3.end()
+        );
+
+        std::valarray<int> i1{1, -2, 3, -4};
+        std::valarray<int> res4 = i1[i1 > 0];
+        auto check4 = {1, 3};
+        test_eq(
+            "mask from expression",
+            std::begin(res4), std::end(res4),
+            check4.begin(), check4.end()
+        );
+
+        std::valarray<int> res5 = abs(i1 * 2);
+        auto check5 = {2, 4, 6, 8};
+        test_eq(
+            "function of expression",
+            std::begin(res5), std::end(res5),
+            check5.begin(), check5.end()
+        );
+    }
+
+    void valarray_test::test_members()
+    {
+        std::valarray<int> v1{3, 1, 4, 1, 5};
+        test_eq("sum", v1.sum(), 14);
+        test_eq("min", v1.min(), 1);
+        test_eq("max", v1.max(), 5);
+
+        auto res1 = v1.shift(2);
+        auto check1 = {4, 1, 5, 0, 0};
+        test_eq(
+            "shift left",
+            std::begin(res1), std::end(res1),
+            check1.begin(), check1.end()
+        );
+
+        auto res2 = v1.shift(-2);
+        auto check2 = {0, 0, 3, 1, 4};
+        test_eq(
+            "shift right",
+            std::begin(res2), std::end(res2),
+            check2.begin(), check2.end()
+        );
+
+        auto res3 = v1.cshift(2);
+        auto check3 = {4, 1, 5, 3, 1};
+        test_eq(
+            "cshift left",
+            std::begin(res3), std::end(res3),
+            check3.begin(), check3.end()
+        );
+
+        auto res4 = v1.cshift(-1);
+        auto check4 = {5, 3, 1, 4, 1};
+        test_eq(
+            "cshift right",
+            std::begin(res4), std::end(res4),
+            check4.begin(), check4.end()
+        );
+
+        auto res5 = v1.apply([](int x){ return x * x; });
+        auto check5 = {9, 1, 16, 1, 25};
+        test_eq(
+            "apply",
+            std::begin(res5), std::end(res5),
+            check5.begin(), check5.end()
+        );
+
+        v1.resize(3, 2);
+        auto check6 = {2, 2, 2};
+        test_eq(
+            "resize",
+            std::begin(v1), std::end(v1),
+            check6.begin(), check6.end()
+        );
+
+        std::valarray<int> v2{1, 2};
+        v1.swap(v2);
+        test_eq("swap pt1", v1.size(), 2U);
+        test_eq("swap pt2", v2.size(), 3U);
+    }
+
+    void valarray_test::test_subsets()
+    {
+        std::valarray<int> v1{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+        const auto& cv1 = v1;
+        std::valarray<int> res1 = cv1[std::slice{1, 3, 3}];
+        auto check1 = {1, 4, 7};
+        test_eq(
+            "slice read",
+            std::begin(res1), std::end(res1),
+            check1.begin(), check1.end()
+        );
+
+        v1[std::slice{0, 5, 2}] = 0;
+        auto check2 = {0, 1, 0, 3, 0, 5, 0, 7, 0, 9};
+        test_eq(
+            "slice scalar assignment",
+            std::begin(v1), std::end(v1),
+            check2.begin(), check2.end()
+        );
+
+        v1[std::slice{1, 5, 2}] += std::valarray<int>(1, 5);
+        auto check3 = {0, 2, 0, 4, 0, 6, 0, 8, 0, 10};
+        test_eq(
+            "slice compound assignment",
+            std::begin(v1), std::end(v1),
+            check3.begin(), check3.end()
+        );
+
+        std::valarray<int> v2{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+        std::valarray<std::size_t> sizes{2, 3};
+        std::valarray<std::size_t> strides{6, 2};
+        std::valarray<int> res4 = v2[std::gslice{0, sizes, strides}];
+        auto check4 = {0, 2, 4, 6, 8, 10};
+        test_eq(
+            "gslice read",
+            std::begin(res4), std::end(res4),
+            check4.begin(), check4.end()
+        );
+
+        v2[std::gslice{1, sizes, strides}] = -std::valarray<int>{v2[std::gslice{0, sizes, strides}]};
+        auto check5 = {0, 0, 2, -2, 4, -4, 6, -6, 8, -8, 10, -10};
+        test_eq(
+            "gslice expression assignment",
+            std::begin(v2), std::end(v2),
+            check5.begin(), check5.end()
+        );
+
+        std::valarray<int> v3{5, -1, 7, -3};
+        v3[v3 < 0] = 0;
+        auto check6 = {5, 0, 7, 0};
+        test_eq(
+            "mask assignment",
+            std::begin(v3), std::end(v3),
+            check6.begin(), check6.end()
+        );
+
+        std::valarray<std::size_t> idx{3, 0, 2};
+        std::valarray<int> res7 = v3[idx];
+        auto check7 = {0, 5, 7};
+        test_eq(
+            "indirect read",
+            std::begin(res7), std::end(res7),
+            check7.begin(), check7.end()
+        );
+
+        v3[idx] *= std::valarray<int>{2, 3, 4};
+        auto check8 = {15, 0, 28, 0};
+        test_eq(
+            "indirect compound assignment",
+            std::begin(v3), std::end(v3),
+            check8.begin(), check8.end()
+        );
+    }
+
+    void valarray_test::test_math()
+    {
+        std::valarray<double> v1{1.0, 4.0, 9.0};
+
+        std::valarray<double> res1 = sqrt(v1);
+        auto check1 = {1.0, 2.0, 3.0};
+        test_eq(
+            "sqrt",
+            std::begin(res1), std::end(res1),
+            check1.begin(), check1.end()
+        );
+
+        std::valarray<double> res2 = pow(v1, 2.0);
+        auto check2 = {1.0, 16.0, 81.0};
+        test_eq(
+            "pow",
+            std::begin(res2), std::end(res2),
+            check2.begin(), check2.end()
+        );
+
+        std::valarray<double> res3 = abs(-v1);
+        test_eq(
+            "abs",
+            std::begin(res3), std::end(res3),
+            std::begin(v1), std::end(v1)
+        );
+
+        std::valarray<double> v2(4.0, 3);
+        std::valarray<double> res4 = valarray_adl::eval(v1, v2);
+        auto check4 = {8.0, 12.0, 16.0};
+        test_eq(
+            "lookup outside of std",
+            std::begin(res4), std::end(res4),
+            check4.begin(), check4.end()
+        );
+    }
+}
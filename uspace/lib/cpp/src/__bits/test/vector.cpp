@@ -29,6 +29,7 @@
 #include <__bits/test/tests.hpp>
 #include <algorithm>
 #include <initializer_list>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -42,6 +43,7 @@ namespace std::test
         test_construction_and_assignment();
         test_insert();
         test_erase();
+        test_non_trivial();
 
         return end();
     }
@@ -85,7 +87,12 @@ namespace std::test
             check3.begin(), check3.end()
         );
 
-        // TODO: iterator constructor when implemented
+        std::vector<int> vec5(check1.begin(), check1.end());
+        test_eq(
+            "iterator constructor",
+            vec5.begin(), vec5.end(),
+            check1.begin(), check1.end()
+        );
 
         std::vector<int> vec6{vec4};
         test_eq(
@@ -227,4 +234,47 @@ namespace std::test
             check3.begin(), check3.end()
         );
     }
+
+    void vector_test::test_non_trivial()
+    {
+        // Longer than the inline buffer of string.
+        std::string str(40, 'x');
+        auto check1 = {str, str, str};
+        auto check2 = {str, std::string{"a"}, str, std::string{"b"}};
+        auto check3 = {std::string{"a"}, str, std::string{"b"}};
+
+        std::vector<std::string> vec1(3ul, str);
+        test_eq(
+            "non-trivial replication constructor",
+            vec1.begin(), vec1.end(),
+            check1.begin(), check1.end()
+        );
+
+        std::vector<std::string> vec2{vec1};
+        test_eq(
+            "non-trivial copy constructor",
+            vec2.begin(), vec2.end(),
+            check1.begin(), check1.end()
+        );
+
+        std::vector<std::string> vec3{str, "b"};
+        vec3.insert(vec3.begin() + 1, "a");
+        vec3.insert(vec3.end(), vec3[0]);
+        vec3.insert(vec3.end(), vec3[2]);
+        vec3.erase(vec3.begin() + 2);
+        test_eq(
+            "non-trivial insert",
+            vec3.begin(), vec3.end(),
+            check2.begin(), check2.end()
+        );
+
+        vec3.erase(vec3.begin());
+        vec3.erase(vec3.begin() + 1);
+        vec3.insert(vec3.begin() + 1, 1ul, str);
+        test_eq(
+            "non-trivial erase",
+            vec3.begin(), vec3.end(),
+            check3.begin(), check3.end()
+        );
+    }
 }
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/atomic.hpp>
+#include <__bits/thread/threading.hpp>
+#include <cstdint>
+
+namespace std::aux
+{
+    namespace
+    {
+        size_t hash_address(const volatile void* addr)
+        {
+            auto key = reinterpret_cast<uintptr_t>(addr);
+            key ^= key >> 4;
+            key ^= key >> 8;
+
+            return key;
+        }
+
+        /**
+         * Waiters on different addresses may share a bucket,
+         * which only causes spurious wakeups, every waiter
+         * rechecks its value before going back to sleep.
+         */
+        struct wait_bucket
+        {
+            mutex_t mtx;
+            condvar_t cv;
+            size_t waiters;
+        };
+
+        constexpr size_t wait_bucket_count{16};
+
+        struct wait_table
+        {
+            wait_table()
+            {
+                for (auto& b: buckets)
+                {
+                    threading::mutex::init(b.mtx);
+                    threading::condvar::init(b.cv);
+                    b.waiters = 0;
+                }
+            }
+
+            wait_bucket buckets[wait_bucket_count];
+        };
+
+        wait_bucket& get_bucket(const volatile void* addr)
+        {
+            static wait_table table{};
+
+            return table.buckets[hash_address(addr) % wait_bucket_count];
+        }
+
+        constexpr size_t lock_count{16};
+
+        bool locks[lock_count]{};
+
+        bool& get_lock(const volatile void* addr)
+        {
+            return locks[hash_address(addr) % lock_count];
+        }
+    }
+
+    void atomic_lock(const volatile void* addr) noexcept
+    {
+        auto& lock = get_lock(addr);
+
+        /**
+         * The critical sections are a couple of memcpys,
+         * so we only yield if the holder got preempted.
+         */
+        while (__atomic_test_and_set(&lock, __ATOMIC_ACQUIRE))
+        {
+            while (__atomic_load_n(&lock, __ATOMIC_RELAXED))
+                threading::thread::yield();
+        }
+    }
+
+    void atomic_unlock(const volatile void* addr) noexcept
+    {
+        __atomic_clear(&get_lock(addr), __ATOMIC_RELEASE);
+    }
+
+    void atomic_wait(const volatile void* addr, atomic_changed_t changed,
+                     const void* old) noexcept
+    {
+        auto& bucket = get_bucket(addr);
+
+        threading::mutex::lock(bucket.mtx);
+        __atomic_add_fetch(&bucket.waiters, 1, __ATOMIC_SEQ_CST);
+
+        /**
+         * The counter is increased before the value is
+         * checked, so a notifier that changed the value
+         * will see us and take the bucket lock.
+         */
+        while (!changed(addr, old))
+            threading::condvar::wait(bucket.cv, bucket.mtx);
+
+        __atomic_sub_fetch(&bucket.waiters, 1, __ATOMIC_SEQ_CST);
+        threading::mutex::unlock(bucket.mtx);
+    }
+
+    void atomic_notify(const volatile void* addr, bool all) noexcept
+    {
+        auto& bucket = get_bucket(addr);
+
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&bucket.waiters, __ATOMIC_SEQ_CST) == 0)
+            return;
+
+        /**
+         * Since the bucket can be shared by several
+         * addresses, signalling a single waiter is only
+         * safe if it is the only one in the bucket.
+         */
+        threading::mutex::lock(bucket.mtx);
+        if (!all && bucket.waiters == 1)
+            threading::condvar::signal(bucket.cv);
+        else
+            threading::condvar::broadcast(bucket.cv);
+        threading::mutex::unlock(bucket.mtx);
+    }
+}
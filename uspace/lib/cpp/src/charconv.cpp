@@ -0,0 +1,1685 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+/**
+ * The digit generation of libc is not wrapped
+ * for C++, so we put it in the namespace ourselves.
+ */
+namespace helenos
+{
+    extern "C"
+    {
+        #include <double_to_str.h>
+        #include <ieee_double.h>
+    }
+}
+
+namespace std::aux
+{
+    const char digit_pairs[200] = {
+        '0', '0', '0', '1', '0', '2', '0', '3', '0', '4', '0', '5', '0', '6', '0', '7', '0', '8', '0', '9',
+        '1', '0', '1', '1', '1', '2', '1', '3', '1', '4', '1', '5', '1', '6', '1', '7', '1', '8', '1', '9',
+        '2', '0', '2', '1', '2', '2', '2', '3', '2', '4', '2', '5', '2', '6', '2', '7', '2', '8', '2', '9',
+        '3', '0', '3', '1', '3', '2', '3', '3', '3', '4', '3', '5', '3', '6', '3', '7', '3', '8', '3', '9',
+        '4', '0', '4', '1', '4', '2', '4', '3', '4', '4', '4', '5', '4', '6', '4', '7', '4', '8', '4', '9',
+        '5', '0', '5', '1', '5', '2', '5', '3', '5', '4', '5', '5', '5', '6', '5', '7', '5', '8', '5', '9',
+        '6', '0', '6', '1', '6', '2', '6', '3', '6', '4', '6', '5', '6', '6', '6', '7', '6', '8', '6', '9',
+        '7', '0', '7', '1', '7', '2', '7', '3', '7', '4', '7', '5', '7', '6', '7', '7', '7', '8', '7', '9',
+        '8', '0', '8', '1', '8', '2', '8', '3', '8', '4', '8', '5', '8', '6', '8', '7', '8', '8', '8', '9',
+        '9', '0', '9', '1', '9', '2', '9', '3', '9', '4', '9', '5', '9', '6', '9', '7', '9', '8', '9', '9'
+    };
+}
+
+namespace
+{
+    using ::helenos::ieee_double_t;
+
+    /**
+     * Arbitrary precision unsigned integer, large enough to
+     * hold any double scaled by the powers of ten and two we
+     * need to print it exactly or to compare a decimal number
+     * with a halfway point between two doubles.
+     */
+    class bignum
+    {
+        public:
+            bignum(uint64_t val = 0)
+                : size_{}
+            {
+                while (val)
+                {
+                    limbs_[size_++] = static_cast<uint32_t>(val);
+                    val >>= 32;
+                }
+            }
+
+            void mul_add(uint32_t mul, uint32_t add)
+            {
+                uint64_t carry{add};
+                for (size_t i = 0; i < size_; ++i)
+                {
+                    carry += static_cast<uint64_t>(limbs_[i]) * mul;
+                    limbs_[i] = static_cast<uint32_t>(carry);
+                    carry >>= 32;
+                }
+
+                if (carry && size_ < limb_count)
+                    limbs_[size_++] = static_cast<uint32_t>(carry);
+            }
+
+            void mul_pow5(int exp)
+            {
+                for (; exp >= 13; exp -= 13)
+                    mul_add(pow5_[13], 0);
+                if (exp > 0)
+                    mul_add(pow5_[exp], 0);
+            }
+
+            void shift_left(int bits)
+            {
+                if (size_ == 0 || bits <= 0)
+                    return;
+
+                size_t limbs = static_cast<size_t>(bits) / 32;
+                int rem = bits % 32;
+
+                if (size_ + limbs + 1 > limb_count)
+                    limbs = limb_count - size_ - 1;
+
+                if (rem)
+                {
+                    limbs_[size_] = 0;
+                    for (size_t i = size_; i > 0; --i)
+                    {
+                        limbs_[i] |= limbs_[i - 1] >> (32 - rem);
+                        limbs_[i - 1] <<= rem;
+                    }
+                    if (limbs_[size_])
+                        ++size_;
+                }
+
+                if (limbs)
+                {
+                    for (size_t i = size_; i > 0; --i)
+                        limbs_[i - 1 + limbs] = limbs_[i - 1];
+                    for (size_t i = 0; i < limbs; ++i)
+                        limbs_[i] = 0;
+                    size_ += limbs;
+                }
+            }
+
+            /**
+             * Returns true if any of the bits shifted
+             * out was set.
+             */
+            bool shift_right(int bits)
+            {
+                bool sticky{false};
+                size_t limbs = static_cast<size_t>(bits) / 32;
+                int rem = bits % 32;
+
+                if (limbs >= size_)
+                {
+                    sticky = size_ > 0;
+                    size_ = 0;
+
+                    return sticky;
+                }
+
+                for (size_t i = 0; i < limbs; ++i)
+                    sticky = sticky || limbs_[i] != 0;
+                for (size_t i = limbs; i < size_; ++i)
+                    limbs_[i - limbs] = limbs_[i];
+                size_ -= limbs;
+
+                if (rem)
+                {
+                    sticky = sticky || (limbs_[0] & ((1U << rem) - 1)) != 0;
+                    for (size_t i = 0; i + 1 < size_; ++i)
+                        limbs_[i] = (limbs_[i] >> rem) | (limbs_[i + 1] << (32 - rem));
+                    limbs_[size_ - 1] >>= rem;
+                    if (limbs_[size_ - 1] == 0)
+                        --size_;
+                }
+
+                return sticky;
+            }
+
+            /**
+             * Divides in place, returns the remainder.
+             */
+            uint32_t div_small(uint32_t div)
+            {
+                uint64_t rem{};
+                for (size_t i = size_; i > 0; --i)
+                {
+                    rem = (rem << 32) | limbs_[i - 1];
+                    limbs_[i - 1] = static_cast<uint32_t>(rem / div);
+                    rem %= div;
+                }
+
+                while (size_ > 0 && limbs_[size_ - 1] == 0)
+                    --size_;
+
+                return static_cast<uint32_t>(rem);
+            }
+
+            /**
+             * Returns true if the division was not exact.
+             */
+            bool div_pow5(int exp)
+            {
+                bool sticky{false};
+                for (; exp >= 13; exp -= 13)
+                    sticky = div_small(pow5_[13]) != 0 || sticky;
+                if (exp > 0)
+                    sticky = div_small(pow5_[exp]) != 0 || sticky;
+
+                return sticky;
+            }
+
+            bool odd() const
+            {
+                return size_ > 0 && (limbs_[0] & 1);
+            }
+
+            /**
+             * Writes the decimal digits of the number to buf,
+             * destroys the number and returns the digit count.
+             */
+            int to_decimal(char* buf)
+            {
+                /**
+                 * Produce 9 digits at a time from the
+                 * back and reverse them at the end.
+                 */
+                int len{};
+                do
+                {
+                    auto chunk = div_small(1000000000U);
+                    for (int i = 0; i < 9 && (chunk || size_ > 0 || i == 0); ++i)
+                    {
+                        buf[len++] = static_cast<char>('0' + chunk % 10);
+                        chunk /= 10;
+                    }
+                } while (size_ > 0);
+
+                for (int i = 0, j = len - 1; i < j; ++i, --j)
+                {
+                    auto tmp = buf[i];
+                    buf[i] = buf[j];
+                    buf[j] = tmp;
+                }
+
+                return len;
+            }
+
+            int compare(const bignum& other) const
+            {
+                if (size_ != other.size_)
+                    return size_ < other.size_ ? -1 : 1;
+
+                for (size_t i = size_; i > 0; --i)
+                {
+                    if (limbs_[i - 1] != other.limbs_[i - 1])
+                        return limbs_[i - 1] < other.limbs_[i - 1] ? -1 : 1;
+                }
+
+                return 0;
+            }
+
+        private:
+            static constexpr size_t limb_count{200};
+
+            /**
+             * 5^13 is the largest power of five
+             * that fits into a limb.
+             */
+            static constexpr uint32_t pow5_[] = {
+                1, 5, 25, 125, 625, 3125, 15625, 78125, 390625,
+                1953125, 9765625, 48828125, 244140625, 1220703125
+            };
+
+            uint32_t limbs_[limb_count];
+            size_t size_;
+    };
+
+    /**
+     * Formatting.
+     */
+
+    /**
+     * A double has at most 767 significant decimal
+     * digits, which bounds any exact conversion.
+     */
+    constexpr int max_exact_digits{800};
+
+    /**
+     * Decimal digits of a value, the value is
+     * digits * 10^exp.
+     */
+    struct decimal
+    {
+        char digits[max_exact_digits];
+        int len;
+        int exp;
+    };
+
+    /**
+     * The digit generation only looks at the significand and
+     * exponent and derives the rounding interval from them,
+     * so we can describe a float the same way as extract_ieee_double
+     * describes a double and get the shortest digits for a float.
+     */
+    ieee_double_t extract_ieee_float(float val)
+    {
+        uint32_t bits{};
+        std::memcpy(&bits, &val, sizeof(bits));
+
+        auto raw_exponent = static_cast<int>((bits >> 23) & 0xff);
+        auto raw_significand = bits & 0x7fffffU;
+
+        ieee_double_t res{};
+        res.is_negative = (bits >> 31) != 0;
+        res.is_special = (raw_exponent == 0xff);
+        if (res.is_special)
+        {
+            res.is_infinity = (raw_significand == 0);
+            res.is_nan = (raw_significand != 0);
+            res.is_denormal = true;
+        }
+        else
+        {
+            res.is_denormal = (raw_exponent == 0);
+            if (res.is_denormal)
+            {
+                res.pos_val.significand = raw_significand;
+                res.pos_val.exponent = 1 - 150;
+            }
+            else
+            {
+                res.pos_val.significand = raw_significand + (1U << 23);
+                res.pos_val.exponent = raw_exponent - 150;
+                res.is_accuracy_step = (raw_significand == 0) && (raw_exponent != 1);
+            }
+        }
+
+        return res;
+    }
+
+    /**
+     * Output that remembers whether everything fit.
+     */
+    class writer
+    {
+        public:
+            writer(char* first, char* last)
+                : it_{first}, last_{last}, ok_{true}
+            { /* DUMMY BODY */ }
+
+            void put(char c)
+            {
+                if (it_ != last_)
+                    *it_++ = c;
+                else
+                    ok_ = false;
+            }
+
+            void put(const char* str, int n)
+            {
+                if (n <= 0)
+                    return;
+
+                if (last_ - it_ < n)
+                {
+                    ok_ = false;
+                    it_ = last_;
+                }
+                else
+                {
+                    std::memcpy(it_, str, n);
+                    it_ += n;
+                }
+            }
+
+            void fill(char c, int n)
+            {
+                if (n <= 0)
+                    return;
+
+                if (last_ - it_ < n)
+                {
+                    ok_ = false;
+                    it_ = last_;
+                }
+                else
+                {
+                    std::memset(it_, c, n);
+                    it_ += n;
+                }
+            }
+
+            std::to_chars_result result() const
+            {
+                if (ok_)
+                    return {it_, std::errc{}};
+                else
+                    return {last_, std::errc::value_too_large};
+            }
+
+        private:
+            char* it_;
+            char* last_;
+            bool ok_;
+    };
+
+    /**
+     * Rounds away the last digit, see fp_round_up in printf_core.
+     */
+    void round_last_digit(decimal& dec)
+    {
+        auto buf = dec.digits;
+        if (dec.len <= 0)
+        {
+            /**
+             * Nothing left above the requested
+             * position, the value rounds to zero.
+             */
+            buf[0] = '0';
+            dec.exp = 0;
+            dec.len = 1;
+
+            return;
+        }
+
+        int carry = ('5' <= buf[dec.len - 1]);
+
+        --dec.len;
+        ++dec.exp;
+
+        auto last_digit = buf + dec.len - 1;
+        if (carry)
+        {
+            while (buf <= last_digit && *last_digit == '9')
+                --last_digit;
+
+            if (buf <= last_digit)
+            {
+                *last_digit += 1;
+                int new_len = last_digit - buf + 1;
+                dec.exp += dec.len - new_len;
+                dec.len = new_len;
+            }
+            else
+            {
+                buf[0] = '1';
+                dec.exp += dec.len;
+                dec.len = 1;
+            }
+        }
+        else if (last_digit < buf)
+        {
+            buf[0] = '0';
+            dec.exp = 0;
+            dec.len = 1;
+        }
+    }
+
+    void trim_trailing_zeros(decimal& dec)
+    {
+        while (dec.len >= 2 && dec.digits[dec.len - 1] == '0')
+        {
+            --dec.len;
+            ++dec.exp;
+        }
+    }
+
+    int max(int a, int b)
+    {
+        return a < b ? b : a;
+    }
+
+    int min(int a, int b)
+    {
+        return a < b ? a : b;
+    }
+
+    /**
+     * Writes dec as [d]d.ddd with precision fractional digits,
+     * see print_double_str_fixed in printf_core.
+     */
+    void put_fixed(writer& w, const decimal& dec, int precision, bool trim)
+    {
+        int int_len = max(1, dec.len + dec.exp);
+
+        int last_frac_signif_pos = max(0, -dec.exp);
+        int leading_frac_zeros = max(0, last_frac_signif_pos - dec.len);
+        int signif_frac_figs = min(last_frac_signif_pos, dec.len);
+        int trailing_frac_zeros = trim ? 0 : precision - last_frac_signif_pos;
+        int frac_len = leading_frac_zeros + signif_frac_figs + trailing_frac_zeros;
+
+        int buf_int_len = min(dec.len, dec.len + dec.exp);
+        if (buf_int_len > 0)
+        {
+            w.put(dec.digits, buf_int_len);
+            w.fill('0', int_len - buf_int_len);
+        }
+        else
+            w.put('0');
+
+        if (frac_len > 0)
+        {
+            w.put('.');
+            w.fill('0', leading_frac_zeros);
+            w.put(dec.digits + dec.len - signif_frac_figs, signif_frac_figs);
+            w.fill('0', trailing_frac_zeros);
+        }
+    }
+
+    /**
+     * Writes dec as d.ddde+dd with precision fractional digits,
+     * see print_double_str_scient in printf_core.
+     */
+    void put_scientific(writer& w, const decimal& dec, int precision, bool trim)
+    {
+        int signif_frac_figs = dec.len - 1;
+        int trailing_frac_zeros = trim ? 0 : precision - signif_frac_figs;
+
+        w.put(dec.digits[0]);
+        if (signif_frac_figs + max(trailing_frac_zeros, 0) > 0)
+        {
+            w.put('.');
+            w.put(dec.digits + 1, signif_frac_figs);
+            w.fill('0', trailing_frac_zeros);
+        }
+
+        int exp = dec.exp + dec.len - 1;
+        w.put('e');
+        w.put(exp < 0 ? '-' : '+');
+
+        exp = exp < 0 ? -exp : exp;
+        if (exp >= 100)
+        {
+            w.put(static_cast<char>('0' + exp / 100));
+            exp %= 100;
+        }
+        w.put(std::aux::digit_pairs + exp * 2, 2);
+    }
+
+    int fixed_length(const decimal& dec)
+    {
+        if (dec.exp >= 0)
+            return dec.len + dec.exp;
+        else if (dec.len + dec.exp > 0)
+            return dec.len + 1;
+        else
+            return 2 - dec.exp;
+    }
+
+    int scientific_length(const decimal& dec)
+    {
+        int exp = dec.exp + dec.len - 1;
+        exp = exp < 0 ? -exp : exp;
+
+        return dec.len + (dec.len > 1 ? 1 : 0) + (exp >= 100 ? 5 : 4);
+    }
+
+    /**
+     * Compares c * 10^k with n * 2^p exactly.
+     */
+    int compare_scaled(uint64_t c, int k, uint64_t n, int p)
+    {
+        bignum lhs{c};
+        bignum rhs{n};
+
+        if (k >= 0)
+            lhs.mul_pow5(k);
+        else
+            rhs.mul_pow5(-k);
+
+        if (k > p)
+            lhs.shift_left(k - p);
+        else
+            rhs.shift_left(p - k);
+
+        return lhs.compare(rhs);
+    }
+
+    /**
+     * Tells if c * 10^k lies above the lower or below the upper
+     * boundary of the rounding interval of val, i.e. if it reads
+     * back as val provided it lies on the right side of val. The
+     * boundaries themselves round to an even significand.
+     */
+    bool above_lower(uint64_t c, int k, const ieee_double_t& val)
+    {
+        auto m = val.pos_val.significand;
+        auto q = val.pos_val.exponent;
+
+        int cmp = val.is_accuracy_step
+            ? compare_scaled(c, k, 4 * m - 1, q - 2)
+            : compare_scaled(c, k, 2 * m - 1, q - 1);
+
+        return cmp > 0 || (cmp == 0 && (m & 1) == 0);
+    }
+
+    bool below_upper(uint64_t c, int k, const ieee_double_t& val)
+    {
+        auto m = val.pos_val.significand;
+        int cmp = compare_scaled(c, k, 2 * m + 1, val.pos_val.exponent - 1);
+
+        return cmp < 0 || (cmp == 0 && (m & 1) == 0);
+    }
+
+    /**
+     * Tells if candidates spaced 10^e apart are too far from each
+     * other for two of them to lie in the rounding interval of val,
+     * which is at most 2^q wide, i.e. if q * log10(2) < e. The
+     * margin covers the rounding of the double arithmetic.
+     */
+    bool spaced_apart(int e, const ieee_double_t& val)
+    {
+        return val.pos_val.exponent * 0.30102999566398120 < e - 1e-9;
+    }
+
+    /**
+     * Decimal exponent beyond which a positive finite
+     * double has no more nonzero digits.
+     */
+    int exact_exponent(double val)
+    {
+        uint64_t bits{};
+        std::memcpy(&bits, &val, sizeof(bits));
+
+        auto raw_exponent = static_cast<int>(bits >> 52);
+        int exp = (raw_exponent ? raw_exponent : 1) - 1075;
+
+        return exp < 0 ? -exp : 0;
+    }
+
+    /**
+     * Exact digits of val * 10^scale rounded half to even
+     * to an integer, val must be positive and finite.
+     */
+    void exact_digits(decimal& dec, double val, int scale)
+    {
+        uint64_t bits{};
+        std::memcpy(&bits, &val, sizeof(bits));
+
+        auto raw_exponent = static_cast<int>(bits >> 52);
+        uint64_t mant = bits & ((uint64_t{1} << 52) - 1);
+        int exp = 1 - 1075;
+        if (raw_exponent)
+        {
+            mant |= uint64_t{1} << 52;
+            exp = raw_exponent - 1075;
+        }
+
+        /**
+         * Compute the integer part of twice the scaled value
+         * and remember if anything was lost, the lowest bit
+         * then tells us on which side of the halfway point
+         * we are.
+         */
+        bignum num{mant};
+        int exp2 = exp + scale + 1;
+        bool sticky{false};
+
+        if (exp2 > 0)
+            num.shift_left(exp2);
+        if (scale > 0)
+            num.mul_pow5(scale);
+        else
+            sticky = num.div_pow5(-scale);
+        if (exp2 < 0)
+            sticky = num.shift_right(-exp2) || sticky;
+
+        bool half = num.odd();
+        num.shift_right(1);
+        if (half && (sticky || num.odd()))
+            num.mul_add(1, 1);
+
+        dec.len = num.to_decimal(dec.digits);
+        dec.exp = -scale;
+    }
+
+    uint64_t digits_value(const decimal& dec)
+    {
+        uint64_t res{};
+        for (int i = 0; i < dec.len; ++i)
+            res = res * 10 + static_cast<uint64_t>(dec.digits[i] - '0');
+
+        return res;
+    }
+
+    bool reads_back(uint64_t c, int k, const ieee_double_t& val)
+    {
+        return above_lower(c, k, val) && below_upper(c, k, val);
+    }
+
+    /**
+     * Digits of the shortest representation that reads
+     * back as the same value, the closest one to the value
+     * if there are more of them, val must be positive.
+     *
+     * Grisu2 in double_to_short_str always produces digits that
+     * read back as the value, but neither are they always the
+     * shortest ones (9.999999999999999e+22 instead of 1e+23) nor
+     * the closest ones of their length. We check both exactly
+     * unless the digits are spaced too far apart for another
+     * candidate to fit in the rounding interval.
+     */
+    void shortest_digits(decimal& dec, const ieee_double_t& ieee, double val)
+    {
+        dec.len = ::helenos::double_to_short_str(
+            ieee, dec.digits, sizeof(dec.digits), &dec.exp
+        );
+
+        if (dec.len > 17 || spaced_apart(dec.exp, ieee))
+            return;
+
+        uint64_t d = digits_value(dec);
+        int e = dec.exp;
+        bool closest{false};
+
+        /**
+         * Any shorter number in the interval implies that d with
+         * its last digit rounded off down or up is in it as well.
+         * Both lie on one side of the value, so each has only one
+         * boundary to check.
+         */
+        while (d >= 10 && (above_lower(d / 10, e + 1, ieee) ||
+                           below_upper(d / 10 + 1, e + 1, ieee)))
+        {
+            /**
+             * The value rounded to one digit less is the closest
+             * candidate. If it does not read back as the value,
+             * its neighbour on the other side of the value does.
+             */
+            exact_digits(dec, val, -(e + 1));
+            d = digits_value(dec);
+            ++e;
+
+            if (!reads_back(d, e, ieee))
+            {
+                auto m = ieee.pos_val.significand;
+                if (compare_scaled(d, e, m, ieee.pos_val.exponent) > 0)
+                    --d;
+                else
+                    ++d;
+            }
+
+            while (d % 10 == 0)
+            {
+                d /= 10;
+                ++e;
+            }
+
+            closest = true;
+        }
+
+        if (!closest)
+        {
+            exact_digits(dec, val, -e);
+
+            auto r = digits_value(dec);
+            if (r != d && reads_back(r, e, ieee))
+            {
+                d = r;
+                while (d % 10 == 0)
+                {
+                    d /= 10;
+                    ++e;
+                }
+            }
+        }
+
+        dec.len = 0;
+        for (auto tmp = d; tmp > 0; tmp /= 10)
+            ++dec.len;
+        for (int i = dec.len; i > 0; --i, d /= 10)
+            dec.digits[i - 1] = static_cast<char>('0' + d % 10);
+        dec.exp = e;
+    }
+
+    /**
+     * The digits of double_to_fixed_str may be off by one in
+     * the last place, which only changes the rounding if we
+     * are close to a halfway point. We can only rely on them
+     * if all digits we asked for were produced, otherwise we
+     * fall back to the exact conversion. The error also grows
+     * beyond 17 digits as the 64 bit arithmetic runs out.
+     */
+    bool safe_to_round(const decimal& dec)
+    {
+        auto last = dec.digits[dec.len - 1];
+
+        return dec.len <= 17 && (last < '4' || '6' < last);
+    }
+
+    /**
+     * Digits rounded to precision fractional digits.
+     */
+    void fixed_digits(decimal& dec, const ieee_double_t& ieee, double val, int precision)
+    {
+        dec.len = ::helenos::double_to_fixed_str(
+            ieee, -1, precision + 1, dec.digits, sizeof(dec.digits), &dec.exp
+        );
+
+        if (dec.len > 0 && dec.exp == -(precision + 1) && safe_to_round(dec))
+            round_last_digit(dec);
+        else
+            exact_digits(dec, val, min(precision, exact_exponent(val)));
+    }
+
+    /**
+     * Digits rounded to count significant digits.
+     */
+    void significant_digits(decimal& dec, const ieee_double_t& ieee, double val, int count)
+    {
+        dec.len = ::helenos::double_to_fixed_str(
+            ieee, count + 1, -1, dec.digits, sizeof(dec.digits), &dec.exp
+        );
+
+        if (dec.len == count + 1 && safe_to_round(dec))
+        {
+            round_last_digit(dec);
+
+            return;
+        }
+
+        /**
+         * The shortest digits tell us the exponent of the
+         * leading digit, unless they rounded up to the next
+         * power of ten.
+         */
+        shortest_digits(dec, ieee, val);
+        int lead_exp = dec.exp + dec.len - 1;
+        int exact_exp = exact_exponent(val);
+
+        while (true)
+        {
+            int scale = count - 1 - lead_exp;
+            int exact_scale = min(scale, exact_exp);
+            int expected = count - (scale - exact_scale);
+
+            exact_digits(dec, val, exact_scale);
+            if (dec.len < expected)
+            {
+                --lead_exp;
+
+                continue;
+            }
+            else if (dec.len > expected)
+            {
+                /**
+                 * Rounded up to a power of ten.
+                 */
+                dec.exp += dec.len - 1;
+                dec.len = 1;
+            }
+
+            break;
+        }
+    }
+
+    /**
+     * Writes val as [h].hhhp+d, precision < 0 means
+     * as many digits as needed.
+     */
+    void put_hex(writer& w, double val, int precision)
+    {
+        uint64_t bits{};
+        std::memcpy(&bits, &val, sizeof(bits));
+
+        auto raw_exponent = static_cast<int>((bits >> 52) & 0x7ff);
+        auto frac = bits & ((uint64_t{1} << 52) - 1);
+
+        unsigned lead{};
+        int exp{};
+        if (raw_exponent != 0)
+        {
+            lead = 1;
+            exp = raw_exponent - 1023;
+        }
+        else if (frac != 0)
+            exp = -1022;
+
+        int ndigits = 13;
+        if (precision < 0)
+        {
+            while (ndigits > 0 && (frac & 0xf) == 0)
+            {
+                frac >>= 4;
+                --ndigits;
+            }
+        }
+        else if (precision < ndigits)
+        {
+            /**
+             * Round half to even, a carry can make
+             * the leading digit 2.
+             */
+            auto shift = 4 * (ndigits - precision);
+            auto rem = frac & ((uint64_t{1} << shift) - 1);
+            auto half = uint64_t{1} << (shift - 1);
+
+            frac >>= shift;
+            if (rem > half || (rem == half && (frac & 1)))
+                ++frac;
+
+            ndigits = precision;
+            if ((frac >> (4 * ndigits)) != 0)
+            {
+                ++lead;
+                frac &= (uint64_t{1} << (4 * ndigits)) - 1;
+            }
+        }
+
+        w.put(std::aux::digits[lead]);
+        if (ndigits > 0 || precision > 0)
+        {
+            w.put('.');
+            for (int i = ndigits - 1; i >= 0; --i)
+                w.put(std::aux::digits[(frac >> (4 * i)) & 0xf]);
+            w.fill('0', precision - ndigits);
+        }
+
+        w.put('p');
+        w.put(exp < 0 ? '-' : '+');
+
+        char buf[8];
+        auto res = std::to_chars(buf, buf + sizeof(buf), exp < 0 ? -exp : exp);
+        w.put(buf, res.ptr - buf);
+    }
+}
+
+namespace std::aux
+{
+    /**
+     * Common implementation of the floating point to_chars overloads.
+     * Mirrors the %f, %e, %g and %a conversions of printf_core, with
+     * the difference that the shortest representation is used if no
+     * precision is given.
+     */
+    to_chars_result to_chars_float(char* first, char* last, double val,
+                                   bool single, chars_format fmt,
+                                   bool shortest, int precision)
+    {
+        writer w{first, last};
+
+        auto ieee = single ? extract_ieee_float(static_cast<float>(val))
+                           : ::helenos::extract_ieee_double(val);
+
+        if (ieee.is_negative)
+            w.put('-');
+
+        if (ieee.is_special)
+        {
+            w.put(ieee.is_nan ? "nan" : "inf", 3);
+
+            return w.result();
+        }
+
+        if (!shortest && precision < 0)
+            precision = 6;
+
+        if (fmt == chars_format::hex)
+        {
+            put_hex(w, val < 0 ? -val : val, shortest ? -1 : precision);
+
+            return w.result();
+        }
+
+        decimal dec{};
+        if (shortest)
+        {
+            shortest_digits(dec, ieee, val < 0 ? -val : val);
+
+            if (fmt == chars_format::fixed)
+                put_fixed(w, dec, max(0, -dec.exp), false);
+            else if (fmt == chars_format::scientific)
+                put_scientific(w, dec, dec.len - 1, false);
+            else if (fmt == chars_format::general)
+            {
+                /**
+                 * Like %g with precision set to the
+                 * number of digits we have.
+                 */
+                int exp = dec.exp + dec.len - 1;
+                if (-4 <= exp && exp < dec.len)
+                    put_fixed(w, dec, max(0, -dec.exp), true);
+                else
+                    put_scientific(w, dec, dec.len - 1, true);
+            }
+            else
+            {
+                /**
+                 * No format given, use whichever of the two
+                 * is shorter and prefer fixed on a tie (23.2.1).
+                 */
+                if (fixed_length(dec) <= scientific_length(dec))
+                    put_fixed(w, dec, max(0, -dec.exp), false);
+                else
+                    put_scientific(w, dec, dec.len - 1, false);
+            }
+        }
+        else if (val == 0)
+        {
+            dec.digits[0] = '0';
+            dec.len = 1;
+
+            if (fmt == chars_format::fixed)
+                put_fixed(w, dec, precision, false);
+            else if (fmt == chars_format::scientific)
+                put_scientific(w, dec, precision, false);
+            else
+                put_fixed(w, dec, 0, true);
+        }
+        else if (fmt == chars_format::fixed)
+        {
+            fixed_digits(dec, ieee, val < 0 ? -val : val, precision);
+            put_fixed(w, dec, precision, false);
+        }
+        else if (fmt == chars_format::scientific)
+        {
+            significant_digits(dec, ieee, val < 0 ? -val : val, precision + 1);
+            put_scientific(w, dec, precision, false);
+        }
+        else
+        {
+            /**
+             * Like %g, the exponent of the value rounded to
+             * precision digits decides the style. Both use the
+             * same digits, so round only once.
+             */
+            precision = max(1, precision);
+            significant_digits(dec, ieee, val < 0 ? -val : val, precision);
+            trim_trailing_zeros(dec);
+
+            int exp = dec.exp + dec.len - 1;
+            if (-4 <= exp && exp < precision)
+                put_fixed(w, dec, max(0, -dec.exp), true);
+            else
+                put_scientific(w, dec, dec.len - 1, true);
+        }
+
+        return w.result();
+    }
+}
+
+namespace
+{
+    /**
+     * Parsing.
+     */
+
+    template<class T>
+    struct float_traits;
+
+    template<>
+    struct float_traits<float>
+    {
+        using bits_type = uint32_t;
+
+        static constexpr int mantissa_bits{23};
+        static constexpr int exponent_bias{127};
+        static constexpr int max_exponent{0xff};
+
+        /**
+         * Exact powers of ten and the decimal exponents
+         * beyond which the value is zero or infinity.
+         */
+        static constexpr int max_exact_pow10{10};
+        static constexpr int min_dec_exponent{-46};
+        static constexpr int max_dec_exponent{39};
+    };
+
+    template<>
+    struct float_traits<double>
+    {
+        using bits_type = uint64_t;
+
+        static constexpr int mantissa_bits{52};
+        static constexpr int exponent_bias{1023};
+        static constexpr int max_exponent{0x7ff};
+
+        static constexpr int max_exact_pow10{22};
+        static constexpr int min_dec_exponent{-324};
+        static constexpr int max_dec_exponent{309};
+    };
+
+    template<class T>
+    T from_bits(typename float_traits<T>::bits_type bits, bool negative)
+    {
+        if (negative)
+            bits |= typename float_traits<T>::bits_type{1} << (sizeof(bits) * 8 - 1);
+
+        T res{};
+        std::memcpy(&res, &bits, sizeof(res));
+
+        return res;
+    }
+
+    template<class T>
+    typename float_traits<T>::bits_type to_bits(T val)
+    {
+        typename float_traits<T>::bits_type res{};
+        std::memcpy(&res, &val, sizeof(res));
+
+        return res;
+    }
+
+    template<class T>
+    constexpr typename float_traits<T>::bits_type infinity_bits()
+    {
+        using traits = float_traits<T>;
+
+        return typename traits::bits_type{traits::max_exponent} << traits::mantissa_bits;
+    }
+
+    /**
+     * Significant digits of a decimal number, possibly split
+     * by a decimal point, the value is 0.ddd * 10^point.
+     */
+    class digit_string
+    {
+        public:
+            /**
+             * Digits beyond this do not change the result except
+             * for telling us that the number is above a halfway
+             * point, see 'sticky' below.
+             */
+            static constexpr int max_digits{800};
+
+            digit_string(const char* int_first, const char* int_last,
+                         const char* frac_first, const char* frac_last)
+                : int_first_{int_first}, int_last_{int_last},
+                  frac_first_{frac_first}, frac_last_{frac_last}, point_{}
+            {
+                while (int_first_ != int_last_ && *int_first_ == '0')
+                    ++int_first_;
+
+                if (int_first_ == int_last_)
+                {
+                    while (frac_first_ != frac_last_ && *frac_first_ == '0')
+                    {
+                        ++frac_first_;
+                        --point_;
+                    }
+                }
+                else
+                    point_ = static_cast<int>(int_last_ - int_first_);
+
+                while (frac_last_ != frac_first_ && *(frac_last_ - 1) == '0')
+                    --frac_last_;
+                if (frac_first_ == frac_last_)
+                {
+                    while (int_last_ != int_first_ && *(int_last_ - 1) == '0')
+                        --int_last_;
+                }
+            }
+
+            bool zero() const
+            {
+                return int_first_ == int_last_ && frac_first_ == frac_last_;
+            }
+
+            int point() const
+            {
+                return point_;
+            }
+
+            int size() const
+            {
+                return static_cast<int>((int_last_ - int_first_) + (frac_last_ - frac_first_));
+            }
+
+            int operator[](int i) const
+            {
+                auto int_size = static_cast<int>(int_last_ - int_first_);
+                if (i < int_size)
+                    return int_first_[i] - '0';
+                else
+                    return frac_first_[i - int_size] - '0';
+            }
+
+        private:
+            const char* int_first_;
+            const char* int_last_;
+            const char* frac_first_;
+            const char* frac_last_;
+            int point_;
+    };
+
+    /**
+     * Compares the decimal number ds * 10^exp10 with
+     * mant * 2^exp2.
+     */
+    int compare_decimal(const digit_string& ds, int count, bool sticky,
+                        int exp10, uint64_t mant, int exp2)
+    {
+        bignum lhs{};
+        int i{};
+        for (; i + 9 <= count; i += 9)
+        {
+            uint32_t chunk{};
+            for (int j = 0; j < 9; ++j)
+                chunk = chunk * 10 + ds[i + j];
+            lhs.mul_add(1000000000U, chunk);
+        }
+        for (; i < count; ++i)
+            lhs.mul_add(10, ds[i]);
+
+        bignum rhs{mant};
+        if (exp10 >= 0)
+            lhs.mul_pow5(exp10);
+        else
+            rhs.mul_pow5(-exp10);
+
+        if (exp10 >= exp2)
+            lhs.shift_left(exp10 - exp2);
+        else
+            rhs.shift_left(exp2 - exp10);
+
+        auto res = lhs.compare(rhs);
+        if (res == 0 && sticky)
+            res = 1;
+
+        return res;
+    }
+
+    /**
+     * Rounds mant * 2^exp2 (plus something below the last
+     * bit if sticky) to the nearest T, returns its bits.
+     */
+    template<class T>
+    typename float_traits<T>::bits_type assemble(uint64_t mant, int exp2, bool sticky)
+    {
+        using traits = float_traits<T>;
+        using bits_type = typename traits::bits_type;
+
+        if (mant == 0)
+            return 0;
+
+        /**
+         * Normalize so that the top bit is bit 63,
+         * then work out how many bits to drop.
+         */
+        auto lz = __builtin_clzll(mant);
+        mant <<= lz;
+        exp2 -= lz;
+
+        int exponent = exp2 + 63 + traits::exponent_bias;
+        int drop = 63 - traits::mantissa_bits;
+        if (exponent <= 0)
+        {
+            drop += 1 - exponent;
+            exponent = 0;
+        }
+
+        if (drop > 64)
+            return 0;
+
+        uint64_t kept = drop == 64 ? 0 : mant >> drop;
+        uint64_t rem = drop == 64 ? mant : mant & ((uint64_t{1} << drop) - 1);
+        uint64_t half = uint64_t{1} << (drop - 1);
+
+        if (rem > half || (rem == half && (sticky || (kept & 1))))
+            ++kept;
+
+        /**
+         * The hidden bit of kept is added to the exponent, which
+         * also takes care of a carry out of the mantissa and of
+         * a subnormal that rounded up to the smallest normal.
+         */
+        auto res = (static_cast<bits_type>(exponent > 0 ? exponent - 1 : 0) << traits::mantissa_bits)
+                   + static_cast<bits_type>(kept);
+        if (res >= infinity_bits<T>())
+            return infinity_bits<T>();
+
+        return res;
+    }
+
+    template<class T>
+    T pow10(int exp)
+    {
+        static constexpr T pow10_table[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        return pow10_table[exp];
+    }
+
+    /**
+     * Scales mant by 10^exp10 in long double, which only
+     * gives us a first estimate of the result.
+     */
+    long double estimate(uint64_t mant, int exp10)
+    {
+        long double res = mant;
+        long double base = exp10 < 0 ? 0.1L : 10.0L;
+
+        auto exp = static_cast<unsigned>(exp10 < 0 ? -exp10 : exp10);
+        while (exp > 300)
+        {
+            res *= exp10 < 0 ? 1e-300L : 1e300L;
+            exp -= 300;
+        }
+
+        long double scale = 1.0L;
+        for (; exp; exp >>= 1)
+        {
+            if (exp & 1)
+                scale *= base;
+            base *= base;
+        }
+
+        return res * scale;
+    }
+
+    /**
+     * Converts a decimal number to the nearest T. The fast path
+     * is exact if both the digits and the power of ten are
+     * exactly representable, otherwise we start from an
+     * estimate and correct it comparing the input with the
+     * halfway points to the neighbours exactly.
+     */
+    template<class T>
+    bool decimal_to_float(const digit_string& ds, int exp10, T& val)
+    {
+        using traits = float_traits<T>;
+        using bits_type = typename traits::bits_type;
+
+        if (ds.zero())
+        {
+            val = T{};
+
+            return true;
+        }
+
+        auto magnitude = ds.point() + exp10;
+        if (magnitude > traits::max_dec_exponent || magnitude < traits::min_dec_exponent)
+            return false;
+
+        /**
+         * Up to 19 significant digits fit into 64 bits.
+         */
+        int count = ds.size() < 19 ? ds.size() : 19;
+        uint64_t mant{};
+        for (int i = 0; i < count; ++i)
+            mant = mant * 10 + static_cast<uint64_t>(ds[i]);
+        int mant_exp10 = magnitude - count;
+
+        if (count == ds.size() &&
+            mant <= (uint64_t{1} << (traits::mantissa_bits + 1)) &&
+            -traits::max_exact_pow10 <= mant_exp10 &&
+            mant_exp10 <= traits::max_exact_pow10)
+        {
+            auto res = static_cast<T>(mant);
+            if (mant_exp10 < 0)
+                res /= pow10<T>(-mant_exp10);
+            else
+                res *= pow10<T>(mant_exp10);
+            val = res;
+
+            return true;
+        }
+
+        auto bits = to_bits(static_cast<T>(estimate(mant, mant_exp10)));
+        if (bits >= infinity_bits<T>())
+            bits = infinity_bits<T>() - 1;
+
+        int digits = ds.size() < digit_string::max_digits ? ds.size() : digit_string::max_digits;
+        bool sticky = ds.size() > digits;
+        int digits_exp10 = magnitude - digits;
+
+        while (true)
+        {
+            auto raw_exponent = static_cast<int>(bits >> traits::mantissa_bits);
+            auto frac = static_cast<uint64_t>(bits & ((bits_type{1} << traits::mantissa_bits) - 1));
+
+            uint64_t m = frac;
+            int e = 1 - traits::exponent_bias - traits::mantissa_bits;
+            if (raw_exponent > 0)
+            {
+                m |= uint64_t{1} << traits::mantissa_bits;
+                e = raw_exponent - traits::exponent_bias - traits::mantissa_bits;
+            }
+
+            /**
+             * Halfway up is (2m + 1) * 2^(e - 1), halfway down
+             * is closer if we are at a power of two.
+             */
+            auto cmp = compare_decimal(ds, digits, sticky, digits_exp10, 2 * m + 1, e - 1);
+            if (cmp > 0 || (cmp == 0 && (bits & 1)))
+            {
+                ++bits;
+                if (bits == infinity_bits<T>())
+                    return false;
+
+                continue;
+            }
+
+            if (bits == 0)
+                break;
+
+            if (frac == 0 && raw_exponent > 1)
+                cmp = compare_decimal(ds, digits, sticky, digits_exp10, 4 * m - 1, e - 2);
+            else
+                cmp = compare_decimal(ds, digits, sticky, digits_exp10, 2 * m - 1, e - 1);
+
+            if (cmp < 0 || (cmp == 0 && (bits & 1)))
+            {
+                --bits;
+
+                continue;
+            }
+
+            break;
+        }
+
+        if (bits == 0)
+            return false;
+
+        val = from_bits<T>(bits, false);
+
+        return true;
+    }
+
+    bool is_digit(char c, int base)
+    {
+        return std::aux::digit_value(c) < base;
+    }
+
+    bool match_ci(const char* first, const char* last, const char* str)
+    {
+        for (; *str; ++first, ++str)
+        {
+            if (first == last || (*first | 0x20) != *str)
+                return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * Parses the pattern described in 23.2.2 and converts it.
+     */
+    template<class T>
+    std::from_chars_result parse_float(const char* first, const char* last,
+                                       T& val, std::chars_format fmt)
+    {
+        using traits = float_traits<T>;
+        using bits_type = typename traits::bits_type;
+
+        auto it = first;
+        bool negative{false};
+        if (it != last && *it == '-')
+        {
+            negative = true;
+            ++it;
+        }
+
+        if (match_ci(it, last, "inf"))
+        {
+            it += 3;
+            if (match_ci(it, last, "inity"))
+                it += 5;
+            val = from_bits<T>(infinity_bits<T>(), negative);
+
+            return {it, std::errc{}};
+        }
+        else if (match_ci(it, last, "nan"))
+        {
+            it += 3;
+            if (it != last && *it == '(')
+            {
+                auto paren = it + 1;
+                while (paren != last && (is_digit(*paren, 36) || *paren == '_'))
+                    ++paren;
+                if (paren != last && *paren == ')')
+                    it = paren + 1;
+            }
+
+            auto quiet = bits_type{1} << (traits::mantissa_bits - 1);
+            val = from_bits<T>(infinity_bits<T>() | quiet, negative);
+
+            return {it, std::errc{}};
+        }
+
+        int base = (fmt == std::chars_format::hex) ? 16 : 10;
+
+        auto int_first = it;
+        while (it != last && is_digit(*it, base))
+            ++it;
+        auto int_last = it;
+
+        auto frac_first = it;
+        auto frac_last = it;
+        if (it != last && *it == '.')
+        {
+            frac_first = ++it;
+            while (it != last && is_digit(*it, base))
+                ++it;
+            frac_last = it;
+        }
+
+        if (int_first == int_last && frac_first == frac_last)
+            return {first, std::errc::invalid_argument};
+
+        /**
+         * The exponent is optional for general and hex, required
+         * for scientific and not allowed for fixed.
+         */
+        int exp{};
+        bool has_exp{false};
+        char exp_char = (base == 16) ? 'p' : 'e';
+        if (fmt != std::chars_format::fixed && it != last && (*it | 0x20) == exp_char)
+        {
+            auto exp_it = it + 1;
+            bool exp_negative{false};
+            if (exp_it != last && (*exp_it == '-' || *exp_it == '+'))
+            {
+                exp_negative = (*exp_it == '-');
+                ++exp_it;
+            }
+
+            if (exp_it != last && is_digit(*exp_it, 10))
+            {
+                for (; exp_it != last && is_digit(*exp_it, 10); ++exp_it)
+                {
+                    /**
+                     * Saturate, anything this big
+                     * is zero or infinity anyway.
+                     */
+                    if (exp < 100000)
+                        exp = exp * 10 + (*exp_it - '0');
+                }
+
+                exp = exp_negative ? -exp : exp;
+                has_exp = true;
+                it = exp_it;
+            }
+        }
+
+        if (fmt == std::chars_format::scientific && !has_exp)
+            return {first, std::errc::invalid_argument};
+
+        T res{};
+        if (base == 16)
+        {
+            /**
+             * Only 16 hex digits fit into the mantissa,
+             * the rest only matters for rounding.
+             */
+            uint64_t mant{};
+            int count{};
+            bool sticky{false};
+            int exp2 = exp;
+
+            auto digit = [&](char c, bool fractional) {
+                auto d = static_cast<uint64_t>(std::aux::digit_value(c));
+                if (count == 0 && d == 0)
+                {
+                    if (fractional)
+                        exp2 -= 4;
+
+                    return;
+                }
+
+                if (count < 16)
+                {
+                    mant = mant * 16 + d;
+                    ++count;
+                    if (fractional)
+                        exp2 -= 4;
+                }
+                else
+                {
+                    sticky = sticky || d != 0;
+                    if (!fractional)
+                        exp2 += 4;
+                }
+            };
+
+            for (auto c = int_first; c != int_last; ++c)
+                digit(*c, false);
+            for (auto c = frac_first; c != frac_last; ++c)
+                digit(*c, true);
+
+            auto bits = assemble<T>(mant, exp2, sticky);
+            if (bits == infinity_bits<T>() || (bits == 0 && mant != 0))
+                return {it, std::errc::result_out_of_range};
+
+            res = from_bits<T>(bits, false);
+        }
+        else
+        {
+            digit_string ds{int_first, int_last, frac_first, frac_last};
+            if (!decimal_to_float(ds, exp, res))
+                return {it, std::errc::result_out_of_range};
+        }
+
+        val = negative ? -res : res;
+
+        return {it, std::errc{}};
+    }
+}
+
+namespace std
+{
+    to_chars_result to_chars(char* first, char* last, float val)
+    {
+        return aux::to_chars_float(first, last, val, true, chars_format{}, true, -1);
+    }
+
+    to_chars_result to_chars(char* first, char* last, double val)
+    {
+        return aux::to_chars_float(first, last, val, false, chars_format{}, true, -1);
+    }
+
+    /**
+     * Note: We format and parse long double as double.
+     */
+    to_chars_result to_chars(char* first, char* last, long double val)
+    {
+        return aux::to_chars_float(
+            first, last, static_cast<double>(val), false, chars_format{}, true, -1
+        );
+    }
+
+    to_chars_result to_chars(char* first, char* last, float val,
+                             chars_format fmt)
+    {
+        return aux::to_chars_float(first, last, val, true, fmt, true, -1);
+    }
+
+    to_chars_result to_chars(char* first, char* last, double val,
+                             chars_format fmt)
+    {
+        return aux::to_chars_float(first, last, val, false, fmt, true, -1);
+    }
+
+    to_chars_result to_chars(char* first, char* last, long double val,
+                             chars_format fmt)
+    {
+        return aux::to_chars_float(
+            first, last, static_cast<double>(val), false, fmt, true, -1
+        );
+    }
+
+    to_chars_result to_chars(char* first, char* last, float val,
+                             chars_format fmt, int precision)
+    {
+        return aux::to_chars_float(first, last, val, true, fmt, false, precision);
+    }
+
+    to_chars_result to_chars(char* first, char* last, double val,
+                             chars_format fmt, int precision)
+    {
+        return aux::to_chars_float(first, last, val, false, fmt, false, precision);
+    }
+
+    to_chars_result to_chars(char* first, char* last, long double val,
+                             chars_format fmt, int precision)
+    {
+        return aux::to_chars_float(
+            first, last, static_cast<double>(val), false, fmt, false, precision
+        );
+    }
+
+    from_chars_result from_chars(const char* first, const char* last, float& val,
+                                 chars_format fmt)
+    {
+        return parse_float(first, last, val, fmt);
+    }
+
+    from_chars_result from_chars(const char* first, const char* last, double& val,
+                                 chars_format fmt)
+    {
+        return parse_float(first, last, val, fmt);
+    }
+
+    from_chars_result from_chars(const char* first, const char* last, long double& val,
+                                 chars_format fmt)
+    {
+        double tmp{};
+        auto res = parse_float(first, last, tmp, fmt);
+        if (res.ec == errc{})
+            val = tmp;
+
+        return res;
+    }
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/thread/executor.hpp>
+#include <new>
+#include <thread>
+
+namespace std::aux
+{
+    namespace
+    {
+        /**
+         * Fibrils have their own TLS, so this tells
+         * us whether we are running inside of a worker
+         * even if the fibril migrates between runners.
+         */
+        thread_local void* current_worker{};
+    }
+
+    executor& executor::instance()
+    {
+        static executor exec{};
+
+        return exec;
+    }
+
+    executor::executor()
+        : workers_{}, worker_count_{}, idle_mtx_{}, idle_cv_{},
+          pending_{}, next_{}
+    {
+        threading::mutex::init(idle_mtx_);
+        threading::condvar::init(idle_cv_);
+
+        size_t count = thread::hardware_concurrency();
+        if (count == 0)
+            count = 1;
+
+        workers_ = static_cast<worker*>(
+            ::operator new(count * sizeof(worker), nothrow)
+        );
+        if (!workers_)
+            return;
+
+        /**
+         * The workers read worker_count_ when stealing,
+         * so they may start only once all of them exist.
+         */
+        size_t created{};
+        for (; created < count; ++created)
+        {
+            auto& w = workers_[created];
+            w.exec = this;
+            w.index = created;
+            w.head = nullptr;
+            w.tail = nullptr;
+            threading::mutex::init(w.mtx);
+
+            w.fid = threading::thread::create(worker_main_, w);
+            if (!w.fid)
+                break;
+        }
+
+        /**
+         * The workers are fibrils, they run in parallel
+         * only if the task has more than one runner.
+         */
+        worker_count_ = created;
+        if (worker_count_ > 1)
+            threading::thread::enable_multithreaded();
+
+        for (size_t i = 0; i < worker_count_; ++i)
+            threading::thread::start(workers_[i].fid);
+    }
+
+    bool executor::submit(executor_task* task)
+    {
+        if (worker_count_ == 0)
+            return false;
+
+        /**
+         * Workers push to their own queue to keep nested
+         * tasks local, everyone else spreads the tasks.
+         */
+        worker* w = static_cast<worker*>(current_worker);
+        if (!w || w->exec != this)
+        {
+            auto idx = __atomic_fetch_add(&next_, 1, __ATOMIC_RELAXED);
+            w = &workers_[idx % worker_count_];
+        }
+
+        threading::mutex::lock(w->mtx);
+        task->prev_ = w->tail;
+        task->next_ = nullptr;
+        if (w->tail)
+            w->tail->next_ = task;
+        else
+            __atomic_store_n(&w->head, task, __ATOMIC_RELAXED);
+        w->tail = task;
+        __atomic_store_n(&task->queue_, w, __ATOMIC_RELEASE);
+        threading::mutex::unlock(w->mtx);
+
+        /**
+         * Workers check pending_ while holding idle_mtx_,
+         * so signaling under it cannot be missed.
+         */
+        __atomic_add_fetch(&pending_, 1, __ATOMIC_RELEASE);
+        threading::mutex::lock(idle_mtx_);
+        threading::condvar::signal(idle_cv_);
+        threading::mutex::unlock(idle_mtx_);
+
+        return true;
+    }
+
+    bool executor::revoke(executor_task* task)
+    {
+        auto w = static_cast<worker*>(
+            __atomic_load_n(&task->queue_, __ATOMIC_ACQUIRE)
+        );
+        if (!w)
+            return false;
+
+        threading::mutex::lock(w->mtx);
+        bool res = task->queue_ == w;
+        if (res)
+            unlink_(*w, task);
+        threading::mutex::unlock(w->mtx);
+
+        return res;
+    }
+
+    size_t executor::worker_count() const noexcept
+    {
+        return worker_count_;
+    }
+
+    executor_task* executor::pop_(worker& w)
+    {
+        threading::mutex::lock(w.mtx);
+        auto task = w.tail;
+        if (task)
+            unlink_(w, task);
+        threading::mutex::unlock(w.mtx);
+
+        return task;
+    }
+
+    executor_task* executor::steal_(worker& w)
+    {
+        for (size_t i = 1; i < worker_count_; ++i)
+        {
+            auto task = pop_front_(workers_[(w.index + i) % worker_count_]);
+            if (task)
+                return task;
+        }
+
+        return nullptr;
+    }
+
+    executor_task* executor::pop_front_(worker& w)
+    {
+        // Do not bother locking queues that are empty.
+        if (!__atomic_load_n(&w.head, __ATOMIC_RELAXED))
+            return nullptr;
+
+        threading::mutex::lock(w.mtx);
+        auto task = w.head;
+        if (task)
+            unlink_(w, task);
+        threading::mutex::unlock(w.mtx);
+
+        return task;
+    }
+
+    void executor::unlink_(worker& w, executor_task* task)
+    {
+        if (task->prev_)
+            task->prev_->next_ = task->next_;
+        else
+            __atomic_store_n(&w.head, task->next_, __ATOMIC_RELAXED);
+
+        if (task->next_)
+            task->next_->prev_ = task->prev_;
+        else
+            w.tail = task->prev_;
+
+        task->prev_ = nullptr;
+        task->next_ = nullptr;
+        __atomic_store_n(&task->queue_, nullptr, __ATOMIC_RELEASE);
+        __atomic_sub_fetch(&pending_, 1, __ATOMIC_RELAXED);
+    }
+
+    int executor::worker_main_(void* arg)
+    {
+        auto& w = *static_cast<worker*>(arg);
+        auto& exec = *w.exec;
+        current_worker = &w;
+
+        while (true)
+        {
+            auto task = exec.pop_(w);
+            if (!task)
+                task = exec.steal_(w);
+
+            if (task)
+            {
+                task->run();
+                continue;
+            }
+
+            threading::mutex::lock(exec.idle_mtx_);
+            while (__atomic_load_n(&exec.pending_, __ATOMIC_ACQUIRE) == 0)
+                threading::condvar::wait(exec.idle_cv_, exec.idle_mtx_);
+            threading::mutex::unlock(exec.idle_mtx_);
+        }
+
+        return 0;
+    }
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <fstream>
+#include <offset.h>
+#include <adt/list.h>
+
+/**
+ * Neither the VFS nor the address space interface
+ * is wrapped for C++, so we put them in the namespace
+ * ourselves.
+ */
+namespace helenos
+{
+    extern "C"
+    {
+        #include <as.h>
+        #include <vfs/vfs.h>
+    }
+}
+
+namespace std::aux
+{
+    int filebuf_open(const char* name, ios_base::openmode mode)
+    {
+        int walk{::helenos::WALK_REGULAR};
+        int flags{};
+        bool trunc{false};
+
+        /**
+         * See table 132, ate and binary do not change
+         * the way the file is opened.
+         */
+        switch (mode & ~(ios_base::ate | ios_base::binary))
+        {
+            case ios_base::out:
+            case ios_base::out | ios_base::trunc:
+                walk |= ::helenos::WALK_MAY_CREATE;
+                flags = ::helenos::MODE_WRITE;
+                trunc = true;
+                break;
+            case ios_base::out | ios_base::app:
+            case ios_base::app:
+                walk |= ::helenos::WALK_MAY_CREATE;
+                flags = ::helenos::MODE_WRITE | ::helenos::MODE_APPEND;
+                break;
+            case ios_base::in:
+                flags = ::helenos::MODE_READ;
+                break;
+            case ios_base::in | ios_base::out:
+                flags = ::helenos::MODE_READ | ::helenos::MODE_WRITE;
+                break;
+            case ios_base::in | ios_base::out | ios_base::trunc:
+                walk |= ::helenos::WALK_MAY_CREATE;
+                flags = ::helenos::MODE_READ | ::helenos::MODE_WRITE;
+                trunc = true;
+                break;
+            case ios_base::in | ios_base::out | ios_base::app:
+            case ios_base::in | ios_base::app:
+                walk |= ::helenos::WALK_MAY_CREATE;
+                flags = ::helenos::MODE_READ | ::helenos::MODE_WRITE |
+                        ::helenos::MODE_APPEND;
+                break;
+            default:
+                return -1;
+        }
+
+        int fd{};
+        if (::helenos::vfs_lookup_open(name, walk, flags, &fd) != EOK)
+            return -1;
+
+        if (trunc && ::helenos::vfs_resize(fd, 0) != EOK)
+        {
+            ::helenos::vfs_put(fd);
+
+            return -1;
+        }
+
+        return fd;
+    }
+
+    bool filebuf_close(int fd)
+    {
+        return ::helenos::vfs_put(fd) == EOK;
+    }
+
+    streamsize filebuf_read(int fd, streamoff pos, void* buf, size_t size)
+    {
+        ::helenos::aoff64_t off = pos;
+        size_t nread{};
+
+        auto rc = ::helenos::vfs_read(fd, &off, buf, size, &nread);
+        if (rc != EOK && nread == 0)
+            return -1;
+
+        return static_cast<streamsize>(nread);
+    }
+
+    streamsize filebuf_write(int fd, streamoff pos, const void* buf, size_t size)
+    {
+        ::helenos::aoff64_t off = pos;
+        size_t nwritten{};
+
+        auto rc = ::helenos::vfs_write(fd, &off, buf, size, &nwritten);
+        if (rc != EOK && nwritten == 0)
+            return -1;
+
+        return static_cast<streamsize>(nwritten);
+    }
+
+    streamoff filebuf_size(int fd)
+    {
+        ::helenos::vfs_stat_t st{};
+        if (::helenos::vfs_stat(fd, &st) != EOK)
+            return -1;
+
+        return static_cast<streamoff>(st.size);
+    }
+
+    void* filebuf_map(int fd, size_t size)
+    {
+        /**
+         * There is no pager for regular files, so the
+         * mapping is an anonymous area that we fill in
+         * one request and then make read-only. Reads
+         * from the stream are then plain memory accesses.
+         */
+        auto area = ::helenos::as_area_create(
+            ::helenos::AS_AREA_ANY, size,
+            ::helenos::AS_AREA_READ | ::helenos::AS_AREA_WRITE |
+            ::helenos::AS_AREA_CACHEABLE, nullptr
+        );
+        if (area == ::helenos::AS_MAP_FAILED)
+            return nullptr;
+
+        ::helenos::aoff64_t off{};
+        size_t nread{};
+        auto rc = ::helenos::vfs_read(fd, &off, area, size, &nread);
+        if (rc != EOK || nread != size)
+        {
+            ::helenos::as_area_destroy(area);
+
+            return nullptr;
+        }
+
+        ::helenos::as_area_change_flags(
+            area, ::helenos::AS_AREA_READ | ::helenos::AS_AREA_CACHEABLE
+        );
+
+        return area;
+    }
+
+    void filebuf_unmap(void* map)
+    {
+        ::helenos::as_area_destroy(map);
+    }
+}
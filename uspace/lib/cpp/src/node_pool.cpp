@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026 HelenOS project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <__bits/memory/node_pool.hpp>
+#include <new>
+
+namespace std::aux
+{
+    void* node_pool::allocate(size_t size)
+    {
+        if (node_size_ == 0)
+        {
+            /**
+             * Bind the pool to the first size we see, each
+             * node must be able to hold the free list link
+             * and keep the next node aligned.
+             */
+            if (size < sizeof(free_node))
+                size = sizeof(free_node);
+
+            auto align = alignof(max_align_t);
+            node_size_ = (size + align - 1) & ~(align - 1);
+        }
+
+        if (free_)
+        {
+            auto res = free_;
+            free_ = free_->next;
+            --free_count_;
+
+            return res;
+        }
+
+        if (tail_ == tail_end_)
+            grow_();
+
+        auto res = tail_;
+        tail_ += node_size_;
+
+        return res;
+    }
+
+    void node_pool::deallocate(void* ptr, size_t)
+    {
+        if (!ptr)
+            return;
+
+        auto node = static_cast<free_node*>(ptr);
+        node->next = free_;
+        free_ = node;
+        ++free_count_;
+    }
+
+    bool node_pool::serves(size_t size) const noexcept
+    {
+        if (node_size_ == 0)
+            return true;
+
+        auto align = alignof(max_align_t);
+        if (size < sizeof(free_node))
+            size = sizeof(free_node);
+
+        return ((size + align - 1) & ~(align - 1)) == node_size_;
+    }
+
+    void node_pool::reference() noexcept
+    {
+        ++refcount_;
+    }
+
+    bool node_pool::release() noexcept
+    {
+        return --refcount_ == 0;
+    }
+
+    size_t node_pool::chunk_count() const noexcept
+    {
+        return chunk_count_;
+    }
+
+    size_t node_pool::free_count() const noexcept
+    {
+        return free_count_;
+    }
+
+    node_pool::~node_pool()
+    {
+        while (chunks_)
+        {
+            auto tmp = chunks_;
+            chunks_ = chunks_->next;
+
+            ::operator delete(tmp);
+        }
+    }
+
+    void node_pool::grow_()
+    {
+        /**
+         * Chunks double in size so that small containers
+         * do not waste memory and big ones need only
+         * a handful of trips to malloc.
+         */
+        size_t nodes = min_chunk_nodes_;
+        if (chunks_)
+        {
+            nodes = chunks_->nodes * 2;
+            if (nodes > max_chunk_nodes_)
+                nodes = max_chunk_nodes_;
+        }
+
+        auto header = chunk_header_size_();
+        auto mem = static_cast<char*>(
+            ::operator new(header + nodes * node_size_)
+        );
+
+        auto ch = reinterpret_cast<chunk*>(mem);
+        ch->next = chunks_;
+        ch->nodes = nodes;
+        chunks_ = ch;
+        ++chunk_count_;
+
+        tail_ = mem + header;
+        tail_end_ = tail_ + nodes * node_size_;
+    }
+
+    size_t node_pool::chunk_header_size_() noexcept
+    {
+        auto align = alignof(max_align_t);
+
+        return (sizeof(chunk) + align - 1) & ~(align - 1);
+    }
+}
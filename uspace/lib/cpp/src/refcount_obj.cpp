@@ -30,49 +30,45 @@
 
 namespace std::aux
 {
-    void refcount_obj::increment()
+    /**
+     * Note: New references can only be created from existing
+     *       ones, so increments need no ordering. Decrements
+     *       have to release our writes to the object and the
+     *       last one has to acquire the writes of the others
+     *       before the object gets destroyed.
+     */
+
+    void refcount_obj::increment() noexcept
     {
-        __atomic_add_fetch(&refcount_, 1, __ATOMIC_ACQ_REL);
+        __atomic_add_fetch(&refcount_, 1, __ATOMIC_RELAXED);
     }
 
-    void refcount_obj::increment_weak()
+    void refcount_obj::increment_weak() noexcept
     {
-        __atomic_add_fetch(&weak_refcount_, 1, __ATOMIC_ACQ_REL);
+        __atomic_add_fetch(&weak_refcount_, 1, __ATOMIC_RELAXED);
     }
 
-    bool refcount_obj::decrement()
+    bool refcount_obj::decrement() noexcept
     {
-        if (__atomic_sub_fetch(&refcount_, 1, __ATOMIC_ACQ_REL) == 0)
-        {
-            /**
-             * First call to destroy() will delete the held object,
-             * so it doesn't matter what the weak_refcount_ is,
-             * but we added one and we need to remove it now.
-             */
-            decrement_weak();
-
-            return true;
-        }
-        else
-            return false;
+        return __atomic_sub_fetch(&refcount_, 1, __ATOMIC_ACQ_REL) == 0;
     }
 
-    bool refcount_obj::decrement_weak()
+    bool refcount_obj::decrement_weak() noexcept
     {
-        return __atomic_sub_fetch(&weak_refcount_, 1, __ATOMIC_ACQ_REL) == 0 && refs() == 0;
+        return __atomic_sub_fetch(&weak_refcount_, 1, __ATOMIC_ACQ_REL) == 0;
     }
 
-    refcount_t refcount_obj::refs() const
+    refcount_t refcount_obj::refs() const noexcept
     {
         return __atomic_load_n(&refcount_, __ATOMIC_RELAXED);
     }
 
-    refcount_t refcount_obj::weak_refs() const
+    refcount_t refcount_obj::weak_refs() const noexcept
     {
         return __atomic_load_n(&weak_refcount_, __ATOMIC_RELAXED);
     }
 
-    bool refcount_obj::expired() const
+    bool refcount_obj::expired() const noexcept
     {
         return refs() == 0;
     }
@@ -27,8 +27,38 @@
  */
 
 #include <cassert>
+#include <charconv>
 #include <string>
 
+namespace
+{
+    template<class Int>
+    std::string integer_to_string(Int val)
+    {
+        /**
+         * Each byte adds less than three
+         * digits, plus room for the sign.
+         */
+        char buf[sizeof(Int) * 3 + 2];
+        auto res = std::to_chars(buf, buf + sizeof(buf), val);
+
+        return std::string(buf, static_cast<std::size_t>(res.ptr - buf));
+    }
+
+    template<class Float>
+    std::string float_to_string(Float val)
+    {
+        /**
+         * Same as %f, the largest double has 309
+         * integral digits.
+         */
+        char buf[330];
+        auto res = std::to_chars(buf, buf + sizeof(buf), val, std::chars_format::fixed, 6);
+
+        return std::string(buf, static_cast<std::size_t>(res.ptr - buf));
+    }
+}
+
 namespace std
 {
     int stoi(const string& str, size_t* idx, int base)
@@ -107,101 +137,47 @@ namespace std
 
     string to_string(int val)
     {
-        char* tmp;
-        ::asprintf(&tmp, "%d", val);
-
-        std::string res{tmp};
-        free(tmp);
-
-        return res;
+        return integer_to_string(val);
     }
 
     string to_string(unsigned val)
     {
-        char* tmp;
-        ::asprintf(&tmp, "%u", val);
-
-        std::string res{tmp};
-        free(tmp);
-
-        return res;
+        return integer_to_string(val);
     }
 
     string to_string(long val)
     {
-        char* tmp;
-        ::asprintf(&tmp, "%ld", val);
-
-        std::string res{tmp};
-        free(tmp);
-
-        return res;
+        return integer_to_string(val);
     }
 
     string to_string(unsigned long val)
     {
-        char* tmp;
-        ::asprintf(&tmp, "%lu", val);
-
-        std::string res{tmp};
-        free(tmp);
-
-        return res;
+        return integer_to_string(val);
     }
 
     string to_string(long long val)
     {
-        char* tmp;
-        ::asprintf(&tmp, "%lld", val);
-
-        std::string res{tmp};
-        free(tmp);
-
-        return res;
+        return integer_to_string(val);
     }
 
     string to_string(unsigned long long val)
     {
-        char* tmp;
-        ::asprintf(&tmp, "%llu", val);
-
-        std::string res{tmp};
-        free(tmp);
-
-        return res;
+        return integer_to_string(val);
     }
 
     string to_string(float val)
     {
-        char* tmp;
-        ::asprintf(&tmp, "%f", val);
-
-        std::string res{tmp};
-        free(tmp);
-
-        return res;
+        return float_to_string(val);
     }
 
     string to_string(double val)
     {
-        char* tmp;
-        ::asprintf(&tmp, "%f", val);
-
-        std::string res{tmp};
-        free(tmp);
-
-        return res;
+        return float_to_string(val);
     }
 
     string to_string(long double val)
     {
-        char* tmp;
-        ::asprintf(&tmp, "%Lf", val);
-
-        std::string res{tmp};
-        free(tmp);
-
-        return res;
+        return float_to_string(val);
     }
 
     int stoi(const wstring& str, size_t* idx, int base)
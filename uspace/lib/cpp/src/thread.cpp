@@ -32,6 +32,18 @@
 #include <thread>
 #include <utility>
 
+/**
+ * The stats interface is not wrapped for C++ like
+ * fibril.h is, so we put it in the namespace ourselves.
+ */
+namespace helenos
+{
+    extern "C"
+    {
+        #include <stats.h>
+    }
+}
+
 namespace std
 {
     thread::thread() noexcept
@@ -119,9 +131,20 @@ namespace std
 
     unsigned thread::hardware_concurrency() noexcept
     {
-        // TODO:
-        __unimplemented();
-        return 0;
+        size_t count{};
+        auto cpus = ::helenos::stats_get_cpus(&count);
+        if (!cpus)
+            return 0;
+
+        unsigned res{};
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (cpus[i].active)
+                ++res;
+        }
+        free(cpus);
+
+        return res;
     }
 
     void swap(thread& x, thread& y) noexcept
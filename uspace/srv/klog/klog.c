@@ -38,9 +38,12 @@
 #include <async.h>
 #include <as.h>
 #include <ddi.h>
+#include <align.h>
+#include <barrier.h>
 #include <errno.h>
 #include <str_error.h>
 #include <io/klog.h>
+#include <abi/klog.h>
 #include <sysinfo.h>
 #include <stdlib.h>
 #include <fibril_synch.h>
@@ -51,22 +54,11 @@
 
 #define NAME  "klog"
 
-typedef size_t __attribute__((aligned(1))) unaligned_size_t;
-
-typedef struct {
-	size_t entry_len;
-	uint32_t serial;
-	uint32_t facility;
-	uint32_t level;
-	char message[0];
-
-} __attribute__((__packed__)) log_entry_t;
-
 /* Producer/consumer buffers */
 typedef struct {
 	link_t link;
 	size_t size;
-	log_entry_t *data;
+	klog_entry_t *data;
 } item_t;
 
 static prodcons_t pc;
@@ -75,6 +67,22 @@ static prodcons_t pc;
 #define BUFFER_SIZE PAGE_SIZE
 static void *buffer;
 
+/* Kernel log ring mapped into our address space */
+typedef struct {
+	klog_ring_t *ring;
+	uint8_t *data;
+	/* Position of the first entry not yet queued */
+	size_t pos;
+	/* Position after the last complete entry */
+	size_t head;
+	/* Number of lost entries already reported */
+	size_t dropped;
+} ring_t;
+
+/* Kernel log rings, NULL if they are not mapped */
+static ring_t *rings = NULL;
+static size_t ring_count = 0;
+
 /* Notification mutex */
 static FIBRIL_MUTEX_INITIALIZE(mtx);
 
@@ -88,15 +96,41 @@ static const char *facility_name[] = {
 #define facility_len (sizeof(facility_name) / sizeof(const char *))
 static log_t facility_ctx[facility_len];
 
-/** Klog producer
+/** Queue a copy of a log entry for the consumer
  *
- * Copies the log entries to a producer/consumer queue.
+ * @param entry Log entry.
  *
- * @param length Number of characters to copy.
- * @param data   Pointer to the kernel klog buffer.
+ * @return True on success, false if out of memory.
  *
  */
-static void producer(void)
+static bool produce(const klog_entry_t *entry)
+{
+	klog_entry_t *buf = malloc(entry->len + 1);
+	if (buf == NULL)
+		return false;
+
+	item_t *item = malloc(sizeof(item_t));
+	if (item == NULL) {
+		free(buf);
+		return false;
+	}
+
+	memcpy(buf, entry, entry->len);
+	*((uint8_t *) buf + entry->len) = 0;
+	link_initialize(&item->link);
+	item->size = entry->len;
+	item->data = buf;
+	prodcons_produce(&pc, &item->link);
+
+	return true;
+}
+
+/** Klog producer reading the entries using klog_read()
+ *
+ * Copies the log entries to a producer/consumer queue.
+ *
+ */
+static void producer_read(void)
 {
 	size_t len = 0;
 	errno_t rc = klog_read(buffer, BUFFER_SIZE, &len);
@@ -107,31 +141,173 @@ static void producer(void)
 	}
 
 	size_t offset = 0;
-	while (offset < len) {
-		size_t entry_len = *((unaligned_size_t *) (buffer + offset));
+	while (offset + sizeof(klog_entry_t) <= len) {
+		klog_entry_t *entry = (klog_entry_t *) (buffer + offset);
 
-		if (offset + entry_len > len || entry_len < sizeof(log_entry_t))
+		if (offset + entry->len > len || entry->len < sizeof(klog_entry_t))
 			break;
 
-		log_entry_t *buf = malloc(entry_len + 1);
-		if (buf == NULL)
+		if (!produce(entry))
 			break;
 
-		item_t *item = malloc(sizeof(item_t));
-		if (item == NULL) {
-			free(buf);
+		offset += ALIGN_UP(entry->len, KLOG_ENTRY_ALIGN);
+	}
+}
+
+/** Find the first entry of a mapped ring not yet queued
+ *
+ * Skips the unused rest of the ring before it wraps around.
+ *
+ * @param ring Mapped ring.
+ *
+ * @return The entry or NULL if there are no more entries.
+ *
+ */
+static klog_entry_t *ring_first(ring_t *ring)
+{
+	size_t size = ring->ring->size;
+
+	while (ring->pos != ring->head) {
+		size_t offset = ring->pos % size;
+		size_t rest = size - offset;
+		klog_entry_t *entry = (klog_entry_t *) (ring->data + offset);
+
+		if ((rest < sizeof(klog_entry_t)) || (entry->len == 0)) {
+			ring->pos += rest;
+			continue;
+		}
+
+		if ((entry->len < sizeof(klog_entry_t)) || (entry->len > rest)) {
+			/* Not at an entry boundary, skip everything */
+			ring->pos = ring->head;
 			break;
 		}
 
-		memcpy(buf, buffer + offset, entry_len);
-		*((uint8_t *) buf + entry_len) = 0;
-		link_initialize(&item->link);
-		item->size = entry_len;
-		item->data = buf;
-		prodcons_produce(&pc, &item->link);
+		return entry;
+	}
+
+	return NULL;
+}
 
-		offset += entry_len;
+/** Klog producer draining the mapped kernel log rings
+ *
+ * Copies the log entries of all rings to a producer/consumer queue
+ * in the order in which they were logged. The space in the rings is
+ * released at once after the whole batch has been queued.
+ *
+ */
+static void producer_rings(void)
+{
+	for (size_t i = 0; i < ring_count; i++) {
+		klog_ring_t *ring = rings[i].ring;
+
+		rings[i].head = ACCESS_ONCE(ring->head);
+		rings[i].pos = ACCESS_ONCE(ring->tail);
+
+		size_t dropped = ACCESS_ONCE(ring->dropped);
+		if (dropped != rings[i].dropped) {
+			log_msg(LOG_DEFAULT, LVL_WARN,
+			    "%zu kernel log entries lost on CPU %zu",
+			    dropped - rings[i].dropped, i);
+			rings[i].dropped = dropped;
+		}
 	}
+
+	read_barrier();
+
+	while (true) {
+		ring_t *ring = NULL;
+		klog_entry_t *entry = NULL;
+
+		for (size_t i = 0; i < ring_count; i++) {
+			klog_entry_t *first = ring_first(&rings[i]);
+			if ((first != NULL) && ((entry == NULL) ||
+			    ((int32_t) (first->serial - entry->serial) < 0))) {
+				ring = &rings[i];
+				entry = first;
+			}
+		}
+
+		if (entry == NULL)
+			break;
+
+		if (!produce(entry))
+			break;
+
+		ring->pos += ALIGN_UP(entry->len, KLOG_ENTRY_ALIGN);
+	}
+
+	/* Release the space only after the entries are copied */
+	memory_barrier();
+
+	for (size_t i = 0; i < ring_count; i++)
+		ACCESS_ONCE(rings[i].ring->tail) = rings[i].pos;
+}
+
+/** Klog producer
+ *
+ * Copies the log entries to a producer/consumer queue.
+ *
+ */
+static void producer(void)
+{
+	if (rings != NULL)
+		producer_rings();
+	else
+		producer_read();
+}
+
+/** Map the kernel log rings
+ *
+ * @return EOK on success or an error code.
+ *
+ */
+static errno_t rings_map(void)
+{
+	sysarg_t faddr;
+	errno_t rc = sysinfo_get_value("klog.faddr", &faddr);
+	if (rc != EOK)
+		return rc;
+
+	sysarg_t pages;
+	rc = sysinfo_get_value("klog.pages", &pages);
+	if (rc != EOK)
+		return rc;
+
+	sysarg_t count;
+	rc = sysinfo_get_value("klog.rings", &count);
+	if (rc != EOK)
+		return rc;
+
+	sysarg_t ring_size;
+	rc = sysinfo_get_value("klog.ring_size", &ring_size);
+	if (rc != EOK)
+		return rc;
+
+	sysarg_t data_offset;
+	rc = sysinfo_get_value("klog.data_offset", &data_offset);
+	if (rc != EOK)
+		return rc;
+
+	void *area = AS_AREA_ANY;
+	rc = physmem_map(faddr, pages, AS_AREA_READ | AS_AREA_WRITE |
+	    AS_AREA_CACHEABLE, &area);
+	if (rc != EOK)
+		return rc;
+
+	rings = calloc(count, sizeof(ring_t));
+	if (rings == NULL) {
+		physmem_unmap(area);
+		return ENOMEM;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		rings[i].ring = area + i * KLOG_RING_HEADER_SIZE;
+		rings[i].data = area + data_offset + i * ring_size;
+	}
+
+	ring_count = count;
+	return EOK;
 }
 
 /** Klog consumer
@@ -151,7 +327,7 @@ static errno_t consumer(void *data)
 		link_t *link = prodcons_consume(&pc);
 		item_t *item = list_get_instance(link, item_t, link);
 
-		if (item->size < sizeof(log_entry_t)) {
+		if (item->size < sizeof(klog_entry_t)) {
 			free(item->data);
 			free(item);
 			continue;
@@ -219,10 +395,16 @@ int main(int argc, char *argv[])
 		facility_ctx[i] = log_create(facility_name[i], kernel_ctx);
 	}
 
-	buffer = malloc(BUFFER_SIZE);
-	if (buffer == NULL) {
-		log_msg(LOG_DEFAULT, LVL_ERROR, "Unable to allocate buffer");
-		return 1;
+	rc = rings_map();
+	if (rc != EOK) {
+		log_msg(LOG_DEFAULT, LVL_WARN, "Unable to map kernel log rings, "
+		    "reading them by copying: %s", str_error(rc));
+
+		buffer = malloc(BUFFER_SIZE);
+		if (buffer == NULL) {
+			log_msg(LOG_DEFAULT, LVL_ERROR, "Unable to allocate buffer");
+			return 1;
+		}
 	}
 
 	prodcons_initialize(&pc);
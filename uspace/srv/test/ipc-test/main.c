@@ -40,6 +40,7 @@
 #include <as.h>
 #include <async.h>
 #include <errno.h>
+#include <fibril.h>
 #include <str_error.h>
 #include <io/log.h>
 #include <ipc/ipc_test.h>
@@ -245,6 +246,9 @@ int main(int argc, char *argv[])
 		return rc;
 	}
 
+	/* Handle connections of concurrent clients in parallel. */
+	fibril_enable_multithreaded();
+
 	printf("%s: Accepting connections\n", NAME);
 	task_retval(0);
 	async_manager();